@@ -135,6 +135,10 @@ static void vblk_put_req(struct vsc_request *req)
 		memset(&req->vs_req, 0, sizeof(struct vs_request));
 		req->req = NULL;
 		memset(&req->iter, 0, sizeof(struct req_iterator));
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 9, 0)
+		memset(req->coalesced, 0, sizeof(req->coalesced));
+		req->num_coalesced = 0;
+#endif
 		vblkdev->inflight_reqs--;
 
 		if ((vblkdev->inflight_reqs == 0) &&
@@ -237,7 +241,27 @@ static void req_error_handler(struct vblk_dev *vblkdev, struct request *breq)
 #endif
 }
 
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 9, 0)
+/**
+ * vblk_end_coalesced: Complete the bio requests that were batched
+ *		behind the primary request of a vsc request. The server
+ *		processed them as a single transfer, so they all share
+ *		its completion status.
+ */
+static void vblk_end_coalesced(struct vblk_dev *vblkdev,
+		struct vsc_request *vsc_req, bool error)
+{
+	uint32_t i;
 
+	for (i = 0; i < vsc_req->num_coalesced; i++) {
+		if (error)
+			req_error_handler(vblkdev, vsc_req->coalesced[i]);
+		else
+			blk_mq_end_request(vsc_req->coalesced[i], BLK_STS_OK);
+	}
+	vsc_req->num_coalesced = 0;
+}
+#endif
 
 static void handle_non_ioctl_resp(struct vblk_dev *vblkdev,
 		struct vsc_request *vsc_req,
@@ -322,6 +346,10 @@ end:
 
 		req_error_handler(vblkdev, bio_req);
 	}
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 9, 0)
+	vblk_end_coalesced(vblkdev, vsc_req, invoke_req_err_hand);
+#endif
 }
 
 /**
@@ -389,6 +417,9 @@ static bool complete_bio_req(struct vblk_dev *vblkdev)
 
 	} else if ((bio_req != NULL) && (status != 0)) {
 		req_error_handler(vblkdev, bio_req);
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 9, 0)
+		vblk_end_coalesced(vblkdev, vsc_req, true);
+#endif
 	} else {
 		dev_err(vblkdev->device,
 			"VSC request %d has null bio request!\n",
@@ -443,6 +474,231 @@ static bool bio_req_sanity_check(struct vblk_dev *vblkdev,
 	return true;
 }
 
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 9, 0)
+/**
+ * vblk_coalesce_next_reqs: Batch queued requests that continue the
+ *		primary request's block range into the same vsc request,
+ *		so that adjacent small writes and trim ranges are
+ *		submitted to the server in one IVC frame. Candidates are
+ *		taken from the head of the request list while they match
+ *		the primary operation, start exactly where the range so
+ *		far ends and keep the transfer within the server's
+ *		per-I/O limit. Returns the number of extra sectors
+ *		covered by the batched requests.
+ *
+ *		Writes are only batched on the mempool path; with
+ *		use_vm_address each request carries its own IOVA mapping.
+ */
+static uint32_t vblk_coalesce_next_reqs(struct vblk_dev *vblkdev,
+		struct vsc_request *vsc_req, struct request *bio_req)
+{
+	struct req_entry *entry;
+	struct request *next_req;
+	uint64_t limit_bytes;
+	uint64_t total_bytes = blk_rq_bytes(bio_req);
+	sector_t next_pos = blk_rq_pos(bio_req) + blk_rq_sectors(bio_req);
+	uint32_t extra_sectors = 0;
+
+	if (req_op(bio_req) == REQ_OP_WRITE) {
+		if (vblkdev->config.blk_config.use_vm_address)
+			return 0;
+		limit_bytes = vsc_req->mempool_len;
+	} else if (req_op(bio_req) == REQ_OP_DISCARD) {
+		limit_bytes = ((uint64_t)
+			vblkdev->config.blk_config.max_erase_blks_per_io *
+			vblkdev->config.blk_config.hardblk_size);
+	} else {
+		return 0;
+	}
+
+	spin_lock(&vblkdev->queue_lock);
+	while ((vsc_req->num_coalesced < VBLK_MAX_COALESCED_REQS) &&
+			!list_empty(&vblkdev->req_list)) {
+		entry = list_first_entry(&vblkdev->req_list, struct req_entry,
+						list_entry);
+		next_req = entry->req;
+
+		if ((req_op(next_req) != req_op(bio_req)) ||
+			(blk_rq_pos(next_req) != next_pos) ||
+			((total_bytes + blk_rq_bytes(next_req)) > limit_bytes))
+			break;
+
+		list_del(&entry->list_entry);
+		kfree(entry);
+
+		vsc_req->coalesced[vsc_req->num_coalesced] = next_req;
+		vsc_req->num_coalesced++;
+		next_pos += blk_rq_sectors(next_req);
+		extra_sectors += blk_rq_sectors(next_req);
+		total_bytes += blk_rq_bytes(next_req);
+	}
+	spin_unlock(&vblkdev->queue_lock);
+
+	/* Submissions are serialized by ivc_lock, so the counters
+	 * need no extra protection */
+	if (vsc_req->num_coalesced != 0) {
+		if (req_op(bio_req) == REQ_OP_WRITE)
+			vblkdev->coalesced_writes += vsc_req->num_coalesced;
+		else
+			vblkdev->coalesced_discards += vsc_req->num_coalesced;
+	}
+
+	return extra_sectors;
+}
+#endif
+
+/**
+ * vblk_cache_setup: Validate the shared read-only block cache exposed
+ *		by the storage server, once the device configuration
+ *		(and with it the block size) is known. The cache is
+ *		disabled when the header does not describe a layout
+ *		that fits the reserved region.
+ */
+static void vblk_cache_setup(struct vblk_dev *vblkdev)
+{
+	struct vs_cache_header *hdr = vblkdev->cache_base;
+	uint32_t hardblk_size = vblkdev->config.blk_config.hardblk_size;
+	uint32_t line_blks;
+	uint32_t num_entries;
+	uint64_t data_offset;
+	uint64_t line_bytes;
+	uint64_t need;
+
+	if (hdr == NULL)
+		return;
+
+	/* Snapshot the geometry once; the header lives in server-writable
+	 * shared memory, so the validated copy in vblkdev is the only one
+	 * used for lookups afterwards */
+	line_blks = READ_ONCE(hdr->line_blks);
+	num_entries = READ_ONCE(hdr->num_entries);
+	data_offset = READ_ONCE(hdr->data_offset);
+
+	if ((hdr->magic != VS_CACHE_MAGIC) ||
+		(hdr->version != VS_CACHE_VERSION) ||
+		(line_blks == 0) || (num_entries == 0))
+		goto invalid;
+
+	if ((sizeof(struct vs_cache_header) +
+		((uint64_t)num_entries *
+			sizeof(struct vs_cache_entry))) > data_offset)
+		goto invalid;
+
+	line_bytes = (uint64_t)line_blks * hardblk_size;
+	need = data_offset + ((uint64_t)num_entries * line_bytes);
+	if (need > vblkdev->cache_ivmk->size)
+		goto invalid;
+
+	vblkdev->cache_line_blks = line_blks;
+	vblkdev->cache_num_entries = num_entries;
+	vblkdev->cache_data_offset = data_offset;
+
+	dev_info(vblkdev->device,
+		"shared block cache: %u lines of %u blocks\n",
+		num_entries, line_blks);
+	return;
+
+invalid:
+	dev_warn(vblkdev->device, "Invalid shared cache header, disabling\n");
+	vblkdev->cache_base = NULL;
+}
+
+/**
+ * vblk_try_cache_read: Serve a read request from the shared read-only
+ *		block cache, if the requested range is held by a
+ *		consistent cache line. The server may refill or
+ *		invalidate a line at any time, so the entry generation
+ *		is checked again after the copy; on any inconsistency
+ *		the caller falls back to a regular IVC read. Returns
+ *		true when the request was completed from the cache.
+ */
+static bool vblk_try_cache_read(struct vblk_dev *vblkdev,
+		struct request *bio_req)
+{
+	struct vs_cache_entry *entry;
+	struct bio_vec bvec;
+	struct req_iterator iter;
+	uint32_t hardblk_size = vblkdev->config.blk_config.hardblk_size;
+	uint32_t line_blks = vblkdev->cache_line_blks;
+	uint64_t start_blk;
+	uint64_t num_blks;
+	uint64_t line_idx;
+	uint64_t entry_offset;
+	uint32_t entry_blks;
+	uint32_t gen;
+	void *line_data;
+	size_t line_off;
+	size_t total_size = 0;
+	size_t size;
+	void *buffer;
+
+	if (vblkdev->cache_base == NULL)
+		return false;
+
+	start_blk = ((blk_rq_pos(bio_req) * (uint64_t)SECTOR_SIZE) /
+		hardblk_size);
+	num_blks = (blk_rq_bytes(bio_req) / hardblk_size);
+
+	/* Only ranges contained in a single cache line are looked up */
+	if ((num_blks == 0) || (num_blks > line_blks) ||
+		((start_blk / line_blks) !=
+		((start_blk + num_blks - 1) / line_blks)))
+		return false;
+
+	line_idx = ((start_blk / line_blks) % vblkdev->cache_num_entries);
+	entry = (struct vs_cache_entry *)(vblkdev->cache_base +
+		sizeof(struct vs_cache_header)) + line_idx;
+
+	gen = READ_ONCE(entry->generation);
+	if ((gen & 1) != 0)
+		goto miss;
+
+	/* Pairs with the server's barrier between filling a line and
+	 * publishing its even generation */
+	smp_rmb();
+
+	/* The entry can be torn while the server updates it; the final
+	 * generation check rejects any copy based on stale fields */
+	entry_offset = READ_ONCE(entry->blk_offset);
+	entry_blks = READ_ONCE(entry->num_blks);
+
+	if ((entry_blks > line_blks) ||
+		(entry_offset > start_blk) ||
+		((entry_offset + entry_blks) < (start_blk + num_blks)))
+		goto miss;
+
+	line_data = vblkdev->cache_base + vblkdev->cache_data_offset +
+		(line_idx * (uint64_t)line_blks * hardblk_size);
+	line_off = ((start_blk - entry_offset) * hardblk_size);
+
+	rq_for_each_segment(bvec, bio_req, iter) {
+		size = bvec.bv_len;
+		buffer = page_address(bvec.bv_page) + bvec.bv_offset;
+
+		if ((total_size + size) > (num_blks * hardblk_size))
+			size = (num_blks * hardblk_size) - total_size;
+
+		memcpy(buffer, line_data + line_off + total_size, size);
+
+		total_size += size;
+		if (total_size == (num_blks * hardblk_size))
+			break;
+	}
+
+	smp_rmb();
+	if (READ_ONCE(entry->generation) != gen)
+		goto miss;
+
+	/* Lookups are serialized by ivc_lock, so the counters need no
+	 * extra protection */
+	vblkdev->cache_hits++;
+	return true;
+
+miss:
+	vblkdev->cache_misses++;
+	return false;
+}
+
 /**
  * submit_bio_req: Fetch a bio request and submit it to
  * server for processing.
@@ -458,7 +714,9 @@ static bool submit_bio_req(struct vblk_dev *vblkdev)
 	void *buffer;
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 9, 0)
 	struct req_entry *entry = NULL;
+	uint32_t i;
 #endif
+	uint32_t extra_sectors = 0;
 	size_t sz;
 	uint32_t sg_cnt;
 	dma_addr_t  sg_dma_addr = 0;
@@ -493,6 +751,21 @@ static bool submit_bio_req(struct vblk_dev *vblkdev)
 	if (bio_req == NULL)
 		goto bio_exit;
 
+	if ((req_op(bio_req) == REQ_OP_READ) &&
+		vblk_try_cache_read(vblkdev, bio_req)) {
+		/* Completed from the shared cache, no IVC round trip */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 9, 0)
+		blk_mq_end_request(bio_req, BLK_STS_OK);
+#else
+		if (blk_end_request(bio_req, 0, blk_rq_bytes(bio_req))) {
+			dev_err(vblkdev->device,
+				"Error completing cached request!\n");
+		}
+#endif
+		vblk_put_req(vsc_req);
+		return true;
+	}
+
 	if ((vblkdev->config.blk_config.use_vm_address) &&
 		((req_op(bio_req) == REQ_OP_READ) ||
 		(req_op(bio_req) == REQ_OP_WRITE))) {
@@ -553,10 +826,16 @@ static bool submit_bio_req(struct vblk_dev *vblkdev)
 				goto bio_exit;
 			}
 
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 9, 0)
+			extra_sectors = vblk_coalesce_next_reqs(vblkdev,
+					vsc_req, bio_req);
+#endif
+
 			vs_req->blkdev_req.blk_req.blk_offset = ((blk_rq_pos(bio_req) *
 				(uint64_t)SECTOR_SIZE)
 				/ vblkdev->config.blk_config.hardblk_size);
-			vs_req->blkdev_req.blk_req.num_blks = ((blk_rq_sectors(bio_req) *
+			vs_req->blkdev_req.blk_req.num_blks =
+				(((blk_rq_sectors(bio_req) + extra_sectors) *
 				SECTOR_SIZE) /
 				vblkdev->config.blk_config.hardblk_size);
 
@@ -601,6 +880,28 @@ static bool submit_bio_req(struct vblk_dev *vblkdev)
 					break;
 				}
 			}
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 9, 0)
+			/* Append the data of the batched requests behind
+			 * the primary request's data in the mempool */
+			for (i = 0; i < vsc_req->num_coalesced; i++) {
+				struct req_iterator c_iter;
+
+				rq_for_each_segment(bvec,
+						vsc_req->coalesced[i],
+						c_iter) {
+					size = bvec.bv_len;
+					buffer = page_address(bvec.bv_page) +
+							bvec.bv_offset;
+
+					memcpy(
+					vsc_req->mempool_virt + total_size,
+					buffer, size);
+
+					total_size += size;
+				}
+			}
+#endif
 		}
 	} else {
 		if (vblk_prep_ioctl_req(vblkdev,
@@ -628,6 +929,9 @@ static bool submit_bio_req(struct vblk_dev *vblkdev)
 
 bio_exit:
 	if (vsc_req != NULL) {
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 9, 0)
+		vblk_end_coalesced(vblkdev, vsc_req, true);
+#endif
 		vblk_put_req(vsc_req);
 	}
 
@@ -822,6 +1126,30 @@ vblk_speed_mode_show(struct device *dev, struct device_attribute *attr,
 	return snprintf(buf, 32, "%s\n", vblk->config.speed_mode);
 }
 
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 9, 0)
+static ssize_t
+vblk_coalesced_show(struct device *dev, struct device_attribute *attr,
+			 char *buf)
+{
+	struct gendisk *disk = dev_to_disk(dev);
+	struct vblk_dev *vblk = disk->private_data;
+
+	return snprintf(buf, 64, "writes %llu discards %llu\n",
+			vblk->coalesced_writes, vblk->coalesced_discards);
+}
+#endif
+
+static ssize_t
+vblk_shared_cache_show(struct device *dev, struct device_attribute *attr,
+			 char *buf)
+{
+	struct gendisk *disk = dev_to_disk(dev);
+	struct vblk_dev *vblk = disk->private_data;
+
+	return snprintf(buf, 64, "hits %llu misses %llu\n",
+			vblk->cache_hits, vblk->cache_misses);
+}
+
 static const struct device_attribute dev_attr_phys_dev_ro =
 	__ATTR(phys_dev, 0444,
 	       vblk_phys_dev_show, NULL);
@@ -838,6 +1166,16 @@ static const struct device_attribute dev_attr_speed_mode_ro =
 	__ATTR(speed_mode, 0444,
 	       vblk_speed_mode_show, NULL);
 
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 9, 0)
+static const struct device_attribute dev_attr_coalesced_ro =
+	__ATTR(coalesced, 0444,
+	       vblk_coalesced_show, NULL);
+#endif
+
+static const struct device_attribute dev_attr_shared_cache_ro =
+	__ATTR(shared_cache, 0444,
+	       vblk_shared_cache_show, NULL);
+
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 9, 0)
 static const struct blk_mq_ops vblk_mq_ops = {
 	.queue_rq	= vblk_request,
@@ -855,6 +1193,8 @@ static void setup_device(struct vblk_dev *vblkdev)
 		vblkdev->config.blk_config.num_blks *
 			vblkdev->config.blk_config.hardblk_size;
 
+	vblk_cache_setup(vblkdev);
+
 	spin_lock_init(&vblkdev->lock);
 	spin_lock_init(&vblkdev->queue_lock);
 	mutex_init(&vblkdev->ioctl_lock);
@@ -1073,6 +1413,20 @@ static void setup_device(struct vblk_dev *vblkdev)
 		dev_warn(vblkdev->device, "Error adding speed_mode file!\n");
 		return;
 	}
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 9, 0)
+	if (device_create_file(disk_to_dev(vblkdev->gd),
+		&dev_attr_coalesced_ro)) {
+		dev_warn(vblkdev->device, "Error adding coalesced file!\n");
+		return;
+	}
+#endif
+
+	if (device_create_file(disk_to_dev(vblkdev->gd),
+		&dev_attr_shared_cache_ro)) {
+		dev_warn(vblkdev->device, "Error adding shared cache file!\n");
+		return;
+	}
 }
 
 static void vblk_init_device(struct work_struct *ws)
@@ -1184,6 +1538,27 @@ static int tegra_hv_vblk_probe(struct platform_device *pdev)
 		goto free_mempool;
 	}
 
+	/* The shared read-only block cache mempool is optional; the
+	 * device works without it, paying an IVC round trip per read
+	 */
+	if (of_property_read_u32_index(vblk_node, "read-cache-mempool", 0,
+		&(vblkdev->cache_ivm_id)) == 0) {
+		ivmk = tegra_hv_mempool_reserve(vblkdev->cache_ivm_id);
+		if (IS_ERR_OR_NULL(ivmk)) {
+			dev_warn(dev, "Failed to reserve cache IVM %d\n",
+				vblkdev->cache_ivm_id);
+		} else {
+			vblkdev->cache_ivmk = ivmk;
+			vblkdev->cache_base = devm_memremap(vblkdev->device,
+					ivmk->ipa, ivmk->size, MEMREMAP_WB);
+			if (IS_ERR_OR_NULL(vblkdev->cache_base)) {
+				dev_warn(dev, "Failed to map cache IVM %d\n",
+						vblkdev->cache_ivm_id);
+				vblkdev->cache_base = NULL;
+			}
+		}
+	}
+
 	vblkdev->initialized = false;
 
 	vblkdev->wq = alloc_workqueue("vblk_req_wq%d",
@@ -1226,6 +1601,8 @@ free_wq:
 
 free_mempool:
 	tegra_hv_mempool_unreserve(vblkdev->ivmk);
+	if (vblkdev->cache_ivmk)
+		tegra_hv_mempool_unreserve(vblkdev->cache_ivmk);
 
 free_ivc:
 	tegra_hv_ivc_unreserve(vblkdev->ivck);
@@ -1249,6 +1626,8 @@ static int tegra_hv_vblk_remove(struct platform_device *pdev)
 	destroy_workqueue(vblkdev->wq);
 	tegra_hv_ivc_unreserve(vblkdev->ivck);
 	tegra_hv_mempool_unreserve(vblkdev->ivmk);
+	if (vblkdev->cache_ivmk)
+		tegra_hv_mempool_unreserve(vblkdev->cache_ivmk);
 
 	return 0;
 }
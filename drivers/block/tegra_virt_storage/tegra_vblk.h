@@ -43,6 +43,9 @@
 
 #define MAX_VSC_REQS 32
 
+/* Maximum number of adjacent bio requests merged into one IVC request */
+#define VBLK_MAX_COALESCED_REQS 8
+
 struct vblk_ioctl_req {
 	uint32_t ioctl_id;
 	void *ioctl_buf;
@@ -70,6 +73,12 @@ struct vsc_request {
 	/* Scatter list for maping IOVA address */
 	struct scatterlist *sg_lst;
 	int sg_num_ents;
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5,9,0)
+	/* Adjacent write/discard requests batched behind req into
+	 * this transfer */
+	struct request *coalesced[VBLK_MAX_COALESCED_REQS];
+	uint32_t num_coalesced;
+#endif
 };
 
 enum vblk_queue_state {
@@ -97,6 +106,17 @@ struct vblk_dev {
 	uint32_t ivm_id;
 	struct tegra_hv_ivc_cookie *ivck;
 	struct tegra_hv_ivm_cookie *ivmk;
+	/* Optional shared read-only block cache, see vs_cache_header */
+	uint32_t cache_ivm_id;
+	struct tegra_hv_ivm_cookie *cache_ivmk;
+	void *cache_base;
+	/* Cache geometry validated and snapshotted at setup time; the
+	 * server-writable header is not trusted after that */
+	uint32_t cache_line_blks;
+	uint32_t cache_num_entries;
+	uint64_t cache_data_offset;
+	uint64_t cache_hits;
+	uint64_t cache_misses;
 	uint32_t devnum;
 	bool initialized;
 	struct work_struct init;
@@ -114,6 +134,10 @@ struct vblk_dev {
 	struct mutex ivc_lock;
 	enum vblk_queue_state queue_state;
 	struct completion req_queue_empty;
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5,9,0)
+	uint64_t coalesced_writes;
+	uint64_t coalesced_discards;
+#endif
 };
 
 int vblk_complete_ioctl_req(struct vblk_dev *vblkdev,
@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Multi-clock rate transactions.
+ *
+ * Pipeline mode switches retarget several clocks at once; doing that
+ * with bare clk_set_rate() calls applies the changes in whatever order
+ * the caller wrote them, discovers rejected rates only midway through,
+ * and leaves consumers running on half-switched intermediate states.
+ * A transaction stages the new rates, validates all of them before any
+ * hardware is touched, and commits rate raises before rate drops so no
+ * clock ever runs below both its old and its new rate. A commit that
+ * fails midway rolls the already-changed clocks back to their previous
+ * rates.
+ *
+ * Each rate change is still an individual clk_set_rate() under the hood;
+ * neither the common clock framework nor the BPMP MRQ_CLK ABI offers a
+ * batched commit, so the transaction minimizes intermediate states
+ * rather than eliminating them.
+ */
+
+#include <linux/clk.h>
+#include <linux/err.h>
+#include <linux/export.h>
+#include <linux/kernel.h>
+#include <linux/tegra-clk-txn.h>
+
+/**
+ * tegra_clk_txn_init - prepare a transaction over caller-provided storage
+ */
+int tegra_clk_txn_init(struct tegra_clk_txn *txn,
+		       struct tegra_clk_txn_entry *entries,
+		       unsigned int max_entries)
+{
+	if (!txn || !entries || !max_entries)
+		return -EINVAL;
+
+	txn->entries = entries;
+	txn->max_entries = max_entries;
+	txn->num_entries = 0;
+	txn->validated = false;
+
+	return 0;
+}
+EXPORT_SYMBOL(tegra_clk_txn_init);
+
+/**
+ * tegra_clk_txn_stage - add a rate change to the transaction
+ *
+ * Staging only records the request; nothing is validated or applied
+ * until tegra_clk_txn_validate() or tegra_clk_txn_commit().
+ */
+int tegra_clk_txn_stage(struct tegra_clk_txn *txn, struct clk *clk,
+			unsigned long rate)
+{
+	unsigned int i;
+
+	if (!txn || !txn->entries || IS_ERR_OR_NULL(clk))
+		return -EINVAL;
+
+	if (txn->num_entries >= txn->max_entries)
+		return -ENOSPC;
+
+	for (i = 0; i < txn->num_entries; i++) {
+		if (clk_is_match(txn->entries[i].clk, clk))
+			return -EBUSY;
+	}
+
+	txn->entries[txn->num_entries].clk = clk;
+	txn->entries[txn->num_entries].rate = rate;
+	txn->num_entries++;
+	txn->validated = false;
+
+	return 0;
+}
+EXPORT_SYMBOL(tegra_clk_txn_stage);
+
+/**
+ * tegra_clk_txn_validate - round all staged rates without applying them
+ *
+ * Fails before any clock is touched if one of the staged rates cannot
+ * be satisfied, so a rejected mode switch leaves the pipeline on its
+ * current rates.
+ */
+int tegra_clk_txn_validate(struct tegra_clk_txn *txn)
+{
+	unsigned int i;
+	long rounded;
+
+	if (!txn || !txn->entries)
+		return -EINVAL;
+
+	for (i = 0; i < txn->num_entries; i++) {
+		struct tegra_clk_txn_entry *e = &txn->entries[i];
+
+		rounded = clk_round_rate(e->clk, e->rate);
+		if (rounded <= 0)
+			return rounded ? (int)rounded : -EINVAL;
+		e->rounded = rounded;
+	}
+
+	txn->validated = true;
+
+	return 0;
+}
+EXPORT_SYMBOL(tegra_clk_txn_validate);
+
+static int tegra_clk_txn_apply(struct tegra_clk_txn *txn, bool raises)
+{
+	unsigned int i;
+	int err;
+
+	for (i = 0; i < txn->num_entries; i++) {
+		struct tegra_clk_txn_entry *e = &txn->entries[i];
+
+		if ((e->rounded >= e->saved) != raises)
+			continue;
+
+		err = clk_set_rate(e->clk, e->rate);
+		if (err)
+			return err;
+	}
+
+	return 0;
+}
+
+/**
+ * tegra_clk_txn_commit - apply all staged rate changes
+ *
+ * Validates first if the caller has not, then applies rate raises in
+ * staging order followed by rate drops, so consumers never see a clock
+ * below both its old and its new rate. On failure every clock already
+ * changed is returned to its previous rate and the transaction is left
+ * staged for inspection; on success the transaction is emptied for
+ * reuse.
+ */
+int tegra_clk_txn_commit(struct tegra_clk_txn *txn)
+{
+	unsigned int i;
+	int err;
+
+	if (!txn || !txn->entries)
+		return -EINVAL;
+
+	if (!txn->validated) {
+		err = tegra_clk_txn_validate(txn);
+		if (err)
+			return err;
+	}
+
+	for (i = 0; i < txn->num_entries; i++) {
+		struct tegra_clk_txn_entry *e = &txn->entries[i];
+
+		e->saved = clk_get_rate(e->clk);
+	}
+
+	err = tegra_clk_txn_apply(txn, true);
+	if (!err)
+		err = tegra_clk_txn_apply(txn, false);
+
+	if (err) {
+		/* best-effort rollback of the entries already applied */
+		for (i = 0; i < txn->num_entries; i++) {
+			struct tegra_clk_txn_entry *e = &txn->entries[i];
+
+			if (clk_get_rate(e->clk) != e->saved)
+				clk_set_rate(e->clk, e->saved);
+		}
+		return err;
+	}
+
+	txn->num_entries = 0;
+	txn->validated = false;
+
+	return 0;
+}
+EXPORT_SYMBOL(tegra_clk_txn_commit);
@@ -78,6 +78,8 @@ struct cc3_params {
 
 struct per_cluster_data {
 	struct cpufreq_frequency_table *clft;
+	/* clamped ndiv per clft index, precomputed at table init */
+	uint16_t *ndiv_tbl;
 	struct mrq_cpu_ndiv_limits_response ndiv_limits_tbl;
 	struct tegra_bwmgr_client *bwmgr;
 	struct cpumask cpu_mask;
@@ -271,6 +273,28 @@ static void write_ndiv_request(void *val)
 	}
 }
 
+/*
+ * ndiv requests posted to a remote core. The request register is
+ * core-local, so the value is parked here and applied by a no-wait
+ * IPI; last writer wins. This keeps the set path free of cross-CPU
+ * locking and of spinning until the remote write has retired.
+ */
+static DEFINE_PER_CPU(uint64_t, posted_ndiv);
+
+static void write_posted_ndiv_request(void *unused)
+{
+	uint64_t val = this_cpu_read(posted_ndiv);
+
+	write_ndiv_request(&val);
+}
+
+/* Post an ndiv request to a cpu without waiting for it to apply */
+static void post_ndiv_request(uint32_t cpu, uint16_t ndiv)
+{
+	WRITE_ONCE(per_cpu(posted_ndiv, cpu), (uint64_t)ndiv);
+	smp_call_function_single(cpu, write_posted_ndiv_request, NULL, 0);
+}
+
 #ifdef CONFIG_DEBUG_FS
 /* Read freq request in ndiv for a cpu */
 static void read_ndiv_request(void *ret)
@@ -331,6 +355,7 @@ struct mrq_cpu_ndiv_limits_response *get_ndiv_limits(enum cluster cl)
  */
 static int tegra194_set_speed(struct cpufreq_policy *policy, unsigned int index)
 {
+	uint16_t cl_ndiv[MAX_CLUSTERS] = { 0 };
 	struct cpufreq_frequency_table *ftbl;
 	struct cpufreq_freqs freqs;
 	uint32_t tgt_freq;
@@ -357,8 +382,32 @@ static int tegra194_set_speed(struct cpufreq_policy *policy, unsigned int index)
 
 	cl = get_cpu_cluster(policy->cpu);
 
-	for_each_cpu_and(cpu, policy->cpus, cpu_online_mask)
-		tegra_update_cpu_speed(tgt_freq, cpu);
+	/*
+	 * The ndiv for the policy's own cluster comes from the table
+	 * precomputed next to the frequency table. With a single policy
+	 * spanning clusters, other clusters' tables need not line up
+	 * with this index, so their ndiv is computed once from the
+	 * target frequency and reused for each of their cpus.
+	 */
+	for_each_cpu_and(cpu, policy->cpus, cpu_online_mask) {
+		enum cluster ccl = get_cpu_cluster(cpu);
+		struct mrq_cpu_ndiv_limits_response *nltbl =
+			&tfreq_data.pcluster[ccl].ndiv_limits_tbl;
+
+		if (!nltbl->ref_clk_hz)
+			continue;
+
+		if (!cl_ndiv[ccl]) {
+			if (ccl == cl && tfreq_data.pcluster[ccl].ndiv_tbl)
+				cl_ndiv[ccl] =
+					tfreq_data.pcluster[ccl].ndiv_tbl[index];
+			else
+				cl_ndiv[ccl] = clamp_ndiv(nltbl,
+					map_freq_to_ndiv(nltbl, tgt_freq));
+		}
+
+		post_ndiv_request(cpu, cl_ndiv[ccl]);
+	}
 
 	if (tfreq_data.pcluster[cl].bwmgr)
 		set_cpufreq_to_emcfreq(cl, tgt_freq);
@@ -507,6 +556,62 @@ static int get_ndiv(void *data, u64 *ndiv)
 
 DEFINE_SIMPLE_ATTRIBUTE(ndiv_fops, get_ndiv, set_ndiv, "%04llx\n");
 
+/*
+ * Batched frequency request: one write sets every cluster. Accepts up
+ * to MAX_CLUSTERS space-separated frequencies in kHz, one per cluster
+ * in cluster order; 0 or a missing value leaves that cluster alone.
+ * Requests are posted to each online core without waiting, so a
+ * userspace governor running at 100Hz per cluster pays one syscall
+ * and no IPI round trips.
+ */
+static ssize_t freq_req_all_write(struct file *file, const char __user *buf,
+				  size_t count, loff_t *ppos)
+{
+	uint32_t freq[MAX_CLUSTERS] = { 0 };
+	struct mrq_cpu_ndiv_limits_response *nltbl;
+	char kbuf[64];
+	uint16_t ndiv;
+	enum cluster cl;
+	int cpu;
+
+	if (count >= sizeof(kbuf))
+		return -EINVAL;
+
+	if (copy_from_user(kbuf, buf, count))
+		return -EFAULT;
+	kbuf[count] = '\0';
+
+	if (sscanf(kbuf, "%u %u %u %u",
+		   &freq[CLUSTER0], &freq[CLUSTER1],
+		   &freq[CLUSTER2], &freq[CLUSTER3]) < 1)
+		return -EINVAL;
+
+	get_online_cpus();
+	LOOP_FOR_EACH_CLUSTER(cl) {
+		if (!freq[cl] || !tfreq_data.pcluster[cl].configured)
+			continue;
+
+		nltbl = &tfreq_data.pcluster[cl].ndiv_limits_tbl;
+		if (!nltbl->ref_clk_hz)
+			continue;
+
+		ndiv = clamp_ndiv(nltbl, map_freq_to_ndiv(nltbl, freq[cl]));
+
+		for_each_cpu_and(cpu, &tfreq_data.pcluster[cl].cpu_mask,
+				 cpu_online_mask)
+			post_ndiv_request(cpu, ndiv);
+	}
+	put_online_cpus();
+
+	return count;
+}
+
+static const struct file_operations freq_req_all_fops = {
+	.open = simple_open,
+	.write = freq_req_all_write,
+	.llseek = default_llseek,
+};
+
 static void dump_ndiv_limits_tbl(struct seq_file *s,
 				struct mrq_cpu_ndiv_limits_response *nlt)
 {
@@ -686,6 +791,12 @@ static int __init tegra_cpufreq_debug_init(void)
 					&freq_compute_fops))
 		goto err_out;
 
+	if (!debugfs_create_file("freq_req_all", S_IWUSR,
+				 tegra_cpufreq_debugfs_root,
+					NULL,
+					&freq_req_all_fops))
+		goto err_out;
+
 	if (!tegra_debugfs_create_cpu_emc_map(tegra_cpufreq_debugfs_root,
 					cpu_emc_map_ptr))
 		goto err_out;
@@ -882,8 +993,9 @@ static void free_resources(void)
 		if (!tfreq_data.pcluster[cl].configured)
 			continue;
 
-		/* free table */
+		/* free tables */
 		kfree(tfreq_data.pcluster[cl].clft);
+		kfree(tfreq_data.pcluster[cl].ndiv_tbl);
 
 		/* unregister from emc bw manager */
 		tegra_bwmgr_unregister(tfreq_data.pcluster[cl].bwmgr);
@@ -910,6 +1022,7 @@ static int __init init_freqtbls(struct device_node *dn)
 	struct cpufreq_frequency_table *ftbl;
 	struct mrq_cpu_ndiv_limits_response *nltbl;
 	u16 ndiv, max_freq_steps, delta_ndiv;
+	uint16_t *ndivtbl;
 	enum cluster cl;
 	int ret = 0, index;
 
@@ -972,24 +1085,42 @@ static int __init init_freqtbls(struct device_node *dn)
 			(max_freq_steps + 1), GFP_KERNEL);
 		if (!ftbl) {
 			ret = -ENOMEM;
-			while (cl--)
-				kfree(tfreq_data.pcluster[cl].clft);
-			goto err_out;
+			goto err_free_tbls;
+		}
+
+		/* ndiv per table index, so the set path needs no mapping */
+		ndivtbl = kzalloc(sizeof(uint16_t) * (max_freq_steps + 1),
+				  GFP_KERNEL);
+		if (!ndivtbl) {
+			kfree(ftbl);
+			ret = -ENOMEM;
+			goto err_free_tbls;
 		}
 
 		for (index = 0, ndiv = nltbl->ndiv_min;
 				ndiv < nltbl->ndiv_max;
-				index++, ndiv += freq_table_step_size)
+				index++, ndiv += freq_table_step_size) {
 			ftbl[index].frequency = map_ndiv_to_freq(nltbl, ndiv);
+			ndivtbl[index] = ndiv;
+		}
 
+		ndivtbl[index] = nltbl->ndiv_max;
 		ftbl[index++].frequency = map_ndiv_to_freq(nltbl,
 							   nltbl->ndiv_max);
 		ftbl[index].frequency = CPUFREQ_TABLE_END;
 
 		tfreq_data.pcluster[cl].clft = ftbl;
+		tfreq_data.pcluster[cl].ndiv_tbl = ndivtbl;
+	}
+
+	return 0;
+
+err_free_tbls:
+	while (cl--) {
+		kfree(tfreq_data.pcluster[cl].clft);
+		kfree(tfreq_data.pcluster[cl].ndiv_tbl);
 	}
 
-err_out:
 	return ret;
 }
 
@@ -129,6 +129,8 @@ struct cc3_params {
 
 struct per_cluster_data {
 	struct cpufreq_frequency_table *clft;
+	/* EDVD hint per clft index, precomputed at table init */
+	uint32_t *edvd_hint;
 	void __iomem *edvd_pub;
 	struct cpu_vhint_table dvfs_tbl;
 	struct tegra_bwmgr_client *bwmgr;
@@ -314,30 +316,17 @@ static struct cpufreq_frequency_table *get_freqtable(uint8_t cpu)
 }
 
 /**
- * tegra_update_cpu_speed - update cpu freq
+ * compute_ndiv_vhint - compose EDVD ndiv/vindex hint for a rate
+ * @vhtbl - vhint table of the target cluster
  * @rate - in kHz
- * @cpu - cpu whose freq to be updated
- * Returns 0 on success, -ve on failure
+ * Returns the EDVD register value requesting <rate>
  */
-static void tegra_update_cpu_speed(uint32_t rate, uint8_t cpu)
+static uint32_t compute_ndiv_vhint(struct cpu_vhint_table *vhtbl,
+	uint32_t rate)
 {
-	struct cpu_vhint_table *vhtbl;
-	uint32_t val = 0, phy_cpu;
-	int cur_cl;
+	uint32_t val = 0;
 	uint16_t ndiv;
 	int8_t vindx;
-	spinlock_t *slock = &per_cpu(pcpu_slock, cpu);
-
-	cur_cl = tegra18_logical_to_cluster(cpu);
-	vhtbl = &tfreq_data.pcluster[cur_cl].dvfs_tbl;
-
-	/*
-	 * LUT for this cluster is not present.
-	 * Could be single cluster or n cluster chip but for <cur_cl>,
-	 * current cluster LUT is not sent by BPMP.
-	 */
-	if (!vhtbl->lut)
-		return;
 
 	rate *= vhtbl->pdiv * vhtbl->mdiv;
 	ndiv = (rate * KHZ_TO_HZ) / vhtbl->ref_clk_hz;
@@ -359,6 +348,56 @@ static void tegra_update_cpu_speed(uint32_t rate, uint8_t cpu)
 		vindx = vhtbl->vindex_mult * vindx / vhtbl->vindex_div;
 
 	val |= (vindx << EDVD_COREX_VINDEX_VAL_SHIFT);
+
+	return val;
+}
+
+/**
+ * tegra_update_cpu_hint - write a precomputed EDVD hint
+ * @cpu - cpu whose freq to be updated
+ * @hint - EDVD register value as built by compute_ndiv_vhint()
+ *
+ * Lockless fast path for set_target: the hint is a single 32 bit
+ * register store and target requests are serialized per policy by the
+ * cpufreq core, so no lock is taken here. The debugfs hint writers
+ * keep the per-cpu spinlock; last_hint may briefly lag the register,
+ * which at worst makes a CC6 exit replay a hint one request old.
+ */
+static void tegra_update_cpu_hint(uint8_t cpu, uint32_t hint)
+{
+	int cur_cl = tegra18_logical_to_cluster(cpu);
+	uint32_t phy_cpu = logical_to_phys_map(cpu);
+
+	tcpufreq_writel(hint, tfreq_data.pcluster[cur_cl].edvd_pub +
+		EDVD_CL_NDIV_VHINT_OFFSET, phy_cpu);
+	WRITE_ONCE(tfreq_data.last_hint[cpu], hint);
+}
+
+/**
+ * tegra_update_cpu_speed - update cpu freq
+ * @rate - in kHz
+ * @cpu - cpu whose freq to be updated
+ * Returns 0 on success, -ve on failure
+ */
+static void tegra_update_cpu_speed(uint32_t rate, uint8_t cpu)
+{
+	struct cpu_vhint_table *vhtbl;
+	uint32_t val, phy_cpu;
+	int cur_cl;
+	spinlock_t *slock = &per_cpu(pcpu_slock, cpu);
+
+	cur_cl = tegra18_logical_to_cluster(cpu);
+	vhtbl = &tfreq_data.pcluster[cur_cl].dvfs_tbl;
+
+	/*
+	 * LUT for this cluster is not present.
+	 * Could be single cluster or n cluster chip but for <cur_cl>,
+	 * current cluster LUT is not sent by BPMP.
+	 */
+	if (!vhtbl->lut)
+		return;
+
+	val = compute_ndiv_vhint(vhtbl, rate);
 	phy_cpu = logical_to_phys_map(cpu);
 
 	spin_lock(slock);
@@ -412,8 +451,21 @@ static int tegra186_cpufreq_set_target(struct cpufreq_policy *policy,
 			tegra_update_cpu_speed_hv(tgt_freq, policy->cpu);
 
 		for_each_cpu(cpu, policy->cpus) {
-			if (!tegra_cpufreq_hv_mode)
-				tegra_update_cpu_speed(tgt_freq, cpu);
+			if (!tegra_cpufreq_hv_mode) {
+				int ccl = tegra18_logical_to_cluster(cpu);
+				uint32_t *hints =
+					tfreq_data.pcluster[ccl].edvd_hint;
+
+				/*
+				 * Policies are per cluster so <index> is
+				 * valid against the cpu's own hint table.
+				 */
+				if (hints)
+					tegra_update_cpu_hint(cpu,
+						hints[index]);
+				else
+					tegra_update_cpu_speed(tgt_freq, cpu);
+			}
 			/*
 			 * Update the freq data for each cpu regardless
 			 * hypervisor or native mode.
@@ -1079,8 +1131,9 @@ static void free_resources(struct device *dev)
 		/* free ndiv_to_vindex mem */
 		kfree(tfreq_data.pcluster[cl].dvfs_tbl.vindx);
 
-		/* free table */
+		/* free tables */
 		kfree(tfreq_data.pcluster[cl].clft);
+		kfree(tfreq_data.pcluster[cl].edvd_hint);
 
 		/* unregister from emc bw manager */
 		tegra_bwmgr_unregister(tfreq_data.pcluster[cl].bwmgr);
@@ -1098,7 +1151,8 @@ static int __init init_freqtbls(struct device_node *dn)
 	struct cpufreq_frequency_table *ftbl;
 	struct cpu_vhint_table *vhtbl;
 	u16 ndiv, max_freq_steps, delta_ndiv;
-	int cl;
+	uint32_t *hinttbl;
+	int cl, i;
 	int ret = 0, index;
 
 	if (!of_property_read_u16(dn, "freq_table_step_size",
@@ -1142,9 +1196,7 @@ static int __init init_freqtbls(struct device_node *dn)
 			(max_freq_steps + 1), GFP_KERNEL);
 		if (!ftbl) {
 			ret = -ENOMEM;
-			while (cl--)
-				kfree(tfreq_data.pcluster[cl].clft);
-			goto err_out;
+			goto err_free_tbls;
 		}
 
 		for (index = 0, ndiv = vhtbl->ndiv_min;
@@ -1160,10 +1212,32 @@ static int __init init_freqtbls(struct device_node *dn)
 
 		ftbl[index].frequency = CPUFREQ_TABLE_END;
 
+		/*
+		 * Precompute the EDVD hint per table index so that
+		 * set_target skips the ndiv/vindex walk on every request.
+		 */
+		hinttbl = kzalloc(sizeof(uint32_t) * index, GFP_KERNEL);
+		if (!hinttbl) {
+			ret = -ENOMEM;
+			kfree(ftbl);
+			goto err_free_tbls;
+		}
+
+		for (i = 0; i < index; i++)
+			hinttbl[i] = compute_ndiv_vhint(vhtbl,
+				ftbl[i].frequency);
+
 		tfreq_data.pcluster[cl].clft = ftbl;
+		tfreq_data.pcluster[cl].edvd_hint = hinttbl;
 	}
 
-err_out:
+	return 0;
+
+err_free_tbls:
+	while (cl--) {
+		kfree(tfreq_data.pcluster[cl].clft);
+		kfree(tfreq_data.pcluster[cl].edvd_hint);
+	}
 	return ret;
 }
 
@@ -40,6 +40,8 @@
 #include <linux/version.h>
 #include <linux/cpuhotplug.h>
 #include <linux/atomic.h>
+#include <linux/topology.h>
+#include <linux/seq_file.h>
 #include <linux/platform/tegra/t19x-cpuidle.h>
 
 #define CREATE_TRACE_POINTS
@@ -103,6 +105,126 @@ static enum cpuhp_state hp_state;
 #define T19x_NVG_CROSSOVER_C6	TEGRA_NVG_CHANNEL_CROSSOVER_C6_LOWER_BOUND
 #define T19x_NVG_CROSSOVER_CC6	TEGRA_NVG_CHANNEL_CROSSOVER_CC6_LOWER_BOUND
 
+/*
+ * Cluster coordinated CC6 promotion.
+ *
+ * MCE promotes a cluster to CC6 from the per-core wake time hints
+ * alone, so staggered short wakeups across siblings can repeatedly
+ * power gate the cluster only to bring it back up before the entry
+ * cost is amortized. Track the recent idle residency of every core
+ * and hint a wake time below the CC6 crossover unless the predicted
+ * residual idle of the whole cluster clears the break-even threshold.
+ */
+#define COORD_HISTORY_LEN	8
+#define T19x_MAX_CLUSTERS	4
+
+struct coord_cpu_data {
+	u64 idle_start; /* idle entry time, us */
+	u32 history[COORD_HISTORY_LEN]; /* recent idle residency, us */
+	u32 next;
+	u32 predicted; /* min of history, us */
+	bool idle;
+};
+
+struct coord_cluster_stats {
+	atomic64_t cc6_allowed;
+	atomic64_t cc6_blocked;
+};
+
+static DEFINE_PER_CPU(struct coord_cpu_data, coord_data);
+static struct coord_cluster_stats coord_stats[T19x_MAX_CLUSTERS];
+static u32 coordinated_cc6 = 1;
+static u32 cc6_crossover_us;
+static u32 cc6_break_even_us;
+
+static void coord_idle_enter(int cpu)
+{
+	struct coord_cpu_data *cd = &per_cpu(coord_data, cpu);
+
+	cd->idle_start = ktime_to_us(ktime_get());
+	WRITE_ONCE(cd->idle, true);
+}
+
+static void coord_idle_exit(int cpu)
+{
+	struct coord_cpu_data *cd = &per_cpu(coord_data, cpu);
+	u64 now = ktime_to_us(ktime_get());
+	u32 lowest = UINT_MAX;
+	int i;
+
+	WRITE_ONCE(cd->idle, false);
+
+	cd->history[cd->next] = (u32)min_t(u64, now - cd->idle_start,
+						UINT_MAX);
+	cd->next = (cd->next + 1) % COORD_HISTORY_LEN;
+
+	/*
+	 * Predict conservatively from the shortest recent residency; the
+	 * zero-filled history keeps CC6 blocked until a core has real
+	 * samples.
+	 */
+	for (i = 0; i < COORD_HISTORY_LEN; i++)
+		lowest = min(lowest, cd->history[i]);
+	WRITE_ONCE(cd->predicted, lowest);
+}
+
+static u32 coord_cluster_wake_time(int cpu, u32 wake_time_us)
+{
+	struct coord_cpu_data *cd;
+	int cl = topology_physical_package_id(cpu);
+	u32 cluster_idle;
+	u64 now;
+	int sibling;
+
+	if (!coordinated_cc6 || !cc6_crossover_us)
+		return wake_time_us;
+
+	if (cl < 0 || cl >= T19x_MAX_CLUSTERS)
+		return wake_time_us;
+
+	now = ktime_to_us(ktime_get());
+	cluster_idle = READ_ONCE(per_cpu(coord_data, cpu).predicted);
+
+	/*
+	 * The cluster stays in CC6 only while every core is idle, so the
+	 * cluster prediction is the shortest residual idle among online
+	 * siblings; a running sibling pins it to zero. Offline siblings
+	 * are powered off and do not hold the cluster up.
+	 */
+	for_each_cpu_and(sibling, topology_core_cpumask(cpu),
+			cpu_online_mask) {
+		u32 pred, residual = 0;
+		u64 elapsed;
+
+		if (sibling == cpu)
+			continue;
+
+		cd = &per_cpu(coord_data, sibling);
+		if (READ_ONCE(cd->idle)) {
+			pred = READ_ONCE(cd->predicted);
+			elapsed = now - cd->idle_start;
+			residual = elapsed < pred ? pred - elapsed : 0;
+		}
+
+		cluster_idle = min(cluster_idle, residual);
+		if (!cluster_idle)
+			break;
+	}
+
+	if (cluster_idle < cc6_break_even_us) {
+		atomic64_inc(&coord_stats[cl].cc6_blocked);
+		/*
+		 * Hint just below the CC6 crossover so MCE keeps the
+		 * cluster up; the C6 crossover sits lower, so the core
+		 * itself may still be promoted.
+		 */
+		return min(wake_time_us, cc6_crossover_us - 1);
+	}
+
+	atomic64_inc(&coord_stats[cl].cc6_allowed);
+	return wake_time_us;
+}
+
 static bool check_mce_version(void)
 {
 	u32 mce_version_major, mce_version_minor;
@@ -207,6 +329,8 @@ static int t19x_cpu_enter_state(
 			index = forced_idle_state;
 	}
 
+	coord_idle_enter(smp_processor_id());
+
 	if (index == T19x_CPUIDLE_C7_STATE)
 		t19x_cpu_enter_c7(index);
 	else if (index == T19x_CPUIDLE_C6_STATE)
@@ -214,6 +338,8 @@ static int t19x_cpu_enter_state(
 	else
 		asm volatile("wfi\n");
 
+	coord_idle_exit(smp_processor_id());
+
 	return index;
 }
 
@@ -221,7 +347,9 @@ static u32 t19x_make_power_state(u32 state)
 {
 	int cpu = smp_processor_id();
 
-	u32 wake_time = (per_cpu(sleep_time, cpu) + BG_TIME) * tsc_per_usec;
+	u32 wake_time_us = coord_cluster_wake_time(cpu,
+				per_cpu(sleep_time, cpu) + BG_TIME);
+	u32 wake_time = wake_time_us * tsc_per_usec;
 
 	if (testmode || test_c6_exit_latency)
 		wake_time = 0xFFFFEEEE;
@@ -439,6 +567,31 @@ static int cc_state_get(void *data, u64 *val)
 	return 0;
 }
 
+static int coord_stats_show(struct seq_file *s, void *data)
+{
+	int cl;
+
+	for (cl = 0; cl < T19x_MAX_CLUSTERS; cl++)
+		seq_printf(s, "cluster%d: cc6_allowed %llu cc6_blocked %llu\n",
+			cl,
+			(u64)atomic64_read(&coord_stats[cl].cc6_allowed),
+			(u64)atomic64_read(&coord_stats[cl].cc6_blocked));
+
+	return 0;
+}
+
+static int coord_stats_open(struct inode *inode, struct file *file)
+{
+	return single_open(file, coord_stats_show, inode->i_private);
+}
+
+static const struct file_operations coord_stats_fops = {
+	.open		= coord_stats_open,
+	.read		= seq_read,
+	.llseek		= seq_lseek,
+	.release	= single_release,
+};
+
 DEFINE_SIMPLE_ATTRIBUTE(duration_us_fops, NULL, forced_idle_write, "%llu\n");
 DEFINE_SIMPLE_ATTRIBUTE(xover_c6_fops, NULL, c6_xover_write, "%llu\n");
 DEFINE_SIMPLE_ATTRIBUTE(xover_cc6_fops, NULL,
@@ -473,6 +626,18 @@ static int cpuidle_debugfs_init(void)
 
 	if (!dfs_file)
 		goto err_out;
+
+	dfs_file = debugfs_create_u32("coordinated_cc6", 0644,
+		cpuidle_debugfs_node, &coordinated_cc6);
+
+	if (!dfs_file)
+		goto err_out;
+
+	dfs_file = debugfs_create_u32("cc6_break_even_us", 0644,
+		cpuidle_debugfs_node, &cc6_break_even_us);
+
+	if (!dfs_file)
+		goto err_out;
 #else
 	debugfs_create_u64("forced_idle_state", 0644,
 		cpuidle_debugfs_node, &forced_idle_state);
@@ -482,6 +647,12 @@ static int cpuidle_debugfs_init(void)
 
 	debugfs_create_u64("forced_cluster_idle_state", 0644,
 		cpuidle_debugfs_node, &forced_cluster_idle_state);
+
+	debugfs_create_u32("coordinated_cc6", 0644,
+		cpuidle_debugfs_node, &coordinated_cc6);
+
+	debugfs_create_u32("cc6_break_even_us", 0644,
+		cpuidle_debugfs_node, &cc6_break_even_us);
 #endif
 
 	dfs_file = debugfs_create_file("forced_idle_duration_us", 0200,
@@ -510,6 +681,11 @@ static int cpuidle_debugfs_init(void)
 	if (!dfs_file)
 		goto err_out;
 
+	dfs_file = debugfs_create_file("cluster_coord_stats", 0444,
+		cpuidle_debugfs_node, NULL, &coord_stats_fops);
+	if (!dfs_file)
+		goto err_out;
+
 #if LINUX_VERSION_CODE < KERNEL_VERSION(5, 8, 0)
 	dfs_file = debugfs_create_u64("dbg_gpio", 0644, cpuidle_debugfs_node,
 					&dbg_gpio);
@@ -585,9 +761,19 @@ static void send_crossover(void *data)
 	for_each_child_of_node(of_states, child)
 		for (i = 0; i < sizeof(table1)/sizeof(table1[0]); i++) {
 			if (of_property_read_u32(child,
-				table1[i].name, &value) == 0)
+				table1[i].name, &value) == 0) {
 				tegra_mce_update_crossover_time
 					(table1[i].index, value * tsc_per_usec);
+				/*
+				 * The CC6 crossover doubles as the default
+				 * break-even for coordinated promotion.
+				 */
+				if (table1[i].index == T19x_NVG_CROSSOVER_CC6) {
+					cc6_crossover_us = value;
+					if (!cc6_break_even_us)
+						cc6_break_even_us = value;
+				}
+			}
 	}
 }
 
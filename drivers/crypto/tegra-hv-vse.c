@@ -127,6 +127,8 @@ struct tegra_virtual_se_dev {
 	struct skcipher_request *reqs[TEGRA_HV_VSE_MAX_TASKS_PER_SUBMIT];
 	atomic_t ivc_count;
 	int gather_buf_sz;
+	/* AES submit message, reused across submissions under mtx */
+	struct tegra_virtual_se_ivc_msg_t *aes_ivc_msg;
 	/* Engine id */
 	unsigned int engine_id;
 	/* Engine suspend state */
@@ -2092,18 +2094,22 @@ static void tegra_hv_vse_process_new_req(struct tegra_virtual_se_dev *se_dev)
 	struct tegra_vse_tag *priv_data_ptr;
 	union tegra_virtual_se_aes_args *aes;
 
-	priv = devm_kzalloc(se_dev->dev, sizeof(*priv), GFP_KERNEL);
+	/* Allocated per submission and freed on completion, skip devres */
+	priv = kzalloc(sizeof(*priv), GFP_KERNEL);
 	if (!priv) {
 		err = -ENOMEM;
 		goto err_exit;
 	}
 
-	ivc_req_msg =
-		devm_kzalloc(se_dev->dev, sizeof(*ivc_req_msg), GFP_KERNEL);
-	if (!ivc_req_msg) {
-		err = -ENOMEM;
-		goto err_exit;
-	}
+	/*
+	 * The submit message is reused across submissions; it is copied
+	 * into the IVC frame before tegra_hv_vse_send_ivc() returns and
+	 * this path is serialized by se_dev->mtx. Only the descriptors
+	 * filled below are cleared and sent.
+	 */
+	ivc_req_msg = se_dev->aes_ivc_msg;
+	memset(ivc_req_msg, 0, sizeof(ivc_req_msg->hdr) +
+		se_dev->req_cnt * sizeof(ivc_req_msg->d[0]));
 
 	err = tegra_hv_se_setup_ablk_req(se_dev, priv);
 	if (err) {
@@ -2164,7 +2170,8 @@ static void tegra_hv_vse_process_new_req(struct tegra_virtual_se_dev *se_dev)
 	atomic_add(1, &se_dev->ivc_count);
 	vse_thread_start = true;
 	err = tegra_hv_vse_send_ivc(se_dev, pivck, ivc_req_msg,
-			sizeof(struct tegra_virtual_se_ivc_msg_t));
+			sizeof(ivc_req_msg->hdr) +
+			se_dev->req_cnt * sizeof(ivc_req_msg->d[0]));
 	if (err) {
 		dev_err(se_dev->dev,
 			"\n %s send ivc failed %d\n", __func__, err);
@@ -2178,7 +2185,7 @@ exit:
 err_exit:
 	if (priv) {
 		kfree(priv->buf);
-		devm_kfree(se_dev->dev, priv);
+		kfree(priv);
 	}
 	for (k = 0; k < se_dev->req_cnt; k++) {
 		req = se_dev->reqs[k];
@@ -2186,8 +2193,6 @@ err_exit:
 			req->base.complete(&req->base, err);
 	}
 exit_return:
-	if (ivc_req_msg)
-		devm_kfree(se_dev->dev, ivc_req_msg);
 	se_dev->req_cnt = 0;
 	se_dev->gather_buf_sz = 0;
 }
@@ -3827,7 +3832,7 @@ static int tegra_vse_kthread(void *unused)
 					(s8)ivc_resp_msg->d[0].rx.status;
 				priv->call_back_vse(priv);
 				atomic_sub(1, &se_dev->ivc_count);
-				devm_kfree(se_dev->dev, priv);
+				kfree(priv);
 				break;
 			case VIRTUAL_SE_KEY_SLOT:
 				ivc_rx = &ivc_resp_msg->d[0].rx;
@@ -3947,6 +3952,13 @@ static int tegra_hv_vse_probe(struct platform_device *pdev)
 	}
 
 	if (engine_id == VIRTUAL_SE_AES1) {
+		se_dev->aes_ivc_msg = devm_kzalloc(&pdev->dev,
+				sizeof(struct tegra_virtual_se_ivc_msg_t),
+				GFP_KERNEL);
+		if (!se_dev->aes_ivc_msg) {
+			err = -ENOMEM;
+			goto exit;
+		}
 		INIT_WORK(&se_dev->se_work, tegra_hv_vse_work_handler);
 		crypto_init_queue(&se_dev->queue,
 			TEGRA_HV_VSE_CRYPTO_QUEUE_LENGTH);
@@ -132,6 +132,24 @@ struct tegra_se_elp_chipdata {
 	bool weierstrass;
 };
 
+#define TEGRA_SE_PKA1_PRECOMP_CACHE_COUNT	4
+
+/*
+ * Cached Montgomery precomputed values for one modulus. The M and R2
+ * outputs of the precomputation programs depend only on the modulus and
+ * operation mode, so for repeated operations on a fixed curve they can
+ * be written back into the register banks instead of being recomputed
+ * with three PKA1 round trips per operation.
+ */
+struct tegra_se_pka1_precomp_cache {
+	bool valid;
+	u32 op_mode;
+	u32 size;
+	u32 modulus[ECC_MAX_WORDS];
+	u32 m[ECC_MAX_WORDS];
+	u32 r2[ECC_MAX_WORDS];
+};
+
 struct tegra_se_elp_dev {
 	struct device *dev;
 	void __iomem *io_reg[2];
@@ -143,6 +161,10 @@ struct tegra_se_elp_dev {
 	u32 *rdata;
 	/* Mutex lock to protect HW */
 	struct mutex hw_lock;
+	/* Precomputed value cache, protected by hw_lock */
+	struct tegra_se_pka1_precomp_cache precomp_cache[
+					TEGRA_SE_PKA1_PRECOMP_CACHE_COUNT];
+	unsigned int precomp_evict;
 };
 
 static struct tegra_se_elp_dev *elp_dev;
@@ -1965,6 +1987,122 @@ static int tegra_se_pka1_get_precomp(struct tegra_se_pka1_rsa_context *ctx,
 	return ret;
 }
 
+/*
+ * Restores the cached modulus and precomputed values into the register
+ * banks the precomputation programs would have left them in. M and R2
+ * are also copied into the request buffers as the key slot path loads
+ * them from there.
+ */
+static void tegra_se_pka1_restore_precomp(struct tegra_se_elp_dev *se_dev,
+					  struct tegra_se_pka1_precomp_cache
+					  *cache, u32 *m, u32 *r2)
+{
+	u32 i;
+	unsigned int nwords = cache->size / WORD_SIZE_BYTES;
+
+	for (i = 0; i < nwords; i++)
+		se_elp_writel(se_dev, PKA1, cache->modulus[i], reg_bank_offset(
+			      TEGRA_SE_PKA1_MOD_BANK,
+			      TEGRA_SE_PKA1_MOD_ID,
+			      cache->op_mode) + (i * 4));
+
+	for (i = 0; i < nwords; i++)
+		se_elp_writel(se_dev, PKA1, cache->m[i], reg_bank_offset(
+			      TEGRA_SE_PKA1_M_BANK,
+			      TEGRA_SE_PKA1_M_ID,
+			      cache->op_mode) + (i * 4));
+
+	for (i = 0; i < nwords; i++)
+		se_elp_writel(se_dev, PKA1, cache->r2[i], reg_bank_offset(
+			      TEGRA_SE_PKA1_R2_BANK,
+			      TEGRA_SE_PKA1_R2_ID,
+			      cache->op_mode) + (i * 4));
+
+	memcpy(m, cache->m, cache->size);
+	memcpy(r2, cache->r2, cache->size);
+}
+
+/*
+ * Serves the precomputed values of an ECC or Mod request from the cache
+ * when its modulus has been seen before, falling back to the
+ * precomputation programs on a miss. Must be called with hw_lock held
+ * and the PKA1 mutex acquired, like tegra_se_pka1_get_precomp().
+ */
+static int tegra_se_pka1_get_precomp_cached(
+				struct tegra_se_pka1_ecc_request *ecc_req,
+				struct tegra_se_pka1_mod_request *mod_req)
+{
+	struct tegra_se_pka1_precomp_cache *cache;
+	struct tegra_se_elp_dev *se_dev;
+	u32 *modulus, *m, *r2;
+	unsigned int op_mode, type, size;
+	unsigned int i;
+	bool cacheable;
+	int ret;
+
+	if (ecc_req) {
+		se_dev = ecc_req->se_dev;
+		modulus = ecc_req->modulus;
+		m = ecc_req->m;
+		r2 = ecc_req->r2;
+		size = ecc_req->size;
+		op_mode = ecc_req->op_mode;
+		type = ecc_req->type;
+
+		cacheable = !(op_mode == SE_ELP_OP_MODE_ECC521 ||
+			      type == C25519_POINT_MUL ||
+			      type == ED25519_POINT_MUL ||
+			      type == ED25519_SHAMIR_TRICK);
+	} else {
+		se_dev = mod_req->se_dev;
+		modulus = mod_req->modulus;
+		m = mod_req->m;
+		r2 = mod_req->r2;
+		size = mod_req->size;
+		op_mode = mod_req->op_mode;
+		type = mod_req->type;
+
+		cacheable = !(op_mode == SE_ELP_OP_MODE_ECC521 ||
+			      type == C25519_MOD_EXP ||
+			      type == C25519_MOD_SQR ||
+			      type == MOD_SUB ||
+			      type == BIT_SERIAL_DP_MOD_REDUCE ||
+			      type == NON_MOD_MULT ||
+			      type == C25519_MOD_MULT);
+	}
+
+	/* Request types without precomputed values have nothing to cache */
+	if (!cacheable || size > ECC_MAX_WORDS * WORD_SIZE_BYTES)
+		return tegra_se_pka1_get_precomp(NULL, ecc_req, mod_req);
+
+	for (i = 0; i < TEGRA_SE_PKA1_PRECOMP_CACHE_COUNT; i++) {
+		cache = &se_dev->precomp_cache[i];
+		if (cache->valid && cache->op_mode == op_mode &&
+		    cache->size == size &&
+		    !memcmp(cache->modulus, modulus, size)) {
+			tegra_se_pka1_restore_precomp(se_dev, cache, m, r2);
+			return 0;
+		}
+	}
+
+	ret = tegra_se_pka1_get_precomp(NULL, ecc_req, mod_req);
+	if (ret)
+		return ret;
+
+	cache = &se_dev->precomp_cache[se_dev->precomp_evict];
+	se_dev->precomp_evict = (se_dev->precomp_evict + 1) %
+				TEGRA_SE_PKA1_PRECOMP_CACHE_COUNT;
+
+	cache->op_mode = op_mode;
+	cache->size = size;
+	memcpy(cache->modulus, modulus, size);
+	memcpy(cache->m, m, size);
+	memcpy(cache->r2, r2, size);
+	cache->valid = true;
+
+	return 0;
+}
+
 static int tegra_se_pka1_rsa_op(struct akcipher_request *req)
 {
 	struct crypto_akcipher *tfm;
@@ -2077,7 +2215,7 @@ int tegra_se_pka1_ecc_op(struct tegra_se_pka1_ecc_request *req)
 		goto clk_dis;
 	}
 
-	ret = tegra_se_pka1_get_precomp(NULL, req, NULL);
+	ret = tegra_se_pka1_get_precomp_cached(req, NULL);
 	if (ret)
 		goto exit;
 
@@ -2094,6 +2232,78 @@ ecc_exit:
 }
 EXPORT_SYMBOL(tegra_se_pka1_ecc_op);
 
+/*
+ * Processes a queue of independent ECC point operations back to back
+ * while holding on to the hardware, so a burst pays for one clock
+ * enable and one PKA1 mutex acquire/scrub cycle instead of one per
+ * operation. Processing stops at the first failing operation.
+ */
+int tegra_se_pka1_ecc_op_queue(struct tegra_se_pka1_ecc_request *reqs,
+			       unsigned int nreqs)
+{
+	struct tegra_se_elp_dev *se_dev;
+	unsigned int i, done;
+	int ret = 0;
+
+	if (!reqs || !nreqs) {
+		pr_err("Invalid ECC request queue\n");
+		return -EINVAL;
+	}
+
+	for (i = 0; i < nreqs; i++) {
+		if (reqs[i].size < ECC_MIN_BYTES ||
+		    reqs[i].size > ECC_MAX_BYTES) {
+			pr_err("ECC request size not in range\n");
+			return -EDOM;
+		}
+	}
+
+	for (done = 0; done < nreqs; done++) {
+		ret = tegra_se_pka1_ecc_init(&reqs[done]);
+		if (ret)
+			goto ecc_exit;
+	}
+
+	se_dev = reqs[0].se_dev;
+	mutex_lock(&se_dev->hw_lock);
+	ret = clk_prepare_enable(se_dev->c);
+	if (ret) {
+		dev_err(se_dev->dev, "clk_enable failed\n");
+		goto unlock;
+	}
+
+	ret = tegra_se_acquire_pka1_mutex(se_dev);
+	if (ret) {
+		dev_err(se_dev->dev, "PKA1 Mutex acquire failed\n");
+		goto clk_dis;
+	}
+
+	for (i = 0; i < nreqs; i++) {
+		/* Keep the mutex watchdog from expiring across the queue */
+		tegra_se_restart_pka1_mutex_wdt(se_dev);
+
+		ret = tegra_se_pka1_get_precomp_cached(&reqs[i], NULL);
+		if (ret)
+			break;
+
+		ret = tegra_se_pka1_ecc_do(&reqs[i]);
+		if (ret)
+			break;
+	}
+
+	tegra_se_release_pka1_mutex(se_dev);
+clk_dis:
+	clk_disable_unprepare(se_dev->c);
+unlock:
+	mutex_unlock(&se_dev->hw_lock);
+ecc_exit:
+	while (done--)
+		tegra_se_pka1_ecc_exit(&reqs[done]);
+
+	return ret;
+}
+EXPORT_SYMBOL(tegra_se_pka1_ecc_op_queue);
+
 static int tegra_se_pka1_mod_op(struct tegra_se_pka1_mod_request *req)
 {
 	struct tegra_se_elp_dev *se_dev;
@@ -2122,7 +2332,7 @@ static int tegra_se_pka1_mod_op(struct tegra_se_pka1_mod_request *req)
 		goto clk_dis;
 	}
 
-	ret = tegra_se_pka1_get_precomp(NULL, NULL, req);
+	ret = tegra_se_pka1_get_precomp_cached(NULL, req);
 	if (ret)
 		goto exit;
 
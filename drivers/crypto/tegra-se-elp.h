@@ -735,5 +735,7 @@ static struct tegra_se_ecc_curve edcurve_p256 = {
 
 struct tegra_se_pka1_ecc_request;
 int tegra_se_pka1_ecc_op(struct tegra_se_pka1_ecc_request *req);
+int tegra_se_pka1_ecc_op_queue(struct tegra_se_pka1_ecc_request *reqs,
+			       unsigned int nreqs);
 
 #endif /* _CRYPTO_TEGRA_SE_ELP_H */
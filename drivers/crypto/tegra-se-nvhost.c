@@ -1067,7 +1067,7 @@ static void tegra_se_sha_complete_callback(void *priv, int nr_completed)
 	req = priv_data->sha_req;
 	if (!req) {
 		dev_err(se_dev->dev, "Invalid request for callback\n");
-		devm_kfree(se_dev->dev, priv_data);
+		kfree(priv_data);
 		return;
 	}
 
@@ -1099,7 +1099,7 @@ static void tegra_se_sha_complete_callback(void *priv, int nr_completed)
 
 	req->base.complete(&req->base, 0);
 
-	devm_kfree(se_dev->dev, priv_data);
+	kfree(priv_data);
 
 	pr_debug("%s:%d sha callback complete", __func__, __LINE__);
 }
@@ -1119,7 +1119,7 @@ static void tegra_se_aes_complete_callback(void *priv, int nr_completed)
 	atomic_set(&se_dev->cmdbuf_addr_list[priv_data->cmdbuf_node].free, 1);
 
 	if (!priv_data->req_cnt) {
-		devm_kfree(se_dev->dev, priv_data);
+		kfree(priv_data);
 		return;
 	}
 
@@ -1134,7 +1134,7 @@ static void tegra_se_aes_complete_callback(void *priv, int nr_completed)
 			dev_err(se_dev->dev, "Invalid request for callback\n");
 			if (priv_data->dynmem)
 				kfree(priv_data->buf);
-			devm_kfree(se_dev->dev, priv_data);
+			kfree(priv_data);
 			return;
 		}
 
@@ -1162,7 +1162,7 @@ static void tegra_se_aes_complete_callback(void *priv, int nr_completed)
 		atomic_set(&se_dev->aes_buf_stat[priv_data->aesbuf_entry], 1);
 	}
 
-	devm_kfree(se_dev->dev, priv_data);
+	kfree(priv_data);
 	pr_debug("%s(%d) aes callback complete\n", __func__, __LINE__);
 }
 
@@ -1188,9 +1188,11 @@ static int tegra_se_channel_submit_gather(struct tegra_se_dev *se_dev,
 	struct nvhost_device_data *pdata = platform_get_drvdata(se_dev->pdev);
 
 	if (callback) {
-		priv = devm_kzalloc(se_dev->dev,
-				    sizeof(struct tegra_se_priv_data),
-				    GFP_KERNEL);
+		/*
+		 * Allocated and freed on every submit, including from the
+		 * completion notifier, so skip the devres bookkeeping.
+		 */
+		priv = kzalloc(sizeof(struct tegra_se_priv_data), GFP_KERNEL);
 		if (!priv)
 			return -ENOMEM;
 	}
@@ -1199,7 +1201,7 @@ static int tegra_se_channel_submit_gather(struct tegra_se_dev *se_dev,
 	if (err) {
 		dev_err(se_dev->dev, "nvhost_module_busy failed for se_dev\n");
 		if (priv)
-			devm_kfree(se_dev->dev, priv);
+			kfree(priv);
 		return err;
 	}
 
@@ -1333,7 +1335,7 @@ error:
 exit:
 	nvhost_module_idle(se_dev->pdev);
 	if (err)
-		devm_kfree(se_dev->dev, priv);
+		kfree(priv);
 
 	return err;
 }
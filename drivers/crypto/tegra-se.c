@@ -29,6 +29,7 @@
 #include <linux/of.h>
 #include <linux/of_device.h>
 #include <linux/mutex.h>
+#include <linux/percpu.h>
 #include <linux/interrupt.h>
 #include <linux/types.h>
 #include <linux/errno.h>
@@ -254,6 +255,33 @@ static void tegra_se_work_handler(struct work_struct *work);
 static DECLARE_WORK(se_work, tegra_se_work_handler);
 static struct workqueue_struct *se_work_q;
 
+/* Per-CPU DRBG entropy cache. Random bytes are produced ahead of time
+ * by the engine so that readers consume prefilled buffers at memcpy
+ * speed. Each CPU holds two buffers; one is drained while the refill
+ * worker replenishes the other, so bursty readers only stall on the
+ * engine once the whole cache is exhausted.
+ */
+#define TEGRA_SE_RNG_CACHE_SIZE		1024
+#define TEGRA_SE_RNG_CACHE_BUFS		2
+
+struct tegra_se_rng_cache_buf {
+	u8 data[TEGRA_SE_RNG_CACHE_SIZE];
+	unsigned int avail;	/* unread bytes at the tail of data */
+};
+
+struct tegra_se_rng_cache {
+	spinlock_t lock;
+	struct tegra_se_rng_cache_buf bufs[TEGRA_SE_RNG_CACHE_BUFS];
+};
+
+static struct tegra_se_rng_cache __percpu *rng_cache;
+static u32 *rng_cache_dt_buf;	/* DT input buffer for refills */
+static dma_addr_t rng_cache_dt_buf_adr;
+static u32 *rng_cache_rng_buf;	/* engine output buffer for refills */
+static dma_addr_t rng_cache_rng_buf_adr;
+static void tegra_se_rng_cache_refill(struct work_struct *work);
+static DECLARE_WORK(rng_cache_work, tegra_se_rng_cache_refill);
+
 #define PMC_SCRATCH43_REG_OFFSET 0x22c
 #define GET_MSB(x)  ((x) >> (8 * sizeof(x) - 1))
 static int force_reseed_count;
@@ -1365,12 +1393,11 @@ static int tegra_se_rng_drbg_init(struct crypto_tfm *tfm)
 	return 0;
 }
 
-static int tegra_se_rng_drbg_get_random(struct crypto_rng *tfm,
-					const u8 *src, unsigned int slen,
-					u8 *rdata, unsigned int dlen)
+static int tegra_se_rng_generate(struct tegra_se_dev *se_dev,
+				 dma_addr_t dt_buf_adr,
+				 u32 *rng_buf, dma_addr_t rng_buf_adr,
+				 u8 *rdata, unsigned int dlen)
 {
-	struct tegra_se_rng_context *rng_ctx = crypto_rng_ctx(tfm);
-	struct tegra_se_dev *se_dev = rng_ctx->se_dev;
 	struct tegra_se_ll *src_ll, *dst_ll;
 	u8 *rdata_addr;
 	int ret = 0, j;
@@ -1399,9 +1426,9 @@ static int tegra_se_rng_drbg_get_random(struct crypto_rng *tfm,
 	*se_dev->dst_ll_buf = 0;
 	src_ll = (struct tegra_se_ll *)(se_dev->src_ll_buf + 1);
 	dst_ll = (struct tegra_se_ll *)(se_dev->dst_ll_buf + 1);
-	src_ll->addr = rng_ctx->dt_buf_adr;
+	src_ll->addr = dt_buf_adr;
 	src_ll->data_len = TEGRA_SE_RNG_DT_SIZE;
-	dst_ll->addr = rng_ctx->rng_buf_adr;
+	dst_ll->addr = rng_buf_adr;
 	dst_ll->data_len = TEGRA_SE_RNG_DT_SIZE;
 
 	tegra_se_config_algo(se_dev, SE_AES_OP_MODE_RNG_DRBG, true,
@@ -1417,16 +1444,13 @@ static int tegra_se_rng_drbg_get_random(struct crypto_rng *tfm,
 		rdata_addr = (rdata + (j * TEGRA_SE_RNG_DT_SIZE));
 
 		if (data_len && num_blocks == j) {
-			memcpy(rdata_addr, rng_ctx->rng_buf, data_len);
+			memcpy(rdata_addr, rng_buf, data_len);
 		} else {
-			memcpy(rdata_addr, rng_ctx->rng_buf,
+			memcpy(rdata_addr, rng_buf,
 			       TEGRA_SE_RNG_DT_SIZE);
 		}
 	}
 
-	if (!ret)
-		ret = dlen;
-
 	if (se_dev->chipdata->drbg_src_entropy_clk_enable)
 		clk_disable_unprepare(se_dev->enclk);
 out:
@@ -1436,6 +1460,112 @@ out:
 	return ret;
 }
 
+static unsigned int tegra_se_rng_cache_get(u8 *rdata, unsigned int dlen)
+{
+	struct tegra_se_rng_cache *cache;
+	struct tegra_se_rng_cache_buf *buf;
+	unsigned int copied = 0, chunk;
+	bool refill = false;
+	unsigned long flags;
+	int i;
+
+	if (!rng_cache)
+		return 0;
+
+	cache = get_cpu_ptr(rng_cache);
+	spin_lock_irqsave(&cache->lock, flags);
+	for (i = 0; i < TEGRA_SE_RNG_CACHE_BUFS && copied < dlen; i++) {
+		buf = &cache->bufs[i];
+		if (!buf->avail)
+			continue;
+		chunk = min(dlen - copied, buf->avail);
+		memcpy(rdata + copied,
+		       buf->data + (TEGRA_SE_RNG_CACHE_SIZE - buf->avail),
+		       chunk);
+		buf->avail -= chunk;
+		copied += chunk;
+		if (!buf->avail)
+			refill = true;
+	}
+	spin_unlock_irqrestore(&cache->lock, flags);
+	put_cpu_ptr(rng_cache);
+
+	if (refill)
+		schedule_work(&rng_cache_work);
+
+	return copied;
+}
+
+static void tegra_se_rng_cache_refill(struct work_struct *work)
+{
+	struct tegra_se_dev *se_dev = se_devices[SE_DRBG];
+	struct tegra_se_rng_cache *cache;
+	struct tegra_se_rng_cache_buf *buf;
+	unsigned long flags;
+	u8 *scratch;
+	int cpu, i;
+
+	scratch = kmalloc(TEGRA_SE_RNG_CACHE_SIZE, GFP_KERNEL);
+	if (!scratch)
+		return;
+
+	/* The engine round trip runs on the scratch buffer so that a
+	 * per-CPU lock is held only for the memcpy into the cache.
+	 */
+	for_each_possible_cpu(cpu) {
+		cache = per_cpu_ptr(rng_cache, cpu);
+		for (i = 0; i < TEGRA_SE_RNG_CACHE_BUFS; i++) {
+			buf = &cache->bufs[i];
+			if (READ_ONCE(buf->avail))
+				continue;
+
+			if (tegra_se_rng_generate(se_dev,
+						  rng_cache_dt_buf_adr,
+						  rng_cache_rng_buf,
+						  rng_cache_rng_buf_adr,
+						  scratch,
+						  TEGRA_SE_RNG_CACHE_SIZE))
+				goto out;
+
+			spin_lock_irqsave(&cache->lock, flags);
+			memcpy(buf->data, scratch, TEGRA_SE_RNG_CACHE_SIZE);
+			buf->avail = TEGRA_SE_RNG_CACHE_SIZE;
+			spin_unlock_irqrestore(&cache->lock, flags);
+		}
+	}
+out:
+	memzero_explicit(scratch, TEGRA_SE_RNG_CACHE_SIZE);
+	kfree(scratch);
+}
+
+static int tegra_se_rng_drbg_get_random(struct crypto_rng *tfm,
+					const u8 *src, unsigned int slen,
+					u8 *rdata, unsigned int dlen)
+{
+	struct tegra_se_rng_context *rng_ctx = crypto_rng_ctx(tfm);
+	struct tegra_se_dev *se_dev = rng_ctx->se_dev;
+	unsigned int copied = 0;
+	int ret;
+
+	/* Serve short requests from the per-CPU entropy cache. Larger
+	 * requests go straight to the engine so that a single reader
+	 * cannot drain the whole cache.
+	 */
+	if (dlen <= TEGRA_SE_RNG_CACHE_SIZE) {
+		copied = tegra_se_rng_cache_get(rdata, dlen);
+		if (copied == dlen)
+			return dlen;
+	}
+
+	ret = tegra_se_rng_generate(se_dev, rng_ctx->dt_buf_adr,
+				    rng_ctx->rng_buf, rng_ctx->rng_buf_adr,
+				    rdata + copied, dlen - copied);
+	if (ret)
+		return ret;
+
+	return dlen;
+}
+
 static int tegra_se_rng_drbg_reset(struct crypto_rng *tfm, const u8 *seed,
 				   unsigned int slen)
 {
@@ -1458,6 +1588,62 @@ static void tegra_se_rng_drbg_exit(struct crypto_tfm *tfm)
 	rng_ctx->se_dev = NULL;
 }
 
+static void tegra_se_rng_cache_free(struct tegra_se_dev *se_dev)
+{
+	if (!rng_cache)
+		return;
+
+	cancel_work_sync(&rng_cache_work);
+	free_percpu(rng_cache);
+	rng_cache = NULL;
+	dma_free_coherent(se_dev->dev, TEGRA_SE_RNG_DT_SIZE,
+			  rng_cache_dt_buf, rng_cache_dt_buf_adr);
+	dma_free_coherent(se_dev->dev, TEGRA_SE_RNG_DT_SIZE,
+			  rng_cache_rng_buf, rng_cache_rng_buf_adr);
+	rng_cache_dt_buf = NULL;
+	rng_cache_rng_buf = NULL;
+}
+
+static void tegra_se_rng_cache_init(struct tegra_se_dev *se_dev)
+{
+	struct tegra_se_rng_cache __percpu *cache;
+	int cpu;
+
+	rng_cache_dt_buf = dma_alloc_coherent(se_dev->dev,
+					      TEGRA_SE_RNG_DT_SIZE,
+					      &rng_cache_dt_buf_adr,
+					      GFP_KERNEL);
+	rng_cache_rng_buf = dma_alloc_coherent(se_dev->dev,
+					       TEGRA_SE_RNG_DT_SIZE,
+					       &rng_cache_rng_buf_adr,
+					       GFP_KERNEL);
+	cache = alloc_percpu(struct tegra_se_rng_cache);
+
+	if (!rng_cache_dt_buf || !rng_cache_rng_buf || !cache) {
+		if (cache)
+			free_percpu(cache);
+		if (rng_cache_dt_buf)
+			dma_free_coherent(se_dev->dev, TEGRA_SE_RNG_DT_SIZE,
+					  rng_cache_dt_buf,
+					  rng_cache_dt_buf_adr);
+		if (rng_cache_rng_buf)
+			dma_free_coherent(se_dev->dev, TEGRA_SE_RNG_DT_SIZE,
+					  rng_cache_rng_buf,
+					  rng_cache_rng_buf_adr);
+		rng_cache_dt_buf = NULL;
+		rng_cache_rng_buf = NULL;
+		dev_warn(se_dev->dev, "rng entropy cache disabled\n");
+		return;
+	}
+
+	for_each_possible_cpu(cpu)
+		spin_lock_init(&per_cpu_ptr(cache, cpu)->lock);
+
+	/* Publish the cache and prefill it in the background */
+	rng_cache = cache;
+	schedule_work(&rng_cache_work);
+}
+
 static int tegra_se_sha_init(struct ahash_request *req)
 {
 	struct crypto_ahash *tfm = crypto_ahash_reqtfm(req);
@@ -3466,6 +3652,7 @@ static int tegra_se_probe(struct platform_device *pdev)
 			dev_err(se_dev->dev, "crypto_register_rng failed\n");
 			goto fail_rng;
 		}
+		tegra_se_rng_cache_init(se_dev);
 	}
 
 	if (is_algo_supported(node, "aes")) {
@@ -3632,8 +3819,10 @@ fail_alg1:
 	}
 fail_alg:
 	if (is_algo_supported(node, "drbg")) {
-		if (is_algo_supported_in_hw(se_dev, rng_algs[0].base.cra_name))
+		if (is_algo_supported_in_hw(se_dev, rng_algs[0].base.cra_name)) {
+			tegra_se_rng_cache_free(se_dev);
 			crypto_unregister_rng(&rng_algs[0]);
+		}
 	}
 fail_rng:
 	tegra_se_free_ll_buf(se_dev);
@@ -3691,6 +3880,7 @@ static int tegra_se_remove(struct platform_device *pdev)
 		if (is_algo_supported_in_hw(se_dev, rng_algs[0].base.cra_name))
 			crypto_unregister_rng(&rng_algs[0]);
 	}
+	tegra_se_rng_cache_free(se_dev);
 	tegra_se_free_ll_buf(se_dev);
 	sg_tegra_se_dev = NULL;
 
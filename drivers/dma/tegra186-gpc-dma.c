@@ -40,6 +40,19 @@
 
 #include "dmaengine.h"
 
+/*
+ * Interrupt decimation for cyclic transfers: queue the client callback
+ * only every Nth period so pull-mode audio stacks can batch period
+ * processing.  Per-period bookkeeping still runs in the ISR (the next
+ * period must be reprogrammed at each EOC), so residue reported through
+ * tx_status stays accurate between callbacks.  Clamped at prep time to
+ * the number of periods in the ring.
+ */
+static uint cyclic_irq_decimation = 1;
+module_param(cyclic_irq_decimation, uint, 0644);
+MODULE_PARM_DESC(cyclic_irq_decimation,
+		 "Queue cyclic callbacks every Nth period (1 = every period)");
+
 /* Common space stream_idx mask register */
 #define GPCDMA_COMMON_CH0_STREAM_IDx_MASK(x)	(0x180 + (x * 0x80))
 
@@ -251,6 +264,10 @@ struct tegra_dma_channel {
 	raw_spinlock_t		lock;
 	bool			busy;
 	bool			cyclic;
+	/* Invoke the cyclic callback only every Nth period */
+	u32			cyclic_irq_decimation;
+	/* Periods elapsed since the last callback was queued */
+	u32			cyclic_periods_pending;
 	struct tegra_dma	*tdma;
 
 	/* Different lists for managing the requests */
@@ -267,6 +284,8 @@ struct tegra_dma_channel {
 
 	/* Channel-slave specific configuration */
 	int slave_id;
+	/* Stream-id programmed in MCSEQ at probe */
+	u32 stream_id;
 	struct dma_slave_config dma_sconfig;
 	struct tegra_dma_channel_regs	channel_reg;
 };
@@ -712,10 +731,15 @@ static void handle_cont_sngl_cycle_dma_done(struct tegra_dma_channel *tdc,
 	dma_desc->bytes_transferred += sgreq->req_len;
 	dma_desc->total_bytes_transferred += sgreq->req_len;
 
-	/* Callback need to be call */
-	if (!dma_desc->cb_count)
-		list_add_tail(&dma_desc->cb_node, &tdc->cb_desc);
-	dma_desc->cb_count++;
+	/* Callback need to be call, every Nth period when decimating */
+	tdc->cyclic_periods_pending++;
+	if (to_terminate || tdc->cyclic_irq_decimation <= 1 ||
+	    tdc->cyclic_periods_pending >= tdc->cyclic_irq_decimation) {
+		if (!dma_desc->cb_count)
+			list_add_tail(&dma_desc->cb_node, &tdc->cb_desc);
+		dma_desc->cb_count++;
+		tdc->cyclic_periods_pending = 0;
+	}
 
 	/* If not last req then put at end of pending list */
 	if (!list_is_last(&sgreq->node, &tdc->pending_sg_req)) {
@@ -817,7 +841,9 @@ static irqreturn_t tegra_dma_isr(int irq, void *dev_id)
 				tdc->id, status);
 			tegra_dma_dump_chan_regs(tdc);
 		}
-		tasklet_schedule(&tdc->tasklet);
+		/* With decimation most periods queue no callback */
+		if (!list_empty(&tdc->cb_desc))
+			tasklet_schedule(&tdc->tasklet);
 		raw_spin_unlock_irqrestore(&tdc->lock, flags);
 		return IRQ_HANDLED;
 	}
@@ -1170,10 +1196,8 @@ static struct dma_async_tx_descriptor *tegra_dma_prep_dma_memset(
 	/* Configure default priority weight for the channel */
 	csr |= (1 << TEGRA_GPCDMA_CSR_WEIGHT_SHIFT);
 
-	mc_seq =  tdc_read(tdc, TEGRA_GPCDMA_CHAN_MCSEQ);
-	/* retain stream-id and clean rest */
-	mc_seq &= (TEGRA_GPCDMA_MCSEQ_STREAM_ID_MASK <<
-			TEGRA_GPCDMA_MCSEQ_STREAM_ID0_SHIFT);
+	/* stream-id as programmed at probe, avoids a MMIO read per prep */
+	mc_seq = tdc->stream_id << TEGRA_GPCDMA_MCSEQ_STREAM_ID0_SHIFT;
 
 	/* Set the address wrapping */
 	mc_seq |= TEGRA_GPCDMA_MCSEQ_WRAP_NONE <<
@@ -1269,12 +1293,9 @@ static struct dma_async_tx_descriptor *tegra_dma_prep_dma_memcpy(
 	/* Configure default priority weight for the channel */
 	csr |= (1 << TEGRA_GPCDMA_CSR_WEIGHT_SHIFT);
 
-	mc_seq =  tdc_read(tdc, TEGRA_GPCDMA_CHAN_MCSEQ);
-	/* retain stream-id and clean rest */
-	mc_seq &= ((TEGRA_GPCDMA_MCSEQ_STREAM_ID_MASK <<
-			TEGRA_GPCDMA_MCSEQ_STREAM_ID0_SHIFT) |
-			(TEGRA_GPCDMA_MCSEQ_STREAM_ID_MASK <<
-			TEGRA_GPCDMA_MCSEQ_STREAM_ID1_SHIFT));
+	/* stream-ids as programmed at probe, avoids a MMIO read per prep */
+	mc_seq = (tdc->stream_id << TEGRA_GPCDMA_MCSEQ_STREAM_ID0_SHIFT) |
+		(tdc->stream_id << TEGRA_GPCDMA_MCSEQ_STREAM_ID1_SHIFT);
 
 	/* Set the address wrapping */
 	mc_seq |= TEGRA_GPCDMA_MCSEQ_WRAP_NONE <<
@@ -1393,10 +1414,8 @@ static struct dma_async_tx_descriptor *tegra_dma_prep_slave_sg(
 	if (flags & DMA_PREP_INTERRUPT)
 		csr |= TEGRA_GPCDMA_CSR_IE_EOC;
 
-	mc_seq =  tdc_read(tdc, TEGRA_GPCDMA_CHAN_MCSEQ);
-	/* retain stream-id and clean rest */
-	mc_seq &= (TEGRA_GPCDMA_MCSEQ_STREAM_ID_MASK <<
-			TEGRA_GPCDMA_MCSEQ_STREAM_ID0_SHIFT);
+	/* stream-id as programmed at probe, avoids a MMIO read per prep */
+	mc_seq = tdc->stream_id << TEGRA_GPCDMA_MCSEQ_STREAM_ID0_SHIFT;
 
 	/* Set the address wrapping on both MC and MMIO side */
 	mc_seq |= TEGRA_GPCDMA_MCSEQ_WRAP_NONE <<
@@ -1580,10 +1599,8 @@ static struct dma_async_tx_descriptor *tegra_dma_prep_dma_cyclic(
 
 	mmio_seq |= (1 << TEGRA_GPCDMA_MMIOSEQ_WRAP_WORD_SHIFT);
 
-	mc_seq =  tdc_read(tdc, TEGRA_GPCDMA_CHAN_MCSEQ);
-	/* retain stream-id and clean rest */
-	mc_seq &= (TEGRA_GPCDMA_MCSEQ_STREAM_ID_MASK <<
-			TEGRA_GPCDMA_MCSEQ_STREAM_ID0_SHIFT);
+	/* stream-id as programmed at probe, avoids a MMIO read per prep */
+	mc_seq = tdc->stream_id << TEGRA_GPCDMA_MCSEQ_STREAM_ID0_SHIFT;
 	/* Set the address wrapping on both MC and MMIO side */
 	mc_seq |= TEGRA_GPCDMA_MCSEQ_WRAP_NONE <<
 			TEGRA_GPCDMA_MCSEQ_WRAP0_SHIFT;
@@ -1614,6 +1631,15 @@ static struct dma_async_tx_descriptor *tegra_dma_prep_dma_cyclic(
 	dma_desc->bytes_requested = buf_len;
 	remain_len = buf_len;
 
+	/*
+	 * Latch the decimation factor for this transfer. Never defer the
+	 * callback past a full ring or a pull-mode client could be lapped
+	 * without ever being woken.
+	 */
+	tdc->cyclic_irq_decimation = min_t(u32, cyclic_irq_decimation ?: 1,
+					   buf_len / period_len);
+	tdc->cyclic_periods_pending = 0;
+
 	/* Split transfer equal to period size */
 	while (remain_len) {
 		sg_req = tegra_dma_sg_req_get(tdc);
@@ -1778,6 +1804,8 @@ static int tegra_dma_program_sid(struct tegra_dma_channel *tdc, int chan, int st
 	reg_val |= (stream_id << TEGRA_GPCDMA_MCSEQ_STREAM_ID1_SHIFT);
 
 	tdc_write(tdc, TEGRA_GPCDMA_CHAN_MCSEQ, reg_val);
+	/* Cache for descriptor setup, so prep calls need not read it back */
+	tdc->stream_id = stream_id;
 	return 0;
 }
 
@@ -1239,6 +1239,26 @@ static void tegra_gpio_set(struct gpio_chip *chip, unsigned offset, int value)
 	tegra_gpio_writel(tgi, val, offset, GPIO_OUT_VAL_REG);
 }
 
+/*
+ * Set several output lines in one call. The controller has a separate
+ * OUT_VAL register per pin, so the lines cannot be flipped with one bank
+ * write; instead the writes are issued back to back with nothing between
+ * them, keeping the skew between lines to the MMIO posting time rather
+ * than a full gpiolib call per line.
+ */
+static void tegra_gpio_set_multiple(struct gpio_chip *chip,
+				    unsigned long *mask, unsigned long *bits)
+{
+	struct tegra_gpio_info *tgi = gpiochip_get_data(chip);
+	unsigned int offset;
+
+	printk(KERN_DEBUG "Debug NVIDIA gpio %s, file %s", __func__, __FILE__);
+
+	for_each_set_bit(offset, mask, chip->ngpio)
+		__raw_writel(test_bit(offset, bits) ? 0x1 : 0x0,
+			     GPIO_CNTRL_REG(tgi, offset, GPIO_OUT_VAL_REG));
+}
+
 static int tegra_gpio_get(struct gpio_chip *chip, unsigned offset)
 {
 	struct tegra_gpio_info *tgi = gpiochip_get_data(chip);
@@ -1865,6 +1885,7 @@ static int tegra_gpio_probe(struct platform_device *pdev)
 	tgi->gc.get			= tegra_gpio_get;
 	tgi->gc.direction_output	= tegra_gpio_direction_output;
 	tgi->gc.set			= tegra_gpio_set;
+	tgi->gc.set_multiple		= tegra_gpio_set_multiple;
 	tgi->gc.get_direction		= tegra_gpio_get_direction;
 	tgi->gc.suspend_configure	= tegra_gpio_suspend_configure;
 	tgi->gc.is_enabled		= tegra_gpio_is_enabled;
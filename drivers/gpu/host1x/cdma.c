@@ -13,6 +13,7 @@
 #include <linux/interrupt.h>
 #include <linux/kernel.h>
 #include <linux/kfifo.h>
+#include <linux/sched/clock.h>
 #include <linux/slab.h>
 #include <trace/events/host1x.h>
 
@@ -297,6 +298,40 @@ static void stop_cdma_timer_locked(struct host1x_cdma *cdma)
 	cdma->timeout.client = NULL;
 }
 
+/*
+ * Record one event into the channel's flight recorder. All callers hold
+ * the cdma lock, so there is a single producer; the free running head
+ * counter is published after the entry, so the ring can be read without
+ * locking from a status dump or a crashdump. Only cached syncpt values
+ * are used, keeping the recording cost to a few stores.
+ */
+static void cdma_flight_record(struct host1x_cdma *cdma, u32 event,
+			       u32 dmaget, struct host1x_syncpt *sp)
+{
+	struct host1x_cdma_flight *flight = &cdma->flight;
+	u32 head = READ_ONCE(flight->head);
+	struct host1x_cdma_flight_entry *entry =
+		&flight->entries[head % HOST1X_CDMA_FLIGHT_EVENTS];
+
+	entry->timestamp = local_clock();
+	entry->event = event;
+	entry->dmaget = dmaget;
+	entry->dmaput = cdma->last_pos;
+	if (sp) {
+		entry->syncpt_id = sp->id;
+		entry->syncpt_min = host1x_syncpt_read_min(sp);
+		entry->syncpt_max = host1x_syncpt_read_max(sp);
+	} else {
+		entry->syncpt_id = 0;
+		entry->syncpt_min = 0;
+		entry->syncpt_max = 0;
+	}
+
+	/* publish the entry before moving head */
+	smp_wmb();
+	WRITE_ONCE(flight->head, head + 1);
+}
+
 /*
  * For all sync queue entries that have already finished according to the
  * current sync point registers:
@@ -333,6 +368,9 @@ static void update_cdma_locked(struct host1x_cdma *cdma)
 		if (cdma->timeout.client)
 			stop_cdma_timer_locked(cdma);
 
+		cdma_flight_record(cdma, HOST1X_CDMA_FLIGHT_COMPLETE,
+				   job->first_get, sp);
+
 		/* Unpin the memory */
 		host1x_job_unpin(job);
 
@@ -369,6 +407,9 @@ void host1x_cdma_update_sync_queue(struct host1x_cdma *cdma,
 
 	syncpt_val = host1x_syncpt_load(cdma->timeout.syncpt);
 
+	cdma_flight_record(cdma, HOST1X_CDMA_FLIGHT_TIMEOUT, cdma->first_get,
+			   cdma->timeout.syncpt);
+
 	dev_dbg(dev, "%s: starting cleanup (thresh %d)\n",
 		__func__, syncpt_val);
 
@@ -610,6 +651,58 @@ void host1x_cdma_push(struct host1x_cdma *cdma, u32 op1, u32 op2)
 	host1x_pushbuffer_push(pb, op1, op2);
 }
 
+/*
+ * Push a run of two-word slots into the push buffer with a single put
+ * pointer update. The words array holds opcode/value pairs and count is
+ * the number of such pairs. Compared to calling host1x_cdma_push() in a
+ * loop this copies each contiguous run with one memcpy() and advances
+ * the put pointer once per run, which matters for jobs that push
+ * thousands of words per submit.
+ *
+ * Blocks as necessary if the push buffer is full.
+ */
+void host1x_cdma_push_vector(struct host1x_cdma *cdma, const u32 *words,
+			     unsigned int count)
+{
+	struct host1x *host1x = cdma_to_host1x(cdma);
+	struct push_buffer *pb = &cdma->push_buffer;
+
+	if (host1x_debug_trace_cmdbuf) {
+		const char *name = dev_name(cdma_to_channel(cdma)->dev);
+		unsigned int i;
+
+		for (i = 0; i < count; i++)
+			trace_host1x_cdma_push(name, words[i * 2],
+					       words[i * 2 + 1]);
+	}
+
+	while (count > 0) {
+		u32 slots_free = cdma->slots_free;
+		unsigned int run;
+
+		if (slots_free == 0) {
+			host1x_hw_cdma_flush(host1x, cdma);
+			slots_free = host1x_cdma_wait_locked(cdma,
+						CDMA_EVENT_PUSH_BUFFER_SPACE);
+		}
+
+		/* limit each run to the contiguous space before the wrap */
+		run = min3(count, (unsigned int)slots_free,
+			   (unsigned int)(pb->size - pb->pos) / 8);
+
+		memcpy(pb->mapped + pb->pos, words, run * 8);
+
+		pb->pos += run * 8;
+		if (pb->pos >= pb->size)
+			pb->pos -= pb->size;
+
+		cdma->slots_free = slots_free - run;
+		cdma->slots_used += run;
+		words += run * 2;
+		count -= run;
+	}
+}
+
 /*
  * Push four words into two consecutive push buffer slots. Note that extra
  * care needs to be taken not to split the two slots across the end of the
@@ -676,6 +769,9 @@ void host1x_cdma_end(struct host1x_cdma *cdma,
 	host1x_job_get(job);
 	list_add_tail(&job->list, &cdma->sync_queue);
 
+	cdma_flight_record(cdma, HOST1X_CDMA_FLIGHT_SUBMIT, job->first_get,
+			   job->syncpt);
+
 	/* start timer on idle -> active transitions */
 	if (job->timeout && idle)
 		cdma_start_timer_locked(cdma, job);
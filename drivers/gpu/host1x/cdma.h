@@ -57,6 +57,35 @@ enum cdma_event {
 	CDMA_EVENT_PUSH_BUFFER_SPACE	/* wait for space in push buffer */
 };
 
+/*
+ * Always-on flight recorder: a small per-channel ring of fixed-size
+ * event records written on the submit, completion and timeout paths.
+ * The history survives until it is overwritten, so a hang can be
+ * diagnosed from a crashdump or a status dump without reproducing it.
+ */
+#define HOST1X_CDMA_FLIGHT_EVENTS	32
+
+enum host1x_cdma_flight_event {
+	HOST1X_CDMA_FLIGHT_SUBMIT,
+	HOST1X_CDMA_FLIGHT_COMPLETE,
+	HOST1X_CDMA_FLIGHT_TIMEOUT,
+};
+
+struct host1x_cdma_flight_entry {
+	u64 timestamp;			/* local_clock() at record time */
+	u32 event;			/* enum host1x_cdma_flight_event */
+	u32 dmaget;			/* DMAGET of the affected job */
+	u32 dmaput;			/* last value written to DMAPUT */
+	u32 syncpt_id;
+	u32 syncpt_min;
+	u32 syncpt_max;
+};
+
+struct host1x_cdma_flight {
+	u32 head;			/* free running write counter */
+	struct host1x_cdma_flight_entry entries[HOST1X_CDMA_FLIGHT_EVENTS];
+};
+
 struct host1x_cdma {
 	struct mutex lock;		/* controls access to shared state */
 	struct completion complete;	/* signalled when event occurs */
@@ -71,6 +100,7 @@ struct host1x_cdma {
 	bool running;
 	bool torndown;
 	struct work_struct update_work;
+	struct host1x_cdma_flight flight;	/* always-on event history */
 };
 
 #define cdma_to_channel(cdma) container_of(cdma, struct host1x_channel, cdma)
@@ -81,6 +111,8 @@ int host1x_cdma_init(struct host1x_cdma *cdma);
 int host1x_cdma_deinit(struct host1x_cdma *cdma);
 int host1x_cdma_begin(struct host1x_cdma *cdma, struct host1x_job *job);
 void host1x_cdma_push(struct host1x_cdma *cdma, u32 op1, u32 op2);
+void host1x_cdma_push_vector(struct host1x_cdma *cdma, const u32 *words,
+			     unsigned int count);
 void host1x_cdma_push_wide(struct host1x_cdma *cdma, u32 op1, u32 op2,
 			   u32 op3, u32 op4);
 void host1x_cdma_end(struct host1x_cdma *cdma, struct host1x_job *job);
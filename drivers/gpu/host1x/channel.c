@@ -86,6 +86,15 @@ static void release_channel(struct kref *kref)
 	struct host1x *host = dev_get_drvdata(channel->dev->parent);
 	struct host1x_channel_list *chlist = &host->channel_list;
 
+	/*
+	 * Reserved channels stay initialized so the owning client can
+	 * reacquire them without going through CDMA setup again.
+	 */
+	if (channel->reserved_for) {
+		channel->idle = true;
+		return;
+	}
+
 	host1x_hw_cdma_stop(host, &channel->cdma);
 	host1x_cdma_deinit(&channel->cdma);
 
@@ -117,12 +126,32 @@ static struct host1x_channel *acquire_unused_channel(struct host1x *host)
 	return &chlist->channels[index];
 }
 
+static struct host1x_channel *acquire_reserved_channel(struct host1x *host,
+						       struct host1x_client *client)
+{
+	struct host1x_channel_list *chlist = &host->channel_list;
+	unsigned int max_channels = host->info->nb_channels;
+	unsigned int index;
+
+	for (index = 0; index < max_channels; index++) {
+		struct host1x_channel *channel = &chlist->channels[index];
+
+		if (channel->reserved_for == client && channel->idle) {
+			channel->idle = false;
+			return channel;
+		}
+	}
+
+	return NULL;
+}
+
 /**
  * host1x_channel_request() - Allocate a channel
  * @client: Host1x client this channel will be used to send commands to
  *
- * Allocates a new host1x channel for @client. May return NULL if CDMA
- * initialization fails.
+ * Allocates a new host1x channel for @client. If @client has reserved
+ * channels, an idle one is reused without reinitializing the hardware.
+ * May return NULL if CDMA initialization fails.
  */
 struct host1x_channel *host1x_channel_request(struct host1x_client *client)
 {
@@ -131,6 +160,12 @@ struct host1x_channel *host1x_channel_request(struct host1x_client *client)
 	struct host1x_channel *channel;
 	int err;
 
+	channel = acquire_reserved_channel(host, client);
+	if (channel) {
+		kref_init(&channel->refcount);
+		return channel;
+	}
+
 	channel = acquire_unused_channel(host);
 	if (!channel)
 		return NULL;
@@ -158,3 +193,80 @@ fail:
 	return NULL;
 }
 EXPORT_SYMBOL(host1x_channel_request);
+
+/**
+ * host1x_channel_reserve() - Pre-claim channels for a client
+ * @client: Host1x client the channels are reserved for
+ * @count: Number of channels to reserve
+ *
+ * Reserves @count channels for exclusive reuse by @client. Reserved
+ * channels keep their hardware state across host1x_channel_put() and
+ * are handed back by host1x_channel_request() without going through
+ * channel and CDMA initialization, so reacquiring a channel in a frame
+ * loop has no setup cost. Returns 0 on success or a negative error
+ * code; on failure no channels remain reserved.
+ */
+int host1x_channel_reserve(struct host1x_client *client, unsigned int count)
+{
+	struct host1x_channel **channels;
+	unsigned int i;
+	int err = 0;
+
+	channels = kcalloc(count, sizeof(*channels), GFP_KERNEL);
+	if (!channels)
+		return -ENOMEM;
+
+	for (i = 0; i < count; i++) {
+		channels[i] = host1x_channel_request(client);
+		if (!channels[i]) {
+			err = -EBUSY;
+			break;
+		}
+	}
+
+	while (i--) {
+		if (!err)
+			channels[i]->reserved_for = client;
+
+		host1x_channel_put(channels[i]);
+	}
+
+	kfree(channels);
+
+	return err;
+}
+EXPORT_SYMBOL(host1x_channel_reserve);
+
+/**
+ * host1x_channel_unreserve() - Release a client's reserved channels
+ * @client: Host1x client whose reservations are dropped
+ *
+ * Tears down all idle channels reserved by @client and returns them to
+ * the free pool. Reserved channels that are still in use lose their
+ * reservation and are released normally on their final
+ * host1x_channel_put().
+ */
+void host1x_channel_unreserve(struct host1x_client *client)
+{
+	struct host1x *host = dev_get_drvdata(client->dev->parent);
+	struct host1x_channel_list *chlist = &host->channel_list;
+	unsigned int max_channels = host->info->nb_channels;
+	unsigned int index;
+
+	for (index = 0; index < max_channels; index++) {
+		struct host1x_channel *channel = &chlist->channels[index];
+
+		if (channel->reserved_for != client)
+			continue;
+
+		channel->reserved_for = NULL;
+
+		if (channel->idle) {
+			channel->idle = false;
+			host1x_hw_cdma_stop(host, &channel->cdma);
+			host1x_cdma_deinit(&channel->cdma);
+			clear_bit(channel->id, chlist->allocated_channels);
+		}
+	}
+}
+EXPORT_SYMBOL(host1x_channel_unreserve);
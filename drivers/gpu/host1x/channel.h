@@ -29,6 +29,10 @@ struct host1x_channel {
 	struct host1x_client *client;
 	struct device *dev;
 	struct host1x_cdma cdma;
+	/* owner of the reserved channel pool this channel belongs to */
+	struct host1x_client *reserved_for;
+	/* reserved channel is initialized but currently unused */
+	bool idle;
 };
 
 /* channel list operations */
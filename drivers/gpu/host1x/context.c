@@ -23,6 +23,7 @@ int host1x_memory_context_list_init(struct host1x *host1x)
 
 	cdl->devs = NULL;
 	cdl->len = 0;
+	cdl->age = 0;
 	mutex_init(&cdl->lock);
 
 	err = of_property_count_u32_elems(node, "iommu-map");
@@ -96,8 +97,10 @@ void host1x_memory_context_list_free(struct host1x_memory_context_list *cdl)
 {
 	unsigned int i;
 
-	for (i = 0; i < cdl->len; i++)
+	for (i = 0; i < cdl->len; i++) {
+		put_pid(cdl->devs[i].prev_owner);
 		device_del(&cdl->devs[i].dev);
+	}
 
 	kfree(cdl->devs);
 	cdl->len = 0;
@@ -122,9 +125,24 @@ struct host1x_memory_context *host1x_memory_context_alloc(struct host1x *host1x,
 			refcount_inc(&cd->ref);
 			mutex_unlock(&cdl->lock);
 			return cd;
-		} else if (!cd->owner && !free) {
+		}
+
+		if (cd->owner)
+			continue;
+
+		/*
+		 * A device last used by this client keeps its stream ID
+		 * and SMMU domain warm for it - prefer it outright.
+		 * Otherwise claim the coldest released device so warm
+		 * associations survive as long as possible.
+		 */
+		if (cd->prev_owner == pid) {
 			free = cd;
+			break;
 		}
+
+		if (!free || cd->released < free->released)
+			free = cd;
 	}
 
 	if (!free) {
@@ -132,6 +150,8 @@ struct host1x_memory_context *host1x_memory_context_alloc(struct host1x *host1x,
 		return ERR_PTR(-EBUSY);
 	}
 
+	put_pid(free->prev_owner);
+	free->prev_owner = NULL;
 	refcount_set(&free->ref, 1);
 	free->owner = get_pid(pid);
 
@@ -152,8 +172,14 @@ void host1x_memory_context_put(struct host1x_memory_context *cd)
 	struct host1x_memory_context_list *cdl = &cd->host->context_list;
 
 	if (refcount_dec_and_mutex_lock(&cd->ref, &cdl->lock)) {
-		put_pid(cd->owner);
+		/*
+		 * Hand the pid reference over as a warm-reuse hint so a
+		 * returning client is matched back to this device.
+		 */
+		put_pid(cd->prev_owner);
+		cd->prev_owner = cd->owner;
 		cd->owner = NULL;
+		cd->released = ++cdl->age;
 		mutex_unlock(&cdl->lock);
 	}
 }
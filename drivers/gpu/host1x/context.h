@@ -19,6 +19,8 @@ struct host1x_memory_context_list {
 	struct mutex lock;
 	struct host1x_memory_context *devs;
 	unsigned int len;
+	/* monotonic stamp source for coldest-first context reclaim */
+	unsigned long age;
 };
 
 #ifdef CONFIG_IOMMU_API
@@ -49,6 +49,43 @@ void host1x_debug_cont(struct output *o, const char *fmt, ...)
 	o->fn(o->ctx, o->buf, len, true);
 }
 
+static const char * const flight_event_names[] = {
+	"submit", "complete", "timeout",
+};
+
+static void show_flight_recorder(struct host1x_channel *ch, struct output *o)
+{
+	struct host1x_cdma_flight *flight = &ch->cdma.flight;
+	u32 head = READ_ONCE(flight->head);
+	u32 count = min_t(u32, head, HOST1X_CDMA_FLIGHT_EVENTS);
+	u32 i;
+
+	if (count == 0)
+		return;
+
+	/* pairs with the publishing barrier in the recording path */
+	smp_rmb();
+
+	host1x_debug_output(o, "%u flight recorder events (latest last):\n",
+			    count);
+
+	for (i = head - count; i != head; i++) {
+		struct host1x_cdma_flight_entry *entry =
+			&flight->entries[i % HOST1X_CDMA_FLIGHT_EVENTS];
+		u64 ts = entry->timestamp;
+
+		host1x_debug_output(o,
+				    "  [%llu.%06llu] %-8s get %08x put %08x syncpt %u (min %u max %u)\n",
+				    ts / NSEC_PER_SEC,
+				    (ts % NSEC_PER_SEC) / NSEC_PER_USEC,
+				    flight_event_names[entry->event %
+					ARRAY_SIZE(flight_event_names)],
+				    entry->dmaget, entry->dmaput,
+				    entry->syncpt_id, entry->syncpt_min,
+				    entry->syncpt_max);
+	}
+}
+
 static int show_channel(struct host1x_channel *ch, void *data, bool show_fifo)
 {
 	struct host1x *m = dev_get_drvdata(ch->dev->parent);
@@ -67,6 +104,8 @@ static int show_channel(struct host1x_channel *ch, void *data, bool show_fifo)
 
 	host1x_hw_show_channel_cdma(m, ch, o);
 
+	show_flight_recorder(ch, o);
+
 	mutex_unlock(&debug_lock);
 	mutex_unlock(&ch->cdma.lock);
 
@@ -32,6 +32,7 @@
 #include "context.h"
 #include "debug.h"
 #include "dev.h"
+#include "fence.h"
 #include "intr.h"
 
 #include "hw/host1x01.h"
@@ -890,13 +891,24 @@ static int __init tegra_host1x_init(void)
 {
 	int err;
 
-	err = bus_register(&host1x_bus_type);
+	err = host1x_fence_cache_init();
 	if (err < 0)
 		return err;
 
+	err = bus_register(&host1x_bus_type);
+	if (err < 0)
+		goto destroy_cache;
+
 	err = platform_register_drivers(drivers, ARRAY_SIZE(drivers));
 	if (err < 0)
-		bus_unregister(&host1x_bus_type);
+		goto unregister_bus;
+
+	return 0;
+
+unregister_bus:
+	bus_unregister(&host1x_bus_type);
+destroy_cache:
+	host1x_fence_cache_exit();
 
 	return err;
 }
@@ -906,6 +918,7 @@ static void __exit tegra_host1x_exit(void)
 {
 	platform_unregister_drivers(drivers, ARRAY_SIZE(drivers));
 	bus_unregister(&host1x_bus_type);
+	host1x_fence_cache_exit();
 }
 module_exit(tegra_host1x_exit);
 
@@ -6,6 +6,7 @@
  */
 
 #include <linux/dma-fence.h>
+#include <linux/dma-fence-array.h>
 #include <linux/file.h>
 #include <linux/fs.h>
 #include <linux/slab.h>
@@ -15,6 +16,23 @@
 #include "intr.h"
 #include "syncpt.h"
 
+/* Fences are created and destroyed on every submission; use a slab. */
+static struct kmem_cache *host1x_fence_cache;
+
+int host1x_fence_cache_init(void)
+{
+	host1x_fence_cache = KMEM_CACHE(host1x_syncpt_fence, 0);
+	if (!host1x_fence_cache)
+		return -ENOMEM;
+
+	return 0;
+}
+
+void host1x_fence_cache_exit(void)
+{
+	kmem_cache_destroy(host1x_fence_cache);
+}
+
 static const char *host1x_syncpt_fence_get_driver_name(struct dma_fence *f)
 {
 	return "host1x";
@@ -66,10 +84,23 @@ static bool host1x_syncpt_fence_enable_signaling(struct dma_fence *f)
 	return true;
 }
 
+static void host1x_syncpt_fence_free_rcu(struct rcu_head *rcu)
+{
+	struct dma_fence *f = container_of(rcu, struct dma_fence, rcu);
+
+	kmem_cache_free(host1x_fence_cache, to_host1x_fence(f));
+}
+
+static void host1x_syncpt_fence_release(struct dma_fence *f)
+{
+	call_rcu(&f->rcu, host1x_syncpt_fence_free_rcu);
+}
+
 const struct dma_fence_ops host1x_syncpt_fence_ops = {
 	.get_driver_name = host1x_syncpt_fence_get_driver_name,
 	.get_timeline_name = host1x_syncpt_fence_get_timeline_name,
 	.enable_signaling = host1x_syncpt_fence_enable_signaling,
+	.release = host1x_syncpt_fence_release,
 };
 
 void host1x_fence_signal(struct host1x_syncpt_fence *f)
@@ -122,28 +153,104 @@ static void do_fence_timeout(struct work_struct *work)
 		dma_fence_put(&f->base);
 }
 
-struct dma_fence *host1x_fence_create(struct host1x_syncpt *sp, u32 threshold,
-				      bool timeout)
+static struct host1x_syncpt_fence *host1x_fence_alloc(struct host1x_syncpt *sp,
+						      u32 threshold,
+						      bool timeout,
+						      u64 context)
 {
 	struct host1x_syncpt_fence *fence;
 
-	fence = kzalloc(sizeof(*fence), GFP_KERNEL);
+	fence = kmem_cache_zalloc(host1x_fence_cache, GFP_KERNEL);
 	if (!fence)
-		return ERR_PTR(-ENOMEM);
+		return NULL;
 
 	fence->sp = sp;
 	fence->threshold = threshold;
 	fence->timeout = timeout;
 
 	dma_fence_init(&fence->base, &host1x_syncpt_fence_ops, &sp->fences.lock,
-		       dma_fence_context_alloc(1), 0);
+		       context, 0);
 
 	INIT_DELAYED_WORK(&fence->timeout_work, do_fence_timeout);
 
+	return fence;
+}
+
+struct dma_fence *host1x_fence_create(struct host1x_syncpt *sp, u32 threshold,
+				      bool timeout)
+{
+	struct host1x_syncpt_fence *fence;
+
+	fence = host1x_fence_alloc(sp, threshold, timeout,
+				   dma_fence_context_alloc(1));
+	if (!fence)
+		return ERR_PTR(-ENOMEM);
+
 	return &fence->base;
 }
 EXPORT_SYMBOL(host1x_fence_create);
 
+/**
+ * host1x_fence_create_array() - create a combined fence for several thresholds
+ * @sps: array of syncpoints to wait on
+ * @thresholds: threshold for each syncpoint
+ * @count: number of (syncpoint, threshold) pairs
+ * @timeout: true if the fences should be reaped after 30s
+ *
+ * Returns a single fence that signals once every threshold has been
+ * reached. The caller registers one callback and takes one wakeup for
+ * the whole set instead of one per syncpoint.
+ */
+struct dma_fence *host1x_fence_create_array(struct host1x_syncpt **sps,
+					    u32 *thresholds,
+					    unsigned int count, bool timeout)
+{
+	struct dma_fence_array *array;
+	struct dma_fence **fences;
+	unsigned int i;
+	u64 context;
+
+	if (!count)
+		return ERR_PTR(-EINVAL);
+
+	if (count == 1)
+		return host1x_fence_create(sps[0], thresholds[0], timeout);
+
+	fences = kmalloc_array(count, sizeof(*fences), GFP_KERNEL);
+	if (!fences)
+		return ERR_PTR(-ENOMEM);
+
+	/* each fence sits on its own timeline */
+	context = dma_fence_context_alloc(count);
+
+	for (i = 0; i < count; i++) {
+		struct host1x_syncpt_fence *fence;
+
+		fence = host1x_fence_alloc(sps[i], thresholds[i], timeout,
+					   context + i);
+		if (!fence)
+			goto put_fences;
+
+		fences[i] = &fence->base;
+	}
+
+	/* the array takes ownership of the fences and the array memory */
+	array = dma_fence_array_create(count, fences,
+				       dma_fence_context_alloc(1), 0, false);
+	if (!array)
+		goto put_fences;
+
+	return &array->base;
+
+put_fences:
+	while (i--)
+		dma_fence_put(fences[i]);
+	kfree(fences);
+
+	return ERR_PTR(-ENOMEM);
+}
+EXPORT_SYMBOL(host1x_fence_create_array);
+
 int host1x_fence_extract(struct dma_fence *fence, u32 *id, u32 *threshold)
 {
 	struct host1x_syncpt_fence *f;
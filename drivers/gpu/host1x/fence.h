@@ -27,4 +27,7 @@ struct host1x_fence_list {
 
 void host1x_fence_signal(struct host1x_syncpt_fence *fence);
 
+int host1x_fence_cache_init(void);
+void host1x_fence_cache_exit(void);
+
 #endif
@@ -228,6 +228,9 @@ void host1x_syncpt_release_vblank_reservation(struct host1x_client *client,
 
 struct dma_fence *host1x_fence_create(struct host1x_syncpt *sp, u32 threshold,
 				      bool timeout);
+struct dma_fence *host1x_fence_create_array(struct host1x_syncpt **sps,
+					    u32 *thresholds,
+					    unsigned int count, bool timeout);
 int host1x_fence_extract(struct dma_fence *fence, u32 *id, u32 *threshold);
 void host1x_fence_cancel(struct dma_fence *fence);
 
@@ -239,6 +242,8 @@ struct host1x_channel;
 struct host1x_job;
 
 struct host1x_channel *host1x_channel_request(struct host1x_client *client);
+int host1x_channel_reserve(struct host1x_client *client, unsigned int count);
+void host1x_channel_unreserve(struct host1x_client *client);
 struct host1x_channel *host1x_channel_get(struct host1x_channel *channel);
 void host1x_channel_stop(struct host1x_channel *channel);
 void host1x_channel_put(struct host1x_channel *channel);
@@ -474,6 +479,10 @@ struct host1x_memory_context {
 
 	refcount_t ref;
 	struct pid *owner;
+	/* last owner, kept as a warm-reuse hint for returning clients */
+	struct pid *prev_owner;
+	/* age stamp of the last release, for coldest-first reclaim */
+	unsigned long released;
 
 	struct device dev;
 	u64 dma_mask;
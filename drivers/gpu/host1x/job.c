@@ -5,6 +5,7 @@
  * Copyright (c) 2010-2015, NVIDIA Corporation.
  */
 
+#include <linux/crc32.h>
 #include <linux/dma-mapping.h>
 #include <linux/err.h>
 #include <linux/host1x-next.h>
@@ -530,6 +531,147 @@ out:
 	return err;
 }
 
+/*
+ * Cache of previously validated gathers. Media pipelines resubmit
+ * identical command streams every frame; a gather whose contents, entry
+ * class and relocation layout match an already validated one is accepted
+ * after a memcmp instead of a full opcode parse. Entries are verified by
+ * comparison, never by hash alone, so a hash collision cannot bypass the
+ * firewall.
+ */
+struct host1x_fw_cache_entry {
+	struct list_head node;
+	u32 crc;
+	u32 words;
+	/* class at gather entry and after the last opcode */
+	u32 class;
+	u32 exit_class;
+	unsigned int num_relocs;
+	int (*is_addr_reg)(struct device *dev, u32 class, u32 reg);
+	int (*is_valid_class)(u32 class);
+	struct device *dev;
+	/* gather words followed by one reloc offset per consumed reloc */
+	u32 *data;
+};
+
+#define HOST1X_FW_CACHE_MAX_ENTRIES	128
+#define HOST1X_FW_CACHE_MAX_WORDS	4096
+
+static LIST_HEAD(fw_cache);
+static unsigned int fw_cache_entries;
+static DEFINE_MUTEX(fw_cache_lock);
+
+static bool host1x_fw_cache_lookup(struct host1x_firewall *fw,
+				   struct host1x_job_gather *g)
+{
+	u32 *data = (u32 *)fw->job->gather_copy_mapped +
+		    (g->offset / sizeof(u32));
+	u32 crc = crc32_le(~0, (void *)data, g->words * sizeof(u32));
+	struct host1x_fw_cache_entry *ent;
+	unsigned int i;
+
+	mutex_lock(&fw_cache_lock);
+
+	list_for_each_entry(ent, &fw_cache, node) {
+		const u32 *offsets;
+
+		if (ent->crc != crc || ent->words != g->words ||
+		    ent->class != fw->class ||
+		    ent->is_addr_reg != fw->job->is_addr_reg ||
+		    ent->is_valid_class != fw->job->is_valid_class ||
+		    ent->dev != fw->dev ||
+		    ent->num_relocs > fw->num_relocs)
+			continue;
+
+		if (memcmp(ent->data, data, g->words * sizeof(u32)))
+			continue;
+
+		offsets = ent->data + ent->words;
+
+		for (i = 0; i < ent->num_relocs; i++) {
+			const struct host1x_reloc *reloc = &fw->reloc[i];
+
+			if (reloc->cmdbuf.bo != g->bo || reloc->shift ||
+			    reloc->cmdbuf.offset != offsets[i])
+				break;
+		}
+
+		if (i < ent->num_relocs)
+			continue;
+
+		/* consume the relocs exactly as validate() would have */
+		fw->reloc += ent->num_relocs;
+		fw->num_relocs -= ent->num_relocs;
+		fw->class = ent->exit_class;
+
+		list_move(&ent->node, &fw_cache);
+		mutex_unlock(&fw_cache_lock);
+
+		return true;
+	}
+
+	mutex_unlock(&fw_cache_lock);
+
+	return false;
+}
+
+static void host1x_fw_cache_add(struct host1x_firewall *fw,
+				struct host1x_job_gather *g, u32 entry_class,
+				struct host1x_reloc *relocs,
+				unsigned int num_relocs)
+{
+	u32 *data = (u32 *)fw->job->gather_copy_mapped +
+		    (g->offset / sizeof(u32));
+	struct host1x_fw_cache_entry *ent;
+	unsigned int i;
+
+	if (g->words > HOST1X_FW_CACHE_MAX_WORDS)
+		return;
+
+	ent = kmalloc(sizeof(*ent), GFP_KERNEL);
+	if (!ent)
+		return;
+
+	ent->data = kmalloc_array(g->words + num_relocs, sizeof(u32),
+				  GFP_KERNEL);
+	if (!ent->data) {
+		kfree(ent);
+		return;
+	}
+
+	memcpy(ent->data, data, g->words * sizeof(u32));
+
+	for (i = 0; i < num_relocs; i++)
+		ent->data[g->words + i] = relocs[i].cmdbuf.offset;
+
+	ent->crc = crc32_le(~0, (void *)data, g->words * sizeof(u32));
+	ent->words = g->words;
+	ent->class = entry_class;
+	ent->exit_class = fw->class;
+	ent->num_relocs = num_relocs;
+	ent->is_addr_reg = fw->job->is_addr_reg;
+	ent->is_valid_class = fw->job->is_valid_class;
+	ent->dev = fw->dev;
+
+	mutex_lock(&fw_cache_lock);
+
+	if (fw_cache_entries >= HOST1X_FW_CACHE_MAX_ENTRIES) {
+		struct host1x_fw_cache_entry *victim =
+			list_last_entry(&fw_cache,
+					struct host1x_fw_cache_entry, node);
+
+		list_del(&victim->node);
+		kfree(victim->data);
+		kfree(victim);
+		fw_cache_entries--;
+	}
+
+	list_add(&ent->node, &fw_cache);
+	fw_cache_entries++;
+
+	mutex_unlock(&fw_cache_lock);
+}
+
 static inline int copy_gathers(struct device *host, struct host1x_job *job,
 			       struct device *dev)
 {
@@ -590,9 +732,17 @@ static inline int copy_gathers(struct device *host, struct host1x_job *job,
 		g->base = job->gather_copy;
 		g->offset = offset;
 
-		/* Validate the job */
-		if (validate(&fw, g))
-			return -EINVAL;
+		/* Validate the job, reusing a cached result if possible */
+		if (!host1x_fw_cache_lookup(&fw, g)) {
+			struct host1x_reloc *relocs = fw.reloc;
+			u32 entry_class = fw.class;
+
+			if (validate(&fw, g))
+				return -EINVAL;
+
+			host1x_fw_cache_add(&fw, g, entry_class, relocs,
+					    fw.reloc - relocs);
+		}
 
 		offset += g->words * sizeof(u32);
 	}
@@ -47,6 +47,15 @@
  */
 #define CAPTURE_CHANNEL_ISP_INVALID_ID	U16_C(0xFFFF)
 
+/**
+ * @brief Timeout for RCE to release a program descriptor slot [ms].
+ *
+ * A staged replacement program takes effect at the next frame boundary,
+ * at which point RCE releases the descriptor it supersedes; a couple of
+ * frame intervals is sufficient even at low frame rates.
+ */
+#define ISP_PROGRAM_RELEASE_TIMEOUT_MS	200
+
 /**
  * @brief ISP channel process descriptor queue context.
  */
@@ -67,6 +76,9 @@ struct isp_desc_rec {
 	struct mutex unpins_list_lock; /**< Lock for unpins_list */
 	struct capture_common_unpins *unpins_list;
 		/**< List of process request buffer unpins */
+
+	wait_queue_head_t release_wait;
+		/**< Waiters for descriptor release by RCE */
 };
 
 /**
@@ -531,6 +543,7 @@ static void isp_capture_request_unpin(
 		for (i = 0; i < unpins->num_unpins; i++)
 			put_mapping(capture->buffer_ctx, unpins->data[i]);
 		(void)memset(unpins, 0U, sizeof(*unpins));
+		wake_up(&capture->capture_desc_ctx.release_wait);
 	}
 	mutex_unlock(&capture->capture_desc_ctx.unpins_list_lock);
 }
@@ -556,6 +569,7 @@ static void isp_capture_program_request_unpin(
 		for (i = 0; i < unpins->num_unpins; i++)
 			put_mapping(capture->buffer_ctx, unpins->data[i]);
 		(void)memset(unpins, 0U, sizeof(*unpins));
+		wake_up(&capture->program_desc_ctx.release_wait);
 	}
 	mutex_unlock(&capture->program_desc_ctx.unpins_list_lock);
 }
@@ -622,11 +636,34 @@ static int isp_capture_program_prepare(
 	mutex_lock(&capture->program_desc_ctx.unpins_list_lock);
 
 	if (capture->program_desc_ctx.unpins_list[req->buffer_index].num_unpins != 0) {
-		dev_err(chan->isp_dev,
-			"%s: program request is still in use by rtcpu\n",
-			__func__);
 		mutex_unlock(&capture->program_desc_ctx.unpins_list_lock);
-		return -EBUSY;
+
+		/*
+		 * The descriptor is still attached to an in-flight frame.
+		 * RCE releases it at the frame boundary once a replacement
+		 * program takes effect, so wait for the release instead of
+		 * failing: this lets the next-frame program be staged while
+		 * the current frame is still processing.
+		 */
+		err = wait_event_interruptible_timeout(
+			capture->program_desc_ctx.release_wait,
+			capture->program_desc_ctx.unpins_list[
+				req->buffer_index].num_unpins == 0U,
+			msecs_to_jiffies(ISP_PROGRAM_RELEASE_TIMEOUT_MS));
+		if (err < 0)
+			return err;
+
+		mutex_lock(&capture->program_desc_ctx.unpins_list_lock);
+
+		if (capture->program_desc_ctx.unpins_list[
+				req->buffer_index].num_unpins != 0) {
+			dev_err(chan->isp_dev,
+				"%s: program request is still in use by rtcpu\n",
+				__func__);
+			mutex_unlock(
+				&capture->program_desc_ctx.unpins_list_lock);
+			return -EBUSY;
+		}
 	}
 
 	meminfo = &((struct memoryinfo_surface *)
@@ -959,6 +996,9 @@ int isp_capture_init(
 	mutex_init(&capture->program_desc_ctx.unpins_list_lock);
 	mutex_init(&capture->reset_lock);
 
+	init_waitqueue_head(&capture->capture_desc_ctx.release_wait);
+	init_waitqueue_head(&capture->program_desc_ctx.release_wait);
+
 	capture->isp_channel = chan;
 	chan->capture_data = capture;
 
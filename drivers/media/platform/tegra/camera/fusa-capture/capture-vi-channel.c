@@ -178,6 +178,60 @@
 #define VI_CAPTURE_BUFFER_REQUEST \
 	_IOW('I', 10, struct vi_buffer_req)
 
+/**
+ * @brief Enqueue a batch of capture requests to RCE in one call; each entry
+ * is pinned and submitted exactly as in @ref VI_CAPTURE_REQUEST, in array
+ * order.
+ *
+ * Pre-enqueueing several future requests keeps the next capture descriptor
+ * resident in RCE across frame boundaries, so the request submission is not
+ * on the frame-interval critical path.
+ *
+ * @note On failure, requests before the failing entry remain enqueued and
+ * will complete normally.
+ *
+ * @param[in]	ptr	Pointer to a struct @ref vi_capture_req_ring
+ *
+ * @returns	0 (success), neg. errno (failure)
+ */
+#define VI_CAPTURE_REQUEST_RING \
+	_IOW('I', 11, struct vi_capture_req_ring)
+
+/**
+ * @brief Recover an errored VI channel in place: the channel is reset in RCE
+ * but buffer pins, the capture descriptor queue and the FW channel allocation
+ * are retained, and the capture requests that were in flight are resubmitted
+ * automatically in their original order.
+ *
+ * This is the fast-restart alternative to the full
+ * @ref VI_CAPTURE_RESET / re-enqueue cycle after a stream error.
+ *
+ * @param[in]	reset_flags	uint32_t bitmask of
+ *				@ref CAPTURE_CHANNEL_RESET_FLAGS
+ *
+ * @returns	0 (success), neg. errno (failure)
+ */
+#define VI_CAPTURE_RECOVER \
+	_IOW('I', 12, __u32)
+
+/**
+ * @brief Configure early-completion notification at scanline granularity: the
+ * channel's line timer syncpoint is signalled when the configured scanline of
+ * each frame has been written to memory, ahead of the end-of-frame progress
+ * syncpoint, so that downstream engines can start consuming the top of the
+ * frame while the bottom is still being captured.
+ *
+ * The channel must have been set up with
+ * @ref CAPTURE_CHANNEL_FLAG_LINETIMER. The configuration applies to capture
+ * requests submitted after this call.
+ *
+ * @param[in]	ptr	Pointer to a struct @ref vi_capture_early_notify
+ *
+ * @returns	0 (success), neg. errno (failure)
+ */
+#define VI_CAPTURE_SET_EARLY_NOTIFY \
+	_IOW('I', 13, struct vi_capture_early_notify)
+
 /** @} */
 
 void vi_capture_request_unpin(
@@ -382,6 +436,73 @@ fail:
 	return err;
 }
 
+/**
+ * @brief Validate, pin and submit a single capture request to RCE.
+ *
+ * Common backend of @ref VI_CAPTURE_REQUEST and @ref VI_CAPTURE_REQUEST_RING.
+ *
+ * @param[in]	chan	VI channel context
+ * @param[in]	req	Capture request to enqueue
+ *
+ * @returns	0 (success), neg. errno (failure)
+ */
+static int vi_channel_capture_enqueue(
+	struct tegra_vi_channel *chan,
+	struct vi_capture_req *req)
+{
+	struct vi_capture *capture = chan->capture_data;
+	struct capture_common_unpins *request_unpins;
+	int err;
+
+	if (req->num_relocs == 0) {
+		dev_err(chan->dev, "request must have non-zero relocs\n");
+		return -EINVAL;
+	}
+
+	if (req->buffer_index >= capture->queue_depth) {
+		dev_err(chan->dev, "buffer index is out of bound\n");
+		return -EINVAL;
+	}
+
+	/* Don't let to speculate with invalid buffer_index value */
+	spec_bar();
+
+	if (capture->unpins_list == NULL) {
+		dev_err(chan->dev, "Channel setup incomplete\n");
+		return -EINVAL;
+	}
+
+	mutex_lock(&capture->unpins_list_lock);
+
+	request_unpins = &capture->unpins_list[req->buffer_index];
+
+	if (request_unpins->num_unpins != 0U) {
+		dev_err(chan->dev, "Descriptor is still in use by rtcpu\n");
+		mutex_unlock(&capture->unpins_list_lock);
+		return -EBUSY;
+	}
+	err = pin_vi_capture_request_buffers_locked(chan, req,
+			request_unpins);
+
+	mutex_unlock(&capture->unpins_list_lock);
+
+	if (err < 0) {
+		dev_err(chan->dev,
+			"pin request failed\n");
+		vi_capture_request_unpin(chan, req->buffer_index);
+		return err;
+	}
+
+	err = vi_capture_request(chan, req);
+	if (err < 0) {
+		dev_err(chan->dev,
+			"vi capture request submit failed\n");
+		vi_capture_request_unpin(chan, req->buffer_index);
+	}
+
+	return err;
+}
+
 /**
  * @brief Process an IOCTL call on a VI channel character device.
  *
@@ -496,6 +617,20 @@ static long vi_channel_ioctl(
 		break;
 	}
 
+	case _IOC_NR(VI_CAPTURE_RECOVER): {
+		uint32_t reset_flags;
+
+		if (copy_from_user(&reset_flags, ptr, sizeof(reset_flags)))
+			break;
+
+		/* Pins are kept: the resubmitted requests reuse them */
+		err = vi_capture_recover(chan, reset_flags);
+		if (err < 0)
+			dev_err(chan->dev, "vi capture recover failed\n");
+
+		break;
+	}
+
 	case _IOC_NR(VI_CAPTURE_RELEASE): {
 		uint32_t reset_flags;
 		int i;
@@ -514,6 +649,8 @@ static long vi_channel_ioctl(
 			capture->buf_ctx = NULL;
 			vfree(capture->unpins_list);
 			capture->unpins_list = NULL;
+			vfree(capture->pending_seq);
+			capture->pending_seq = NULL;
 		}
 
 		break;
@@ -546,57 +683,57 @@ static long vi_channel_ioctl(
 
 	case _IOC_NR(VI_CAPTURE_REQUEST): {
 		struct vi_capture_req req;
-		struct capture_common_unpins *request_unpins;
 
 		if (copy_from_user(&req, ptr, sizeof(req)))
 			break;
 
-		if (req.num_relocs == 0) {
-			dev_err(chan->dev, "request must have non-zero relocs\n");
-			return -EINVAL;
-		}
+		err = vi_channel_capture_enqueue(chan, &req);
 
-		if (req.buffer_index >= capture->queue_depth) {
-			dev_err(chan->dev, "buffer index is out of bound\n");
-			return -EINVAL;
-		}
+		break;
+	}
+
+	case _IOC_NR(VI_CAPTURE_REQUEST_RING): {
+		struct vi_capture_req_ring ring;
+		struct vi_capture_req *reqs;
+		uint32_t i;
 
-		/* Don't let to speculate with invalid buffer_index value */
-		spec_bar();
+		if (copy_from_user(&ring, ptr, sizeof(ring)))
+			break;
 
-		if (capture->unpins_list == NULL) {
+		if (capture == NULL) {
 			dev_err(chan->dev, "Channel setup incomplete\n");
 			return -EINVAL;
 		}
 
-		mutex_lock(&capture->unpins_list_lock);
-
-		request_unpins = &capture->unpins_list[req.buffer_index];
-
-		if (request_unpins->num_unpins != 0U) {
-			dev_err(chan->dev, "Descriptor is still in use by rtcpu\n");
-			mutex_unlock(&capture->unpins_list_lock);
-			return -EBUSY;
+		if (ring.num_reqs == 0 ||
+				ring.num_reqs > capture->queue_depth) {
+			dev_err(chan->dev, "invalid request count %u\n",
+				ring.num_reqs);
+			return -EINVAL;
 		}
-		err = pin_vi_capture_request_buffers_locked(chan, &req,
-				request_unpins);
 
-		mutex_unlock(&capture->unpins_list_lock);
+		reqs = kcalloc(ring.num_reqs, sizeof(*reqs), GFP_KERNEL);
+		if (reqs == NULL)
+			return -ENOMEM;
 
-		if (err < 0) {
-			dev_err(chan->dev,
-				"pin request failed\n");
-			vi_capture_request_unpin(chan, req.buffer_index);
+		if (copy_from_user(reqs, (void __user *)(uintptr_t)ring.reqs,
+				ring.num_reqs * sizeof(*reqs))) {
+			kfree(reqs);
 			break;
 		}
 
-		err = vi_capture_request(chan, &req);
-		if (err < 0) {
-			dev_err(chan->dev,
-				"vi capture request submit failed\n");
-			vi_capture_request_unpin(chan, req.buffer_index);
+		/*
+		 * Requests enqueued before a failing entry stay queued;
+		 * their completions retire them as usual.
+		 */
+		err = 0;
+		for (i = 0; i < ring.num_reqs; i++) {
+			err = vi_channel_capture_enqueue(chan, &reqs[i]);
+			if (err < 0)
+				break;
 		}
 
+		kfree(reqs);
 		break;
 	}
 
@@ -624,6 +761,18 @@ static long vi_channel_ioctl(
 		break;
 	}
 
+	case _IOC_NR(VI_CAPTURE_SET_EARLY_NOTIFY): {
+		struct vi_capture_early_notify notify;
+
+		if (copy_from_user(&notify, ptr, sizeof(notify)))
+			break;
+		err = vi_capture_set_early_notify(chan, &notify);
+		if (err < 0)
+			dev_err(chan->dev,
+				"setting early notify failed\n");
+		break;
+	}
+
 	case _IOC_NR(VI_CAPTURE_SET_PROGRESS_STATUS_NOTIFIER): {
 		struct vi_capture_progress_status_req req;
 
@@ -28,6 +28,7 @@
 
 #include <asm/arch_timer.h>
 #include <uapi/linux/nvhost_events.h>
+#include <uapi/linux/nvhost_pipeline_events.h>
 #include <camera/nvcamera_log.h>
 #include "soc/tegra/camrtc-capture.h"
 #include "soc/tegra/camrtc-capture-messages.h"
@@ -273,6 +274,104 @@ static int vi_capture_read_syncpt(
 	return 0;
 }
 
+/**
+ * @brief Derive the pipeline trace id of a capture request.
+ *
+ * The capture request format cannot carry a client-assigned id, so the
+ * id is derived as documented in uapi/linux/nvhost_pipeline_events.h.
+ *
+ * @param[in]	channel_id	RCE-assigned capture channel id
+ * @param[in]	buffer_index	Capture descriptor index
+ *
+ * @returns	pipeline trace id
+ */
+static inline uint64_t vi_capture_trace_id(
+	uint32_t channel_id,
+	uint32_t buffer_index)
+{
+	return ((uint64_t)channel_id << 32) | buffer_index;
+}
+
+/**
+ * @brief Complete a capture request: clear its pending sequence number,
+ * unpin its buffers, sync the capture descriptor for CPU access and
+ * signal completion through the progress status notifier or the
+ * capture_resp completion.
+ *
+ * Shared between the IVC @ref CAPTURE_STATUS_IND path and the
+ * syncpoint-backed completion path enabled with
+ * @ref CAPTURE_CHANNEL_FLAG_SILENT_STATUS.
+ *
+ * @param[in]	chan		VI channel context
+ * @param[in]	buffer_index	Descriptor queue index of the request
+ */
+static void vi_capture_complete_frame(
+	struct tegra_vi_channel *chan,
+	uint32_t buffer_index)
+{
+	struct vi_capture *capture = chan->capture_data;
+
+	if (capture->pending_seq != NULL &&
+			buffer_index < capture->queue_depth)
+		WRITE_ONCE(capture->pending_seq[buffer_index], 0);
+	if (capture->is_mem_pinned)
+		vi_capture_request_unpin(chan, buffer_index);
+	dma_sync_single_range_for_cpu(capture->rtcpu_dev,
+		capture->requests.iova,
+		buffer_index * capture->request_size,
+		capture->request_size, DMA_FROM_DEVICE);
+
+	nvhost_pipeline_trace_frame(
+		vi_capture_trace_id(capture->channel_id, buffer_index),
+		NVHOST_PIPELINE_STAGE_CAPTURE_STATUS,
+		nvhost_get_devdata(chan->ndev)->class,
+		buffer_index);
+
+	if (capture->is_progress_status_notifier_set) {
+		capture_common_set_progress_status(
+				&capture->progress_status_notifier,
+				buffer_index,
+				capture->progress_status_buffer_depth,
+				PROGRESS_STATUS_DONE);
+	} else {
+		/*
+		 * Only fire completions if not using
+		 * the new progress status buffer mechanism
+		 */
+		complete(&capture->capture_resp);
+	}
+}
+
+/**
+ * @brief Context of a one-shot progress syncpoint completion notifier.
+ */
+struct vi_capture_syncpt_ctx {
+	struct tegra_vi_channel *chan; /**< VI channel context */
+	uint32_t buffer_index; /**< Descriptor queue index of the request */
+};
+
+/**
+ * @brief One-shot progress syncpoint notifier, armed per capture request
+ * when @ref CAPTURE_CHANNEL_FLAG_SILENT_STATUS is set. Signals routine
+ * frame completion without a per-frame IVC status message; IVC remains
+ * the path for errors and metadata.
+ *
+ * @param[in]	pdata	struct vi_capture_syncpt_ctx of the request
+ * @param[in]	count	No. of syncpoint increments since the threshold
+ */
+static void vi_capture_syncpt_notify(void *pdata, int count)
+{
+	struct vi_capture_syncpt_ctx *ctx = pdata;
+	struct tegra_vi_channel *chan = ctx->chan;
+
+	vi_capture_complete_frame(chan, ctx->buffer_index);
+
+	dev_dbg(chan->dev, "%s: buf:%u completed by syncpt\n",
+			__func__, ctx->buffer_index);
+
+	kfree(ctx);
+}
+
 /**
  * @brief VI channel callback function for @em capture IVC messages.
  *
@@ -301,26 +400,7 @@ static void vi_capture_ivc_status_callback(
 	switch (status_msg->header.msg_id) {
 	case CAPTURE_STATUS_IND:
 		buffer_index = status_msg->capture_status_ind.buffer_index;
-		if (capture->is_mem_pinned)
-			vi_capture_request_unpin(chan, buffer_index);
-		dma_sync_single_range_for_cpu(capture->rtcpu_dev,
-			capture->requests.iova,
-			buffer_index * capture->request_size,
-			capture->request_size, DMA_FROM_DEVICE);
-
-		if (capture->is_progress_status_notifier_set) {
-			capture_common_set_progress_status(
-					&capture->progress_status_notifier,
-					buffer_index,
-					capture->progress_status_buffer_depth,
-					PROGRESS_STATUS_DONE);
-		} else {
-			/*
-			 * Only fire completions if not using
-			 * the new progress status buffer mechanism
-			 */
-			complete(&capture->capture_resp);
-		}
+		vi_capture_complete_frame(chan, buffer_index);
 		dev_dbg(chan->dev, "%s: status chan_id %u msg_id %u\n",
 				__func__, status_msg->header.channel_id,
 				status_msg->header.msg_id);
@@ -539,6 +619,8 @@ void vi_capture_shutdown(
 
 		vfree(capture->unpins_list);
 		capture->unpins_list = NULL;
+		vfree(capture->pending_seq);
+		capture->pending_seq = NULL;
 	}
 	kfree(capture);
 	chan->capture_data = NULL;
@@ -697,6 +779,10 @@ int vi_capture_setup(
 		goto syncpt_fail;
 	}
 
+	capture->syncpt_status_enable = (setup->channel_flags &
+			CAPTURE_CHANNEL_FLAG_SILENT_STATUS) != 0U;
+	capture->sp_fence = capture->progress_sp.threshold;
+
 	err = tegra_capture_ivc_register_control_cb(
 			&vi_capture_ivc_control_callback,
 			&transaction, capture);
@@ -731,6 +817,16 @@ int vi_capture_setup(
 		goto unpin_alloc_fail;
 	}
 
+	capture->pending_seq =
+		vzalloc(setup->queue_depth * sizeof(*capture->pending_seq));
+
+	if (!capture->pending_seq) {
+		dev_err(chan->dev,
+			"%s: pending_seq alloc failed\n", __func__);
+		goto pending_seq_alloc_fail;
+	}
+	capture->submit_seq = 0;
+
 	config->requests_memoryinfo = capture->requests_memoryinfo_iova;
 	config->request_memoryinfo_size =
 			sizeof(struct capture_descriptor_memoryinfo);
@@ -819,6 +915,9 @@ int vi_capture_setup(
 cb_fail:
 resp_fail:
 submit_fail:
+	vfree(capture->pending_seq);
+	capture->pending_seq = NULL;
+pending_seq_alloc_fail:
 	vfree(capture->unpins_list);
 	capture->unpins_list = NULL;
 unpin_alloc_fail:
@@ -847,7 +946,7 @@ struct tegra_vi_channel *get_tegra_vi_channel(
 	return channels[stream_id][virtual_channel_id];
 }
 
-int vi_capture_reset(
+static int vi_capture_reset_locked(
 	struct tegra_vi_channel *chan,
 	uint32_t reset_flags)
 {
@@ -859,30 +958,6 @@ int vi_capture_reset(
 	struct CAPTURE_CONTROL_MSG *resp_msg = &capture->control_resp_msg;
 	int err = 0;
 
-#if LINUX_VERSION_CODE < KERNEL_VERSION(5, 4, 0)
-	nv_camera_log(chan->ndev,
-		arch_counter_get_cntvct(),
-		NVHOST_CAMERA_VI_CAPTURE_RESET);
-#else
-	nv_camera_log(chan->ndev,
-		__arch_counter_get_cntvct(),
-		NVHOST_CAMERA_VI_CAPTURE_RESET);
-#endif
-
-	if (capture == NULL) {
-		dev_err(chan->dev,
-			 "%s: vi capture uninitialized\n", __func__);
-		return -ENODEV;
-	}
-
-	if (capture->channel_id == CAPTURE_CHANNEL_INVALID_ID) {
-		dev_err(chan->dev,
-			"%s: setup channel first\n", __func__);
-		return -ENODEV;
-	}
-
-	mutex_lock(&capture->reset_lock);
-
 #ifdef CAPTURE_RESET_BARRIER_IND
 	memset(&capture_desc, 0, sizeof(capture_desc));
 	capture_desc.header.msg_id = CAPTURE_RESET_BARRIER_IND;
@@ -920,6 +995,130 @@ int vi_capture_reset(
 	}
 
 submit_fail:
+	return err;
+}
+
+int vi_capture_reset(
+	struct tegra_vi_channel *chan,
+	uint32_t reset_flags)
+{
+	struct vi_capture *capture = chan->capture_data;
+	int err = 0;
+
+#if LINUX_VERSION_CODE < KERNEL_VERSION(5, 4, 0)
+	nv_camera_log(chan->ndev,
+		arch_counter_get_cntvct(),
+		NVHOST_CAMERA_VI_CAPTURE_RESET);
+#else
+	nv_camera_log(chan->ndev,
+		__arch_counter_get_cntvct(),
+		NVHOST_CAMERA_VI_CAPTURE_RESET);
+#endif
+
+	if (capture == NULL) {
+		dev_err(chan->dev,
+			 "%s: vi capture uninitialized\n", __func__);
+		return -ENODEV;
+	}
+
+	if (capture->channel_id == CAPTURE_CHANNEL_INVALID_ID) {
+		dev_err(chan->dev,
+			"%s: setup channel first\n", __func__);
+		return -ENODEV;
+	}
+
+	mutex_lock(&capture->reset_lock);
+	err = vi_capture_reset_locked(chan, reset_flags);
+	mutex_unlock(&capture->reset_lock);
+
+	return err;
+}
+
+int vi_capture_recover(
+	struct tegra_vi_channel *chan,
+	uint32_t reset_flags)
+{
+	struct vi_capture *capture = chan->capture_data;
+	struct CAPTURE_MSG capture_desc;
+	uint64_t last_seq = 0;
+	uint32_t resubmitted = 0;
+	uint32_t i;
+	int err = 0;
+
+	if (capture == NULL) {
+		dev_err(chan->dev,
+			 "%s: vi capture uninitialized\n", __func__);
+		return -ENODEV;
+	}
+
+	if (capture->channel_id == CAPTURE_CHANNEL_INVALID_ID) {
+		dev_err(chan->dev,
+			"%s: setup channel first\n", __func__);
+		return -ENODEV;
+	}
+
+	if (capture->pending_seq == NULL) {
+		dev_err(chan->dev,
+			"%s: channel setup incomplete\n", __func__);
+		return -ENODEV;
+	}
+
+	mutex_lock(&capture->reset_lock);
+
+	err = vi_capture_reset_locked(chan, reset_flags);
+	if (err < 0)
+		goto done;
+
+	/* Resubmit the in-flight requests in original submission order.
+	 * Buffer pins and the descriptor queue were untouched by the
+	 * reset, so re-enqueueing the buffer index is all that is needed.
+	 */
+	for (;;) {
+		uint64_t best_seq = U64_MAX;
+		uint32_t best_index = capture->queue_depth;
+
+		for (i = 0; i < capture->queue_depth; i++) {
+			uint64_t seq = READ_ONCE(capture->pending_seq[i]);
+
+			if (seq != 0 && seq > last_seq && seq < best_seq) {
+				best_seq = seq;
+				best_index = i;
+			}
+		}
+
+		if (best_index == capture->queue_depth)
+			break;
+
+		last_seq = best_seq;
+
+		memset(&capture_desc, 0, sizeof(capture_desc));
+		capture_desc.header.msg_id = CAPTURE_REQUEST_REQ;
+		capture_desc.header.channel_id = capture->channel_id;
+		capture_desc.capture_request_req.buffer_index = best_index;
+
+		err = tegra_capture_ivc_capture_submit(&capture_desc,
+				sizeof(capture_desc));
+		if (err < 0) {
+			dev_err(chan->dev,
+				"%s: IVC resubmit failed for buf:%u\n",
+				__func__, best_index);
+			goto done;
+		}
+
+		nvhost_pipeline_trace_frame(
+			vi_capture_trace_id(capture->channel_id, best_index),
+			NVHOST_PIPELINE_STAGE_CAPTURE_REQUEST,
+			nvhost_get_devdata(chan->ndev)->class,
+			best_index);
+
+		capture->pending_seq[best_index] = ++capture->submit_seq;
+		resubmitted++;
+	}
+
+	dev_dbg(chan->dev, "%s: resubmitted %u capture requests\n",
+		__func__, resubmitted);
+
+done:
 	mutex_unlock(&capture->reset_lock);
 	return err;
 }
@@ -1431,6 +1630,23 @@ int vi_capture_request(
 
 	mutex_lock(&capture->reset_lock);
 
+	if (capture->early_notify_enable &&
+			req->buffer_index < capture->queue_depth) {
+		struct capture_descriptor *desc =
+			(struct capture_descriptor *)(capture->requests.va +
+				req->buffer_index * capture->request_size);
+
+		desc->ch_cfg.line_timer_enable = 1;
+		desc->ch_cfg.line_timer_periodic =
+			capture->early_notify_periodic ? 1U : 0U;
+		desc->ch_cfg.line_timer = capture->early_notify_line;
+		desc->ch_cfg.line_timer_first = capture->early_notify_line;
+		dma_sync_single_range_for_device(capture->rtcpu_dev,
+			capture->requests.iova,
+			req->buffer_index * capture->request_size,
+			capture->request_size, DMA_TO_DEVICE);
+	}
+
 	memset(&capture_desc, 0, sizeof(capture_desc));
 	capture_desc.header.msg_id = CAPTURE_REQUEST_REQ;
 	capture_desc.header.channel_id = capture->channel_id;
@@ -1463,6 +1679,39 @@ int vi_capture_request(
 		return err;
 	}
 
+	nvhost_pipeline_trace_frame(
+		vi_capture_trace_id(capture->channel_id, req->buffer_index),
+		NVHOST_PIPELINE_STAGE_CAPTURE_REQUEST,
+		nvhost_get_devdata(chan->ndev)->class,
+		req->buffer_index);
+
+	if (capture->syncpt_status_enable) {
+		struct vi_capture_syncpt_ctx *ctx;
+		int sperr = -ENOMEM;
+
+		ctx = kzalloc(sizeof(*ctx), GFP_KERNEL);
+		if (ctx != NULL) {
+			ctx->chan = chan;
+			ctx->buffer_index = req->buffer_index;
+			/* progress syncpoint increments once per frame */
+			sperr = nvhost_intr_register_notifier(chan->ndev,
+					capture->progress_sp.id,
+					++capture->sp_fence,
+					vi_capture_syncpt_notify, ctx);
+			if (sperr < 0)
+				kfree(ctx);
+		}
+		if (sperr < 0)
+			dev_err(chan->dev,
+				"failed to arm completion syncpt: %d\n",
+				sperr);
+	}
+
+	if (capture->pending_seq != NULL &&
+			req->buffer_index < capture->queue_depth)
+		capture->pending_seq[req->buffer_index] =
+			++capture->submit_seq;
+
 	mutex_unlock(&capture->reset_lock);
 
 	return 0;
@@ -1523,6 +1772,44 @@ int vi_capture_status(
 	return 0;
 }
 
+int vi_capture_set_early_notify(struct tegra_vi_channel *chan,
+		struct vi_capture_early_notify *notify)
+{
+	struct vi_capture *capture = chan->capture_data;
+
+	if (capture == NULL) {
+		dev_err(chan->dev,
+			"%s: vi capture uninitialized\n", __func__);
+		return -ENODEV;
+	}
+
+	if (capture->channel_id == CAPTURE_CHANNEL_INVALID_ID) {
+		dev_err(chan->dev,
+			"%s: setup channel first\n", __func__);
+		return -ENODEV;
+	}
+
+	if (notify->enable && capture->linetimer_sp.id == 0U) {
+		dev_err(chan->dev,
+			"%s: channel has no line timer syncpoint\n", __func__);
+		return -EINVAL;
+	}
+
+	if (notify->enable && notify->line == 0U) {
+		dev_err(chan->dev,
+			"%s: invalid line timer scanline\n", __func__);
+		return -EINVAL;
+	}
+
+	mutex_lock(&capture->reset_lock);
+	capture->early_notify_enable = (notify->enable != 0U);
+	capture->early_notify_periodic = (notify->periodic != 0U);
+	capture->early_notify_line = notify->line;
+	mutex_unlock(&capture->reset_lock);
+
+	return 0;
+}
+
 int vi_capture_set_compand(struct tegra_vi_channel *chan,
 		struct vi_capture_compand *compand)
 {
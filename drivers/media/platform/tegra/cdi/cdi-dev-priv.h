@@ -15,6 +15,21 @@
 #define __CDI_DEV_PRIV_H__
 
 #include <linux/cdev.h>
+#include <linux/list.h>
+#include <linux/workqueue.h>
+
+#define CDI_DEV_MAX_ASYNC_DEPTH		64
+#define CDI_DEV_MAX_ASYNC_BURST		256
+
+struct cdi_dev_async_wr {
+	struct list_head node;
+	unsigned int offset;
+	size_t size;
+	void (*complete)(void *priv, int err);
+	void *priv;
+	/* 2 lead bytes reserved for the register offset */
+	u8 buf[];
+};
 
 struct cdi_dev_info {
 	struct i2c_client *i2c_client;
@@ -31,12 +46,20 @@ struct cdi_dev_info {
 	u8 power_is_on;
 	u8 des_pwr_method;
 	u8 cam_pwr_method;
+	struct list_head wr_queue;
+	spinlock_t wr_lock;
+	struct work_struct wr_work;
+	u32 wr_queued;
 };
 
 int cdi_dev_raw_rd(struct cdi_dev_info *info, unsigned int offset,
 	unsigned int offset_len, u8 *val, size_t size);
 int cdi_dev_raw_wr(struct cdi_dev_info *info, unsigned int offset, u8 *val,
 	size_t size);
+int cdi_dev_wr_async(struct cdi_dev_info *info, unsigned int offset,
+	const u8 *val, size_t size,
+	void (*complete)(void *priv, int err), void *priv);
+void cdi_dev_wr_flush(struct cdi_dev_info *info);
 
 int cdi_dev_debugfs_init(struct cdi_dev_info *cdi_dev);
 int cdi_dev_debugfs_remove(struct cdi_dev_info *cdi_dev);
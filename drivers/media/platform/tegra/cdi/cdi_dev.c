@@ -311,6 +311,108 @@ int cdi_dev_raw_wr(
 	return ret;
 }
 
+static void cdi_dev_wr_worker(struct work_struct *work)
+{
+	struct cdi_dev_info *info =
+		container_of(work, struct cdi_dev_info, wr_work);
+	struct cdi_dev_async_wr *wr;
+	unsigned long flags;
+	int err;
+
+	spin_lock_irqsave(&info->wr_lock, flags);
+	while (!list_empty(&info->wr_queue)) {
+		wr = list_first_entry(&info->wr_queue,
+			struct cdi_dev_async_wr, node);
+		list_del(&wr->node);
+		info->wr_queued--;
+		spin_unlock_irqrestore(&info->wr_lock, flags);
+
+		err = cdi_dev_raw_wr(info, wr->offset, wr->buf, wr->size);
+		if (err)
+			dev_err(info->dev,
+				"%s: write @%x size %zu failed: %d\n",
+				__func__, wr->offset, wr->size, err);
+		if (wr->complete)
+			wr->complete(wr->priv, err);
+		kfree(wr);
+
+		spin_lock_irqsave(&info->wr_lock, flags);
+	}
+	spin_unlock_irqrestore(&info->wr_lock, flags);
+}
+
+/* post an i2c write to the device.
+   val    - buffer contains data to write, without the register offset.
+   size   - number of bytes to be written to device.
+   offset - address in the device's register space to start with.
+   complete - optional, called from the write worker with the transfer
+	result once the data is on the bus.
+   The write is queued and pushed to the bus from a worker thread, so
+   the caller never blocks on the i2c transfer. A write to the registers
+   immediately following a still queued write is merged into it, so a
+   sequence of posted updates goes out as one burst.
+*/
+int cdi_dev_wr_async(struct cdi_dev_info *info, unsigned int offset,
+	const u8 *val, size_t size,
+	void (*complete)(void *priv, int err), void *priv)
+{
+	struct cdi_dev_async_wr *wr, *last;
+	unsigned long flags;
+
+	if (size == 0 || size > CDI_DEV_MAX_ASYNC_BURST)
+		return -EINVAL;
+
+	wr = kzalloc(sizeof(*wr) + 2 + CDI_DEV_MAX_ASYNC_BURST, GFP_KERNEL);
+	if (wr == NULL) {
+		dev_err(info->dev, "%s: Unable to allocate memory!\n",
+			__func__);
+		return -ENOMEM;
+	}
+
+	wr->offset = offset;
+	wr->size = size;
+	wr->complete = complete;
+	wr->priv = priv;
+	memcpy(wr->buf + 2, val, size);
+
+	spin_lock_irqsave(&info->wr_lock, flags);
+	if (!list_empty(&info->wr_queue)) {
+		last = list_last_entry(&info->wr_queue,
+			struct cdi_dev_async_wr, node);
+		if (last->complete == NULL &&
+			offset == last->offset + last->size &&
+			last->size + size <= CDI_DEV_MAX_ASYNC_BURST) {
+			/* registers are consecutive, coalesce the bursts */
+			memcpy(last->buf + 2 + last->size, val, size);
+			last->size += size;
+			last->complete = complete;
+			last->priv = priv;
+			spin_unlock_irqrestore(&info->wr_lock, flags);
+			kfree(wr);
+			schedule_work(&info->wr_work);
+			return 0;
+		}
+	}
+	if (info->wr_queued >= CDI_DEV_MAX_ASYNC_DEPTH) {
+		spin_unlock_irqrestore(&info->wr_lock, flags);
+		dev_err(info->dev, "%s: queue is full\n", __func__);
+		kfree(wr);
+		return -EBUSY;
+	}
+	list_add_tail(&wr->node, &info->wr_queue);
+	info->wr_queued++;
+	spin_unlock_irqrestore(&info->wr_lock, flags);
+
+	schedule_work(&info->wr_work);
+	return 0;
+}
+
+/* wait until all posted writes are on the bus */
+void cdi_dev_wr_flush(struct cdi_dev_info *info)
+{
+	flush_work(&info->wr_work);
+}
+
 static int cdi_dev_raw_rw(struct cdi_dev_info *info)
 {
 	struct cdi_dev_package *pkg = &info->rw_pkg;
@@ -335,9 +437,28 @@ static int cdi_dev_raw_rw(struct cdi_dev_info *info)
 			kfree(buf);
 			return -EFAULT;
 		}
-		/* in the user access case, the offset is integrated in the
-		   buffer to be transferred, so pass -1 as the offset */
-		ret = cdi_dev_raw_wr(info, -1, buf, pkg->size);
+		if (pkg->flags & CDI_DEV_PKG_FLAG_ASYNC) {
+			unsigned int offset;
+
+			/* the offset leads the buffer; strip it so
+			   consecutive updates can be coalesced */
+			if (pkg->size <= info->reg_len) {
+				kfree(buf);
+				return -EINVAL;
+			}
+			if (info->reg_len == 2)
+				offset = (buf[0] << 8) | buf[1];
+			else
+				offset = buf[0];
+			ret = cdi_dev_wr_async(info, offset,
+				buf + info->reg_len,
+				pkg->size - info->reg_len, NULL, NULL);
+		} else {
+			/* in the user access case, the offset is integrated
+			   in the buffer to be transferred, so pass -1 as the
+			   offset */
+			ret = cdi_dev_raw_wr(info, -1, buf, pkg->size);
+		}
 	} else {
 		/* read from device */
 		ret = cdi_dev_raw_rd(info, pkg->offset,
@@ -497,6 +618,7 @@ static int cdi_dev_release(struct inode *inode, struct file *file)
 	struct cdi_dev_info *info = file->private_data;
 
 	dev_dbg(info->dev, "%s\n", __func__);
+	cdi_dev_wr_flush(info);
 	file->private_data = NULL;
 	WARN_ON(!atomic_xchg(&info->in_use, 0));
 	return 0;
@@ -532,6 +654,9 @@ static int cdi_dev_probe(struct i2c_client *client,
 	}
 
 	mutex_init(&info->mutex);
+	INIT_LIST_HEAD(&info->wr_queue);
+	spin_lock_init(&info->wr_lock);
+	INIT_WORK(&info->wr_work, cdi_dev_wr_worker);
 
 	if (client->dev.platform_data) {
 		info->pdata = client->dev.platform_data;
@@ -636,6 +761,7 @@ static int cdi_dev_remove(struct i2c_client *client)
 	struct device *pdev;
 
 	dev_dbg(&client->dev, "%s\n", __func__);
+	cdi_dev_wr_flush(info);
 	cdi_dev_debugfs_remove(info);
 
 	/* remove only cdi_dev_info not i2c_client itself */
@@ -656,6 +782,7 @@ static int cdi_dev_suspend(struct device *dev)
 	struct cdi_dev_info *cdi = (struct cdi_dev_info *)dev_get_drvdata(dev);
 
 	dev_info(dev, "Suspending\n");
+	cdi_dev_wr_flush(cdi);
 	mutex_lock(&cdi->mutex);
 	cdi->power_is_on = 0;
 	mutex_unlock(&cdi->mutex);
@@ -692,6 +819,7 @@ static struct i2c_driver cdi_dev_drv = {
 	.driver = {
 		.name = "cdi-dev",
 		.owner = THIS_MODULE,
+		.probe_type = PROBE_PREFER_ASYNCHRONOUS,
 		.pm = &cdi_dev_pm_ops,
 	},
 	.id_table = cdi_dev_id,
@@ -1978,6 +1978,7 @@ static struct platform_driver cdi_mgr_driver = {
 	.driver = {
 		.name = "cdi-mgr",
 		.owner = THIS_MODULE,
+		.probe_type = PROBE_PREFER_ASYNCHRONOUS,
 		.of_match_table = of_match_ptr(cdi_mgr_of_match),
 		.pm = &cdi_mgr_pm_ops,
 	},
@@ -15,6 +15,21 @@
 #define __ISC_DEV_PRIV_H__
 
 #include <linux/cdev.h>
+#include <linux/list.h>
+#include <linux/workqueue.h>
+
+#define ISC_DEV_MAX_ASYNC_DEPTH		64
+#define ISC_DEV_MAX_ASYNC_BURST		256
+
+struct isc_dev_async_wr {
+	struct list_head node;
+	unsigned int offset;
+	size_t size;
+	void (*complete)(void *priv, int err);
+	void *priv;
+	/* 2 lead bytes reserved for the register offset */
+	u8 buf[];
+};
 
 struct isc_dev_info {
 	struct i2c_client *i2c_client;
@@ -29,11 +44,18 @@ struct isc_dev_info {
 	u32 reg_off;
 	char devname[32];
 	u8 power_is_on;
+	struct list_head wr_queue;
+	spinlock_t wr_lock;
+	struct work_struct wr_work;
+	u32 wr_queued;
 };
 
 int isc_dev_raw_rd(struct isc_dev_info *, unsigned int,
 	unsigned int, u8 *, size_t);
 int isc_dev_raw_wr(struct isc_dev_info *, unsigned int, u8 *, size_t);
+int isc_dev_wr_async(struct isc_dev_info *, unsigned int,
+	const u8 *, size_t, void (*)(void *, int), void *);
+void isc_dev_wr_flush(struct isc_dev_info *);
 
 int isc_dev_debugfs_init(struct isc_dev_info *isc_dev);
 int isc_dev_debugfs_remove(struct isc_dev_info *isc_dev);
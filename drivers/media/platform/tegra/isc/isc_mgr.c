@@ -1220,6 +1220,7 @@ static struct platform_driver isc_mgr_driver = {
 	.driver = {
 		.name = "isc-mgr",
 		.owner = THIS_MODULE,
+		.probe_type = PROBE_PREFER_ASYNCHRONOUS,
 		.of_match_table = of_match_ptr(isc_mgr_of_match),
 		.pm = &isc_mgr_pm_ops,
 	},
@@ -28,6 +28,7 @@
 #include <linux/debugfs.h>
 #include <linux/clk/tegra.h>
 #include <linux/pm.h>
+#include <linux/thermal.h>
 #include <linux/miscdevice.h>
 #include <linux/fs.h>
 #include <linux/uaccess.h>
@@ -54,6 +55,9 @@
 
 #define DRV_NAME "tegra_mipi_cal"
 #define MIPI_CAL_TIMEOUT_MSEC 500
+/* reuse calibration results within this temperature band, in mC */
+#define MIPI_CAL_TEMP_BAND 10000
+#define MIPI_CAL_TEMP_INVAL INT_MIN
 
 struct tegra_mipi_bias {
 	/* BIAS_PAD_CFG0 */
@@ -106,6 +110,10 @@ struct tegra_mipi {
 	atomic_t fd_refcount;
 	atomic_t pad_refcount;
 	struct miscdevice misc_dev;
+	/* last successful calibration, protected by lock */
+	struct thermal_zone_device *tzd;
+	int cal_lanes;
+	int cal_temp;
 };
 
 static struct tegra_mipi *mipi;
@@ -309,6 +317,63 @@ static int tegra_mipi_wait(struct tegra_mipi *mipi, int lanes)
 
 }
 
+static int mipical_read_temp(struct tegra_mipi *mipi)
+{
+	int temp;
+
+	if (!mipi->tzd || thermal_zone_get_temp(mipi->tzd, &temp))
+		return MIPI_CAL_TEMP_INVAL;
+
+	return temp;
+}
+
+/* Calibration results stay loaded in the pad bricks until the partition
+ * is power gated, so a repeat request for the same lane configuration
+ * only needs a re-run when the temperature has drifted out of the band
+ * the results were measured in. Called with mipi->lock held.
+ */
+static bool mipical_cached_result_valid(struct tegra_mipi *mipi,
+					int lanes_info)
+{
+	int val, temp;
+	int lanes = lanes_info & ~CPHY_MASK;
+
+	if (mipi->cal_lanes != lanes_info)
+		return false;
+
+	/* quick verification: the done bits clear with the partition */
+	regmap_read(mipi->regmap, ADDR(CIL_MIPI_CAL_STATUS), &val);
+	if (((val & lanes) != lanes) || (val & CAL_ACTIVE))
+		return false;
+
+	temp = mipical_read_temp(mipi);
+	if (temp != MIPI_CAL_TEMP_INVAL &&
+		mipi->cal_temp != MIPI_CAL_TEMP_INVAL &&
+		abs(temp - mipi->cal_temp) > MIPI_CAL_TEMP_BAND)
+		return false;
+
+	return true;
+}
+
+/* Called with mipi->lock held */
+static void mipical_cache_result(struct tegra_mipi *mipi,
+				int lanes_info, int err)
+{
+	if (err) {
+		mipi->cal_lanes = 0;
+		return;
+	}
+	mipi->cal_lanes = lanes_info;
+	mipi->cal_temp = mipical_read_temp(mipi);
+}
+
+static void mipical_cache_invalidate(struct tegra_mipi *mipi)
+{
+	mutex_lock(&mipi->lock);
+	mipi->cal_lanes = 0;
+	mutex_unlock(&mipi->lock);
+}
+
 static int _t18x_tegra_mipi_bias_pad_enable(struct tegra_mipi *mipi)
 {
 	tegra_mipi_clk_enable(mipi);
@@ -349,8 +414,10 @@ int tegra_mipi_poweron(bool enable)
 
 	if (enable)
 		err = tegra_mipi_clk_enable(mipi);
-	else
+	else {
 		tegra_mipi_clk_disable(mipi);
+		mipical_cache_invalidate(mipi);
+	}
 
 	return err;
 }
@@ -405,8 +472,11 @@ int tegra_mipi_bias_pad_disable(void)
 				"mipical: unbalanced call to pad_disable\n");
 			return ret;
 		}
-		if (atomic_dec_return(&mipi->pad_refcount) == 0)
+		if (atomic_dec_return(&mipi->pad_refcount) == 0) {
 			ret = mipi->soc->pad_disable(mipi);
+			/* power gating the pads drops the loaded results */
+			mipical_cache_invalidate(mipi);
+		}
 	} else
 		ret = -EINVAL;
 
@@ -661,6 +731,13 @@ static int tegra_mipical_using_prod(struct tegra_mipi *mipi, int lanes_info)
 	lanes = lanes_info - is_cphy;
 	mutex_lock(&mipi->lock);
 
+	if (mipical_cached_result_valid(mipi, lanes_info)) {
+		dev_dbg(mipi->dev, "reuse calibration for lanes %x\n", lanes);
+		trace_mipical_result("cached_lanes", lanes);
+		mutex_unlock(&mipi->lock);
+		return 0;
+	}
+
 	/* clean up lanes */
 	clear_all(mipi);
 
@@ -715,6 +792,7 @@ static int tegra_mipical_using_prod(struct tegra_mipi *mipi, int lanes_info)
 		timeout_ct++;
 #endif
 prod_set_fail:
+	mipical_cache_result(mipi, lanes_info, err);
 	mutex_unlock(&mipi->lock);
 	return err;
 
@@ -798,6 +876,13 @@ static int t21x_tegra_mipical_using_prod(struct tegra_mipi *mipi, int lanes)
 
 	mutex_lock(&mipi->lock);
 
+	if (mipical_cached_result_valid(mipi, lanes)) {
+		dev_dbg(mipi->dev, "reuse calibration for lanes %x\n", lanes);
+		trace_mipical_result("cached_lanes", lanes);
+		mutex_unlock(&mipi->lock);
+		return 0;
+	}
+
 	/* clean up lanes */
 	clear_all(mipi);
 
@@ -815,6 +900,7 @@ static int t21x_tegra_mipical_using_prod(struct tegra_mipi *mipi, int lanes)
 	select_lanes(mipi, lanes);
 	/* Start calibration */
 	err = tegra_mipi_wait(mipi, lanes);
+	mipical_cache_result(mipi, lanes, err);
 
 #ifdef CONFIG_DEBUG_FS
 	regmap_read(mipi->regmap, ADDR(CIL_MIPI_CAL_STATUS), &mipical_status);
@@ -1176,6 +1262,14 @@ static int tegra_mipi_probe(struct platform_device *pdev)
 
 	mutex_init(&mipi->lock);
 
+	/* track the die temperature to spot drift; without a zone the
+	 * cached results only rely on the quick status verification
+	 */
+	mipi->tzd = thermal_zone_get_zone_by_name("CPU-therm");
+	if (IS_ERR(mipi->tzd))
+		mipi->tzd = NULL;
+	mipi->cal_temp = MIPI_CAL_TEMP_INVAL;
+
 	err = tegra_mipi_misc_register(mipi);
 	if (err)
 		return err;
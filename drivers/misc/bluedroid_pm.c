@@ -25,6 +25,7 @@
 #include <linux/pm_qos.h>
 #include <linux/delay.h>
 #include <linux/timer.h>
+#include <linux/ktime.h>
 #include <linux/of_gpio.h>
 #include <linux/version.h>
 
@@ -35,6 +36,16 @@
 
 #define TX_TIMER_INTERVAL 5
 
+/*
+ * Bounds for the adaptive idle hold-off window. The wake line is kept
+ * asserted for a multiple of the learned inter-event interval after the
+ * host signals idle, so back-to-back traffic (e.g. LE audio) does not
+ * toggle the wake path on every event.
+ */
+#define LPM_HOLD_MIN_US		10000
+#define LPM_HOLD_MAX_US		(TX_TIMER_INTERVAL * USEC_PER_SEC)
+#define LPM_HOLD_GAP_MULT	4
+
 /* Macro to enable or disable debug logging */
 /* #define BLUEDROID_PM_DBG */
 #ifndef BLUEDROID_PM_DBG
@@ -67,6 +78,15 @@ struct bluedroid_pm_data {
 	struct work_struct work;
 	spinlock_t lock;
 	struct device *dev;
+	/* adaptive LPM state and residency accounting */
+	ktime_t last_wake_ts;
+	ktime_t wake_assert_ts;
+	ktime_t wake_drop_ts;
+	u32 avg_gap_us;
+	u64 awake_ns;
+	u64 sleep_ns;
+	u64 wake_asserts;
+	u64 wake_coalesced;
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 9, 0)
 	struct timer_list bluedroid_pm_timer;
 #endif
@@ -151,6 +171,79 @@ static void bluedroid_pm_gpio_set_value(unsigned int gpio, int value)
 		gpiod_set_value(gpio_to_desc(gpio), value);
 }
 
+/**
+ * Asserts the chip wake line and takes the wake lock. Events arriving
+ * while the line is still held from the previous burst are counted as
+ * coalesced and cost no GPIO or wake lock traffic. Also updates the
+ * learned inter-event interval used to size the idle hold-off window.
+ * @param bluedroid_pm: bluedroid_pm structure.
+ */
+static void bluedroid_pm_wake_assert(struct bluedroid_pm_data *bluedroid_pm)
+{
+	ktime_t now = ktime_get();
+	u32 gap_us;
+
+	if (bluedroid_pm_gpio_get_value(bluedroid_pm->ext_wake)) {
+		/* still held from the previous burst */
+		bluedroid_pm->wake_coalesced++;
+	} else {
+		bluedroid_pm_gpio_set_value(bluedroid_pm->ext_wake, 1);
+		__pm_stay_awake(&bluedroid_pm->wake_lock);
+		bluedroid_pm->wake_asserts++;
+		if (ktime_to_ns(bluedroid_pm->wake_drop_ts))
+			bluedroid_pm->sleep_ns += ktime_to_ns(ktime_sub(now,
+						bluedroid_pm->wake_drop_ts));
+		bluedroid_pm->wake_assert_ts = now;
+	}
+
+	/* learn the inter-event interval with a 1/8 weighted average */
+	if (ktime_to_ns(bluedroid_pm->last_wake_ts)) {
+		gap_us = min_t(u64,
+			ktime_us_delta(now, bluedroid_pm->last_wake_ts),
+			LPM_HOLD_MAX_US);
+		if (bluedroid_pm->avg_gap_us)
+			bluedroid_pm->avg_gap_us +=
+				((int)gap_us -
+				 (int)bluedroid_pm->avg_gap_us) / 8;
+		else
+			bluedroid_pm->avg_gap_us = gap_us;
+	}
+	bluedroid_pm->last_wake_ts = now;
+}
+
+/**
+ * Drops the chip wake line and releases the wake lock, accumulating
+ * the awake residency.
+ * @param bluedroid_pm: bluedroid_pm structure.
+ */
+static void bluedroid_pm_wake_drop(struct bluedroid_pm_data *bluedroid_pm)
+{
+	ktime_t now = ktime_get();
+
+	bluedroid_pm_gpio_set_value(bluedroid_pm->ext_wake, 0);
+	__pm_relax(&bluedroid_pm->wake_lock);
+	if (ktime_to_ns(bluedroid_pm->wake_assert_ts))
+		bluedroid_pm->awake_ns += ktime_to_ns(ktime_sub(now,
+					bluedroid_pm->wake_assert_ts));
+	bluedroid_pm->wake_drop_ts = now;
+}
+
+/**
+ * Returns the idle hold-off in jiffies: a multiple of the learned
+ * inter-event interval, clamped so a quiet link still sleeps quickly
+ * and a noisy one never holds the wake longer than the legacy timer.
+ * @param bluedroid_pm: bluedroid_pm structure.
+ */
+static unsigned long bluedroid_pm_hold_jiffies(
+				struct bluedroid_pm_data *bluedroid_pm)
+{
+	u32 hold_us = clamp_t(u32,
+			LPM_HOLD_GAP_MULT * bluedroid_pm->avg_gap_us,
+			LPM_HOLD_MIN_US, LPM_HOLD_MAX_US);
+
+	return usecs_to_jiffies(hold_us);
+}
+
 /**
  * Handles bluedroid_pm busy timer expiration.
  * @param data: bluedroid_pm structure.
@@ -181,13 +274,13 @@ static void bluedroid_pm_timer_expire(struct timer_list *timer)
 	if (!bluedroid_pm_gpio_get_value(bluedroid_pm->host_wake)) {
 		/* BT can sleep */
 		BDP_DBG("Tx and Rx are idle, BT sleeping");
-		bluedroid_pm_gpio_set_value(bluedroid_pm->ext_wake, 0);
-		__pm_relax(&bluedroid_pm->wake_lock);
+		bluedroid_pm_wake_drop(bluedroid_pm);
 	} else {
 		/* BT Rx is busy, Reset Timer */
 		BDP_DBG("Rx is busy, restarting the timer");
 		mod_timer(&bluedroid_pm_timer,
-					jiffies + (TX_TIMER_INTERVAL * HZ));
+				jiffies + bluedroid_pm_hold_jiffies(
+					bluedroid_pm));
 	}
 }
 
@@ -571,12 +664,20 @@ static struct platform_driver bluedroid_pm_driver = {
 static ssize_t lpm_read_proc(struct file *file, char __user *buf, size_t size,
 					loff_t *ppos)
 {
-	char msg[50];
+	char msg[200];
 	struct bluedroid_pm_data *bluedroid_pm = PDE_DATA(file_inode(file));
 
-	sprintf(msg, "BT LPM Status: TX %x, RX %x\n",
+	sprintf(msg, "BT LPM Status: TX %x, RX %x\n"
+			"Wake asserts: %llu, coalesced: %llu\n"
+			"Awake: %llu ms, asleep: %llu ms\n"
+			"Avg event gap: %u us\n",
 			bluedroid_pm_gpio_get_value(bluedroid_pm->ext_wake),
-			bluedroid_pm_gpio_get_value(bluedroid_pm->host_wake));
+			bluedroid_pm_gpio_get_value(bluedroid_pm->host_wake),
+			bluedroid_pm->wake_asserts,
+			bluedroid_pm->wake_coalesced,
+			bluedroid_pm->awake_ns / NSEC_PER_MSEC,
+			bluedroid_pm->sleep_ns / NSEC_PER_MSEC,
+			bluedroid_pm->avg_gap_us);
 	return simple_read_from_buffer(buf, size, ppos, msg, strlen(msg));
 }
 
@@ -600,25 +701,21 @@ static ssize_t lpm_write_proc(struct file *file, const char __user *buffer,
 
 	if (!bluedroid_pm->is_blocked) {
 		if (buf[0] == '0') {
-			if (!bluedroid_pm_gpio_get_value(
-				bluedroid_pm->host_wake)) {
-				/* BT can sleep */
-				BDP_DBG("Tx and Rx are idle, BT sleeping");
-					bluedroid_pm_gpio_set_value(
-						bluedroid_pm->ext_wake, 0);
-					__pm_relax(&bluedroid_pm->wake_lock);
-				} else {
-					/* Reset Timer */
-					BDP_DBG("Rx is busy, restarting the timer");
-					mod_timer(&bluedroid_pm_timer,
-						jiffies + (TX_TIMER_INTERVAL * HZ));
-				}
+			/*
+			 * Do not drop the wake right away: hold it over
+			 * the learned inter-event window so the next
+			 * burst of a periodic stream finds it still
+			 * asserted. The timer re-checks Rx and drops
+			 * the wake once the link goes genuinely idle.
+			 */
+			BDP_DBG("Tx is idle, arming idle hold-off timer");
+			mod_timer(&bluedroid_pm_timer,
+				jiffies + bluedroid_pm_hold_jiffies(
+					bluedroid_pm));
 			clear_bit(BT_WAKE, &bluedroid_pm->flags);
 		} else if (buf[0] == '1') {
 			BDP_DBG("Tx is busy, wake_lock taken, delete timer");
-			bluedroid_pm_gpio_set_value(
-				bluedroid_pm->ext_wake, 1);
-			__pm_stay_awake(&bluedroid_pm->wake_lock);
+			bluedroid_pm_wake_assert(bluedroid_pm);
 			del_timer(&bluedroid_pm_timer);
 			set_bit(BT_WAKE, &bluedroid_pm->flags);
 		} else {
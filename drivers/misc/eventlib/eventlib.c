@@ -24,10 +24,13 @@
 #include <linux/mm.h>
 #include <linux/fs.h>
 #include <linux/crc32.h>
+#include <linux/rculist.h>
+#include <linux/smp.h>
 
 #include <linux/keventlib.h>
 
 #include "eventlib.h"
+#include "eventlib_init.h"
 
 #define KEVENTLIB_VER		"0.3"
 #define KEVENTLIB_VERSION	KEVENTLIB_VER "." \
@@ -62,6 +65,12 @@ struct eventlib_provider_info {
 
 	char *schema;
 	size_t schema_size;
+
+	/* One trace buffer shard per CPU; each shard has its own lock so
+	 * writers on different CPUs never contend with each other.
+	 */
+	uint32_t num_shards;
+	spinlock_t shard_locks[EVENTLIB_TBUFS_MAX];
 };
 
 static struct eventlib_module {
@@ -106,7 +115,9 @@ static int keventlib_init(struct eventlib_provider_info *info)
 	el_ctx->w2r_shm_size = (uint32_t)info->w2r_size;
 	el_ctx->r2w_shm = NULL;
 	el_ctx->r2w_shm_size = 0;
-	el_ctx->flags = 0;
+	el_ctx->flags = (info->num_shards > 1) ?
+		EVENTLIB_FLAG_SHARDED_BUFFERS : 0;
+	el_ctx->num_buffers = info->num_shards;
 
 	ret = eventlib_init(el_ctx);
 	if (ret)
@@ -255,9 +266,11 @@ static int get_free_id(void)
 static int
 provider_init(struct eventlib_provider_info *info,
 	      size_t size, const char *name,
-	      const char *schema, size_t schema_size)
+	      const char *schema, size_t schema_size,
+	      uint32_t num_shards)
 {
 	int ret = 0, id;
+	uint32_t i;
 
 	info->data = NULL;
 	info->data_size = 0;
@@ -268,6 +281,13 @@ provider_init(struct eventlib_provider_info *info,
 	if (size == 0 || !is_power_of_2(size))
 		return -EINVAL;
 
+	if (num_shards == 0 || num_shards > EVENTLIB_TBUFS_MAX)
+		return -EINVAL;
+
+	info->num_shards = num_shards;
+	for (i = 0; i < num_shards; i++)
+		spin_lock_init(&info->shard_locks[i]);
+
 	info->data = (void *)__get_free_pages(GFP_KERNEL, get_order(size));
 	if (!info->data)
 		return -ENOMEM;
@@ -309,7 +329,7 @@ provider_init(struct eventlib_provider_info *info,
 
 	info->id = id;
 
-	list_add_tail(&info->list, &ctx.providers);
+	list_add_tail_rcu(&info->list, &ctx.providers);
 	atomic_inc(&ctx.nr_providers);
 
 	spin_unlock(&ctx.lock);
@@ -339,7 +359,7 @@ find_provider_info(int id)
 {
 	struct eventlib_provider_info *info;
 
-	list_for_each_entry(info, &ctx.providers, list) {
+	list_for_each_entry_rcu(info, &ctx.providers, list) {
 		if (id == info->id)
 			return info;
 	}
@@ -355,6 +375,14 @@ __free_provider(struct work_struct *work)
 
 	struct eventlib_provider_info *info = wd->provider;
 
+	/* wait out writers still logging into the buffers */
+	synchronize_rcu();
+
+	eventlib_close(&info->el_ctx);
+
+	free_pages((unsigned long)info->data,
+		   get_order(info->data_size));
+
 	remove_sysfs_entry(info);
 
 	if (info->schema)
@@ -371,12 +399,7 @@ static void free_provider(struct eventlib_provider_info *info)
 {
 	struct eventlib_work_data *wd;
 
-	eventlib_close(&info->el_ctx);
-
-	free_pages((unsigned long)info->data,
-		   get_order(info->data_size));
-
-	list_del(&info->list);
+	list_del_rcu(&info->list);
 
 	wd = kmalloc(sizeof(*wd), GFP_ATOMIC);
 	if (!wd)
@@ -400,11 +423,13 @@ static void unregister_all_providers(void)
 int keventlib_write(int id, void *data, size_t size, uint32_t type, uint64_t ts)
 {
 	int err = 0;
+	uint32_t idx = 0;
+	unsigned long flags;
 	struct eventlib_provider_info *info;
 
 	pr_debug("%s: size: %#zx\n", __func__, size);
 
-	spin_lock(&ctx.lock);
+	rcu_read_lock();
 
 	info = find_provider_info(id);
 	if (!info) {
@@ -417,16 +442,26 @@ int keventlib_write(int id, void *data, size_t size, uint32_t type, uint64_t ts)
 		goto err_out;
 	}
 
-	eventlib_write(&info->el_ctx, 0, type, ts, data, size);
+	/* Writers on a sharded provider go to their own CPU's buffer, so
+	 * the shard lock is normally uncontended; it only serializes
+	 * against interrupts and migrated writers on the same shard.
+	 */
+	if (info->num_shards > 1)
+		idx = (uint32_t)raw_smp_processor_id() % info->num_shards;
+
+	spin_lock_irqsave(&info->shard_locks[idx], flags);
+	eventlib_write(&info->el_ctx, idx, type, ts, data, size);
+	spin_unlock_irqrestore(&info->shard_locks[idx], flags);
 
 err_out:
-	spin_unlock(&ctx.lock);
+	rcu_read_unlock();
 	return err;
 }
 EXPORT_SYMBOL(keventlib_write);
 
-int keventlib_register(size_t size, const char *name,
-		       const char *schema, size_t schema_size)
+static int keventlib_register_common(size_t size, const char *name,
+				     const char *schema, size_t schema_size,
+				     uint32_t num_shards)
 {
 	int ret;
 	struct eventlib_provider_info *info;
@@ -440,7 +475,8 @@ int keventlib_register(size_t size, const char *name,
 	if (!info)
 		return -ENOMEM;
 
-	ret = provider_init(info, size, name, schema, schema_size);
+	ret = provider_init(info, size, name, schema, schema_size,
+			    num_shards);
 	if (ret < 0) {
 		kfree(info);
 		return ret;
@@ -448,8 +484,25 @@ int keventlib_register(size_t size, const char *name,
 
 	return info->id;
 }
+
+int keventlib_register(size_t size, const char *name,
+		       const char *schema, size_t schema_size)
+{
+	return keventlib_register_common(size, name, schema, schema_size, 1);
+}
 EXPORT_SYMBOL(keventlib_register);
 
+int keventlib_register_sharded(size_t size, const char *name,
+			       const char *schema, size_t schema_size)
+{
+	uint32_t num_shards = min_t(uint32_t, num_possible_cpus(),
+				    EVENTLIB_TBUFS_MAX);
+
+	return keventlib_register_common(size, name, schema, schema_size,
+					 num_shards);
+}
+EXPORT_SYMBOL(keventlib_register_sharded);
+
 void keventlib_unregister(int id)
 {
 	struct eventlib_provider_info *info;
@@ -461,7 +514,9 @@ void keventlib_unregister(int id)
 
 	spin_lock(&ctx.lock);
 
+	rcu_read_lock();
 	info = find_provider_info(id);
+	rcu_read_unlock();
 	if (!info) {
 		pr_err("Unregistered provider: %d\n", id);
 		spin_unlock(&ctx.lock);
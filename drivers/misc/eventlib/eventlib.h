@@ -30,6 +30,14 @@
 /* Possible init flags */
 #define EVENTLIB_FLAG_INIT_FILTERING (1 << 0)
 
+/* Writer only: treat the trace buffers as writer shards. All shards draw
+ * sequence ids from one shared counter, so different buffer indices can be
+ * written concurrently without locking (each index must still have a single
+ * producer at a time). eventlib_read() merges the shards back into one
+ * sequence-ordered stream.
+ */
+#define EVENTLIB_FLAG_SHARDED_BUFFERS (1 << 1)
+
 /* These are used to ensure binary compatibility between library and caller
  * If eventlib_ctx is ever changed in incompatible way, EVENTLIB_CTX_VERSION
  * must be increased.
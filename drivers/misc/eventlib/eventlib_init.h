@@ -95,6 +95,14 @@ struct eventlib_init {
 
 	struct eventlib_tbuf_ctx tbuf[EVENTLIB_TBUFS_MAX];
 	struct eventlib_flt_ctx flt;
+
+	/* Reader: nonzero if the writer shards events across the trace
+	 * buffers with a shared sequence id space; see tbuf compat word.
+	 */
+	uint32_t tbuf_sharded;
+
+	/* Reader: largest sequence id delivered from the merged stream */
+	uint64_t tbuf_sharded_ack;
 };
 
 _Static_assert(sizeof(struct eventlib_init) <=
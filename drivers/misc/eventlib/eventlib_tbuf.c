@@ -36,10 +36,17 @@
 #define SEQUENCE_ID_MAX (~0ULL)
 
 /* Bit 0 of compat word shows if writer has initialized filtering.
- * Other bits in compat word must be zero in this version
+ * Bit 1 shows if writer shards events across the trace buffers with a
+ * shared sequence id space, which the reader must merge back in
+ * sequence order. Other bits in compat word must be zero in this
+ * version.
  */
-#define TBUF_COMPAT(ctx) ((ctx->flags & EVENTLIB_FLAG_INIT_FILTERING) ? 1 : 0)
-#define TBUF_CHECK_COMPAT(compat) (((compat) & ~1u) == 0)
+#define TBUF_COMPAT_SHARDED 2u
+#define TBUF_COMPAT(ctx) \
+	((((ctx)->flags & EVENTLIB_FLAG_INIT_FILTERING) ? 1u : 0u) | \
+	(((ctx)->flags & EVENTLIB_FLAG_SHARDED_BUFFERS) ? \
+		TBUF_COMPAT_SHARDED : 0u))
+#define TBUF_CHECK_COMPAT(compat) (((compat) & ~3u) == 0)
 
 static int tbuf_writer_init(struct eventlib_ctx *ctx)
 {
@@ -106,6 +113,10 @@ static int tbuf_reader_init(struct eventlib_ctx *ctx)
 		if (!TBUF_CHECK_COMPAT(w2r->compat))
 			return -EPROTONOSUPPORT;
 
+		if (idx == 0)
+			ctx->priv->tbuf_sharded =
+				w2r->compat & TBUF_COMPAT_SHARDED;
+
 		ret = tracebuf_bind(&ctx->priv->tbuf[idx].tbuf_ctx,
 			&w2r->tbuf,
 			size - (uint32_t)sizeof(struct eventlib_tbuf_w2r));
@@ -150,7 +161,14 @@ void eventlib_write(struct eventlib_ctx *ctx, uint32_t idx,
 	hdr.params = ts;
 	hdr.reserved = type;
 
-	tracebuf_push(&ctx->priv->tbuf[idx].tbuf_ctx, &hdr, data, size);
+	if (ctx->flags & EVENTLIB_FLAG_SHARDED_BUFFERS)
+		/* all shards order themselves against buffer 0's counter */
+		tracebuf_push_seq(&ctx->priv->tbuf[idx].tbuf_ctx, &hdr,
+			data, size,
+			tracebuf_next_seqid(&ctx->priv->tbuf[0].tbuf_ctx));
+	else
+		tracebuf_push(&ctx->priv->tbuf[idx].tbuf_ctx, &hdr,
+			data, size);
 }
 
 static int tbuf_pull_single(struct eventlib_tbuf_ctx *tbuf,
@@ -291,6 +309,157 @@ static int eventlib_read_from_tbuf(struct eventlib_tbuf_ctx *tbuf, void *buffer,
 	return 0;
 }
 
+struct tbuf_merge_state {
+	struct pullstate state;
+	uint64_t seqid;
+	uint64_t min;
+	uint64_t max;
+	bool peeked;
+	bool done;
+};
+
+/* Look at the next record of one shard without consuming it: pull on a
+ * throwaway copy of the position with a zero-length payload, which copies
+ * only the header.
+ */
+static int tbuf_merge_peek(struct eventlib_tbuf_ctx *tbuf,
+	struct tbuf_merge_state *ms)
+{
+	struct pullstate state;
+	struct record rec;
+	uint32_t length = 0;
+	uint64_t seqid = 0ULL;
+	int ret;
+
+	if (ms->done || ms->peeked)
+		return 0;
+
+	state = ms->state;
+	ret = tbuf_pull_single(tbuf, &state, &seqid, &rec, NULL, &length);
+
+	if (ret == -ENOBUFS) {
+		ms->done = true;
+		return 0;
+	}
+
+	if (ret != 0)
+		return ret;
+
+	/* Duplicate: this and all older records were already delivered */
+	if (seqid <= tbuf->seqid_ack) {
+		ms->done = true;
+		return 0;
+	}
+
+	ms->seqid = seqid;
+	ms->peeked = true;
+
+	return 0;
+}
+
+/* Merge the writer shards into one stream ordered by sequence id. Each
+ * shard delivers newest first, so at every step the shard whose next
+ * record has the largest sequence id carries the globally newest event.
+ */
+static int eventlib_read_sharded(struct eventlib_ctx *ctx, void *buffer,
+	uint32_t *size, uint64_t *lost)
+{
+	struct tbuf_merge_state merge[EVENTLIB_TBUFS_MAX];
+	uint32_t nbufs = ctx->priv->w2r_copy.num_buffers;
+	struct eventlib_tbuf_ctx *tbuf;
+	uint64_t gmin = SEQUENCE_ID_MAX;
+	uint64_t gmax = SEQUENCE_ID_MIN;
+	uint64_t seqid = 0ULL;
+	uintptr_t current;
+	uint32_t length;
+	uint32_t avail;
+	unsigned int idx;
+	int best;
+	int ret;
+
+	for (idx = 0; idx < nbufs; idx++) {
+		pull_init(&ctx->priv->tbuf[idx].tbuf_ctx, &merge[idx].state);
+		merge[idx].min = SEQUENCE_ID_MAX;
+		merge[idx].max = SEQUENCE_ID_MIN;
+		merge[idx].peeked = false;
+		merge[idx].done = false;
+	}
+
+	current = (uintptr_t)buffer;
+	avail = *size;
+
+	while (avail >= sizeof(struct record)) {
+		best = -1;
+
+		for (idx = 0; idx < nbufs; idx++) {
+			ret = tbuf_merge_peek(&ctx->priv->tbuf[idx],
+				&merge[idx]);
+			if (ret != 0)
+				return ret;
+
+			if (merge[idx].done)
+				continue;
+
+			if (best < 0 || merge[idx].seqid > merge[best].seqid)
+				best = (int)idx;
+		}
+
+		if (best < 0)
+			break;
+
+		tbuf = &ctx->priv->tbuf[best];
+		length = avail - (uint32_t)sizeof(struct record);
+
+		ret = tbuf_pull_single(tbuf, &merge[best].state, &seqid,
+			(struct record *)current,
+			(void *)(current + sizeof(struct record)),
+			&length);
+		if (ret != 0)
+			return ret;
+
+		merge[best].peeked = false;
+
+		if (seqid > merge[best].max)
+			merge[best].max = seqid;
+
+		if (seqid < merge[best].min)
+			merge[best].min = seqid;
+
+		if (seqid > gmax)
+			gmax = seqid;
+
+		if (seqid < gmin)
+			gmin = seqid;
+
+		if (avail < (uint32_t)sizeof(struct record) + length)
+			return -EIO;
+
+		avail -= (uint32_t)sizeof(struct record) + length;
+		current += (uint32_t)sizeof(struct record) + length;
+	}
+
+	for (idx = 0; idx < nbufs; idx++) {
+		if (merge[idx].max == SEQUENCE_ID_MIN)
+			continue;
+
+		ctx->priv->tbuf[idx].seqid_ack = merge[idx].max;
+	}
+
+	/* Sequence ids are global across shards here, so gaps are only
+	 * meaningful against the merged stream, not per shard.
+	 */
+	if (gmax != SEQUENCE_ID_MIN) {
+		if (lost && gmin > ctx->priv->tbuf_sharded_ack + 1)
+			*lost += gmin - ctx->priv->tbuf_sharded_ack - 1;
+
+		ctx->priv->tbuf_sharded_ack = gmax;
+	}
+
+	*size = *size - avail;
+
+	return 0;
+}
+
 int eventlib_read(struct eventlib_ctx *ctx, void *buffer, uint32_t *size,
 	uint64_t *lost)
 {
@@ -310,6 +479,27 @@ int eventlib_read(struct eventlib_ctx *ctx, void *buffer, uint32_t *size,
 	if (ctx->direction != EVENTLIB_DIRECTION_READER)
 		return -EPROTO;
 
+	if (ctx->priv->tbuf_sharded) {
+		for (idx = 0; idx < INIT_COUNT_MAX; idx++) {
+			copy_size = *size;
+			accum_lost = 0;
+
+			ret = eventlib_read_sharded(ctx, buffer, &copy_size,
+				lost ? &accum_lost : NULL);
+			if (ret != -EINTR)
+				break;
+		}
+
+		if (ret != 0)
+			return ret;
+
+		*size = copy_size;
+		if (lost)
+			*lost = accum_lost;
+
+		return 0;
+	}
+
 	for (idx = 0; idx < ctx->priv->w2r_copy.num_buffers; idx++) {
 		accum_lost = 0;
 		copy_size = accum_empty;
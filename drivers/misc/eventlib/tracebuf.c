@@ -152,6 +152,18 @@ int tracebuf_bind(struct tracectx *ctx, void *buffer, uint32_t length)
 
 void tracebuf_push(struct tracectx *ctx, struct tracehdr *hdr,
 	void *payload, uint32_t paylen)
+{
+	tracebuf_push_seq(ctx, hdr, payload, paylen,
+		increment64(&ctx->shared->seqid));
+}
+
+uint64_t tracebuf_next_seqid(struct tracectx *ctx)
+{
+	return __sync_fetch_and_add(&ctx->shared->seqid, 1ULL);
+}
+
+void tracebuf_push_seq(struct tracectx *ctx, struct tracehdr *hdr,
+	void *payload, uint32_t paylen, uint64_t seqid)
 {
 	uint32_t padding;
 	uint64_t position;
@@ -159,7 +171,7 @@ void tracebuf_push(struct tracectx *ctx, struct tracehdr *hdr,
 	uintptr_t addr;
 	bool wrapped = false;
 
-	hdr->seqid = increment64(&ctx->shared->seqid);
+	hdr->seqid = seqid;
 	hdr->length = (uint32_t)paylen;
 
 	if (paylen > ctx->maxsize)
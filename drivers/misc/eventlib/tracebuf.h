@@ -122,6 +122,34 @@ int tracebuf_bind(struct tracectx *ctx, void *buffer, uint32_t length);
 void tracebuf_push(struct tracectx *ctx, struct tracehdr *hdr,
 	void *payload, uint32_t paylen);
 
+/*
+ * Description for tracebuf_push_seq()
+ *   - Same as tracebuf_push(), except that the sequence id is provided
+ *     by the caller instead of being drawn from the buffer's own counter.
+ *   - Used when several buffers share one sequence id space, see
+ *     tracebuf_next_seqid().
+ * Parameters
+ *   - Same as tracebuf_push(), plus `seqid` provided by the caller.
+ * Return values
+ *   - Operation never fails.
+ */
+
+void tracebuf_push_seq(struct tracectx *ctx, struct tracehdr *hdr,
+	void *payload, uint32_t paylen, uint64_t seqid);
+
+/*
+ * Description for tracebuf_next_seqid()
+ *   - Fetch the next sequence id from the buffer's shared counter with
+ *     an atomic increment, so that concurrent producers pushing into
+ *     different buffers can share this buffer's counter.
+ * Parameters
+ *   - Param `ctx` is provided by the caller.
+ * Return values
+ *   - Operation never fails.
+ */
+
+uint64_t tracebuf_next_seqid(struct tracectx *ctx);
+
 /*
  * Description for tracebuf_pull()
  *   - Attempt to get a message from the buffer; may fail for many
@@ -90,6 +90,19 @@ struct irq_q_info {
 	u32		  tail;
 };
 
+/* donated buffer tracking
+ *
+ * A donation pins no extra memory; it only caches the addresses and a
+ * kernel mapping of an existing allocation so per-iteration test loops
+ * can reference the buffer by index without re-resolving the handle.
+ */
+struct MODS_DONATED_BUFFER {
+	struct MODS_MEM_INFO *p_mem_info; /* NULL when the slot is free */
+	void                 *kernel_vaddr; /* cached vmap of all pages */
+	u64                   dma_addr;   /* DMA addr of the first chunk */
+	u64                   size;       /* total size, in bytes */
+};
+
 /* The driver can be opened simultaneously multiple times, from the same or from
  * different processes.  This structure tracks data specific to each open fd.
  */
@@ -112,6 +125,7 @@ struct mods_client {
 	struct pci_dev          *cached_dev;
 #endif
 	struct mutex             mtx;
+	struct MODS_DONATED_BUFFER donated_bufs[MODS_MAX_DONATED_BUFFERS];
 	int                      mods_fb_suspended[FB_MAX];
 	u32                      access_token;
 	atomic_t                 num_allocs;
@@ -484,6 +498,12 @@ int esc_mods_iommu_dma_map_memory(struct mods_client               *client,
 				  struct MODS_IOMMU_DMA_MAP_MEMORY *p);
 int esc_mods_iommu_dma_unmap_memory(struct mods_client               *client,
 				    struct MODS_IOMMU_DMA_MAP_MEMORY *p);
+int esc_mods_donate_buffer(struct mods_client        *client,
+			   struct MODS_DONATE_BUFFER *p);
+int esc_mods_get_donated_buffer(struct mods_client             *client,
+				struct MODS_GET_DONATED_BUFFER *p);
+int esc_mods_release_donated_buffer(struct mods_client                 *client,
+				    struct MODS_RELEASE_DONATED_BUFFER *p);
 
 #ifdef CONFIG_ARM
 int esc_mods_memory_barrier(struct mods_client *client);
@@ -20,6 +20,7 @@
 
 #include "mods_internal.h"
 
+#include <linux/delay.h>
 #include <linux/fs.h>
 #include <linux/init.h>
 #include <linux/miscdevice.h>
@@ -1801,6 +1802,112 @@ static int esc_mods_get_driver_stats(struct mods_client *client,
 	return 0;
 }
 
+static int exec_reg_op(struct mods_client *client,
+		       void       __iomem *ptr,
+		       struct MODS_REG_OP *op)
+{
+	u32 val;
+
+	switch (op->op) {
+	case MODS_REG_OP_READ:
+		op->read_value = readl(ptr);
+		break;
+
+	case MODS_REG_OP_WRITE:
+		writel(op->value, ptr);
+		break;
+
+	case MODS_REG_OP_RMW:
+		val = readl(ptr);
+		op->read_value = val;
+		writel((val & ~op->mask) | (op->value & op->mask), ptr);
+		break;
+
+	case MODS_REG_OP_POLL: {
+		const u64 end = get_jiffies_64() +
+				msecs_to_jiffies(op->timeout_ms);
+
+		for (;;) {
+			val = readl(ptr);
+			if ((val & op->mask) == op->value)
+				break;
+			if (time_after64(get_jiffies_64(), end)) {
+				op->read_value = val;
+				return -ETIMEDOUT;
+			}
+			usleep_range(10, 20);
+		}
+		op->read_value = val;
+		break;
+	}
+
+	default:
+		cl_error("invalid register op %u\n", (unsigned int)op->op);
+		return -EINVAL;
+	}
+
+	return OK;
+}
+
+static int esc_mods_reg_transaction(struct mods_client *client,
+				    struct MODS_REG_TRANSACTION *p)
+{
+	void __iomem *ptr       = NULL;
+	u64           mapped_pa = ~0ULL;
+	u32           i;
+
+	LOG_ENT();
+
+	if (p->num_ops > MODS_MAX_REG_OPS) {
+		cl_error("invalid number of register ops %u, max allowed is %u\n",
+			 p->num_ops, MODS_MAX_REG_OPS);
+		LOG_EXT();
+		return -EINVAL;
+	}
+
+	p->num_completed = 0;
+	p->status        = OK;
+
+	for (i = 0; i < p->num_ops; i++) {
+		struct MODS_REG_OP *op   = &p->ops[i];
+		const u64           pa   = op->address & PAGE_MASK;
+		const u32           offs = op->address & ~PAGE_MASK;
+
+		if (op->address & 3) {
+			cl_error("unaligned register address 0x%llx at index %u\n",
+				 (unsigned long long)op->address, i);
+			p->status = -EINVAL;
+			break;
+		}
+
+		/* reuse the mapping while ops stay within one page */
+		if (!ptr || pa != mapped_pa) {
+			if (ptr)
+				iounmap(ptr);
+			ptr = ioremap(pa, PAGE_SIZE);
+			if (!ptr) {
+				cl_error("failed to map register address 0x%llx\n",
+					 (unsigned long long)op->address);
+				p->status = -ENOMEM;
+				break;
+			}
+			mapped_pa = pa;
+		}
+
+		p->status = exec_reg_op(client, ptr + offs, op);
+		if (p->status != OK)
+			break;
+
+		++p->num_completed;
+	}
+
+	if (ptr)
+		iounmap(ptr);
+
+	LOG_EXT();
+	return OK;
+}
+
 /**************
  * IO control *
  **************/
@@ -2076,6 +2183,23 @@ static long mods_krnl_ioctl(struct file  *fp,
 			   esc_mods_merge_pages, MODS_MERGE_PAGES);
 		break;
 
+	case MODS_ESC_DONATE_BUFFER:
+		MODS_IOCTL(MODS_ESC_DONATE_BUFFER,
+			   esc_mods_donate_buffer, MODS_DONATE_BUFFER);
+		break;
+
+	case MODS_ESC_GET_DONATED_BUFFER:
+		MODS_IOCTL(MODS_ESC_GET_DONATED_BUFFER,
+			   esc_mods_get_donated_buffer,
+			   MODS_GET_DONATED_BUFFER);
+		break;
+
+	case MODS_ESC_RELEASE_DONATED_BUFFER:
+		MODS_IOCTL_NORETVAL(MODS_ESC_RELEASE_DONATED_BUFFER,
+				    esc_mods_release_donated_buffer,
+				    MODS_RELEASE_DONATED_BUFFER);
+		break;
+
 	case MODS_ESC_GET_PHYSICAL_ADDRESS:
 		MODS_IOCTL(MODS_ESC_GET_PHYSICAL_ADDRESS,
 			   esc_mods_get_phys_addr,
@@ -2653,6 +2777,11 @@ static long mods_krnl_ioctl(struct file  *fp,
 			   esc_mods_get_driver_stats, MODS_GET_DRIVER_STATS);
 		break;
 
+	case MODS_ESC_REG_TRANSACTION:
+		MODS_IOCTL(MODS_ESC_REG_TRANSACTION,
+			   esc_mods_reg_transaction, MODS_REG_TRANSACTION);
+		break;
+
 	default:
 		cl_error(
 			"unrecognized ioctl 0x%x, dir %u, type 0x%x, nr %u, size 0x%x\n",
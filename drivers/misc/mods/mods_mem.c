@@ -21,6 +21,7 @@
 #include "mods_internal.h"
 
 #include <linux/pagemap.h>
+#include <linux/vmalloc.h>
 
 #if defined(MODS_HAS_SET_DMA_MASK)
 #include <linux/dma-mapping.h>
@@ -846,6 +847,27 @@ static int validate_mem_handle(struct mods_client   *client,
 	return false;
 }
 
+/* Drop any donation of this allocation.  Invoke with client->mtx held. */
+static void mods_release_donations(struct mods_client   *client,
+				   struct MODS_MEM_INFO *p_mem_info)
+{
+	u32 i;
+
+	for (i = 0; i < MODS_MAX_DONATED_BUFFERS; i++) {
+		struct MODS_DONATED_BUFFER *dbuf = &client->donated_bufs[i];
+
+		if (dbuf->p_mem_info != p_mem_info)
+			continue;
+
+		cl_debug(DEBUG_MEM_DETAILED,
+			 "release donated buffer %u on free of %p\n",
+			 i, p_mem_info);
+
+		vunmap(dbuf->kernel_vaddr);
+		memset(dbuf, 0, sizeof(*dbuf));
+	}
+}
+
 static int mods_unregister_and_free(struct mods_client   *client,
 				    struct MODS_MEM_INFO *p_del_mem)
 {
@@ -865,6 +887,8 @@ static int mods_unregister_and_free(struct mods_client   *client,
 		if (p_del_mem == p_mem_info) {
 			list_del(iter);
 
+			mods_release_donations(client, p_mem_info);
+
 			mutex_unlock(&client->mtx);
 
 			dma_unmap_all(client, p_mem_info, NULL);
@@ -1615,6 +1639,181 @@ failed:
 	return err;
 }
 
+int esc_mods_donate_buffer(struct mods_client        *client,
+			   struct MODS_DONATE_BUFFER *p)
+{
+	struct MODS_MEM_INFO       *p_mem_info;
+	struct MODS_DONATED_BUFFER *dbuf = NULL;
+	struct page               **pages;
+	pgprot_t                    prot = PAGE_KERNEL;
+	void                       *vaddr;
+	u32                         num_pages = 0;
+	u32                         i;
+	int                         err;
+
+	LOG_ENT();
+
+	p_mem_info = (struct MODS_MEM_INFO *)(size_t)p->memory_handle;
+
+	err = mutex_lock_interruptible(&client->mtx);
+	if (unlikely(err)) {
+		LOG_EXT();
+		return err;
+	}
+
+	if (!validate_mem_handle(client, p_mem_info)) {
+		cl_error("invalid handle %p\n", p_mem_info);
+		err = -EINVAL;
+		goto failed;
+	}
+
+	for (i = 0; i < MODS_MAX_DONATED_BUFFERS; i++) {
+		if (client->donated_bufs[i].p_mem_info == p_mem_info) {
+			cl_error("handle %p already donated at index %u\n",
+				 p_mem_info, i);
+			err = -EEXIST;
+			goto failed;
+		}
+		if (!dbuf && !client->donated_bufs[i].p_mem_info)
+			dbuf = &client->donated_bufs[i];
+	}
+
+	if (unlikely(!dbuf)) {
+		cl_error("all %u donation slots are in use\n",
+			 (unsigned int)MODS_MAX_DONATED_BUFFERS);
+		err = -ENOSPC;
+		goto failed;
+	}
+
+	/* Expand the chunk orders into a flat page array for vmap */
+	for (i = 0; i < p_mem_info->num_chunks; i++)
+		num_pages += 1U << p_mem_info->pages[i].order;
+
+	pages = kmalloc_array(num_pages, sizeof(*pages),
+			      GFP_KERNEL | __GFP_NORETRY);
+	if (unlikely(!pages)) {
+		err = -ENOMEM;
+		goto failed;
+	}
+
+	num_pages = 0;
+	for (i = 0; i < p_mem_info->num_chunks; i++) {
+		struct MODS_PHYS_CHUNK *chunk = &p_mem_info->pages[i];
+		u32                     j;
+
+		for (j = 0; j < (1U << chunk->order); j++)
+			pages[num_pages++] = chunk->p_page + j;
+	}
+
+	if (p_mem_info->pages[0].wc)
+		prot = pgprot_writecombine(prot);
+
+	vaddr = vmap(pages, num_pages, VM_MAP, prot);
+	kfree(pages);
+	if (unlikely(!vaddr)) {
+		cl_error("failed to map %u pages of handle %p\n",
+			 num_pages, p_mem_info);
+		err = -ENOMEM;
+		goto failed;
+	}
+
+	dbuf->p_mem_info   = p_mem_info;
+	dbuf->kernel_vaddr = vaddr;
+	dbuf->dma_addr     = p_mem_info->pages[0].mapped ?
+			     p_mem_info->pages[0].dev_addr :
+			     p_mem_info->pages[0].dma_addr;
+	dbuf->size         = (u64)p_mem_info->num_pages << PAGE_SHIFT;
+
+	p->index = (u32)(dbuf - client->donated_bufs);
+
+	cl_debug(DEBUG_MEM,
+		 "donated handle %p at index %u\n",
+		 p_mem_info, p->index);
+
+failed:
+	mutex_unlock(&client->mtx);
+
+	LOG_EXT();
+	return err;
+}
+
+int esc_mods_get_donated_buffer(struct mods_client             *client,
+				struct MODS_GET_DONATED_BUFFER *p)
+{
+	struct MODS_DONATED_BUFFER *dbuf;
+	int                         err;
+
+	LOG_ENT();
+
+	if (unlikely(p->index >= MODS_MAX_DONATED_BUFFERS)) {
+		cl_error("invalid donated buffer index %u\n", p->index);
+		LOG_EXT();
+		return -EINVAL;
+	}
+
+	err = mutex_lock_interruptible(&client->mtx);
+	if (unlikely(err)) {
+		LOG_EXT();
+		return err;
+	}
+
+	dbuf = &client->donated_bufs[p->index];
+
+	if (unlikely(!dbuf->p_mem_info)) {
+		cl_error("donated buffer index %u is not in use\n", p->index);
+		err = -EINVAL;
+		goto failed;
+	}
+
+	p->dma_addr         = dbuf->dma_addr;
+	p->physical_address = dbuf->p_mem_info->pages[0].dma_addr;
+	p->size             = dbuf->size;
+
+failed:
+	mutex_unlock(&client->mtx);
+
+	LOG_EXT();
+	return err;
+}
+
+int esc_mods_release_donated_buffer(struct mods_client                 *client,
+				    struct MODS_RELEASE_DONATED_BUFFER *p)
+{
+	struct MODS_DONATED_BUFFER *dbuf;
+	int                         err;
+
+	LOG_ENT();
+
+	if (unlikely(p->index >= MODS_MAX_DONATED_BUFFERS)) {
+		cl_error("invalid donated buffer index %u\n", p->index);
+		LOG_EXT();
+		return -EINVAL;
+	}
+
+	err = mutex_lock_interruptible(&client->mtx);
+	if (unlikely(err)) {
+		LOG_EXT();
+		return err;
+	}
+
+	dbuf = &client->donated_bufs[p->index];
+
+	if (unlikely(!dbuf->p_mem_info)) {
+		cl_error("donated buffer index %u is not in use\n", p->index);
+		err = -EINVAL;
+		goto failed;
+	}
+
+	vunmap(dbuf->kernel_vaddr);
+	memset(dbuf, 0, sizeof(*dbuf));
+
+failed:
+	mutex_unlock(&client->mtx);
+
+	LOG_EXT();
+	return err;
+}
+
 int esc_mods_set_mem_type(struct mods_client      *client,
 			  struct MODS_MEMORY_TYPE *p)
 {
@@ -80,6 +80,7 @@
 #include <linux/iio/buffer.h>
 #include <linux/iio/kfifo_buf.h>
 #include <linux/iio/trigger.h>
+#include <linux/math64.h>
 #include <linux/nvs.h>
 #include <linux/version.h>
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 14, 0)
@@ -735,6 +736,43 @@ static int nvs_handler(void *handle, void *buffer, s64 ts)
 	return ret;
 }
 
+static int nvs_handler_batch(void *handle, void *buffer, unsigned int n,
+			     s64 ts_first, s64 ts_last)
+{
+	struct iio_dev *indio_dev = (struct iio_dev *)handle;
+	unsigned char *buf = buffer;
+	s64 ts_period = 0;
+	s64 ts;
+	unsigned int src_i = 0;
+	unsigned int i;
+	int ret;
+
+	if (!indio_dev)
+		return 0;
+
+	if (!buf || !n)
+		/* flush or timestamp-only event */
+		return nvs_buf_push(indio_dev, buf, ts_last);
+
+	if (n > 1)
+		ts_period = div_s64(ts_last - ts_first, n - 1);
+	for (i = 0; i < n; i++) {
+		/* interpolate between the FIFO boundary timestamps so that
+		 * the last sample lands exactly on ts_last.
+		 */
+		if (i == (n - 1))
+			ts = ts_last;
+		else
+			ts = ts_first + (ts_period * (s64)i);
+		ret = nvs_buf_push(indio_dev, &buf[src_i], ts);
+		if (ret < 0)
+			return ret;
+
+		src_i += ret;
+	}
+	return src_i;
+}
+
 static int nvs_enable(struct iio_dev *indio_dev, bool en)
 {
 	struct nvs_state *st = iio_priv(indio_dev);
@@ -2017,6 +2055,7 @@ static struct nvs_fn_if nvs_fn_if_iio = {
 	.suspend			= nvs_suspend,
 	.resume				= nvs_resume,
 	.handler			= nvs_handler,
+	.handler_batch			= nvs_handler_batch,
 };
 
 struct nvs_fn_if *nvs_iio(void)
@@ -142,6 +142,7 @@ static struct nvs_fn_if nvs_fn_if_input = {
 	.suspend			= nvs_suspend,
 	.resume				= nvs_resume,
 	.handler			= nvs_handler,
+	.handler_batch			= nvs_handler_batch,
 };
 
 struct nvs_fn_if *nvs_input(void)
@@ -147,6 +147,7 @@ static struct nvs_fn_if nvs_fn_if_relay = {
 	.suspend			= nvs_suspend,
 	.resume				= nvs_resume,
 	.handler			= nvs_handler,
+	.handler_batch			= nvs_handler_batch,
 };
 
 struct nvs_fn_if *nvs_relay(void)
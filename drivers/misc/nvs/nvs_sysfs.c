@@ -43,6 +43,7 @@
 #include <linux/slab.h>
 #include <linux/of.h>
 #include <linux/string.h>
+#include <linux/math64.h>
 #include "nvs_sysfs.h"
 
 #define NVS_SYSFS_DRIVER_VERSION	(3)
@@ -369,6 +370,43 @@ int nvs_handler(void *handle, void *buffer, s64 ts)
 	return ret;
 }
 
+int nvs_handler_batch(void *handle, void *buffer, unsigned int n,
+		      s64 ts_first, s64 ts_last)
+{
+	struct nvs_state *st = (struct nvs_state *)handle;
+	unsigned char *buf = buffer;
+	s64 ts_period = 0;
+	s64 ts;
+	unsigned int src_i = 0;
+	unsigned int i;
+	int ret;
+
+	if (!st)
+		return 0;
+
+	if (!buf || !n)
+		/* flush or timestamp-only event */
+		return nvs_buf_push(st, buf, ts_last);
+
+	if (n > 1)
+		ts_period = div_s64(ts_last - ts_first, n - 1);
+	for (i = 0; i < n; i++) {
+		/* interpolate between the FIFO boundary timestamps so that
+		 * the last sample lands exactly on ts_last.
+		 */
+		if (i == (n - 1))
+			ts = ts_last;
+		else
+			ts = ts_first + (ts_period * (s64)i);
+		ret = nvs_buf_push(st, &buf[src_i], ts);
+		if (ret < 0)
+			return ret;
+
+		src_i += ret;
+	}
+	return src_i;
+}
+
 static void nvs_report_mode(struct nvs_state *st)
 {
 	/* Currently this is called once during initialization. However, there
@@ -83,6 +83,8 @@ void nvs_mutex_unlock(void *handle);
 int nvs_suspend(void *handle);
 int nvs_resume(void *handle);
 int nvs_handler(void *handle, void *buffer, s64 ts);
+int nvs_handler_batch(void *handle, void *buffer, unsigned int n,
+		      s64 ts_first, s64 ts_last);
 
 static inline void *nvs_st_kif(struct nvs_state *st)
 {
@@ -179,19 +179,51 @@ can_recv(struct fifo_t *fifo, int *ret)
 	return recv;
 }
 
+/* stage one message into the send fifo without publishing it to peer.*/
+static void
+stage_msg(struct fifo_t *fifo, struct comm_msg *msg)
+{
+	void __iomem *to =
+		(void __iomem *)(fifo->send + (fifo->wr_pos * fifo->frame_sz));
+
+	memcpy_toio(to, (void *)(msg), sizeof(*msg));
+
+	fifo->local_hdr->wr_count++;
+	fifo->wr_pos = fifo->wr_pos + 1;
+	if (fifo->wr_pos >= fifo->nframes)
+		fifo->wr_pos = 0;
+}
+
+/* publish all staged messages: update peer wr_count, single doorbell.*/
+static int
+publish_msgs(struct comm_channel_ctx_t *comm_ctx, enum peer_cpu_t peer_cpu)
+{
+	int ret = 0;
+	struct fifo_t *fifo = &comm_ctx->fifo;
+	struct syncpt_t *syncpt = &comm_ctx->syncpt;
+
+	writel(fifo->local_hdr->wr_count,
+	       (void __iomem *)(&fifo->send_hdr->wr_count));
+
+	if (peer_cpu == NVCPU_X86_64) {
+	/* comm-channel irq verctor always take from index 0 */
+		ret = pci_client_raise_irq(comm_ctx->pci_client_h, PCI_EPC_IRQ_MSI, 0);
+	} else {
+	/* notify peer.*/
+		writel(0x1, syncpt->peer_mem.pva);
+	}
+
+	return ret;
+}
+
 static int
 send_msg(struct comm_channel_ctx_t *comm_ctx, struct comm_msg *msg)
 {
 	int ret = 0;
-	size_t size = 0;
-	void *from = NULL;
-	void __iomem *to = NULL;
 	struct fifo_t *fifo = NULL;
-	struct syncpt_t *syncpt = NULL;
 	enum peer_cpu_t peer_cpu = NVCPU_ORIN;
 
 	fifo = &comm_ctx->fifo;
-	syncpt = &comm_ctx->syncpt;
 
 	peer_cpu = pci_client_get_peer_cpu(comm_ctx->pci_client_h);
 	mutex_lock(&fifo->send_lock);
@@ -202,26 +234,48 @@ send_msg(struct comm_channel_ctx_t *comm_ctx, struct comm_msg *msg)
 		return ret;
 	}
 
-	to = (void __iomem *)(fifo->send + (fifo->wr_pos * fifo->frame_sz));
-	from = (void *)(msg);
-	size = sizeof(*msg);
-	memcpy_toio(to, from, size);
+	stage_msg(fifo, msg);
+	ret = publish_msgs(comm_ctx, peer_cpu);
 
-	fifo->local_hdr->wr_count++;
-	writel(fifo->local_hdr->wr_count,
-	       (void __iomem *)(&fifo->send_hdr->wr_count));
+	mutex_unlock(&fifo->send_lock);
 
-	if (peer_cpu == NVCPU_X86_64) {
-	/* comm-channel irq verctor always take from index 0 */
-		ret = pci_client_raise_irq(comm_ctx->pci_client_h, PCI_EPC_IRQ_MSI, 0);
-	} else {
-	/* notify peer for each write.*/
-		writel(0x1, syncpt->peer_mem.pva);
+	return ret;
+}
+
+/*
+ * Write-combined variant of send_msg(): stage all messages in the send
+ * fifo and raise a single notification for the whole burst, instead of
+ * one non-posted doorbell per message. All-or-nothing: if the fifo does
+ * not have space for the complete burst, -EAGAIN is returned.
+ */
+static int
+send_msg_burst(struct comm_channel_ctx_t *comm_ctx,
+	       struct comm_msg *msgs, u32 count)
+{
+	int ret = 0;
+	u32 i = 0;
+	u32 peer_toread = 0;
+	struct fifo_t *fifo = NULL;
+	enum peer_cpu_t peer_cpu = NVCPU_ORIN;
+
+	fifo = &comm_ctx->fifo;
+
+	peer_cpu = pci_client_get_peer_cpu(comm_ctx->pci_client_h);
+	mutex_lock(&fifo->send_lock);
+
+	peer_toread = (fifo->local_hdr->wr_count - fifo->recv_hdr->rd_count);
+	if (peer_toread > fifo->nframes) {
+		mutex_unlock(&fifo->send_lock);
+		return -EOVERFLOW;
+	}
+	if (count > (fifo->nframes - peer_toread)) {
+		mutex_unlock(&fifo->send_lock);
+		return -EAGAIN;
 	}
 
-	fifo->wr_pos = fifo->wr_pos + 1;
-	if (fifo->wr_pos >= fifo->nframes)
-		fifo->wr_pos = 0;
+	for (i = 0; i < count; i++)
+		stage_msg(fifo, &msgs[i]);
+	ret = publish_msgs(comm_ctx, peer_cpu);
 
 	mutex_unlock(&fifo->send_lock);
 
@@ -294,6 +348,36 @@ comm_channel_msg_send(void *comm_channel_h, struct comm_msg *msg)
 	return send_msg(comm_ctx, msg);
 }
 
+int
+comm_channel_msg_send_burst(void *comm_channel_h,
+			    struct comm_msg *msgs, u32 count)
+{
+	u32 i = 0;
+	enum nvscic2c_pcie_link link = NVSCIC2C_PCIE_LINK_DOWN;
+	struct comm_channel_ctx_t *comm_ctx =
+				(struct comm_channel_ctx_t *)comm_channel_h;
+
+	if (WARN_ON(!comm_ctx || !msgs || !count))
+		return -EINVAL;
+
+	if (WARN_ON(count > comm_ctx->fifo.nframes))
+		return -EINVAL;
+
+	for (i = 0; i < count; i++) {
+		if (WARN_ON(msgs[i].type <= COMM_MSG_TYPE_INVALID ||
+			    msgs[i].type >= COMM_MSG_TYPE_MAXIMUM ||
+			    msgs[i].type == COMM_MSG_TYPE_BOOTSTRAP))
+			return -EINVAL;
+	}
+
+	link = pci_client_query_link_status(comm_ctx->pci_client_h);
+
+	if (link != NVSCIC2C_PCIE_LINK_UP)
+		return -ENOLINK;
+
+	return send_msg_burst(comm_ctx, msgs, count);
+}
+
 static int
 recv_taskfn(void *arg)
 {
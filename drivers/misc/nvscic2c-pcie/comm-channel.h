@@ -117,6 +117,17 @@ comm_channel_deinit(void **comm_channel_h);
 int
 comm_channel_msg_send(void *comm_channel_h, struct comm_msg *msg);
 
+/*
+ * Send a batch of messages with a single peer notification. Messages
+ * are staged back-to-back in the send fifo (posted writes) and the
+ * doorbell is raised once for the whole burst. For latency-critical
+ * single messages use comm_channel_msg_send() which notifies the peer
+ * immediately.
+ */
+int
+comm_channel_msg_send_burst(void *comm_channel_h,
+			    struct comm_msg *msgs, u32 count);
+
 int
 comm_channel_bootstrap_msg_send(void *comm_channel_h, struct comm_msg *msg);
 
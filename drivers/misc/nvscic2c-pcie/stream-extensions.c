@@ -590,6 +590,46 @@ reclaim_cr:
 	return ret;
 }
 
+/* implement NVSCIC2C_PCIE_IOCTL_SUBMIT_COPY_REQUESTS ioctl call. */
+static int
+ioctl_submit_copy_burst(struct stream_ext_ctx_t *ctx,
+			struct nvscic2c_pcie_submit_copy_burst_args *args)
+{
+	int ret = 0;
+	u64 i = 0;
+	struct nvscic2c_pcie_submit_copy_args cp_args;
+	void __user *requests = (void __user *)args->requests;
+
+	if (!args->num_requests || !args->requests)
+		return -EINVAL;
+
+	/*
+	 * submit in order, stopping at the first request that fails.
+	 * Requests submitted until then stay scheduled and complete via
+	 * their eDMA callbacks; report how many went through.
+	 */
+	for (i = 0; i < args->num_requests; i++) {
+		if (copy_from_user(&cp_args,
+				   (requests + (i * sizeof(cp_args))),
+				   sizeof(cp_args))) {
+			ret = -EFAULT;
+			break;
+		}
+
+		ret = ioctl_submit_copy_request(ctx, &cp_args);
+		if (ret)
+			break;
+	}
+
+	args->num_requests = i;
+
+	/* an error is reported only when nothing could be submitted.*/
+	if (i > 0)
+		ret = 0;
+
+	return ret;
+}
+
 /* implement NVSCIC2C_PCIE_IOCTL_MAX_COPY_REQUESTS ioctl call. */
 static int
 ioctl_set_max_copy_requests(struct stream_ext_ctx_t *ctx,
@@ -688,6 +728,11 @@ stream_extension_ioctl(void *stream_ext_h, unsigned int cmd, void *args)
 			((struct stream_ext_ctx_t *)ctx,
 			 (struct nvscic2c_pcie_submit_copy_args *)args);
 		break;
+	case NVSCIC2C_PCIE_IOCTL_SUBMIT_COPY_REQUESTS:
+		ret = ioctl_submit_copy_burst
+			((struct stream_ext_ctx_t *)ctx,
+			 (struct nvscic2c_pcie_submit_copy_burst_args *)args);
+		break;
 	case NVSCIC2C_PCIE_IOCTL_MAX_COPY_REQUESTS:
 		ret = ioctl_set_max_copy_requests
 			((struct stream_ext_ctx_t *)ctx,
@@ -775,21 +775,45 @@ syncobj_release(s32 obj_id, void *ptr, void *data)
 	return 0;
 }
 
+/* batch of UNREGISTER messages collected for a single notification.*/
+#define UNREGISTER_BURST_LEN	(16)
+struct unregister_burst_t {
+	struct vmap_ctx_t *vmap_ctx;
+	u32 count;
+	struct comm_msg msgs[UNREGISTER_BURST_LEN];
+};
+
+static void
+unregister_burst_flush(struct unregister_burst_t *burst)
+{
+	if (!burst->count)
+		return;
+
+	/* best-effort on exit, as with the per-message sends before.*/
+	comm_channel_msg_send_burst(burst->vmap_ctx->comm_channel_h,
+				    burst->msgs, burst->count);
+	burst->count = 0;
+}
+
 /* Exit point only. */
 static int
 importobj_release(s32 obj_id, void *ptr, void *data)
 {
 	struct importobj_map_ref *map = (struct importobj_map_ref *)(ptr);
-	struct vmap_ctx_t *vmap_ctx = (struct vmap_ctx_t *)(data);
-	struct comm_msg msg = {0};
+	struct unregister_burst_t *burst = (struct unregister_burst_t *)(data);
+	struct comm_msg *msg = NULL;
 
 	if (map) {
-		msg.type = COMM_MSG_TYPE_UNREGISTER;
-		msg.u.unreg.export_desc = map->reg.export_desc;
-		msg.u.unreg.iova = map->reg.attrib.iova;
-		msg.u.unreg.size = map->reg.attrib.size;
-		msg.u.unreg.offsetof = map->reg.attrib.offsetof;
-		comm_channel_msg_send(vmap_ctx->comm_channel_h, &msg);
+		if (burst->count >= UNREGISTER_BURST_LEN)
+			unregister_burst_flush(burst);
+
+		msg = &burst->msgs[burst->count++];
+		memset(msg, 0, sizeof(*msg));
+		msg->type = COMM_MSG_TYPE_UNREGISTER;
+		msg->u.unreg.export_desc = map->reg.export_desc;
+		msg->u.unreg.iova = map->reg.attrib.iova;
+		msg->u.unreg.size = map->reg.attrib.size;
+		msg->u.unreg.offsetof = map->reg.attrib.offsetof;
 
 		kfree(map);
 	}
@@ -802,6 +826,7 @@ void
 vmap_deinit(void **vmap_h)
 {
 	struct vmap_ctx_t *vmap_ctx = (struct vmap_ctx_t *)(*vmap_h);
+	struct unregister_burst_t unreg_burst = {0};
 
 	if (!vmap_ctx)
 		return;
@@ -828,8 +853,11 @@ vmap_deinit(void **vmap_h)
 	idr_destroy(&vmap_ctx->sync_idr);
 	mutex_unlock(&vmap_ctx->sync_idr_lock);
 
+	/* combine the UNREGISTERs, one notification per burst.*/
 	mutex_lock(&vmap_ctx->import_idr_lock);
-	idr_for_each(&vmap_ctx->import_idr, importobj_release, vmap_ctx);
+	unreg_burst.vmap_ctx = vmap_ctx;
+	idr_for_each(&vmap_ctx->import_idr, importobj_release, &unreg_burst);
+	unregister_burst_flush(&unreg_burst);
 	idr_destroy(&vmap_ctx->import_idr);
 	mutex_unlock(&vmap_ctx->import_idr_lock);
 
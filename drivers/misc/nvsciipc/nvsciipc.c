@@ -19,6 +19,7 @@
 #include <linux/module.h>
 #include <linux/platform_device.h>
 #include <linux/string.h>
+#include <linux/stringhash.h>
 #include <linux/types.h>
 #include <linux/device.h>
 #include <linux/cdev.h>
@@ -166,6 +167,30 @@ NvSciError NvSciIpcEndpointMapVuid(NvSciIpcEndpointVuid localUserVuid,
 }
 EXPORT_SYMBOL(NvSciIpcEndpointMapVuid);
 
+static u32 nvsciipc_ep_name_hash(const char *ep_name)
+{
+	return full_name_hash(NULL, ep_name,
+			strnlen(ep_name, NVSCIIPC_MAX_EP_NAME));
+}
+
+/* Look up an endpoint by name in the hash index, NULL when not found.
+ * Caller must hold nvsciipc_mutex.
+ */
+static struct nvsciipc_config_entry *nvsciipc_find_ep(struct nvsciipc *ctx,
+		const char *ep_name)
+{
+	struct nvsciipc_ep_node *ep_node;
+	u32 key = nvsciipc_ep_name_hash(ep_name);
+
+	hash_for_each_possible(ctx->ep_htable, ep_node, node, key) {
+		if (!strncmp(ep_name, ep_node->entry->ep_name,
+			NVSCIIPC_MAX_EP_NAME))
+			return ep_node->entry;
+	}
+
+	return NULL;
+}
+
 static int nvsciipc_dev_open(struct inode *inode, struct file *filp)
 {
 	struct nvsciipc *ctx = container_of(inode->i_cdev,
@@ -187,6 +212,10 @@ static void nvsciipc_free_db(struct nvsciipc *ctx)
 		kfree(ctx->db);
 	}
 
+	kfree(ctx->ep_nodes);
+	ctx->ep_nodes = NULL;
+	hash_init(ctx->ep_htable);
+
 	ctx->num_eps = 0;
 }
 
@@ -201,7 +230,7 @@ static int nvsciipc_ioctl_get_vuid(struct nvsciipc *ctx, unsigned int cmd,
 				   unsigned long arg)
 {
 	struct nvsciipc_get_vuid get_vuid;
-	int i;
+	struct nvsciipc_config_entry *entry;
 
 	if (copy_from_user(&get_vuid, (void __user *)arg, _IOC_SIZE(cmd))) {
 		ERR("%s : copy_from_user failed\n", __func__);
@@ -213,19 +242,57 @@ static int nvsciipc_ioctl_get_vuid(struct nvsciipc *ctx, unsigned int cmd,
 		return -EINVAL;
 	}
 
-	for (i = 0; i < ctx->num_eps; i++) {
-		if (!strncmp(get_vuid.ep_name, ctx->db[i]->ep_name,
-			NVSCIIPC_MAX_EP_NAME)) {
-			get_vuid.vuid = ctx->db[i]->vuid;
-			break;
-		}
+	entry = nvsciipc_find_ep(ctx, get_vuid.ep_name);
+	if (entry == NULL) {
+		ERR("wrong endpoint name passed\n");
+		return -EINVAL;
 	}
 
-	if (i == ctx->num_eps) {
-		ERR("wrong endpoint name passed\n");
+	get_vuid.vuid = entry->vuid;
+	if (copy_to_user((void __user *)arg, &get_vuid, _IOC_SIZE(cmd))) {
+		ERR("%s : copy_to_user failed\n", __func__);
+		return -EFAULT;
+	}
+
+	return 0;
+}
+
+static int nvsciipc_ioctl_get_db(struct nvsciipc *ctx, unsigned int cmd,
+				 unsigned long arg)
+{
+	struct nvsciipc_get_db get_db;
+	int count, i;
+
+	if (copy_from_user(&get_db, (void __user *)arg, _IOC_SIZE(cmd))) {
+		ERR("%s : copy_from_user failed\n", __func__);
+		return -EFAULT;
+	}
+
+	if (ctx->num_eps == 0) {
+		ERR("need to set endpoint database first\n");
 		return -EINVAL;
-	} else if (copy_to_user((void __user *)arg, &get_vuid,
-				_IOC_SIZE(cmd))) {
+	}
+
+	if (get_db.num_eps < 0) {
+		INFO("invalid value passed for num_eps\n");
+		return -EINVAL;
+	}
+
+	if (get_db.entries == NULL)
+		count = 0;
+	else
+		count = min(get_db.num_eps, ctx->num_eps);
+
+	for (i = 0; i < count; i++) {
+		if (copy_to_user((void __user *)&get_db.entries[i], ctx->db[i],
+				sizeof(struct nvsciipc_config_entry))) {
+			ERR("%s : copy_to_user failed\n", __func__);
+			return -EFAULT;
+		}
+	}
+
+	get_db.num_eps = ctx->num_eps;
+	if (copy_to_user((void __user *)arg, &get_db, _IOC_SIZE(cmd))) {
 		ERR("%s : copy_to_user failed\n", __func__);
 		return -EFAULT;
 	}
@@ -366,6 +433,21 @@ static int nvsciipc_ioctl_set_db(struct nvsciipc *ctx, unsigned int cmd,
 				    << NVSCIIPC_VUID_VMID_SHIFT);
 	}
 
+	ctx->ep_nodes = kcalloc(ctx->num_eps, sizeof(struct nvsciipc_ep_node),
+			GFP_KERNEL);
+	if (ctx->ep_nodes == NULL) {
+		ERR("memory allocation for ep_nodes failed\n");
+		ret = -EFAULT;
+		goto ptr_error;
+	}
+
+	/* Index the database by name so endpoint lookup avoids scanning it */
+	for (i = 0; i < ctx->num_eps; i++) {
+		ctx->ep_nodes[i].entry = ctx->db[i];
+		hash_add(ctx->ep_htable, &ctx->ep_nodes[i].node,
+			nvsciipc_ep_name_hash(ctx->db[i]->ep_name));
+	}
+
 	kfree(entry_ptr);
 	return ret;
 
@@ -417,6 +499,11 @@ static long nvsciipc_dev_ioctl(struct file *filp, unsigned int cmd,
 		ret = nvsciipc_ioctl_get_vuid(ctx, cmd, arg);
 		mutex_unlock(&nvsciipc_mutex);
 		break;
+	case NVSCIIPC_IOCTL_GET_DB:
+		mutex_lock(&nvsciipc_mutex);
+		ret = nvsciipc_ioctl_get_db(ctx, cmd, arg);
+		mutex_unlock(&nvsciipc_mutex);
+		break;
 	case NVSCIIPC_IOCTL_GET_VUID_LEGACY:
 		mutex_lock(&nvsciipc_mutex);
 		ret = nvsciipc_ioctl_get_vuid_legacy(ctx, cmd, arg);
@@ -457,6 +544,7 @@ static int nvsciipc_probe(struct platform_device *pdev)
 	}
 
 	ctx->dev = &(pdev->dev);
+	hash_init(ctx->ep_htable);
 	platform_set_drvdata(pdev, ctx);
 
 	ret = alloc_chrdev_region(&(ctx->dev_t), 0, 1, MODULE_NAME);
@@ -14,6 +14,7 @@
 #ifndef __NVSCIIPC_KERNEL_H__
 #define __NVSCIIPC_KERNEL_H__
 
+#include <linux/hashtable.h>
 #include <linux/nvscierror.h>
 #include <linux/nvsciipc_interface.h>
 #include <uapi/linux/nvsciipc_ioctl.h>
@@ -25,6 +26,14 @@
 #define MODULE_NAME             "nvsciipc"
 #define MAX_NAME_SIZE           64
 
+#define NVSCIIPC_EP_HASH_BITS   7
+
+/* Hash index node, one per endpoint database entry */
+struct nvsciipc_ep_node {
+	struct hlist_node node;
+	struct nvsciipc_config_entry *entry;
+};
+
 struct nvsciipc {
 	struct device *dev;
 
@@ -36,6 +45,10 @@ struct nvsciipc {
 
 	int num_eps;
 	struct nvsciipc_config_entry **db;
+
+	/* name hash index over db, built when the database is set */
+	struct nvsciipc_ep_node *ep_nodes;
+	DECLARE_HASHTABLE(ep_htable, NVSCIIPC_EP_HASH_BITS);
 };
 
 /***********************************************************************/
@@ -50,6 +63,8 @@ static long nvsciipc_dev_ioctl(struct file *filp, unsigned int cmd,
 			       unsigned long arg);
 static int nvsciipc_ioctl_get_vuid(struct nvsciipc *ctx, unsigned int cmd,
 				   unsigned long arg);
+static int nvsciipc_ioctl_get_db(struct nvsciipc *ctx, unsigned int cmd,
+				 unsigned long arg);
 static int nvsciipc_ioctl_set_db(struct nvsciipc *ctx, unsigned int cmd,
 				 unsigned long arg);
 
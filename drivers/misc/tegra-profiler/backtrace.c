@@ -116,8 +116,40 @@ static bool
 is_ex_entry_exist(struct quadd_event_context *event_ctx,
 		  struct quadd_callchain *cc, unsigned long addr)
 {
+	unsigned int i, nr;
+	struct vm_area_struct *vma = NULL;
+	struct mm_struct *mm = event_ctx->task->mm;
 	struct quadd_unw_methods *um = &cc->um;
 
+	/*
+	 * Both table unwinders look the unwind tables up by the start
+	 * address of the vma, so a vma without a registered region fails
+	 * identically for every address within it.  Remember such vmas
+	 * for the rest of the sample: on binaries built without unwind
+	 * tables this turns the per-frame region search into a simple
+	 * range check.
+	 */
+	if (mm)
+		vma = find_vma(mm, addr);
+
+	if (vma) {
+		for (i = 0; i < cc->nr_no_unw_vmas; i++) {
+			if (addr >= cc->no_unw_vmas[i].vm_start &&
+			    addr < cc->no_unw_vmas[i].vm_end)
+				return false;
+		}
+
+		if (!quadd_is_ex_region_exist(event_ctx, vma->vm_start)) {
+			nr = cc->nr_no_unw_vmas;
+			if (nr < QUADD_MAX_NO_UNW_VMAS) {
+				cc->no_unw_vmas[nr].vm_start = vma->vm_start;
+				cc->no_unw_vmas[nr].vm_end = vma->vm_end;
+				cc->nr_no_unw_vmas = nr + 1;
+			}
+			return false;
+		}
+	}
+
 	if (um->dwarf) {
 		if (quadd_is_ex_entry_exist_dwarf(event_ctx, addr))
 			return true;
@@ -565,14 +597,27 @@ get_user_callchain_mixed(struct quadd_event_context *event_ctx,
 		nr_prev = cc->nr;
 		prev_sp = cc->curr_sp;
 
-		if (um->dwarf)
-			quadd_get_user_cc_dwarf(event_ctx, cc);
-		if (um->ut)
-			quadd_get_user_cc_arm32_ehabi(event_ctx, cc);
-
-		if (um->fp && nr_prev == cc->nr)
+		/*
+		 * Tiered unwinding: walk the cheap frame-pointer chain
+		 * first and fall back to the table unwinders only when
+		 * it makes no progress.  user_backtrace() stops at the
+		 * first address that is covered by unwind tables, so
+		 * the tables pick up exactly where the frame pointers
+		 * end.
+		 */
+		if (um->fp_first && um->fp)
 			__get_user_callchain_fp(event_ctx, cc);
 
+		if (!um->fp_first || nr_prev == cc->nr) {
+			if (um->dwarf)
+				quadd_get_user_cc_dwarf(event_ctx, cc);
+			if (um->ut)
+				quadd_get_user_cc_arm32_ehabi(event_ctx, cc);
+
+			if (um->fp && !um->fp_first && nr_prev == cc->nr)
+				__get_user_callchain_fp(event_ctx, cc);
+		}
+
 		is_stack_ok = cc->nr <= 1 ?
 			cc->curr_sp >= prev_sp : cc->curr_sp > prev_sp;
 		is_stack_ok = (cc->curr_sp & align_mask) ? 0 : is_stack_ok;
@@ -596,6 +641,8 @@ quadd_get_user_callchain(struct quadd_event_context *event_ctx,
 	cc->curr_pc = 0;
 	cc->curr_lr = 0;
 
+	cc->nr_no_unw_vmas = 0;
+
 	if (!regs) {
 		cc->urc_fp = QUADD_URC_FAILURE;
 		cc->urc_ut = QUADD_URC_FAILURE;
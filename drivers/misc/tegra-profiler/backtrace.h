@@ -26,6 +26,8 @@
 
 #define QUADD_MAX_STACK_DEPTH		64
 
+#define QUADD_MAX_NO_UNW_VMAS		4
+
 #define QUADD_UNW_TYPES_SIZE \
 	DIV_ROUND_UP(QUADD_MAX_STACK_DEPTH * 4, sizeof(u32) * BITS_PER_BYTE)
 
@@ -36,7 +38,8 @@ struct quadd_unw_methods {
 		fp:1,
 		ut:1,
 		ut_ce:1,
-		dwarf:1;
+		dwarf:1,
+		fp_first:1;
 };
 
 struct quadd_callchain {
@@ -63,6 +66,13 @@ struct quadd_callchain {
 	unsigned long curr_pc;
 	unsigned long curr_lr;
 
+	/* vmas without unwind tables, cached for the current sample */
+	struct {
+		unsigned long vm_start;
+		unsigned long vm_end;
+	} no_unw_vmas[QUADD_MAX_NO_UNW_VMAS];
+	unsigned int nr_no_unw_vmas;
+
 	struct quadd_hrt_ctx *hrt;
 };
 
@@ -148,12 +148,19 @@ write_sample(struct quadd_ring_buffer *rb,
 static size_t get_data_size(void)
 {
 	int cpu_id;
-	unsigned long flags;
-	size_t size = 0, tail;
+	size_t size = 0, head, tail;
 	struct comm_cpu_context *cc;
 	struct quadd_ring_buffer *rb;
 	struct quadd_ring_buffer_hdr *rb_hdr;
 
+	/*
+	 * Polling only looks at the ring pointers: pos_write is
+	 * published with smp_store_release() by the producer and
+	 * pos_read is owned by userspace, so there is no need to take
+	 * the producers' locks here. Doing so bounced every per-CPU
+	 * lock across the system on each poll and perturbed the
+	 * profiled workload at high sampling rates.
+	 */
 	for_each_possible_cpu(cpu_id) {
 		cc = &per_cpu(cpu_ctx, cpu_id);
 
@@ -163,12 +170,9 @@ static size_t get_data_size(void)
 		if (!rb_hdr)
 			continue;
 
-		raw_spin_lock_irqsave(&rb->lock, flags);
-
+		head = smp_load_acquire(&rb_hdr->pos_write);
 		tail = READ_ONCE(rb_hdr->pos_read);
-		size += CIRC_CNT(rb_hdr->pos_write, tail, rb_hdr->size);
-
-		raw_spin_unlock_irqrestore(&rb->lock, flags);
+		size += CIRC_CNT(head, tail, rb_hdr->size);
 	}
 
 	return size;
@@ -209,6 +213,18 @@ put_sample(struct quadd_record_data *data,
 	return err;
 }
 
+void quadd_comm_rb_get_stats(int cpu_id, size_t *nr_skipped,
+			     size_t *max_fill)
+{
+	struct comm_cpu_context *cc = &per_cpu(cpu_ctx, cpu_id);
+	struct quadd_ring_buffer *rb = &cc->rb;
+
+	/* The counters are only written under the ring lock; a racy
+	 * read is good enough for statistics. */
+	*nr_skipped = READ_ONCE(rb->nr_skipped_samples);
+	*max_fill = READ_ONCE(rb->max_fill_count);
+}
+
 static void comm_reset(void)
 {
 	pr_debug("Comm reset\n");
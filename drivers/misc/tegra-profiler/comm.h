@@ -93,4 +93,7 @@ quadd_comm_init(struct quadd_ctx *ctx,
 		struct quadd_comm_control_interface *control);
 void quadd_comm_exit(void);
 
+void quadd_comm_rb_get_stats(int cpu_id, size_t *nr_skipped,
+			     size_t *max_fill);
+
 #endif	/* __QUADD_COMM_H__ */
@@ -1570,6 +1570,15 @@ out:
 	return ret;
 }
 
+int
+quadd_is_ex_region_exist(struct quadd_event_context *event_ctx,
+			 unsigned long key)
+{
+	struct ex_region_info ri;
+
+	return !search_ex_region(task_tgid_nr(event_ctx->task), key, &ri);
+}
+
 int quadd_unwind_start(struct task_struct *task)
 {
 	int err;
@@ -69,6 +69,10 @@ int
 quadd_is_ex_entry_exist_arm32_ehabi(struct quadd_event_context *event_ctx,
 				    unsigned long addr);
 
+int
+quadd_is_ex_region_exist(struct quadd_event_context *event_ctx,
+			 unsigned long key);
+
 void
 quadd_unwind_set_tail_info(struct ex_region_info *ri,
 			   unsigned int secid,
@@ -273,6 +273,8 @@ static void put_header(int cpuid, bool is_uncore)
 			hdr->flags |= QUADD_HDR_FLAG_BT_UT_CE;
 		if (um->dwarf)
 			hdr->flags |= QUADD_HDR_FLAG_BT_DWARF;
+		if (um->fp_first)
+			hdr->flags |= QUADD_HDR_FLAG_BT_FP_FIRST;
 	}
 
 	if (hrt.use_arch_timer)
@@ -1048,9 +1050,10 @@ int quadd_hrt_start(void)
 		um->ut = extra & QUADD_PARAM_EXTRA_BT_UT ? 1 : 0;
 		um->ut_ce = extra & QUADD_PARAM_EXTRA_BT_UT_CE ? 1 : 0;
 		um->dwarf = extra & QUADD_PARAM_EXTRA_BT_DWARF ? 1 : 0;
+		um->fp_first = extra & QUADD_PARAM_EXTRA_BT_FP_FIRST ? 1 : 0;
 
-		pr_info("unw methods: fp/ut/ut_ce/dwarf: %u/%u/%u/%u\n",
-			um->fp, um->ut, um->ut_ce, um->dwarf);
+		pr_info("unw methods: fp/ut/ut_ce/dwarf: %u/%u/%u/%u, fp first: %u\n",
+			um->fp, um->ut, um->ut_ce, um->dwarf, um->fp_first);
 	}
 
 	if (hrt.tc && (extra & QUADD_PARAM_EXTRA_USE_ARCH_TIMER) &&
@@ -23,6 +23,7 @@
 #include <linux/tegra_profiler.h>
 
 #include "quadd.h"
+#include "comm.h"
 #include "version.h"
 #include "quadd_proc.h"
 #include "arm_pmu.h"
@@ -243,6 +244,42 @@ static const struct proc_ops status_proc_fops = {
 };
 #endif
 
+static int show_rb_stats(struct seq_file *f, void *offset)
+{
+	int cpu_id;
+	size_t nr_skipped, max_fill;
+
+	for_each_possible_cpu(cpu_id) {
+		quadd_comm_rb_get_stats(cpu_id, &nr_skipped, &max_fill);
+
+		seq_printf(f, "cpu %d: skipped samples: %zu, max fill: %zu\n",
+			   cpu_id, nr_skipped, max_fill);
+	}
+
+	return 0;
+}
+
+static int show_rb_stats_proc_open(struct inode *inode, struct file *file)
+{
+	return single_open(file, show_rb_stats, NULL);
+}
+
+#if (LINUX_VERSION_CODE < KERNEL_VERSION(5, 6, 0))
+static const struct file_operations rb_stats_proc_fops = {
+	.open		= show_rb_stats_proc_open,
+	.read		= seq_read,
+	.llseek		= seq_lseek,
+	.release	= single_release,
+};
+#else
+static const struct proc_ops rb_stats_proc_fops = {
+	.proc_open	= show_rb_stats_proc_open,
+	.proc_read	= seq_read,
+	.proc_lseek	= seq_lseek,
+	.proc_release	= single_release,
+};
+#endif
+
 void quadd_proc_init(struct quadd_ctx *context)
 {
 	ctx = context;
@@ -253,6 +290,7 @@ void quadd_proc_init(struct quadd_ctx *context)
 	proc_create(QUADD_PROC_DEV "/capabilities", 0, NULL,
 		    &capabilities_proc_fops);
 	proc_create(QUADD_PROC_DEV "/status", 0, NULL, &status_proc_fops);
+	proc_create(QUADD_PROC_DEV "/rb_stats", 0, NULL, &rb_stats_proc_fops);
 }
 
 void quadd_proc_deinit(void)
@@ -260,6 +298,7 @@ void quadd_proc_deinit(void)
 	remove_proc_entry(QUADD_PROC_DEV "/version", NULL);
 	remove_proc_entry(QUADD_PROC_DEV "/capabilities", NULL);
 	remove_proc_entry(QUADD_PROC_DEV "/status", NULL);
+	remove_proc_entry(QUADD_PROC_DEV "/rb_stats", NULL);
 	remove_proc_entry(QUADD_PROC_DEV, NULL);
 }
 
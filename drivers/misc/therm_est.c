@@ -51,6 +51,8 @@ struct therm_estimator {
 	int tc2;
 	struct therm_est_subdevice *subdevice;
 	bool *tripped_info;
+	/* force a full recompute on the next pass (coeffs changed etc.) */
+	bool force_update;
 
 	int use_activator;
 #ifdef CONFIG_PM
@@ -123,23 +125,55 @@ static void therm_est_work_func(struct work_struct *work)
 					therm_est_work);
 	struct therm_est_subdevice *subdevice;
 	struct therm_est_coeffs *coeffs_set;
+	struct therm_est_sub_thz *sub_thz;
 	s32 *thz_coeffs;
+	bool changed;
 	long *hist;
-	int temp;
+	int temp, prev;
 	int i, j, index, sum = 0;
 
 	subdevice = est->subdevice;
 	coeffs_set = &subdevice->coeffs_set[subdevice->active_coeffs];
+	changed = est->force_update;
 
 	subdevice->ntemp = (subdevice->ntemp + 1) % HIST_LEN;
 	for (i = 0; i < subdevice->num_devs; i++) {
-		if (therm_est_subdev_get_temp(subdevice->sub_thz[i].thz, &temp))
+		sub_thz = &subdevice->sub_thz[i];
+		if (therm_est_subdev_get_temp(sub_thz->thz, &temp))
 			continue;
-		subdevice->sub_thz[i].hist[subdevice->ntemp] = temp;
+		prev = sub_thz->hist[(subdevice->ntemp + HIST_LEN - 1) %
+					HIST_LEN];
+		sub_thz->hist[subdevice->ntemp] = temp;
+		if (temp == prev) {
+			if (sub_thz->same_count <= HIST_LEN)
+				sub_thz->same_count++;
+		} else {
+			sub_thz->same_count = 1;
+		}
+		/*
+		 * Once a device has reported the same temperature for a
+		 * full history window plus one pass, its contribution to
+		 * the estimate can no longer move.
+		 */
+		if (sub_thz->same_count <= HIST_LEN)
+			changed = true;
 	}
 
+	/* Steady state: no sensor delta, the estimate cannot change */
+	if (!changed)
+		goto sched;
+	est->force_update = false;
+
 	for (i = 0; i < subdevice->num_devs; i++) {
-		hist = subdevice->sub_thz[i].hist;
+		sub_thz = &subdevice->sub_thz[i];
+		hist = sub_thz->hist;
+		/* Flat history: convolution collapses to one multiply */
+		if (coeffs_set->coeff_sums &&
+				sub_thz->same_count >= HIST_LEN) {
+			sum += hist[subdevice->ntemp] *
+					coeffs_set->coeff_sums[i];
+			continue;
+		}
 		thz_coeffs = coeffs_set->coeffs[i];
 		for (j = 0; j < HIST_LEN; j++) {
 			index = (subdevice->ntemp - j + HIST_LEN) % HIST_LEN;
@@ -155,6 +189,7 @@ static void therm_est_work_func(struct work_struct *work)
 		therm_est_update_limits(est);
 	}
 
+sched:
 	if (est->polling_enabled > 0 || !est->use_activator) {
 		queue_delayed_work(est->workqueue, &est->therm_est_work,
 			msecs_to_jiffies(est->polling_period));
@@ -209,11 +244,33 @@ static int therm_est_init_history(struct therm_estimator *est)
 
 		for (j = 0; j < HIST_LEN; j++)
 			sub_thz[i].hist[j] = temp;
+		sub_thz[i].same_count = HIST_LEN;
 	}
 
 	return 0;
 }
 
+/* Cache the per-device coefficient totals used by the flat-history
+ * fastpath. Called whenever a coefficient set is (re)written. */
+static void therm_est_update_coeff_sums(struct therm_est_subdevice *subdevice)
+{
+	struct therm_est_coeffs *coeffs_set;
+	s32 sum;
+	int i, j, k;
+
+	for (i = 0; i < subdevice->num_coeffs; i++) {
+		coeffs_set = &subdevice->coeffs_set[i];
+		if (!coeffs_set->coeff_sums)
+			continue;
+		for (j = 0; j < subdevice->num_devs; j++) {
+			sum = 0;
+			for (k = 0; k < HIST_LEN; k++)
+				sum += coeffs_set->coeffs[j][k];
+			coeffs_set->coeff_sums[j] = sum;
+		}
+	}
+}
+
 static int therm_est_polling(struct therm_estimator *est,
 				int polling)
 {
@@ -222,6 +279,7 @@ static int therm_est_polling(struct therm_estimator *est,
 	if (est->polling_enabled > 0) {
 		est->low_limit = 0;
 		est->high_limit = 0;
+		est->force_update = true;
 		therm_est_init_history(est);
 		queue_delayed_work(est->workqueue,
 			&est->therm_est_work,
@@ -241,6 +299,7 @@ static int switch_active_coeffs(struct therm_estimator *est, int active_coeffs)
 		return -EINVAL;
 
 	subdevice->active_coeffs = active_coeffs;
+	est->force_update = true;
 
 	return 0;
 }
@@ -335,6 +394,8 @@ static ssize_t set_coeff(struct device *dev,
 	memcpy(est->subdevice->coeffs_set[coeffs_index].coeffs[dev_index],
 						coeff,
 						sizeof(coeff[0]) * HIST_LEN);
+	therm_est_update_coeff_sums(est->subdevice);
+	est->force_update = true;
 
 	return count;
 }
@@ -361,6 +422,7 @@ static ssize_t set_offset(struct device *dev,
 		return -EINVAL;
 
 	est->subdevice->coeffs_set[coeffs_index].toffset = offset;
+	est->force_update = true;
 
 	return count;
 }
@@ -519,6 +581,7 @@ static int therm_est_pm_notify(struct notifier_block *nb,
 	case PM_POST_SUSPEND:
 		est->low_limit = 0;
 		est->high_limit = 0;
+		est->force_update = true;
 		therm_est_init_history(est);
 		queue_delayed_work(est->workqueue,
 				&est->therm_est_work,
@@ -620,6 +683,12 @@ static int therm_est_get_subdev(struct device *dev,
 			GFP_KERNEL);
 		if (!subdevice->coeffs_set[i].coeffs)
 			return -ENOMEM;
+
+		subdevice->coeffs_set[i].coeff_sums = devm_kzalloc(dev,
+			sizeof(*subdevice->coeffs_set->coeff_sums) * num_subdevs,
+			GFP_KERNEL);
+		if (!subdevice->coeffs_set[i].coeff_sums)
+			return -ENOMEM;
 	}
 
 	for (i = 0; i < num_subdevs; i++) {
@@ -737,9 +806,11 @@ static int therm_est_probe(struct platform_device *pdev)
 	est->tc2 = data->tc2;
 	est->cur_temp = DEFAULT_TSKIN;
 	est->use_activator = data->use_activator;
+	est->force_update = true;
 
 	/* initialize history */
 	therm_est_init_history(est);
+	therm_est_update_coeff_sums(est->subdevice);
 
 	est->workqueue = alloc_workqueue(dev_name(&pdev->dev),
 				    WQ_HIGHPRI | WQ_UNBOUND, 1);
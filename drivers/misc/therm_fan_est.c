@@ -86,6 +86,19 @@ static void therm_fan_est_work_func(struct work_struct *work)
 	est->cur_temp = est->cur_temp_debug;
 #endif
 
+	/*
+	 * Load feedforward: an announced load burst heats the hot spots
+	 * before the sensor history reflects it, so bias the estimate
+	 * upwards while the hint is alive and let the trip evaluation
+	 * (or the continuous governor) pre-spin the fan.
+	 */
+	if (est->ff_boost != 0) {
+		if (time_after(est->ff_deadline, jiffies))
+			est->cur_temp += est->ff_boost;
+		else
+			est->ff_boost = 0;
+	}
+
 	if (est->is_continuous_gov)
 		goto next_work;
 
@@ -507,6 +520,43 @@ static ssize_t set_sleep_mode(struct device *dev,
 	return count;
 }
 
+static ssize_t show_load_hint(struct device *dev,
+				struct device_attribute *da,
+				char *buf)
+{
+	struct therm_fan_estimator *est = dev_get_drvdata(dev);
+
+	if (!est)
+		return -EINVAL;
+
+	snprintf(buf, PAGE_SIZE, "%ld\n",
+		(est->ff_boost != 0 && time_after(est->ff_deadline, jiffies)) ?
+		est->ff_boost : 0);
+	return strlen(buf);
+}
+
+static ssize_t set_load_hint(struct device *dev,
+				struct device_attribute *da,
+				const char *buf, size_t count)
+{
+	struct therm_fan_estimator *est = dev_get_drvdata(dev);
+	int load;
+
+	if (kstrtoint(buf, 0, &load))
+		return -EINVAL;
+
+	if (load < 0 || load > 100)
+		return -EINVAL;
+
+	est->ff_boost = (est->ff_gain * load) / 100;
+	est->ff_deadline = jiffies + msecs_to_jiffies(est->ff_timeout);
+
+	/* re-evaluate now instead of waiting out the polling period */
+	mod_delayed_work(est->workqueue, &est->therm_fan_est_work, 0);
+
+	return count;
+}
+
 static ssize_t show_temps(struct device *dev,
 				struct device_attribute *da,
 				char *buf)
@@ -555,6 +605,8 @@ static struct sensor_device_attribute therm_fan_est_nodes[] = {
 				show_fan_profile, set_fan_profile, 0),
 	SENSOR_ATTR(sleep_mode, S_IRUGO | S_IWUSR,
 				show_sleep_mode, set_sleep_mode, 0),
+	SENSOR_ATTR(load_hint, S_IRUGO | S_IWUSR,
+				show_load_hint, set_load_hint, 0),
 #if DEBUG
 	SENSOR_ATTR(temps, S_IRUGO | S_IWUSR, show_temps, set_temps, 0),
 #else
@@ -717,6 +769,19 @@ static int therm_fan_est_probe(struct platform_device *pdev)
 	}
 	est_data->polling_period = (long)value;
 
+	/* load feedforward, optional */
+	if (of_property_read_u32(node, "feedforward_gain", &value))
+		value = 0;
+	est_data->ff_gain = (long)value;
+
+	if (of_property_read_u32(node, "feedforward_timeout", &value))
+		value = 2 * est_data->polling_period;
+	est_data->ff_timeout = (long)value;
+
+	if (est_data->ff_gain)
+		pr_info("THERMAL EST feedforward: gain %ld timeout %ld\n",
+			est_data->ff_gain, est_data->ff_timeout);
+
 	/* fan trip temp/hyst profiles */
 	est_data->num_profiles = 0;
 	base_profile_node = of_get_child_by_name(node, "profiles");
@@ -2807,6 +2807,9 @@ static void tx_descriptor_init(struct eqos_prv_data *pdata, UINT qinx)
 	/* update the starting address of desc chain/ring */
 	DMA_TDLAR_WR(qinx, GET_TX_DESC_DMA_ADDR(qinx, start_index));
 
+	ptx_ring->defer_doorbell = Y_FALSE;
+	ptx_ring->doorbell_pending = Y_FALSE;
+
 	pr_debug("<--tx_descriptor_init\n");
 }
 
@@ -3010,9 +3013,16 @@ static void pre_transmit(struct eqos_prv_data *pdata, UINT qinx)
 #endif
 
 	/* issue a poll command to Tx DMA by writing address
-	 * of next immediate free descriptor */
+	 * of next immediate free descriptor. With more packets queued for
+	 * this ring the write is deferred so one doorbell covers the burst.
+	 */
 	wmb();
-	DMA_TDTP_TPDR_WR(qinx, GET_TX_DESC_DMA_ADDR(qinx, cur_index));
+	if (ptx_ring->defer_doorbell == Y_TRUE) {
+		ptx_ring->doorbell_pending = Y_TRUE;
+	} else {
+		DMA_TDTP_TPDR_WR(qinx, GET_TX_DESC_DMA_ADDR(qinx, cur_index));
+		ptx_ring->doorbell_pending = Y_FALSE;
+	}
 	ptx_ring->cur_tx = cur_index;
 
 	if (pdata->eee_enabled) {
@@ -45,6 +45,7 @@
  */
 
 #include <linux/gpio.h>
+#include <linux/prefetch.h>
 #include <linux/time.h>
 #include <linux/platform/tegra/ptp-notifier.h>
 #include <linux/reset.h>
@@ -395,6 +396,12 @@ void handle_mac_intrs(struct eqos_prv_data *pdata, ULONG dma_isr)
 		if (GET_VALUE(mac_isr, MAC_ISR_LPI_LPOS, MAC_ISR_LPI_HPOS) & 1) {
 			eqos_handle_eee_interrupt(pdata);
 		}
+
+		/* Timestamp interrupt - drain the auxiliary snapshot FIFO */
+		if (GET_VALUE(mac_isr, MAC_ISR_TSIS_LPOS,
+			      MAC_ISR_TSIS_HPOS) & 1) {
+			eqos_ptp_aux_ts_irq(pdata);
+		}
 	}
 
 	pr_debug("<--%s()\n", __func__);
@@ -1616,6 +1623,10 @@ static inline int eqos_tx_avail(struct tx_ring *ptx_ring)
 	return (ptx_ring->dirty_tx - ptx_ring->cur_tx - 1) & (TX_DESC_CNT - 1);
 }
 
+/* free descriptor count below which the xmit path kicks the TX NAPI
+ * rather than waiting for the coalesced completion interrupt */
+#define EQOS_TX_RECLAIM_WMARK	(TX_DESC_CNT / 4)
+
 /*!
 * \brief API to transmit the packets
 *
@@ -1643,6 +1654,11 @@ static int eqos_start_xmit(struct sk_buff *skb, struct net_device *dev)
 	INT retval = NETDEV_TX_OK;
 	int cnt = 0;
 	int tso;
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 2, 0)
+	UINT xmit_more = netdev_xmit_more();
+#else
+	UINT xmit_more = skb->xmit_more;
+#endif
 
 	pr_debug("-->eqos_start_xmit: skb->len = %d, qinx = %u\n", skb->len, qinx);
 
@@ -1738,6 +1754,11 @@ static int eqos_start_xmit(struct sk_buff *skb, struct net_device *dev)
 	if ((pdata->hw_feat.tsstssel == 0) || (pdata->hwts_tx_en == 0))
 		skb_tx_timestamp(skb);
 
+	/* defer the doorbell while the stack has more packets for this
+	 * ring; the burst is flushed with a single tail pointer write */
+	ptx_ring->defer_doorbell =
+		(xmit_more && !netif_xmit_stopped(txq)) ? Y_TRUE : Y_FALSE;
+
 	/* configure required descriptor fields for transmission */
 	hw_if->pre_xmit(pdata, qinx);
 
@@ -1755,6 +1776,28 @@ static int eqos_start_xmit(struct sk_buff *skb, struct net_device *dev)
 		netdev_dbg(dev, "%s(): Stopping TX ring %d\n", __func__, qinx);
 	}
 
+	/* Under sustained bidirectional load the coalesced completion
+	 * interrupt can lag far behind the ring; once occupancy crosses
+	 * the reclaim watermark kick the TX NAPI from the xmit path
+	 * instead of waiting for the interrupt.
+	 */
+	if (!ptx_ring->tx_full &&
+	    eqos_tx_avail(ptx_ring) < EQOS_TX_RECLAIM_WMARK &&
+	    likely(napi_schedule_prep(&pdata->tx_queue[qinx].napi))) {
+		pdata->xstats.tx_wmark_reclaim_n[qinx]++;
+		eqos_disable_chan_tx_interrupt(pdata, qinx);
+		__napi_schedule(&pdata->tx_queue[qinx].napi);
+	}
+
+	/* ring the deferred doorbell when this was the last packet of the
+	 * burst or the queue was stopped above */
+	if ((ptx_ring->doorbell_pending == Y_TRUE) &&
+	    (!xmit_more || netif_xmit_stopped(txq))) {
+		DMA_TDTP_TPDR_WR(qinx,
+				 GET_TX_DESC_DMA_ADDR(qinx, ptx_ring->cur_tx));
+		ptx_ring->doorbell_pending = Y_FALSE;
+	}
+
 tx_netdev_return:
 	return retval;
 }
@@ -2012,6 +2055,7 @@ static int process_tx_completions(struct eqos_tx_queue *tx_queue, int budget)
 	unsigned int tstamp_taken = 0;
 	int err_incremented;
 	int processed = 0;
+	int next_entry;
 
 	pr_debug("-->%s(): dirty_tx = %d, qinx = %u\n", __func__, entry, qinx);
 
@@ -2022,6 +2066,14 @@ cleanup:
 		ptx_swcx_desc = GET_TX_BUF_PTR(qinx, entry);
 		tstamp_taken = 0;
 
+		/* warm up the next descriptor's state while this one
+		 * is being cleaned */
+		next_entry = INCR_TX_LOCAL_INDEX(entry, 1);
+		if (next_entry != ptx_ring->cur_tx) {
+			prefetch(GET_TX_DESC_PTR(qinx, next_entry));
+			prefetch(GET_TX_BUF_PTR(qinx, next_entry));
+		}
+
 		/* ensure we actually got Tx desc */
 		rmb();
 		if (!hw_if->tx_complete(ptx_desc))
@@ -2285,10 +2337,17 @@ static int process_rx_completions(struct eqos_rx_queue *rx_queue, int quota)
 		struct sk_buff *skb;
 		u32 status, pkt_len;
 		int entry = prx_ring->cur_rx;
+		int next_entry;
 
 		prx_swcx_desc = GET_RX_BUF_PTR(qinx, entry);
 		prx_desc = GET_RX_DESC_PTR(qinx, entry);
 
+		/* warm up the next descriptor's state while this one
+		 * is being processed */
+		next_entry = INCR_RX_LOCAL_INDEX(entry, 1);
+		prefetch(GET_RX_DESC_PTR(qinx, next_entry));
+		prefetch(GET_RX_BUF_PTR(qinx, next_entry));
+
 		status = prx_desc->rdes3;
 		if (status & EQOS_RDESC3_OWN)
 			break;
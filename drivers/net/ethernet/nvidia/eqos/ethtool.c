@@ -137,6 +137,14 @@ static const struct eqos_stats eqos_gstrings_stats[] = {
 	EQOS_EXTRA_STAT(tx_clean_n[5]),
 	EQOS_EXTRA_STAT(tx_clean_n[6]),
 	EQOS_EXTRA_STAT(tx_clean_n[7]),
+	EQOS_EXTRA_STAT(tx_wmark_reclaim_n[0]),
+	EQOS_EXTRA_STAT(tx_wmark_reclaim_n[1]),
+	EQOS_EXTRA_STAT(tx_wmark_reclaim_n[2]),
+	EQOS_EXTRA_STAT(tx_wmark_reclaim_n[3]),
+	EQOS_EXTRA_STAT(tx_wmark_reclaim_n[4]),
+	EQOS_EXTRA_STAT(tx_wmark_reclaim_n[5]),
+	EQOS_EXTRA_STAT(tx_wmark_reclaim_n[6]),
+	EQOS_EXTRA_STAT(tx_wmark_reclaim_n[7]),
 	/* EEE */
 	EQOS_EXTRA_STAT(tx_path_in_lpi_mode_irq_n),
 	EQOS_EXTRA_STAT(tx_path_exit_lpi_mode_irq_n),
@@ -149,6 +157,10 @@ static const struct eqos_stats eqos_gstrings_stats[] = {
 	EQOS_EXTRA_STAT(rx_vlan_pkt_n),
 	EQOS_EXTRA_STAT(tx_timestamp_captured_n),
 	EQOS_EXTRA_STAT(rx_timestamp_captured_n),
+	EQOS_EXTRA_STAT(aux_ts_captured_n),
+	EQOS_EXTRA_STAT(aux_ts_delivered_n),
+	EQOS_EXTRA_STAT(aux_ts_interval_min_ns),
+	EQOS_EXTRA_STAT(aux_ts_interval_max_ns),
 	EQOS_EXTRA_STAT(tx_tso_pkt_n),
 
 	/* Tx/Rx frames per channels/queues */
@@ -46,6 +46,16 @@
  */
 #include <linux/version.h>
 #include "yheader.h"
+#include "yregacc.h"
+
+/* Deliver every Nth auxiliary snapshot event to the PTP clock framework.
+ * The sync chain only consumes a fraction of the raw trigger rate; the
+ * skipped events still update the interval statistics in ethtool -S.
+ */
+static unsigned int aux_ts_decimation = 1;
+module_param(aux_ts_decimation, uint, S_IRUGO | S_IWUSR);
+MODULE_PARM_DESC(aux_ts_decimation,
+		 "Deliver every Nth auxiliary snapshot event (0/1 = all)");
 
 /*!
  * \brief API to adjust the frequency of hardware clock.
@@ -243,7 +253,102 @@ static int eqos_set_time(struct ptp_clock_info *ptp, const struct timespec64 *ts
 static int eqos_enable(struct ptp_clock_info *ptp,
 		       struct ptp_clock_request *rq, int on)
 {
-	return -EOPNOTSUPP;
+	struct eqos_prv_data *pdata =
+	    container_of(ptp, struct eqos_prv_data, ptp_clock_ops);
+	unsigned long flags;
+
+	if (rq->type != PTP_CLK_REQ_EXTTS)
+		return -EOPNOTSUPP;
+
+	if (rq->extts.index >= ptp->n_ext_ts)
+		return -EINVAL;
+
+	raw_spin_lock_irqsave(&pdata->ptp_lock, flags);
+
+	if (on) {
+		/* start from an empty FIFO and fresh statistics */
+		MAC_AC_ATSFC_WR(1);
+		pdata->aux_ts_seen = 0;
+		pdata->aux_ts_last_ns = 0;
+		pdata->xstats.aux_ts_interval_min_ns = 0;
+		pdata->xstats.aux_ts_interval_max_ns = 0;
+	}
+
+	switch (rq->extts.index) {
+	case 0:
+		MAC_AC_ATSEN0_WR(on ? 1 : 0);
+		break;
+	case 1:
+		MAC_AC_ATSEN1_WR(on ? 1 : 0);
+		break;
+	case 2:
+		MAC_AC_ATSEN2_WR(on ? 1 : 0);
+		break;
+	default:
+		MAC_AC_ATSEN3_WR(on ? 1 : 0);
+		break;
+	}
+	MAC_IMR_TSIM_WR(on ? 1 : 0);
+
+	raw_spin_unlock_irqrestore(&pdata->ptp_lock, flags);
+
+	return 0;
+}
+
+/*!
+ * \brief API to drain the auxiliary snapshot FIFO.
+ *
+ * \details This function is called from the MAC interrupt handler when
+ * the timestamp interrupt is raised. It reads out all auxiliary
+ * snapshots captured since the last interrupt, maintains running
+ * min/max interval statistics and forwards every Nth event to the PTP
+ * clock framework, with N given by the aux_ts_decimation parameter.
+ *
+ * \param[in] pdata – pointer to private data structure.
+ *
+ * \return void
+ */
+
+void eqos_ptp_aux_ts_irq(struct eqos_prv_data *pdata)
+{
+	struct ptp_clock_event event;
+	ULONG num, sec, nsec;
+	u64 ns;
+
+	/* reading the status register also clears the interrupt */
+	MAC_TSR_ATSNS_RD(num);
+
+	while (num--) {
+		/* reading the nanoseconds register pops one FIFO entry */
+		MAC_ATN_AUXTSLO_RD(nsec);
+		MAC_ATS_AUXTSHI_RD(sec);
+		ns = ((u64)sec * 1000000000ULL) + nsec;
+
+		pdata->xstats.aux_ts_captured_n++;
+		if (pdata->aux_ts_last_ns) {
+			u64 interval = ns - pdata->aux_ts_last_ns;
+
+			if (!pdata->xstats.aux_ts_interval_min_ns ||
+			    interval < pdata->xstats.aux_ts_interval_min_ns)
+				pdata->xstats.aux_ts_interval_min_ns = interval;
+			if (interval > pdata->xstats.aux_ts_interval_max_ns)
+				pdata->xstats.aux_ts_interval_max_ns = interval;
+		}
+		pdata->aux_ts_last_ns = ns;
+
+		if (aux_ts_decimation > 1 &&
+		    (pdata->aux_ts_seen++ % aux_ts_decimation))
+			continue;
+
+		/* the FIFO does not record which trigger input captured
+		 * the snapshot, so all events are reported on channel 0
+		 */
+		event.type = PTP_CLOCK_EXTTS;
+		event.index = 0;
+		event.timestamp = ns;
+		ptp_clock_event(pdata->ptp_clock, &event);
+		pdata->xstats.aux_ts_delivered_n++;
+	}
 }
 
 /* structure describing a PTP hardware clock */
@@ -299,6 +404,9 @@ int eqos_ptp_init(struct eqos_prv_data *pdata)
 
 	pdata->ptp_clock_ops = eqos_ptp_clock_ops;
 
+	/* one EXTTS channel per auxiliary snapshot trigger input */
+	pdata->ptp_clock_ops.n_ext_ts = pdata->hw_feat.aux_snap_num;
+
 	pdata->ptp_clock =
 	    ptp_clock_register(&pdata->ptp_clock_ops, &pdata->pdev->dev);
 	if (IS_ERR(pdata->ptp_clock)) {
@@ -920,13 +920,16 @@ struct hw_if_struct {
 	VOID(*config_ptp_channel)(UINT, UINT);
 };
 
-/* wrapper buffer structure to hold transmit pkt details */
+/* wrapper buffer structure to hold transmit pkt details.
+ * Cache-line aligned so that each entry occupies its own line; the
+ * per-descriptor state is touched from both the xmit and completion
+ * paths and must not straddle or share lines. */
 struct tx_swcx_desc {
 	dma_addr_t dma;		/* dma address of skb */
 	struct sk_buff *skb;	/* virtual address of skb */
 	unsigned short len;	/* length of fragment */
 	unsigned char buf1_mapped_as_page;
-};
+} ____cacheline_aligned;
 
 struct tx_ring {
 	char *desc_name;	/* ID of descriptor */
@@ -960,6 +963,10 @@ struct tx_ring {
 	/* for TSO */
 	u32 default_mss;
 	bool tx_full;
+
+	/* for xmit_more doorbell batching */
+	u32 defer_doorbell;
+	u32 doorbell_pending;
 };
 
 struct eqos_tx_queue {
@@ -972,13 +979,14 @@ struct eqos_tx_queue {
 	bool slot_num_check;
 };
 
-/* wrapper buffer structure to hold received pkt details */
+/* wrapper buffer structure to hold received pkt details.
+ * Cache-line aligned for the same reason as struct tx_swcx_desc. */
 struct rx_swcx_desc {
 	dma_addr_t dma;		/* dma address of skb */
 	struct sk_buff *skb;	/* virtual address of skb */
 	bool inte;	/* set to non-zero if INTE is set for
 				corresponding desc */
-};
+} ____cacheline_aligned;
 
 struct rx_ring {
 	char *desc_name;	/* ID of descriptor */
@@ -1240,6 +1248,7 @@ struct eqos_extra_stats {
 	unsigned long rx_normal_irq_n[8];
 	unsigned long napi_poll_n;
 	unsigned long tx_clean_n[8];
+	unsigned long tx_wmark_reclaim_n[8];
 	/* EEE */
 	unsigned long tx_path_in_lpi_mode_irq_n;
 	unsigned long tx_path_exit_lpi_mode_irq_n;
@@ -1252,6 +1261,10 @@ struct eqos_extra_stats {
 	unsigned long rx_vlan_pkt_n;
 	unsigned long tx_timestamp_captured_n;
 	unsigned long rx_timestamp_captured_n;
+	unsigned long aux_ts_captured_n;
+	unsigned long aux_ts_delivered_n;
+	unsigned long aux_ts_interval_min_ns;
+	unsigned long aux_ts_interval_max_ns;
 	unsigned long tx_tso_pkt_n;
 
 	/* Tx/Rx frames per channels/queues */
@@ -1444,6 +1457,9 @@ struct eqos_prv_data {
 	unsigned int default_addend;
 	bool one_nsec_accuracy; /* set to 1 if one nano second accuracy
 				   is enabled else set to zero */
+	/* auxiliary snapshot decimation state */
+	unsigned int aux_ts_seen;
+	u64 aux_ts_last_ns;
 
 	bool suspended;
 	/* for filtering */
@@ -1583,6 +1599,7 @@ void eqos_mmc_read(struct eqos_mmc_counters *mmc);
 
 int eqos_ptp_init(struct eqos_prv_data *pdata);
 void eqos_ptp_remove(struct eqos_prv_data *pdata);
+void eqos_ptp_aux_ts_irq(struct eqos_prv_data *pdata);
 bool eqos_eee_init(struct eqos_prv_data *pdata);
 void eqos_handle_eee_interrupt(struct eqos_prv_data *pdata);
 void eqos_disable_eee_mode(struct eqos_prv_data *pdata);
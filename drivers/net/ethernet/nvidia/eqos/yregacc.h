@@ -37646,6 +37646,9 @@ extern ULONG eqos_base_addr;
 #define MAC_ISR_LPI_LPOS 5
 #define MAC_ISR_LPI_HPOS 5
 
+#define MAC_ISR_TSIS_LPOS 12
+#define MAC_ISR_TSIS_HPOS 12
+
 #define GET_VALUE(data, lbit, hbit) ((data >> lbit) & (~(~0<<(hbit-lbit+1))))
 
 #define GET_INDEXED_VALUE(data, lbit, hbit, index)\
@@ -28,6 +28,9 @@ int ether_get_tx_ts(struct ether_priv_data *pdata)
 	struct osi_ioctl ioctl_data = {};
 	unsigned long long nsec = 0x0;
 	struct ether_tx_ts_skb_list *pnode;
+	unsigned long now_jiffies = jiffies;
+	LIST_HEAD(pending_list);
+	LIST_HEAD(done_list);
 	int ret = -1;
 	unsigned long flags;
 	bool pending = false;
@@ -37,13 +40,21 @@ int ether_get_tx_ts(struct ether_priv_data *pdata)
 		return 0;
 	}
 
-	if (list_empty(&pdata->tx_ts_skb_head)) {
+	/* Take over the whole pending list in one go so that per packet
+	 * timestamp lookups never contend with the transmit path for the
+	 * list lock.
+	 */
+	raw_spin_lock_irqsave(&pdata->txts_lock, flags);
+	list_splice_init(&pdata->tx_ts_skb_head, &pending_list);
+	raw_spin_unlock_irqrestore(&pdata->txts_lock, flags);
+
+	if (list_empty(&pending_list)) {
 		atomic_set(&pdata->tx_ts_ref_cnt, -1);
 		return 0;
 	}
 
 	list_for_each_safe(head_node, temp_head_node,
-			   &pdata->tx_ts_skb_head) {
+			   &pending_list) {
 		pnode = list_entry(head_node,
 				   struct ether_tx_ts_skb_list,
 				   list_head);
@@ -79,17 +90,42 @@ update_skb:
 				dev_consume_skb_any(pnode->skb);
 			}
 
-			raw_spin_lock_irqsave(&pdata->txts_lock, flags);
-			list_del(head_node);
-			pnode->in_use = OSI_DISABLE;
-			raw_spin_unlock_irqrestore(&pdata->txts_lock, flags);
+			pnode->skb = NULL;
+			list_move_tail(head_node, &done_list);
+		} else if ((jiffies_to_msecs(now_jiffies) -
+			    jiffies_to_msecs(pnode->pkt_jiffies)) >=
+			   ETHER_SECTOMSEC) {
+			dev_dbg(pdata->dev,
+				"%s() skb %p deleting for pktid = %x time=%lu\n",
+				__func__, pnode->skb, pnode->pktid,
+				pnode->pkt_jiffies);
+			if (pnode->skb != NULL) {
+				dev_consume_skb_any(pnode->skb);
+			}
 
+			pnode->skb = NULL;
+			list_move_tail(head_node, &done_list);
 		} else {
 			dev_dbg(pdata->dev, "Unable to retrieve TS from OSI\n");
 			pending = true;
 		}
 	}
 
+	/* Return matched/expired nodes to the free pool and park the rest
+	 * back on the pending list with a single lock round trip.
+	 */
+	raw_spin_lock_irqsave(&pdata->txts_lock, flags);
+	list_for_each_safe(head_node, temp_head_node, &done_list) {
+		pnode = list_entry(head_node,
+				   struct ether_tx_ts_skb_list,
+				   list_head);
+		pnode->in_use = OSI_DISABLE;
+		list_move_tail(head_node, &pdata->tx_ts_free_head);
+	}
+	/* Newer nodes may have been queued while draining - keep FIFO order */
+	list_splice(&pending_list, &pdata->tx_ts_skb_head);
+	raw_spin_unlock_irqrestore(&pdata->txts_lock, flags);
+
 	if (pending)
 		ret = -EAGAIN;
 
@@ -1386,6 +1422,29 @@ static irqreturn_t ether_common_isr(int irq, void *data)
 	return irq_ret;
 }
 
+/**
+ * @brief Spread a per-queue IRQ across online CPUs
+ *
+ * Algorithm: Pick a CPU for the given queue index with
+ * cpumask_local_spread() so that the per-queue MSI vectors land on
+ * different cores, and publish it as the IRQ affinity hint.
+ *
+ * @param[in] pdata: OS dependent private data structure.
+ * @param[in] irq: Linux IRQ number.
+ * @param[in] mask: Per-IRQ cpumask storage (must stay valid while the
+ *		    hint is set).
+ * @param[in] idx: Queue/vector index used for spreading.
+ */
+static void ether_set_irq_affinity(struct ether_priv_data *pdata, int irq,
+				   cpumask_t *mask, unsigned int idx)
+{
+	unsigned int cpu = cpumask_local_spread(idx, dev_to_node(pdata->dev));
+
+	cpumask_clear(mask);
+	cpumask_set_cpu(cpu, mask);
+	irq_set_affinity_hint(irq, mask);
+}
+
 /**
  * @brief Free IRQs
  *
@@ -1416,6 +1475,7 @@ static void ether_free_irqs(struct ether_priv_data *pdata)
 	    pdata->osi_core->mac == OSI_MAC_HW_MGBE) {
 		for (i = 0; i < pdata->osi_core->num_vm_irqs; i++) {
 			if (pdata->rx_irq_alloc_mask & (OSI_ENABLE << i)) {
+				irq_set_affinity_hint(pdata->vm_irqs[i], NULL);
 				devm_free_irq(pdata->dev, pdata->vm_irqs[i],
 					      &pdata->vm_irq_data[i]);
 			}
@@ -1425,12 +1485,14 @@ static void ether_free_irqs(struct ether_priv_data *pdata)
 			chan = pdata->osi_dma->dma_chans[i];
 
 			if (pdata->rx_irq_alloc_mask & (OSI_ENABLE << i)) {
+				irq_set_affinity_hint(pdata->rx_irqs[i], NULL);
 				devm_free_irq(pdata->dev, pdata->rx_irqs[i],
 					      pdata->rx_napi[chan]);
 				pdata->rx_irq_alloc_mask &=
 							(~(OSI_ENABLE << i));
 			}
 			if (pdata->tx_irq_alloc_mask & (OSI_ENABLE << i)) {
+				irq_set_affinity_hint(pdata->tx_irqs[i], NULL);
 				devm_free_irq(pdata->dev, pdata->tx_irqs[i],
 					      pdata->tx_napi[chan]);
 				pdata->tx_irq_alloc_mask &=
@@ -1601,6 +1663,9 @@ static int ether_request_irqs(struct ether_priv_data *pdata)
 			}
 
 			pdata->rx_irq_alloc_mask |= (OSI_ENABLE << i);
+
+			ether_set_irq_affinity(pdata, pdata->vm_irqs[i],
+					       &pdata->vm_irq_cpu_mask[i], i);
 		}
 	} else {
 		for (i = 0; i < osi_dma->num_dma_chans; i++) {
@@ -1622,6 +1687,9 @@ static int ether_request_irqs(struct ether_priv_data *pdata)
 
 			pdata->rx_irq_alloc_mask |= (OSI_ENABLE << i);
 
+			ether_set_irq_affinity(pdata, pdata->rx_irqs[i],
+					       &pdata->rx_irq_cpu_mask[i], i);
+
 			snprintf(pdata->irq_names[j], ETHER_IRQ_NAME_SZ, "%s.tx%d",
 				 netdev_name(pdata->ndev), chan);
 			ret = devm_request_irq(pdata->dev,
@@ -1638,6 +1706,9 @@ static int ether_request_irqs(struct ether_priv_data *pdata)
 			}
 
 			pdata->tx_irq_alloc_mask |= (OSI_ENABLE << i);
+
+			ether_set_irq_affinity(pdata, pdata->tx_irqs[i],
+					       &pdata->tx_irq_cpu_mask[i], i);
 		}
 	}
 
@@ -1693,6 +1764,9 @@ static void ether_napi_enable(struct ether_priv_data *pdata)
 	for (i = 0; i < osi_dma->num_dma_chans; i++) {
 		chan = osi_dma->dma_chans[i];
 
+		/* DMA (re)init cleared the HW Tx context state */
+		pdata->tx_napi[chan]->ctx_valid = OSI_DISABLE;
+
 		napi_enable(&pdata->tx_napi[chan]->napi);
 		napi_enable(&pdata->rx_napi[chan]->napi);
 	}
@@ -1709,7 +1783,8 @@ static void ether_napi_enable(struct ether_priv_data *pdata)
 static void ether_free_rx_skbs(struct osi_rx_swcx *rx_swcx,
 			       struct ether_priv_data *pdata,
 			       unsigned int rx_buf_len,
-			       void *resv_buf_virt_addr)
+			       void *resv_buf_virt_addr,
+			       unsigned int chan)
 {
 	struct osi_dma_priv_data *osi_dma = pdata->osi_dma;
 	struct osi_rx_swcx *prx_swcx = NULL;
@@ -1721,7 +1796,7 @@ static void ether_free_rx_skbs(struct osi_rx_swcx *rx_swcx,
 		if (prx_swcx->buf_virt_addr != NULL) {
 			if (resv_buf_virt_addr != prx_swcx->buf_virt_addr) {
 #ifdef ETHER_PAGE_POOL
-				page_pool_put_full_page(pdata->page_pool,
+				page_pool_put_full_page(pdata->page_pool[chan],
 							prx_swcx->buf_virt_addr,
 							false);
 #else
@@ -1759,7 +1834,8 @@ static void free_rx_dma_resources(struct osi_dma_priv_data *osi_dma,
 			if (rx_ring->rx_swcx != NULL) {
 				ether_free_rx_skbs(rx_ring->rx_swcx, pdata,
 						   osi_dma->rx_buf_len,
-						   osi_dma->resv_buf_virt_addr);
+						   osi_dma->resv_buf_virt_addr,
+						   i);
 				kfree(rx_ring->rx_swcx);
 			}
 
@@ -1774,9 +1850,17 @@ static void free_rx_dma_resources(struct osi_dma_priv_data *osi_dma,
 		}
 	}
 #ifdef ETHER_PAGE_POOL
-	if (pdata->page_pool) {
-		page_pool_destroy(pdata->page_pool);
-		pdata->page_pool = NULL;
+	for (i = 0; i < OSI_MGBE_MAX_NUM_CHANS; i++) {
+		if (pdata->page_pool[i]) {
+#ifdef ETHER_XDP
+			if (pdata->rx_napi[i] &&
+			    xdp_rxq_info_is_reg(&pdata->rx_napi[i]->xdp_rxq)) {
+				xdp_rxq_info_unreg(&pdata->rx_napi[i]->xdp_rxq);
+			}
+#endif
+			page_pool_destroy(pdata->page_pool[i]);
+			pdata->page_pool[i] = NULL;
+		}
 	}
 #endif
 }
@@ -1855,7 +1939,8 @@ err_rx_desc:
  * @retval "negative value" on failure.
  */
 static int ether_allocate_rx_buffers(struct ether_priv_data *pdata,
-				     struct osi_rx_ring *rx_ring)
+				     struct osi_rx_ring *rx_ring,
+				     unsigned int chan)
 {
 #ifndef ETHER_PAGE_POOL
 	unsigned int rx_buf_len = pdata->osi_dma->rx_buf_len;
@@ -1874,14 +1959,14 @@ static int ether_allocate_rx_buffers(struct ether_priv_data *pdata,
 		rx_swcx = rx_ring->rx_swcx + i;
 
 #ifdef ETHER_PAGE_POOL
-		page = page_pool_dev_alloc_pages(pdata->page_pool);
+		page = page_pool_dev_alloc_pages(pdata->page_pool[chan]);
 		if (!page) {
 			dev_err(pdata->dev,
 				"failed to allocate page pool buffer");
 			return -ENOMEM;
 		}
 
-		dma_addr = page_pool_get_dma_addr(page);
+		dma_addr = page_pool_get_dma_addr(page) + ETHER_XDP_HEADROOM;
 		rx_swcx->buf_virt_addr = page;
 #else
 		skb = __netdev_alloc_skb_ip_align(pdata->ndev, rx_buf_len,
@@ -1918,7 +2003,8 @@ static int ether_allocate_rx_buffers(struct ether_priv_data *pdata,
  * @retval 0 on success
  * @retval "negative value" on failure.
  */
-static int ether_page_pool_create(struct ether_priv_data *pdata)
+static int ether_page_pool_create(struct ether_priv_data *pdata,
+				  unsigned int chan)
 {
 	struct osi_dma_priv_data *osi_dma = pdata->osi_dma;
 	struct page_pool_params pp_params = { 0 };
@@ -1927,19 +2013,41 @@ static int ether_page_pool_create(struct ether_priv_data *pdata)
 
 	pp_params.flags = PP_FLAG_DMA_MAP;
 	pp_params.pool_size = osi_dma->rx_buf_len;
-	num_pages = DIV_ROUND_UP(osi_dma->rx_buf_len, PAGE_SIZE);
+	num_pages = DIV_ROUND_UP(osi_dma->rx_buf_len + ETHER_XDP_HEADROOM,
+				 PAGE_SIZE);
 	pp_params.order = ilog2(roundup_pow_of_two(num_pages));
 	pp_params.nid = dev_to_node(pdata->dev);
 	pp_params.dev = pdata->dev;
 	pp_params.dma_dir = DMA_FROM_DEVICE;
 
-	pdata->page_pool = page_pool_create(&pp_params);
-	if (IS_ERR(pdata->page_pool)) {
-		ret = PTR_ERR(pdata->page_pool);
-		pdata->page_pool = NULL;
+	pdata->page_pool[chan] = page_pool_create(&pp_params);
+	if (IS_ERR(pdata->page_pool[chan])) {
+		ret = PTR_ERR(pdata->page_pool[chan]);
+		pdata->page_pool[chan] = NULL;
 		return ret;
 	}
 
+#ifdef ETHER_XDP
+	ret = xdp_rxq_info_reg(&pdata->rx_napi[chan]->xdp_rxq, pdata->ndev,
+			       chan, pdata->rx_napi[chan]->napi.napi_id);
+	if (ret < 0) {
+		goto err_destroy_pool;
+	}
+
+	ret = xdp_rxq_info_reg_mem_model(&pdata->rx_napi[chan]->xdp_rxq,
+					 MEM_TYPE_PAGE_POOL,
+					 pdata->page_pool[chan]);
+	if (ret < 0) {
+		xdp_rxq_info_unreg(&pdata->rx_napi[chan]->xdp_rxq);
+		goto err_destroy_pool;
+	}
+
+	return 0;
+
+err_destroy_pool:
+	page_pool_destroy(pdata->page_pool[chan]);
+	pdata->page_pool[chan] = NULL;
+#endif
 	return ret;
 }
 #endif
@@ -1965,18 +2073,18 @@ static int ether_allocate_rx_dma_resources(struct osi_dma_priv_data *osi_dma,
 	unsigned int i;
 	int ret = 0;
 
-#ifdef ETHER_PAGE_POOL
-	ret = ether_page_pool_create(pdata);
-	if (ret < 0) {
-		pr_err("%s(): failed to create page pool\n",
-		       __func__);
-		goto exit;
-	}
-#endif
 	for (i = 0; i < OSI_MGBE_MAX_NUM_CHANS; i++) {
 		chan = osi_dma->dma_chans[i];
 
 		if (chan != OSI_INVALID_CHAN_NUM) {
+#ifdef ETHER_PAGE_POOL
+			ret = ether_page_pool_create(pdata, chan);
+			if (ret < 0) {
+				pr_err("%s(): failed to create page pool for chan %u\n",
+				       __func__, chan);
+				goto exit;
+			}
+#endif
 			ret = allocate_rx_dma_resource(osi_dma, pdata->dev,
 						       chan);
 			if (ret != 0) {
@@ -1984,7 +2092,8 @@ static int ether_allocate_rx_dma_resources(struct osi_dma_priv_data *osi_dma,
 			}
 
 			ret = ether_allocate_rx_buffers(pdata,
-							osi_dma->rx_ring[chan]);
+							osi_dma->rx_ring[chan],
+							chan);
 			if (ret < 0) {
 				goto exit;
 			}
@@ -2822,8 +2931,9 @@ static inline void ether_flush_tx_ts_skb_list(struct ether_priv_data *pdata)
 					   struct ether_tx_ts_skb_list,
 					   list_head);
 			dev_kfree_skb(pnode->skb);
-			list_del(head_node);
+			pnode->skb = NULL;
 			pnode->in_use = OSI_DISABLE;
+			list_move_tail(head_node, &pdata->tx_ts_free_head);
 		}
 	}
 	raw_spin_unlock_irqrestore(&pdata->txts_lock, flags);
@@ -2899,6 +3009,7 @@ static int ether_close(struct net_device *ndev)
 			atomic_set(&pdata->tx_napi[chan]->tx_usecs_timer_armed,
 				   OSI_DISABLE);
 		}
+		hrtimer_cancel(&pdata->rx_napi[chan]->dim_timer);
 	}
 
 	/* Delete MAC filters */
@@ -3060,6 +3171,7 @@ static void ether_tx_swcx_rollback(struct ether_priv_data *pdata,
  * OSI layer for data transmission and buffer cleanup.
  *
  * @param[in] dev: device instance associated with driver.
+ * @param[in] tx_napi: Tx NAPI instance associated with channel number.
  * @param[in] tx_ring: Tx ring instance associated with channel number.
  * @param[in] skb: socket buffer.
  *
@@ -3067,6 +3179,7 @@ static void ether_tx_swcx_rollback(struct ether_priv_data *pdata,
  * @retval "negative value"  on failure.
  */
 static int ether_tx_swcx_alloc(struct ether_priv_data *pdata,
+			       struct ether_tx_napi *tx_napi,
 			       struct osi_tx_ring *tx_ring,
 			       struct sk_buff *skb)
 {
@@ -3075,6 +3188,8 @@ static int ether_tx_swcx_alloc(struct ether_priv_data *pdata,
 	struct osi_tx_swcx *tx_swcx = NULL;
 	struct device *dev = pdata->dev;
 	unsigned int len = 0, offset = 0, size = 0;
+	unsigned int ctx_desc = OSI_DISABLE;
+	unsigned long val;
 	int cnt = 0, ret = 0, i, num_frags;
 #if (KERNEL_VERSION(5, 4, 0) <= LINUX_VERSION_CODE)
 	skb_frag_t *frag;
@@ -3123,14 +3238,34 @@ static int ether_tx_swcx_alloc(struct ether_priv_data *pdata,
 	      ((pdata->osi_core->mac == OSI_MAC_HW_MGBE) ||
 	       ((pdata->osi_dma->ptp_flag & OSI_PTP_SYNC_ONESTEP) ==
 		OSI_PTP_SYNC_ONESTEP)))) {
-		tx_swcx = tx_ring->tx_swcx + cur_tx_idx;
-		if (tx_swcx->len) {
-			return 0;
-		}
+		/* HW retains the MSS/VLAN tag programmed by the last
+		 * context descriptor on this channel, so a packet whose
+		 * context matches the previous one on the same channel can
+		 * reuse it. PTP packets always get a fresh context
+		 * descriptor since it also carries timestamp state.
+		 */
+		if (((tx_pkt_cx->flags & OSI_PKT_CX_PTP) != OSI_PKT_CX_PTP) &&
+		    (tx_napi->ctx_valid == OSI_ENABLE) &&
+		    (tx_napi->ctx_flags ==
+		     (tx_pkt_cx->flags &
+		      (OSI_PKT_CX_VLAN | OSI_PKT_CX_TSO))) &&
+		    (tx_napi->ctx_mss == tx_pkt_cx->mss) &&
+		    (tx_napi->ctx_vtag == tx_pkt_cx->vtag_id)) {
+			val = pdata->xstats.tx_ctx_desc_skip_n[tx_napi->chan];
+			pdata->xstats.tx_ctx_desc_skip_n[tx_napi->chan] =
+				osi_update_stats_counter(val, 1U);
+		} else {
+			tx_swcx = tx_ring->tx_swcx + cur_tx_idx;
+			if (tx_swcx->len) {
+				return 0;
+			}
 
-		tx_swcx->len = -1;
-		cnt++;
-		INCR_TX_DESC_INDEX(cur_tx_idx, pdata->osi_dma->tx_ring_sz);
+			tx_swcx->len = -1;
+			cnt++;
+			ctx_desc = OSI_ENABLE;
+			INCR_TX_DESC_INDEX(cur_tx_idx,
+					   pdata->osi_dma->tx_ring_sz);
+		}
 	}
 
 	if ((tx_pkt_cx->flags & OSI_PKT_CX_TSO) == OSI_PKT_CX_TSO) {
@@ -3250,6 +3385,20 @@ static int ether_tx_swcx_alloc(struct ether_priv_data *pdata,
 	tx_swcx->buf_virt_addr = skb;
 	tx_pkt_cx->desc_cnt = cnt;
 
+	/* All descriptors are filled now, so the context descriptor (if
+	 * any) is guaranteed to reach HW. Remember what it programs so
+	 * that identical follow-up packets can skip theirs. For a PTP-only
+	 * context this caches zero MSS/VLAN, forcing the next TSO/VLAN
+	 * packet to program a fresh context descriptor.
+	 */
+	if (ctx_desc == OSI_ENABLE) {
+		tx_napi->ctx_flags = tx_pkt_cx->flags &
+				     (OSI_PKT_CX_VLAN | OSI_PKT_CX_TSO);
+		tx_napi->ctx_mss = tx_pkt_cx->mss;
+		tx_napi->ctx_vtag = tx_pkt_cx->vtag_id;
+		tx_napi->ctx_valid = OSI_ENABLE;
+	}
+
 	return cnt;
 
 desc_not_free:
@@ -3334,7 +3483,8 @@ static int ether_start_xmit(struct sk_buff *skb, struct net_device *ndev)
 	int count = 0;
 	int ret;
 
-	count = ether_tx_swcx_alloc(pdata, tx_ring, skb);
+	count = ether_tx_swcx_alloc(pdata, pdata->tx_napi[chan], tx_ring,
+				    skb);
 	if (count <= 0) {
 		if (count == 0) {
 			netif_stop_subqueue(ndev, qinx);
@@ -3350,6 +3500,10 @@ static int ether_start_xmit(struct sk_buff *skb, struct net_device *ndev)
 	if (ret < 0) {
 		INCR_TX_DESC_INDEX(cur_tx_idx, count);
 		ether_tx_swcx_rollback(pdata, tx_ring, cur_tx_idx, count);
+		/* Rolled back descriptors never reached HW, so the context
+		 * cached by ether_tx_swcx_alloc() is not in HW either.
+		 */
+		pdata->tx_napi[chan]->ctx_valid = OSI_DISABLE;
 		netdev_err(ndev, "%s() dropping corrupted skb\n", __func__);
 		dev_kfree_skb_any(skb);
 		return NETDEV_TX_OK;
@@ -4141,6 +4295,72 @@ static int ether_setup_tc(struct net_device *ndev, enum tc_setup_type type,
 }
 #endif
 
+#ifdef ETHER_XDP
+/**
+ * @brief Attach/detach an XDP program.
+ *
+ * Algorithm: Validate that a received frame plus the XDP headroom and
+ * the skb shared info still fit the page pool buffer, then swap the
+ * program pointer. The Rx path picks the new program up on the next
+ * packet; no ring restart is needed since the headroom is always
+ * reserved on page pool buffers.
+ *
+ * @param[in] pdata: OSD private data.
+ * @param[in] prog: BPF program to attach, NULL to detach.
+ * @param[in] extack: Netlink extended ack for error reporting.
+ *
+ * @retval 0 on success
+ * @retval "negative value" on failure.
+ */
+static int ether_xdp_setup(struct ether_priv_data *pdata,
+			   struct bpf_prog *prog,
+			   struct netlink_ext_ack *extack)
+{
+	struct osi_dma_priv_data *osi_dma = pdata->osi_dma;
+	unsigned int num_pages = DIV_ROUND_UP(osi_dma->rx_buf_len +
+					      ETHER_XDP_HEADROOM, PAGE_SIZE);
+	unsigned int buf_sz = PAGE_SIZE <<
+			      ilog2(roundup_pow_of_two(num_pages));
+	struct bpf_prog *old_prog;
+
+	if (prog != NULL &&
+	    (ETHER_XDP_HEADROOM + osi_dma->rx_buf_len +
+	     SKB_DATA_ALIGN(sizeof(struct skb_shared_info))) > buf_sz) {
+		NL_SET_ERR_MSG_MOD(extack,
+				   "Rx buffer too large for XDP headroom");
+		return -EOPNOTSUPP;
+	}
+
+	old_prog = xchg(&pdata->xdp_prog, prog);
+	if (old_prog != NULL) {
+		bpf_prog_put(old_prog);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Network stack XDP hook.
+ *
+ * @param[in] ndev: Network device instance.
+ * @param[in] bpf: XDP command and arguments.
+ *
+ * @retval 0 on success
+ * @retval "negative value" on failure.
+ */
+static int ether_xdp(struct net_device *ndev, struct netdev_bpf *bpf)
+{
+	struct ether_priv_data *pdata = netdev_priv(ndev);
+
+	switch (bpf->command) {
+	case XDP_SETUP_PROG:
+		return ether_xdp_setup(pdata, bpf->prog, bpf->extack);
+	default:
+		return -EINVAL;
+	}
+}
+#endif
+
 /**
  * @brief Ethernet network device operations
  */
@@ -4159,13 +4379,95 @@ static const struct net_device_ops ether_netdev_ops = {
 #if (KERNEL_VERSION(5, 10, 0) <= LINUX_VERSION_CODE)
 	.ndo_setup_tc = ether_setup_tc,
 #endif
+#ifdef ETHER_XDP
+	.ndo_bpf = ether_xdp,
+#endif
 };
 
+/** Interrupt hold-off profiles walked by the adaptive RX engine (usec) */
+static const unsigned int ether_rx_dim_usecs[] = { 0U, 16U, 32U, 64U, 128U,
+						   256U };
+
+/** Busy polls needed before stepping one profile up */
+#define ETHER_RX_DIM_BUSY_POLLS		4U
+/** Idle polls needed before stepping one profile down */
+#define ETHER_RX_DIM_IDLE_POLLS		16U
+/** Highest valid index into ether_rx_dim_usecs */
+#define ETHER_RX_DIM_MAX_LEVEL	(ARRAY_SIZE(ether_rx_dim_usecs) - 1U)
+
+/**
+ * @brief SW timer to re-enable RX interrupts after the hold-off period.
+ *
+ * Algorithm: While the timer was pending the channel interrupt stayed
+ * masked, so packets batched up in the ring. Unmasking here fires the
+ * IRQ immediately if work is already pending.
+ *
+ * @param[in] data: hr timer instance of the receive channel.
+ *
+ * @return HRTIMER_NORESTART
+ */
+static enum hrtimer_restart ether_rx_dim_hrtimer(struct hrtimer *data)
+{
+	struct ether_rx_napi *rx_napi = container_of(data, struct ether_rx_napi,
+						     dim_timer);
+	struct ether_priv_data *pdata = rx_napi->pdata;
+	unsigned long flags;
+
+	raw_spin_lock_irqsave(&pdata->rlock, flags);
+	osi_handle_dma_intr(pdata->osi_dma, rx_napi->chan,
+			    OSI_DMA_CH_RX_INTR,
+			    OSI_DMA_INTR_ENABLE);
+	raw_spin_unlock_irqrestore(&pdata->rlock, flags);
+
+	return HRTIMER_NORESTART;
+}
+
+/**
+ * @brief Walk the adaptive RX coalescing profile for a channel.
+ *
+ * Algorithm: Track how loaded the poll loop is. A run of busy polls
+ * moves the channel one profile up (longer interrupt hold-off), a run
+ * of idle polls moves it back down towards immediate interrupts.
+ *
+ * @param[in] rx_napi: Rx NAPI instance of the channel.
+ * @param[in] received: Number of packets handled by this poll.
+ * @param[in] budget: NAPI budget.
+ */
+static void ether_rx_dim_update(struct ether_rx_napi *rx_napi, int received,
+				int budget)
+{
+	if (received >= (budget / 2)) {
+		rx_napi->dim_idle_polls = 0U;
+		rx_napi->dim_busy_polls++;
+		if (rx_napi->dim_busy_polls >= ETHER_RX_DIM_BUSY_POLLS) {
+			rx_napi->dim_busy_polls = 0U;
+			if (rx_napi->dim_level < ETHER_RX_DIM_MAX_LEVEL) {
+				rx_napi->dim_level++;
+			}
+		}
+	} else if (received <= (budget / 8)) {
+		rx_napi->dim_busy_polls = 0U;
+		rx_napi->dim_idle_polls++;
+		if (rx_napi->dim_idle_polls >= ETHER_RX_DIM_IDLE_POLLS) {
+			rx_napi->dim_idle_polls = 0U;
+			if (rx_napi->dim_level > 0U) {
+				rx_napi->dim_level--;
+			}
+		}
+	} else {
+		/* moderate load, keep the current profile */
+	}
+
+	rx_napi->dim_usecs = ether_rx_dim_usecs[rx_napi->dim_level];
+}
+
 /**
  * @brief NAPI poll handler for receive.
  *
  * Algorithm: Invokes OSI layer to read data from HW and pass onto the
- * Linux network stack.
+ * Linux network stack. With adaptive coalescing enabled on the channel,
+ * interrupt re-enable is deferred by the current profile hold-off so
+ * that busy channels take fewer interrupts.
  *
  * @param[in] napi: NAPI instance for Rx NAPI.
  * @param[in] budget: NAPI budget.
@@ -4187,13 +4489,33 @@ static int ether_napi_poll_rx(struct napi_struct *napi, int budget)
 
 	received = osi_process_rx_completions(osi_dma, chan, budget,
 					      &more_data_avail);
+
+#ifdef ETHER_XDP
+	/* flush redirect queues filled while processing completions */
+	if (READ_ONCE(pdata->xdp_prog) != NULL) {
+		xdp_do_flush();
+	}
+#endif
+
+	if (rx_napi->use_adaptive == OSI_ENABLE) {
+		ether_rx_dim_update(rx_napi, received, budget);
+	}
+
 	if (received < budget) {
 		napi_complete(napi);
-		raw_spin_lock_irqsave(&pdata->rlock, flags);
-		osi_handle_dma_intr(osi_dma, chan,
-				    OSI_DMA_CH_RX_INTR,
-				    OSI_DMA_INTR_ENABLE);
-		raw_spin_unlock_irqrestore(&pdata->rlock, flags);
+		if (rx_napi->use_adaptive == OSI_ENABLE &&
+		    rx_napi->dim_usecs != 0U) {
+			/* hold the interrupt off so further packets batch up */
+			hrtimer_start(&rx_napi->dim_timer,
+				      rx_napi->dim_usecs * NSEC_PER_USEC,
+				      HRTIMER_MODE_REL);
+		} else {
+			raw_spin_lock_irqsave(&pdata->rlock, flags);
+			osi_handle_dma_intr(osi_dma, chan,
+					    OSI_DMA_CH_RX_INTR,
+					    OSI_DMA_INTR_ENABLE);
+			raw_spin_unlock_irqrestore(&pdata->rlock, flags);
+		}
 	}
 
 	return received;
@@ -6465,7 +6787,7 @@ static int ether_probe(struct platform_device *pdev)
 		goto err_dma_mask;
 	}
 
-	/* Setup the tx_usecs timer */
+	/* Setup the tx_usecs timer and the adaptive RX coalescing timer */
 	for (i = 0; i < osi_dma->num_dma_chans; i++) {
 		chan = osi_dma->dma_chans[i];
 		atomic_set(&pdata->tx_napi[chan]->tx_usecs_timer_armed,
@@ -6474,6 +6796,10 @@ static int ether_probe(struct platform_device *pdev)
 			     CLOCK_MONOTONIC, HRTIMER_MODE_REL);
 		pdata->tx_napi[chan]->tx_usecs_timer.function =
 			ether_tx_usecs_hrtimer;
+		hrtimer_init(&pdata->rx_napi[chan]->dim_timer,
+			     CLOCK_MONOTONIC, HRTIMER_MODE_REL);
+		pdata->rx_napi[chan]->dim_timer.function =
+			ether_rx_dim_hrtimer;
 	}
 
 	ret = register_netdev(ndev);
@@ -6535,6 +6861,11 @@ static int ether_probe(struct platform_device *pdev)
 	INIT_DELAYED_WORK(&pdata->set_speed_work, set_speed_work_func);
 	osi_core->hw_feature = &pdata->hw_feat;
 	INIT_LIST_HEAD(&pdata->tx_ts_skb_head);
+	INIT_LIST_HEAD(&pdata->tx_ts_free_head);
+	for (i = 0; i < ETHER_MAX_PENDING_SKB_CNT; i++) {
+		list_add_tail(&pdata->tx_ts_skb[i].list_head,
+			      &pdata->tx_ts_free_head);
+	}
 	INIT_DELAYED_WORK(&pdata->tx_ts_work, ether_get_tx_ts_work);
 	pdata->rx_m_enabled = false;
 	pdata->rx_pcs_m_enabled = false;
@@ -6698,10 +7029,17 @@ static int ether_resume(struct ether_priv_data *pdata)
 	}
 	osi_set_rx_buf_len(osi_dma);
 
-	ret = ether_allocate_dma_resources(pdata);
-	if (ret < 0) {
-		dev_err(dev, "failed to allocate dma resources\n");
-		return ret;
+	/* Warm resume: rings, Rx buffers and their DMA mappings survived
+	 * suspend, so only the descriptor contents need re-initialization
+	 * by osi_hw_dma_init() below. Allocate only when coming up cold,
+	 * e.g. after a failed suspend freed the resources.
+	 */
+	if (osi_dma->tx_ring[osi_dma->dma_chans[0]] == NULL) {
+		ret = ether_allocate_dma_resources(pdata);
+		if (ret < 0) {
+			dev_err(dev, "failed to allocate dma resources\n");
+			return ret;
+		}
 	}
 
 	ioctl_data.cmd =  OSI_CMD_RESUME;
@@ -6759,6 +7097,61 @@ err_resume:
 	return ret;
 }
 
+/**
+ * @brief Drop packets left on the Tx rings across suspend.
+ *
+ * Alogorithm: Walk all Tx ring software context entries and release
+ * any buffer the hardware had not completed before DMA was stopped,
+ * so the ring allocations can stay across suspend and be re-programmed
+ * warm on resume without leaking the in-flight skbs.
+ *
+ * @param[in] pdata: OS dependent private data structure.
+ */
+static void ether_drain_tx_rings(struct ether_priv_data *pdata)
+{
+	struct osi_dma_priv_data *osi_dma = pdata->osi_dma;
+	struct osi_tx_swcx *tx_swcx = NULL;
+	struct osi_tx_ring *tx_ring = NULL;
+	unsigned int i, j;
+
+	for (i = 0; i < OSI_MGBE_MAX_NUM_CHANS; i++) {
+		tx_ring = osi_dma->tx_ring[i];
+
+		if (tx_ring == NULL || tx_ring->tx_swcx == NULL)
+			continue;
+
+		for (j = 0; j < osi_dma->tx_ring_sz; j++) {
+			tx_swcx = tx_ring->tx_swcx + j;
+
+			if (tx_swcx->buf_phy_addr) {
+				if ((tx_swcx->flags & OSI_PKT_CX_PAGED_BUF) ==
+				    OSI_PKT_CX_PAGED_BUF) {
+					dma_unmap_page(pdata->dev,
+						       tx_swcx->buf_phy_addr,
+						       tx_swcx->len,
+						       DMA_TO_DEVICE);
+				} else {
+					dma_unmap_single(pdata->dev,
+							 tx_swcx->buf_phy_addr,
+							 tx_swcx->len,
+							 DMA_TO_DEVICE);
+				}
+				tx_swcx->buf_phy_addr = 0;
+			}
+
+			if (tx_swcx->buf_virt_addr != NULL) {
+				dev_kfree_skb_any((struct sk_buff *)
+						  tx_swcx->buf_virt_addr);
+				tx_swcx->buf_virt_addr = NULL;
+				pdata->ndev->stats.tx_dropped++;
+			}
+
+			tx_swcx->len = 0;
+			tx_swcx->flags = 0;
+		}
+	}
+}
+
 /**
  * @brief Ethernet platform driver suspend noirq callback.
  *
@@ -6836,7 +7229,11 @@ static int ether_suspend_noirq(struct device *dev)
 				    OSI_DMA_INTR_DISABLE);
 	}
 
-	free_dma_resources(pdata);
+	/* Packets still on the Tx rings are dropped; the ring, Rx buffer
+	 * and reserved buffer allocations with their DMA mappings stay
+	 * across suspend so resume only re-programs descriptors.
+	 */
+	ether_drain_tx_rings(pdata);
 
 	if (osi_core->mac == OSI_MAC_HW_MGBE)
 		pm_runtime_put_sync(pdata->dev);
@@ -59,6 +59,23 @@
 #define ETHER_PAGE_POOL
 #endif
 #endif
+#if defined(ETHER_PAGE_POOL) && (KERNEL_VERSION(5, 14, 0) <= LINUX_VERSION_CODE)
+#include <linux/bpf.h>
+#include <linux/bpf_trace.h>
+#include <linux/filter.h>
+#include <net/xdp.h>
+#define ETHER_XDP
+#endif
+/**
+ * @brief Headroom reserved in front of every page pool Rx buffer so an
+ * XDP program can adjust headers and redirected buffers can be converted
+ * to frames in place. Zero when XDP support is not compiled in.
+ */
+#ifdef ETHER_XDP
+#define ETHER_XDP_HEADROOM	XDP_PACKET_HEADROOM
+#else
+#define ETHER_XDP_HEADROOM	0U
+#endif
 #include <osi_core.h>
 #include <osi_dma.h>
 #include <mmc.h>
@@ -314,6 +331,14 @@ struct ether_tx_napi {
 	struct hrtimer tx_usecs_timer;
 	/** SW timer flag associated with transmit channel */
 	atomic_t tx_usecs_timer_armed;
+	/** TSO/VLAN flags carried by the last context descriptor */
+	unsigned int ctx_flags;
+	/** TSO MSS programmed by the last context descriptor */
+	unsigned int ctx_mss;
+	/** VLAN tag programmed by the last context descriptor */
+	unsigned int ctx_vtag;
+	/** Context cache valid flag, cleared on DMA (re)start */
+	unsigned int ctx_valid;
 };
 
 /**
@@ -326,6 +351,22 @@ struct ether_rx_napi {
 	struct ether_priv_data *pdata;
 	/** NAPI instance associated with transmit channel */
 	struct napi_struct napi;
+	/** Adaptive RX coalescing enable for this channel */
+	unsigned int use_adaptive;
+	/** Current index into the adaptive coalescing profile table */
+	unsigned int dim_level;
+	/** Interrupt hold-off of the current profile in usec */
+	unsigned int dim_usecs;
+	/** Consecutive busy polls, walks the profile up on overflow */
+	unsigned int dim_busy_polls;
+	/** Consecutive idle polls, walks the profile down on overflow */
+	unsigned int dim_idle_polls;
+	/** SW timer deferring interrupt re-enable on busy channels */
+	struct hrtimer dim_timer;
+#ifdef ETHER_XDP
+	/** XDP Rx queue info tied to this channel's page pool */
+	struct xdp_rxq_info xdp_rxq;
+#endif
 };
 
 /**
@@ -386,12 +427,24 @@ struct ether_xtra_stat_counters {
 	nveu64_t tx_normal_irq_n[OSI_MGBE_MAX_NUM_QUEUES];
 	/** TX per channel SW timer callback count */
 	nveu64_t tx_usecs_swtimer_n[OSI_MGBE_MAX_NUM_QUEUES];
+	/** TX per channel skipped context descriptor count */
+	nveu64_t tx_ctx_desc_skip_n[OSI_MGBE_MAX_NUM_QUEUES];
 	/** RX per channel interrupt count */
 	nveu64_t rx_normal_irq_n[OSI_MGBE_MAX_NUM_QUEUES];
 	/** link connect count */
 	nveu64_t link_connect_count;
 	/** link disconnect count */
 	nveu64_t link_disconnect_count;
+#ifdef ETHER_XDP
+	/** packets passed up the stack by the XDP program */
+	nveu64_t xdp_pass_n;
+	/** packets dropped by the XDP program */
+	nveu64_t xdp_drop_n;
+	/** packets redirected by the XDP program */
+	nveu64_t xdp_redirect_n;
+	/** redirects that failed and fell back to drop */
+	nveu64_t xdp_redirect_fail_n;
+#endif
 };
 
 /**
@@ -487,6 +540,12 @@ struct ether_priv_data {
 	int rx_irqs[ETHER_MAX_IRQS];
 	/** Array of VM IRQ numbers */
 	int vm_irqs[OSI_MAX_VM_IRQS];
+	/** CPU affinity masks used to spread Tx channel IRQs */
+	cpumask_t tx_irq_cpu_mask[ETHER_MAX_IRQS];
+	/** CPU affinity masks used to spread Rx channel IRQs */
+	cpumask_t rx_irq_cpu_mask[ETHER_MAX_IRQS];
+	/** CPU affinity masks used to spread VM IRQs */
+	cpumask_t vm_irq_cpu_mask[OSI_MAX_VM_IRQS];
 	/** IRQ name */
 	char irq_names[ETHER_IRQ_MAX_IDX][ETHER_IRQ_NAME_SZ];
 	/** memory allocation mask */
@@ -542,8 +601,12 @@ struct ether_priv_data {
 	/** VM channel info data associated with VM IRQ */
 	struct ether_vm_irq_data *vm_irq_data;
 #ifdef ETHER_PAGE_POOL
-	/** Pointer to page pool */
-	struct page_pool *page_pool;
+	/** Per-queue Rx buffer page pools, indexed by DMA channel */
+	struct page_pool *page_pool[OSI_MGBE_MAX_NUM_CHANS];
+#endif
+#ifdef ETHER_XDP
+	/** Attached XDP program, NULL when none is loaded */
+	struct bpf_prog *xdp_prog;
 #endif
 #ifdef CONFIG_DEBUG_FS
 	/** Debug fs directory pointer */
@@ -565,6 +628,8 @@ struct ether_priv_data {
 	struct delayed_work tx_ts_work;
 	/** local skb list head */
 	struct list_head tx_ts_skb_head;
+	/** free node list head for pre allocated tx_ts_skb entries */
+	struct list_head tx_ts_free_head;
 	/** pre allocated memory for ether_tx_ts_skb_list list */
 	struct ether_tx_ts_skb_list tx_ts_skb[ETHER_MAX_PENDING_SKB_CNT];
 	/** Atomic variable to hold the current pad calibration status */
@@ -17,6 +17,13 @@
 #include "ether_linux.h"
 
 #if (KERNEL_VERSION(5, 10, 0) <= LINUX_VERSION_CODE)
+/* Lead time (in ns) given to the MAC to latch the shadow GCL before the
+ * list switch boundary. A stale base time is advanced by whole cycles
+ * past this point so that the switch-over never happens mid-cycle.
+ */
+#define ETHER_EST_SWAP_LEAD_TIME_NS	(100U * 1000U)
+
+
 int ether_tc_setup_taprio(struct ether_priv_data *pdata,
 			  struct tc_taprio_qopt_offload *qopt)
 {
@@ -34,6 +41,9 @@ int ether_tc_setup_taprio(struct ether_priv_data *pdata,
 	/* time is 24 bit long */
 	unsigned int wid = 24U;
 	struct timespec64 time;
+	unsigned int sec = 0, nsec = 0;
+	u64 now_ns, base_ns, cycles;
+	unsigned long flags;
 	unsigned long ctr;
 	int i, ret = 0;
 
@@ -114,10 +124,30 @@ int ether_tc_setup_taprio(struct ether_priv_data *pdata,
 		}
 	}
 
-	/* Adjust for real system time TODO better to have
-	 * some offset to avoid BTRE
+	/* The MAC latches the new GCL into its shadow bank and switches
+	 * lists when the base time expires. A base time in the past
+	 * raises a BTR error and forces an immediate mid-cycle switch,
+	 * which glitches traffic on runtime schedule updates. Advance a
+	 * stale base time by whole cycles so that the swap always lands
+	 * on a future PTP-aligned cycle boundary.
 	 */
-	time = ktime_to_timespec64(qopt->base_time);
+	raw_spin_lock_irqsave(&pdata->ptp_lock, flags);
+	ret = osi_dma_get_systime_from_mac(pdata->osi_dma, &sec, &nsec);
+	raw_spin_unlock_irqrestore(&pdata->ptp_lock, flags);
+	if (ret != 0) {
+		netdev_err(pdata->ndev, "failed to read MAC system time\n");
+		goto done;
+	}
+
+	now_ns = ((u64)sec * OSI_NSEC_PER_SEC) + nsec;
+	base_ns = (u64)qopt->base_time;
+	if (base_ns < (now_ns + ETHER_EST_SWAP_LEAD_TIME_NS)) {
+		cycles = div64_u64(now_ns + ETHER_EST_SWAP_LEAD_TIME_NS -
+				   base_ns, qopt->cycle_time) + 1U;
+		base_ns += cycles * qopt->cycle_time;
+	}
+
+	time = ns_to_timespec64(base_ns);
 	est_ioctl_data.est.btr[0] = (unsigned int)time.tv_nsec;
 	est_ioctl_data.est.btr[1] = (unsigned int)time.tv_sec;
 	est_ioctl_data.est.btr_offset[0] = 0;
@@ -177,6 +207,7 @@ int ether_tc_setup_cbs(struct ether_priv_data *pdata,
 	struct osi_core_priv_data *osi_core = pdata->osi_core;
 	struct phy_device *phydev = pdata->phydev;
 	struct osi_ioctl ioctl_data = {};
+	struct osi_ioctl get_data = {};
 	int queue = qopt->queue;
 	unsigned int multiplier, speed_div;
 	unsigned long  value;
@@ -249,6 +280,27 @@ int ether_tc_setup_cbs(struct ether_priv_data *pdata,
 	value = qopt->locredit * 1024ll * 8;
 	ioctl_data.avb.low_credit = (unsigned long)value;
 
+	/* Fetch the currently programmed parameters first: a repeat of
+	 * the same configuration returns without touching the MAC, and
+	 * an idle-slope change on a live queue goes down as a single
+	 * SET without a disable/re-enable cycle in between.
+	 */
+	get_data.avb.qindex = (unsigned int)queue;
+	get_data.avb.tcindex = (unsigned int)queue;
+	get_data.cmd = OSI_CMD_GET_AVB;
+	if (osi_handle_ioctl(osi_core, &get_data) == 0) {
+		if ((get_data.avb.algo == ioctl_data.avb.algo) &&
+		    (get_data.avb.oper_mode == ioctl_data.avb.oper_mode) &&
+		    (get_data.avb.credit_control ==
+		     ioctl_data.avb.credit_control) &&
+		    (get_data.avb.idle_slope == ioctl_data.avb.idle_slope) &&
+		    (get_data.avb.send_slope == ioctl_data.avb.send_slope) &&
+		    (get_data.avb.hi_credit == ioctl_data.avb.hi_credit) &&
+		    (get_data.avb.low_credit == ioctl_data.avb.low_credit)) {
+			return 0;
+		}
+	}
+
 	ioctl_data.cmd = OSI_CMD_SET_AVB;
 
 	return osi_handle_ioctl(osi_core, &ioctl_data);
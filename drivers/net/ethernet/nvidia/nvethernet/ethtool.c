@@ -219,6 +219,16 @@ static const struct ether_stats ether_gstrings_stats[] = {
 	ETHER_EXTRA_STAT(tx_usecs_swtimer_n[7]),
 	ETHER_EXTRA_STAT(tx_usecs_swtimer_n[8]),
 	ETHER_EXTRA_STAT(tx_usecs_swtimer_n[9]),
+	ETHER_EXTRA_STAT(tx_ctx_desc_skip_n[0]),
+	ETHER_EXTRA_STAT(tx_ctx_desc_skip_n[1]),
+	ETHER_EXTRA_STAT(tx_ctx_desc_skip_n[2]),
+	ETHER_EXTRA_STAT(tx_ctx_desc_skip_n[3]),
+	ETHER_EXTRA_STAT(tx_ctx_desc_skip_n[4]),
+	ETHER_EXTRA_STAT(tx_ctx_desc_skip_n[5]),
+	ETHER_EXTRA_STAT(tx_ctx_desc_skip_n[6]),
+	ETHER_EXTRA_STAT(tx_ctx_desc_skip_n[7]),
+	ETHER_EXTRA_STAT(tx_ctx_desc_skip_n[8]),
+	ETHER_EXTRA_STAT(tx_ctx_desc_skip_n[9]),
 	ETHER_EXTRA_STAT(rx_normal_irq_n[0]),
 	ETHER_EXTRA_STAT(rx_normal_irq_n[1]),
 	ETHER_EXTRA_STAT(rx_normal_irq_n[2]),
@@ -231,6 +241,12 @@ static const struct ether_stats ether_gstrings_stats[] = {
 	ETHER_EXTRA_STAT(rx_normal_irq_n[9]),
 	ETHER_EXTRA_STAT(link_disconnect_count),
 	ETHER_EXTRA_STAT(link_connect_count),
+#ifdef ETHER_XDP
+	ETHER_EXTRA_STAT(xdp_pass_n),
+	ETHER_EXTRA_STAT(xdp_drop_n),
+	ETHER_EXTRA_STAT(xdp_redirect_n),
+	ETHER_EXTRA_STAT(xdp_redirect_fail_n),
+#endif
 };
 
 /**
@@ -1102,6 +1118,82 @@ static int ether_get_coalesce(struct net_device *dev,
 	return 0;
 }
 
+/**
+ * @brief Get per-queue interrupt coalescing parameters.
+ *
+ * Algorithm: Reports the state of the software adaptive RX coalescing
+ * engine for the given receive channel: whether it is enabled and the
+ * interrupt hold-off of the profile it currently sits on.
+ *
+ * @param[in] dev: Net device data.
+ * @param[in] queue: Receive channel number.
+ * @param[in] ec: pointer to ethtool_coalesce structure
+ *
+ * @retval 0 on Success.
+ * @retval "negative value" on failure.
+ */
+static int ether_get_per_queue_coalesce(struct net_device *dev, u32 queue,
+					struct ethtool_coalesce *ec)
+{
+	struct ether_priv_data *pdata = netdev_priv(dev);
+	struct ether_rx_napi *rx_napi;
+
+	if (queue >= OSI_MGBE_MAX_NUM_CHANS ||
+	    pdata->rx_napi[queue] == NULL) {
+		return -EINVAL;
+	}
+
+	rx_napi = pdata->rx_napi[queue];
+
+	memset(ec, 0, sizeof(struct ethtool_coalesce));
+	ec->use_adaptive_rx_coalesce = rx_napi->use_adaptive;
+	ec->rx_coalesce_usecs = rx_napi->dim_usecs;
+
+	return 0;
+}
+
+/**
+ * @brief Set per-queue interrupt coalescing parameters.
+ *
+ * Algorithm: Only the adaptive RX flag is tunable per channel; the
+ * static HW coalescing parameters stay global, see ether_set_coalesce().
+ * This lets a latency critical channel (e.g. PTP on channel 0) keep
+ * immediate interrupts while bulk channels walk the hold-off profiles.
+ *
+ * @param[in] dev: Net device data.
+ * @param[in] queue: Receive channel number.
+ * @param[in] ec: pointer to ethtool_coalesce structure
+ *
+ * @retval 0 on Success.
+ * @retval "negative value" on failure.
+ */
+static int ether_set_per_queue_coalesce(struct net_device *dev, u32 queue,
+					struct ethtool_coalesce *ec)
+{
+	struct ether_priv_data *pdata = netdev_priv(dev);
+	struct ether_rx_napi *rx_napi;
+
+	if (queue >= OSI_MGBE_MAX_NUM_CHANS ||
+	    pdata->rx_napi[queue] == NULL) {
+		return -EINVAL;
+	}
+
+	rx_napi = pdata->rx_napi[queue];
+
+	if (ec->use_adaptive_rx_coalesce != 0U) {
+		rx_napi->use_adaptive = OSI_ENABLE;
+	} else {
+		/* restart from the immediate interrupt profile */
+		rx_napi->use_adaptive = OSI_DISABLE;
+		rx_napi->dim_level = 0U;
+		rx_napi->dim_usecs = 0U;
+		rx_napi->dim_busy_polls = 0U;
+		rx_napi->dim_idle_polls = 0U;
+	}
+
+	return 0;
+}
+
 /*
  * @brief Get current EEE configuration in MAC/PHY
  *
@@ -1620,9 +1712,12 @@ static const struct ethtool_ops ether_ethtool_ops = {
 	.get_coalesce = ether_get_coalesce,
 #if KERNEL_VERSION(5, 5, 0) <= LINUX_VERSION_CODE
 	.supported_coalesce_params = (ETHTOOL_COALESCE_USECS |
-		ETHTOOL_COALESCE_MAX_FRAMES),
+		ETHTOOL_COALESCE_MAX_FRAMES |
+		ETHTOOL_COALESCE_USE_ADAPTIVE_RX),
 #endif
 	.set_coalesce = ether_set_coalesce,
+	.get_per_queue_coalesce = ether_get_per_queue_coalesce,
+	.set_per_queue_coalesce = ether_set_per_queue_coalesce,
 	.get_wol = ether_get_wol,
 	.set_wol = ether_set_wol,
 	.get_eee = ether_get_eee,
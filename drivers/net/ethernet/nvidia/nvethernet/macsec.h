@@ -278,6 +278,8 @@ struct macsec_priv_data {
 	unsigned int macsec_tx_an_map;
 	/** Macsec RX currently enabled AN */
 	unsigned int macsec_rx_an_map;
+	/** jiffies of last MMC counter readout from hardware */
+	unsigned long mmc_last_read;
 };
 
 int macsec_probe(struct ether_priv_data *pdata);
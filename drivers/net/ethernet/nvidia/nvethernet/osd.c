@@ -17,80 +17,45 @@
 #include "ether_linux.h"
 
 /**
- * @brief ether_get_free_tx_ts_node - get free node for pending SKB
+ * @brief add_skb_node - queue SKB waiting for a Tx timestamp
  *
  * Algorithm:
- *  - Find index of statically allocayted free memory for pending SKB
+ *  - Take a node from the pre allocated free pool in O(1).
+ *  - Add it at the tail of the pending SKB list.
  *
- * @param[in] pdata: OSD private data structure.
+ * Stale nodes are purged by the timestamp drain work so that the
+ * transmit path never walks the pending list.
  *
- * @retval index number
+ * @param[in] pdata: OSD private data structure.
+ * @param[in] skb: SKB waiting for a timestamp.
+ * @param[in] pktid: packet id to identify timestamp.
  */
-static inline unsigned int ether_get_free_tx_ts_node(struct ether_priv_data *pdata)
-{
-	unsigned int i;
-
-	for (i = 0; i < ETHER_MAX_PENDING_SKB_CNT; i++) {
-		if (pdata->tx_ts_skb[i].in_use == OSI_NONE) {
-			break;
-		}
-	}
-
-	return i;
-}
-
 static inline void add_skb_node(struct ether_priv_data *pdata, struct sk_buff *skb,
 				unsigned int pktid) {
-	struct list_head *head_node, *temp_head_node;
-	struct ether_tx_ts_skb_list *pnode = NULL;
-	unsigned int idx;
+	struct ether_tx_ts_skb_list *pnode;
 	unsigned long flags;
-	unsigned long now_jiffies = jiffies;
 
-	if (list_empty(&pdata->tx_ts_skb_head)) {
-		goto empty;
-	}
-
-	raw_spin_lock_irqsave(&pdata->txts_lock, flags);
-	list_for_each_safe(head_node, temp_head_node,
-			   &pdata->tx_ts_skb_head) {
-		pnode = list_entry(head_node,
-				   struct ether_tx_ts_skb_list,
-				   list_head);
-
-		if ((jiffies_to_msecs(now_jiffies) - jiffies_to_msecs(pnode->pkt_jiffies))
-		     >= ETHER_SECTOMSEC) {
-			dev_dbg(pdata->dev, "%s() skb %p deleting for pktid = %x time=%lu\n",
-				__func__, pnode->skb, pnode->pktid, pnode->pkt_jiffies);
-			if (pnode->skb != NULL) {
-				dev_consume_skb_any(pnode->skb);
-			}
-			list_del(head_node);
-			pnode->in_use = OSI_DISABLE;
-		}
-	}
-	raw_spin_unlock_irqrestore(&pdata->txts_lock, flags);
-empty:
 	raw_spin_lock_irqsave(&pdata->txts_lock, flags);
-	idx = ether_get_free_tx_ts_node(pdata);
-	if (idx == ETHER_MAX_PENDING_SKB_CNT) {
+	pnode = list_first_entry_or_null(&pdata->tx_ts_free_head,
+					 struct ether_tx_ts_skb_list,
+					 list_head);
+	if (pnode == NULL) {
+		raw_spin_unlock_irqrestore(&pdata->txts_lock, flags);
 		dev_dbg(pdata->dev,
 			"No free node to store pending SKB\n");
 		dev_consume_skb_any(skb);
-		raw_spin_unlock_irqrestore(&pdata->txts_lock, flags);
 		return;
 	}
 
-	pdata->tx_ts_skb[idx].in_use = OSI_ENABLE;
-	pnode = &pdata->tx_ts_skb[idx];
+	pnode->in_use = OSI_ENABLE;
 	pnode->skb = skb;
 	pnode->pktid = pktid;
-	pnode->pkt_jiffies = now_jiffies;
+	pnode->pkt_jiffies = jiffies;
 
 	dev_dbg(pdata->dev, "%s() SKB %p added for pktid = %x time=%lu\n",
 		__func__, skb, pktid, pnode->pkt_jiffies);
-	list_add_tail(&pnode->list_head,
-		      &pdata->tx_ts_skb_head);
+	list_move_tail(&pnode->list_head,
+		       &pdata->tx_ts_skb_head);
 	raw_spin_unlock_irqrestore(&pdata->txts_lock, flags);
 }
 
@@ -249,7 +214,7 @@ static inline int ether_alloc_skb(struct ether_priv_data *pdata,
 	}
 
 #else
-	rx_swcx->buf_virt_addr = page_pool_dev_alloc_pages(pdata->page_pool);
+	rx_swcx->buf_virt_addr = page_pool_dev_alloc_pages(pdata->page_pool[chan]);
 	if (!rx_swcx->buf_virt_addr) {
 		dev_err(pdata->dev,
 			"page pool allocation failed using resv_buf\n");
@@ -262,7 +227,9 @@ static inline int ether_alloc_skb(struct ether_priv_data *pdata,
 		return 0;
 	}
 
-	rx_swcx->buf_phy_addr = page_pool_get_dma_addr(rx_swcx->buf_virt_addr);
+	rx_swcx->buf_phy_addr =
+		page_pool_get_dma_addr(rx_swcx->buf_virt_addr) +
+		ETHER_XDP_HEADROOM;
 #endif
 #ifndef ETHER_PAGE_POOL
 	rx_swcx->buf_virt_addr = skb;
@@ -644,23 +611,107 @@ static void osd_receive_packet(void *priv, struct osi_rx_ring *rx_ring,
 	if (likely((rx_pkt_cx->flags & OSI_PKT_CX_VALID) ==
 		   OSI_PKT_CX_VALID)) {
 #ifdef ETHER_PAGE_POOL
-		skb = netdev_alloc_skb_ip_align(pdata->ndev,
-						rx_pkt_cx->pkt_len);
+		unsigned int truesize =
+			PAGE_SIZE << pdata->page_pool[chan]->p.order;
+		unsigned char *buf = (unsigned char *)page_address(page) +
+				     ETHER_XDP_HEADROOM;
+		unsigned int pkt_len = rx_pkt_cx->pkt_len;
+#ifdef ETHER_XDP
+		struct bpf_prog *xdp_prog;
+#endif
+
+		dma_sync_single_for_cpu(pdata->dev, dma_addr,
+					rx_pkt_cx->pkt_len, DMA_FROM_DEVICE);
+
+#ifdef ETHER_XDP
+		/* Run the XDP program on the raw buffer before any skb
+		 * is built, so the dropped majority never touches the
+		 * allocator.
+		 */
+		xdp_prog = READ_ONCE(pdata->xdp_prog);
+		if (xdp_prog != NULL) {
+			struct xdp_buff xdp;
+			unsigned int act;
+
+			xdp_init_buff(&xdp, truesize, &rx_napi->xdp_rxq);
+			xdp_prepare_buff(&xdp, page_address(page),
+					 ETHER_XDP_HEADROOM, pkt_len, false);
+			act = bpf_prog_run_xdp(xdp_prog, &xdp);
+			switch (act) {
+			case XDP_PASS:
+				/* program may have adjusted the headers */
+				buf = xdp.data;
+				pkt_len = (unsigned int)(xdp.data_end -
+							 xdp.data);
+				val = pdata->xstats.xdp_pass_n;
+				pdata->xstats.xdp_pass_n =
+					osi_update_stats_counter(val, 1UL);
+				break;
+			case XDP_REDIRECT:
+				if (xdp_do_redirect(ndev, &xdp,
+						    xdp_prog) == 0) {
+					val = pdata->xstats.xdp_redirect_n;
+					pdata->xstats.xdp_redirect_n =
+						osi_update_stats_counter(val,
+									 1UL);
+					goto pkt_consumed;
+				}
+				val = pdata->xstats.xdp_redirect_fail_n;
+				pdata->xstats.xdp_redirect_fail_n =
+					osi_update_stats_counter(val, 1UL);
+				fallthrough;
+			case XDP_ABORTED:
+				trace_xdp_exception(ndev, xdp_prog, act);
+				fallthrough;
+			case XDP_DROP:
+			default:
+				val = pdata->xstats.xdp_drop_n;
+				pdata->xstats.xdp_drop_n =
+					osi_update_stats_counter(val, 1UL);
+				page_pool_recycle_direct(pdata->page_pool[chan],
+							 page);
+				goto pkt_consumed;
+			}
+		}
+#endif
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 14, 0)
+		/* Zero-copy: wrap the pool page in an skb and let the
+		 * stack recycle it back into this queue's pool on free.
+		 */
+		if (likely(ETHER_XDP_HEADROOM + pkt_len +
+			   SKB_DATA_ALIGN(sizeof(struct skb_shared_info)) <=
+			   truesize)) {
+			skb = build_skb(page_address(page), truesize);
+			if (unlikely(!skb)) {
+				pdata->ndev->stats.rx_dropped++;
+				page_pool_recycle_direct(pdata->page_pool[chan],
+							 page);
+				return;
+			}
+			skb_reserve(skb, buf -
+				    (unsigned char *)page_address(page));
+			skb_put(skb, pkt_len);
+			skb_mark_for_recycle(skb);
+			goto skb_ready;
+		}
+#endif
+		skb = netdev_alloc_skb_ip_align(pdata->ndev, pkt_len);
 		if (unlikely(!skb)) {
 			pdata->ndev->stats.rx_dropped++;
 			dev_err(pdata->dev,
 				"%s(): Error in allocating the skb\n",
 			        __func__);
-			page_pool_recycle_direct(pdata->page_pool, page);
+			page_pool_recycle_direct(pdata->page_pool[chan], page);
 			return;
 		}
 
-		dma_sync_single_for_cpu(pdata->dev, dma_addr,
-					rx_pkt_cx->pkt_len, DMA_FROM_DEVICE);
-		skb_copy_to_linear_data(skb, page_address(page),
-					rx_pkt_cx->pkt_len);
-		skb_put(skb, rx_pkt_cx->pkt_len);
-		page_pool_recycle_direct(pdata->page_pool, page);
+		skb_copy_to_linear_data(skb, buf, pkt_len);
+		skb_put(skb, pkt_len);
+		page_pool_recycle_direct(pdata->page_pool[chan], page);
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 14, 0)
+skb_ready:
+#endif
 #else
 		skb_put(skb, rx_pkt_cx->pkt_len);
 #endif
@@ -712,13 +763,16 @@ static void osd_receive_packet(void *priv, struct osi_rx_ring *rx_ring,
 		ndev->stats.rx_fifo_errors = osi_core->mmc.mmc_rx_fifo_overflow;
 		ndev->stats.rx_errors++;
 #ifdef ETHER_PAGE_POOL
-		page_pool_recycle_direct(pdata->page_pool, page);
+		page_pool_recycle_direct(pdata->page_pool[chan], page);
 #endif
 		dev_kfree_skb_any(skb);
 	}
 
 #ifdef ETHER_NVGRO
 done:
+#endif
+#ifdef ETHER_XDP
+pkt_consumed:
 #endif
 	ndev->stats.rx_packets++;
 	rx_swcx->buf_virt_addr = NULL;
@@ -801,11 +855,10 @@ static void osd_transmit_complete(void *priv, const struct osi_tx_swcx *swcx,
 		if ((txdone_pkt_cx->flags & OSI_TXDONE_CX_TS_DELAYED) ==
 		    OSI_TXDONE_CX_TS_DELAYED) {
 			add_skb_node(pdata, skb, txdone_pkt_cx->pktid);
-			/* Consume the timestamp immediately if already available */
-			if (ether_get_tx_ts(pdata) < 0)
-				schedule_delayed_work(&pdata->tx_ts_work,
-						      msecs_to_jiffies(ETHER_TS_MS_TIMER));
-
+			/* Match timestamps to SKBs asynchronously so that
+			 * timestamp retrieval never throttles Tx completion
+			 */
+			schedule_delayed_work(&pdata->tx_ts_work, 0);
 		} else {
 			dev_consume_skb_any(skb);
 		}
@@ -15,6 +15,7 @@
  */
 
 #include <linux/version.h>
+#include <asm/arch_timer.h>
 #include "ether_linux.h"
 
 /**
@@ -250,6 +251,69 @@ static int ether_set_time(struct ptp_clock_info *ptp,
 	return ret;
 }
 
+/**
+ * @brief Get hardware cross timestamp of PHC and system time
+ *
+ * Algorithm: The MAC captures its PTP time and the system counter (TSC)
+ * in one hardware snapshot. The captured TSC value is converted to the
+ * system clocks by rewinding a fresh system time snapshot by the age of
+ * the capture, so no software bracketing of the PHC read is needed.
+ *
+ * @param[in] ptp: Pointer to ptp_clock_info structure.
+ * @param[in] cts: Cross timestamp filled with PHC and system time.
+ *
+ * @retval 0 on success
+ * @retval "negative value" on failure.
+ */
+static int ether_get_crosststamp(struct ptp_clock_info *ptp,
+				 struct system_device_crosststamp *cts)
+{
+	struct ether_priv_data *pdata = container_of(ptp,
+						     struct ether_priv_data,
+						     ptp_clock_ops);
+	struct osi_core_priv_data *osi_core = pdata->osi_core;
+	struct osi_ioctl ioctl_data = {};
+	struct system_time_snapshot snap;
+	u64 ptp_ns, tsc_ticks, delta_ns;
+	unsigned long flags;
+	int ret;
+
+	raw_spin_lock_irqsave(&pdata->ptp_lock, flags);
+
+	ioctl_data.cmd = OSI_CMD_CAP_TSC_PTP;
+	ret = osi_handle_ioctl(osi_core, &ioctl_data);
+	if (ret != 0) {
+		dev_err(pdata->dev,
+			"Failed to get TSC Struct info from registers\n");
+		raw_spin_unlock_irqrestore(&pdata->ptp_lock, flags);
+		return ret;
+	}
+
+	/* snapshot the system clocks while the capture is fresh */
+	ktime_get_snapshot(&snap);
+
+	raw_spin_unlock_irqrestore(&pdata->ptp_lock, flags);
+
+	ptp_ns = ioctl_data.ptp_tsc.ptp_low_bits +
+		 (ioctl_data.ptp_tsc.ptp_high_bits * OSI_NSEC_PER_SEC);
+	tsc_ticks = ((u64)ioctl_data.ptp_tsc.tsc_high_bits <<
+		     TSC_HIGH_SHIFT) | ioctl_data.ptp_tsc.tsc_low_bits;
+
+	/*
+	 * The TSC the MAC captured is the system counter, which also
+	 * backs the snapshot cycles on Tegra, so the counter delta is
+	 * exactly the age of the hardware capture.
+	 */
+	delta_ns = mul_u64_u32_div(snap.cycles - tsc_ticks, NSEC_PER_SEC,
+				   arch_timer_get_cntfrq());
+
+	cts->device = ns_to_ktime(ptp_ns);
+	cts->sys_realtime = ktime_sub_ns(snap.real, delta_ns);
+	cts->sys_monoraw = ktime_sub_ns(snap.raw, delta_ns);
+
+	return 0;
+}
+
 /**
  * @brief Describing Ethernet PTP hardware clock
  */
@@ -265,6 +329,7 @@ static struct ptp_clock_info ether_ptp_clock_ops = {
 	.adjtime = ether_adjust_time,
 	.gettime64 = ether_get_time,
 	.settime64 = ether_set_time,
+	.getcrosststamp = ether_get_crosststamp,
 };
 
 static int ether_early_ptp_init(struct ether_priv_data *pdata)
@@ -1025,9 +1025,19 @@ static DEVICE_ATTR(macsec_byp_lut, (S_IRUGO | S_IWUSR),
 		   macsec_byp_lut_show,
 		   macsec_byp_lut_store);
 
+/** MACsec MMC counter readout cache lifetime in milliseconds. Frequent
+ * polling is served from the last snapshot so that monitoring does not
+ * hammer the MACsec register bus while traffic is flowing.
+ */
+#define MACSEC_MMC_CACHE_MS	50U
+
 /**
  * @brief Shows the current macsec statitics counters
  *
+ * All counters are read from hardware in one batch and cached for
+ * MACSEC_MMC_CACHE_MS, so back to back reads of this attribute only
+ * touch the controller once per cache period.
+ *
  * @param[in] dev: Device data.
  * @param[in] attr: Device attribute
  * @param[in] buf: Buffer to print the current counters
@@ -1038,6 +1048,7 @@ static ssize_t macsec_mmc_counters_show(struct device *dev,
 	struct net_device *ndev = (struct net_device *)dev_get_drvdata(dev);
 	struct ether_priv_data *pdata = netdev_priv(ndev);
 	struct osi_core_priv_data *osi_core = pdata->osi_core;
+	struct macsec_priv_data *macsec_pdata = pdata->macsec_pdata;
 	struct osi_macsec_mmc_counters *mmc = &osi_core->macsec_mmc;
 	unsigned short i;
 	char *start = buf;
@@ -1047,45 +1058,53 @@ static ssize_t macsec_mmc_counters_show(struct device *dev,
 		return 0;
 	}
 
-	osi_macsec_read_mmc(osi_core);
-	buf += scnprintf(buf, PAGE_SIZE, "tx_pkts_untaged:\t%llu\n",
+	mutex_lock(&macsec_pdata->lock);
+	if (macsec_pdata->mmc_last_read == 0 ||
+	    time_after(jiffies, macsec_pdata->mmc_last_read +
+		       msecs_to_jiffies(MACSEC_MMC_CACHE_MS))) {
+		osi_macsec_read_mmc(osi_core);
+		macsec_pdata->mmc_last_read = jiffies;
+	}
+
+	buf += scnprintf(buf, PAGE_SIZE - (buf - start), "tx_pkts_untaged:\t%llu\n",
 		mmc->tx_pkts_untaged);
-	buf += scnprintf(buf, PAGE_SIZE, "tx_pkts_too_long:\t%llu\n",
+	buf += scnprintf(buf, PAGE_SIZE - (buf - start), "tx_pkts_too_long:\t%llu\n",
 		mmc->tx_pkts_too_long);
-	buf += scnprintf(buf, PAGE_SIZE, "tx_octets_protected:\t%llu\n",
+	buf += scnprintf(buf, PAGE_SIZE - (buf - start), "tx_octets_protected:\t%llu\n",
 		mmc->tx_octets_protected);
 	for (i = 0; i < OSI_MACSEC_SC_INDEX_MAX; i++) {
-		buf += scnprintf(buf, PAGE_SIZE, "tx_pkts_protected sc%d:\t%llu\n",
+		buf += scnprintf(buf, PAGE_SIZE - (buf - start), "tx_pkts_protected sc%d:\t%llu\n",
 			i, mmc->tx_pkts_protected[i]);
 	}
 
-	buf += scnprintf(buf, PAGE_SIZE, "rx_pkts_no_tag:  \t%llu\n",
+	buf += scnprintf(buf, PAGE_SIZE - (buf - start), "rx_pkts_no_tag:  \t%llu\n",
 		mmc->rx_pkts_no_tag);
-	buf += scnprintf(buf, PAGE_SIZE, "rx_pkts_untagged:\t%llu\n",
+	buf += scnprintf(buf, PAGE_SIZE - (buf - start), "rx_pkts_untagged:\t%llu\n",
 		mmc->rx_pkts_untagged);
-	buf += scnprintf(buf, PAGE_SIZE, "rx_pkts_bad_tag:\t%llu\n",
+	buf += scnprintf(buf, PAGE_SIZE - (buf - start), "rx_pkts_bad_tag:\t%llu\n",
 		mmc->rx_pkts_bad_tag);
-	buf += scnprintf(buf, PAGE_SIZE, "rx_pkts_no_sa_err:\t%llu\n",
+	buf += scnprintf(buf, PAGE_SIZE - (buf - start), "rx_pkts_no_sa_err:\t%llu\n",
 		mmc->rx_pkts_no_sa_err);
-	buf += scnprintf(buf, PAGE_SIZE, "rx_pkts_no_sa:  \t%llu\n",
+	buf += scnprintf(buf, PAGE_SIZE - (buf - start), "rx_pkts_no_sa:  \t%llu\n",
 		mmc->rx_pkts_no_sa);
-	buf += scnprintf(buf, PAGE_SIZE, "rx_pkts_overrun:\t%llu\n",
+	buf += scnprintf(buf, PAGE_SIZE - (buf - start), "rx_pkts_overrun:\t%llu\n",
 		mmc->rx_pkts_overrun);
-	buf += scnprintf(buf, PAGE_SIZE, "rx_octets_validated:\t%llu\n",
+	buf += scnprintf(buf, PAGE_SIZE - (buf - start), "rx_octets_validated:\t%llu\n",
 		mmc->rx_octets_validated);
 
 	for (i = 0; i < OSI_MACSEC_SC_INDEX_MAX; i++) {
-		buf += scnprintf(buf, PAGE_SIZE, "rx_pkts_invalid sc%d:\t%llu\n",
+		buf += scnprintf(buf, PAGE_SIZE - (buf - start), "rx_pkts_invalid sc%d:\t%llu\n",
 			i, mmc->in_pkts_invalid[i]);
 	}
 	for (i = 0; i < OSI_MACSEC_SC_INDEX_MAX; i++) {
-		buf += scnprintf(buf, PAGE_SIZE, "rx_pkts_delayed sc%d:\t%llu\n",
+		buf += scnprintf(buf, PAGE_SIZE - (buf - start), "rx_pkts_delayed sc%d:\t%llu\n",
 			i, mmc->rx_pkts_delayed[i]);
 	}
 	for (i = 0; i < OSI_MACSEC_SC_INDEX_MAX; i++) {
-		buf += scnprintf(buf, PAGE_SIZE, "rx_pkts_ok sc%d: \t%llu\n",
+		buf += scnprintf(buf, PAGE_SIZE - (buf - start), "rx_pkts_ok sc%d: \t%llu\n",
 			i, mmc->rx_pkts_ok[i]);
 	}
+	mutex_unlock(&macsec_pdata->lock);
 
 	return (buf - start);
 }
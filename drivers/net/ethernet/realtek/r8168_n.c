@@ -320,9 +320,10 @@ static struct pci_device_id rtl8168_pci_tbl[] = {
 
 MODULE_DEVICE_TABLE(pci, rtl8168_pci_tbl);
 
-static int rx_copybreak = 0;
+static int rx_copybreak = 256;
 static int use_dac = 1;
 static int timer_count = 0x2600;
+static int napi_weight = R8168_NAPI_WEIGHT;
 
 static struct {
         u32 msg_enable;
@@ -392,6 +393,9 @@ MODULE_PARM_DESC(use_dac, "Enable PCI DAC. Unsafe on 32 bit PCI slot.");
 module_param(timer_count, int, 0);
 MODULE_PARM_DESC(timer_count, "Timer Interrupt Interval.");
 
+module_param(napi_weight, int, 0);
+MODULE_PARM_DESC(napi_weight, "NAPI poll weight.");
+
 module_param(eee_enable, int, 0);
 MODULE_PARM_DESC(eee_enable, "Enable Energy Efficient Ethernet.");
 
@@ -25186,7 +25190,9 @@ rtl8168_init_one(struct pci_dev *pdev, const struct pci_device_id *ent)
         dev->base_addr = (unsigned long) ioaddr;
 
 #ifdef CONFIG_R8168_NAPI
-        RTL_NAPI_CONFIG(dev, tp, rtl8168_poll, R8168_NAPI_WEIGHT);
+        if (napi_weight < 1 || napi_weight > R8168_NAPI_WEIGHT)
+                napi_weight = R8168_NAPI_WEIGHT;
+        RTL_NAPI_CONFIG(dev, tp, rtl8168_poll, napi_weight);
 #endif
 
 #ifdef CONFIG_R8168_VLAN
@@ -26766,16 +26772,6 @@ rtl8168_mark_to_asic(struct RxDesc *desc,
         desc->opts1 = cpu_to_le32(DescOwn | eor | rx_buf_sz);
 }
 
-static inline void
-rtl8168_map_to_asic(struct RxDesc *desc,
-                    dma_addr_t mapping,
-                    u32 rx_buf_sz)
-{
-        desc->addr = cpu_to_le64(mapping);
-        wmb();
-        rtl8168_mark_to_asic(desc, rx_buf_sz);
-}
-
 static int
 rtl8168_alloc_rx_skb(struct rtl8168_private *tp,
                      struct sk_buff **sk_buff,
@@ -26806,7 +26802,8 @@ rtl8168_alloc_rx_skb(struct rtl8168_private *tp,
         }
 
         *sk_buff = skb;
-        rtl8168_map_to_asic(desc, mapping, rx_buf_sz);
+        /* ownership is passed to the asic by the caller, batched */
+        desc->addr = cpu_to_le64(mapping);
 out:
         return ret;
 
@@ -26837,20 +26834,40 @@ rtl8168_rx_fill(struct rtl8168_private *tp,
                 u32 end,
                 u8 in_intr)
 {
-        u32 cur;
+        u32 cur = start;
+        int ret = 0;
 
-        for (cur = start; end - cur > 0; cur++) {
-                int ret, i = cur % NUM_RX_DESC;
+        while (end - cur > 0 && ret == 0) {
+                u32 run_start;
 
-                if (tp->Rx_skbuff[i])
-                        continue;
+                /* slots still holding a buffer already belong to the asic */
+                while (end - cur > 0 && tp->Rx_skbuff[cur % NUM_RX_DESC])
+                        cur++;
 
-                ret = rtl8168_alloc_rx_skb(tp, tp->Rx_skbuff + i,
-                                           tp->RxDescArray + i,
-                                           tp->rx_buf_sz,
-                                           in_intr);
-                if (ret < 0)
-                        break;
+                /* allocate and map a batch without giving it to the asic */
+                run_start = cur;
+                while (end - cur > 0 && !tp->Rx_skbuff[cur % NUM_RX_DESC]) {
+                        int i = cur % NUM_RX_DESC;
+
+                        ret = rtl8168_alloc_rx_skb(tp, tp->Rx_skbuff + i,
+                                                   tp->RxDescArray + i,
+                                                   tp->rx_buf_sz,
+                                                   in_intr);
+                        if (ret < 0)
+                                break;
+                        cur++;
+                }
+
+                /* publish the whole batch with a single barrier */
+                if (cur != run_start) {
+                        wmb();
+                        while (run_start != cur) {
+                                rtl8168_mark_to_asic(tp->RxDescArray +
+                                                     (run_start % NUM_RX_DESC),
+                                                     tp->rx_buf_sz);
+                                run_start++;
+                        }
+                }
         }
         return cur - start;
 }
@@ -51,6 +51,12 @@
 * 0004: [packet-size 32 bit]
 * 0008: data
 *
+* aggregated data frame
+* 0000: [16-bit used size][12-bit pad][Aggr-bit][0][0][F_CNTRL=0]
+* 0004: [packet count 32 bit]
+* 0008: per-packet records, [32-bit packet size][data],
+*       each record padded to 32-bit alignment
+*
 * control frame
 * 0000: <flags> (F_CNTRL == 1) F_CNTRL_CMD(x)
 * 0004: control frame data (deduced from F_CNTRL_CMD)
@@ -70,6 +76,7 @@
 
 #define F_DATA_FIRST		(1 << 1)	/* first chunk of a frame */
 #define F_DATA_LAST		(1 << 2)	/* last chunk of a frame */
+#define F_DATA_AGGR		(1 << 3)	/* aggregated data frame */
 #define F_DATA_FSIZE_SHIFT	16
 #define F_DATA_FSIZE_MASK	(~0 << F_DATA_FSIZE_SHIFT)
 #define F_DATA_FSIZE(x)	(((u32)(x) << F_DATA_FSIZE_SHIFT) & F_DATA_FSIZE_MASK)
@@ -139,6 +146,7 @@ struct tegra_hv_net {
 	unsigned int high_watermark;	/* mult * framesize */
 	unsigned int low_watermark;
 	unsigned int max_tx_delay;
+	bool frame_aggr;	/* pack multiple packets per IVC frame */
 };
 
 static int tegra_hv_net_open(struct net_device *ndev)
@@ -203,6 +211,18 @@ static void *tegra_hv_net_xmit_get_buffer(struct tegra_hv_net *hvn)
 	return p;
 }
 
+/* seal and send an aggregated frame built by the xmit worker */
+static void tegra_hv_net_xmit_aggr_flush(struct tegra_hv_net *hvn,
+		u32 *p, int used, int count)
+{
+	netdev_dbg(hvn->ndev, "A: C%d U%d\n", count, used);
+
+	p[0] = F_DATA_AGGR | F_DATA_FSIZE(used);
+	p[1] = count;
+
+	(void)tegra_hv_ivc_write_advance(hvn->ivck);
+}
+
 static void tegra_hv_net_xmit_work(struct work_struct *work)
 {
 	struct tegra_hv_net *hvn =
@@ -211,7 +231,8 @@ static void tegra_hv_net_xmit_work(struct work_struct *work)
 	struct net_device *ndev = hvn->ndev;
 	struct sk_buff *skb;
 	int ret, max_frame, count, first, last, orig_len;
-	u32 *p, p0, p1;
+	int aggr_used = 0, aggr_count = 0;
+	u32 *p, *ap = NULL, p0, p1;
 	enum drop_kind dk;
 
 	max_frame = hvn->ivck->frame_size - HDR_SIZE;
@@ -237,8 +258,53 @@ static void tegra_hv_net_xmit_work(struct work_struct *work)
 		/* print_hex_dump(KERN_INFO, "tx-", DUMP_PREFIX_OFFSET,
 		 * 16, 1, skb->data, skb->len, true); */
 
-		/* copy the fragments */
 		orig_len = skb->len;
+
+		/* pack small packets as records of a shared IVC frame */
+		if (hvn->frame_aggr &&
+				ALIGN(4 + skb->len, 4) <= max_frame) {
+
+			/* no room left; seal the frame and start over */
+			if (ap != NULL && aggr_used +
+					ALIGN(4 + skb->len, 4) > max_frame) {
+				tegra_hv_net_xmit_aggr_flush(hvn, ap,
+						aggr_used, aggr_count);
+				ap = NULL;
+			}
+
+			if (ap == NULL) {
+				/* wait up to the maximum send timeout */
+				ap = tegra_hv_net_xmit_get_buffer(hvn);
+				if (IS_ERR(ap)) {
+					ap = NULL;
+					dk = dk_wq;
+					goto drop;
+				}
+				aggr_used = 0;
+				aggr_count = 0;
+			}
+
+			ap[2 + aggr_used / 4] = skb->len;
+			skb_copy_from_linear_data(skb,
+					(u8 *)&ap[2] + aggr_used + 4,
+					skb->len);
+			aggr_used += ALIGN(4 + skb->len, 4);
+			aggr_count++;
+
+			dk = dk_none;
+			goto drop;
+		}
+
+		/* the packet needs a frame (or more) of its own; send any
+		 * pending aggregate first so packets stay in order
+		 */
+		if (ap != NULL) {
+			tegra_hv_net_xmit_aggr_flush(hvn, ap,
+					aggr_used, aggr_count);
+			ap = NULL;
+		}
+
+		/* copy the fragments */
 		first = 1;
 		while (skb->len > 0) {
 			count = skb->len;
@@ -308,6 +374,10 @@ drop:
 		}
 		u64_stats_update_end(&stats->tx_syncp);
 	}
+
+	/* the queue drained; send whatever was packed so far */
+	if (ap != NULL)
+		tegra_hv_net_xmit_aggr_flush(hvn, ap, aggr_used, aggr_count);
 }
 
 /* xmit is dummy, we just add the skb to the tx_q and queue work */
@@ -466,6 +536,77 @@ static void tegra_hv_net_tx_complete(struct tegra_hv_net *hvn)
 
 }
 
+/* deliver the packet records of an aggregated frame */
+static void tegra_hv_net_rx_aggr(struct tegra_hv_net *hvn,
+		struct tegra_hv_net_stats *stats, u32 *p, int max_frame)
+{
+	struct net_device *ndev = hvn->ndev;
+	struct sk_buff *skb;
+	int used, count, off, len;
+	enum drop_kind dk;
+
+	used = (p[0] & F_DATA_FSIZE_MASK) >> F_DATA_FSIZE_SHIFT;
+	count = p[1];
+
+	netdev_dbg(ndev, "A: C%d U%d [%08x %08x]\n", count, used, p[0], p[1]);
+
+	if (used > max_frame) {
+		netdev_err(ndev, "Bad aggregate size %d\n", used);
+		u64_stats_update_begin(&stats->rx_syncp);
+		stats->rx_drops++;
+		stats->rx_bad_frame++;
+		u64_stats_update_end(&stats->rx_syncp);
+		return;
+	}
+
+	off = 0;
+	while (count > 0 && off + 4 <= used) {
+		len = p[2 + off / 4];
+
+		dk = dk_none;
+		if (len < MIN_MTU || len > MAX_MTU + MIN_MTU ||
+				off + 4 + len > used) {
+			netdev_err(ndev, "Bad packet size %d\n", len);
+			dk = dk_packet;
+		} else {
+			skb = netdev_alloc_skb(ndev, len);
+			if (skb == NULL) {
+				netdev_err(ndev, "failed to allocate packet\n");
+				dk = dk_alloc;
+			} else {
+				skb_copy_to_linear_data(skb,
+						(u8 *)&p[2] + off + 4, len);
+				skb_put(skb, len);
+				skb->protocol = eth_type_trans(skb, ndev);
+				skb->ip_summed = CHECKSUM_NONE;
+				napi_gro_receive(&hvn->napi, skb);
+			}
+		}
+
+		u64_stats_update_begin(&stats->rx_syncp);
+		if (dk == dk_none) {
+			stats->rx_packets++;
+			stats->rx_bytes += len;
+		} else {
+			stats->rx_drops++;
+			if (dk == dk_packet)
+				stats->rx_bad_packet++;
+			else
+				stats->rx_alloc_fail++;
+		}
+		u64_stats_update_end(&stats->rx_syncp);
+
+		/* a bad record means record framing is lost;
+		 * drop the rest of the frame
+		 */
+		if (dk == dk_packet)
+			break;
+
+		off += ALIGN(4 + len, 4);
+		count--;
+	}
+}
+
 static int tegra_hv_net_rx(struct tegra_hv_net *hvn, int limit)
 {
 	struct tegra_hv_net_stats *stats = this_cpu_ptr(hvn->stats);
@@ -492,6 +633,13 @@ static int tegra_hv_net_rx(struct tegra_hv_net *hvn, int limit)
 		nr++;
 
 		p0 = p[0];
+
+		if (p0 & F_DATA_AGGR) {
+			tegra_hv_net_rx_aggr(hvn, stats, p, max_frame);
+			(void)tegra_hv_ivc_read_advance(hvn->ivck);
+			continue;
+		}
+
 		first = !!(p0 & F_DATA_FIRST);
 		last = !!(p0 & F_DATA_LAST);
 		frame_size = (p0 & F_DATA_FSIZE_MASK) >> F_DATA_FSIZE_SHIFT;
@@ -551,7 +699,7 @@ static int tegra_hv_net_rx(struct tegra_hv_net *hvn, int limit)
 
 			skb->protocol = eth_type_trans(skb, ndev);
 			skb->ip_summed = CHECKSUM_NONE;
-			netif_receive_skb(skb);
+			napi_gro_receive(&hvn->napi, skb);
 			hvn->rx_skb = NULL;
 		}
 		dk = dk_none;
@@ -626,6 +774,7 @@ static int tegra_hv_net_probe(struct platform_device *pdev)
 	int ret;
 	u32 id;
 	u32 highmark, lowmark, txdelay;
+	bool aggr;
 
 	if (!is_tegra_hypervisor_mode()) {
 		dev_info(dev, "Hypervisor is not present\n");
@@ -668,6 +817,9 @@ static int tegra_hv_net_probe(struct platform_device *pdev)
 	if (ret != 0)
 		txdelay = DEFAULT_MAX_TX_DELAY_MSECS;
 
+	/* both peers must be built with aggregation support */
+	aggr = of_property_read_bool(dn, "frame-aggregation");
+
 	ndev = alloc_netdev(sizeof(*hvn), "hv%d", NET_NAME_UNKNOWN,
 			    ether_setup);
 	if (ndev == NULL) {
@@ -699,6 +851,7 @@ static int tegra_hv_net_probe(struct platform_device *pdev)
 	hvn->high_watermark = highmark * hvn->ivck->nframes;
 	hvn->low_watermark = lowmark * hvn->ivck->nframes;
 	hvn->max_tx_delay = txdelay;
+	hvn->frame_aggr = aggr;
 
 	/* make sure the frame size is sufficient */
 	if (hvn->ivck->frame_size <= HDR_SIZE + 4) {
@@ -707,8 +860,9 @@ static int tegra_hv_net_probe(struct platform_device *pdev)
 		goto out_unreserve;
 	}
 
-	dev_info(dev, "Reserved IVC channel #%d - frame_size=%d\n",
-			id, hvn->ivck->frame_size);
+	dev_info(dev, "Reserved IVC channel #%d - frame_size=%d%s\n",
+			id, hvn->ivck->frame_size,
+			hvn->frame_aggr ? ", frame aggregation" : "");
 
 	SET_NETDEV_DEV(ndev, dev);
 	platform_set_drvdata(pdev, ndev);
@@ -561,13 +561,14 @@ static inline chanspec_t wl_cfg80211_ulb_get_min_bw_chspec(
 static s32 wl_create_event_handler(struct bcm_cfg80211 *cfg);
 static void wl_destroy_event_handler(struct bcm_cfg80211 *cfg);
 static void wl_event_handler(struct work_struct *work_data);
+static void wl_scan_event_handler(struct work_struct *work_data);
 static void wl_init_eq(struct bcm_cfg80211 *cfg);
 static void wl_flush_eq(struct bcm_cfg80211 *cfg);
 static unsigned long wl_lock_eq(struct bcm_cfg80211 *cfg);
 static void wl_unlock_eq(struct bcm_cfg80211 *cfg, unsigned long flags);
 static void wl_init_eq_lock(struct bcm_cfg80211 *cfg);
 static void wl_init_event_handler(struct bcm_cfg80211 *cfg);
-static struct wl_event_q *wl_deq_event(struct bcm_cfg80211 *cfg);
+static struct wl_event_q *wl_deq_event(struct bcm_cfg80211 *cfg, struct list_head *eq);
 static s32 wl_enq_event(struct bcm_cfg80211 *cfg, struct net_device *ndev, u32 type,
 	const wl_event_msg_t *msg, void *data);
 static void wl_put_event(struct wl_event_q *e);
@@ -2831,6 +2832,7 @@ wl_do_escan(struct bcm_cfg80211 *cfg, struct wiphy *wiphy, struct net_device *nd
 	results->version = 0;
 	results->count = 0;
 	results->buflen = WL_SCAN_RESULTS_FIXED_SIZE;
+	bzero(cfg->escan_info.bssid_filter, sizeof(cfg->escan_info.bssid_filter));
 
 	cfg->escan_info.ndev = ndev;
 	cfg->escan_info.wiphy = wiphy;
@@ -12578,11 +12580,25 @@ static s32 wl_create_event_handler(struct bcm_cfg80211 *cfg)
 			INIT_WORK(&cfg->event_work, wl_event_handler);
 		}
 	}
+	if (!ret && !cfg->scan_event_workq) {
+		/* Scan results are deferred to a normal priority workqueue */
+		cfg->scan_event_workq = alloc_workqueue("dhd_scan_eventd", WQ_MEM_RECLAIM, 0);
+		if (!cfg->scan_event_workq) {
+			ret = -ENOMEM;
+		} else {
+			INIT_WORK(&cfg->scan_event_work, wl_scan_event_handler);
+		}
+	}
 	return ret;
 }
 
 static void wl_destroy_event_handler(struct bcm_cfg80211 *cfg)
 {
+	if (cfg->scan_event_workq) {
+		cancel_work_sync(&cfg->scan_event_work);
+		destroy_workqueue(cfg->scan_event_workq);
+		cfg->scan_event_workq = NULL;
+	}
 	if (cfg->event_workq) {
 		cancel_work_sync(&cfg->event_work);
 		destroy_workqueue(cfg->event_workq);
@@ -12998,6 +13014,27 @@ wl_cfg80211_remove_lowRSSI_info(wl_scan_results_t *list, removal_element_t *cand
 }
 #endif /* ESCAN_BUF_OVERFLOW_MGMT */
 
+/*
+ * 256 bit presence filter over the BSSIDs collected in the current scan.
+ * Returns true if the BSSID may already be in the scan list and marks it
+ * as seen. False positives only cost the regular list walk; the filter is
+ * reset together with the scan result buffer at scan start.
+ */
+static bool wl_escan_bssid_seen(struct bcm_cfg80211 *cfg, struct ether_addr *bssid)
+{
+	u32 hash = 0;
+	u32 i;
+	bool seen;
+
+	for (i = 0; i < ETHER_ADDR_LEN; i++)
+		hash = (hash * 31) + bssid->octet[i];
+	hash &= 0xff;
+
+	seen = cfg->escan_info.bssid_filter[hash >> 5] & (1u << (hash & 0x1f));
+	cfg->escan_info.bssid_filter[hash >> 5] |= (1u << (hash & 0x1f));
+	return seen;
+}
+
 static s32 wl_escan_handler(struct bcm_cfg80211 *cfg, bcm_struct_cfgdev *cfgdev,
 	const wl_event_msg_t *e, void *data)
 {
@@ -13114,6 +13151,16 @@ static s32 wl_escan_handler(struct bcm_cfg80211 *cfg, bcm_struct_cfgdev *cfgdev,
 				remove_lower_rssi = TRUE;
 #endif /* ESCAN_BUF_OVERFLOW_MGMT */
 
+			/* a BSSID not yet seen in this scan cannot be in the
+			 * list, so the in-place update walk can be skipped
+			 */
+			if (
+#ifdef ESCAN_BUF_OVERFLOW_MGMT
+				!remove_lower_rssi &&
+#endif /* ESCAN_BUF_OVERFLOW_MGMT */
+				!wl_escan_bssid_seen(cfg, &bi->BSSID))
+				goto append_bss;
+
 			for (i = 0; i < list->count; i++) {
 				bss = bss ? (wl_bss_info_t *)((uintptr)bss + dtoh32(bss->length))
 					: list->bss_info;
@@ -13202,6 +13249,7 @@ static s32 wl_escan_handler(struct bcm_cfg80211 *cfg, bcm_struct_cfgdev *cfgdev,
 				}
 				cur_len += dtoh32(bss->length);
 			}
+append_bss:
 			if (bi_length > ESCAN_BUF_SIZE - list->buflen) {
 #ifdef ESCAN_BUF_OVERFLOW_MGMT
 				wl_cfg80211_remove_lowRSSI_info(list, candidate, bi);
@@ -13882,46 +13930,71 @@ void wl_cfg80211_detach(void *cfg80211_priv)
 	 */
 }
 
+static void wl_dispatch_event(struct bcm_cfg80211 *cfg, struct wl_event_q *e)
+{
+	struct wireless_dev *wdev = NULL;
+
+	WL_DBG(("event type (%d), ifidx: %d bssidx: %d \n",
+			e->etype, e->emsg.ifidx, e->emsg.bsscfgidx));
+
+	if (e->emsg.ifidx > WL_MAX_IFS) {
+		WL_ERR((" Event ifidx not in range. val:%d \n", e->emsg.ifidx));
+		return;
+	}
+
+	if (!(wdev = wl_get_wdev_by_bssidx(cfg, e->emsg.bsscfgidx))) {
+		/* For WLC_E_IF would be handled by wl_host_event */
+		if (e->etype != WLC_E_IF)
+			WL_ERR(("No wdev corresponding to bssidx: 0x%x found!"
+						" Ignoring event.\n", e->emsg.bsscfgidx));
+	} else if (e->etype < WLC_E_LAST && cfg->evt_handler[e->etype]) {
+		dhd_pub_t *dhd = (struct dhd_pub *)(cfg->pub);
+		if (dhd->busstate == DHD_BUS_DOWN) {
+			WL_ERR((": BUS is DOWN.\n"));
+		} else {
+#ifdef DHD_IFDEBUG
+			if (cfg->iface_cnt == 0) {
+				wl_dump_ifinfo(cfg);
+			}
+#endif
+			cfg->evt_handler[e->etype](cfg, wdev_to_cfgdev(wdev),
+					&e->emsg, e->edata);
+		}
+	} else {
+		WL_DBG(("Unknown Event (%d): ignoring\n", e->etype));
+	}
+}
+
 static void wl_event_handler(struct work_struct *work_data)
 {
 	struct bcm_cfg80211 *cfg = NULL;
 	struct wl_event_q *e;
-	struct wireless_dev *wdev = NULL;
 
 	WL_DBG(("Enter \n"));
 	BCM_SET_CONTAINER_OF(cfg, work_data, struct bcm_cfg80211, event_work);
 	DHD_EVENT_WAKE_LOCK(cfg->pub);
-	while ((e = wl_deq_event(cfg))) {
-		WL_DBG(("event type (%d), ifidx: %d bssidx: %d \n",
-				e->etype, e->emsg.ifidx, e->emsg.bsscfgidx));
+	while ((e = wl_deq_event(cfg, &cfg->eq_list))) {
+		wl_dispatch_event(cfg, e);
+		wl_put_event(e);
+	}
+	DHD_EVENT_WAKE_UNLOCK(cfg->pub);
+}
 
-		if (e->emsg.ifidx > WL_MAX_IFS) {
-			WL_ERR((" Event ifidx not in range. val:%d \n", e->emsg.ifidx));
-			goto fail;
-		}
+/*
+ * Scan results are drained in batches at normal priority so that roaming
+ * storms and scans do not starve other work; ordering within the scan
+ * event stream is kept since a single work item never runs concurrently.
+ */
+static void wl_scan_event_handler(struct work_struct *work_data)
+{
+	struct bcm_cfg80211 *cfg = NULL;
+	struct wl_event_q *e;
 
-		if (!(wdev = wl_get_wdev_by_bssidx(cfg, e->emsg.bsscfgidx))) {
-			/* For WLC_E_IF would be handled by wl_host_event */
-			if (e->etype != WLC_E_IF)
-				WL_ERR(("No wdev corresponding to bssidx: 0x%x found!"
-							" Ignoring event.\n", e->emsg.bsscfgidx));
-		} else if (e->etype < WLC_E_LAST && cfg->evt_handler[e->etype]) {
-			dhd_pub_t *dhd = (struct dhd_pub *)(cfg->pub);
-			if (dhd->busstate == DHD_BUS_DOWN) {
-				WL_ERR((": BUS is DOWN.\n"));
-			} else {
-#ifdef DHD_IFDEBUG
-				if (cfg->iface_cnt == 0) {
-					wl_dump_ifinfo(cfg);
-				}
-#endif
-				cfg->evt_handler[e->etype](cfg, wdev_to_cfgdev(wdev),
-						&e->emsg, e->edata);
-			}
-		} else {
-			WL_DBG(("Unknown Event (%d): ignoring\n", e->etype));
-		}
-fail:
+	WL_DBG(("Enter \n"));
+	BCM_SET_CONTAINER_OF(cfg, work_data, struct bcm_cfg80211, scan_event_work);
+	DHD_EVENT_WAKE_LOCK(cfg->pub);
+	while ((e = wl_deq_event(cfg, &cfg->scan_eq_list))) {
+		wl_dispatch_event(cfg, e);
 		wl_put_event(e);
 	}
 	DHD_EVENT_WAKE_UNLOCK(cfg->pub);
@@ -13979,7 +14052,9 @@ wl_cfg80211_event(struct net_device *ndev, const wl_event_msg_t * e, void *data)
 	}
 
 	if (likely(!wl_enq_event(cfg, ndev, event_type, e, data))) {
-		if (cfg->event_workq) {
+		if (event_type == WLC_E_ESCAN_RESULT && cfg->scan_event_workq) {
+			queue_work(cfg->scan_event_workq, &cfg->scan_event_work);
+		} else if (cfg->event_workq) {
 			queue_work(cfg->event_workq, &cfg->event_work);
 		}
 	}
@@ -13989,6 +14064,7 @@ static void wl_init_eq(struct bcm_cfg80211 *cfg)
 {
 	wl_init_eq_lock(cfg);
 	INIT_LIST_HEAD(&cfg->eq_list);
+	INIT_LIST_HEAD(&cfg->scan_eq_list);
 }
 
 static void wl_flush_eq(struct bcm_cfg80211 *cfg)
@@ -14002,6 +14078,11 @@ static void wl_flush_eq(struct bcm_cfg80211 *cfg)
 		list_del(&e->eq_list);
 		kfree(e);
 	}
+	while (!list_empty_careful(&cfg->scan_eq_list)) {
+		BCM_SET_LIST_FIRST_ENTRY(e, &cfg->scan_eq_list, struct wl_event_q, eq_list);
+		list_del(&e->eq_list);
+		kfree(e);
+	}
 	wl_unlock_eq(cfg, flags);
 }
 
@@ -14009,14 +14090,14 @@ static void wl_flush_eq(struct bcm_cfg80211 *cfg)
 * retrieve first queued event from head
 */
 
-static struct wl_event_q *wl_deq_event(struct bcm_cfg80211 *cfg)
+static struct wl_event_q *wl_deq_event(struct bcm_cfg80211 *cfg, struct list_head *eq)
 {
 	struct wl_event_q *e = NULL;
 	unsigned long flags;
 
 	flags = wl_lock_eq(cfg);
-	if (likely(!list_empty(&cfg->eq_list))) {
-		BCM_SET_LIST_FIRST_ENTRY(e, &cfg->eq_list, struct wl_event_q, eq_list);
+	if (likely(!list_empty(eq))) {
+		BCM_SET_LIST_FIRST_ENTRY(e, eq, struct wl_event_q, eq_list);
 		list_del(&e->eq_list);
 	}
 	wl_unlock_eq(cfg, flags);
@@ -14054,7 +14135,10 @@ wl_enq_event(struct bcm_cfg80211 *cfg, struct net_device *ndev, u32 event,
 	if (data)
 		memcpy(e->edata, data, data_len);
 	flags = wl_lock_eq(cfg);
-	list_add_tail(&e->eq_list, &cfg->eq_list);
+	if (event == WLC_E_ESCAN_RESULT)
+		list_add_tail(&e->eq_list, &cfg->scan_eq_list);
+	else
+		list_add_tail(&e->eq_list, &cfg->eq_list);
 	wl_unlock_eq(cfg, flags);
 
 	return err;
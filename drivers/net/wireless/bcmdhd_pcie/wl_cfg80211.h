@@ -512,6 +512,7 @@ struct escan_info {
 #endif /* STATIC_WL_PRIV_STRUCT */
 	struct wiphy *wiphy;
 	struct net_device *ndev;
+	u32 bssid_filter[8];	/* 256 bit BSSID presence hint for dedup */
 };
 
 #ifdef ESCAN_BUF_OVERFLOW_MGMT
@@ -590,6 +591,7 @@ struct bcm_cfg80211 {
 	struct cfg80211_scan_request *scan_request;	/* scan request object */
 	EVENT_HANDLER evt_handler[WLC_E_LAST];
 	struct list_head eq_list;	/* used for event queue */
+	struct list_head scan_eq_list;	/* event queue for scan results */
 	struct list_head net_list;     /* used for struct net_info */
 	spinlock_t net_list_sync;	/* to protect scan status (and others if needed) */
 	spinlock_t eq_lock;	/* for event queue synchronization */
@@ -684,6 +686,8 @@ struct bcm_cfg80211 {
 	struct mutex pm_sync;	/* mainly for pm work synchronization */
 	struct workqueue_struct *event_workq;   /* workqueue for event */
 	struct work_struct event_work;		/* work item for event */
+	struct workqueue_struct *scan_event_workq; /* normal prio wq for scan results */
+	struct work_struct scan_event_work;	/* work item for scan results */
 
 	vndr_ie_setbuf_t *ibss_vsie;	/* keep the VSIE for IBSS */
 	int ibss_vsie_len;
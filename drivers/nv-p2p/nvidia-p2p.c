@@ -24,36 +24,143 @@ MODULE_DESCRIPTION("Nvidia Tegra P2P Driver");
 MODULE_AUTHOR("Preetham Chandru pchandru@nvidia.com");
 MODULE_LICENSE("GPL");
 
+/*
+ * Pinned-region cache.
+ *
+ * The pages and the mmu notifier for a pinned virtual range are owned by a
+ * cache entry keyed by (mm, vaddr, size) rather than by the individual
+ * page table handed to the client. Re-pinning an unchanged range is then a
+ * refcount bump on the existing entry instead of a fresh get_user_pages()
+ * walk. The pinning persists after the last client unregisters and is
+ * dropped when the range is unmapped, remapped or the mm goes away, as
+ * reported by the mmu notifier.
+ */
+struct nvidia_p2p_pin_cache_entry {
+	struct list_head node;
+	/* page tables sharing this pinning, guarded by pin_cache_lock */
+	struct list_head clients;
+	struct mmu_notifier mn;
+	struct mm_struct *mm;
+	u64 vaddr;
+	u64 size;
+	u32 entries;
+	struct page **pages;
+	struct kref ref;
+	bool invalidated;
+#if LINUX_VERSION_CODE < KERNEL_VERSION(5, 4, 0)
+	struct rcu_head rcu;
+#endif
+};
+
+static LIST_HEAD(pin_cache);
+static DEFINE_MUTEX(pin_cache_lock);
+
+static void nvidia_p2p_pin_cache_release(struct kref *ref)
+{
+	struct nvidia_p2p_pin_cache_entry *entry = container_of(ref,
+						struct nvidia_p2p_pin_cache_entry,
+						ref);
+	int user_pages = entry->entries;
+
+	while (--user_pages >= 0) {
+		put_page(entry->pages[user_pages]);
+	}
+	kfree(entry->pages);
+	kfree(entry);
+}
+
+#if LINUX_VERSION_CODE < KERNEL_VERSION(5, 4, 0)
+static void nvidia_p2p_mn_free_rcu(struct rcu_head *rcu)
+{
+	struct nvidia_p2p_pin_cache_entry *entry = container_of(rcu,
+						struct nvidia_p2p_pin_cache_entry,
+						rcu);
+
+	kref_put(&entry->ref, nvidia_p2p_pin_cache_release);
+}
+#endif
+
+/*
+ * Unlink the entry from the cache and notify every client still attached
+ * to it. The lock is dropped around each free_callback since clients
+ * release their reference from within it.
+ */
+static void nvidia_p2p_pin_cache_invalidate(
+		struct nvidia_p2p_pin_cache_entry *entry, bool unregister)
+{
+	struct nvidia_p2p_page_table *page_table;
+
+	mutex_lock(&pin_cache_lock);
+	if (entry->invalidated) {
+		mutex_unlock(&pin_cache_lock);
+		return;
+	}
+	entry->invalidated = true;
+	list_del(&entry->node);
+	while (!list_empty(&entry->clients)) {
+		page_table = list_first_entry(&entry->clients,
+					struct nvidia_p2p_page_table,
+					cache_node);
+		list_del_init(&page_table->cache_node);
+		mutex_unlock(&pin_cache_lock);
+		page_table->free_callback(page_table->data);
+		mutex_lock(&pin_cache_lock);
+	}
+	mutex_unlock(&pin_cache_lock);
+
+	/*
+	 * The notifier core holds its own reference on the entry; it may
+	 * only be dropped once no SRCU reader can still walk the
+	 * subscription, i.e. after the grace period following deregistration.
+	 */
+	if (unregister) {
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 4, 0)
+		/* free_notifier drops the notifier's reference */
+		mmu_notifier_put(&entry->mn);
+#else
+		mmu_notifier_unregister_no_release(&entry->mn, entry->mm);
+		/* unregister synchronized SRCU, safe to drop now */
+		kref_put(&entry->ref, nvidia_p2p_pin_cache_release);
+#endif
+	} else {
+		/*
+		 * Called from ops->release: the core dereferences the
+		 * subscription after we return, so the drop must wait out
+		 * the grace period even though the mm is going away.
+		 */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 4, 0)
+		mmu_notifier_put(&entry->mn);
+#else
+		mmu_notifier_call_srcu(&entry->rcu, nvidia_p2p_mn_free_rcu);
+#endif
+	}
+	/* Drop the reference the cache itself holds */
+	kref_put(&entry->ref, nvidia_p2p_pin_cache_release);
+}
+
 static void nvidia_p2p_mn_release(struct mmu_notifier *mn,
 	struct mm_struct *mm)
 {
-	struct nvidia_p2p_page_table *page_table = container_of(mn,
-						struct nvidia_p2p_page_table,
+	struct nvidia_p2p_pin_cache_entry *entry = container_of(mn,
+						struct nvidia_p2p_pin_cache_entry,
 						mn);
 
-	page_table->free_callback(page_table->data);
+	nvidia_p2p_pin_cache_invalidate(entry, false);
 }
 
 static void nvidia_p2p_mn_invl_range_start_legacy(struct mmu_notifier *mn,
 	struct mm_struct *mm, unsigned long start, unsigned long end)
 {
-	struct nvidia_p2p_page_table *page_table = container_of(mn,
-						struct  nvidia_p2p_page_table,
+	struct nvidia_p2p_pin_cache_entry *entry = container_of(mn,
+						struct nvidia_p2p_pin_cache_entry,
 						mn);
 
 	u64 vaddr = 0;
-	u64 size = 0;
 
-	vaddr = page_table->vaddr;
-	size = page_table->size;
+	vaddr = entry->vaddr;
 
 	if (vaddr >= start && vaddr <= end) {
-#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 4, 0)
-		mmu_notifier_put(&page_table->mn);
-#else
-		mmu_notifier_unregister_no_release(&page_table->mn, page_table->mm);
-#endif
-		page_table->free_callback(page_table->data);
+		nvidia_p2p_pin_cache_invalidate(entry, true);
 	}
 }
 
@@ -68,8 +175,14 @@ static int nvidia_p2p_mn_invl_range_start(struct mmu_notifier *mn,
 #endif
 
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 4, 0)
+/* Runs after the notifier core's SRCU grace period has elapsed */
 static void nvidia_p2p_free_notifier(struct mmu_notifier *mn)
 {
+	struct nvidia_p2p_pin_cache_entry *entry = container_of(mn,
+						struct nvidia_p2p_pin_cache_entry,
+						mn);
+
+	kref_put(&entry->ref, nvidia_p2p_pin_cache_release);
 }
 #endif
 
@@ -86,29 +199,41 @@ static struct mmu_notifier_ops nvidia_p2p_mmu_ops = {
 #endif
 };
 
-int nvidia_p2p_get_pages(u64 vaddr, u64 size,
-		struct nvidia_p2p_page_table **page_table,
-		void (*free_callback)(void *data), void *data)
+/* Caller holds pin_cache_lock */
+static struct nvidia_p2p_pin_cache_entry *nvidia_p2p_pin_cache_find(
+		struct mm_struct *mm, u64 vaddr, u64 size)
+{
+	struct nvidia_p2p_pin_cache_entry *entry;
+
+	list_for_each_entry(entry, &pin_cache, node) {
+		if (entry->mm == mm && entry->vaddr == vaddr &&
+		    entry->size == size && !entry->invalidated) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static struct nvidia_p2p_pin_cache_entry *nvidia_p2p_pin_cache_create(
+		u64 vaddr, u64 size)
 {
 	int ret = 0;
 	int user_pages = 0;
 	int locked = 0;
 	int nr_pages = size >> PAGE_SHIFT;
 	struct page **pages;
+	struct nvidia_p2p_pin_cache_entry *entry;
 
-	if (nr_pages <= 0) {
-		return -EINVAL;
-	}
-
-	*page_table = kzalloc(sizeof(**page_table), GFP_KERNEL);
-	if (!*page_table) {
-		return -ENOMEM;
+	entry = kzalloc(sizeof(*entry), GFP_KERNEL);
+	if (!entry) {
+		return ERR_PTR(-ENOMEM);
 	}
 
 	pages = kcalloc(nr_pages, sizeof(*pages), GFP_KERNEL);
 	if (!pages) {
 		ret = -ENOMEM;
-		goto free_page_table;
+		goto free_entry;
 	}
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 7, 0)
 	down_read(&current->mm->mmap_lock);
@@ -129,35 +254,98 @@ int nvidia_p2p_get_pages(u64 vaddr, u64 size,
 		goto free_pages;
 	}
 
+	entry->mm = current->mm;
+	entry->vaddr = vaddr;
+	entry->size = size;
+	entry->entries = user_pages;
+	entry->pages = pages;
+	INIT_LIST_HEAD(&entry->clients);
+	kref_init(&entry->ref);
+
+	/* Reference owned by the notifier machinery; taken before
+	 * registration since the callbacks can fire as soon as it succeeds.
+	 * On failure the entry was never published, so it is freed directly.
+	 */
+	kref_get(&entry->ref);
+	entry->mn.ops = &nvidia_p2p_mmu_ops;
+	ret = mmu_notifier_register(&entry->mn, entry->mm);
+	if (ret) {
+		goto free_pages;
+	}
+
+	return entry;
+free_pages:
+	while (--user_pages >= 0) {
+		put_page(pages[user_pages]);
+	}
+	kfree(pages);
+free_entry:
+	kfree(entry);
+	return ERR_PTR(ret);
+}
+
+int nvidia_p2p_get_pages(u64 vaddr, u64 size,
+		struct nvidia_p2p_page_table **page_table,
+		void (*free_callback)(void *data), void *data)
+{
+	int nr_pages = size >> PAGE_SHIFT;
+	struct nvidia_p2p_pin_cache_entry *entry;
+
+	if (nr_pages <= 0) {
+		return -EINVAL;
+	}
+
+	*page_table = kzalloc(sizeof(**page_table), GFP_KERNEL);
+	if (!*page_table) {
+		return -ENOMEM;
+	}
+
+	mutex_lock(&pin_cache_lock);
+	entry = nvidia_p2p_pin_cache_find(current->mm, vaddr, size);
+	if (entry) {
+		kref_get(&entry->ref);
+		list_add(&(*page_table)->cache_node, &entry->clients);
+		mutex_unlock(&pin_cache_lock);
+		goto init_page_table;
+	}
+	mutex_unlock(&pin_cache_lock);
+
+	/* Pin and register the notifier outside the lock: faulting the
+	 * pages in may itself trigger invalidation callbacks on this mm.
+	 */
+	entry = nvidia_p2p_pin_cache_create(vaddr, size);
+	if (IS_ERR(entry)) {
+		kfree(*page_table);
+		*page_table = NULL;
+		return PTR_ERR(entry);
+	}
+
+	mutex_lock(&pin_cache_lock);
+	/* A concurrent pinning of the same range may have been inserted
+	 * meanwhile; duplicate entries are benign as each owns its pages
+	 * and notifier, so keep ours rather than re-pinning.
+	 */
+	list_add(&entry->node, &pin_cache);
+	kref_get(&entry->ref);
+	list_add(&(*page_table)->cache_node, &entry->clients);
+	mutex_unlock(&pin_cache_lock);
+
+init_page_table:
 	(*page_table)->version = NVIDIA_P2P_PAGE_TABLE_VERSION;
-	(*page_table)->pages = pages;
-	(*page_table)->entries = user_pages;
+	(*page_table)->pages = entry->pages;
+	(*page_table)->entries = entry->entries;
 	(*page_table)->page_size = NVIDIA_P2P_PAGE_SIZE_4KB;
 	(*page_table)->size = size;
 
-	(*page_table)->mn.ops = &nvidia_p2p_mmu_ops;
-	(*page_table)->mm = current->mm;
+	(*page_table)->cache = entry;
+	(*page_table)->mm = entry->mm;
 	(*page_table)->free_callback = free_callback;
 	(*page_table)->data = data;
 	(*page_table)->vaddr = vaddr;
 	mutex_init(&(*page_table)->lock);
 	(*page_table)->mapped = NVIDIA_P2P_PINNED;
 
-	ret = mmu_notifier_register(&(*page_table)->mn, (*page_table)->mm);
-	if (ret) {
-		goto free_pages;
-	}
-
 	return 0;
-free_pages:
-	while (--user_pages >= 0) {
-		put_page(pages[user_pages]);
-	}
-	kfree(pages);
-free_page_table:
-	kfree(*page_table);
-	*page_table = NULL;
-	return ret;
 }
 EXPORT_SYMBOL(nvidia_p2p_get_pages);
 
@@ -167,7 +355,14 @@ int nvidia_p2p_put_pages(struct nvidia_p2p_page_table *page_table)
 		return -EINVAL;
 	}
 
-	mmu_notifier_unregister(&page_table->mn, page_table->mm);
+	/* Detach from the cache entry; the pinning itself stays cached for
+	 * later re-registration until the range or the mm goes away.
+	 */
+	mutex_lock(&pin_cache_lock);
+	if (!list_empty(&page_table->cache_node)) {
+		list_del_init(&page_table->cache_node);
+	}
+	mutex_unlock(&pin_cache_lock);
 
 	return 0;
 }
@@ -175,9 +370,6 @@ EXPORT_SYMBOL(nvidia_p2p_put_pages);
 
 int nvidia_p2p_free_page_table(struct nvidia_p2p_page_table *page_table)
 {
-	int user_pages = 0;
-	struct page **pages = NULL;
-
 	if (!page_table) {
 		return 0;
 	}
@@ -189,14 +381,15 @@ int nvidia_p2p_free_page_table(struct nvidia_p2p_page_table *page_table)
 	}
 
 	if (page_table->mapped & NVIDIA_P2P_PINNED) {
-		pages = page_table->pages;
-		user_pages = page_table->entries;
-
-		while (--user_pages >= 0) {
-			put_page(pages[user_pages]);
+		/* In case the client skipped nvidia_p2p_put_pages() */
+		mutex_lock(&pin_cache_lock);
+		if (!list_empty(&page_table->cache_node)) {
+			list_del_init(&page_table->cache_node);
 		}
+		mutex_unlock(&pin_cache_lock);
 
-		kfree(pages);
+		kref_put(&page_table->cache->ref, nvidia_p2p_pin_cache_release);
+		page_table->cache = NULL;
 		page_table->mapped &= (u32)~NVIDIA_P2P_PINNED;
 	}
 
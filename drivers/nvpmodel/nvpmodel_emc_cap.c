@@ -70,6 +70,8 @@ struct icc_path *icc_path_handle;
 struct nvpmodel_clk {
 	struct kobj_attribute attr;
 	struct clk *clk;
+	/* last rate requested through sysfs, ULONG_MAX when unknown */
+	unsigned long cap_request;
 };
 
 static struct nvpmodel_clk *clks;
@@ -81,13 +83,11 @@ static ssize_t emc_iso_cap_show(struct kobject *kobj,
 	return sprintf(buf, "%lu\n", emc_iso_cap);
 }
 
-static ssize_t emc_iso_cap_store(struct kobject *kobj,
-				struct kobj_attribute *attr, const char *buf,
-				size_t count)
+static int apply_emc_iso_cap(unsigned long cap)
 {
 	int error = 0;
-	if (sscanf(buf, "%lu", &emc_iso_cap) != 1)
-		return -EINVAL;
+
+	emc_iso_cap = cap;
 #if IS_ENABLED(CONFIG_TEGRA_BWMGR)
 	if (bwmgr_handle != NULL) {
 		error = tegra_bwmgr_set_emc(bwmgr_handle, emc_iso_cap,
@@ -110,6 +110,21 @@ static ssize_t emc_iso_cap_store(struct kobject *kobj,
 		}
 	}
 #endif
+	return 0;
+}
+
+static ssize_t emc_iso_cap_store(struct kobject *kobj,
+				struct kobj_attribute *attr, const char *buf,
+				size_t count)
+{
+	unsigned long cap;
+	int error;
+
+	if (sscanf(buf, "%lu", &cap) != 1)
+		return -EINVAL;
+	error = apply_emc_iso_cap(cap);
+	if (error)
+		return error;
 	return count;
 }
 
@@ -131,17 +146,11 @@ static ssize_t clk_cap_show(struct kobject *kobj,
 	return sprintf(buf, "%ld\n", rate);
 }
 
-static ssize_t clk_cap_store(struct kobject *kobj,
-				struct kobj_attribute *attr, const char *buf,
-				size_t count)
+static int apply_clk_cap(struct nvpmodel_clk *clk, unsigned long request)
 {
-	unsigned long rate;
+	unsigned long rate = request;
 	long rate_signed;
 	int ret;
-	struct nvpmodel_clk *clk = container_of(attr, struct nvpmodel_clk, attr);
-
-	if (sscanf(buf, "%lu", &rate) != 1)
-		return -EINVAL;
 
 	/* Remove previous freq cap to get correct rounted rate for new cap */
 	ret = clk_set_max_rate(clk->clk, UINT_MAX);
@@ -161,9 +170,121 @@ static ssize_t clk_cap_store(struct kobject *kobj,
 		return ret;
 	}
 
+	clk->cap_request = request;
+	return 0;
+}
+
+static ssize_t clk_cap_store(struct kobject *kobj,
+				struct kobj_attribute *attr, const char *buf,
+				size_t count)
+{
+	unsigned long rate;
+	int ret;
+	struct nvpmodel_clk *clk = container_of(attr, struct nvpmodel_clk, attr);
+
+	if (sscanf(buf, "%lu", &rate) != 1)
+		return -EINVAL;
+
+	ret = apply_clk_cap(clk, rate);
+	if (ret)
+		return ret;
+
+	return count;
+}
+
+static ssize_t batch_cap_show(struct kobject *kobj,
+				struct kobj_attribute *attr, char *buf)
+{
+	ssize_t len = 0;
+	int i;
+
+	len += sprintf(buf + len, "emc_iso_cap=%lu\n", emc_iso_cap);
+	for (i = 0; i < num_clocks; i++) {
+		if (!clks[i].clk || !clks[i].attr.attr.name ||
+				clks[i].cap_request == ULONG_MAX)
+			continue;
+		len += sprintf(buf + len, "%s=%lu\n", clks[i].attr.attr.name,
+				clks[i].cap_request);
+	}
+
+	return len;
+}
+
+/* Apply a whole set of caps in one write so that a power model switch
+ * costs a single transition instead of one sysfs write per clock. Input
+ * is whitespace separated name=rate entries, e.g.
+ * "nvenc=192000000 nvdec=0 emc_iso_cap=3200000000". Entries matching the
+ * currently applied request are skipped, so only the delta between two
+ * models is actually programmed. Entries are applied in order and the
+ * first failure aborts the write.
+ */
+static ssize_t batch_cap_store(struct kobject *kobj,
+				struct kobj_attribute *attr, const char *buf,
+				size_t count)
+{
+	char *kbuf, *pos, *entry;
+	int error = 0;
+	int i;
+
+	kbuf = kstrndup(buf, count, GFP_KERNEL);
+	if (!kbuf)
+		return -ENOMEM;
+
+	pos = kbuf;
+	while ((entry = strsep(&pos, " \t\n")) != NULL) {
+		unsigned long rate;
+		char *val;
+
+		if (*entry == '\0')
+			continue;
+
+		val = strchr(entry, '=');
+		if (!val) {
+			error = -EINVAL;
+			break;
+		}
+		*val++ = '\0';
+		if (kstrtoul(val, 10, &rate)) {
+			error = -EINVAL;
+			break;
+		}
+
+		if (!strcmp(entry, "emc_iso_cap")) {
+			error = apply_emc_iso_cap(rate);
+			if (error)
+				break;
+			continue;
+		}
+
+		error = -ENOENT;
+		for (i = 0; i < num_clocks; i++) {
+			if (!clks[i].clk || !clks[i].attr.attr.name ||
+					strcmp(entry, clks[i].attr.attr.name))
+				continue;
+			if (clks[i].cap_request == rate)
+				error = 0;
+			else
+				error = apply_clk_cap(&clks[i], rate);
+			break;
+		}
+		if (error)
+			break;
+	}
+
+	if (error) {
+		pr_err("nvpmodel: batch cap failed at \"%s\" err=%d\n",
+				entry, error);
+		kfree(kbuf);
+		return error;
+	}
+
+	kfree(kbuf);
 	return count;
 }
 
+static struct kobj_attribute batch_cap_attribute =
+	__ATTR(batch_cap, 0660, batch_cap_show, batch_cap_store);
+
 static void free_resources(void)
 {
 	int i;
@@ -249,6 +370,13 @@ static int __init nvpmodel_clk_cap_init(void)
 		goto exit;
 	}
 
+	error = sysfs_create_file(clk_cap_kobject,
+				&batch_cap_attribute.attr);
+	if (error) {
+		pr_err("failed to create batch_cap sysfs: error %d\n", error);
+		goto exit;
+	}
+
 	num_clocks = of_property_count_strings(dn, "clock-names");
 	if (num_clocks <= 0) {
 		num_clocks = 0;
@@ -270,6 +398,7 @@ static int __init nvpmodel_clk_cap_init(void)
 			continue;
 		}
 
+		clks[i].cap_request = ULONG_MAX;
 		clks[i].clk = of_clk_get(dn, i);
 		if (IS_ERR(clks[i].clk)) {
 			clks[i].clk = NULL;
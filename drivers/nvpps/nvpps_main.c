@@ -20,6 +20,7 @@
 #include <linux/module.h>
 #include <linux/slab.h>
 #include <linux/cdev.h>
+#include <linux/mm.h>
 #include <linux/poll.h>
 #include <linux/gpio.h>
 #include <linux/list.h>
@@ -96,6 +97,9 @@ struct nvpps_device_data {
 	u32			tsc_ptp_src;
 	bool		only_timer_mode;
 	s64			ptp_offset;
+
+	/* mmap-able snapshot ring, written under lock */
+	struct nvpps_shm_hdr	*shm_hdr;
 };
 
 
@@ -210,6 +214,42 @@ static inline u64 get_systime(struct nvpps_device_data *pdev_data, u64 *tsc)
 
 
 
+/*
+ * Append the current event to the mmap-able snapshot ring. Called with
+ * pdev_data->lock held so writers are serialized; each ring entry carries
+ * its own sequence count so userspace can detect a torn read without
+ * taking any lock.
+ */
+static void nvpps_shm_update(struct nvpps_device_data *pdev_data)
+{
+	struct nvpps_shm_hdr	*hdr = pdev_data->shm_hdr;
+	struct nvpps_shm_sample	*sample;
+	u32			idx;
+
+	if (!hdr) {
+		return;
+	}
+
+	idx = (hdr->head + 1) & (NVPPS_SHM_RING_SZ - 1);
+	sample = &hdr->samples[idx];
+
+	/* odd seq marks the entry inconsistent while it is rewritten */
+	WRITE_ONCE(sample->seq, sample->seq + 1);
+	smp_wmb();
+	sample->evt_nb = pdev_data->pps_event_id;
+	sample->tsc = pdev_data->tsc;
+	sample->ptp = pdev_data->phc;
+	sample->ptp_offset = pdev_data->ptp_offset;
+	sample->irq_latency = pdev_data->irq_latency;
+	sample->evt_mode = pdev_data->actual_evt_mode;
+	smp_wmb();
+	WRITE_ONCE(sample->seq, sample->seq + 1);
+	/* publish the entry only after it is consistent */
+	smp_wmb();
+	WRITE_ONCE(hdr->head, idx);
+}
+
+
 /*
  * Report the PPS event
  */
@@ -334,6 +374,7 @@ static void nvpps_get_ts(struct nvpps_device_data *pdev_data, bool in_isr)
 	pdev_data->irq_latency = irq_latency;
 	pdev_data->actual_evt_mode = in_isr ? NVPPS_MODE_GPIO : NVPPS_MODE_TIMER;
 	pdev_data->ptp_offset = ptp_offset;
+	nvpps_shm_update(pdev_data);
 	raw_spin_unlock_irqrestore(&pdev_data->lock, flags);
 
 	/* event notification */
@@ -664,6 +705,33 @@ static long nvpps_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
 
 
 
+static int nvpps_mmap(struct file *file, struct vm_area_struct *vma)
+{
+	struct nvpps_file_data		*pfile_data = (struct nvpps_file_data *)file->private_data;
+	struct nvpps_device_data	*pdev_data = pfile_data->pdev_data;
+	unsigned long			size = vma->vm_end - vma->vm_start;
+
+	if (!pdev_data->shm_hdr) {
+		return -ENODEV;
+	}
+
+	if ((size > PAGE_SIZE) || (vma->vm_pgoff != 0)) {
+		return -EINVAL;
+	}
+
+	/* the snapshot ring is written only by the kernel */
+	if (vma->vm_flags & VM_WRITE) {
+		return -EPERM;
+	}
+	vma->vm_flags &= ~VM_MAYWRITE;
+
+	return remap_pfn_range(vma, vma->vm_start,
+			virt_to_phys(pdev_data->shm_hdr) >> PAGE_SHIFT,
+			size, vma->vm_page_prot);
+}
+
+
+
 static int nvpps_open(struct inode *inode, struct file *file)
 {
 	struct nvpps_device_data	*pdev_data = container_of(inode->i_cdev, struct nvpps_device_data, cdev);
@@ -703,6 +771,7 @@ static const struct file_operations nvpps_fops = {
 	.poll		= nvpps_poll,
 	.fasync		= nvpps_fasync,
 	.unlocked_ioctl	= nvpps_ioctl,
+	.mmap		= nvpps_mmap,
 	.open		= nvpps_open,
 	.release	= nvpps_close,
 };
@@ -974,6 +1043,19 @@ static int nvpps_probe(struct platform_device *pdev)
 		}
 	}
 
+	/* snapshot ring shared with userspace through mmap */
+	BUILD_BUG_ON(sizeof(struct nvpps_shm_hdr) > PAGE_SIZE);
+	pdev_data->shm_hdr = (struct nvpps_shm_hdr *)get_zeroed_page(GFP_KERNEL);
+	if (!pdev_data->shm_hdr) {
+		device_destroy(s_nvpps_class, pdev_data->dev->devt);
+		err = -ENOMEM;
+		goto error_ret;
+	}
+	pdev_data->shm_hdr->magic = NVPPS_SHM_MAGIC;
+	pdev_data->shm_hdr->version = NVPPS_SHM_VERSION;
+	pdev_data->shm_hdr->ring_size = NVPPS_SHM_RING_SZ;
+	pdev_data->shm_hdr->tsc_res_ns = pdev_data->tsc_res_ns;
+
 	/* setup PPS event hndler */
 	err = set_mode(pdev_data,
 				   (pdev_data->only_timer_mode) ? NVPPS_MODE_TIMER : NVPPS_MODE_GPIO);
@@ -1022,6 +1104,10 @@ static int nvpps_probe(struct platform_device *pdev)
 	return 0;
 
 error_ret:
+	if (pdev_data->shm_hdr) {
+		free_page((unsigned long)pdev_data->shm_hdr);
+		pdev_data->shm_hdr = NULL;
+	}
 	cdev_del(&pdev_data->cdev);
 	mutex_lock(&s_nvpps_lock);
 	idr_remove(&s_nvpps_idr, pdev_data->id);
@@ -1057,6 +1143,10 @@ static int nvpps_remove(struct platform_device *pdev)
 			iounmap(pdev_data->tsc_reg_map_base);
 		}
 		device_destroy(s_nvpps_class, pdev_data->dev->devt);
+		if (pdev_data->shm_hdr) {
+			free_page((unsigned long)pdev_data->shm_hdr);
+			pdev_data->shm_hdr = NULL;
+		}
 	}
 
 #ifndef NVPPS_NO_DT
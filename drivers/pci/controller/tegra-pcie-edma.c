@@ -5,6 +5,7 @@
  * Copyright (C) 2021-2022 NVIDIA Corporation. All rights reserved.
  */
 
+#include <linux/cpumask.h>
 #include <linux/delay.h>
 #include <linux/dma-iommu.h>
 #include <linux/io.h>
@@ -53,10 +54,25 @@ struct edma_chan {
 	edma_xfer_status_t st;
 };
 
-struct edma_prv {
-	u32 edma_desc_size;
+struct edma_prv;
+
+/** Completion vector: each requested IRQ processes only the channels
+ *  routed to it, so handlers on different vectors can run in parallel.
+ */
+struct edma_irq_slot {
+	struct edma_prv *prv;
 	int irq;
 	char *irq_name;
+	/** write/read channels whose completions this vector carries */
+	u32 ch_mask[2];
+};
+
+struct edma_prv {
+	u32 edma_desc_size;
+	struct edma_irq_slot slots[DMA_WR_CHNL_NUM];
+	u32 num_irqs;
+	/** completion vector index per write/read channel */
+	u8 ch_vec[2][DMA_WR_CHNL_NUM];
 	bool is_remote_dma;
 	uint16_t msi_data;
 	uint64_t msi_addr;
@@ -131,10 +147,14 @@ static inline void edma_hw_init(void *cookie, bool rw_type)
 	if (prv->ch_init & OSI_BIT(rw_type))
 		dma_common_wr(prv->edma_base, WRITE_ENABLE, eng_off[rw_type]);
 
-	/* Program MSI addr & data for remote DMA use case */
+	/* Program MSI addr & data for remote DMA use case. Each channel
+	 * signals the data of its completion vector, msi_data + vector,
+	 * which is the data layout of multi-message MSI and of MSI-X on
+	 * hosts whose table entries share the translator doorbell.
+	 */
 	if (prv->is_remote_dma) {
-		msi_data = prv->msi_data;
-		msi_data |= (msi_data << 16);
+		msi_data = (prv->msi_data + prv->ch_vec[0][0]) |
+			   ((u32)(prv->msi_data + prv->ch_vec[0][1]) << 16);
 
 		dma_common_wr(prv->edma_base, lower_32_bits(prv->msi_addr),
 			      DMA_WRITE_DONE_IMWR_LOW_OFF);
@@ -146,6 +166,8 @@ static inline void edma_hw_init(void *cookie, bool rw_type)
 			      DMA_WRITE_ABORT_IMWR_HIGH_OFF);
 		dma_common_wr(prv->edma_base, msi_data,
 			      DMA_WRITE_CH01_IMWR_DATA_OFF);
+		msi_data = (prv->msi_data + prv->ch_vec[0][2]) |
+			   ((u32)(prv->msi_data + prv->ch_vec[0][3]) << 16);
 		dma_common_wr(prv->edma_base, msi_data,
 			      DMA_WRITE_CH23_IMWR_DATA_OFF);
 
@@ -157,6 +179,8 @@ static inline void edma_hw_init(void *cookie, bool rw_type)
 			      DMA_READ_ABORT_IMWR_LOW_OFF);
 		dma_common_wr(prv->edma_base, upper_32_bits(prv->msi_addr),
 			      DMA_READ_ABORT_IMWR_HIGH_OFF);
+		msi_data = (prv->msi_data + prv->ch_vec[1][0]) |
+			   ((u32)(prv->msi_data + prv->ch_vec[1][1]) << 16);
 		dma_common_wr(prv->edma_base, msi_data,
 			      DMA_READ_CH01_IMWR_DATA_OFF);
 	}
@@ -319,11 +343,13 @@ static irqreturn_t edma_irq(int irq, void *cookie)
 
 static irqreturn_t edma_irq_handler(int irq, void *cookie)
 {
-	struct edma_prv *prv = (struct edma_prv *)cookie;
+	struct edma_irq_slot *slot = (struct edma_irq_slot *)cookie;
+	struct edma_prv *prv = slot->prv;
 	int bit = 0;
 	u32 val, i = 0;
 	struct edma_chan *chan[2] = {&prv->tx[0], &prv->rx[0]};
 	struct edma_chan *ch;
+	unsigned long mask;
 	u32 int_status_off[2] = {DMA_WRITE_INT_STATUS_OFF, DMA_READ_INT_STATUS_OFF};
 	u32 int_clear_off[2] = {DMA_WRITE_INT_CLEAR_OFF, DMA_READ_INT_CLEAR_OFF};
 	u32 mode_cnt[2] = {DMA_WR_CHNL_NUM, DMA_RD_CHNL_NUM};
@@ -332,22 +358,32 @@ static irqreturn_t edma_irq_handler(int irq, void *cookie)
 		if (!(prv->ch_init & OSI_BIT(i)))
 			continue;
 
+		/* Only touch the channels routed to this vector; handlers
+		 * on the other vectors may be running concurrently.
+		 */
+		mask = slot->ch_mask[i];
 		val = dma_common_rd(prv->edma_base, int_status_off[i]);
+		val &= mask | (mask << 16);
 		if ((val & OSI_GENMASK(31, 16)) != 0U) {
 			/**
 			 * If ABORT, immediately update state for all channels as aborted.
 			 * This setting stop further SW queuing
 			 */
 			dev_info(prv->dev, "Abort int status 0x%x", val);
-			for (bit = 0; bit < mode_cnt[i]; bit++) {
+			for_each_set_bit(bit, &mask, mode_cnt[i]) {
 				ch = chan[i] + bit;
 				ch->st = EDMA_XFER_ABORT;
 			}
 
-			edma_hw_deinit(prv, !!i);
+			/* With multiple vectors the engine stays enabled, as
+			 * bouncing it would stall the other vectors' channels;
+			 * the aborted channels are re-initialized below.
+			 */
+			if (prv->num_irqs == 1)
+				edma_hw_deinit(prv, !!i);
 
 			/** Perform abort handling */
-			for (bit = 0; bit < mode_cnt[i]; bit++) {
+			for_each_set_bit(bit, &mask, mode_cnt[i]) {
 				ch = chan[i] + bit;
 				if (!ch->ring)
 					continue;
@@ -366,9 +402,10 @@ static irqreturn_t edma_irq_handler(int irq, void *cookie)
 						prv->is_remote_dma);
 			}
 
-			edma_hw_init(prv, !!i);
+			if (prv->num_irqs == 1)
+				edma_hw_init(prv, !!i);
 		} else {
-			for (bit = 0; bit < mode_cnt[i]; bit++) {
+			for_each_set_bit(bit, &mask, mode_cnt[i]) {
 				ch = chan[i] + bit;
 				if (OSI_BIT(bit) & val) {
 					dma_common_wr(prv->edma_base, OSI_BIT(bit),
@@ -418,7 +455,24 @@ void *tegra_pcie_edma_initialize(struct tegra_pcie_edma_init_info *info)
 			pr_err("%s: msi_irq is out of range\n", __func__);
 			goto free_priv;
 		}
-		prv->irq = (int)info->edma_remote->msi_irq;
+		prv->slots[0].irq = (int)info->edma_remote->msi_irq;
+		prv->num_irqs = 1;
+		if (info->edma_remote->num_msi_irqs > 1) {
+			if (info->edma_remote->num_msi_irqs > DMA_WR_CHNL_NUM) {
+				pr_err("%s: too many msi_irqs\n", __func__);
+				goto free_priv;
+			}
+			for (i = 0; i < info->edma_remote->num_msi_irqs; i++) {
+				if (info->edma_remote->msi_irqs[i] > INT_MAX) {
+					pr_err("%s: msi_irqs[%d] is out of range\n",
+					       __func__, i);
+					goto free_priv;
+				}
+				prv->slots[i].irq =
+					(int)info->edma_remote->msi_irqs[i];
+			}
+			prv->num_irqs = info->edma_remote->num_msi_irqs;
+		}
 		prv->msi_data = info->edma_remote->msi_data;
 		prv->msi_addr = info->edma_remote->msi_addr;
 		prv->is_remote_dma = true;
@@ -453,11 +507,12 @@ void *tegra_pcie_edma_initialize(struct tegra_pcie_edma_init_info *info)
 			goto put_dev;
 		}
 
-		prv->irq = platform_get_irq_byname(pdev, "intr");
-		if (prv->irq <= 0) {
+		prv->slots[0].irq = platform_get_irq_byname(pdev, "intr");
+		if (prv->slots[0].irq <= 0) {
 			dev_err(prv->dev, "failed to get intr interrupt\n");
 			goto put_dev;
 		};
+		prv->num_irqs = 1;
 	} else {
 		pr_err("Neither device node nor edma remote available");
 		goto free_priv;
@@ -508,16 +563,44 @@ void *tegra_pcie_edma_initialize(struct tegra_pcie_edma_init_info *info)
 		}
 	}
 
-	prv->irq_name = kasprintf(GFP_KERNEL, "%s_edma_lib", dev_name(prv->dev));
-	if (!prv->irq_name)
-		goto free_ring;
+	/* Spread write and read channels round-robin over the completion
+	 * vectors and give each vector a default affinity hint spread
+	 * across the present CPUs; per-vector affinity can be overridden
+	 * through /proc/irq/<N>/smp_affinity as usual.
+	 */
+	for (i = 0; i < DMA_WR_CHNL_NUM; i++) {
+		prv->ch_vec[0][i] = i % prv->num_irqs;
+		prv->slots[prv->ch_vec[0][i]].ch_mask[0] |= OSI_BIT(i);
+	}
+	for (i = 0; i < DMA_RD_CHNL_NUM; i++) {
+		prv->ch_vec[1][i] = i % prv->num_irqs;
+		prv->slots[prv->ch_vec[1][i]].ch_mask[1] |= OSI_BIT(i);
+	}
 
-	ret = request_threaded_irq(prv->irq, edma_irq, edma_irq_handler,
-				   IRQF_SHARED,
-				   prv->irq_name, prv);
-	if (ret < 0) {
-		dev_err(prv->dev, "failed to request \"intr\" irq\n");
-		goto free_irq_name;
+	for (i = 0; i < prv->num_irqs; i++) {
+		struct edma_irq_slot *slot = &prv->slots[i];
+
+		slot->prv = prv;
+		slot->irq_name = kasprintf(GFP_KERNEL,
+					   i ? "%s_edma_lib.%d" : "%s_edma_lib",
+					   dev_name(prv->dev), i);
+		if (!slot->irq_name)
+			goto free_irqs;
+
+		ret = request_threaded_irq(slot->irq, edma_irq,
+					   edma_irq_handler, IRQF_SHARED,
+					   slot->irq_name, slot);
+		if (ret < 0) {
+			dev_err(prv->dev, "failed to request \"intr\" irq\n");
+			kfree(slot->irq_name);
+			slot->irq_name = NULL;
+			goto free_irqs;
+		}
+
+		if (prv->num_irqs > 1)
+			irq_set_affinity_hint(slot->irq,
+				cpumask_of(cpumask_local_spread(i,
+						dev_to_node(prv->dev))));
 	}
 
 	for (i = 0; i < DMA_WR_CHNL_NUM; i++) {
@@ -536,9 +619,16 @@ void *tegra_pcie_edma_initialize(struct tegra_pcie_edma_init_info *info)
 
 	return prv;
 
-free_irq_name:
-	kfree(prv->irq_name);
-free_ring:
+free_irqs:
+	for (i = 0; i < prv->num_irqs; i++) {
+		struct edma_irq_slot *slot = &prv->slots[i];
+
+		if (!slot->irq_name)
+			continue;
+		irq_set_affinity_hint(slot->irq, NULL);
+		free_irq(slot->irq, slot);
+		kfree(slot->irq_name);
+	}
 	for (j = 0; j < 2; j++) {
 		for (i = 0; i < mode_cnt[j]; i++) {
 			ch = chan[j] + i;
@@ -568,6 +658,33 @@ free_priv:
 }
 EXPORT_SYMBOL(tegra_pcie_edma_initialize);
 
+/*
+ * Pick the configured channel of the given type with the most room in its
+ * descriptor ring. r_idx/w_idx are sampled without the channel lock, which
+ * is fine for a placement heuristic: a stale value only means a slightly
+ * less balanced choice, never an incorrect submission.
+ */
+static u32 edma_select_chan(struct edma_prv *prv, edma_xfer_type_t type)
+{
+	struct edma_chan *chans = (type == EDMA_XFER_WRITE) ? prv->tx : prv->rx;
+	u32 mode_cnt = (type == EDMA_XFER_WRITE) ? DMA_WR_CHNL_NUM : DMA_RD_CHNL_NUM;
+	u32 i, avail, best_avail = 0;
+	u32 best = mode_cnt;
+
+	for (i = 0; i < mode_cnt; i++) {
+		if (!chans[i].desc_sz)
+			continue;
+		avail = (chans[i].r_idx - chans[i].w_idx - 1U) &
+			(chans[i].desc_sz - 1U);
+		if (best == mode_cnt || avail > best_avail) {
+			best = i;
+			best_avail = avail;
+		}
+	}
+
+	return best;
+}
+
 edma_xfer_status_t tegra_pcie_edma_submit_xfer(void *cookie,
 						struct tegra_pcie_edma_xfer_info *tx_info)
 {
@@ -583,14 +700,21 @@ edma_xfer_status_t tegra_pcie_edma_submit_xfer(void *cookie,
 	u32 int_status_off[2] = {DMA_WRITE_INT_STATUS_OFF, DMA_READ_INT_STATUS_OFF};
 	u32 doorbell_off[2] = {DMA_WRITE_DOORBELL_OFF, DMA_READ_DOORBELL_OFF};
 	u32 mode_cnt[2] = {DMA_WR_CHNL_NUM, DMA_RD_CHNL_NUM};
+	u32 chan_num;
 	bool pcs;
 
-	if (!prv || !tx_info || tx_info->nents == 0 || !tx_info->desc ||
-	    tx_info->channel_num >= mode_cnt[tx_info->type])
+	if (!prv || !tx_info || tx_info->nents == 0 || !tx_info->desc)
 		return EDMA_XFER_FAIL_INVAL_INPUTS;
 
-	ch = (tx_info->type == EDMA_XFER_WRITE) ? &prv->tx[tx_info->channel_num] :
-						  &prv->rx[tx_info->channel_num];
+	chan_num = tx_info->channel_num;
+	if (chan_num == EDMA_CHAN_ANY)
+		chan_num = edma_select_chan(prv, tx_info->type);
+
+	if (chan_num >= mode_cnt[tx_info->type])
+		return EDMA_XFER_FAIL_INVAL_INPUTS;
+
+	ch = (tx_info->type == EDMA_XFER_WRITE) ? &prv->tx[chan_num] :
+						  &prv->rx[chan_num];
 
 	if (!ch->desc_sz)
 		return EDMA_XFER_FAIL_INVAL_INPUTS;
@@ -665,7 +789,7 @@ edma_xfer_status_t tegra_pcie_edma_submit_xfer(void *cookie,
 	/* desc write should not go OOO wrt DMA DB ring */
 	wmb();
 
-	dma_common_wr(prv->edma_base, tx_info->channel_num, doorbell_off[tx_info->type]);
+	dma_common_wr(prv->edma_base, chan_num, doorbell_off[tx_info->type]);
 
 	if (ch->type == EDMA_CHAN_XFER_SYNC) {
 		ret = wait_event_timeout(ch->wq, !ch->busy,
@@ -674,7 +798,7 @@ edma_xfer_status_t tegra_pcie_edma_submit_xfer(void *cookie,
 			/* dummy print to avoid misra-c voilations */
 			dev_dbg(prv->dev, "read back pcs: %d\n", pcs);
 			dev_err(prv->dev, "%s: timeout at %d ch, w_idx(%d), r_idx(%d)\n",
-				__func__, tx_info->channel_num, ch->w_idx,
+				__func__, chan_num, ch->w_idx,
 				ch->r_idx);
 			dev_err(prv->dev, "%s: int status 0x%x", __func__,
 				dma_common_rd(prv->edma_base, int_status_off[tx_info->type]));
@@ -725,9 +849,14 @@ void tegra_pcie_edma_deinit(void *cookie)
 	edma_hw_deinit(cookie, false);
 	edma_hw_deinit(cookie, true);
 
-	synchronize_irq(prv->irq);
-	free_irq(prv->irq, prv);
-	kfree(prv->irq_name);
+	for (i = 0; i < prv->num_irqs; i++) {
+		struct edma_irq_slot *slot = &prv->slots[i];
+
+		irq_set_affinity_hint(slot->irq, NULL);
+		synchronize_irq(slot->irq);
+		free_irq(slot->irq, slot);
+		kfree(slot->irq_name);
+	}
 
 	for (j = 0; j < 2; j++) {
 		for (i = 0; i < mode_cnt[j]; i++) {
@@ -37,6 +37,7 @@
 #include <linux/pm_runtime.h>
 #include <linux/phy/phy.h>
 #include <linux/resource.h>
+#include <linux/workqueue.h>
 #include <linux/version.h>
 #if KERNEL_VERSION(4, 15, 0) > LINUX_VERSION_CODE
 #include <soc/tegra/chip-id.h>
@@ -616,6 +617,15 @@ struct tegra_pcie_dw {
 	struct margin_cmd mcmd;
 	u32 dvfs_tbl[4][4]; /* for x1/x2/x3/x4 and Gen-1/2/3/4 */
 	struct tegra_pcie_of_data *of_data;
+
+	/* link speed governor, see tegra_pcie_link_gov_work() */
+	struct delayed_work gov_work;
+	struct list_head gov_node;
+	bool gov_enabled;
+	u32 gov_idle_ms;
+	atomic_t gov_busy_hint;
+	unsigned long gov_last_busy;	/* jiffies */
+	u32 gov_busy_samples;
 };
 
 struct tegra_pcie_of_data {
@@ -681,6 +691,16 @@ static unsigned int pcie_gen_freq[] = {
 	GEN4_CORE_CLK_FREQ
 };
 
+/* Link speed governor: uptrain to max speed when the data mover is
+ * active, downtrain to Gen-1 once the link has been idle long enough
+ */
+#define LINK_GOV_POLL_MS	100
+#define LINK_GOV_IDLE_MS	500
+#define LINK_GOV_UPTRAIN_SAMPLES	2
+
+static LIST_HEAD(tegra_pcie_gov_list);
+static DEFINE_SPINLOCK(tegra_pcie_gov_lock);
+
 static void tegra_pcie_downstream_dev_to_D0(struct tegra_pcie_dw *pcie);
 static int tegra_pcie_dw_pme_turnoff(struct tegra_pcie_dw *pcie);
 static int tegra_pcie_dw_runtime_suspend(struct device *dev);
@@ -1581,105 +1601,304 @@ static void config_plat_gpio(struct tegra_pcie_dw *pcie, bool flag)
 		gpiod_set_value(gpio_to_desc(pcie->gpios[count]), flag);
 }
 
-static int apply_speed_change(struct seq_file *s, void *data)
+static int tegra_pcie_change_link_speed(struct tegra_pcie_dw *pcie,
+					u32 target_speed)
 {
-	struct tegra_pcie_dw *pcie = (struct tegra_pcie_dw *)(s->private);
+	struct dw_pcie *pci = &pcie->pci;
 	unsigned long start_jiffies;
 	u32 val = 0;
 
-	if (pcie->target_speed > (PCI_EXP_LNKSTA_CLS_8_0GB + 1)) {
-		seq_puts(s, "Invalid target speed. Should be 1 ~ 4\n");
-		return 0;
-	}
+	if (!target_speed || target_speed > (PCI_EXP_LNKSTA_CLS_8_0GB + 1))
+		return -EINVAL;
 
-	dw_pcie_read(pcie->pci.dbi_base + CFG_LINK_STATUS_CONTROL, 4, &val);
-	if (((val >> 16) & PCI_EXP_LNKSTA_CLS) == pcie->target_speed) {
-		seq_puts(s, "Link speed is already the target speed...!\n");
-		return 0;
-	}
+	dw_pcie_read(pci->dbi_base + CFG_LINK_STATUS_CONTROL, 4, &val);
+	if (((val >> 16) & PCI_EXP_LNKSTA_CLS) == target_speed)
+		return -EALREADY;
 
-	if (!tegra_platform_is_fpga() && (pcie->target_speed == 4)) {
+	if (!tegra_platform_is_fpga() && (target_speed == 4)) {
 		u32 temp1 = 0, temp2 = 0;
 
-		dw_pcie_read(pcie->pci.dbi_base + pcie->cap_pl16g_status, 4,
-			     &val);
-		dw_pcie_read(pcie->pci.dbi_base + CFG_LINK_STATUS_CONTROL, 4,
+		dw_pcie_read(pci->dbi_base + pcie->cap_pl16g_status, 4, &val);
+		dw_pcie_read(pci->dbi_base + CFG_LINK_STATUS_CONTROL, 4,
 			     &temp1);
-		dw_pcie_read(pcie->pci.dbi_base + CFG_LINK_STATUS_CONTROL_2, 4,
+		dw_pcie_read(pci->dbi_base + CFG_LINK_STATUS_CONTROL_2, 4,
 			     &temp2);
 
 		if (!((val & CAP_PL16G_STATUS_REG_EQ_16G_CPL) ||
 		      (((temp1 & (PCI_EXP_LNKSTA_CLS << 16)) ==
 			 (PCI_EXP_LNKSTA_CLS_8_0GB << 16)) &&
-			 temp2 & CFG_LINK_STATUS_CONTROL_2_PCIE_CAP_EQ_CPL))) {
-			seq_puts(s, "Gen-3/4 Equalization is not complete\n");
-			return 0;
-		}
+			 temp2 & CFG_LINK_STATUS_CONTROL_2_PCIE_CAP_EQ_CPL)))
+			return -ENODATA;
 	}
 
-	dw_pcie_read(pcie->pci.dbi_base + CFG_LINK_STATUS_CONTROL_2, 4, &val);
+	dw_pcie_read(pci->dbi_base + CFG_LINK_STATUS_CONTROL_2, 4, &val);
 	val &= ~PCI_EXP_LNKSTA_CLS;
-	val |= pcie->target_speed;
-	dw_pcie_write(pcie->pci.dbi_base + CFG_LINK_STATUS_CONTROL_2, 4, val);
+	val |= target_speed;
+	dw_pcie_write(pci->dbi_base + CFG_LINK_STATUS_CONTROL_2, 4, val);
 
 	/* Wait for previous link training to complete */
 	start_jiffies = jiffies;
 	for (;;) {
-		dw_pcie_read(pcie->pci.dbi_base + CFG_LINK_STATUS_CONTROL, 4,
-			     &val);
+		dw_pcie_read(pci->dbi_base + CFG_LINK_STATUS_CONTROL, 4, &val);
 		if (!(val & CFG_LINK_STATUS_LT))
 			break;
 		if (time_after(jiffies, start_jiffies +
-		    msecs_to_jiffies(1000))) {
-			seq_puts(s, "Link Retrain Timeout\n");
+		    msecs_to_jiffies(1000)))
 			break;
-		}
 		usleep_range(1000, 1100);
 	}
-	if (val & CFG_LINK_STATUS_LT) {
-		seq_puts(s, "Previous link training didn't complete\n");
-		return 0;
-	}
+	if (val & CFG_LINK_STATUS_LT)
+		return -EBUSY;
 
 	/* Clear BW Management Status */
-	dw_pcie_read(pcie->pci.dbi_base + CFG_LINK_STATUS_CONTROL, 4, &val);
+	dw_pcie_read(pci->dbi_base + CFG_LINK_STATUS_CONTROL, 4, &val);
 	val |= CFG_LINK_STATUS_BW_MAN_STATUS;
-	dw_pcie_write(pcie->pci.dbi_base + CFG_LINK_STATUS_CONTROL, 4, val);
+	dw_pcie_write(pci->dbi_base + CFG_LINK_STATUS_CONTROL, 4, val);
 
-	dw_pcie_read(pcie->pci.dbi_base + CFG_LINK_STATUS_CONTROL, 4, &val);
-	val |= CFG_LINK_CONTROL_LT;
-	dw_pcie_write(pcie->pci.dbi_base + CFG_LINK_STATUS_CONTROL, 4, val);
+	if (pcie->mode == DW_PCIE_EP_TYPE) {
+		/* EPs can't set the retrain bit; request an autonomous
+		 * rate change through the LTSSM instead
+		 */
+		dw_pcie_read(pci->dbi_base + PORT_LOGIC_GEN2_CTRL, 4, &val);
+		val &= ~PORT_LOGIC_GEN2_CTRL_DIRECT_SPEED_CHANGE;
+		dw_pcie_write(pci->dbi_base + PORT_LOGIC_GEN2_CTRL, 4, val);
+		val |= PORT_LOGIC_GEN2_CTRL_DIRECT_SPEED_CHANGE;
+		dw_pcie_write(pci->dbi_base + PORT_LOGIC_GEN2_CTRL, 4, val);
+	} else {
+		dw_pcie_read(pci->dbi_base + CFG_LINK_STATUS_CONTROL, 4, &val);
+		val |= CFG_LINK_CONTROL_LT;
+		dw_pcie_write(pci->dbi_base + CFG_LINK_STATUS_CONTROL, 4, val);
+	}
 
 	/* Wait for link training end. Break out after waiting for timeout */
 	start_jiffies = jiffies;
 	for (;;) {
-		dw_pcie_read(pcie->pci.dbi_base + CFG_LINK_STATUS_CONTROL, 4,
-			     &val);
+		dw_pcie_read(pci->dbi_base + CFG_LINK_STATUS_CONTROL, 4, &val);
 		if (val & CFG_LINK_STATUS_BW_MAN_STATUS)
 			break;
 		if (time_after(jiffies, start_jiffies +
-		     msecs_to_jiffies(1000))) {
-			seq_puts(s, "Bandwidth Management Status Timeout\n");
-			break;
-		}
+		     msecs_to_jiffies(1000)))
+			return -ETIMEDOUT;
 		usleep_range(1000, 1100);
 	}
 
 	/* Give 20ms time for new link status to appear in LnkSta register */
 	msleep(20);
 
-	dw_pcie_read(pcie->pci.dbi_base + CFG_LINK_STATUS_CONTROL, 4, &val);
-	if (((val >> 16) & PCI_EXP_LNKSTA_CLS) == pcie->target_speed) {
+	dw_pcie_read(pci->dbi_base + CFG_LINK_STATUS_CONTROL, 4, &val);
+	if (((val >> 16) & PCI_EXP_LNKSTA_CLS) != target_speed) {
+		dev_dbg(pcie->dev, "Link settled for Gen-%u\n",
+			(val >> 16) & PCI_EXP_LNKSTA_CLS);
+		return -EAGAIN;
+	}
+
+	return 0;
+}
+
+static int apply_speed_change(struct seq_file *s, void *data)
+{
+	struct tegra_pcie_dw *pcie = (struct tegra_pcie_dw *)(s->private);
+	u32 val = 0;
+
+	switch (tegra_pcie_change_link_speed(pcie, pcie->target_speed)) {
+	case 0:
 		seq_puts(s, "Link speed is successful...!\n");
-	} else {
+		break;
+	case -EINVAL:
+		seq_puts(s, "Invalid target speed. Should be 1 ~ 4\n");
+		break;
+	case -EALREADY:
+		seq_puts(s, "Link speed is already the target speed...!\n");
+		break;
+	case -ENODATA:
+		seq_puts(s, "Gen-3/4 Equalization is not complete\n");
+		break;
+	case -EBUSY:
+		seq_puts(s, "Previous link training didn't complete\n");
+		break;
+	case -ETIMEDOUT:
+		seq_puts(s, "Bandwidth Management Status Timeout\n");
+		break;
+	default:
+		dw_pcie_read(pcie->pci.dbi_base + CFG_LINK_STATUS_CONTROL, 4,
+			     &val);
 		seq_puts(s, "Link speed change failed...");
 		seq_printf(s, "Settled for Gen-%u\n", (val >> 16) &
 			   PCI_EXP_LNKSTA_CLS);
+		break;
 	}
 
 	return 0;
 }
 
+/* Re-request the EMC floor and core clock for the current link speed */
+static void tegra_pcie_gov_update_clks(struct tegra_pcie_dw *pcie)
+{
+	struct dw_pcie *pci = &pcie->pci;
+	u32 val = 0, width = 0, speed = 0;
+	unsigned long freq;
+
+	dw_pcie_read(pci->dbi_base + CFG_LINK_STATUS_CONTROL, 4, &val);
+	width = ((val >> 16) & PCI_EXP_LNKSTA_NLW) >> 4;
+	width = find_first_bit((const unsigned long *)&width,
+			       sizeof(width));
+	speed = ((val >> 16) & PCI_EXP_LNKSTA_CLS);
+	if (!speed || speed > ARRAY_SIZE(pcie_gen_freq))
+		return;
+	freq = pcie->dvfs_tbl[width][speed - 1];
+	dev_dbg(pcie->dev, "EMC Freq requested = %lu\n", freq);
+
+	if (!IS_ERR_OR_NULL(pcie->emc_bw)) {
+		if (tegra_bwmgr_set_emc(pcie->emc_bw, freq,
+					TEGRA_BWMGR_SET_EMC_FLOOR))
+			dev_err(pcie->dev, "can't set emc clock[%lu]\n", freq);
+	} else if (!IS_ERR_OR_NULL(pcie->icc_bwmgr_path)) {
+		if (icc_set_bw(pcie->icc_bwmgr_path, 0, FREQ2ICC(freq)))
+			dev_err(pcie->dev, "can't set emc clock[%lu]\n", freq);
+	}
+
+	clk_set_rate(pcie->core_clk, pcie_gen_freq[speed - 1]);
+}
+
+static void tegra_pcie_link_gov_work(struct work_struct *work)
+{
+	struct tegra_pcie_dw *pcie = container_of(work, struct tegra_pcie_dw,
+						  gov_work.work);
+	u32 val = 0, speed, ltssm;
+	u32 max_speed = pcie->max_speed ?: (PCI_EXP_LNKSTA_CLS_8_0GB + 1);
+	bool busy;
+
+	dw_pcie_read(pcie->pci.dbi_base + CFG_LINK_STATUS_CONTROL, 4, &val);
+	speed = (val >> 16) & PCI_EXP_LNKSTA_CLS;
+	if (!speed || speed > (PCI_EXP_LNKSTA_CLS_8_0GB + 1))
+		goto resched;	/* link is not up */
+
+	/* ASPM parks an idle link in L1; sampling the LTSSM in L0 here
+	 * means TLPs are in flight
+	 */
+	ltssm = (readl(pcie->appl_base + APPL_DEBUG) &
+		 APPL_DEBUG_LTSSM_STATE_MASK) >> APPL_DEBUG_LTSSM_STATE_SHIFT;
+	busy = (ltssm == APPL_DEBUG_PM_LINKST_IN_L0);
+
+	if (atomic_xchg(&pcie->gov_busy_hint, 0)) {
+		pcie->gov_busy_samples = LINK_GOV_UPTRAIN_SAMPLES;
+		pcie->gov_last_busy = jiffies;
+	} else if (busy) {
+		if (pcie->gov_busy_samples < LINK_GOV_UPTRAIN_SAMPLES)
+			pcie->gov_busy_samples++;
+		pcie->gov_last_busy = jiffies;
+	} else {
+		pcie->gov_busy_samples = 0;
+	}
+
+	if (pcie->gov_busy_samples >= LINK_GOV_UPTRAIN_SAMPLES &&
+	    speed < max_speed) {
+		if (!tegra_pcie_change_link_speed(pcie, max_speed))
+			tegra_pcie_gov_update_clks(pcie);
+	} else if (speed > 1 && !busy &&
+		   time_after(jiffies, pcie->gov_last_busy +
+			      msecs_to_jiffies(pcie->gov_idle_ms))) {
+		if (!tegra_pcie_change_link_speed(pcie, 1))
+			tegra_pcie_gov_update_clks(pcie);
+	}
+
+resched:
+	if (pcie->gov_enabled)
+		schedule_delayed_work(&pcie->gov_work,
+				      msecs_to_jiffies(LINK_GOV_POLL_MS));
+}
+
+/* Activity hint from a data mover (e.g. an endpoint DMA queue crossing
+ * its occupancy watermark). @dev must be the controller's device. Safe
+ * to call from atomic context.
+ */
+void tegra_pcie_link_speed_hint(struct device *dev, bool busy)
+{
+	struct tegra_pcie_dw *pcie;
+	unsigned long flags;
+
+	spin_lock_irqsave(&tegra_pcie_gov_lock, flags);
+	list_for_each_entry(pcie, &tegra_pcie_gov_list, gov_node) {
+		if (pcie->dev != dev)
+			continue;
+		if (pcie->gov_enabled) {
+			pcie->gov_last_busy = jiffies;
+			if (busy && !atomic_xchg(&pcie->gov_busy_hint, 1))
+				mod_delayed_work(system_wq, &pcie->gov_work, 0);
+		}
+		break;
+	}
+	spin_unlock_irqrestore(&tegra_pcie_gov_lock, flags);
+}
+EXPORT_SYMBOL(tegra_pcie_link_speed_hint);
+
+static ssize_t link_speed_governor_store(struct device *dev,
+					 struct device_attribute *attr,
+					 const char *buf, size_t count)
+{
+	struct tegra_pcie_dw *pcie = dev_get_drvdata(dev);
+	bool enable;
+
+	if (kstrtobool(buf, &enable))
+		return -EINVAL;
+
+	/* rate changes would trip the monitored core clock */
+	if (pcie->is_safety_platform)
+		return -EOPNOTSUPP;
+
+	if (enable && !pcie->gov_enabled) {
+		pcie->gov_last_busy = jiffies;
+		pcie->gov_busy_samples = 0;
+		pcie->gov_enabled = true;
+		schedule_delayed_work(&pcie->gov_work,
+				      msecs_to_jiffies(LINK_GOV_POLL_MS));
+	} else if (!enable && pcie->gov_enabled) {
+		pcie->gov_enabled = false;
+		cancel_delayed_work_sync(&pcie->gov_work);
+		/* leave the link at full speed */
+		if (!tegra_pcie_change_link_speed(pcie, pcie->max_speed ?:
+					(PCI_EXP_LNKSTA_CLS_8_0GB + 1)))
+			tegra_pcie_gov_update_clks(pcie);
+	}
+
+	return count;
+}
+
+static ssize_t link_speed_governor_show(struct device *dev,
+					struct device_attribute *attr,
+					char *buf)
+{
+	struct tegra_pcie_dw *pcie = dev_get_drvdata(dev);
+
+	return sprintf(buf, "%d\n", pcie->gov_enabled);
+}
+static DEVICE_ATTR_RW(link_speed_governor);
+
+static ssize_t link_gov_idle_ms_store(struct device *dev,
+				      struct device_attribute *attr,
+				      const char *buf, size_t count)
+{
+	struct tegra_pcie_dw *pcie = dev_get_drvdata(dev);
+	u32 val;
+
+	if (kstrtou32(buf, 0, &val) || !val)
+		return -EINVAL;
+
+	pcie->gov_idle_ms = val;
+
+	return count;
+}
+
+static ssize_t link_gov_idle_ms_show(struct device *dev,
+				     struct device_attribute *attr,
+				     char *buf)
+{
+	struct tegra_pcie_dw *pcie = dev_get_drvdata(dev);
+
+	return sprintf(buf, "%u\n", pcie->gov_idle_ms);
+}
+static DEVICE_ATTR_RW(link_gov_idle_ms);
+
 static int apply_pme_turnoff(struct seq_file *s, void *data)
 {
 	struct tegra_pcie_dw *pcie = (struct tegra_pcie_dw *)(s->private);
@@ -4596,14 +4815,44 @@ static int tegra_pcie_dw_probe(struct platform_device *pdev)
 
 	platform_set_drvdata(pdev, pcie);
 
+	INIT_DELAYED_WORK(&pcie->gov_work, tegra_pcie_link_gov_work);
+	pcie->gov_idle_ms = LINK_GOV_IDLE_MS;
+	atomic_set(&pcie->gov_busy_hint, 0);
+	spin_lock(&tegra_pcie_gov_lock);
+	list_add_tail(&pcie->gov_node, &tegra_pcie_gov_list);
+	spin_unlock(&tegra_pcie_gov_lock);
+
+	ret = device_create_file(pcie->dev, &dev_attr_link_speed_governor);
+	if (!ret)
+		ret = device_create_file(pcie->dev, &dev_attr_link_gov_idle_ms);
+	if (ret) {
+		dev_err(pcie->dev, "link governor sysfs creation failed\n");
+		ret = 0;
+	}
+
 	if (pcie->mode == DW_PCIE_RC_TYPE) {
 		ret = tegra_pcie_config_rp(pcie);
 		if (ret == -ENOMEDIUM)
 			ret = 0;
+		if (ret)
+			goto fail_gov;
 	} else if (pcie->mode == DW_PCIE_EP_TYPE) {
 		tegra_pcie_config_ep(pcie, pdev);
 	}
 
+	return 0;
+
+fail_gov:
+	/* unwind the governor state so no stale node is left on the
+	 * global list for tegra_pcie_link_speed_hint() to traverse */
+	device_remove_file(pcie->dev, &dev_attr_link_gov_idle_ms);
+	device_remove_file(pcie->dev, &dev_attr_link_speed_governor);
+	pcie->gov_enabled = false;
+	cancel_delayed_work_sync(&pcie->gov_work);
+	spin_lock(&tegra_pcie_gov_lock);
+	list_del(&pcie->gov_node);
+	spin_unlock(&tegra_pcie_gov_lock);
+
 	return ret;
 }
 
@@ -4718,6 +4967,14 @@ static int tegra_pcie_dw_remove(struct platform_device *pdev)
 {
 	struct tegra_pcie_dw *pcie = platform_get_drvdata(pdev);
 
+	spin_lock(&tegra_pcie_gov_lock);
+	list_del(&pcie->gov_node);
+	spin_unlock(&tegra_pcie_gov_lock);
+	pcie->gov_enabled = false;
+	cancel_delayed_work_sync(&pcie->gov_work);
+	device_remove_file(pcie->dev, &dev_attr_link_gov_idle_ms);
+	device_remove_file(pcie->dev, &dev_attr_link_speed_governor);
+
 	if (pcie->mode == DW_PCIE_RC_TYPE) {
 		if (!pcie->link_state && pcie->power_down_en)
 			return 0;
@@ -5004,6 +5261,10 @@ static int tegra_pcie_dw_suspend_noirq(struct device *dev)
 	struct tegra_pcie_dw *pcie = dev_get_drvdata(dev);
 	int ret = 0;
 
+	/* The governor polls DBI and APPL registers; stop it before the
+	 * core clock is gated and the resets are asserted */
+	cancel_delayed_work_sync(&pcie->gov_work);
+
 	if (pcie->mode == DW_PCIE_EP_TYPE)
 		return 0;
 
@@ -5228,6 +5489,14 @@ static int tegra_pcie_dw_resume_early(struct device *dev)
 		writel(val, pcie->appl_base + APPL_CTRL);
 	}
 
+	/* Restart the polling stopped in suspend_noirq() */
+	if (pcie->gov_enabled) {
+		pcie->gov_busy_samples = 0;
+		pcie->gov_last_busy = jiffies;
+		schedule_delayed_work(&pcie->gov_work,
+				      msecs_to_jiffies(LINK_GOV_POLL_MS));
+	}
+
 	return 0;
 }
 
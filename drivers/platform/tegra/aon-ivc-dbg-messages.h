@@ -94,7 +94,16 @@ enum aon_mods {
  */
 enum aon_ping {
 	AON_PING_TEST = 8,
-	AON_REQUEST_TYPE_MAX = 11,
+	AON_REQUEST_TYPE_MAX = 12,
+};
+
+/* The following enum indicates the stats publication request from
+ * ccplex to SPE. It hands the firmware a shared buffer into which it
+ * periodically writes its stats, so that steady-state sampling does
+ * not need an IVC round-trip per query.
+ */
+enum aon_stats {
+	AON_STATS_BUFFER = 12,
 };
 
 /* The following enum indicates if we are reading from or writing
@@ -206,6 +215,41 @@ struct aon_mods_crc_xfer {
 	uint32_t crc;
 };
 
+/* This struct is used to hand the firmware a buffer for periodic stats
+ * publication and to set the publication period.
+ * Fields:
+ * flag:	to indicate read or write
+ * period_ms:	publication interval in ms, 0 disables publication
+ * addr:	address of the buffer the firmware publishes into
+ * size:	size of the buffer in bytes
+ */
+struct aon_stats_buffer_xfer {
+	/* enum aon_xfer_flag */
+	u32 flag;
+	u32 period_ms;
+	u64 addr;
+	u32 size;
+};
+
+/* Layout of the buffer handed over with AON_STATS_BUFFER. The firmware
+ * increments seqcnt before and after each update, so the value is odd
+ * while an update is in flight; readers snapshot the page and retry if
+ * seqcnt changed or was odd.
+ * Fields:
+ * seqcnt:		update sequence count, odd during an update
+ * sc8_count:		number of times SPE entered SC8
+ * state_durations:	time spent in each power state, in ms
+ * state_entry_counts:	number of times each power state is entered
+ * update_count:	number of publications since enabled
+ */
+struct aon_stats_page {
+	u32 seqcnt;
+	u32 sc8_count;
+	u64 state_durations[6];
+	u32 state_entry_counts[6];
+	u64 update_count;
+};
+
 /* This struct is used to extract the firmware version of the SPE.
  * Fields:
  * data:	buffer to store the version string. Uses u8
@@ -242,6 +286,7 @@ struct aon_dbg_request {
 		struct aon_pm_dbg_xfer pm_xfer;
 		struct aon_mods_xfer mods_xfer;
 		struct aon_ping_xfer ping_xfer;
+		struct aon_stats_buffer_xfer stats_xfer;
 	} data;
 };
 
@@ -262,6 +307,7 @@ struct aon_dbg_response {
 		struct aon_pm_dbg_xfer pm_xfer;
 		struct aon_ping_xfer ping_xfer;
 		struct aon_mods_crc_xfer crc_xfer;
+		struct aon_stats_buffer_xfer stats_xfer;
 	} data;
 };
 
@@ -218,6 +218,11 @@ static u32 get_raw_cnt(void __iomem *base)
 	return __raw_readl(base + ACTMON_DEV_COUNT);
 }
 
+static u32 get_cum_cnt(void __iomem *base)
+{
+	return __raw_readl(base + ACTMON_DEV_CUMULATIVE_COUNT);
+}
+
 static void enb_dev_wm(u32 *val)
 {
 	*val |= (ACTMON_DEV_INTR_UP_WMARK_ENB |
@@ -258,6 +263,7 @@ static void actmon_dev_reg_ops_init(struct actmon_dev *adev)
 	adev->ops.get_dev_intr_enb = get_dev_intr;
 	adev->ops.get_avg_cnt = get_avg_cnt;
 	adev->ops.get_raw_cnt = get_raw_cnt;
+	adev->ops.get_cum_cnt = get_cum_cnt;
 	adev->ops.enb_dev_wm = enb_dev_wm;
 	adev->ops.disb_dev_up_wm = disb_dev_up_wm;
 	adev->ops.disb_dev_dn_wm = disb_dev_dn_wm;
@@ -22,6 +22,10 @@
 #include <linux/debugfs.h>
 #include <linux/cpuhotplug.h>
 #include <linux/string.h>
+#include <linux/kthread.h>
+#include <linux/wait.h>
+#include <linux/atomic.h>
+#include <linux/percpu.h>
 
 static LIST_HEAD(core_ras_list);
 static DEFINE_RAW_SPINLOCK(core_ras_lock);
@@ -502,6 +506,237 @@ static void ras_unregister_core_ers(void)
 		unregister_core_er(&core_ers[i].rec);
 }
 
+/*
+ * Correctable errors are captured raw in the FHI handler and decoded
+ * from a kthread. During correctable error storms the synchronous
+ * decode and printing used to run entirely in interrupt context and
+ * induced jitter in latency sensitive tasks; the handler is now
+ * bounded to a few system register reads, the write-to-clear of the
+ * status register and one ring slot store per error.
+ *
+ * The FHI interrupt is per core with forced affinity, so each CPU
+ * owns a single producer ring and the decode thread is the only
+ * consumer. The uncorrectable SERR path is left synchronous: those
+ * errors are fatal and may never reach a thread.
+ */
+#define FHI_RING_SIZE		256 /* power of two */
+#define FHI_RING_MASK		(FHI_RING_SIZE - 1)
+/* full decodes per drain pass before falling back to summaries */
+#define FHI_STORM_BATCH		16
+#define FHI_STORM_BUCKETS	16
+
+struct carmel_raw_error {
+	struct error_record *record;
+	u64 status;
+	u64 misc0;
+	u64 misc1;
+	u64 addr;
+	u64 errx;
+};
+
+struct fhi_cpu_ring {
+	struct carmel_raw_error slots[FHI_RING_SIZE];
+	u64 head; /* written by the owning CPU in interrupt context */
+	u64 tail; /* written by the decode thread */
+};
+
+struct fhi_storm_bucket {
+	struct error_record *record;
+	u16 ierr;
+	u64 count;
+};
+
+static DEFINE_PER_CPU(struct fhi_cpu_ring, fhi_ring);
+static atomic64_t fhi_dropped = ATOMIC64_INIT(0);
+static struct task_struct *fhi_decode_task;
+static DECLARE_WAIT_QUEUE_HEAD(fhi_decode_wait);
+
+/*
+ * Capture one correctable error record into this CPU's ring and ack
+ * it. Runs in the FHI handler with the record already selected in
+ * ERRSELR; full decode and printing happen in the decode thread.
+ */
+static void fhi_capture_record(struct error_record *record, u64 status,
+				u64 errx)
+{
+	struct fhi_cpu_ring *ring = this_cpu_ptr(&fhi_ring);
+	struct carmel_raw_error *raw;
+	u64 err_status, head;
+
+	err_status = ERRi_STATUS_VALID | ERRi_STATUS_CE;
+	if (status & ERRi_STATUS_OF)
+		err_status |= ERRi_STATUS_OF;
+	if (status & ERRi_STATUS_UE)
+		err_status |= ERRi_STATUS_UE | ERRi_STATUS_UET;
+
+	head = ring->head;
+	if (head - READ_ONCE(ring->tail) >= FHI_RING_SIZE) {
+		/* ring full; count the drop but still ack the error */
+		atomic64_inc(&fhi_dropped);
+		if (status & ERRi_STATUS_MV)
+			err_status |= ERRi_STATUS_MV;
+		if (status & ERRi_STATUS_AV)
+			err_status |= ERRi_STATUS_AV;
+		ras_write_error_status(err_status);
+		return;
+	}
+
+	raw = &ring->slots[head & FHI_RING_MASK];
+	raw->record = record;
+	raw->status = status;
+	raw->errx = errx;
+	if (status & ERRi_STATUS_MV) {
+		raw->misc0 = ras_read_error_misc0();
+		raw->misc1 = ras_read_error_misc1();
+		err_status |= ERRi_STATUS_MV;
+	}
+	if (status & ERRi_STATUS_AV) {
+		raw->addr = ras_read_error_address();
+		err_status |= ERRi_STATUS_AV;
+	}
+
+	ras_write_error_status(err_status);
+
+	smp_store_release(&ring->head, head + 1);
+}
+
+/* Decode and print a captured record, mirroring print_error_record()
+ * except that the status registers were read and cleared at capture
+ * time. The generic SERR field is printed numerically as the name
+ * table is private to the arm64_ras core.
+ */
+static void fhi_decode_record(struct carmel_raw_error *raw)
+{
+	struct ras_error *errors = raw->record->errors;
+	u16 ierr = get_error_status_ierr(raw->status);
+	int found = 0;
+	u64 i;
+
+	pr_crit("**************************************\n");
+	pr_crit("RAS Error in %s, ERRSELR_EL1=%llu:\n",
+		raw->record->name, raw->errx);
+	pr_crit("\tStatus = 0x%llx\n", raw->status);
+
+	if (errors) {
+		for (i = 0; errors[i].name; i++) {
+			if (errors[i].error_code == ierr) {
+				pr_crit("\tIERR = %s: 0x%x\n",
+					errors[i].name, ierr);
+				found = 1;
+				break;
+			}
+		}
+		if (!found)
+			pr_crit("\tUnknown IERR: 0x%x\n", ierr);
+	} else {
+		pr_crit("\tBank does not have any known IERR errors\n");
+	}
+
+	pr_crit("\tSERR = 0x%x\n", (u16)get_error_status_serr(raw->status));
+
+	if (raw->status & ERRi_STATUS_OF)
+		pr_crit("\tOverflow (there may be more errors)\n");
+	if (get_error_status_ce(raw->status))
+		pr_crit("\tCorrectable Error\n");
+	if (raw->status & ERRi_STATUS_MV) {
+		pr_crit("\tMISC0 = 0x%llx\n", raw->misc0);
+		pr_crit("\tMISC1 = 0x%llx\n", raw->misc1);
+	}
+	if (raw->status & ERRi_STATUS_AV)
+		pr_crit("\tADDR = 0x%llx\n", raw->addr);
+	pr_crit("**************************************\n");
+}
+
+static bool fhi_ring_pending(void)
+{
+	int cpu;
+
+	for_each_possible_cpu(cpu) {
+		struct fhi_cpu_ring *ring = &per_cpu(fhi_ring, cpu);
+
+		if (READ_ONCE(ring->head) != READ_ONCE(ring->tail))
+			return true;
+	}
+
+	return atomic64_read(&fhi_dropped) != 0;
+}
+
+/* Drain all per-CPU rings. The first FHI_STORM_BATCH errors of a pass
+ * are decoded in full; the remainder of a storm is summarized as one
+ * count per (record, IERR) pair.
+ */
+static void fhi_drain_rings(void)
+{
+	struct fhi_storm_bucket buckets[FHI_STORM_BUCKETS];
+	struct carmel_raw_error raw;
+	int decoded = 0, nbuckets = 0;
+	u64 head, tail, uncategorized = 0, dropped;
+	int cpu, i;
+
+	for_each_possible_cpu(cpu) {
+		struct fhi_cpu_ring *ring = &per_cpu(fhi_ring, cpu);
+
+		tail = ring->tail;
+		head = smp_load_acquire(&ring->head);
+		while (tail != head) {
+			raw = ring->slots[tail & FHI_RING_MASK];
+			smp_store_release(&ring->tail, ++tail);
+
+			if (decoded < FHI_STORM_BATCH) {
+				fhi_decode_record(&raw);
+				decoded++;
+				continue;
+			}
+
+			for (i = 0; i < nbuckets; i++) {
+				if (buckets[i].record == raw.record &&
+					buckets[i].ierr ==
+					get_error_status_ierr(raw.status)) {
+					buckets[i].count++;
+					break;
+				}
+			}
+			if (i < nbuckets)
+				continue;
+			if (nbuckets < FHI_STORM_BUCKETS) {
+				buckets[nbuckets].record = raw.record;
+				buckets[nbuckets].ierr =
+					get_error_status_ierr(raw.status);
+				buckets[nbuckets].count = 1;
+				nbuckets++;
+			} else {
+				uncategorized++;
+			}
+		}
+	}
+
+	for (i = 0; i < nbuckets; i++)
+		pr_crit("RAS: storm: %s IERR 0x%x x %llu\n",
+			buckets[i].record->name, buckets[i].ierr,
+			buckets[i].count);
+	if (uncategorized)
+		pr_crit("RAS: storm: %llu further correctable errors\n",
+			uncategorized);
+
+	dropped = atomic64_xchg(&fhi_dropped, 0);
+	if (dropped)
+		pr_crit("RAS: storm: %llu correctable errors dropped\n",
+			dropped);
+}
+
+static int fhi_decode_thread(void *data)
+{
+	while (!kthread_should_stop()) {
+		wait_event_interruptible(fhi_decode_wait,
+			fhi_ring_pending() || kthread_should_stop());
+		if (kthread_should_stop())
+			break;
+		fhi_drain_rings();
+	}
+
+	return 0;
+}
+
 /*
  * This is used to handle FHI or Correctable Errors triggered from
  * error records per core.
@@ -512,7 +747,7 @@ static void handle_fhi_core(void)
 	int cpu, errx;
 	struct error_record *record;
 
-	pr_info("%s: Scanning Core Error Records for Correctable Errors\n",
+	pr_debug("%s: Scanning Core Error Records for Correctable Errors\n",
 		__func__);
 	/* scan all CPU's per core error records */
 	for_each_online_cpu(cpu) {
@@ -528,7 +763,7 @@ static void handle_fhi_core(void)
 			err_status = ras_read_error_status();
 			if (get_error_status_ce(err_status) &&
 				(err_status & ERRi_STATUS_VALID))
-				print_error_record(record, err_status, errx);
+				fhi_capture_record(record, err_status, errx);
 		}
 	}
 }
@@ -612,7 +847,7 @@ static void handle_fhi_corecluster(void)
 	int cpu, errx;
 	struct error_record *record;
 
-	pr_info("%s:Scanning CoreCluster Error Records for Correctable Errors\n",
+	pr_debug("%s:Scanning CoreCluster Error Records for Correctable Errors\n",
 		__func__);
 	for_each_online_cpu(cpu) {
 		if (!tegra_is_cpu_carmel(cpu))
@@ -626,7 +861,7 @@ static void handle_fhi_corecluster(void)
 
 			if (get_error_status_ce(err_status) &&
 				(err_status & ERRi_STATUS_VALID))
-				print_error_record(record, err_status, errx);
+				fhi_capture_record(record, err_status, errx);
 		}
 	}
 }
@@ -705,7 +940,7 @@ static void handle_fhi_ccplex(void)
 	if (!is_this_ras_cpu())
 		return;
 
-	pr_info("%s: Scanning CCPLEX Error Records for Correctable Errors\n",
+	pr_debug("%s: Scanning CCPLEX Error Records for Correctable Errors\n",
 		__func__);
 
 	list_for_each_entry(record, &ccplex_ras_list, node) {
@@ -714,7 +949,7 @@ static void handle_fhi_ccplex(void)
 
 		if (get_error_status_ce(err_status) &&
 			(err_status & ERRi_STATUS_VALID))
-			print_error_record(record, err_status, record->errx);
+			fhi_capture_record(record, err_status, record->errx);
 	}
 }
 
@@ -727,6 +962,8 @@ static void carmel_fhi_callback(void)
 	handle_fhi_core();
 	handle_fhi_corecluster();
 	handle_fhi_ccplex();
+
+	wake_up_interruptible(&fhi_decode_wait);
 }
 
 static struct ras_fhi_callback fhi_callback = {
@@ -1057,10 +1294,19 @@ static int ras_carmel_probe(struct platform_device *pdev)
 	ras_register_corecluster_ers();
 	ras_register_ccplex_ers();
 
+	/* decode thread must exist before the first FHI can capture */
+	fhi_decode_task = kthread_run(fhi_decode_thread, NULL,
+					"carmel_ras_decode");
+	if (IS_ERR(fhi_decode_task)) {
+		dev_err(dev, "Failed to start decode thread\n");
+		return PTR_ERR(fhi_decode_task);
+	}
+
 	/* register FHI callback for Correctable Errors */
 	ret = register_fhi_callback(&fhi_callback, pdev);
 	if (ret) {
 		dev_err(dev, "Failed to register FHI callback\n");
+		kthread_stop(fhi_decode_task);
 		return -ENOENT;
 	}
 
@@ -1093,6 +1339,8 @@ static int ras_carmel_remove(struct platform_device *pdev)
 {
 	unregister_fhi_callback(&fhi_callback);
 
+	kthread_stop(fhi_decode_task);
+
 	unregister_serr_hook(&core_serr_callback);
 	unregister_serr_hook(&corecluster_serr_callback);
 	unregister_serr_hook(&ccplex_serr_callback);
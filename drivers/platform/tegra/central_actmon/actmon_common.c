@@ -26,6 +26,10 @@
 #include <linux/kobject.h>
 #include <linux/sysfs.h>
 #include <linux/version.h>
+#include <linux/ktime.h>
+#include <linux/math64.h>
+#include <linux/mutex.h>
+#include <linux/workqueue.h>
 
 #include <linux/platform/tegra/actmon_common.h>
 #include <linux/platform/tegra/mc_utils.h>
@@ -431,6 +435,223 @@ static int down_wmark_set(void *data, u64 val)
 DEFINE_SIMPLE_ATTRIBUTE(down_wmark_fops,
 	down_wmark_get, down_wmark_set, "%llu\n");
 
+/*
+ * Capture windows: latch the cumulative activity counters, let a
+ * configurable window elapse and attribute the MC traffic measured in
+ * it. The monitors only distinguish CPU initiated traffic from the
+ * aggregate, so the remaining records pair the measurement with the
+ * per-client bandwidth requests registered with bwmgr.
+ */
+#define CAPTURE_REC_NAME_SZ	16
+/* record types */
+#define CAPTURE_MEASURED	0	/* derived from an activity counter */
+#define CAPTURE_REQUESTED	1	/* bwmgr client request */
+
+struct actmon_capture_rec {
+	char name[CAPTURE_REC_NAME_SZ];
+	u64 kbps;
+	u32 type;
+	u32 reserved;
+};
+
+static void actmon_capture_work(struct work_struct *work);
+
+static struct actmon_capture {
+	struct mutex lock;
+	struct delayed_work work;
+	u64 start_ns;
+	u32 start_cum[MAX_DEVICES];
+	u32 window_ms;
+	bool running;
+	u32 nr_recs;
+	struct actmon_capture_rec recs[MAX_DEVICES + 1 +
+		TEGRA_BWMGR_CLIENT_COUNT];
+} capture = {
+	.lock = __MUTEX_INITIALIZER(capture.lock),
+	.work = __DELAYED_WORK_INITIALIZER(capture.work,
+		actmon_capture_work, 0),
+	.window_ms = 100,
+};
+
+static void actmon_capture_add_rec(const char *name, u64 kbps, u32 type)
+{
+	struct actmon_capture_rec *rec = &capture.recs[capture.nr_recs++];
+
+	strscpy(rec->name, name, sizeof(rec->name));
+	rec->kbps = kbps;
+	rec->type = type;
+	rec->reserved = 0;
+}
+
+static void actmon_capture_work(struct work_struct *work)
+{
+	u64 kbps[MAX_DEVICES] = {0};
+	bool valid[MAX_DEVICES] = {false};
+	unsigned long flags, bw, iso_bw;
+	u32 elapsed_ms;
+	const char *name;
+	int i;
+
+	mutex_lock(&capture.lock);
+
+	elapsed_ms = div64_u64(ktime_get_ns() - capture.start_ns,
+		NSEC_PER_MSEC);
+	if (!elapsed_ms)
+		elapsed_ms = 1;
+	capture.nr_recs = 0;
+
+	for (i = 0; i < MAX_DEVICES; i++) {
+		struct actmon_dev *adev = &actmon->devices[i];
+		u32 delta;
+
+		if (!adev->dn || adev->state != ACTMON_ON ||
+		    adev->type != ACTMON_FREQ_SAMPLER ||
+		    !adev->ops.get_cum_cnt)
+			continue;
+
+		spin_lock_irqsave(&adev->lock, flags);
+		delta = adev->ops.get_cum_cnt(offs(adev->reg_offs)) -
+			capture.start_cum[i];
+		spin_unlock_irqrestore(&adev->lock, flags);
+
+		/*
+		 * A frequency sampler counts one pulse per client clock,
+		 * so the cumulative delta divided by the window length in
+		 * ms is the average frequency in KHz.
+		 */
+		kbps[i] = emc_freq_to_bw(delta / elapsed_ms);
+		valid[i] = true;
+		actmon_capture_add_rec(adev->dev_name, kbps[i],
+			CAPTURE_MEASURED);
+	}
+
+	if (valid[MC_ALL] && valid[MC_CPU])
+		actmon_capture_add_rec("mc_other",
+			kbps[MC_ALL] > kbps[MC_CPU] ?
+			kbps[MC_ALL] - kbps[MC_CPU] : 0,
+			CAPTURE_MEASURED);
+
+	for (i = 0; i < TEGRA_BWMGR_CLIENT_COUNT; i++) {
+		if (tegra_bwmgr_get_client_request(i, &name, &bw, &iso_bw))
+			continue;
+		if (!bw && !iso_bw)
+			continue;
+		/* requests are emc rates in Hz */
+		actmon_capture_add_rec(name,
+			emc_freq_to_bw((bw + iso_bw) / 1000),
+			CAPTURE_REQUESTED);
+	}
+
+	capture.running = false;
+	mutex_unlock(&capture.lock);
+}
+
+static int capture_trigger_set(void *data, u64 val)
+{
+	unsigned long flags;
+	int i;
+
+	if (!val)
+		return -EINVAL;
+
+	mutex_lock(&capture.lock);
+
+	if (capture.running) {
+		mutex_unlock(&capture.lock);
+		return -EBUSY;
+	}
+
+	capture.start_ns = ktime_get_ns();
+	for (i = 0; i < MAX_DEVICES; i++) {
+		struct actmon_dev *adev = &actmon->devices[i];
+
+		if (!adev->dn || adev->state != ACTMON_ON ||
+		    !adev->ops.get_cum_cnt)
+			continue;
+
+		spin_lock_irqsave(&adev->lock, flags);
+		capture.start_cum[i] =
+			adev->ops.get_cum_cnt(offs(adev->reg_offs));
+		spin_unlock_irqrestore(&adev->lock, flags);
+	}
+
+	capture.running = true;
+	schedule_delayed_work(&capture.work,
+		msecs_to_jiffies(capture.window_ms));
+
+	mutex_unlock(&capture.lock);
+	return 0;
+}
+DEFINE_SIMPLE_ATTRIBUTE(capture_trigger_fops, NULL,
+	capture_trigger_set, "%llu\n");
+
+static int capture_window_get(void *data, u64 *val)
+{
+	*val = capture.window_ms;
+	return 0;
+}
+
+static int capture_window_set(void *data, u64 val)
+{
+	if (!val || val > 10000)
+		return -EINVAL;
+
+	mutex_lock(&capture.lock);
+	capture.window_ms = (u32)val;
+	mutex_unlock(&capture.lock);
+	return 0;
+}
+DEFINE_SIMPLE_ATTRIBUTE(capture_window_fops, capture_window_get,
+	capture_window_set, "%llu\n");
+
+static ssize_t capture_records_read(struct file *file, char __user *buf,
+	size_t count, loff_t *ppos)
+{
+	ssize_t ret;
+
+	mutex_lock(&capture.lock);
+	if (capture.running)
+		ret = -EAGAIN;
+	else
+		ret = simple_read_from_buffer(buf, count, ppos,
+			capture.recs,
+			capture.nr_recs * sizeof(capture.recs[0]));
+	mutex_unlock(&capture.lock);
+	return ret;
+}
+
+static const struct file_operations capture_records_fops = {
+	.open		= simple_open,
+	.read		= capture_records_read,
+	.llseek		= default_llseek,
+};
+
+static int actmon_capture_debugfs_init(void)
+{
+	struct dentry *dir, *d;
+
+	dir = debugfs_create_dir("capture", dbgfs_root);
+	if (!dir)
+		return -ENOMEM;
+
+	d = debugfs_create_file("window_ms", RW_MODE, dir, NULL,
+		&capture_window_fops);
+	if (!d)
+		return -ENOMEM;
+
+	d = debugfs_create_file("trigger", S_IWUSR, dir, NULL,
+		&capture_trigger_fops);
+	if (!d)
+		return -ENOMEM;
+
+	d = debugfs_create_file("records", RO_MODE, dir, NULL,
+		&capture_records_fops);
+	if (!d)
+		return -ENOMEM;
+
+	return 0;
+}
+
 static int actmon_debugfs_create_dev(struct actmon_dev *dev)
 {
 	struct dentry *dir, *d;
@@ -512,6 +733,10 @@ static int actmon_debugfs_init(void)
 	if (!d)
 		goto err_out;
 
+	ret = actmon_capture_debugfs_init();
+	if (ret)
+		goto err_out;
+
 	for (i = 0; i < MAX_DEVICES; i++) {
 		if (actmon->devices[i].dn) {
 			ret = actmon_debugfs_create_dev(&actmon->devices[i]);
@@ -641,6 +866,16 @@ static irqreturn_t actmon_dev_fn(int irq, void *dev_id)
 	freq = do_percent(freq, dev->avg_sustain_coef);
 	freq += dev->boost_freq;
 
+	/* Fold in a pending client hint: the hinted demand has not reached
+	 * the monitor counters yet, so keep it as a floor until it expires
+	 */
+	if (dev->hint_freq) {
+		if (time_after(jiffies, dev->hint_expires))
+			dev->hint_freq = 0;
+		else
+			freq = max(freq, dev->hint_freq);
+	}
+
 	dev->target_freq = freq;
 
 	spin_unlock_irqrestore(&dev->lock, flags);
@@ -1031,6 +1266,50 @@ static int actmon_reset_deinit(struct platform_device *pdev)
 	return ret;
 }
 
+/**
+ * tegra_actmon_hint - post an expected-bandwidth hint for an actmon device
+ * @dev_id: device the hint applies to, MC_ALL for aggregate memory traffic
+ * @freq_khz: expected frequency demand in kHz, clamped to the device max
+ * @duration_ms: how long the hint stays valid
+ *
+ * Kernel clients that know a memory burst is about to land (e.g. a job
+ * submission to a just-woken engine) call this to pre-ramp the target
+ * frequency instead of waiting for the activity monitors to observe the
+ * burst two sample periods later. The hint acts as a floor on governor
+ * decisions until it expires, and the rate is raised right away rather
+ * than on the next sample boundary. May sleep, call in process context.
+ */
+int tegra_actmon_hint(enum actmon_devices dev_id, unsigned long freq_khz,
+	unsigned int duration_ms)
+{
+	struct actmon_dev *dev;
+	unsigned long flags, freq;
+
+	if (!actmon || dev_id >= MAX_DEVICES)
+		return -ENODEV;
+
+	dev = &actmon->devices[dev_id];
+	if (!dev->dn || dev->state != ACTMON_ON)
+		return -ENODEV;
+
+	freq_khz = min(freq_khz, dev->max_freq);
+
+	spin_lock_irqsave(&dev->lock, flags);
+	dev->hint_freq = freq_khz;
+	dev->hint_expires = jiffies + msecs_to_jiffies(duration_ms);
+	freq = max(dev->target_freq, freq_khz);
+	dev->target_freq = freq;
+	spin_unlock_irqrestore(&dev->lock, flags);
+
+	dev_dbg(mon_dev, "%s(kHz): hint: %lu for %ums\n", dev->dev_name,
+		freq_khz, duration_ms);
+
+	dev->actmon_dev_set_rate(dev, freq);
+
+	return 0;
+}
+EXPORT_SYMBOL_GPL(tegra_actmon_hint);
+
 int tegra_actmon_register(struct actmon_drv_data *actmon_data)
 {
 	struct device_node *dn = NULL;
@@ -1116,6 +1395,7 @@ int tegra_actmon_remove(struct platform_device *pdev)
 	int i;
 
 #ifdef CONFIG_DEBUG_FS
+	cancel_delayed_work_sync(&capture.work);
 	debugfs_remove_recursive(dbgfs_root);
 #endif
 
@@ -294,6 +294,7 @@ static int nvcvnas_debugfs_init(struct cvnas_device *dev)
 	debugfs_create_size_t("cvsram_size", S_IRUGO, root, &dev->cvsram_size);
 	debugfs_create_file("cvsram_perf_counters", S_IRUGO, root, dev, &cvsram_perf_fops);
 	debugfs_create_file("inject_cvsram_ecc_error", S_IRUGO, root, dev, &cvsram_ecc_err_fops);
+	nvcvnas_partition_debugfs_init(root);
 	dev->debugfs_root = root;
 	return 0;
 }
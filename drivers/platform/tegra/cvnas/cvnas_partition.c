@@ -0,0 +1,292 @@
+/*
+ * drivers/platform/tegra/cvnas/cvnas_partition.c
+ *
+ * CVSRAM dynamic partition manager
+ *
+ * Copyright (C) 2022, NVIDIA Corporation.  All rights reserved.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ */
+
+#ifdef pr_fmt
+#undef pr_fmt
+#endif
+
+#define pr_fmt(fmt) "cvnas: %s,%d" fmt, __func__, __LINE__
+
+#include <linux/cvnas.h>
+#include <linux/slab.h>
+#include <linux/list.h>
+#include <linux/mutex.h>
+#include <linux/module.h>
+#include <linux/debugfs.h>
+#include <linux/seq_file.h>
+
+/*
+ * Named sub-regions of the CVSRAM carveout, so time-multiplexed stages
+ * share the SRAM instead of statically splitting it.  Partitions are
+ * carved first-fit from the carveout and are never relocated; a grow
+ * extends a partition in place into the free gap after it.  When space
+ * runs out, every other partition's eviction callback is asked to give
+ * some back (typically by shrinking or destroying its partition) and
+ * the allocation is retried once.
+ */
+
+/* partitions sorted by base address */
+static LIST_HEAD(cvnas_partitions);
+/* protects the partition list, sizes and usage counters */
+static DEFINE_MUTEX(cvnas_partition_lock);
+/* partitions holding a runtime pm reference on the SRAM */
+static int cvnas_partition_cnt;
+
+static phys_addr_t cvnas_partition_find_gap(phys_addr_t base, size_t size,
+				size_t needed)
+{
+	struct nvcvnas_partition *part;
+	phys_addr_t gap_start = base;
+
+	list_for_each_entry(part, &cvnas_partitions, node) {
+		if (part->base - gap_start >= needed)
+			return gap_start;
+		gap_start = part->base + part->size;
+	}
+
+	if (base + size - gap_start >= needed)
+		return gap_start;
+
+	return 0;
+}
+
+static void cvnas_partition_insert(struct nvcvnas_partition *new)
+{
+	struct nvcvnas_partition *part;
+
+	list_for_each_entry(part, &cvnas_partitions, node) {
+		if (part->base > new->base) {
+			list_add_tail(&new->node, &part->node);
+			return;
+		}
+	}
+	list_add_tail(&new->node, &cvnas_partitions);
+}
+
+/*
+ * Ask every partition except @skip to give back @needed bytes.
+ * Called without the partition lock so that callbacks may shrink or
+ * destroy their own partitions.  Returns the number of cooperating
+ * clients, 0 when nobody could help.
+ */
+static int cvnas_partition_reclaim(struct nvcvnas_partition *skip,
+				size_t needed)
+{
+	struct nvcvnas_partition *part, *tmp;
+	int evicted = 0;
+
+	mutex_lock(&cvnas_partition_lock);
+	list_for_each_entry_safe(part, tmp, &cvnas_partitions, node) {
+		if (part == skip || !part->evict)
+			continue;
+		mutex_unlock(&cvnas_partition_lock);
+		if (part->evict(part, needed, part->ctx) == 0)
+			evicted++;
+		mutex_lock(&cvnas_partition_lock);
+	}
+	mutex_unlock(&cvnas_partition_lock);
+
+	return evicted;
+}
+
+struct nvcvnas_partition *nvcvnas_partition_create(const char *name,
+		size_t size,
+		int (*evict)(struct nvcvnas_partition *part,
+				size_t needed, void *ctx),
+		void *ctx)
+{
+	struct nvcvnas_partition *part;
+	phys_addr_t cvsram_base, base;
+	size_t cvsram_size;
+	int retried = 0;
+	int ret;
+
+	if (!is_nvcvnas_probed() || !name || !size)
+		return ERR_PTR(-EINVAL);
+
+	cvsram_base = nvcvnas_get_cvsram_base();
+	cvsram_size = nvcvnas_get_cvsram_size();
+	if (size > cvsram_size)
+		return ERR_PTR(-ENOMEM);
+
+	part = kzalloc(sizeof(*part), GFP_KERNEL);
+	if (!part)
+		return ERR_PTR(-ENOMEM);
+
+	strscpy(part->name, name, sizeof(part->name));
+	part->size = size;
+	part->evict = evict;
+	part->ctx = ctx;
+
+	mutex_lock(&cvnas_partition_lock);
+retry:
+	base = cvnas_partition_find_gap(cvsram_base, cvsram_size, size);
+	if (!base) {
+		mutex_unlock(&cvnas_partition_lock);
+		if (!retried && cvnas_partition_reclaim(NULL, size)) {
+			retried = 1;
+			mutex_lock(&cvnas_partition_lock);
+			goto retry;
+		}
+		kfree(part);
+		return ERR_PTR(-ENOMEM);
+	}
+
+	part->base = base;
+	cvnas_partition_insert(part);
+
+	if (cvnas_partition_cnt++ == 0) {
+		ret = nvcvnas_busy();
+		if (ret < 0) {
+			cvnas_partition_cnt--;
+			list_del(&part->node);
+			mutex_unlock(&cvnas_partition_lock);
+			kfree(part);
+			return ERR_PTR(ret);
+		}
+	}
+	mutex_unlock(&cvnas_partition_lock);
+
+	return part;
+}
+EXPORT_SYMBOL(nvcvnas_partition_create);
+
+void nvcvnas_partition_destroy(struct nvcvnas_partition *part)
+{
+	if (!part)
+		return;
+
+	mutex_lock(&cvnas_partition_lock);
+	list_del(&part->node);
+	if (--cvnas_partition_cnt == 0)
+		nvcvnas_idle();
+	mutex_unlock(&cvnas_partition_lock);
+
+	kfree(part);
+}
+EXPORT_SYMBOL(nvcvnas_partition_destroy);
+
+int nvcvnas_partition_resize(struct nvcvnas_partition *part, size_t new_size)
+{
+	struct nvcvnas_partition *next;
+	phys_addr_t limit;
+	int retried = 0;
+
+	if (!part || !new_size)
+		return -EINVAL;
+
+	mutex_lock(&cvnas_partition_lock);
+retry:
+	if (new_size <= part->size) {
+		if (new_size < part->used) {
+			mutex_unlock(&cvnas_partition_lock);
+			return -EBUSY;
+		}
+		part->size = new_size;
+		mutex_unlock(&cvnas_partition_lock);
+		return 0;
+	}
+
+	/* grow in place into the gap after us */
+	if (list_is_last(&part->node, &cvnas_partitions))
+		limit = nvcvnas_get_cvsram_base() + nvcvnas_get_cvsram_size();
+	else {
+		next = list_next_entry(part, node);
+		limit = next->base;
+	}
+
+	if (part->base + new_size > limit) {
+		mutex_unlock(&cvnas_partition_lock);
+		if (!retried && cvnas_partition_reclaim(part,
+					new_size - part->size)) {
+			retried = 1;
+			mutex_lock(&cvnas_partition_lock);
+			goto retry;
+		}
+		return -ENOMEM;
+	}
+
+	part->size = new_size;
+	mutex_unlock(&cvnas_partition_lock);
+	return 0;
+}
+EXPORT_SYMBOL(nvcvnas_partition_resize);
+
+phys_addr_t nvcvnas_partition_base(struct nvcvnas_partition *part)
+{
+	return part ? part->base : 0;
+}
+EXPORT_SYMBOL(nvcvnas_partition_base);
+
+size_t nvcvnas_partition_size(struct nvcvnas_partition *part)
+{
+	return part ? part->size : 0;
+}
+EXPORT_SYMBOL(nvcvnas_partition_size);
+
+int nvcvnas_partition_account(struct nvcvnas_partition *part, ssize_t bytes)
+{
+	if (!part)
+		return -EINVAL;
+
+	mutex_lock(&cvnas_partition_lock);
+	if (bytes > 0 && part->used + bytes > part->size) {
+		mutex_unlock(&cvnas_partition_lock);
+		return -ENOMEM;
+	}
+	if (bytes < 0 && part->used < (size_t)-bytes) {
+		mutex_unlock(&cvnas_partition_lock);
+		return -EINVAL;
+	}
+	part->used += bytes;
+	mutex_unlock(&cvnas_partition_lock);
+	return 0;
+}
+EXPORT_SYMBOL(nvcvnas_partition_account);
+
+static int cvnas_partitions_show(struct seq_file *s, void *data)
+{
+	struct nvcvnas_partition *part;
+
+	mutex_lock(&cvnas_partition_lock);
+	list_for_each_entry(part, &cvnas_partitions, node) {
+		seq_printf(s, "%-16s base=%pa size=%zu used=%zu\n",
+				part->name, &part->base,
+				part->size, part->used);
+	}
+	mutex_unlock(&cvnas_partition_lock);
+	return 0;
+}
+
+static int cvnas_partitions_open(struct inode *inode, struct file *file)
+{
+	return single_open(file, cvnas_partitions_show, inode->i_private);
+}
+
+static const struct file_operations cvnas_partitions_fops = {
+	.open = cvnas_partitions_open,
+	.read = seq_read,
+	.llseek = seq_lseek,
+	.release = single_release,
+};
+
+void nvcvnas_partition_debugfs_init(struct dentry *root)
+{
+	debugfs_create_file("partitions", S_IRUGO, root, NULL,
+				&cvnas_partitions_fops);
+}
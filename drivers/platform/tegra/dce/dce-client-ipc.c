@@ -30,6 +30,7 @@ static uint32_t dce_interface_type_map[DCE_CLIENT_IPC_TYPE_MAX] = {
 
 static void dce_client_process_event_ipc(struct tegra_dce *d,
 					 struct tegra_dce_client_ipc *cl);
+static void dce_client_async_send_work(struct work_struct *data);
 
 static inline uint32_t dce_client_get_type(uint32_t int_type)
 {
@@ -193,6 +194,17 @@ int tegra_dce_register_ipc_client(u32 type,
 		goto out;
 	}
 
+	ret = dce_mutex_init(&cl->async_lock);
+	if (ret) {
+		dce_err(d, "dce async lock initialization failed for int_type: [%u]",
+			int_type);
+		dce_cond_destroy(&cl->recv_wait);
+		goto out;
+	}
+
+	INIT_LIST_HEAD(&cl->async_pending);
+	INIT_WORK(&cl->async_send_work, dce_client_async_send_work);
+
 	d->d_clients[type] = cl;
 
 out:
@@ -210,8 +222,26 @@ EXPORT_SYMBOL(tegra_dce_register_ipc_client);
 int tegra_dce_unregister_ipc_client(u32 handle)
 {
 	struct tegra_dce_client_ipc *cl;
+	struct dce_async_cmd *cmd;
 
 	cl = &client_handles[client_handle_to_index(handle)];
+
+	/* drain in-flight work, then fail whatever is still queued */
+	cancel_work_sync(&cl->async_send_work);
+
+	dce_mutex_lock(&cl->async_lock);
+	while (!list_empty(&cl->async_pending)) {
+		cmd = list_first_entry(&cl->async_pending,
+				       struct dce_async_cmd, node);
+		list_del(&cmd->node);
+		cmd->in_use = false;
+		if (cmd->done_fn != NULL)
+			cmd->done_fn(cl->handle, cmd->seq, -ECANCELED,
+				     cmd->msg, cmd->data);
+	}
+	dce_mutex_unlock(&cl->async_lock);
+
+	dce_mutex_destroy(&cl->async_lock);
 	dce_cond_destroy(&cl->recv_wait);
 
 	return dce_client_ipc_handle_free(handle);
@@ -241,6 +271,84 @@ out:
 }
 EXPORT_SYMBOL(tegra_dce_client_ipc_send_recv);
 
+static void dce_client_async_send_work(struct work_struct *data)
+{
+	struct tegra_dce_client_ipc *cl = container_of(data,
+					struct tegra_dce_client_ipc,
+					async_send_work);
+	struct dce_async_cmd *cmd;
+	int status;
+
+	for (;;) {
+		dce_mutex_lock(&cl->async_lock);
+		if (list_empty(&cl->async_pending)) {
+			dce_mutex_unlock(&cl->async_lock);
+			break;
+		}
+		cmd = list_first_entry(&cl->async_pending,
+				       struct dce_async_cmd, node);
+		list_del(&cmd->node);
+		dce_mutex_unlock(&cl->async_lock);
+
+		status = dce_ipc_send_message_sync(cl->d, cl->int_type,
+						   cmd->msg);
+
+		if (cmd->done_fn != NULL)
+			cmd->done_fn(cl->handle, cmd->seq, status,
+				     cmd->msg, cmd->data);
+
+		dce_mutex_lock(&cl->async_lock);
+		cmd->in_use = false;
+		dce_mutex_unlock(&cl->async_lock);
+	}
+}
+
+int tegra_dce_client_ipc_send_async(u32 handle, struct dce_ipc_message *msg,
+		tegra_dce_client_ipc_done_t done_fn, void *usr_ctx, u32 *seqp)
+{
+	struct tegra_dce_client_ipc *cl;
+	struct dce_async_cmd *cmd = NULL;
+	u32 index;
+
+	if (msg == NULL)
+		return -EINVAL;
+
+	cl = dce_client_ipc_lookup_handle(handle);
+	if (cl == NULL)
+		return -EINVAL;
+
+	dce_mutex_lock(&cl->async_lock);
+
+	for (index = 0; index < DCE_CLIENT_ASYNC_CMDS; index++) {
+		if (cl->async_cmds[index].in_use == false) {
+			cmd = &cl->async_cmds[index];
+			break;
+		}
+	}
+
+	if (cmd == NULL) {
+		dce_mutex_unlock(&cl->async_lock);
+		return -EBUSY;
+	}
+
+	cmd->in_use = true;
+	cmd->msg = msg;
+	cmd->done_fn = done_fn;
+	cmd->data = usr_ctx;
+	cmd->seq = ++cl->async_seq;
+	list_add_tail(&cmd->node, &cl->async_pending);
+
+	if (seqp != NULL)
+		*seqp = cmd->seq;
+
+	dce_mutex_unlock(&cl->async_lock);
+
+	queue_work(cl->d->d_async_ipc.async_event_wq, &cl->async_send_work);
+
+	return 0;
+}
+EXPORT_SYMBOL(tegra_dce_client_ipc_send_async);
+
 int dce_client_init(struct tegra_dce *d)
 {
 	int ret = 0;
@@ -16,6 +16,27 @@
 
 #include <linux/platform/tegra/dce/dce-client-ipc.h>
 
+/**
+ * struct dce_async_cmd - one slot of a client's async command ring
+ *
+ * @node : list node on the client's pending queue
+ * @msg : message being sent/received
+ * @seq : correlation id handed back to the submitter
+ * @done_fn : completion callback
+ * @data : submitter context for the completion callback
+ * @in_use : slot is occupied
+ */
+struct dce_async_cmd {
+	struct list_head node;
+	struct dce_ipc_message *msg;
+	u32 seq;
+	tegra_dce_client_ipc_done_t done_fn;
+	void *data;
+	bool in_use;
+};
+
+#define DCE_CLIENT_ASYNC_CMDS	16
+
 /**
  * struct tegra_dce_client_ipc - Data Structure to hold client specific ipc
  *				data pertaining to IPC type
@@ -32,6 +53,11 @@
  * @complete : atomic variable used for IPC synchronization
  * @callback_fn : function pointer to the callback function passed by the
  *                client during registration
+ * @async_cmds : slots for queued async commands
+ * @async_pending : queue of submitted but not yet completed commands
+ * @async_lock : protects the async slots, queue and sequence counter
+ * @async_seq : correlation id of the last submitted async command
+ * @async_send_work : drains the pending queue on the dce async workqueue
  */
 struct tegra_dce_client_ipc {
 	bool valid;
@@ -43,6 +69,11 @@ struct tegra_dce_client_ipc {
 	struct dce_cond recv_wait;
 	atomic_t complete;
 	tegra_dce_client_ipc_callback_t callback_fn;
+	struct dce_async_cmd async_cmds[DCE_CLIENT_ASYNC_CMDS];
+	struct list_head async_pending;
+	struct dce_mutex async_lock;
+	u32 async_seq;
+	struct work_struct async_send_work;
 };
 
 #define DCE_MAX_ASYNC_WORK	8
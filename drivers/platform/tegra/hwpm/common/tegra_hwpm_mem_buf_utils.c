@@ -13,6 +13,7 @@
 
 #include <linux/mm.h>
 #include <linux/vmalloc.h>
+#include <linux/hrtimer.h>
 #include <linux/kernel.h>
 #include <linux/uaccess.h>
 #include <linux/slab.h>
@@ -202,12 +203,76 @@ fail:
 	return ret;
 }
 
+static enum hrtimer_restart tegra_hwpm_sample_timer_fn(struct hrtimer *timer)
+{
+	struct tegra_soc_hwpm *hwpm =
+		container_of(timer, struct tegra_soc_hwpm, sample_timer);
+	int ret = 0;
+
+	/*
+	 * Refresh the MEM_BYTES buffer so that userspace sees an up to date
+	 * stream byte count without issuing UPDATE_GET_PUT for every sampling
+	 * window. PMA registers are direct MMIO, hence safe in timer context.
+	 */
+	ret = hwpm->active_chip->stream_mem_bytes(hwpm);
+	if (ret != 0) {
+		tegra_hwpm_err(hwpm, "Trigger mem_bytes streaming failed");
+		return HRTIMER_NORESTART;
+	}
+
+	hrtimer_forward_now(timer, ns_to_ktime(hwpm->sample_interval_ns));
+	return HRTIMER_RESTART;
+}
+
+void tegra_hwpm_sample_timer_init(struct tegra_soc_hwpm *hwpm)
+{
+	hrtimer_init(&hwpm->sample_timer, CLOCK_MONOTONIC, HRTIMER_MODE_REL);
+	hwpm->sample_timer.function = tegra_hwpm_sample_timer_fn;
+}
+
+void tegra_hwpm_sample_timer_stop(struct tegra_soc_hwpm *hwpm)
+{
+	hrtimer_cancel(&hwpm->sample_timer);
+	hwpm->sample_interval_ns = 0ULL;
+}
+
+int tegra_hwpm_set_periodic_sample(struct tegra_soc_hwpm *hwpm,
+	struct tegra_soc_hwpm_periodic_sample *periodic_sample)
+{
+	tegra_hwpm_fn(hwpm, " ");
+
+	if (periodic_sample->interval_ns == 0ULL) {
+		tegra_hwpm_sample_timer_stop(hwpm);
+		return 0;
+	}
+
+	if (periodic_sample->interval_ns <
+		TEGRA_SOC_HWPM_SAMPLE_INTERVAL_MIN_NS) {
+		periodic_sample->interval_ns =
+			TEGRA_SOC_HWPM_SAMPLE_INTERVAL_MIN_NS;
+	}
+	hwpm->sample_interval_ns = periodic_sample->interval_ns;
+
+	tegra_hwpm_dbg(hwpm, hwpm_dbg_update_get_put,
+		"periodic sampling interval = %llu ns",
+		hwpm->sample_interval_ns);
+
+	/* Restarting an already queued timer applies the new interval */
+	hrtimer_start(&hwpm->sample_timer,
+		ns_to_ktime(hwpm->sample_interval_ns), HRTIMER_MODE_REL);
+
+	return 0;
+}
+
 int tegra_hwpm_clear_mem_pipeline(struct tegra_soc_hwpm *hwpm)
 {
 	int ret = 0;
 
 	tegra_hwpm_fn(hwpm, " ");
 
+	/* Stop periodic sampling before tearing down the stream */
+	tegra_hwpm_sample_timer_stop(hwpm);
+
 	/* Stream MEM_BYTES to clear pipeline */
 	if (hwpm->mem_bytes_kernel) {
 		s32 timeout_msecs = 1000;
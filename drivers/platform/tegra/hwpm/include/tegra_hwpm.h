@@ -18,6 +18,7 @@
 #include <linux/device.h>
 #include <linux/cdev.h>
 #include <linux/delay.h>
+#include <linux/hrtimer.h>
 #include <soc/tegra/fuse.h>
 
 #include <uapi/linux/tegra-soc-hwpm-uapi.h>
@@ -435,6 +436,14 @@ struct tegra_soc_hwpm {
 	struct sg_table *mem_bytes_sgt;
 	void *mem_bytes_kernel;
 
+	/*
+	 * Periodic sampling of the PMA output stream
+	 * The timer triggers MEM_BYTES streaming so userspace can follow the
+	 * stream buffer without a syscall per sampling window.
+	 */
+	struct hrtimer sample_timer;
+	u64 sample_interval_ns;
+
 	/* SW State */
 	bool bind_completed;
 	bool device_opened;
@@ -24,6 +24,7 @@ struct tegra_soc_hwpm_ip_floorsweep_info;
 struct tegra_soc_hwpm_resource_info;
 struct tegra_soc_hwpm_alloc_pma_stream;
 struct tegra_soc_hwpm_update_get_put;
+struct tegra_soc_hwpm_periodic_sample;
 struct hwpm_ip;
 struct tegra_soc_hwpm_ip_ops;
 struct hwpm_ip_inst;
@@ -86,4 +87,9 @@ int tegra_hwpm_clear_mem_pipeline(struct tegra_soc_hwpm *hwpm);
 int tegra_hwpm_update_mem_bytes(struct tegra_soc_hwpm *hwpm,
 	struct tegra_soc_hwpm_update_get_put *update_get_put);
 
+void tegra_hwpm_sample_timer_init(struct tegra_soc_hwpm *hwpm);
+void tegra_hwpm_sample_timer_stop(struct tegra_soc_hwpm *hwpm);
+int tegra_hwpm_set_periodic_sample(struct tegra_soc_hwpm *hwpm,
+	struct tegra_soc_hwpm_periodic_sample *periodic_sample);
+
 #endif /* TEGRA_HWPM_COMMON_H */
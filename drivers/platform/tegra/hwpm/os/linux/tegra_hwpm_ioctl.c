@@ -56,6 +56,8 @@ static int exec_reg_ops_ioctl(struct tegra_soc_hwpm *hwpm,
 			      void *ioctl_struct);
 static int update_get_put_ioctl(struct tegra_soc_hwpm *hwpm,
 				void *ioctl_struct);
+static int periodic_sample_ioctl(struct tegra_soc_hwpm *hwpm,
+				 void *ioctl_struct);
 
 static const struct tegra_soc_hwpm_ioctl ioctls[] = {
 	[TEGRA_SOC_HWPM_IOCTL_DEVICE_INFO] = {
@@ -103,6 +105,11 @@ static const struct tegra_soc_hwpm_ioctl ioctls[] = {
 		.struct_size		= sizeof(struct tegra_soc_hwpm_update_get_put),
 		.handler		= update_get_put_ioctl,
 	},
+	[TEGRA_SOC_HWPM_IOCTL_PERIODIC_SAMPLE] = {
+		.name			= "periodic_sample",
+		.struct_size		= sizeof(struct tegra_soc_hwpm_periodic_sample),
+		.handler		= periodic_sample_ioctl,
+	},
 };
 
 static int device_info_ioctl(struct tegra_soc_hwpm *hwpm,
@@ -325,6 +332,29 @@ static int update_get_put_ioctl(struct tegra_soc_hwpm *hwpm,
 	return tegra_hwpm_update_mem_bytes(hwpm, update_get_put);
 }
 
+static int periodic_sample_ioctl(struct tegra_soc_hwpm *hwpm,
+				 void *ioctl_struct)
+{
+	struct tegra_soc_hwpm_periodic_sample *periodic_sample =
+		(struct tegra_soc_hwpm_periodic_sample *)ioctl_struct;
+
+	tegra_hwpm_fn(hwpm, " ");
+
+	if (!hwpm->bind_completed) {
+		tegra_hwpm_err(hwpm,
+			"The PERIODIC_SAMPLE IOCTL can only be called"
+			" after the BIND IOCTL.");
+		return -EPERM;
+	}
+	if (!hwpm->mem_bytes_kernel) {
+		tegra_hwpm_err(hwpm,
+			"mem_bytes buffer is not mapped in the driver");
+		return -ENXIO;
+	}
+
+	return tegra_hwpm_set_periodic_sample(hwpm, periodic_sample);
+}
+
 static long tegra_hwpm_ioctl(struct file *file,
 				 unsigned int cmd,
 				 unsigned long arg)
@@ -174,6 +174,8 @@ static int tegra_hwpm_probe(struct platform_device *pdev)
 	else
 		hwpm->fake_registers_enabled = false;
 
+	tegra_hwpm_sample_timer_init(hwpm);
+
 	platform_set_drvdata(pdev, hwpm);
 	tegra_soc_hwpm_pdev = pdev;
 
@@ -221,6 +223,8 @@ static int tegra_hwpm_remove(struct platform_device *pdev)
 		return -ENODEV;
 	}
 
+	tegra_hwpm_sample_timer_stop(hwpm);
+
 	if (tegra_platform_is_silicon()) {
 		if (hwpm->la_clk)
 			devm_clk_put(hwpm->dev, hwpm->la_clk);
@@ -13,7 +13,10 @@
 
 #include <linux/types.h>
 #include <linux/atomic.h>
+#include <linux/clk.h>
 #include <linux/mutex.h>
+#include <linux/seqlock.h>
+#include <linux/workqueue.h>
 #include <linux/err.h>
 #include <linux/slab.h>
 #include <linux/module.h>
@@ -85,6 +88,38 @@ static struct {
 	bool override;
 } bwmgr;
 
+/* interval over which async bandwidth requests are coalesced */
+#define BWMGR_ASYNC_DECISION_INTERVAL_MS	5
+
+/*
+ * Lock-free landing slot for asynchronous requests, one per client.
+ * A poster fills the payload, then marks the slot pending; the async
+ * worker consumes pending slots under the bwmgr lock. Posting again
+ * before the worker runs overwrites the previous request (coalescing).
+ */
+struct bwmgr_async_slot {
+	unsigned long val;
+	enum tegra_bwmgr_request_type req;
+	void (*complete)(void *priv, int ret);
+	void *priv;
+	atomic_t pending;
+};
+
+static struct bwmgr_async_slot bwmgr_async_slots[TEGRA_BWMGR_CLIENT_COUNT];
+static void bwmgr_async_work_func(struct work_struct *work);
+static DECLARE_DELAYED_WORK(bwmgr_async_work, bwmgr_async_work_func);
+
+/*
+ * Per-rate attribute table, precomputed from the BPMP DVFS table, and
+ * a seqlock-published snapshot of the entry matching the applied rate.
+ * A rate change only refreshes the snapshot; queries copy it without
+ * taking the bwmgr or clock framework locks.
+ */
+static struct tegra_bwmgr_rate_attr *bwmgr_rate_table;
+static int bwmgr_rate_table_size;
+static struct tegra_bwmgr_rate_attr bwmgr_cur_rate_attr;
+static DEFINE_SEQLOCK(bwmgr_rate_attr_lock);
+
 static struct dram_refresh_alrt {
 	unsigned long cur_state;
 	u32 max_cooling_state;
@@ -93,6 +128,16 @@ static struct dram_refresh_alrt {
 
 static bool clk_update_disabled;
 
+/*
+ * Epoch batching of synchronous votes. An isolated vote still updates
+ * EMC immediately (leading edge), but further votes landing within
+ * bwmgr_epoch_interval_ms of that update are folded into one decision
+ * made by the async worker at the epoch boundary. 0 disables batching.
+ */
+static u32 bwmgr_epoch_interval_ms = BWMGR_ASYNC_DECISION_INTERVAL_MS;
+static unsigned long bwmgr_epoch_last_update;
+static bool bwmgr_epoch_pending;
+
 static struct {
 	unsigned long bw;
 	unsigned long iso_bw;
@@ -220,6 +265,62 @@ static void purge_client(struct tegra_bwmgr_client *handle)
 	handle->iso_cap = bwmgr.emc_max_rate;
 	handle->floor = 0;
 	handle->refcount = 0;
+	atomic_set(&bwmgr_async_slots[handle - bwmgr.bwmgr_client].pending, 0);
+}
+
+/* call with bwmgr lock held */
+static int bwmgr_set_request_locked(struct tegra_bwmgr_client *handle,
+		unsigned long val, enum tegra_bwmgr_request_type req,
+		bool *update_clk)
+{
+	switch (req) {
+	case TEGRA_BWMGR_SET_EMC_FLOOR:
+		if (handle->floor != val) {
+			handle->floor = val;
+			*update_clk = true;
+		}
+		break;
+
+	case TEGRA_BWMGR_SET_EMC_CAP:
+		if (val == 0)
+			val = bwmgr.emc_max_rate;
+
+		if (handle->cap != val) {
+			handle->cap = val;
+			*update_clk = true;
+		}
+		break;
+
+	case TEGRA_BWMGR_SET_EMC_ISO_CAP:
+		if (val == 0)
+			val = bwmgr.emc_max_rate;
+
+		if (handle->iso_cap != val) {
+			handle->iso_cap = val;
+			*update_clk = true;
+		}
+		break;
+
+	case TEGRA_BWMGR_SET_EMC_SHARED_BW:
+		if (handle->bw != val) {
+			handle->bw = val;
+			*update_clk = true;
+		}
+		break;
+
+	case TEGRA_BWMGR_SET_EMC_SHARED_BW_ISO:
+		if (handle->iso_bw != val) {
+			handle->iso_bw = val;
+			*update_clk = true;
+		}
+		break;
+
+	default:
+		WARN_ON(true);
+		return -EINVAL;
+	}
+
+	return 0;
 }
 
 static unsigned long tegra_bwmgr_apply_efficiency(
@@ -336,6 +437,32 @@ static int bwmgr_update_clk(void)
 	return ret;
 }
 
+/*
+ * Apply a changed vote, batching per epoch. Must be called with the
+ * bwmgr lock held. A vote deferred to the epoch boundary returns 0
+ * here; the result of the coalesced update is not propagated back.
+ */
+static int bwmgr_request_update_locked(void)
+{
+	if (clk_update_disabled)
+		return 0;
+
+	if (!bwmgr_epoch_interval_ms ||
+	    time_after(jiffies, bwmgr_epoch_last_update +
+		       msecs_to_jiffies(bwmgr_epoch_interval_ms))) {
+		bwmgr_epoch_last_update = jiffies;
+		return bwmgr_update_clk();
+	}
+
+	if (!bwmgr_epoch_pending) {
+		bwmgr_epoch_pending = true;
+		schedule_delayed_work(&bwmgr_async_work,
+			msecs_to_jiffies(bwmgr_epoch_interval_ms));
+	}
+
+	return 0;
+}
+
 struct tegra_bwmgr_client *tegra_bwmgr_register(
 		enum tegra_bwmgr_client_id client)
 {
@@ -508,61 +635,19 @@ int tegra_bwmgr_set_emc(struct tegra_bwmgr_client *handle, unsigned long val,
 			val, bwmgr_req_to_name(req));
 #endif /* CONFIG_TRACEPOINTS */
 
-	switch (req) {
-	case TEGRA_BWMGR_SET_EMC_FLOOR:
-		if (handle->floor != val) {
-			handle->floor = val;
-			update_clk = true;
-		}
-		break;
-
-	case TEGRA_BWMGR_SET_EMC_CAP:
-		if (val == 0)
-			val = bwmgr.emc_max_rate;
-
-		if (handle->cap != val) {
-			handle->cap = val;
-			update_clk = true;
-		}
-		break;
-
-	case TEGRA_BWMGR_SET_EMC_ISO_CAP:
-		if (val == 0)
-			val = bwmgr.emc_max_rate;
-
-		if (handle->iso_cap != val) {
-			handle->iso_cap = val;
-			update_clk = true;
-		}
-		break;
-
-	case TEGRA_BWMGR_SET_EMC_SHARED_BW:
-		if (handle->bw != val) {
-			handle->bw = val;
-			update_clk = true;
-		}
-		break;
-
-	case TEGRA_BWMGR_SET_EMC_SHARED_BW_ISO:
-		if (handle->iso_bw != val) {
-			handle->iso_bw = val;
-			update_clk = true;
-		}
-		break;
-
-	default:
-		WARN_ON(true);
+	ret = bwmgr_set_request_locked(handle, val, req, &update_clk);
+	if (ret) {
 		if (!bwmgr_unlock()) {
 			pr_err("bwmgr: %s failed for client %s\n",
 			__func__,
 			tegra_bwmgr_client_names[handle - bwmgr.bwmgr_client]);
 			return -EINVAL;
 		}
-		return -EINVAL;
+		return ret;
 	}
 
-	if (update_clk && !clk_update_disabled)
-		ret = bwmgr_update_clk();
+	if (update_clk)
+		ret = bwmgr_request_update_locked();
 
 	if (!bwmgr_unlock()) {
 		pr_err("bwmgr: %s failed for client %s\n",
@@ -575,6 +660,101 @@ int tegra_bwmgr_set_emc(struct tegra_bwmgr_client *handle, unsigned long val,
 }
 EXPORT_SYMBOL_GPL(tegra_bwmgr_set_emc);
 
+static void bwmgr_async_work_func(struct work_struct *work)
+{
+	void (*complete[TEGRA_BWMGR_CLIENT_COUNT])(void *priv, int ret);
+	void *priv[TEGRA_BWMGR_CLIENT_COUNT];
+	bool update_clk = false;
+	int ret = 0;
+	int i;
+
+	if (!bwmgr_lock()) {
+		pr_err("bwmgr: %s failed to take lock\n", __func__);
+		return;
+	}
+
+	for (i = 0; i < TEGRA_BWMGR_CLIENT_COUNT; i++) {
+		struct bwmgr_async_slot *slot = &bwmgr_async_slots[i];
+		bool changed = false;
+
+		complete[i] = NULL;
+
+		if (!atomic_xchg(&slot->pending, 0))
+			continue;
+
+		/* pairs with the barrier in tegra_bwmgr_set_emc_async() */
+		smp_rmb();
+		complete[i] = slot->complete;
+		priv[i] = slot->priv;
+
+		bwmgr_set_request_locked(bwmgr.bwmgr_client + i,
+				slot->val, slot->req, &changed);
+		update_clk = update_clk || changed;
+	}
+
+	/* pick up synchronous votes deferred to the epoch boundary */
+	update_clk = update_clk || bwmgr_epoch_pending;
+	bwmgr_epoch_pending = false;
+
+	if (update_clk && !clk_update_disabled) {
+		bwmgr_epoch_last_update = jiffies;
+		ret = bwmgr_update_clk();
+	}
+
+	if (!bwmgr_unlock())
+		pr_err("bwmgr: %s failed to release lock\n", __func__);
+
+	/* confirm the applied rate to clients that asked for it */
+	for (i = 0; i < TEGRA_BWMGR_CLIENT_COUNT; i++)
+		if (complete[i])
+			complete[i](priv[i], ret);
+}
+
+int tegra_bwmgr_set_emc_async(struct tegra_bwmgr_client *handle,
+		unsigned long val, enum tegra_bwmgr_request_type req,
+		void (*complete)(void *priv, int ret), void *priv)
+{
+	struct bwmgr_async_slot *slot;
+
+	IS_BWMGR_SUPPORTED(bwmgr_disable, -ENOTSUPP);
+
+	if (!IS_HANDLE_VALID(handle)) {
+		pr_err("bwmgr: client sent bad handle %p\n",
+				handle);
+		WARN_ON(true);
+		return -EINVAL;
+	}
+
+	if (req >= TEGRA_BWMGR_SET_EMC_REQ_COUNT) {
+		pr_err("bwmgr: client %ld sent bad request type %d\n",
+				handle - bwmgr.bwmgr_client, req);
+		WARN_ON(true);
+		return -EINVAL;
+	}
+
+	if (!bwmgr.emc_clk || !bwmgr.status) {
+		/* nothing to apply; still honour the completion contract */
+		if (complete)
+			complete(priv, 0);
+		return 0;
+	}
+
+	slot = &bwmgr_async_slots[handle - bwmgr.bwmgr_client];
+	slot->val = val;
+	slot->req = req;
+	slot->complete = complete;
+	slot->priv = priv;
+	/* publish the payload before marking the slot pending */
+	smp_wmb();
+	atomic_set(&slot->pending, 1);
+
+	schedule_delayed_work(&bwmgr_async_work,
+		msecs_to_jiffies(BWMGR_ASYNC_DECISION_INTERVAL_MS));
+
+	return 0;
+}
+EXPORT_SYMBOL_GPL(tegra_bwmgr_set_emc_async);
+
 int tegra_bwmgr_get_client_info(struct tegra_bwmgr_client *handle,
 		unsigned long *out_val,
 		enum tegra_bwmgr_request_type req)
@@ -657,6 +837,41 @@ int tegra_bwmgr_get_client_info(struct tegra_bwmgr_client *handle,
 }
 EXPORT_SYMBOL_GPL(tegra_bwmgr_get_client_info);
 
+int tegra_bwmgr_get_client_request(enum tegra_bwmgr_client_id client,
+		const char **name, unsigned long *bw, unsigned long *iso_bw)
+{
+	struct tegra_bwmgr_client *h;
+
+	IS_BWMGR_SUPPORTED(bwmgr_disable, -ENOTSUPP);
+
+	if (client < 0 || client >= TEGRA_BWMGR_CLIENT_COUNT)
+		return -EINVAL;
+
+	h = &bwmgr.bwmgr_client[client];
+	if (!h->refcount)
+		return -ENOENT;
+
+	if (!bwmgr_lock()) {
+		pr_err("bwmgr: %s failed for client %s\n",
+			__func__, tegra_bwmgr_client_names[client]);
+		return -EINVAL;
+	}
+	if (name)
+		*name = tegra_bwmgr_client_names[client];
+	if (bw)
+		*bw = h->bw;
+	if (iso_bw)
+		*iso_bw = h->iso_bw;
+	if (!bwmgr_unlock()) {
+		pr_err("bwmgr: %s failed for client %s\n",
+			__func__, tegra_bwmgr_client_names[client]);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+EXPORT_SYMBOL_GPL(tegra_bwmgr_get_client_request);
+
 int tegra_bwmgr_notifier_register(struct notifier_block *nb)
 {
 	IS_BWMGR_SUPPORTED(bwmgr_disable, -ENOTSUPP);
@@ -696,6 +911,89 @@ unsigned long tegra_bwmgr_get_emc_rate(void)
 }
 EXPORT_SYMBOL_GPL(tegra_bwmgr_get_emc_rate);
 
+static void bwmgr_fill_rate_attr(struct tegra_bwmgr_rate_attr *attr,
+		unsigned long rate)
+{
+	attr->rate = rate;
+	attr->bw = bwmgr.ops->freq_to_bw(rate);
+	attr->core_rate = emc_to_dram_freq_factor ?
+		rate / emc_to_dram_freq_factor : rate;
+	attr->dvfs_latency = bwmgr.ops->dvfs_latency(rate / 1000);
+}
+
+static void bwmgr_publish_rate_attr(unsigned long rate)
+{
+	struct tegra_bwmgr_rate_attr attr;
+	int i;
+
+	for (i = 0; i < bwmgr_rate_table_size; i++)
+		if (bwmgr_rate_table[i].rate == rate)
+			break;
+
+	if (i < bwmgr_rate_table_size)
+		attr = bwmgr_rate_table[i];
+	else
+		/* rate is not a DVFS table node, derive on the spot */
+		bwmgr_fill_rate_attr(&attr, rate);
+
+	write_seqlock(&bwmgr_rate_attr_lock);
+	bwmgr_cur_rate_attr = attr;
+	write_sequnlock(&bwmgr_rate_attr_lock);
+}
+
+static int bwmgr_rate_attr_notifier(struct notifier_block *nb,
+		unsigned long action, void *data)
+{
+	struct clk_notifier_data *cnd = data;
+
+	if (action == POST_RATE_CHANGE)
+		bwmgr_publish_rate_attr(cnd->new_rate);
+
+	return NOTIFY_OK;
+}
+
+static struct notifier_block bwmgr_rate_attr_nb = {
+	.notifier_call = bwmgr_rate_attr_notifier,
+};
+
+static void bwmgr_rate_table_init(void)
+{
+	int i;
+
+	if (bwmgr_emc_dvfs.num_pairs <= 0 ||
+			bwmgr_emc_dvfs.num_pairs > EMC_DVFS_LATENCY_MAX_SIZE)
+		return;
+
+	bwmgr_rate_table = kcalloc(bwmgr_emc_dvfs.num_pairs,
+			sizeof(*bwmgr_rate_table), GFP_KERNEL);
+	if (!bwmgr_rate_table)
+		return;
+
+	for (i = 0; i < bwmgr_emc_dvfs.num_pairs; i++)
+		bwmgr_fill_rate_attr(&bwmgr_rate_table[i],
+			(unsigned long)bwmgr_emc_dvfs.pairs[i].freq * 1000);
+
+	bwmgr_rate_table_size = bwmgr_emc_dvfs.num_pairs;
+}
+
+int tegra_bwmgr_get_rate_attr(struct tegra_bwmgr_rate_attr *attr)
+{
+	unsigned int seq;
+
+	IS_BWMGR_SUPPORTED(bwmgr_disable, -ENOTSUPP);
+
+	if (!attr)
+		return -EINVAL;
+
+	do {
+		seq = read_seqbegin(&bwmgr_rate_attr_lock);
+		*attr = bwmgr_cur_rate_attr;
+	} while (read_seqretry(&bwmgr_rate_attr_lock, seq));
+
+	return 0;
+}
+EXPORT_SYMBOL_GPL(tegra_bwmgr_get_rate_attr);
+
 /* bwmgr_get_lowest_iso_emc_freq
  * bwmgr_apply_efficiency function will use this api to calculate
  * the lowest emc frequency that satisfies the requests of ISO clients.
@@ -966,6 +1264,11 @@ bpmp_skip:
 	for (i = 0; i < TEGRA_BWMGR_CLIENT_COUNT; i++)
 		purge_client(bwmgr.bwmgr_client + i);
 
+	bwmgr_rate_table_init();
+	bwmgr_publish_rate_attr(clk_get_rate(bwmgr.emc_clk));
+	if (clk_notifier_register(bwmgr.emc_clk, &bwmgr_rate_attr_nb))
+		pr_err("bwmgr: couldn't register rate attr notifier.\n");
+
 	bwmgr_debugfs_init();
 
 	/* Check status property is okay or not. */
@@ -989,9 +1292,17 @@ void __exit bwmgr_exit(void)
 	if (bwmgr_disable)
 		return;
 
+	cancel_delayed_work_sync(&bwmgr_async_work);
+
 	for (i = 0; i < TEGRA_BWMGR_CLIENT_COUNT; i++)
 		purge_client(bwmgr.bwmgr_client + i);
 
+	if (bwmgr.emc_clk)
+		clk_notifier_unregister(bwmgr.emc_clk, &bwmgr_rate_attr_nb);
+	kfree(bwmgr_rate_table);
+	bwmgr_rate_table = NULL;
+	bwmgr_rate_table_size = 0;
+
 	bwmgr.emc_clk = NULL;
 	mutex_destroy(&bwmgr.lock);
 
@@ -1277,6 +1588,9 @@ static void bwmgr_debugfs_init(void)
 		debugfs_create_bool(
 			"clk_update_disabled", S_IRWXU, debugfs_dir,
 			&clk_update_disabled);
+		debugfs_create_u32(
+			"epoch_interval_ms", S_IRWXU, debugfs_dir,
+			&bwmgr_epoch_interval_ms);
 		debugfs_create_u64("emc_min_rate", S_IRUSR, debugfs_dir,
 			(u64 *) &bwmgr.emc_min_rate);
 		debugfs_create_u64("emc_max_rate", S_IRUSR, debugfs_dir,
@@ -26,6 +26,7 @@
 #include <linux/slab.h>
 #include <linux/kobject.h>
 #include <linux/sysfs.h>
+#include <linux/notifier.h>
 #include <linux/printk.h>
 #include <linux/err.h>
 #include <linux/kref.h>
@@ -121,6 +122,8 @@ struct isomgr_client isomgr_clients[TEGRA_ISO_CLIENT_COUNT];
 struct isomgr isomgr = {
 	.max_iso_bw = CONFIG_TEGRA_ISOMGR_POOL_KB_PER_SEC,
 	.avail_bw = CONFIG_TEGRA_ISOMGR_POOL_KB_PER_SEC,
+	/* start at 1 so zero-initialized admission entries never match */
+	.admission_gen = 1,
 };
 
 /* get minimum MC frequency for client that can support this BW and LT */
@@ -279,6 +282,154 @@ static void update_mc_clock(void)
 	}
 }
 
+/*
+ * Headroom watermark: when avail_bw crosses isomgr.wmark_bw on its way
+ * down, kernel subscribers and sysfs pollers are told about it, so load
+ * can be shed before tegra_isomgr_reserve() starts failing. A second
+ * event is sent when headroom recovers above the watermark. The edge is
+ * detected under isomgr_lock in the paths that change avail_bw and the
+ * notification is sent after the lock is dropped, so subscribers may
+ * call back into isomgr APIs.
+ */
+static BLOCKING_NOTIFIER_HEAD(isomgr_wmark_notifier);
+
+/* call with isomgr_lock held; returns the edge to notify, if any */
+static int isomgr_wmark_update(void)
+{
+	bool below;
+
+	if (!isomgr.wmark_bw)
+		return 0;
+
+	below = isomgr.avail_bw < isomgr.wmark_bw;
+	if (below == isomgr.below_wmark)
+		return 0;
+
+	isomgr.below_wmark = below;
+	if (below)
+		isomgr.wmark_crossings++;
+	return below ? TEGRA_ISOMGR_WMARK_BELOW : TEGRA_ISOMGR_WMARK_ABOVE;
+}
+
+/* call without isomgr_lock held */
+static void isomgr_wmark_notify(int edge, s32 avail_bw)
+{
+	if (!edge)
+		return;
+
+	blocking_notifier_call_chain(&isomgr_wmark_notifier, edge, &avail_bw);
+#ifdef CONFIG_TEGRA_ISOMGR_SYSFS
+	if (isomgr.kobj)
+		sysfs_notify(isomgr.kobj, NULL, "avail_bw");
+#endif
+}
+
+/**
+ * tegra_isomgr_set_wmark - set the headroom watermark.
+ *
+ * @bw		headroom threshold in KB/sec. avail_bw dropping below it
+ *		generates TEGRA_ISOMGR_WMARK_BELOW, recovering above it
+ *		generates TEGRA_ISOMGR_WMARK_ABOVE. 0 disables the events.
+ *
+ * @retval	0 on success.
+ */
+int tegra_isomgr_set_wmark(u32 bw)
+{
+	IS_ISOMGR_SUPPORTED(isomgr_disable, -ENOTSUPP);
+
+	if (test_mode)
+		return 0;
+	if (!isomgr_lock())
+		return -EBUSY;
+	isomgr.wmark_bw = bw;
+	/* re-arm edge detection against the new threshold */
+	isomgr.below_wmark = bw ? isomgr.avail_bw < (s32)bw : false;
+	if (!isomgr_unlock())
+		return -EBUSY;
+	return 0;
+}
+EXPORT_SYMBOL(tegra_isomgr_set_wmark);
+
+/**
+ * tegra_isomgr_register_wmark_notifier - subscribe to watermark events.
+ *
+ * @nb		notifier block. Called with TEGRA_ISOMGR_WMARK_BELOW or
+ *		TEGRA_ISOMGR_WMARK_ABOVE as the action and a pointer to
+ *		the avail_bw snapshot (s32, KB/sec) as data.
+ *
+ * @retval	0 on success.
+ */
+int tegra_isomgr_register_wmark_notifier(struct notifier_block *nb)
+{
+	IS_ISOMGR_SUPPORTED(isomgr_disable, -ENOTSUPP);
+
+	return blocking_notifier_chain_register(&isomgr_wmark_notifier, nb);
+}
+EXPORT_SYMBOL(tegra_isomgr_register_wmark_notifier);
+
+/**
+ * tegra_isomgr_unregister_wmark_notifier - drop a watermark subscription.
+ *
+ * @nb		notifier block passed at registration.
+ */
+void tegra_isomgr_unregister_wmark_notifier(struct notifier_block *nb)
+{
+	if (isomgr_disable) {
+		pr_err("%s:isomgr API unavailable\n", __func__);
+		return;
+	}
+
+	blocking_notifier_chain_unregister(&isomgr_wmark_notifier, nb);
+}
+EXPORT_SYMBOL(tegra_isomgr_unregister_wmark_notifier);
+
+/*
+ * Admitted (bw, lt) tuples are cached per client so that repeating a
+ * reservation during a reconfigure is a table lookup instead of a full
+ * admission computation. Entries are valid only while their generation
+ * matches isomgr.admission_gen; the generation is bumped whenever the
+ * global admission inputs change (registration, margins, realized BW).
+ * Only successful admissions are cached, so a stale entry can never
+ * admit more than a full recomputation would.
+ */
+
+/* call with isomgr_lock held. */
+static void invalidate_admissions(void)
+{
+	isomgr.admission_gen++;
+}
+
+/* call with isomgr_lock held. */
+static struct isomgr_admission *find_admission(struct isomgr_client *cp,
+					       u32 bw, u32 lt)
+{
+	int i;
+
+	for (i = 0; i < ISOMGR_MAX_ADMISSIONS; i++) {
+		struct isomgr_admission *adm = &cp->admissions[i];
+
+		if (adm->gen == isomgr.admission_gen &&
+		    adm->bw == bw && adm->lt == lt)
+			return adm;
+	}
+
+	return NULL;
+}
+
+/* call with isomgr_lock held. */
+static void cache_admission(struct isomgr_client *cp, u32 bw, u32 lt,
+			    u32 mf, u32 lto)
+{
+	struct isomgr_admission *adm = &cp->admissions[cp->next_admission];
+
+	cp->next_admission = (cp->next_admission + 1) % ISOMGR_MAX_ADMISSIONS;
+	adm->bw = bw;
+	adm->lt = lt;
+	adm->mf = mf;
+	adm->lto = lto;
+	adm->gen = isomgr.admission_gen;
+}
+
 static void purge_isomgr_client(struct isomgr_client *cp)
 {
 	cp->magic = 0;
@@ -293,6 +444,8 @@ static void purge_isomgr_client(struct isomgr_client *cp)
 	cp->priv = NULL;
 	cp->sleep_bw = 0;
 	cp->margin_bw = 0;
+	cp->next_admission = 0;
+	invalidate_admissions();
 }
 
 /* This function should be called with isomgr lock */
@@ -457,6 +610,8 @@ static void __tegra_isomgr_unregister(tegra_isomgr_handle handle)
 {
 	struct isomgr_client *cp = (struct isomgr_client *)handle;
 	int client = cp - &isomgr_clients[0];
+	int wmark;
+	s32 avail_bw;
 
 	VALIDATE_HANDLE();
 	if (!isomgr_lock()) {
@@ -466,10 +621,13 @@ static void __tegra_isomgr_unregister(tegra_isomgr_handle handle)
 	}
 	trace_tegra_isomgr_unregister(handle, cname[client]);
 	kref_put(&cp->kref, unregister_iso_client);
+	wmark = isomgr_wmark_update();
+	avail_bw = isomgr.avail_bw;
 	if (!isomgr_unlock()) {
 		pr_err("isomgr: %s failed for %s\n",
 			__func__, cname[client]);
 	}
+	isomgr_wmark_notify(wmark, avail_bw);
 validation_fail:
 	return;
 }
@@ -498,6 +656,9 @@ static u32 __tegra_isomgr_reserve(tegra_isomgr_handle handle,
 	s32 bw = ubw;
 	bool ret = 0;
 	u32 mf, dvfs_latency = 0;
+	int wmark;
+	s32 avail_bw;
+	struct isomgr_admission *adm;
 	struct isomgr_client *cp = (struct isomgr_client *) handle;
 	int client = cp - &isomgr_clients[0];
 
@@ -529,17 +690,26 @@ static u32 __tegra_isomgr_reserve(tegra_isomgr_handle handle,
 	if (unlikely(!cp->renegotiate && bw > cp->dedi_bw))
 		goto out;
 
-	if (isomgr.ops->isomgr_plat_reserve) {
-		ret = isomgr.ops->isomgr_plat_reserve(cp, bw,
-				(enum tegra_iso_client)client);
-		if (!ret)
-			goto out;
-	}
+	adm = find_admission(cp, ubw, ult);
+	if (adm) {
+		/* tuple was admitted earlier under the same conditions */
+		mf = adm->mf;
+		dvfs_latency = adm->lto;
+	} else {
+		if (isomgr.ops->isomgr_plat_reserve) {
+			ret = isomgr.ops->isomgr_plat_reserve(cp, bw,
+					(enum tegra_iso_client)client);
+			if (!ret)
+				goto out;
+		}
+
+		/* Look up MC's min freq that could satisfy requested BW and LT */
+		mf = mc_min_freq(ubw, ult);
+		/* Look up MC's dvfs latency at min freq */
+		dvfs_latency = mc_dvfs_latency(mf);
 
-	/* Look up MC's min freq that could satisfy requested BW and LT */
-	mf = mc_min_freq(ubw, ult);
-	/* Look up MC's dvfs latency at min freq */
-	dvfs_latency = mc_dvfs_latency(mf);
+		cache_admission(cp, ubw, ult, mf, dvfs_latency);
+	}
 
 	cp->lti = ult;		/* remember client spec'd LT (usec) */
 	cp->lto = dvfs_latency;	/* remember MC calculated LT (usec) */
@@ -547,11 +717,14 @@ static u32 __tegra_isomgr_reserve(tegra_isomgr_handle handle,
 	cp->rsvd_bw = bw;
 out:
 	kref_put(&cp->kref, unregister_iso_client);
+	wmark = isomgr_wmark_update();
+	avail_bw = isomgr.avail_bw;
 	if (!isomgr_unlock()) {
 		pr_err("isomgr: %s failed for %s\n",
 			__func__, cname[client]);
 		goto validation_fail;
 	}
+	isomgr_wmark_notify(wmark, avail_bw);
 	trace_tegra_isomgr_reserve(handle, ubw, ult, cname[client],
 		dvfs_latency ? "exit" : "rsrv_fail_exit");
 	return dvfs_latency;
@@ -594,6 +767,8 @@ static u32 __tegra_isomgr_realize(tegra_isomgr_handle handle)
 {
 	u32 dvfs_latency = 0;
 	bool ret = 0;
+	int wmark;
+	s32 avail_bw;
 	struct isomgr_client *cp = (struct isomgr_client *) handle;
 	int client = cp - &isomgr_clients[0];
 
@@ -627,15 +802,20 @@ static u32 __tegra_isomgr_realize(tegra_isomgr_handle handle)
 
 	dvfs_latency = (u32)cp->lto;
 	cp->realize = false;
+	/* realized bandwidth changed, cached admissions are stale */
+	invalidate_admissions();
 	update_mc_clock();
 
 out:
 	kref_put(&cp->kref, unregister_iso_client);
+	wmark = isomgr_wmark_update();
+	avail_bw = isomgr.avail_bw;
 	if (!isomgr_unlock()) {
 		pr_err("isomgr: %s failed for %s\n",
 			__func__, cname[client]);
 		goto validation_fail;
 	}
+	isomgr_wmark_notify(wmark, avail_bw);
 	trace_tegra_isomgr_realize(handle, cname[client],
 		dvfs_latency ? "exit" : "real_fail_exit");
 	return dvfs_latency;
@@ -675,6 +855,8 @@ static int __tegra_isomgr_set_margin(enum tegra_iso_client client,
 {
 	int ret = -EINVAL;
 	s32 high_bw;
+	int wmark;
+	s32 avail_bw;
 	struct isomgr_client *cp = NULL;
 
 	trace_tegra_isomgr_set_margin(client, bw, wait, "enter");
@@ -721,13 +903,18 @@ static int __tegra_isomgr_set_margin(enum tegra_iso_client client,
 		}
 	}
 	ret = 0;
+	/* margins changed, cached admissions are stale */
+	invalidate_admissions();
 out:
 	kref_put(&cp->kref, unregister_iso_client);
+	wmark = isomgr_wmark_update();
+	avail_bw = isomgr.avail_bw;
 	if (!isomgr_unlock()) {
 		pr_err("isomgr: %s failed for %s\n",
 			__func__, cname[client]);
 		goto validation_fail;
 	}
+	isomgr_wmark_notify(wmark, avail_bw);
 	trace_tegra_isomgr_set_margin(client, bw, wait,
 					ret ? "fail_exit" : "exit");
 	return ret;
@@ -855,6 +1042,8 @@ EXPORT_SYMBOL(tegra_isomgr_get_total_iso_bw);
 #ifdef CONFIG_TEGRA_ISOMGR_SYSFS
 static ssize_t isomgr_show(struct kobject *kobj,
 	struct kobj_attribute *attr, char *buf);
+static ssize_t isomgr_store(struct kobject *kobj,
+	struct kobj_attribute *attr, const char *buf, size_t size);
 
 static const struct kobj_attribute lt_mf_attr =
 	__ATTR(lt_mf, 0444, isomgr_show, NULL);
@@ -864,12 +1053,18 @@ static const struct kobj_attribute max_iso_bw_attr =
 	__ATTR(max_iso_bw, 0444, isomgr_show, NULL);
 static const struct kobj_attribute version_attr =
 	__ATTR(version, 0444, isomgr_show, NULL);
+static const struct kobj_attribute wmark_bw_attr =
+	__ATTR(wmark_bw, 0644, isomgr_show, isomgr_store);
+static const struct kobj_attribute wmark_crossings_attr =
+	__ATTR(wmark_crossings, 0444, isomgr_show, NULL);
 
 static const struct attribute *isomgr_attrs[] = {
 	&lt_mf_attr.attr,
 	&avail_bw_attr.attr,
 	&max_iso_bw_attr.attr,
 	&version_attr.attr,
+	&wmark_bw_attr.attr,
+	&wmark_crossings_attr.attr,
 	NULL
 };
 
@@ -886,9 +1081,31 @@ static ssize_t isomgr_show(struct kobject *kobj,
 		rval = sprintf(buf, "%dKB\n", isomgr.max_iso_bw);
 	else if (attr == &version_attr)
 		rval = sprintf(buf, "%d\n", ISOMGR_SYSFS_VERSION);
+	else if (attr == &wmark_bw_attr)
+		rval = sprintf(buf, "%dKB\n", isomgr.wmark_bw);
+	else if (attr == &wmark_crossings_attr)
+		rval = sprintf(buf, "%u\n", isomgr.wmark_crossings);
 	return rval;
 }
 
+/*
+ * Writing wmark_bw arms the headroom watermark; pollers of avail_bw are
+ * woken whenever avail_bw crosses it in either direction.
+ */
+static ssize_t isomgr_store(struct kobject *kobj,
+	struct kobj_attribute *attr, const char *buf, size_t size)
+{
+	u32 bw;
+
+	if (attr != &wmark_bw_attr)
+		return -EINVAL;
+	if (kstrtou32(buf, 0, &bw) || (s32)bw < 0)
+		return -EINVAL;
+	if (tegra_isomgr_set_wmark(bw))
+		return -EBUSY;
+	return size;
+}
+
 static ssize_t isomgr_client_show(struct kobject *kobj,
 	struct kobj_attribute *attr, char *buf)
 {
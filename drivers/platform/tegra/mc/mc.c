@@ -25,6 +25,8 @@
 #include <linux/export.h>
 #include <linux/spinlock.h>
 #include <linux/delay.h>
+#include <linux/ktime.h>
+#include <linux/seq_file.h>
 #include <linux/debugfs.h>
 #include <linux/of_device.h>
 #include <linux/of_address.h>
@@ -178,40 +180,131 @@ static bool tegra_stable_hotreset_check(u32 stat_reg, u32 *stat)
 	return true;
 }
 
-int tegra_mc_flush(int id)
+#define MC_FLUSH_NR_CLIENTS	64
+
+struct mc_flush_stat {
+	bool pending;
+	ktime_t start;
+	u64 count;
+	u64 last_ns;
+	u64 total_ns;
+	u64 max_ns;
+};
+
+static struct mc_flush_stat mc_flush_stats[MC_FLUSH_NR_CLIENTS];
+
+static void tegra_mc_flush_regs(int id, u32 *rst_ctrl_reg, u32 *rst_stat_reg)
+{
+	if (id < 32) {
+		*rst_ctrl_reg = MC_CLIENT_HOTRESET_CTRL;
+		*rst_stat_reg = MC_CLIENT_HOTRESET_STAT;
+	} else {
+		*rst_ctrl_reg = MC_CLIENT_HOTRESET_CTRL_1;
+		*rst_stat_reg = MC_CLIENT_HOTRESET_STAT_1;
+	}
+}
+
+static void tegra_mc_flush_record(int id)
 {
-	u32 rst_ctrl, rst_stat;
+	struct mc_flush_stat *stat = &mc_flush_stats[id];
+	unsigned long flags;
+	u64 elapsed;
+
+	spin_lock_irqsave(&tegra_mc_lock, flags);
+	if (stat->pending) {
+		elapsed = ktime_to_ns(ktime_sub(ktime_get(), stat->start));
+		stat->pending = false;
+		stat->count++;
+		stat->last_ns = elapsed;
+		stat->total_ns += elapsed;
+		if (elapsed > stat->max_ns)
+			stat->max_ns = elapsed;
+	}
+	spin_unlock_irqrestore(&tegra_mc_lock, flags);
+}
+
+/*
+ * Arm the hot reset for @id and return without waiting for the client's
+ * outstanding traffic to drain. Completion is polled with
+ * tegra_mc_flush_async_done() or awaited with tegra_mc_flush_wait(), so
+ * the caller can overlap other teardown work with the drain.
+ */
+int tegra_mc_flush_async(int id)
+{
+	u32 rst_ctrl;
 	u32 rst_ctrl_reg, rst_stat_reg;
 	unsigned long flags;
-	unsigned int timeout;
-	bool ret;
 
 	if (!mc)
 		return 0;
 
-	if (id < 32) {
-		rst_ctrl_reg = MC_CLIENT_HOTRESET_CTRL;
-		rst_stat_reg = MC_CLIENT_HOTRESET_STAT;
-	} else {
-		id %= 32;
-		rst_ctrl_reg = MC_CLIENT_HOTRESET_CTRL_1;
-		rst_stat_reg = MC_CLIENT_HOTRESET_STAT_1;
-	}
+	if (id < 0 || id >= MC_FLUSH_NR_CLIENTS)
+		return -EINVAL;
+
+	tegra_mc_flush_regs(id, &rst_ctrl_reg, &rst_stat_reg);
 
 	spin_lock_irqsave(&tegra_mc_lock, flags);
 
 	rst_ctrl = mc_readl(rst_ctrl_reg);
-	rst_ctrl |= (1 << id);
+	rst_ctrl |= (1 << (id % 32));
 	mc_writel(rst_ctrl, rst_ctrl_reg);
 
+	mc_flush_stats[id].pending = true;
+	mc_flush_stats[id].start = ktime_get();
+
 	spin_unlock_irqrestore(&tegra_mc_lock, flags);
 
+	return 0;
+}
+EXPORT_SYMBOL(tegra_mc_flush_async);
+
+/*
+ * Non-blocking completion check for a drain armed with
+ * tegra_mc_flush_async(). Returns 0 once the client's traffic has
+ * drained and -EBUSY while it is still outstanding.
+ */
+int tegra_mc_flush_async_done(int id)
+{
+	u32 rst_stat = 0;
+	u32 rst_ctrl_reg, rst_stat_reg;
+
+	if (!mc)
+		return 0;
+
+	if (id < 0 || id >= MC_FLUSH_NR_CLIENTS)
+		return -EINVAL;
+
+	tegra_mc_flush_regs(id, &rst_ctrl_reg, &rst_stat_reg);
+
+	if (!tegra_stable_hotreset_check(rst_stat_reg, &rst_stat))
+		return -EBUSY;
+
+	if (!(rst_stat & (1 << (id % 32))))
+		return -EBUSY;
+
+	tegra_mc_flush_record(id);
+
+	return 0;
+}
+EXPORT_SYMBOL(tegra_mc_flush_async_done);
+
+/*
+ * Block until a drain armed with tegra_mc_flush_async() completes. The
+ * timeout behaviour matches tegra_mc_flush().
+ */
+int tegra_mc_flush_wait(int id)
+{
+	unsigned int timeout;
+	int err;
+
+	if (!mc)
+		return 0;
+
 	timeout = 0;
 	do {
 		bool exit = false;
 		udelay(10);
-		rst_stat = 0;
-		ret = tegra_stable_hotreset_check(rst_stat_reg, &rst_stat);
+		err = tegra_mc_flush_async_done(id);
 
 		timeout++;
 
@@ -224,12 +317,21 @@ int tegra_mc_flush(int id)
 			WARN(1, "%s flush %d timeout\n", __func__, id);
 			return -ETIMEDOUT;
 		}
+	} while (err == -EBUSY);
 
-		if (!ret)
-			continue;
-	} while (!(rst_stat & (1 << id)));
+	return err;
+}
+EXPORT_SYMBOL(tegra_mc_flush_wait);
 
-	return 0;
+int tegra_mc_flush(int id)
+{
+	int err;
+
+	err = tegra_mc_flush_async(id);
+	if (err)
+		return err;
+
+	return tegra_mc_flush_wait(id);
 }
 EXPORT_SYMBOL(tegra_mc_flush);
 
@@ -262,6 +364,43 @@ int tegra_mc_flush_done(int id)
 }
 EXPORT_SYMBOL(tegra_mc_flush_done);
 
+#ifdef CONFIG_DEBUG_FS
+static int mc_flush_stats_debugfs_show(struct seq_file *s, void *v)
+{
+	int id;
+
+	seq_printf(s, "%-6s %-10s %-12s %-12s %-12s\n",
+		   "client", "flushes", "last (us)", "avg (us)", "max (us)");
+
+	for (id = 0; id < MC_FLUSH_NR_CLIENTS; id++) {
+		struct mc_flush_stat *stat = &mc_flush_stats[id];
+
+		if (!stat->count)
+			continue;
+
+		seq_printf(s, "%-6d %-10llu %-12llu %-12llu %-12llu\n",
+			   id, stat->count,
+			   stat->last_ns / NSEC_PER_USEC,
+			   stat->total_ns / (stat->count * NSEC_PER_USEC),
+			   stat->max_ns / NSEC_PER_USEC);
+	}
+
+	return 0;
+}
+
+static int mc_flush_stats_debugfs_open(struct inode *inode, struct file *file)
+{
+	return single_open(file, mc_flush_stats_debugfs_show, NULL);
+}
+
+static const struct file_operations mc_flush_stats_debugfs_fops = {
+	.open           = mc_flush_stats_debugfs_open,
+	.read           = seq_read,
+	.llseek         = seq_lseek,
+	.release        = single_release,
+};
+#endif
+
 /*
  * Map an MC register space. Each MC has a set of register ranges which must
  * be parsed. The first starting address in the set of ranges is returned as
@@ -452,6 +591,9 @@ static int tegra_mc_probe(struct platform_device *pdev)
 	if (mc_debugfs_dir == NULL)
 		pr_err("Failed to make debugfs node: %ld\n",
 		       PTR_ERR(mc_debugfs_dir));
+	else
+		debugfs_create_file("flush_stats", S_IRUGO, mc_debugfs_dir,
+				    NULL, &mc_flush_stats_debugfs_fops);
 #endif
 
 	tegra_mcerr_init(mc_debugfs_dir, pdev);
@@ -14,6 +14,9 @@
 #include <linux/types.h>
 #include <linux/debugfs.h>
 #include <linux/clk.h>
+#include <linux/kobject.h>
+#include <linux/sysfs.h>
+#include <linux/string.h>
 #include <linux/platform/tegra/mc.h>
 #include <linux/platform/tegra/mc_utils.h>
 #include <linux/version.h>
@@ -271,6 +274,125 @@ enum dram_types tegra_dram_types(void)
 }
 EXPORT_SYMBOL(tegra_dram_types);
 
+/*
+ * Worst case isochronous latency at a DRAM clock, in ns. Sums the
+ * clock dependent disruption components scaled to the given DRAM and
+ * MC clocks with the fixed refresh, training and calibration costs.
+ */
+static u32 dram_clk_to_latency_ns(unsigned long dram_clk_mhz)
+{
+	unsigned long mc_clk_mhz = dram_clk_to_mc_clk(dram_clk_mhz);
+	u32 latency;
+
+	if (emc_param.dram == DRAM_LPDDR5) {
+		latency = (SMMU_DISRUPTION_DRAM_CLK_LP5 * 1000) / dram_clk_mhz;
+		latency += (RING0_DISRUPTION_MC_CLK_LP5 * 1000) / mc_clk_mhz;
+		latency += (HUM_DISRUPTION_DRAM_CLK_LP5 * 1000) / dram_clk_mhz;
+		latency += HUM_DISRUPTION_NS_LP5;
+		latency += (EXPIRED_ISO_DRAM_CLK_LP5 * 1000) / dram_clk_mhz;
+		latency += EXPIRED_ISO_NS_LP5;
+		latency += REFRESH_RATE_LP5 + PERIODIC_TRAINING_LP5 +
+				CALIBRATION_LP5;
+	} else {
+		latency = (SMMU_DISRUPTION_DRAM_CLK_LP4 * 1000) / dram_clk_mhz;
+		latency += (RING0_DISRUPTION_MC_CLK_LP4 * 1000) / mc_clk_mhz;
+		latency += (HUM_DISRUPTION_DRAM_CLK_LP4 * 1000) / dram_clk_mhz;
+		latency += HUM_DISRUPTION_NS_LP4;
+		latency += (EXPIRED_ISO_DRAM_CLK_LP4 * 1000) / dram_clk_mhz;
+		latency += EXPIRED_ISO_NS_LP4;
+		latency += REFRESH_RATE_LP4 + PERIODIC_TRAINING_LP4 +
+				CALIBRATION_LP4;
+	}
+
+	return latency;
+}
+
+int tegra_mc_query_bw_latency(unsigned long dram_clk_mhz,
+				struct mc_bw_latency_point *point)
+{
+	if (dram_type == DRAM_TYPE_INVAL)
+		return -ENODEV;
+
+	if (!dram_clk_mhz)
+		return -EINVAL;
+
+	point->dram_clk_mhz = dram_clk_mhz;
+	point->mc_clk_mhz = dram_clk_to_mc_clk(dram_clk_mhz);
+	/* MHz grid, KBps result */
+	point->peak_bw_kbps = freq_to_bw(dram_clk_mhz * 1000);
+	point->latency_ns = dram_clk_to_latency_ns(dram_clk_mhz);
+	point->reserved = 0;
+
+	return 0;
+}
+EXPORT_SYMBOL(tegra_mc_query_bw_latency);
+
+/*
+ * Sample grid for the exported curve. The curve itself only depends
+ * on the detected DRAM configuration, so it is computed once at init;
+ * admission logic interpolates between points or queries the exact
+ * rate through tegra_mc_query_bw_latency().
+ */
+static const u32 bw_lat_dram_clks[] = {
+	204, 408, 665, 800, 1066, 1333, 1600, 2133, 2666, 3200
+};
+
+#define BW_LAT_NUM_POINTS	ARRAY_SIZE(bw_lat_dram_clks)
+
+static struct {
+	struct mc_bw_latency_header header;
+	struct mc_bw_latency_point points[BW_LAT_NUM_POINTS];
+} __packed bw_lat_blob;
+
+static ssize_t bw_latency_curve_read(struct file *filp, struct kobject *kobj,
+				struct bin_attribute *attr, char *buf,
+				loff_t off, size_t count)
+{
+	if (off >= sizeof(bw_lat_blob))
+		return 0;
+
+	if (count > sizeof(bw_lat_blob) - off)
+		count = sizeof(bw_lat_blob) - off;
+
+	memcpy(buf, (u8 *)&bw_lat_blob + off, count);
+
+	return count;
+}
+
+static struct bin_attribute bw_latency_curve_attr = {
+	.attr = {
+		.name = "bw_latency_curve",
+		.mode = 0444,
+	},
+	.size = sizeof(bw_lat_blob),
+	.read = bw_latency_curve_read,
+};
+
+static struct kobject *mc_utils_kobj;
+
+static void tegra_mc_utils_sysfs_init(void)
+{
+	int i;
+
+	bw_lat_blob.header.version = MC_BW_LATENCY_VERSION;
+	bw_lat_blob.header.dram_type = dram_type;
+	bw_lat_blob.header.num_channels = ch_num;
+	bw_lat_blob.header.num_points = BW_LAT_NUM_POINTS;
+
+	for (i = 0; i < BW_LAT_NUM_POINTS; i++)
+		tegra_mc_query_bw_latency(bw_lat_dram_clks[i],
+					&bw_lat_blob.points[i]);
+
+	mc_utils_kobj = kobject_create_and_add("tegra_mc_utils", kernel_kobj);
+	if (!mc_utils_kobj) {
+		pr_err("tegra_mc: Unable to create mc_utils sysfs dir\n");
+		return;
+	}
+
+	if (sysfs_create_bin_file(mc_utils_kobj, &bw_latency_curve_attr))
+		pr_err("tegra_mc: Unable to create bw_latency_curve node\n");
+}
+
 #if defined(CONFIG_DEBUG_FS)
 static void tegra_mc_utils_debugfs_init(void)
 {
@@ -339,6 +461,9 @@ void tegra_mc_utils_init(void)
 
 	set_dram_type();
 
+	if (dram_type != DRAM_TYPE_INVAL)
+		tegra_mc_utils_sysfs_init();
+
 #if defined(CONFIG_DEBUG_FS)
 	tegra_mc_utils_debugfs_init();
 #endif
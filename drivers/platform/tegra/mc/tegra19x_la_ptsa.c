@@ -34,6 +34,21 @@ static struct la_client_info t19x_la_info_array[TEGRA_T19X_LA_MAX_ID];
 static struct dda_info dda_info_array[TEGRA_DDA_MAX_ID];
 static struct mc_settings_info mc_settings;
 
+/*
+ * Results of the last successful programming, used to skip the fixed
+ * point recomputation and the MC register writes when an update does
+ * not change the solution for a client. Init LA values depend only on
+ * the client type and the boot time MC settings, so they are computed
+ * at most once per client type.
+ */
+static int init_la_cache[TEGRA_LA_NUM_CLIENT_TYPES];
+static bool init_la_cache_valid[TEGRA_LA_NUM_CLIENT_TYPES];
+static unsigned int dyn_bw_cache[TEGRA_DDA_MAX_ID];
+static bool dyn_bw_cache_valid[TEGRA_DDA_MAX_ID];
+static unsigned long disp_freq_cache[TEGRA_T19X_LA_MAX_ID];
+static unsigned int disp_bw_cache[TEGRA_T19X_LA_MAX_ID];
+static bool disp_cache_valid[TEGRA_T19X_LA_MAX_ID];
+
 static void la_init(unsigned int *error)
 {
 	lp.la_info_array_init(
@@ -48,19 +63,27 @@ static void la_init(unsigned int *error)
 static int t19x_set_init_la(enum tegra_la_id id, unsigned int bw_mbps)
 {
 	enum tegra_t19x_la_id t19x_id = tegra_gen_to_t19x_la_id[id];
+	enum la_client_type type = t19x_la_info_array[t19x_id].client_type;
 	unsigned int error = 0;
 	unsigned int lat_all;
 
-	lat_all =
-		lp.get_init_la(
-			t19x_la_info_array[t19x_id].client_type,
-			&mc_settings,
-			&error);
-	if (error) {
-		pr_err("%s: ", __func__);
-		pr_err("error. Skipping la programming\n");
-		WARN_ON(1);
-		return -1;
+	if (init_la_cache_valid[type]) {
+		lat_all = init_la_cache[type];
+	} else {
+		lat_all =
+			lp.get_init_la(
+				type,
+				&mc_settings,
+				&error);
+		if (error) {
+			pr_err("%s: ", __func__);
+			pr_err("error. Skipping la programming\n");
+			WARN_ON(1);
+			return -1;
+		}
+
+		init_la_cache[type] = lat_all;
+		init_la_cache_valid[type] = true;
 	}
 
 	if (t19x_la_kern_init[t19x_id])
@@ -193,6 +216,10 @@ static void t19x_init_ptsa(void)
 	dda_info_array[TEGRA_DDA_MLL_MPCORER_ID].min = -6;
 	dda_info_array[TEGRA_DDA_MLL_MPCORER_ID].max = 6;
 
+	/* The rates are back at their kernel init values */
+	memset(dyn_bw_cache_valid, 0, sizeof(dyn_bw_cache_valid));
+	memset(disp_cache_valid, 0, sizeof(disp_cache_valid));
+
 	program_kern_init_ptsa();
 }
 
@@ -203,6 +230,10 @@ static void t19x_set_dynamic_ptsa(
 {
 	struct fixed_point iso_adj_bw;
 
+	/* The rate fraction depends only on the requested bandwidth */
+	if (dyn_bw_cache_valid[id] && dyn_bw_cache[id] == bw_mbps)
+		return;
+
 	if (dda_info_array[id].iso_type == TEGRA_HISO) {
 		if (id == TEGRA_DDA_EQOSPC_ID) {
 			iso_adj_bw = fixed_point_mult(
@@ -237,6 +268,9 @@ static void t19x_set_dynamic_ptsa(
 	mc_writel(dda_info_array[id].rate &
 		dda_info_array[id].mask,
 		dda_info_array[id].rate_reg_addr);
+
+	dyn_bw_cache[id] = bw_mbps;
+	dyn_bw_cache_valid[id] = true;
 }
 
 static int t19x_handle_display_la_ptsa(
@@ -253,6 +287,16 @@ static int t19x_handle_display_la_ptsa(
 	int ret_val = 0;
 	unsigned int error = 0;
 
+	/*
+	 * The LA and PTSA solution is a function of the EMC frequency and
+	 * the requested bandwidth only, so a repeat request leaves the
+	 * registers untouched.
+	 */
+	if (write_la && disp_cache_valid[t19x_id] &&
+		disp_freq_cache[t19x_id] == emc_freq_hz &&
+		disp_bw_cache[t19x_id] == bw_mbps)
+		return 0;
+
 	clientid = lp.convert_la2dda_id_for_dyn_ptsa(id, &error);
 	drain_time_usec = FIX_PT(0, 0, &error);
 	la_bw_up_bnd_usec = FIX_PT(0, 0, &error);
@@ -289,6 +333,10 @@ static int t19x_handle_display_la_ptsa(
 
 		if (error)
 			return -1;
+
+		disp_freq_cache[t19x_id] = emc_freq_hz;
+		disp_bw_cache[t19x_id] = bw_mbps;
+		disp_cache_valid[t19x_id] = true;
 	}
 
 	return ret_val;
@@ -99,6 +99,40 @@ int tegra_mce_read_cstate_stats(u32 state, u64 *stats)
 }
 EXPORT_SYMBOL_GPL(tegra_mce_read_cstate_stats);
 
+/**
+ * Query the runtime stats of several cstates in one transaction
+ *
+ * @states: array of c-state query indices.
+ * @stats: output array to hold the stats, one per query.
+ * @count: number of queries.
+ *
+ * Platforms implementing the batched op issue all queries in a single
+ * trip through the mailbox; others fall back to per-query reads.
+ *
+ * Returns 0 if success.
+ */
+int tegra_mce_read_cstate_stats_batch(const u32 *states, u64 *stats,
+				      u32 count)
+{
+	u32 i;
+	int ret;
+
+	if (!states || !stats)
+		return -EINVAL;
+
+	if (mce_ops && mce_ops->read_cstate_stats_batch)
+		return mce_ops->read_cstate_stats_batch(states, stats, count);
+
+	for (i = 0; i < count; i++) {
+		ret = tegra_mce_read_cstate_stats(states[i], &stats[i]);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+EXPORT_SYMBOL_GPL(tegra_mce_read_cstate_stats_batch);
+
 /**
  * Overwrite the runtime stats of a specific c-state
  *
@@ -13,7 +13,9 @@
 
 #include <linux/debugfs.h>
 #include <linux/init.h>
+#include <linux/jiffies.h>
 #include <linux/module.h>
+#include <linux/spinlock.h>
 #include <linux/t194_nvg.h>
 #include <linux/tegra-mce.h>
 
@@ -50,6 +52,54 @@ static noinline notrace uint64_t nvg_get_response(void)
 	return ret;
 }
 
+/*
+ * Short-lived cache for cstate stat queries.  Monitoring tools poll the
+ * same per-core/per-cluster counters at a fixed period; a result read
+ * within the last CSTAT_CACHE_MS is served from here instead of taking
+ * another trip through the NVG mailbox.  The query index encodes both
+ * the stat id and the unit, so each core/cluster caches independently.
+ */
+#define CSTAT_CACHE_SIZE	64
+#define CSTAT_CACHE_MS		10
+
+struct cstat_cache_entry {
+	u32 state;
+	u64 stats;
+	unsigned long expires;
+};
+
+static struct cstat_cache_entry cstat_cache[CSTAT_CACHE_SIZE];
+static DEFINE_SPINLOCK(cstat_cache_lock);
+
+static bool cstat_cache_lookup(u32 state, u64 *stats)
+{
+	struct cstat_cache_entry *ent = &cstat_cache[state % CSTAT_CACHE_SIZE];
+	unsigned long flags;
+	bool hit = false;
+
+	spin_lock_irqsave(&cstat_cache_lock, flags);
+	if (ent->expires && ent->state == state &&
+	    time_before(jiffies, ent->expires)) {
+		*stats = ent->stats;
+		hit = true;
+	}
+	spin_unlock_irqrestore(&cstat_cache_lock, flags);
+
+	return hit;
+}
+
+static void cstat_cache_insert(u32 state, u64 stats)
+{
+	struct cstat_cache_entry *ent = &cstat_cache[state % CSTAT_CACHE_SIZE];
+	unsigned long flags;
+
+	spin_lock_irqsave(&cstat_cache_lock, flags);
+	ent->state = state;
+	ent->stats = stats;
+	ent->expires = jiffies + msecs_to_jiffies(CSTAT_CACHE_MS) + 1;
+	spin_unlock_irqrestore(&cstat_cache_lock, flags);
+}
+
 static int tegra19x_mce_enter_cstate(u32 state, u32 wake_time)
 {
 	/* use PSCI interface instead */
@@ -124,6 +174,9 @@ static int tegra19x_mce_read_cstate_stats(u32 state, u64 *stats)
 	if (!stats)
 		return -EINVAL;
 
+	if (cstat_cache_lookup(state, stats))
+		return 0;
+
 	/* disable preemption */
 	preempt_disable();
 
@@ -135,6 +188,37 @@ static int tegra19x_mce_read_cstate_stats(u32 state, u64 *stats)
 	/* enable preemption */
 	preempt_enable();
 
+	cstat_cache_insert(state, *stats);
+
+	return 0;
+}
+
+static int tegra19x_mce_read_cstate_stats_batch(const u32 *states, u64 *stats,
+						u32 count)
+{
+	u32 i;
+
+	if (!states || !stats)
+		return -EINVAL;
+
+	/* issue all uncached queries in one preemption-disabled section */
+	preempt_disable();
+
+	for (i = 0; i < count; i++) {
+		if (cstat_cache_lookup(states[i], &stats[i]))
+			continue;
+
+		nvg_send_req_data(TEGRA_NVG_CHANNEL_CSTATE_STAT_QUERY_REQUEST,
+					(uint64_t)states[i]);
+		nvg_send_req(TEGRA_NVG_CHANNEL_CSTATE_STAT_QUERY_VALUE);
+		stats[i] = nvg_get_response();
+
+		cstat_cache_insert(states[i], stats[i]);
+	}
+
+	/* enable preemption */
+	preempt_enable();
+
 	return 0;
 }
 
@@ -168,11 +252,20 @@ static int tegra19x_mce_cc3_ctrl(u32 ndiv, u32 vindex, u8 enable)
 
 static int tegra19x_mce_read_versions(u32 *major, u32 *minor)
 {
+	/* versions never change at runtime; query the mailbox only once */
+	static u64 cached_version;
+	static bool version_valid;
 	uint64_t version;
 
 	if (!major || !minor)
 		return -EINVAL;
 
+	if (version_valid) {
+		*minor = (u32)cached_version;
+		*major = (u32)(cached_version >> 32);
+		return 0;
+	}
+
 	/* disable preemption */
 	preempt_disable();
 
@@ -184,6 +277,9 @@ static int tegra19x_mce_read_versions(u32 *major, u32 *minor)
 	/* enable preemption */
 	preempt_enable();
 
+	cached_version = version;
+	version_valid = true;
+
 	return 0;
 }
 
@@ -592,6 +688,7 @@ static struct tegra_mce_ops t19x_mce_ops = {
 	.update_cstate_info = tegra19x_mce_update_cstate_info,
 	.update_crossover_time = tegra19x_mce_update_crossover_time,
 	.read_cstate_stats = tegra19x_mce_read_cstate_stats,
+	.read_cstate_stats_batch = tegra19x_mce_read_cstate_stats_batch,
 	.cc3_ctrl = tegra19x_mce_cc3_ctrl,
 	.read_versions = tegra19x_mce_read_versions,
 	.write_dda_ctrl = tegra19x_mce_write_dda_ctrl,
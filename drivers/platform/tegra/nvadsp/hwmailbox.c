@@ -127,6 +127,20 @@ static status_t hwmboxq_enqueue(struct hwmbox_queue *queue,
 	return ret;
 }
 
+/* Must be called with queue lock held in non-interrupt context */
+static bool hwmboxq_is_pending(struct hwmbox_queue *queue, uint32_t data)
+{
+	uint16_t idx = queue->head;
+	uint16_t count = queue->count;
+
+	while (count--) {
+		if (queue->array[idx] == data)
+			return true;
+		idx = (idx + 1) & HWMBOX_QUEUE_SIZE_MASK;
+	}
+	return false;
+}
+
 status_t nvadsp_hwmbox_send_data(uint16_t mid, uint32_t data, uint32_t flags)
 {
 	spinlock_t *lock = &nvadsp_drv_data->hwmbox_send_queue.lock;
@@ -149,6 +163,14 @@ status_t nvadsp_hwmbox_send_data(uint16_t mid, uint32_t data, uint32_t flags)
 		hwmbox_last_msg = data;
 #endif
 		hwmbox_writel(data, send_hwmbox());
+	} else if ((flags & NVADSP_MBOX_SMSG_COALESCE) &&
+		   hwmboxq_is_pending(&nvadsp_drv_data->hwmbox_send_queue,
+				      data)) {
+		/* An identical doorbell is still waiting for the mailbox:
+		 * it will be delivered after this point, so it covers this
+		 * send as well and a second one would be redundant.
+		 */
+		pr_debug("nvadsp_mbox_send: coalesced with pending data\n");
 	} else {
 		pr_debug("nvadsp_mbox_send: enqueue data\n");
 		ret = hwmboxq_enqueue(&nvadsp_drv_data->hwmbox_send_queue,
@@ -14,6 +14,7 @@
  */
 
 #include "dev.h"
+#include <linux/ktime.h>
 #include <linux/nospec.h>
 #include <asm/barrier.h>
 
@@ -302,6 +303,36 @@ status_t nvadsp_mbox_recv(struct nvadsp_mbox *mbox, uint32_t *data, bool block,
 }
 EXPORT_SYMBOL(nvadsp_mbox_recv);
 
+status_t nvadsp_mbox_recv_poll(struct nvadsp_mbox *mbox, uint32_t *data,
+			       unsigned int poll_usec, unsigned int timeout)
+{
+	ktime_t end;
+	int ret;
+
+	if (!nvadsp_drv_data)
+		return -ENOSYS;
+
+	if (!mbox)
+		return -EINVAL;
+
+	/* Busy-poll the receive queue so a message enqueued from the
+	 * mailbox interrupt is picked up without a scheduler wakeup;
+	 * fall back to the blocking wait once the budget is spent.
+	 */
+	end = ktime_add_us(ktime_get(), poll_usec);
+	for (;;) {
+		ret = mboxq_dequeue(&mbox->recv_queue, data);
+		if (ret != -EBUSY)
+			return ret;
+		if (ktime_after(ktime_get(), end))
+			break;
+		cpu_relax();
+	}
+
+	return nvadsp_mbox_recv(mbox, data, true, timeout);
+}
+EXPORT_SYMBOL(nvadsp_mbox_recv_poll);
+
 status_t nvadsp_mbox_close(struct nvadsp_mbox *mbox)
 {
 	unsigned long flags;
@@ -162,6 +162,122 @@ fail:
 }
 EXPORT_SYMBOL_GPL(nvaudio_ivc_send_receive);
 
+/* Batched transaction towards the audio server.
+ *
+ * All count messages are pipelined into the IVC queue without waiting
+ * for individual replies. The server answers only messages with
+ * ack_required set, in submission order, and each reply is copied back
+ * into its slot in msgs[] so the caller can inspect the returned err
+ * and parameters. Messages with ack_required clear are fire and forget
+ * and complete as soon as they are queued.
+ *
+ * The wire format is unchanged - one nvaudio_ivc_msg per IVC frame -
+ * so the server needs no knowledge of the batching. The win over
+ * calling nvaudio_ivc_send_receive per message is that the server
+ * round trip is paid once per queue drain instead of once per message.
+ *
+ * Returns count on success or a negative error. On error the batch may
+ * be partially applied: messages already queued have reached the
+ * server.
+ */
+int nvaudio_ivc_send_receive_batch(struct nvaudio_ivc_ctxt *ictxt,
+			struct nvaudio_ivc_msg *msgs, int count, int size)
+{
+	int len = 0;
+	unsigned long flags = 0, flags1 = 0;
+	int err = 0;
+	int dcnt = 50;
+	int status = -1;
+	int sent = 0, next_ack = 0, pending = 0;
+
+	if (!ictxt || !ictxt->ivck || !msgs || !size || count <= 0)
+		return -EINVAL;
+
+	while (tegra_hv_ivc_channel_notified(ictxt->ivck) != 0) {
+		dev_err(ictxt->dev, "channel notified returns non zero\n");
+		dcnt--;
+		udelay(100);
+		if (!dcnt)
+			return -EIO;
+	}
+
+	spin_lock_irqsave(&ictxt->ivck_rx_lock, flags);
+
+	while (sent < count || pending > 0) {
+		spin_lock_irqsave(&ictxt->ivck_tx_lock, flags1);
+		while (sent < count && tegra_hv_ivc_can_write(ictxt->ivck)) {
+			len = tegra_hv_ivc_write(ictxt->ivck,
+						&msgs[sent], size);
+			if (len != size) {
+				pr_err("%s: write Error\n", __func__);
+				err = -EIO;
+				spin_unlock_irqrestore(&ictxt->ivck_tx_lock,
+							flags1);
+				goto fail;
+			}
+			if (msgs[sent].ack_required)
+				pending++;
+			sent++;
+		}
+		spin_unlock_irqrestore(&ictxt->ivck_tx_lock, flags1);
+
+		if (sent == count && pending == 0)
+			break;
+
+		if (pending > 0) {
+			err = readx_poll_timeout_atomic(tegra_hv_ivc_can_read,
+					ictxt->ivck, status, status, 10,
+					NVAUDIO_IVC_WAIT_TIMEOUT);
+			if (err == -ETIMEDOUT) {
+				pr_err("%s: Waited too long for msg reply\n",
+					__func__);
+				goto fail;
+			}
+
+			/* Replies arrive in submission order, for the
+			 * oldest queued message that requested an ack.
+			 */
+			while (next_ack < sent &&
+					!msgs[next_ack].ack_required)
+				next_ack++;
+
+			memset(&msgs[next_ack], 0,
+				sizeof(struct nvaudio_ivc_msg));
+			len = tegra_hv_ivc_read(ictxt->ivck,
+						&msgs[next_ack],
+						sizeof(struct nvaudio_ivc_msg));
+			if (len != sizeof(struct nvaudio_ivc_msg)) {
+				dev_err(ictxt->dev,
+					"IVC read failure (msg size error)\n");
+				err = -1;
+				goto fail;
+			}
+			next_ack++;
+			pending--;
+		} else {
+			/* Queue full with no reply outstanding - wait
+			 * for the server to make room.
+			 */
+			err = readx_poll_timeout_atomic(tegra_hv_ivc_can_write,
+					ictxt->ivck, status, status, 10,
+					NVAUDIO_IVC_WAIT_TIMEOUT);
+			if (err == -ETIMEDOUT) {
+				pr_err("%s: Waited too long for queue space\n",
+					__func__);
+				goto fail;
+			}
+		}
+	}
+
+	err = count;
+
+fail:
+	spin_unlock_irqrestore(&ictxt->ivck_rx_lock, flags);
+
+	return err;
+}
+EXPORT_SYMBOL_GPL(nvaudio_ivc_send_receive_batch);
+
 /* Every communication with the server is identified
  * with this ivc context.
  * There can be one outstanding request to the server per
@@ -53,6 +53,11 @@ int nvaudio_ivc_send_receive(struct nvaudio_ivc_ctxt *ictxt,
 				struct nvaudio_ivc_msg *msg,
 				int size);
 
+int nvaudio_ivc_send_receive_batch(struct nvaudio_ivc_ctxt *ictxt,
+				struct nvaudio_ivc_msg *msgs,
+				int count,
+				int size);
+
 int tegra124_virt_xbar_set_ivc(struct nvaudio_ivc_ctxt *ictxt,
 					int rx_idx,
 					int tx_idx);
@@ -239,6 +239,10 @@ static int nvdumper_probe(struct platform_device *pdev)
 
 	nvdumper_dbg_footprint_init();
 
+	ret = nvdumper_regions_init(nvdumper_ptr);
+	if (ret)
+		pr_warn("nvdumper: no region table, dump covers all of RAM\n");
+
 	nvdumper_last_reboot = get_dirty_state();
 	switch (nvdumper_last_reboot) {
 	case NVDUMPER_CLEAN:
@@ -270,6 +274,7 @@ err_out1:
 static int nvdumper_remove(struct platform_device *pdev)
 {
 	nvdumper_sysfs_exit();
+	nvdumper_regions_exit();
 	nvdumper_regdump_exit();
 	nvdumper_dbg_footprint_exit();
 	unregister_reboot_notifier(&nvdumper_reboot_notifier);
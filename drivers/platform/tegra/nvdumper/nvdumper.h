@@ -17,6 +17,19 @@
 #ifndef __PLATFORM_TEGRA_NVDUMPER_H
 #define __PLATFORM_TEGRA_NVDUMPER_H
 
+#include <linux/types.h>
+
+/*
+ * Priorities for registered dump regions.  The post-reboot dump
+ * tooling captures lower values first, so the most valuable state
+ * survives even a dump that is cut short.
+ */
+#define NVDUMPER_REGION_PRIO_HIGH	0
+#define NVDUMPER_REGION_PRIO_NORMAL	1
+#define NVDUMPER_REGION_PRIO_LOW	2
+
+#define NVDUMPER_REGION_NAME_LEN	16
+
 extern struct notifier_block nvdumper_panic_notifier;
 extern struct notifier_block nvdumper_die_notifier;
 
@@ -26,5 +39,10 @@ void nvdumper_regdump_exit(void);
 void nvdumper_crash_setup_regs(void);
 void nvdumper_print_data(void);
 void nvdumper_copy_regs(unsigned int id, struct pt_regs *regs, void *svc_sp);
+int nvdumper_regions_init(void __iomem *base);
+void nvdumper_regions_exit(void);
+int nvdumper_register_dump_region(const char *name, phys_addr_t base,
+				  size_t size, u32 prio);
+int nvdumper_unregister_dump_region(phys_addr_t base);
 
 #endif
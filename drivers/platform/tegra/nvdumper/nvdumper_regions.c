@@ -0,0 +1,201 @@
+/*
+ * drivers/platform/tegra/nvdumper/nvdumper_regions.c
+ *
+ * Copyright (c) 2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ */
+
+#include <linux/errno.h>
+#include <linux/io.h>
+#include <linux/kernel.h>
+#include <linux/module.h>
+#include <linux/spinlock.h>
+#include <asm/sections.h>
+#include "nvdumper.h"
+
+/*
+ * Region-of-interest table for the post-reboot RAM dump.
+ *
+ * The kernel never copies memory on a crash; the dump is taken by the
+ * bootloader after a dirty reboot.  By default that dump covers all of
+ * DRAM, which takes minutes on large-memory systems.  This table is
+ * written into the nvdumper reserved page so the dump tooling can
+ * capture only the listed physical regions, lowest priority value
+ * first, and fall back to a full dump when the table is absent or its
+ * magic does not match.
+ *
+ * Entries are published by writing the payload before bumping
+ * nr_regions, so a crash at any instant leaves the tooling with a
+ * consistent prefix of the table.
+ */
+
+#define NVDUMPER_REGIONS_MAGIC		0x5244524eU	/* "NRDR" */
+#define NVDUMPER_REGIONS_VERSION	1
+#define NVDUMPER_REGIONS_OFFSET		0x40
+#define NVDUMPER_MAX_REGIONS		32
+
+struct nvdumper_region_entry {
+	char name[NVDUMPER_REGION_NAME_LEN];
+	u64 base;
+	u64 size;
+	u32 prio;
+	u32 reserved;
+};
+
+struct nvdumper_region_table {
+	u32 magic;
+	u32 version;
+	u32 nr_regions;
+	u32 reserved;
+	struct nvdumper_region_entry entries[NVDUMPER_MAX_REGIONS];
+};
+
+static struct nvdumper_region_table __iomem *region_table;
+static struct nvdumper_region_entry region_shadow[NVDUMPER_MAX_REGIONS];
+static u32 nr_regions;
+static DEFINE_SPINLOCK(regions_lock);
+
+static void nvdumper_write_region(u32 idx)
+{
+	memcpy_toio(&region_table->entries[idx], &region_shadow[idx],
+		    sizeof(region_shadow[idx]));
+}
+
+int nvdumper_register_dump_region(const char *name, phys_addr_t base,
+				  size_t size, u32 prio)
+{
+	struct nvdumper_region_entry *entry;
+	unsigned long flags;
+	u32 i;
+
+	if (!region_table)
+		return -ENODEV;
+
+	if (!name || !size)
+		return -EINVAL;
+
+	spin_lock_irqsave(&regions_lock, flags);
+
+	for (i = 0; i < nr_regions; i++) {
+		if (region_shadow[i].base == base) {
+			spin_unlock_irqrestore(&regions_lock, flags);
+			return -EEXIST;
+		}
+	}
+
+	if (nr_regions >= NVDUMPER_MAX_REGIONS) {
+		spin_unlock_irqrestore(&regions_lock, flags);
+		return -ENOSPC;
+	}
+
+	entry = &region_shadow[nr_regions];
+	memset(entry, 0, sizeof(*entry));
+	strlcpy(entry->name, name, sizeof(entry->name));
+	entry->base = base;
+	entry->size = size;
+	entry->prio = prio;
+
+	nvdumper_write_region(nr_regions);
+	wmb();
+	nr_regions++;
+	iowrite32(nr_regions, &region_table->nr_regions);
+
+	spin_unlock_irqrestore(&regions_lock, flags);
+
+	pr_info("nvdumper: dump region %s at 0x%llx size 0x%zx prio %u\n",
+		name, (u64)base, size, prio);
+
+	return 0;
+}
+EXPORT_SYMBOL(nvdumper_register_dump_region);
+
+int nvdumper_unregister_dump_region(phys_addr_t base)
+{
+	unsigned long flags;
+	u32 i;
+
+	if (!region_table)
+		return -ENODEV;
+
+	spin_lock_irqsave(&regions_lock, flags);
+
+	for (i = 0; i < nr_regions; i++) {
+		if (region_shadow[i].base == base)
+			break;
+	}
+
+	if (i == nr_regions) {
+		spin_unlock_irqrestore(&regions_lock, flags);
+		return -ENOENT;
+	}
+
+	/*
+	 * Truncate the published table before rewriting the tail so the
+	 * dump tooling never sees a half-moved entry, then republish.
+	 */
+	iowrite32(i, &region_table->nr_regions);
+	wmb();
+
+	nr_regions--;
+	memmove(&region_shadow[i], &region_shadow[i + 1],
+		(nr_regions - i) * sizeof(region_shadow[0]));
+	for (; i < nr_regions; i++)
+		nvdumper_write_region(i);
+	wmb();
+	iowrite32(nr_regions, &region_table->nr_regions);
+
+	spin_unlock_irqrestore(&regions_lock, flags);
+
+	return 0;
+}
+EXPORT_SYMBOL(nvdumper_unregister_dump_region);
+
+int nvdumper_regions_init(void __iomem *base)
+{
+	if (!base)
+		return -EINVAL;
+
+	region_table = base + NVDUMPER_REGIONS_OFFSET;
+
+	iowrite32(0, &region_table->nr_regions);
+	iowrite32(NVDUMPER_REGIONS_VERSION, &region_table->version);
+	iowrite32(0, &region_table->reserved);
+	wmb();
+	iowrite32(NVDUMPER_REGIONS_MAGIC, &region_table->magic);
+
+	/*
+	 * The kernel image and its live data are what the first pass of
+	 * any crash analysis needs; register them up front so even an
+	 * otherwise empty table beats a full-DRAM dump.
+	 */
+	nvdumper_register_dump_region("kernel-text", __pa_symbol(_stext),
+				      _etext - _stext,
+				      NVDUMPER_REGION_PRIO_HIGH);
+	nvdumper_register_dump_region("kernel-data", __pa_symbol(_sdata),
+				      _edata - _sdata,
+				      NVDUMPER_REGION_PRIO_HIGH);
+	nvdumper_register_dump_region("kernel-bss", __pa_symbol(__bss_start),
+				      __bss_stop - __bss_start,
+				      NVDUMPER_REGION_PRIO_NORMAL);
+
+	return 0;
+}
+
+void nvdumper_regions_exit(void)
+{
+	if (!region_table)
+		return;
+
+	iowrite32(0, &region_table->magic);
+	region_table = NULL;
+	nr_regions = 0;
+}
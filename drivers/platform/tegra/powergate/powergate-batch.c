@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <linux/completion.h>
+#include <linux/err.h>
+#include <linux/kernel.h>
+#include <linux/slab.h>
+#include <linux/tegra-powergate.h>
+#include <linux/workqueue.h>
+#include <soc/tegra/tegra_powergate.h>
+
+struct pg_batch_work {
+	struct work_struct work;
+	const struct tegra_pg_batch_entry *entry;
+	struct pg_batch_work *batch;
+	struct completion done;
+	int err;
+};
+
+static void pg_batch_unpowergate_fn(struct work_struct *work)
+{
+	struct pg_batch_work *bw =
+		container_of(work, struct pg_batch_work, work);
+
+	if (bw->entry->depends_on >= 0) {
+		struct pg_batch_work *dep = &bw->batch[bw->entry->depends_on];
+
+		wait_for_completion(&dep->done);
+		if (dep->err) {
+			bw->err = -ECANCELED;
+			goto out;
+		}
+	}
+
+	bw->err = tegra_unpowergate_partition(bw->entry->id);
+out:
+	complete(&bw->done);
+}
+
+/**
+ * tegra_unpowergate_partitions - ungate a set of partitions concurrently
+ * @entries: batch to ungate; depends_on orders entries within the batch
+ * @count: number of entries
+ *
+ * Each entry is ungated from its own unbound work item, so independent
+ * partitions come up in parallel and a multi-engine wake costs only the
+ * longest dependency chain instead of the sum of all ungate latencies.
+ * An entry whose depends_on is a valid index into @entries waits for
+ * that entry to finish ungating first; depends_on must refer to an
+ * earlier entry (or be -1), which keeps the graph trivially acyclic.
+ *
+ * On any failure every partition that was ungated by this call is gated
+ * again and the first error is returned, so the batch takes effect as a
+ * whole or not at all.
+ */
+int tegra_unpowergate_partitions(const struct tegra_pg_batch_entry *entries,
+				 unsigned int count)
+{
+	struct pg_batch_work *batch;
+	unsigned int i;
+	int ret = 0;
+
+	if (!entries || !count)
+		return -EINVAL;
+
+	for (i = 0; i < count; i++) {
+		if (entries[i].depends_on >= (int)i)
+			return -EINVAL;
+	}
+
+	batch = kcalloc(count, sizeof(*batch), GFP_KERNEL);
+	if (!batch)
+		return -ENOMEM;
+
+	for (i = 0; i < count; i++) {
+		batch[i].entry = &entries[i];
+		batch[i].batch = batch;
+		init_completion(&batch[i].done);
+		INIT_WORK(&batch[i].work, pg_batch_unpowergate_fn);
+		queue_work(system_unbound_wq, &batch[i].work);
+	}
+
+	for (i = 0; i < count; i++) {
+		wait_for_completion(&batch[i].done);
+		if (batch[i].err && !ret && batch[i].err != -ECANCELED)
+			ret = batch[i].err;
+	}
+
+	if (ret) {
+		for (i = count; i-- > 0; ) {
+			if (!batch[i].err)
+				tegra_powergate_partition(entries[i].id);
+		}
+	}
+
+	kfree(batch);
+
+	return ret;
+}
+EXPORT_SYMBOL(tegra_unpowergate_partitions);
+
+/**
+ * tegra_powergate_partitions - gate a set of partitions
+ * @entries: batch to gate, same layout as tegra_unpowergate_partitions()
+ * @count: number of entries
+ *
+ * Gates the batch in reverse order so that a partition is always gated
+ * after every entry that depends on it. Gating is not on the wake
+ * critical path, so this runs serially. All entries are attempted; the
+ * first error is returned.
+ */
+int tegra_powergate_partitions(const struct tegra_pg_batch_entry *entries,
+			       unsigned int count)
+{
+	unsigned int i;
+	int ret = 0;
+	int err;
+
+	if (!entries || !count)
+		return -EINVAL;
+
+	for (i = count; i-- > 0; ) {
+		err = tegra_powergate_partition(entries[i].id);
+		if (err && !ret)
+			ret = err;
+	}
+
+	return ret;
+}
+EXPORT_SYMBOL(tegra_powergate_partitions);
@@ -151,7 +151,7 @@ static int send_msg_block(struct psc_debug_dev *dbg, void *tx)
 	if (ret < 0)
 		return ret;
 
-	mbox_client_txdone(dbg->chan, 0);
+	/* txdone is driven by the controller polling MBOX_IN_VALID */
 	ret = wait_for_completion_timeout(&dbg->rx_complete,
 			msecs_to_jiffies(dbg->cl.tx_tout));
 	return ret == 0 ? -ETIME : 0;
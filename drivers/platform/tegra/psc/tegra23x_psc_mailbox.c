@@ -19,9 +19,6 @@
 #include <linux/interrupt.h>
 #include <linux/mailbox_controller.h>
 
-/* from drivers/mailbox/mailbox.h */
-#include "mailbox.h"
-
 #include "tegra23x_psc.h"
 
 #define MBOX_NUM	8
@@ -87,6 +84,12 @@ static irqreturn_t  psc_mbox_rx_interrupt(int irq, void *p)
 	ext_ctrl |= MBOX_OUT_DONE;
 	writel(ext_ctrl, vm_chan->base + MBOX_CHAN_EXT_CTRL);
 
+	/* A response means the IN parameters were consumed long ago;
+	 * poll txdone now so the next queued request is staged without
+	 * waiting for the timer period.
+	 */
+	hrtimer_start(&vm_chan->parent->mbox.poll_hrt, 0, HRTIMER_MODE_REL);
+
 	return IRQ_HANDLED;
 }
 
@@ -112,13 +115,25 @@ static int psc_mbox_send_data(struct mbox_chan *chan, void *data)
 	return 0;
 }
 
+static bool psc_mbox_last_tx_done(struct mbox_chan *chan)
+{
+	struct mbox_vm_chan  *vm_chan = chan->con_priv;
+	u32 ext_ctrl;
+
+	/* PSC clears MBOX_IN_VALID once it has latched the IN
+	 * parameters; the next request can be staged while the previous
+	 * one is still being processed.
+	 */
+	ext_ctrl = readl(vm_chan->base + MBOX_CHAN_EXT_CTRL);
+	return (ext_ctrl & MBOX_IN_VALID) == 0;
+}
+
 static int psc_mbox_startup(struct mbox_chan *chan)
 {
 	struct mbox_vm_chan  *vm_chan = chan->con_priv;
 	u32 ext_ctrl = LIC_INTR_EN;
 
 	writel(ext_ctrl, vm_chan->base + MBOX_CHAN_EXT_CTRL);
-	chan->txdone_method = TXDONE_BY_ACK;
 	return 0;
 }
 
@@ -133,6 +148,7 @@ static void psc_mbox_shutdown(struct mbox_chan *chan)
 
 static const struct mbox_chan_ops psc_mbox_ops = {
 	.send_data = psc_mbox_send_data,
+	.last_tx_done = psc_mbox_last_tx_done,
 	.startup = psc_mbox_startup,
 	.shutdown = psc_mbox_shutdown,
 };
@@ -188,9 +204,13 @@ static int tegra234_psc_probe(struct platform_device *pdev)
 	psc->mbox.chans = &psc->chan[0];
 	psc->mbox.num_chans = MBOX_NUM;
 	psc->mbox.ops = &psc_mbox_ops;
-	/* drive txdone by mailbox client ACK with tx_block set to false */
+	/* txdone is detected by polling MBOX_IN_VALID so queued requests
+	 * pipeline per channel; clients that set knows_txdone keep the
+	 * explicit ACK behaviour.
+	 */
 	psc->mbox.txdone_irq = false;
-	psc->mbox.txdone_poll = false;
+	psc->mbox.txdone_poll = true;
+	psc->mbox.txpoll_period = 1;
 
 	platform_set_drvdata(pdev, psc);
 
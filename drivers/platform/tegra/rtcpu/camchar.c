@@ -20,6 +20,8 @@
 #include <linux/device.h>
 #include <linux/fs.h>
 #include <linux/kernel.h>
+#include <linux/log2.h>
+#include <linux/mm.h>
 #include <linux/module.h>
 #include <linux/mutex.h>
 #include <linux/of.h>
@@ -35,6 +37,7 @@
 #include <linux/tegra-ivc.h>
 #include <linux/tegra-ivc-bus.h>
 #include <linux/tegra-ivc-instance.h>
+#include <linux/vmalloc.h>
 #include <linux/wait.h>
 #include <asm/ioctls.h>
 #include <asm/uaccess.h>
@@ -47,6 +50,35 @@ typedef unsigned int __poll_t;
 #define CCIOGNFRAMES _IOR('c', 1, int)
 #define CCIOGNBYTES _IOR('c', 2, int)
 
+/* Readers are woken once this fraction of the ring has filled up */
+#define TEGRA_CAMCHAR_RING_WAKE_FRACTION 4
+
+/*
+ * Layout of the mmap()able diagnostic stream ring. The first page of
+ * the mapping holds this header and the records start on the next page
+ * boundary. head is advanced by the kernel after storing a record and
+ * tail is advanced by the reader after consuming one; both counters
+ * are free running and nrecords is a power of two, so head - tail is
+ * the fill level and counter & (nrecords - 1) indexes the record area.
+ * overflow counts records dropped while the ring was full.
+ */
+struct tegra_camchar_ring_header {
+	u32 head;
+	u32 tail;
+	u32 overflow;
+	u32 record_size;
+	u32 nrecords;
+	u32 watermark;
+};
+
+struct tegra_camchar_ring {
+	void *base;
+	size_t size;
+	u32 record_size;
+	u32 nrecords;
+	u32 watermark;
+};
+
 struct tegra_camchar_data {
 	struct cdev cdev;
 	struct tegra_ivc_channel *ch;
@@ -54,6 +86,9 @@ struct tegra_camchar_data {
 	wait_queue_head_t waitq;
 	bool is_open;
 	bool is_established;
+	/* Lock serializing ring installation against the notify path */
+	spinlock_t ring_lock;
+	struct tegra_camchar_ring *ring;
 };
 
 #define DEVICE_COUNT (128)
@@ -87,8 +122,21 @@ static int tegra_camchar_release(struct inode *in, struct file *fp)
 {
 	struct tegra_ivc_channel *ch = fp->private_data;
 	struct tegra_camchar_data *data;
+	struct tegra_camchar_ring *ring;
 
 	data = tegra_ivc_channel_get_drvdata(ch);
+
+	spin_lock_irq(&data->ring_lock);
+	ring = data->ring;
+	data->ring = NULL;
+	spin_unlock_irq(&data->ring_lock);
+
+	if (ring != NULL) {
+		/* Mapped pages stay alive until the mapping goes away */
+		vfree(ring->base);
+		kfree(ring);
+	}
+
 	tegra_ivc_channel_runtime_put(ch);
 	data->is_open = false;
 
@@ -104,8 +152,16 @@ static __poll_t tegra_camchar_poll(struct file *fp, struct poll_table_struct *pt
 	poll_wait(fp, &dev_data->waitq, pt);
 
 	mutex_lock(&dev_data->io_lock);
-	if (tegra_ivc_can_read(&ch->ivc))
+	spin_lock_irq(&dev_data->ring_lock);
+	if (dev_data->ring != NULL) {
+		struct tegra_camchar_ring_header *hdr = dev_data->ring->base;
+
+		if (READ_ONCE(hdr->head) != READ_ONCE(hdr->tail))
+			ret |= (EPOLLIN | EPOLLRDNORM);
+	} else if (tegra_ivc_can_read(&ch->ivc)) {
 		ret |= (EPOLLIN | EPOLLRDNORM);
+	}
+	spin_unlock_irq(&dev_data->ring_lock);
 	if (tegra_ivc_can_write(&ch->ivc))
 		ret |= (EPOLLOUT | EPOLLWRNORM);
 	mutex_unlock(&dev_data->io_lock);
@@ -124,6 +180,10 @@ static ssize_t tegra_camchar_read(struct file *fp, char __user *buffer, size_t l
 	if (WARN_ON(!ch->is_ready))
 		return -EIO;
 
+	/* Records are diverted into the ring while a mapping is active */
+	if (READ_ONCE(dev_data->ring) != NULL)
+		return -EBUSY;
+
 	len = min_t(size_t, len, ch->ivc.frame_size);
 	if (len == 0)
 		return 0;
@@ -237,11 +297,83 @@ static long tegra_camchar_ioctl(struct file *fp, unsigned int cmd,
 	return ret;
 }
 
+/*
+ * Maps a ring for the diagnostic stream. The mapping must be shared and
+ * start at offset 0; the number of records is derived from the mapping
+ * size, rounded down to a power of two. While the ring is installed the
+ * notify path copies incoming records straight into it instead of
+ * leaving them in the IVC queue for read().
+ */
+static int tegra_camchar_mmap(struct file *fp, struct vm_area_struct *vma)
+{
+	struct tegra_ivc_channel *ch = fp->private_data;
+	struct tegra_camchar_data *dev_data = tegra_ivc_channel_get_drvdata(ch);
+	size_t size = vma->vm_end - vma->vm_start;
+	struct tegra_camchar_ring *ring;
+	struct tegra_camchar_ring_header *hdr;
+	u32 nrecords;
+	int ret;
+
+	if (vma->vm_pgoff != 0 || !(vma->vm_flags & VM_SHARED))
+		return -EINVAL;
+
+	if (size < 2 * PAGE_SIZE)
+		return -EINVAL;
+
+	nrecords = (size - PAGE_SIZE) / ch->ivc.frame_size;
+	if (nrecords < 2)
+		return -EINVAL;
+	nrecords = rounddown_pow_of_two(nrecords);
+
+	ring = kzalloc(sizeof(*ring), GFP_KERNEL);
+	if (ring == NULL)
+		return -ENOMEM;
+
+	ring->base = vmalloc_user(size);
+	if (ring->base == NULL) {
+		kfree(ring);
+		return -ENOMEM;
+	}
+
+	ring->size = size;
+	ring->record_size = ch->ivc.frame_size;
+	ring->nrecords = nrecords;
+	ring->watermark = max(nrecords / TEGRA_CAMCHAR_RING_WAKE_FRACTION, 1U);
+
+	hdr = ring->base;
+	hdr->record_size = ring->record_size;
+	hdr->nrecords = ring->nrecords;
+	hdr->watermark = ring->watermark;
+
+	ret = remap_vmalloc_range(vma, ring->base, 0);
+	if (ret)
+		goto err_free;
+
+	mutex_lock(&dev_data->io_lock);
+	if (dev_data->ring != NULL) {
+		mutex_unlock(&dev_data->io_lock);
+		ret = -EBUSY;
+		goto err_free;
+	}
+	spin_lock_irq(&dev_data->ring_lock);
+	dev_data->ring = ring;
+	spin_unlock_irq(&dev_data->ring_lock);
+	mutex_unlock(&dev_data->io_lock);
+
+	return 0;
+
+err_free:
+	vfree(ring->base);
+	kfree(ring);
+	return ret;
+}
+
 static const struct file_operations tegra_camchar_fops = {
 	.open = tegra_camchar_open,
 	.poll = tegra_camchar_poll,
 	.read = tegra_camchar_read,
 	.write = tegra_camchar_write,
+	.mmap = tegra_camchar_mmap,
 	.release = tegra_camchar_release,
 	.unlocked_ioctl = tegra_camchar_ioctl,
 	.compat_ioctl = tegra_camchar_ioctl,
@@ -295,9 +427,64 @@ static void __exit tegra_camchar_exit(struct tegra_ivc_driver *drv)
 	pr_info("camchar: unloaded rtcpu character device driver\n");
 }
 
+/*
+ * Drains the IVC queue into the mapped ring. A full ring drops the
+ * newest record and accounts it in the overflow counter, so the stream
+ * keeps flowing and the loss is visible to the reader. Wakeups are
+ * batched: the reader is only woken once the fill level reaches the
+ * watermark or a record has been dropped.
+ */
+static void tegra_camchar_ring_drain(struct tegra_camchar_data *dev_data,
+				     struct tegra_ivc_channel *ch)
+{
+	struct tegra_camchar_ring *ring = dev_data->ring;
+	struct tegra_camchar_ring_header *hdr = ring->base;
+	void *records = ring->base + PAGE_SIZE;
+	const void *frame;
+	u32 head, tail;
+	bool wake = false;
+
+	while (tegra_ivc_can_read(&ch->ivc)) {
+		frame = tegra_ivc_read_get_next_frame(&ch->ivc);
+		if (IS_ERR(frame))
+			break;
+
+		head = READ_ONCE(hdr->head);
+		tail = READ_ONCE(hdr->tail);
+
+		if (head - tail < ring->nrecords) {
+			memcpy(records + (size_t)(head & (ring->nrecords - 1)) *
+			       ring->record_size, frame, ring->record_size);
+			/* Publish the record before moving head */
+			smp_wmb();
+			WRITE_ONCE(hdr->head, head + 1);
+
+			if (head + 1 - tail >= ring->watermark)
+				wake = true;
+		} else {
+			WRITE_ONCE(hdr->overflow, hdr->overflow + 1);
+			wake = true;
+		}
+
+		tegra_ivc_read_advance(&ch->ivc);
+	}
+
+	if (wake)
+		wake_up_interruptible(&dev_data->waitq);
+}
+
 static void tegra_camchar_notify(struct tegra_ivc_channel *ch)
 {
 	struct tegra_camchar_data *dev_data = tegra_ivc_channel_get_drvdata(ch);
+	unsigned long flags;
+
+	spin_lock_irqsave(&dev_data->ring_lock, flags);
+	if (dev_data->ring != NULL) {
+		tegra_camchar_ring_drain(dev_data, ch);
+		spin_unlock_irqrestore(&dev_data->ring_lock, flags);
+		return;
+	}
+	spin_unlock_irqrestore(&dev_data->ring_lock, flags);
 
 	wake_up_interruptible(&dev_data->waitq);
 }
@@ -356,6 +543,7 @@ static int tegra_camchar_probe(struct tegra_ivc_channel *ch)
 	data->cdev.owner = THIS_MODULE;
 	init_waitqueue_head(&data->waitq);
 	mutex_init(&data->io_lock);
+	spin_lock_init(&data->ring_lock);
 
 	tegra_ivc_channel_set_drvdata(ch, data);
 
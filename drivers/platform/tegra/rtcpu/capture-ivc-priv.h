@@ -27,6 +27,8 @@
 #define TOTAL_CHANNELS (NUM_CAPTURE_CHANNELS + NUM_CAPTURE_TRANSACTION_IDS)
 #define TRANS_ID_START_IDX NUM_CAPTURE_CHANNELS
 
+struct tegra_capture_ivc;
+
 /**
  * @brief Callback context of an IVC channel.
  */
@@ -37,6 +39,25 @@ struct tegra_capture_ivc_cb_ctx {
 	tegra_capture_ivc_cb_func cb_func;
 	/** Private context of a VI/ISP capture context */
 	const void *priv_context;
+	/** IVC channel context owning this callback context */
+	struct tegra_capture_ivc *civc;
+	/** Per-channel completion dispatch work */
+	struct work_struct work;
+	/** Spinlock protecting the pending message list */
+	spinlock_t msg_lock;
+	/** Messages copied off the IVC ring, awaiting dispatch */
+	struct list_head msg_list;
+};
+
+/**
+ * @brief Completion message copied off the IVC ring for deferred
+ *	per-channel dispatch.
+ */
+struct tegra_capture_ivc_msg {
+	/** Linked list node in the callback context message list */
+	struct list_head node;
+	/** Copy of the IVC frame, starts with tegra_capture_ivc_resp */
+	u8 data[];
 };
 
 /**
@@ -51,6 +72,8 @@ struct tegra_capture_ivc {
 	struct mutex ivc_wr_lock;
 	/** Deferred work */
 	struct work_struct work;
+	/** Workqueue running the per-channel completion works */
+	struct workqueue_struct *cb_wq;
 	/** Channel work queue head */
 	wait_queue_head_t write_q;
 	/** Array holding callbacks registered by each channel */
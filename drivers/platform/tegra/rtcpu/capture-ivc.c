@@ -25,6 +25,7 @@
 #include <linux/of.h>
 #include <linux/of_device.h>
 #include <linux/pm_runtime.h>
+#include <linux/slab.h>
 #include <linux/tegra-ivc.h>
 #include <linux/tegra-ivc-bus.h>
 #include <linux/nospec.h>
@@ -336,6 +337,60 @@ static inline void tegra_capture_ivc_recv_msg(
 	}
 }
 
+/*
+ * Drain and dispatch the pending messages of a single channel. Each
+ * channel has its own work, so one channel's slow status callback only
+ * backs up its own queue; completions for the other channels keep
+ * flowing on the other workers of the (unbound) workqueue. Messages of
+ * one channel are still delivered in arrival order.
+ */
+static void tegra_capture_ivc_cb_worker(struct work_struct *work)
+{
+	struct tegra_capture_ivc_cb_ctx *cb_ctx = container_of(work,
+			struct tegra_capture_ivc_cb_ctx, work);
+	struct tegra_capture_ivc *civc = cb_ctx->civc;
+	uint32_t id = cb_ctx - &civc->cb_ctx[0];
+	struct tegra_capture_ivc_msg *m;
+
+	for (;;) {
+		spin_lock(&cb_ctx->msg_lock);
+		m = list_first_entry_or_null(&cb_ctx->msg_list,
+				struct tegra_capture_ivc_msg, node);
+		if (m != NULL)
+			list_del(&m->node);
+		spin_unlock(&cb_ctx->msg_lock);
+
+		if (m == NULL)
+			break;
+
+		tegra_capture_ivc_recv_msg(civc, id,
+			(const struct tegra_capture_ivc_resp *)m->data);
+		kfree(m);
+	}
+}
+
+static void tegra_capture_ivc_queue_msg(struct tegra_capture_ivc *civc,
+		uint32_t id, const struct tegra_capture_ivc_resp *msg)
+{
+	struct tegra_capture_ivc_cb_ctx *cb_ctx = &civc->cb_ctx[id];
+	struct tegra_capture_ivc_msg *m;
+
+	m = kmalloc(sizeof(*m) + civc->chan->ivc.frame_size, GFP_KERNEL);
+	if (unlikely(m == NULL)) {
+		/* Dispatch inline rather than lose the completion. */
+		tegra_capture_ivc_recv_msg(civc, id, msg);
+		return;
+	}
+
+	memcpy(m->data, msg, civc->chan->ivc.frame_size);
+
+	spin_lock(&cb_ctx->msg_lock);
+	list_add_tail(&m->node, &cb_ctx->msg_list);
+	spin_unlock(&cb_ctx->msg_lock);
+
+	queue_work(civc->cb_wq, &cb_ctx->work);
+}
+
 static inline void tegra_capture_ivc_recv(struct tegra_capture_ivc *civc)
 {
 	struct ivc *ivc = &civc->chan->ivc;
@@ -349,7 +404,7 @@ static inline void tegra_capture_ivc_recv(struct tegra_capture_ivc *civc)
 		/* Check if message is valid */
 		if (!WARN(id >= TOTAL_CHANNELS, "Invalid rtcpu response id %u", id)) {
 			id = array_index_nospec(id, TOTAL_CHANNELS);
-			tegra_capture_ivc_recv_msg(civc, id, msg);
+			tegra_capture_ivc_queue_msg(civc, id, msg);
 		}
 
 		tegra_ivc_read_advance(ivc);
@@ -429,22 +484,44 @@ static int tegra_capture_ivc_probe(struct tegra_ivc_channel *chan)
 	for (i = TRANS_ID_START_IDX; i < ARRAY_SIZE(civc->cb_ctx); i++)
 		list_add_tail(&civc->cb_ctx[i].node, &civc->avl_ctx_list);
 
+	/* Initialize the per-channel completion dispatch contexts */
+	for (i = 0; i < ARRAY_SIZE(civc->cb_ctx); i++) {
+		civc->cb_ctx[i].civc = civc;
+		INIT_WORK(&civc->cb_ctx[i].work, tegra_capture_ivc_cb_worker);
+		spin_lock_init(&civc->cb_ctx[i].msg_lock);
+		INIT_LIST_HEAD(&civc->cb_ctx[i].msg_list);
+	}
+
+	civc->cb_wq = alloc_workqueue("capture-ivc-cb-%s",
+			WQ_HIGHPRI | WQ_UNBOUND, 0, service);
+	if (unlikely(civc->cb_wq == NULL))
+		return -ENOMEM;
+
 	tegra_ivc_channel_set_drvdata(chan, civc);
 
 	if (!strcmp("capture-control", service)) {
-		if (WARN_ON(__scivc_control != NULL))
-			return -EEXIST;
+		if (WARN_ON(__scivc_control != NULL)) {
+			ret = -EEXIST;
+			goto fail_wq;
+		}
 		__scivc_control = civc;
 	} else if (!strcmp("capture", service)) {
-		if (WARN_ON(__scivc_capture != NULL))
-			return -EEXIST;
+		if (WARN_ON(__scivc_capture != NULL)) {
+			ret = -EEXIST;
+			goto fail_wq;
+		}
 		__scivc_capture = civc;
 	} else {
 		dev_err(dev, "Unknown ivc channel %s\n", service);
-		return -EINVAL;
+		ret = -EINVAL;
+		goto fail_wq;
 	}
 
 	return 0;
+
+fail_wq:
+	destroy_workqueue(civc->cb_wq);
+	return ret;
 }
 
 static void tegra_capture_ivc_remove(struct tegra_ivc_channel *chan)
@@ -452,6 +529,8 @@ static void tegra_capture_ivc_remove(struct tegra_ivc_channel *chan)
 	struct tegra_capture_ivc *civc = tegra_ivc_channel_get_drvdata(chan);
 
 	cancel_work_sync(&civc->work);
+	/* runs the queued per-channel works to completion */
+	destroy_workqueue(civc->cb_wq);
 
 	if (__scivc_control == civc)
 		__scivc_control = NULL;
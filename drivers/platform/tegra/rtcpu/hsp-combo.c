@@ -18,8 +18,10 @@
 
 #include <linux/version.h>
 
+#include <linux/delay.h>
 #include <linux/device.h>
 #include <linux/kernel.h>
+#include <linux/ktime.h>
 #include <linux/module.h>
 #include <linux/of.h>
 #include <linux/pm_runtime.h>
@@ -48,8 +50,20 @@ struct camrtc_hsp {
 	wait_queue_head_t response_waitq;
 	atomic_t response;
 	long timeout;
+	u32 resp_latency_us;
 };
 
+/*
+ * Capture control responses typically arrive within ~10us, well below the
+ * interrupt + wakeup overhead of sleeping in the waitqueue. Spin up to this
+ * many microseconds for the response before sleeping; 0 disables spinning.
+ */
+static unsigned int camrtc_response_spin_limit_us = 20;
+module_param_named(response_spin_limit_us, camrtc_response_spin_limit_us,
+		   uint, 0644);
+MODULE_PARM_DESC(response_spin_limit_us,
+		 "Spin limit (us) before sleeping for an RTCPU response");
+
 struct camrtc_hsp_op {
 	int (*send)(struct camrtc_hsp *, int msg, long *timeout);
 	void (*group_ring)(struct camrtc_hsp *, u16 group);
@@ -77,18 +91,49 @@ static int camrtc_hsp_send(struct camrtc_hsp *camhsp,
 static int camrtc_hsp_recv(struct camrtc_hsp *camhsp,
 		int command, long *timeout)
 {
-	int response;
+	u32 spin_limit = READ_ONCE(camrtc_response_spin_limit_us);
+	ktime_t since = ktime_get();
+	s64 latency_us;
+	int response = -1;
+
+	/*
+	 * Adaptive wait: when the measured response latency is below the
+	 * spin limit, the response is expected to beat a sleeping wakeup,
+	 * so poll for it briefly before going through the waitqueue. The
+	 * response interrupt stays armed either way, so a late response
+	 * is simply picked up by wait_event_timeout() below.
+	 */
+	if (spin_limit != 0 && camhsp->resp_latency_us < spin_limit) {
+		u32 spin_us = min(spin_limit, 2 * camhsp->resp_latency_us + 1);
+		u32 elapsed;
+
+		for (elapsed = 0; elapsed < spin_us; elapsed++) {
+			response = atomic_xchg(&camhsp->response, -1);
+			if (response >= 0)
+				break;
+			udelay(1);
+		}
+	}
 
-	*timeout = wait_event_timeout(
-		camhsp->response_waitq,
-		(response = atomic_xchg(&camhsp->response, -1)) >= 0,
-		*timeout);
-	if (*timeout <= 0) {
-		dev_err(&camhsp->dev,
-			"request 0x%08x: response timeout\n", command);
-		return -ETIMEDOUT;
+	if (response < 0) {
+		*timeout = wait_event_timeout(
+			camhsp->response_waitq,
+			(response = atomic_xchg(&camhsp->response, -1)) >= 0,
+			*timeout);
+		if (*timeout <= 0) {
+			dev_err(&camhsp->dev,
+				"request 0x%08x: response timeout\n", command);
+			return -ETIMEDOUT;
+		}
 	}
 
+	/* Feed the measured latency back into the spin policy */
+	latency_us = ktime_us_delta(ktime_get(), since);
+	if (latency_us > USEC_PER_SEC)
+		latency_us = USEC_PER_SEC;
+	camhsp->resp_latency_us =
+		(3 * camhsp->resp_latency_us + (u32)latency_us) / 4;
+
 	dev_dbg(&camhsp->dev, "request 0x%08x: response 0x%08x\n",
 		command, response);
 
@@ -19,6 +19,7 @@
 #include <linux/of_device.h>
 #include <linux/pm_runtime.h>
 #include <linux/slab.h>
+#include <linux/workqueue.h>
 #include <linux/tegra-ivc.h>
 #include <linux/tegra-ivc-bus.h>
 #include <linux/tegra-camera-rtcpu.h>
@@ -41,6 +42,9 @@ struct tegra_ivc_region {
 struct tegra_ivc_bus {
 	struct device dev;
 	struct tegra_ivc_channel *chans;
+	bool has_priority;
+	atomic_t deferred_groups;
+	struct work_struct deferred_work;
 	unsigned num_regions;
 	struct tegra_ivc_region regions[];
 };
@@ -95,7 +99,7 @@ static struct tegra_ivc_channel *tegra_ivc_channel_create(
 		u32 rx;
 		u32 tx;
 	} start, end;
-	u32 version, channel_group, nframes, frame_size, queue_size;
+	u32 version, channel_group, priority, nframes, frame_size, queue_size;
 	const char *service;
 	int ret;
 
@@ -125,6 +129,10 @@ static struct tegra_ivc_channel *tegra_ivc_channel_create(
 	if (ret)
 		version = 0;
 
+	ret = of_property_read_u32(ch_node, NV(priority), &priority);
+	if (ret)
+		priority = 0;
+
 	ret = of_property_read_u32(ch_node, NV(group), &channel_group);
 	if (ret) {
 		dev_err(&chan->dev, "missing <%s> property\n", NV(group));
@@ -187,6 +195,7 @@ static struct tegra_ivc_channel *tegra_ivc_channel_create(
 	}
 
 	chan->group = channel_group;
+	chan->priority = priority;
 
 	tegra_ivc_channel_reset(&chan->ivc);
 
@@ -211,8 +220,8 @@ static struct tegra_ivc_channel *tegra_ivc_channel_create(
 	(++tlv)->tag = 0; /* terminator */
 
 	dev_info(&chan->dev,
-		"%s: ver=%u grp=%u RX[%ux%u]=0x%x-0x%x TX[%ux%u]=0x%x-0x%x\n",
-		ch_node->name, version, channel_group,
+		"%s: ver=%u grp=%u prio=%u RX[%ux%u]=0x%x-0x%x TX[%ux%u]=0x%x-0x%x\n",
+		ch_node->name, version, channel_group, priority,
 		nframes, frame_size, start.rx, end.rx,
 		nframes, frame_size, start.tx, end.tx);
 
@@ -246,15 +255,49 @@ static void tegra_ivc_channel_notify(struct tegra_ivc_channel *chan)
 	rcu_read_unlock();
 }
 
-void tegra_ivc_bus_notify(struct tegra_ivc_bus *bus, u16 group)
+static void tegra_ivc_bus_deferred_work(struct work_struct *work)
 {
+	struct tegra_ivc_bus *bus =
+		container_of(work, struct tegra_ivc_bus, deferred_work);
 	struct tegra_ivc_channel *chan;
+	u16 group = (u16)atomic_xchg(&bus->deferred_groups, 0);
 
 	for (chan = bus->chans; chan != NULL; chan = chan->next) {
-		if ((chan->group & group) != 0)
+		if ((chan->group & group) != 0 && chan->priority == 0)
 			tegra_ivc_channel_notify(chan);
 	}
 }
+
+void tegra_ivc_bus_notify(struct tegra_ivc_bus *bus, u16 group)
+{
+	struct tegra_ivc_channel *chan;
+	u16 deferred = 0;
+
+	/* Channels are sorted by descending priority */
+	for (chan = bus->chans; chan != NULL; chan = chan->next) {
+		if ((chan->group & group) == 0)
+			continue;
+
+		/*
+		 * On buses with priority channels, background channels
+		 * (e.g. the RTCPU log) are drained from a work item so
+		 * that they cannot delay priority traffic sharing the
+		 * notify context. Repeated doorbells are coalesced into
+		 * a single drain while the work is pending.
+		 */
+		if (bus->has_priority && chan->priority == 0) {
+			deferred |= chan->group;
+			continue;
+		}
+
+		tegra_ivc_channel_notify(chan);
+	}
+
+	if (deferred != 0) {
+		atomic_or(deferred, &bus->deferred_groups);
+		schedule_work(&bus->deferred_work);
+	}
+}
 EXPORT_SYMBOL(tegra_ivc_bus_notify);
 
 struct device_type tegra_ivc_bus_dev_type = {
@@ -293,6 +336,8 @@ static int tegra_ivc_bus_match(struct device *dev, struct device_driver *drv)
 
 static void tegra_ivc_bus_stop(struct tegra_ivc_bus *bus)
 {
+	cancel_work_sync(&bus->deferred_work);
+
 	while (bus->chans != NULL) {
 		struct tegra_ivc_channel *chan = bus->chans;
 
@@ -317,6 +362,7 @@ static int tegra_ivc_bus_start(struct tegra_ivc_bus *bus)
 
 		for_each_child_of_node(reg_spec.np, ch_node) {
 			struct tegra_ivc_channel *chan;
+			struct tegra_ivc_channel **link;
 
 			ret = of_property_read_string(ch_node,
 					"status", &status);
@@ -336,8 +382,18 @@ static int tegra_ivc_bus_start(struct tegra_ivc_bus *bus)
 				goto error;
 			}
 
-			chan->next = bus->chans;
-			bus->chans = chan;
+			/* Insert in descending priority order so that
+			 * tegra_ivc_bus_notify() services priority
+			 * channels first.
+			 */
+			link = &bus->chans;
+			while (*link != NULL &&
+				(*link)->priority >= chan->priority)
+				link = &(*link)->next;
+			chan->next = *link;
+			*link = chan;
+			if (chan->priority != 0)
+				bus->has_priority = true;
 		}
 	}
 
@@ -556,6 +612,8 @@ struct tegra_ivc_bus *tegra_ivc_bus_create(struct device *dev)
 		return ERR_PTR(-ENOMEM);
 
 	bus->num_regions = num;
+	atomic_set(&bus->deferred_groups, 0);
+	INIT_WORK(&bus->deferred_work, tegra_ivc_bus_deferred_work);
 	bus->dev.parent = dev;
 	bus->dev.type = &tegra_ivc_bus_dev_type;
 	bus->dev.bus = &tegra_ivc_bus_type;
@@ -51,8 +51,18 @@
 #define NV(p) "nvidia," #p
 
 #define WORK_INTERVAL_DEFAULT		100
+#define WORK_INTERVAL_MIN		4
 #define EXCEPTION_STR_LENGTH		2048
 
+/*
+ * Ring occupancy watermarks in percent of the event entries. Crossing
+ * the high mark halves the poll interval so a verbose firmware gets
+ * drained before its ring wraps; staying below the low mark relaxes
+ * the interval back towards the configured value.
+ */
+#define TRACE_FILL_HIGH_PERCENT		75
+#define TRACE_FILL_LOW_PERCENT		25
+
 /*
  * Private driver data structure
  */
@@ -88,9 +98,19 @@ struct tegra_rtcpu_trace {
 	struct delayed_work work;
 	unsigned long work_interval_jiffies;
 
+	/* adaptive drain */
+	unsigned long work_interval_min_jiffies;
+	unsigned long cur_interval_jiffies;
+	u32 fill_high_mark;
+	u32 fill_low_mark;
+	u32 last_fill;
+	u32 max_fill;
+
 	/* statistics */
 	u32 n_exceptions;
 	u64 n_events;
+	u64 n_high_watermark;
+	u64 n_overruns;
 
 	/* copy of the latest exception and event */
 	char last_exception_str[EXCEPTION_STR_LENGTH];
@@ -946,13 +966,55 @@ const char * const g_trace_nvcsi_intr_type_strs[] = {
 const unsigned int g_trace_nvcsi_intr_type_str_count =
 	ARRAY_SIZE(g_trace_nvcsi_intr_type_strs);
 
-static void rtcpu_trace_nvcsi_event(struct camrtc_event_struct *event)
+static void rtcpu_trace_nvcsi_eventlib_event(struct tegra_rtcpu_trace *tracer,
+				struct camrtc_event_struct *event)
+{
+#ifdef CONFIG_EVENTLIB
+	struct nvhost_device_data *pdata;
+	struct nv_camera_nvcsi_intr nvcsi_intr;
+	u64 ts;
+
+	/*
+	 * NVCSI errors land in the VI eventlib ring, so userspace can
+	 * correlate them with the frame begin/end events of the same
+	 * capture without collecting a second ring.
+	 */
+	if (tracer->vi_platform_device == NULL)
+		return;
+	pdata = platform_get_drvdata(tracer->vi_platform_device);
+	if (pdata == NULL)
+		return;
+
+	if (!pdata->eventlib_id) {
+		pr_warn("%s kernel eventlib id %d cannot be found\n",
+			__func__, pdata->eventlib_id);
+		return;
+	}
+
+	nvcsi_intr.intr_class = event->data.data32[0] & 0xff;
+	nvcsi_intr.intr_type = event->data.data32[1] & 0xff;
+	nvcsi_intr.index = event->data.data32[2];
+	nvcsi_intr.status = event->data.data32[3];
+
+	ts = ((u64)event->data.data32[5] << 32) |
+		(u64)event->data.data32[4];
+	keventlib_write(pdata->eventlib_id,
+		&nvcsi_intr,
+		sizeof(nvcsi_intr),
+		NVHOST_CAMERA_NVCSI_INTR,
+		ts);
+#endif
+}
+
+static void rtcpu_trace_nvcsi_event(struct tegra_rtcpu_trace *tracer,
+				struct camrtc_event_struct *event)
 {
 	u64 ts_tsc = ((u64)event->data.data32[5] << 32) |
 			(u64)event->data.data32[4];
 
 	switch (event->header.id) {
 	case camrtc_trace_nvcsi_intr:
+		rtcpu_trace_nvcsi_eventlib_event(tracer, event);
 		trace_rtcpu_nvcsi_intr(ts_tsc,
 			(event->data.data32[0] & 0xff),
 			(event->data.data32[1] & 0xff),
@@ -993,7 +1055,7 @@ static void rtcpu_trace_array_event(struct tegra_rtcpu_trace *tracer,
 		rtcpu_trace_isp_event(tracer, event);
 		break;
 	case CAMRTC_EVENT_MODULE_NVCSI:
-		rtcpu_trace_nvcsi_event(event);
+		rtcpu_trace_nvcsi_event(tracer, event);
 		break;
 	default:
 		trace_rtcpu_unknown(event->header.tstamp,
@@ -1113,6 +1175,18 @@ static inline void rtcpu_trace_events(struct tegra_rtcpu_trace *tracer)
 
 	new_next = array_index_nospec(new_next, tracer->event_entries);
 
+	/* Track how full the ring got between two drains. The firmware
+	 * overwrites unread entries on wrap, so a drain that finds the
+	 * ring (almost) full has most likely already lost events.
+	 */
+	tracer->last_fill = (new_next >= old_next) ?
+		(new_next - old_next) :
+		(tracer->event_entries - old_next + new_next);
+	if (tracer->last_fill > tracer->max_fill)
+		tracer->max_fill = tracer->last_fill;
+	if (tracer->last_fill >= (tracer->event_entries - 1))
+		tracer->n_overruns++;
+
 	if (old_next == new_next)
 		return;
 
@@ -1164,8 +1238,22 @@ static void rtcpu_trace_worker(struct work_struct *work)
 
 	tegra_rtcpu_trace_flush(tracer);
 
+	/* Adapt the poll interval to the observed ring occupancy */
+	if (tracer->last_fill >= tracer->fill_high_mark) {
+		tracer->n_high_watermark++;
+		tracer->cur_interval_jiffies =
+			max(tracer->cur_interval_jiffies / 2,
+				tracer->work_interval_min_jiffies);
+	} else if ((tracer->last_fill < tracer->fill_low_mark) &&
+		(tracer->cur_interval_jiffies <
+			tracer->work_interval_jiffies)) {
+		tracer->cur_interval_jiffies =
+			min(tracer->cur_interval_jiffies * 2,
+				tracer->work_interval_jiffies);
+	}
+
 	/* reschedule */
-	schedule_delayed_work(&tracer->work, tracer->work_interval_jiffies);
+	schedule_delayed_work(&tracer->work, tracer->cur_interval_jiffies);
 }
 
 /*
@@ -1190,6 +1278,11 @@ static int rtcpu_trace_debugfs_stats_read(
 
 	seq_printf(file, "Exceptions: %u\nEvents: %llu\n",
 			tracer->n_exceptions, tracer->n_events);
+	seq_printf(file, "Ring high watermarks: %llu\nRing overruns: %llu\n",
+			tracer->n_high_watermark, tracer->n_overruns);
+	seq_printf(file, "Ring max fill: %u/%u\nPoll interval: %u ms\n",
+			tracer->max_fill, tracer->event_entries,
+			jiffies_to_msecs(tracer->cur_interval_jiffies));
 
 	return 0;
 }
@@ -1362,6 +1455,12 @@ struct tegra_rtcpu_trace *tegra_rtcpu_trace_create(struct device *dev,
 
 	INIT_DELAYED_WORK(&tracer->work, rtcpu_trace_worker);
 	tracer->work_interval_jiffies = msecs_to_jiffies(param);
+	tracer->work_interval_min_jiffies = msecs_to_jiffies(WORK_INTERVAL_MIN);
+	tracer->cur_interval_jiffies = tracer->work_interval_jiffies;
+	tracer->fill_high_mark =
+		(tracer->event_entries * TRACE_FILL_HIGH_PERCENT) / 100;
+	tracer->fill_low_mark =
+		(tracer->event_entries * TRACE_FILL_LOW_PERCENT) / 100;
 
 	/* Done with initialization */
 	schedule_delayed_work(&tracer->work, 0);
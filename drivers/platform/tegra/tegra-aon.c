@@ -28,6 +28,7 @@
 #include <linux/tegra-ivc.h>
 #include <linux/tegra-ivc-instance.h>
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 4, 0)
+#include <linux/atomic.h>
 #include <linux/mailbox_client.h>
 #include <linux/completion.h>
 #else
@@ -82,6 +83,8 @@ struct aon_hsp {
 	struct aon_hsp_sm tx;
 	struct device dev;
 	struct completion emptied;
+	/* a notify doorbell is in flight, see tegra_aon_hsp_notify() */
+	atomic_t notify_pending;
 };
 #else
 struct aon_hsp {
@@ -215,10 +218,42 @@ static void aon_hsp_tx_empty_notify(struct mbox_client *cl, void *data,
 				    int empty_value)
 {
 	struct aon_hsp *aonhsp = dev_get_drvdata(cl->dev);
+	struct tegra_aon *aon = dev_get_drvdata(aonhsp->dev.parent);
 
 	(void)empty_value;	/* ignored */
 
 	complete(&aonhsp->emptied);
+
+	/*
+	 * Notifications raised while this doorbell was in flight were
+	 * coalesced onto it. If the remote consumed the semaphore before
+	 * the last coalesced bit was set, ring once more so no channel
+	 * is left stranded.
+	 */
+	atomic_set(&aonhsp->notify_pending, 0);
+	if (tegra_aon_hsp_ss_status(aon, aon->ivc_tx_ss) != 0 &&
+	    atomic_xchg(&aonhsp->notify_pending, 1) == 0)
+		tegra_aon_hsp_sm_tx_write(aonhsp, SMBOX_IVC_NOTIFY);
+}
+
+/*
+ * Ring the IVC notify doorbell only when needed.
+ *
+ * The per-channel signal itself is carried by the IVC tx shared
+ * semaphore: the channel bit is set before the doorbell is rung, and
+ * the remote clears the whole word only after it has emptied the
+ * notify mailbox. A doorbell that is still in flight therefore covers
+ * any bit set in the meantime, so back-to-back notifications can ride
+ * on it instead of paying the mailbox framework cost per signal.
+ */
+static void tegra_aon_hsp_notify(struct tegra_aon *aon)
+{
+	struct aon_hsp *aonhsp = aon->hsp;
+
+	if (atomic_xchg(&aonhsp->notify_pending, 1) != 0)
+		return;
+
+	tegra_aon_hsp_sm_tx_write(aonhsp, SMBOX_IVC_NOTIFY);
 }
 #else
 static int tegra_aon_hsp_sm_tx_write(struct aon_hsp *aonhsp, u32 value)
@@ -232,6 +267,28 @@ static bool tegra_aon_hsp_sm_tx_is_empty(struct aon_hsp *aonhsp)
 {
 	return tegra_hsp_sm_tx_is_empty(aonhsp->tx);
 }
+
+/*
+ * Ring the IVC notify doorbell only when needed.
+ *
+ * The per-channel signal itself is carried by the IVC tx shared
+ * semaphore: the channel bit is set before the doorbell is rung, and
+ * the remote clears the whole word only after it has emptied the
+ * notify mailbox. A mailbox that is still full therefore guarantees
+ * the remote has yet to look at the semaphore, so back-to-back
+ * notifications can ride on the doorbell already in flight.
+ */
+static void tegra_aon_hsp_notify(struct tegra_aon *aon)
+{
+	/* Read the semaphore back so the channel bit is posted before
+	 * the mailbox full state is sampled. */
+	(void)tegra_aon_hsp_ss_status(aon, aon->ivc_tx_ss);
+
+	if (!tegra_aon_hsp_sm_tx_is_empty(aon->hsp))
+		return;
+
+	tegra_aon_hsp_sm_tx_write(aon->hsp, SMBOX_IVC_NOTIFY);
+}
 #endif
 
 static void tegra_aon_notify_remote(struct ivc *ivc)
@@ -241,7 +298,7 @@ static void tegra_aon_notify_remote(struct ivc *ivc)
 	ivc_chan = container_of(ivc, struct tegra_aon_ivc_chan, ivc);
 	tegra_aon_hsp_ss_set(ivc_chan->aon, ivc_chan->aon->ivc_tx_ss,
 				BIT(ivc_chan->chan_id));
-	tegra_aon_hsp_sm_tx_write(ivc_chan->aon->hsp, SMBOX_IVC_NOTIFY);
+	tegra_aon_hsp_notify(ivc_chan->aon);
 }
 
 #define NV(p) "nvidia," p
@@ -666,6 +723,7 @@ static struct aon_hsp *aon_hsp_create(struct device *dev)
 
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 4, 0)
 	init_completion(&aonhsp->emptied);
+	atomic_set(&aonhsp->notify_pending, 0);
 	aonhsp->tx.client.tx_block = false;
 	aonhsp->rx.client.rx_callback = aon_hsp_rx_full_notify;
 	aonhsp->tx.client.tx_done = aon_hsp_tx_empty_notify;
@@ -243,6 +243,7 @@ struct tegra_cam_rtcpu {
 #endif
 	struct tegra_camrtc_mon *monitor;
 	u32 max_reboot_retry;
+	bool fast_resume;
 	bool powered;
 	bool boot_sync_done;
 	bool fw_active;
@@ -960,6 +961,9 @@ static int tegra_camrtc_boot(struct device *dev)
 			tegra_camrtc_assert_resets(dev);
 			usleep_range(10, 30);
 			tegra_camrtc_deassert_resets(dev);
+			/* Freshly reset firmware needs the full handshake */
+			rtcpu->boot_sync_done = false;
+			rtcpu->fw_active = false;
 		}
 	}
 
@@ -1225,6 +1229,9 @@ static int tegra_cam_rtcpu_probe(struct platform_device *pdev)
 	rtcpu->max_reboot_retry = 3;
 	(void)of_property_read_u32(dev->of_node, NV(max-reboot),
 			&rtcpu->max_reboot_retry);
+
+	rtcpu->fast_resume = of_property_read_bool(dev->of_node,
+			NV(fast-resume));
 	timeout = 2000;
 	if (tegra_platform_is_vdk())
 		timeout = 5000;
@@ -1414,8 +1421,53 @@ static int tegra_camrtc_halt(struct device *dev, char const *op)
 	return 0;
 }
 
+/*
+ * Fast suspend leaves the core powered with resets deasserted so the
+ * firmware keeps its state in SRAM: resume is then just the firmware
+ * resume handshake plus shared memory sync instead of a cold boot.
+ * Only usable on platforms where the suspend state retains the camera
+ * RTCPU power partition; opted into with the nvidia,fast-resume DT
+ * property.
+ */
+static int tegra_camrtc_fast_suspend(struct device *dev)
+{
+	struct tegra_cam_rtcpu *rtcpu = dev_get_drvdata(dev);
+	int err = 0;
+
+	tegra_camrtc_pm_start(dev, "fast_suspend");
+
+	tegra_camrtc_set_online(dev, false);
+
+	if (!rtcpu->powered) {
+		tegra_camrtc_pm_done(dev, "fast_suspend", 0);
+		return 0;
+	}
+
+	if (!pm_runtime_suspended(dev))
+		/* Tell CAMRTC that it should power down camera devices */
+		err = tegra_camrtc_fw_suspend(dev);
+
+	if (err == 0) {
+		/* Keep power and resets, just drop clocks to idle speed */
+		camrtc_clk_group_adjust_slow(rtcpu->clocks);
+	} else {
+		/* Unresponsive firmware: power off for a clean cold boot */
+		dev_warn(dev, "fast suspend failed, powering off\n");
+		tegra_camrtc_poweroff(dev);
+	}
+
+	tegra_camrtc_pm_done(dev, "fast_suspend", err); /* note this is not returned */
+
+	return 0;
+}
+
 static int tegra_camrtc_suspend(struct device *dev)
 {
+	struct tegra_cam_rtcpu *rtcpu = dev_get_drvdata(dev);
+
+	if (rtcpu->fast_resume)
+		return tegra_camrtc_fast_suspend(dev);
+
 	return tegra_camrtc_halt(dev, "suspend");
 }
 
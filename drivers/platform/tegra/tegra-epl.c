@@ -14,6 +14,9 @@
 #include <linux/pm.h>
 #include <linux/kthread.h>
 #include <linux/mutex.h>
+#include <linux/spinlock.h>
+#include <linux/workqueue.h>
+#include <linux/jiffies.h>
 
 /* Timeout in milliseconds */
 #define TIMEOUT		5U
@@ -27,6 +30,17 @@
 /* Error index offset in mission status register */
 #define ERROR_INDEX_OFFSET	24U
 
+/* Report coalescing: the HSP mailbox carries one report frame per
+ * transaction, so a storm of identical reports (e.g. a flaky camera
+ * deserializer) floods the channel and delays other safety traffic.
+ * The first occurrence of each (reporter, error code) pair is sent
+ * immediately; repeats within the window are folded into one trailing
+ * report, and a sustained storm backs the window off exponentially.
+ */
+#define EPL_COALESCE_WINDOW_MS		10U
+#define EPL_COALESCE_WINDOW_MAX_MS	1000U
+#define EPL_COALESCE_SLOTS		8
+
 enum handshake_state {
 	HANDSHAKE_PENDING,
 	HANDSHAKE_FAILED,
@@ -69,6 +83,21 @@ static struct epl_misc_sw_err_cfg miscerr_cfg[NUM_SW_GENERIC_ERR];
 static enum handshake_state hs_state = HANDSHAKE_PENDING;
 static DEFINE_MUTEX(hs_state_mutex);
 
+/* Data type for a report awaiting its coalescing window to close */
+struct epl_pending_report {
+	struct epl_error_report_frame frame;
+	uint32_t count;		/* repeats folded into this slot */
+	uint32_t window_ms;
+	unsigned long window_start;	/* jiffies */
+	bool in_use;
+};
+
+static struct epl_pending_report pending_reports[EPL_COALESCE_SLOTS];
+static DEFINE_SPINLOCK(pending_lock);
+
+static void epl_coalesce_work_fn(struct work_struct *work);
+static DECLARE_DELAYED_WORK(coalesce_work, epl_coalesce_work_fn);
+
 static struct task_struct *fsi_handshake_thread;
 
 static void tegra_hsp_tx_empty_notify(struct mbox_client *cl,
@@ -105,6 +134,7 @@ static ssize_t device_file_ioctl(
 			struct file *fp, unsigned int cmd, unsigned long arg)
 {
 	uint32_t lData[MAX_LEN];
+	struct epl_error_report_frame error_report;
 	int ret;
 
 	if (copy_from_user(lData, (void __user *)arg,
@@ -114,12 +144,9 @@ static ssize_t device_file_ioctl(
 	switch (cmd) {
 
 	case EPL_REPORT_ERROR_CMD:
-		mutex_lock(&hs_state_mutex);
-		if (hs_state == HANDSHAKE_DONE)
-			ret = mbox_send_message(epl_hsp_v->tx.chan, (void *) lData);
-		else
-			ret = -ENODEV;
-		mutex_unlock(&hs_state_mutex);
+		/* route through the same coalescing as in-kernel clients */
+		memcpy(&error_report, lData, sizeof(error_report));
+		ret = epl_report_error(error_report);
 
 		break;
 	default:
@@ -185,9 +212,9 @@ int epl_report_misc_ec_error(struct device *dev, uint8_t err_number,
 }
 EXPORT_SYMBOL_GPL(epl_report_misc_ec_error);
 
-int epl_report_error(struct epl_error_report_frame error_report)
+static int epl_send_frame(struct epl_error_report_frame *frame)
 {
-	int ret = -EINVAL;
+	int ret;
 
 	mutex_lock(&hs_state_mutex);
 	if (epl_hsp_v == NULL || hs_state != HANDSHAKE_DONE) {
@@ -196,10 +223,122 @@ int epl_report_error(struct epl_error_report_frame error_report)
 	}
 	mutex_unlock(&hs_state_mutex);
 
-	ret = mbox_send_message(epl_hsp_v->tx.chan, (void *)&error_report);
+	ret = mbox_send_message(epl_hsp_v->tx.chan, (void *)frame);
 
 	return ret < 0 ? ret : 0;
 }
+
+static void epl_coalesce_work_fn(struct work_struct *work)
+{
+	struct epl_error_report_frame frame;
+	unsigned long flags;
+	bool pending = false;
+	uint32_t count = 0;
+	int i;
+
+	for (i = 0; i < EPL_COALESCE_SLOTS; i++) {
+		struct epl_pending_report *slot = &pending_reports[i];
+		bool send = false;
+
+		spin_lock_irqsave(&pending_lock, flags);
+		if (slot->in_use) {
+			if (time_after_eq(jiffies, slot->window_start +
+					  msecs_to_jiffies(slot->window_ms))) {
+				if (slot->count != 0U) {
+					frame = slot->frame;
+					count = slot->count;
+					slot->count = 0U;
+					slot->window_start = jiffies;
+					/* storm: back the report rate off */
+					slot->window_ms = min(slot->window_ms * 2U,
+							EPL_COALESCE_WINDOW_MAX_MS);
+					pending = true;
+					send = true;
+				} else {
+					/* window passed quietly, stop tracking */
+					slot->in_use = false;
+				}
+			} else {
+				pending = true;
+			}
+		}
+		spin_unlock_irqrestore(&pending_lock, flags);
+
+		if (send) {
+			/* one trailing report stands in for all repeats */
+			if (epl_send_frame(&frame) == 0)
+				pr_debug("tegra-epl: coalesced %u repeats of error 0x%x from reporter 0x%x\n",
+					 count, frame.error_code,
+					 frame.reporter_id);
+		}
+	}
+
+	if (pending)
+		schedule_delayed_work(&coalesce_work,
+				      msecs_to_jiffies(EPL_COALESCE_WINDOW_MS));
+}
+
+static void epl_coalesce_reset(void)
+{
+	unsigned long flags;
+	int i;
+
+	cancel_delayed_work_sync(&coalesce_work);
+
+	spin_lock_irqsave(&pending_lock, flags);
+	for (i = 0; i < EPL_COALESCE_SLOTS; i++)
+		pending_reports[i].in_use = false;
+	spin_unlock_irqrestore(&pending_lock, flags);
+}
+
+int epl_report_error(struct epl_error_report_frame error_report)
+{
+	struct epl_pending_report *slot = NULL, *free_slot = NULL;
+	unsigned long flags;
+	int i;
+
+	spin_lock_irqsave(&pending_lock, flags);
+	for (i = 0; i < EPL_COALESCE_SLOTS; i++) {
+		if (!pending_reports[i].in_use) {
+			if (free_slot == NULL)
+				free_slot = &pending_reports[i];
+			continue;
+		}
+		if (pending_reports[i].frame.reporter_id == error_report.reporter_id &&
+		    pending_reports[i].frame.error_code == error_report.error_code) {
+			slot = &pending_reports[i];
+			break;
+		}
+	}
+
+	if (slot) {
+		/* repeat within the window: fold into the pending slot,
+		 * keeping the most recent timestamp and attribute
+		 */
+		slot->frame = error_report;
+		slot->count++;
+		spin_unlock_irqrestore(&pending_lock, flags);
+		return 0;
+	}
+
+	if (free_slot) {
+		free_slot->in_use = true;
+		free_slot->frame = error_report;
+		free_slot->count = 0U;
+		free_slot->window_ms = EPL_COALESCE_WINDOW_MS;
+		free_slot->window_start = jiffies;
+	}
+	spin_unlock_irqrestore(&pending_lock, flags);
+
+	if (free_slot)
+		schedule_delayed_work(&coalesce_work,
+				      msecs_to_jiffies(EPL_COALESCE_WINDOW_MS));
+
+	/* the first occurrence always goes straight to the FSI; if the
+	 * slot table is exhausted the report is sent unthrottled
+	 */
+	return epl_send_frame(&error_report);
+}
 EXPORT_SYMBOL_GPL(epl_report_error);
 
 static int epl_client_fsi_handshake(void *arg)
@@ -240,6 +379,9 @@ static int __maybe_unused epl_client_suspend(struct device *dev)
 {
 	pr_debug("tegra-epl: suspend called\n");
 
+	/* originals of any pending repeats were already sent */
+	epl_coalesce_reset();
+
 	mutex_lock(&hs_state_mutex);
 	hs_state = HANDSHAKE_PENDING;
 	mutex_unlock(&hs_state_mutex);
@@ -371,6 +513,7 @@ static int epl_client_probe(struct platform_device *pdev)
 
 static int epl_client_remove(struct platform_device *pdev)
 {
+	epl_coalesce_reset();
 	epl_unregister_device();
 	return 0;
 }
@@ -57,11 +57,7 @@ struct tegra_hv_xhci_debug {
 
 	spinlock_t lock;
 
-	void *rx_frame;
 	u8 *rx_buf;
-	void *tx_frame;
-	u8 *tx_buf;
-	void *buf;
 	int rx_cnt;
 };
 
@@ -98,18 +94,34 @@ static ssize_t fw_log_file_read(struct file *file, char __user *buf,
 			if (!tegra_hv_ivc_can_read(tegra->ivck))
 				break;
 
-			rc = tegra_hv_ivc_read(tegra->ivck, tegra->rx_frame,
-					tegra->ivck->frame_size);
-
-			if (rc < 0) {
-				dev_err(dev, "ivc_read failied %d\n", rc);
-				return rc;
+			/*
+			 * Consume the frame in place: it stays valid until
+			 * the read pointer is advanced, so the payload can
+			 * be copied straight to userspace without staging
+			 * it in a bounce buffer first.
+			 */
+			header = tegra_hv_ivc_read_get_next_frame(tegra->ivck);
+			if (IS_ERR_OR_NULL(header)) {
+				dev_err(dev, "ivc read frame failed\n");
+				return -EIO;
 			}
-			header = tegra->rx_frame;
 
 			dev_dbg(dev, "%s received %u bytes\n", __func__,
 				header->size);
-			tegra->rx_cnt = header->size;
+			tegra->rx_cnt = min_t(u32, header->size,
+					tegra->ivck->frame_size - HDR_SIZE);
+			tegra->rx_buf = (u8 *)header + HDR_SIZE;
+
+			if (tegra->rx_cnt == 0) {
+				/* empty frame, release it and try the next */
+				rc = tegra_hv_ivc_read_advance(tegra->ivck);
+				if (rc < 0) {
+					dev_err(dev, "ivc_read_advance failed %d\n",
+						rc);
+					return rc;
+				}
+				continue;
+			}
 		}
 
 		s = min_t(int, count, tegra->rx_cnt);
@@ -121,8 +133,14 @@ static ssize_t fw_log_file_read(struct file *file, char __user *buf,
 
 			tegra->rx_cnt -= s;
 			tegra->rx_buf += s;
-			if (tegra->rx_cnt == 0)
-				tegra->rx_buf = tegra->rx_frame + HDR_SIZE;
+			if (tegra->rx_cnt == 0) {
+				rc = tegra_hv_ivc_read_advance(tegra->ivck);
+				if (rc < 0) {
+					dev_err(dev, "ivc_read_advance failed %d\n",
+						rc);
+					return rc;
+				}
+			}
 
 			count -= s;
 			n += s;
@@ -272,17 +290,6 @@ static int tegra_hv_xhci_debug_probe(struct platform_device *pdev)
 	dev_info(dev, "Reserved IVC channel #%d - frame_size=%d irq %d\n",
 			id, tegra->ivck->frame_size, tegra->ivck->irq);
 
-	/* allocate temporary frames */
-	tegra->buf = devm_kzalloc(dev, tegra->ivck->frame_size * 2, GFP_KERNEL);
-	if (!tegra->buf) {
-		ret = -ENOMEM;
-		goto out_unreserve;
-	}
-	tegra->rx_frame = tegra->buf;
-	tegra->rx_buf = tegra->rx_frame + HDR_SIZE;
-	tegra->tx_frame = tegra->rx_frame + tegra->ivck->frame_size;
-	tegra->tx_buf = tegra->tx_frame + HDR_SIZE;
-
 	init_waitqueue_head(&tegra->read_wait);
 
 	tegra->pdev = pdev;
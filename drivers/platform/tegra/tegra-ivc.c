@@ -267,6 +267,15 @@ uint32_t tegra_ivc_tx_frames_available(struct ivc *ivc)
 }
 EXPORT_SYMBOL(tegra_ivc_tx_frames_available);
 
+uint32_t tegra_ivc_rx_frames_available(struct ivc *ivc)
+{
+	ivc_invalidate_counter(ivc, ivc->rx_handle +
+			offsetof(struct ivc_channel_header, w_count));
+	return READ_ONCE(ivc->rx_channel->w_count) -
+			READ_ONCE(ivc->rx_channel->r_count);
+}
+EXPORT_SYMBOL(tegra_ivc_rx_frames_available);
+
 static void *ivc_frame_pointer(struct ivc *ivc, struct ivc_channel_header *ch,
 		uint32_t frame)
 {
@@ -529,6 +538,135 @@ int tegra_ivc_write(struct ivc *ivc, const void *buf, size_t size)
 }
 EXPORT_SYMBOL(tegra_ivc_write);
 
+/*
+ * Write up to count frames of size bytes each, taken back to back from buf,
+ * updating the write counter and ringing the doorbell once for the whole
+ * batch instead of once per frame. Returns the number of frames written,
+ * which may be less than count if the channel fills up, or a negative error
+ * if the channel is not established or no frame could be written.
+ */
+int tegra_ivc_write_batch(struct ivc *ivc, const void *buf, size_t size,
+		uint32_t count)
+{
+	uint32_t written = 0;
+	int result;
+
+	if (size > ivc->frame_size)
+		return -E2BIG;
+
+	result = ivc_check_write(ivc);
+	if (result)
+		return result;
+
+	while (written < count) {
+		void *p;
+
+		if (ivc_check_write(ivc))
+			break;
+
+		p = ivc_frame_pointer(ivc, ivc->tx_channel, ivc->w_pos);
+
+		memcpy(p, buf + (size_t)written * size, size);
+		memset(p + size, 0, ivc->frame_size - size);
+		ivc_flush_frame(ivc, ivc->tx_handle, ivc->w_pos, 0, size);
+
+		/*
+		 * Ensure that updated data is visible before the w_pos
+		 * counter indicates that it is ready.
+		 */
+		ivc_wmb();
+
+		ivc_advance_tx(ivc);
+		written++;
+	}
+
+	ivc_flush_counter(ivc, ivc->tx_handle +
+			offsetof(struct ivc_channel_header, w_count));
+
+	/*
+	 * Ensure our write to w_pos occurs before our read from r_pos.
+	 */
+	ivc_mb();
+
+	/*
+	 * Notify when the batch may have taken the channel from empty to
+	 * non-empty. The available count can only asynchronously decrease,
+	 * so the worst possible side-effect will be a spurious notification.
+	 */
+	ivc_invalidate_counter(ivc, ivc->tx_handle +
+		offsetof(struct ivc_channel_header, r_count));
+
+	if (ivc_channel_avail_count(ivc, ivc->tx_channel) <= written)
+		ivc->notify(ivc);
+
+	return (int)written;
+}
+EXPORT_SYMBOL(tegra_ivc_write_batch);
+
+/*
+ * Read up to count frames of size bytes each into buf, consuming them from
+ * the channel and ringing the doorbell once for the whole batch. Returns the
+ * number of frames read, which may be less than count if the channel drains,
+ * or a negative error if the channel is not established or empty.
+ */
+int tegra_ivc_read_batch(struct ivc *ivc, void *buf, size_t size,
+		uint32_t count)
+{
+	uint32_t read = 0;
+	int result;
+
+	if (size > ivc->frame_size)
+		return -E2BIG;
+
+	result = ivc_check_read(ivc);
+	if (result)
+		return result;
+
+	/*
+	 * Order observation of w_pos potentially indicating new data before
+	 * data read.
+	 */
+	ivc_rmb();
+
+	while (read < count) {
+		const void *src;
+
+		if (ivc_check_read(ivc))
+			break;
+
+		ivc_invalidate_frame(ivc, ivc->rx_handle, ivc->r_pos, 0, size);
+		src = ivc_frame_pointer(ivc, ivc->rx_channel, ivc->r_pos);
+
+		memcpy(buf + (size_t)read * size, src, size);
+
+		ivc_advance_rx(ivc);
+		read++;
+	}
+
+	ivc_flush_counter(ivc, ivc->rx_handle +
+			offsetof(struct ivc_channel_header, r_count));
+
+	/*
+	 * Ensure our write to r_pos occurs before our read from w_pos.
+	 */
+	ivc_mb();
+
+	/*
+	 * Notify when the batch may have taken the channel from full to
+	 * non-full. The available count can only asynchronously increase,
+	 * so the worst possible side-effect will be a spurious notification.
+	 */
+	ivc_invalidate_counter(ivc, ivc->rx_handle +
+		offsetof(struct ivc_channel_header, w_count));
+
+	if (ivc_channel_avail_count(ivc, ivc->rx_channel) + read >=
+			ivc->nframes)
+		ivc->notify(ivc);
+
+	return (int)read;
+}
+EXPORT_SYMBOL(tegra_ivc_read_batch);
+
 int tegra_ivc_write_user(struct ivc *ivc, const void __user *user_buf,
 		size_t size)
 {
@@ -18,6 +18,8 @@
 #include <linux/kernel.h>
 #include <linux/module.h>
 #include <linux/debugfs.h>
+#include <linux/dma-mapping.h>
+#include <linux/mm.h>
 #include <linux/of.h>
 #include <linux/of_address.h>
 #include <linux/of_reserved_mem.h>
@@ -90,6 +92,14 @@ static u32 thresholds[AON_PSTATES_TOTAL];
 
 static u32 mods_result = MODS_DEFAULT_VAL;
 
+/* Page the AON firmware periodically publishes its stats into, see
+ * struct aon_stats_page. Protected by aon_mutex except for the
+ * seqcnt-validated snapshot readers.
+ */
+static void *aon_stats_page_va;
+static dma_addr_t aon_stats_page_dma;
+static u32 aon_stats_period;
+
 static unsigned int completion_timeout = 50;
 
 static DEFINE_MUTEX(aon_mutex);
@@ -177,6 +187,12 @@ static struct aon_dbg_response *aon_create_ivc_dbg_req(u32 request,
 	case AON_MODS_LOOPS_TEST:
 		req.data.mods_xfer.loops = data;
 		break;
+	case AON_STATS_BUFFER:
+		req.data.stats_xfer.flag = flag;
+		req.data.stats_xfer.period_ms = (flag) ? data : 0;
+		req.data.stats_xfer.addr = (u64)aon_stats_page_dma;
+		req.data.stats_xfer.size = PAGE_SIZE;
+		break;
 	case AON_PM_VDD_RTC_RETENTION:
 		req.data.pm_xfer.type.retention.flag = flag;
 		req.data.pm_xfer.type.retention.enable = (flag) ? data : 0;
@@ -577,6 +593,113 @@ static int aon_timeout_store(void *data, u64 val)
 DEFINE_SIMPLE_ATTRIBUTE(aon_timeout_fops, aon_timeout_show,
 			aon_timeout_store, "%lld\n");
 
+static int aon_stats_period_show(void *data, u64 *val)
+{
+	mutex_lock(&aon_mutex);
+	*val = aon_stats_period;
+	mutex_unlock(&aon_mutex);
+
+	return 0;
+}
+
+static int aon_stats_period_store(void *data, u64 val)
+{
+	struct aon_dbg_response *resp;
+	int ret = 0;
+
+	if (val > U32_MAX)
+		return -EINVAL;
+
+	mutex_lock(&aon_mutex);
+	if (!aon_stats_page_va) {
+		mutex_unlock(&aon_mutex);
+		return -ENODEV;
+	}
+	resp = aon_create_ivc_dbg_req(*(u32 *)data, WRITE, val);
+	if (IS_ERR(resp))
+		ret = PTR_ERR(resp);
+	else
+		aon_stats_period = val;
+	mutex_unlock(&aon_mutex);
+
+	return ret;
+}
+
+DEFINE_SIMPLE_ATTRIBUTE(aon_stats_period_fops, aon_stats_period_show,
+			aon_stats_period_store, "%lld\n");
+
+static int aon_stats_snapshot_show(struct seq_file *file, void *data)
+{
+	struct aon_stats_page *page = aon_stats_page_va;
+	struct aon_stats_page snap;
+	bool consistent = false;
+	int tries = 10;
+	u32 seqcnt;
+	int i;
+
+	if (!page)
+		return -ENODEV;
+
+	/* Lock-free against the firmware; retry if an update raced us. */
+	while (tries--) {
+		seqcnt = READ_ONCE(page->seqcnt);
+		if (seqcnt & 1) {
+			cpu_relax();
+			continue;
+		}
+		smp_rmb();
+		memcpy(&snap, page, sizeof(snap));
+		smp_rmb();
+		if (READ_ONCE(page->seqcnt) == seqcnt) {
+			consistent = true;
+			break;
+		}
+	}
+	if (!consistent)
+		return -EBUSY;
+	if (!snap.update_count)
+		return -ENODATA;
+
+	for (i = 0; i < ARRAY_SIZE(snap.state_durations); i++) {
+		seq_printf(file, "%s: %llu ms, %u entries\n", pstates[i],
+			   snap.state_durations[i],
+			   snap.state_entry_counts[i]);
+	}
+	seq_printf(file, "sc8_count: %u\n", snap.sc8_count);
+	seq_printf(file, "updates: %llu\n", snap.update_count);
+
+	return 0;
+}
+
+static int aon_stats_snapshot_open(struct inode *inode, struct file *file)
+{
+	return single_open(file, aon_stats_snapshot_show, inode->i_private);
+}
+
+static const struct file_operations aon_stats_snapshot_fops = {
+	.open = aon_stats_snapshot_open,
+	.read = seq_read,
+	.llseek = seq_lseek,
+	.release = single_release
+};
+
+static int aon_stats_page_mmap(struct file *file, struct vm_area_struct *vma)
+{
+	if (!aon_stats_page_va)
+		return -ENODEV;
+	if (vma->vm_flags & VM_WRITE)
+		return -EPERM;
+
+	return dma_mmap_coherent(aondev, vma, aon_stats_page_va,
+				 aon_stats_page_dma, PAGE_SIZE);
+}
+
+static const struct file_operations aon_stats_page_fops = {
+	.open = simple_open,
+	.mmap = aon_stats_page_mmap,
+	.llseek = noop_llseek,
+};
+
 static struct aon_dbgfs_node aon_nodes[] = {
 	{.name = "target_power_state", .id = AON_PM_TARGET_POWER_STATE,
 			.pdr_id = AON_PM, .mode = S_IRUGO | S_IWUSR,
@@ -610,8 +733,15 @@ static struct aon_dbgfs_node aon_nodes[] = {
 	{.name = "sc8_count", .id = AON_PM_SC8_COUNT,
 			.pdr_id = AON_STATS, .mode = S_IRUGO,
 			.fops = &aon_pm_sc8_count_fops,},
+	{.name = "publication_period_ms", .id = AON_STATS_BUFFER,
+			.pdr_id = AON_STATS, .mode = S_IRUGO | S_IWUSR,
+			.fops = &aon_stats_period_fops,},
 	{.name = "completion_timeout", .pdr_id = AON_ROOT,
 			.mode = S_IRUGO | S_IWUSR, .fops = &aon_timeout_fops,},
+	{.name = "snapshot", .pdr_id = AON_STATS, .mode = S_IRUGO,
+			.fops = &aon_stats_snapshot_fops,},
+	{.name = "stats_page", .pdr_id = AON_STATS, .mode = S_IRUGO,
+			.fops = &aon_stats_page_fops,},
 };
 
 static void tegra_aondbg_recv_msg(struct mbox_client *cl, void *rx_msg)
@@ -735,6 +865,12 @@ static int tegra_aondbg_probe(struct platform_device *pdev)
 		init_completion(aon_nodes[i].wait_on);
 	}
 
+	aon_stats_page_va = dmam_alloc_coherent(dev, PAGE_SIZE,
+				&aon_stats_page_dma,
+				GFP_KERNEL | __GFP_ZERO);
+	if (!aon_stats_page_va)
+		dev_warn(dev, "no stats publication page, IVC queries only\n");
+
 	ret = aon_pm_dbg_init(aondbg);
 	if (ret) {
 		dev_err(dev, "failed to create debugfs nodes.\n");
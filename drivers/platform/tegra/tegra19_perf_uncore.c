@@ -28,14 +28,20 @@
 #include <linux/platform_device.h>
 #include <linux/bitops.h>
 #include <linux/errno.h>
+#include <linux/hrtimer.h>
 #include <linux/interrupt.h>
 #include <linux/kernel.h>
 #include <linux/irq.h>
+#include <linux/math64.h>
+#include <linux/mm.h>
+#include <linux/mutex.h>
+#include <linux/smp.h>
 #include <linux/sysfs.h>
 #include <linux/perf_event.h>
 #include <linux/platform_device.h>
 #include <linux/types.h>
 #include <linux/version.h>
+#include <uapi/linux/tegra-uncore-sampler.h>
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 14, 0)
 #include <linux/sched/clock.h>
 #else
@@ -128,6 +134,11 @@
 #define NV_INT_START				0x200
 #define NV_INT_END					0x208
 
+// In-kernel SCF sampling, see carmel_sampler_tick()
+#define SAMPLER_DEFAULT_HZ			100
+#define SAMPLER_MAX_HZ				1000
+#define SCF_LINE_BYTES				64
+
 
 static const u32 pmevcntr[] = { SYS_NV_PMEVCNTR0_EL0, SYS_NV_PMEVCNTR1_EL0 };
 static const u32 pmevtyper[] = { SYS_NV_PMEVTYPER0_EL0, SYS_NV_PMEVTYPER1_EL0 };
@@ -174,6 +185,18 @@ struct uncore_pmu {
 	struct list_head units;
 	DECLARE_BITMAP(used_units, NUM_L2S + 1);
 	struct uncore_unit *cur_unit;
+
+	// In-kernel SCF sampling state, see carmel_sampler_tick()
+	struct tegra_uncore_sampler_hdr *sampler_hdr;
+	struct hrtimer sampler_timer;
+	struct mutex sampler_lock;
+	u32 sampler_hz;
+	bool sampler_on;
+	u32 sampler_phase;
+	u64 sampler_prev_ns;
+	u64 last_rd_kbps;
+	u64 last_wr_kbps;
+	u32 last_hit_pct;
 };
 
 static inline struct uncore_pmu *to_uncore_pmu(struct pmu *pmu)
@@ -572,6 +595,273 @@ static irqreturn_t carmel_uncore_handle_irq(int irq_num, void *data)
 	return IRQ_HANDLED;
 }
 
+/*
+ * In-kernel sampling mode: an hrtimer pinned to CPU0 periodically latches
+ * the two SCF counters into a page shared with userspace through mmap and
+ * derives DRAM read/write bandwidth and the L3 hit rate in-kernel, so
+ * telemetry readers poll memory instead of paying a perf syscall pair per
+ * sample. The counter pair alternates between the two event sets below,
+ * giving each derived metric a fresh value every second tick.
+ *
+ * The sampler claims both SCF counters through scf.used_ctrs, so perf
+ * events targeting the SCF are refused while it runs (and vice versa);
+ * the L2 cluster units stay fully available to perf. All counter access
+ * happens on CPU0, like the rest of the driver.
+ */
+static const u32 sampler_phases[2][UNIT_CTRS] = {
+	{ L3D_CACHE_REFILL, L3D_CACHE_WB },	// DRAM read/write BW
+	{ L3D_CACHE, L3D_CACHE_REFILL },	// L3 hit rate
+};
+
+// runs on CPU0; reprogram the SCF counter pair and open a new window
+static void carmel_sampler_program(struct uncore_pmu *uncore_pmu)
+{
+	const u32 *events = sampler_phases[uncore_pmu->sampler_phase];
+	int i;
+
+	set_unit(uncore_pmu, &uncore_pmu->scf);
+
+	for (i = 0; i < UNIT_CTRS; i++) {
+		sys_counter_write(pmevtyper[i], events[i]);
+		sys_counter_write(pmevcntr[i], 0);
+	}
+	// free-running counters, no overflow interrupts
+	write_sysreg_s(BIT(0) | BIT(1), SYS_NV_PMINTENCLR_EL1);
+	write_sysreg_s(BIT(0) | BIT(1), SYS_NV_PMCNTENSET_EL0);
+	write_sysreg_s(CARMEL_PMCR_E, SYS_NV_PMCR_EL0);
+
+	uncore_pmu->sampler_prev_ns = sched_clock();
+}
+
+static enum hrtimer_restart carmel_sampler_tick(struct hrtimer *timer)
+{
+	struct uncore_pmu *uncore_pmu =
+		container_of(timer, struct uncore_pmu, sampler_timer);
+	struct tegra_uncore_sampler_hdr *hdr = uncore_pmu->sampler_hdr;
+	const u32 *events = sampler_phases[uncore_pmu->sampler_phase];
+	struct tegra_uncore_sample *sample;
+	u64 now = sched_clock();
+	u64 window = now - uncore_pmu->sampler_prev_ns;
+	u32 delta[UNIT_CTRS];
+	u32 idx;
+	int i;
+
+	set_unit(uncore_pmu, &uncore_pmu->scf);
+
+	// counters were cleared when the window opened, so reads are deltas
+	for (i = 0; i < UNIT_CTRS; i++)
+		delta[i] = sys_counter_read(pmevcntr[i]);
+
+	// CTR_INVAL means the unit powered down; drop this window
+	if (delta[0] == CTR_INVAL || delta[1] == CTR_INVAL || !window)
+		goto reprogram;
+
+	if (uncore_pmu->sampler_phase == 0) {
+		// each refill/write-back moves one L3 line to/from DRAM
+		uncore_pmu->last_rd_kbps = div64_u64(
+			(((u64)delta[0] * SCF_LINE_BYTES) >> 10) * NSEC_PER_SEC,
+			window);
+		uncore_pmu->last_wr_kbps = div64_u64(
+			(((u64)delta[1] * SCF_LINE_BYTES) >> 10) * NSEC_PER_SEC,
+			window);
+	} else if (delta[0]) {
+		u32 refills = min(delta[1], delta[0]);
+
+		uncore_pmu->last_hit_pct = ((delta[0] - refills) * 100ULL) /
+					   delta[0];
+	}
+
+	idx = (hdr->head + 1) & (TEGRA_UNCORE_SAMPLER_RING_SZ - 1);
+	sample = &hdr->samples[idx];
+
+	// odd seq marks the entry inconsistent while it is rewritten
+	WRITE_ONCE(sample->seq, sample->seq + 1);
+	smp_wmb();
+	sample->timestamp_ns = now;
+	sample->window_ns = window;
+	sample->dram_rd_kbps = uncore_pmu->last_rd_kbps;
+	sample->dram_wr_kbps = uncore_pmu->last_wr_kbps;
+	sample->l3_hit_pct = uncore_pmu->last_hit_pct;
+	for (i = 0; i < UNIT_CTRS; i++) {
+		sample->raw_ctr[i] = delta[i];
+		sample->raw_events[i] = events[i];
+	}
+	smp_wmb();
+	WRITE_ONCE(sample->seq, sample->seq + 1);
+	// publish the entry only after it is consistent
+	smp_wmb();
+	WRITE_ONCE(hdr->head, idx);
+
+reprogram:
+	uncore_pmu->sampler_phase ^= 1;
+	carmel_sampler_program(uncore_pmu);
+
+	hrtimer_forward_now(timer,
+			ns_to_ktime(NSEC_PER_SEC / uncore_pmu->sampler_hz));
+	return HRTIMER_RESTART;
+}
+
+struct sampler_ipi {
+	struct uncore_pmu *uncore_pmu;
+	int ret;
+};
+
+// runs on CPU0 with interrupts off, serialized against the perf callbacks
+static void carmel_sampler_start_cpu0(void *data)
+{
+	struct sampler_ipi *ipi = data;
+	struct uncore_pmu *uncore_pmu = ipi->uncore_pmu;
+	struct uncore_unit *scf = &uncore_pmu->scf;
+
+	if (!bitmap_empty(scf->used_ctrs, UNIT_CTRS)) {
+		// perf owns an SCF counter right now
+		ipi->ret = -EBUSY;
+		return;
+	}
+	bitmap_fill(scf->used_ctrs, UNIT_CTRS);
+
+	uncore_pmu->sampler_phase = 0;
+	carmel_sampler_program(uncore_pmu);
+
+	hrtimer_start(&uncore_pmu->sampler_timer,
+		      ns_to_ktime(NSEC_PER_SEC / uncore_pmu->sampler_hz),
+		      HRTIMER_MODE_REL);
+	ipi->ret = 0;
+}
+
+// runs on CPU0 with interrupts off
+static void carmel_sampler_stop_cpu0(void *data)
+{
+	struct uncore_pmu *uncore_pmu = data;
+	struct uncore_unit *scf = &uncore_pmu->scf;
+
+	set_unit(uncore_pmu, scf);
+	write_sysreg_s(BIT(0) | BIT(1), SYS_NV_PMCNTENCLR_EL0);
+	bitmap_zero(scf->used_ctrs, UNIT_CTRS);
+}
+
+static int carmel_sampler_set(struct uncore_pmu *uncore_pmu, bool on)
+{
+	struct sampler_ipi ipi = { .uncore_pmu = uncore_pmu, .ret = 0 };
+	int err = 0;
+
+	mutex_lock(&uncore_pmu->sampler_lock);
+	if (on == uncore_pmu->sampler_on)
+		goto out;
+
+	if (on) {
+		uncore_pmu->sampler_hdr->rate_hz = uncore_pmu->sampler_hz;
+		err = smp_call_function_single(0, carmel_sampler_start_cpu0,
+					       &ipi, true);
+		if (!err)
+			err = ipi.ret;
+		if (!err)
+			uncore_pmu->sampler_on = true;
+	} else {
+		uncore_pmu->sampler_on = false;
+		hrtimer_cancel(&uncore_pmu->sampler_timer);
+		smp_call_function_single(0, carmel_sampler_stop_cpu0,
+					 uncore_pmu, true);
+	}
+out:
+	mutex_unlock(&uncore_pmu->sampler_lock);
+	return err;
+}
+
+static ssize_t sampling_show(struct device *dev,
+			     struct device_attribute *attr, char *page)
+{
+	struct uncore_pmu *uncore_pmu = dev_get_drvdata(dev);
+
+	return sprintf(page, "%d\n", uncore_pmu->sampler_on);
+}
+
+static ssize_t sampling_store(struct device *dev,
+			      struct device_attribute *attr,
+			      const char *buf, size_t count)
+{
+	struct uncore_pmu *uncore_pmu = dev_get_drvdata(dev);
+	bool on;
+	int err;
+
+	if (kstrtobool(buf, &on))
+		return -EINVAL;
+
+	err = carmel_sampler_set(uncore_pmu, on);
+	return err ? err : count;
+}
+static DEVICE_ATTR_RW(sampling);
+
+static ssize_t sampling_rate_hz_show(struct device *dev,
+				     struct device_attribute *attr, char *page)
+{
+	struct uncore_pmu *uncore_pmu = dev_get_drvdata(dev);
+
+	return sprintf(page, "%u\n", uncore_pmu->sampler_hz);
+}
+
+static ssize_t sampling_rate_hz_store(struct device *dev,
+				      struct device_attribute *attr,
+				      const char *buf, size_t count)
+{
+	struct uncore_pmu *uncore_pmu = dev_get_drvdata(dev);
+	u32 hz;
+
+	if (kstrtou32(buf, 0, &hz) || !hz || hz > SAMPLER_MAX_HZ)
+		return -EINVAL;
+
+	// picked up by the running timer on its next expiry
+	mutex_lock(&uncore_pmu->sampler_lock);
+	uncore_pmu->sampler_hz = hz;
+	uncore_pmu->sampler_hdr->rate_hz = hz;
+	mutex_unlock(&uncore_pmu->sampler_lock);
+	return count;
+}
+static DEVICE_ATTR_RW(sampling_rate_hz);
+
+static int carmel_sampler_ring_mmap(struct file *filp, struct kobject *kobj,
+				    struct bin_attribute *attr,
+				    struct vm_area_struct *vma)
+{
+	struct uncore_pmu *uncore_pmu = dev_get_drvdata(kobj_to_dev(kobj));
+	unsigned long size = vma->vm_end - vma->vm_start;
+
+	if (size > PAGE_SIZE || vma->vm_pgoff != 0)
+		return -EINVAL;
+
+	// the sample ring is written only by the kernel
+	if (vma->vm_flags & VM_WRITE)
+		return -EPERM;
+	vma->vm_flags &= ~VM_MAYWRITE;
+
+	return remap_pfn_range(vma, vma->vm_start,
+			virt_to_phys(uncore_pmu->sampler_hdr) >> PAGE_SHIFT,
+			size, vma->vm_page_prot);
+}
+
+static struct bin_attribute sampler_ring_attr = {
+	.attr = { .name = "sample_ring", .mode = 0444 },
+	.size = PAGE_SIZE,
+	.mmap = carmel_sampler_ring_mmap,
+};
+
+static struct attribute *carmel_sampler_attrs[] = {
+	&dev_attr_sampling.attr,
+	&dev_attr_sampling_rate_hz.attr,
+	NULL,
+};
+
+static struct bin_attribute *carmel_sampler_bin_attrs[] = {
+	&sampler_ring_attr,
+	NULL,
+};
+
+static const struct attribute_group carmel_sampler_group = {
+	.name = "sampler",
+	.attrs = carmel_sampler_attrs,
+	.bin_attrs = carmel_sampler_bin_attrs,
+};
+
 static ssize_t carmel_uncore_event_sysfs_show(struct device *dev,
 											  struct device_attribute *attr, char *page)
 {
@@ -708,6 +998,28 @@ static int carmel_pmu_device_probe(struct platform_device *pdev)
 		return err;
 	}
 
+	// In-kernel sampling: page shared with userspace plus CPU0 timer
+	BUILD_BUG_ON(sizeof(struct tegra_uncore_sampler_hdr) > PAGE_SIZE);
+	uncore_pmu->sampler_hdr =
+		(struct tegra_uncore_sampler_hdr *)get_zeroed_page(GFP_KERNEL);
+	if (uncore_pmu->sampler_hdr) {
+		uncore_pmu->sampler_hdr->magic = TEGRA_UNCORE_SAMPLER_MAGIC;
+		uncore_pmu->sampler_hdr->version = TEGRA_UNCORE_SAMPLER_VERSION;
+		uncore_pmu->sampler_hdr->ring_size = TEGRA_UNCORE_SAMPLER_RING_SZ;
+		uncore_pmu->sampler_hdr->rate_hz = SAMPLER_DEFAULT_HZ;
+		uncore_pmu->sampler_hz = SAMPLER_DEFAULT_HZ;
+		mutex_init(&uncore_pmu->sampler_lock);
+		hrtimer_init(&uncore_pmu->sampler_timer, CLOCK_MONOTONIC,
+			     HRTIMER_MODE_REL);
+		uncore_pmu->sampler_timer.function = carmel_sampler_tick;
+
+		if (sysfs_create_group(&pdev->dev.kobj, &carmel_sampler_group)) {
+			dev_warn(&pdev->dev, "Failed to create sampler sysfs\n");
+			free_page((unsigned long)uncore_pmu->sampler_hdr);
+			uncore_pmu->sampler_hdr = NULL;
+		}
+	}
+
 	dev_info(&pdev->dev, "Registered Carmel PMU\n");
 
 	return 0;
@@ -26,6 +26,7 @@
 #include <linux/string.h>
 #include <linux/slab.h>
 #include <linux/memblock.h>
+#include <linux/mm.h>
 #include <asm/page.h>
 #include "tegra_bootloader_debug.h"
 
@@ -152,6 +153,118 @@ struct profiler_record {
 	uint64_t timestamp;
 } __packed;
 
+/* Boot timeline: the profiling records parsed once at init into a single
+ * page of fixed size (phase, start, duration) entries, so telemetry can
+ * pull the whole boot timeline with one read or mmap instead of scraping
+ * and parsing the raw carveout on every boot.
+ */
+#define TEGRA_BL_TIMELINE_MAGIC		0x544c4254	/* "TBLT" */
+#define TEGRA_BL_TIMELINE_VERSION	1
+
+struct timeline_header {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t nr_entries;
+	uint32_t reserved;
+} __packed;
+
+struct timeline_entry {
+	char name[MAX_PROFILE_STRLEN + 1];
+	uint64_t start;
+	uint64_t duration;
+} __packed;
+
+static unsigned long tegra_bl_timeline_page;
+
+static void tegra_bl_build_timeline(void)
+{
+	struct profiler_record *profiler_data;
+	struct timeline_header *header;
+	struct timeline_entry *entry;
+	unsigned int max_entries;
+	int count;
+	int i;
+
+	if (!tegra_bl_mapped_full_carveout)
+		return;
+
+	tegra_bl_timeline_page = get_zeroed_page(GFP_KERNEL);
+	if (!tegra_bl_timeline_page) {
+		pr_err("%s: failed to allocate timeline page\n", module_name);
+		return;
+	}
+
+	header = (struct timeline_header *)tegra_bl_timeline_page;
+	entry = (struct timeline_entry *)(header + 1);
+	max_entries = (PAGE_SIZE - sizeof(*header)) / sizeof(*entry);
+
+	profiler_data = (struct profiler_record *)tegra_bl_mapped_full_carveout;
+	count = SIZE_OF_FULL_CARVEOUT / sizeof(struct profiler_record);
+	for (i = 0; i < count && header->nr_entries < max_entries; i++) {
+		if (!profiler_data[i].timestamp)
+			continue;
+
+		strncpy(entry->name, profiler_data[i].str,
+			MAX_PROFILE_STRLEN);
+		entry->start = profiler_data[i].timestamp;
+		/* Duration runs to the next record of the same section;
+		 * section-final records keep duration zero.
+		 */
+		if (i + 1 < count && profiler_data[i + 1].timestamp)
+			entry->duration =
+				profiler_data[i + 1].timestamp - entry->start;
+		entry++;
+		header->nr_entries++;
+	}
+
+	/* Close the timeline with a kernel marker in the same microsecond
+	 * timebase, so time spent between the last bootloader phase and
+	 * kernel initcalls reaching this driver is accounted for too.
+	 */
+	if (usc && header->nr_entries < max_entries) {
+		strncpy(entry->name, "kernel_timeline_init",
+			MAX_PROFILE_STRLEN);
+		entry->start = readl(usc);
+		header->nr_entries++;
+	}
+
+	header->magic = TEGRA_BL_TIMELINE_MAGIC;
+	header->version = TEGRA_BL_TIMELINE_VERSION;
+}
+
+static ssize_t timeline_read(struct file *filp, struct kobject *kobj,
+			struct bin_attribute *attr, char *buf,
+			loff_t off, size_t count)
+{
+	if (!tegra_bl_timeline_page)
+		return -ENODEV;
+
+	return memory_read_from_buffer(buf, count, &off,
+			(void *)tegra_bl_timeline_page, PAGE_SIZE);
+}
+
+static int timeline_mmap(struct file *filp, struct kobject *kobj,
+			struct bin_attribute *attr,
+			struct vm_area_struct *vma)
+{
+	if (!tegra_bl_timeline_page)
+		return -ENODEV;
+
+	if (vma->vm_end - vma->vm_start > PAGE_SIZE)
+		return -EINVAL;
+
+	return remap_pfn_range(vma, vma->vm_start,
+			page_to_pfn(virt_to_page(tegra_bl_timeline_page)),
+			vma->vm_end - vma->vm_start, vma->vm_page_prot);
+}
+
+static const struct bin_attribute timeline_attribute = {
+	.attr = { .name = "timeline", .mode = 0400 },
+	.size = PAGE_SIZE,
+	.read = timeline_read,
+	.mmap = timeline_mmap,
+};
+
 static ssize_t profiler_show(struct kobject *kobj,
 			struct kobj_attribute *attr,
 			char *buf)
@@ -474,6 +587,17 @@ static int __init tegra_bootloader_debuginit(void)
 
 	spin_lock_init(&tegra_bl_lock);
 
+	tegra_bl_build_timeline();
+	if (tegra_bl_timeline_page) {
+		bl_debug_verify_file_entry = sysfs_create_bin_file(
+				boot_profiler_kobj, &timeline_attribute);
+		if (bl_debug_verify_file_entry) {
+			pr_err("%s: failed to create sysfs file : %d\n",
+				module_name, bl_debug_verify_file_entry);
+			goto out_err;
+		}
+	}
+
 	return 0;
 
 out_err:
@@ -488,6 +612,11 @@ out_err:
 	if (ptr_bl_full_carveout)
 		iounmap(ptr_bl_full_carveout);
 
+	if (tegra_bl_timeline_page) {
+		free_page(tegra_bl_timeline_page);
+		tegra_bl_timeline_page = 0;
+	}
+
 	if (boot_profiler_kobj) {
 		sysfs_remove_file(boot_profiler_kobj,
 			&profiler_attribute.attr);
@@ -568,6 +697,9 @@ static void __exit tegra_bl_debuginit_module_exit(void)
 		iounmap(tegra_bl_mapped_full_carveout);
 
 	if (boot_profiler_kobj) {
+		if (tegra_bl_timeline_page)
+			sysfs_remove_bin_file(boot_profiler_kobj,
+				&timeline_attribute);
 		sysfs_remove_file(boot_profiler_kobj,
 			&profiler_attribute.attr);
 		sysfs_remove_file(boot_profiler_kobj,
@@ -576,6 +708,11 @@ static void __exit tegra_bl_debuginit_module_exit(void)
 		boot_profiler_kobj = NULL;
 	}
 
+	if (tegra_bl_timeline_page) {
+		free_page(tegra_bl_timeline_page);
+		tegra_bl_timeline_page = 0;
+	}
+
 	if (usc)
 		iounmap(usc);
 }
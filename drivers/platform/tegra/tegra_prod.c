@@ -41,10 +41,24 @@ struct prod_tuple {
 	u32 val;   /* value */
 };
 
+/* prod_op: Compiled form of a prod tuple for the apply fast path.
+ * @clr: complement of the tuple mask; zero means the whole register is
+ *	 written and the read-modify-write read can be skipped.
+ * @val: tuple value pre-masked with the tuple mask.
+ */
+struct prod_op {
+	u32 index; /* Address base index */
+	u32 addr;  /* offset address*/
+	u32 clr;
+	u32 val;
+};
+
 struct tegra_prod_config {
 	const char *name;
 	struct prod_tuple *prod_tuple;
+	struct prod_op *prod_op;
 	int count; /* number of prod_tuple*/
+	int n_ops; /* number of compiled prod_op*/
 	bool boot_init;
 };
 
@@ -201,6 +215,63 @@ static void tegra_prod_optimise_tupple(struct prod_tuple *p_tuple,
 	}
 }
 
+/**
+ * tegra_prod_compile - Flatten the prod tuples for fast application.
+ * @dev:	Device handle for the allocation.
+ * @t_prod:	Prod configuration whose tuples are compiled.
+ *
+ * Build a contiguous array of pre-masked register operations from the
+ * parsed tuples so that applying the prod does no per-tuple mask
+ * arithmetic. Consecutive tuples updating the same register are merged
+ * into a single operation, and full-mask operations are flagged so the
+ * apply loop writes them without the read-modify-write read.
+ *
+ * Returns 0 on success, -ENOMEM if the op array can not be allocated.
+ */
+static int tegra_prod_compile(struct device *dev,
+			      struct tegra_prod_config *t_prod)
+{
+	struct prod_tuple *p_tuple;
+	struct prod_op *op;
+	int n_ops = 0;
+	int i;
+
+	t_prod->prod_op = devm_kcalloc(dev, t_prod->count,
+				       sizeof(*t_prod->prod_op), GFP_KERNEL);
+	if (!t_prod->prod_op)
+		return -ENOMEM;
+
+	for (i = 0; i < t_prod->count; i++) {
+		p_tuple = &t_prod->prod_tuple[i];
+
+		if (n_ops) {
+			op = &t_prod->prod_op[n_ops - 1];
+			if ((op->index == p_tuple->index) &&
+			    (op->addr == p_tuple->addr)) {
+				/* Applying the new tuple on top of the
+				 * merged one keeps the register result
+				 * identical to two sequential writes.
+				 */
+				op->clr &= ~p_tuple->mask;
+				op->val = (op->val & ~p_tuple->mask) |
+					  (p_tuple->val & p_tuple->mask);
+				continue;
+			}
+		}
+
+		op = &t_prod->prod_op[n_ops];
+		op->index = p_tuple->index;
+		op->addr = p_tuple->addr;
+		op->clr = ~p_tuple->mask;
+		op->val = p_tuple->val & p_tuple->mask;
+		n_ops++;
+	}
+
+	t_prod->n_ops = n_ops;
+
+	return 0;
+}
+
 /**
  * tegra_prod_parse_dt - Read the prod setting form Device tree.
  * @np:			device node from which the property value is to be read.
@@ -291,6 +362,9 @@ static int tegra_prod_parse_dt(struct device *dev,
 			tegra_prod_optimise_tupple(t_prod->prod_tuple,
 						   t_prod->count);
 
+		ret = tegra_prod_compile(dev, t_prod);
+		if (ret < 0)
+			return ret;
 
 		n_child++;
 	}
@@ -331,18 +405,33 @@ static int tegra_prod_set_tuple(void __iomem **base,
  * @base:		base address of the register.
  * @tegra_prod:		the prod setting to set.
  *
- * Set all the tuples in one tegra_prod.
+ * Set all the tuples in one tegra_prod. Uses the compiled op array when
+ * available so the apply loop is a straight sequence of register writes.
  * Returns 0 on success.
  */
 static int tegra_prod_set(void __iomem **base,
 			  struct tegra_prod_config *tegra_prod)
 {
+	struct prod_op *op;
+	void __iomem *reg;
 	int i;
 	int ret;
 
 	if (!tegra_prod)
 		return -EINVAL;
 
+	if (tegra_prod->prod_op) {
+		op = tegra_prod->prod_op;
+		for (i = 0; i < tegra_prod->n_ops; i++, op++) {
+			reg = base[op->index] + op->addr;
+			if (op->clr)
+				writel((readl(reg) & op->clr) | op->val, reg);
+			else
+				writel(op->val, reg);
+		}
+		return 0;
+	}
+
 	for (i = 0; i < tegra_prod->count; i++) {
 		ret = tegra_prod_set_tuple(base, &tegra_prod->prod_tuple[i], 0);
 		if (ret)
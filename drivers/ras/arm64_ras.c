@@ -108,13 +108,14 @@ void ras_write_error_status(u64 status)
 EXPORT_SYMBOL(ras_write_error_status);
 
 /* Read ERR<X>ADDR */
-static u64 ras_read_error_address(void)
+u64 ras_read_error_address(void)
 {
 	u64 addr;
 
 	asm volatile("mrs %0, s3_0_c5_c4_3" : "=r" (addr));
 	return addr;
 }
+EXPORT_SYMBOL(ras_read_error_address);
 
 /* Write to ERR<X>ADDR*/
 void ras_write_error_addr(u64 addr)
@@ -124,13 +125,14 @@ void ras_write_error_addr(u64 addr)
 EXPORT_SYMBOL(ras_write_error_addr);
 
 /* Read ERR<X>MISC0 */
-static u64 ras_read_error_misc0(void)
+u64 ras_read_error_misc0(void)
 {
 	u64 misc0;
 
 	asm volatile("mrs %0, s3_0_c5_c5_0" : "=r" (misc0));
 	return misc0;
 }
+EXPORT_SYMBOL(ras_read_error_misc0);
 
 /* Write to ERR<X>MISC0*/
 void ras_write_error_misc0(u64 misc0)
@@ -140,13 +142,14 @@ void ras_write_error_misc0(u64 misc0)
 EXPORT_SYMBOL(ras_write_error_misc0);
 
 /* Read ERR<X>MISC1 */
-static u64 ras_read_error_misc1(void)
+u64 ras_read_error_misc1(void)
 {
 	u64 misc1;
 
 	asm volatile("mrs %0, s3_0_c5_c5_1" : "=r" (misc1));
 	return misc1;
 }
+EXPORT_SYMBOL(ras_read_error_misc1);
 
 /* Write to ERR<X>MISC1*/
 void ras_write_error_misc1(u64 misc1)
@@ -79,6 +79,7 @@ struct tegra_fuse_hw_feature {
 	bool hw_mutex_support;
 	bool has_power_switch;
 	int pgm_time;
+	u32 macro_words;
 	struct fuse_burn_data burn_data[TEGRA_FUSE_BURN_MAX_FUSES];
 };
 
@@ -91,6 +92,9 @@ struct tegra_fuse_burn_dev {
 	s32 min_temp;
 	s32 max_temp;
 	u32 thermal_zone;
+	u32 *shadow;
+	bool shadow_valid;
+	struct bin_attribute shadow_attr;
 };
 
 static DEFINE_MUTEX(fuse_lock);
@@ -343,6 +347,42 @@ static void tegra_fuse_set_pd(bool pd)
 	}
 }
 
+/* Refill the cached copy of the fuse macro. Caller must hold fuse_lock. */
+static void tegra_fuse_shadow_refresh(struct tegra_fuse_burn_dev *fuse_dev)
+{
+	u32 i;
+
+	if (!fuse_dev->shadow)
+		return;
+
+	if (fuse_dev->hw->power_down_mode)
+		tegra_fuse_set_pd(false);
+
+	for (i = 0; i < fuse_dev->hw->macro_words; i++)
+		fuse_dev->shadow[i] = fuse_cmd_read(i);
+
+	if (fuse_dev->hw->power_down_mode)
+		tegra_fuse_set_pd(true);
+
+	fuse_dev->shadow_valid = true;
+}
+
+/*
+ * Read one fuse macro word, from the cached shadow when possible so
+ * repeated queries do not hit the clock-gated macro. Caller must hold
+ * fuse_lock.
+ */
+static u32 tegra_fuse_macro_read(struct tegra_fuse_burn_dev *fuse_dev, u32 addr)
+{
+	if (fuse_dev->shadow && addr < fuse_dev->hw->macro_words) {
+		if (!fuse_dev->shadow_valid)
+			tegra_fuse_shadow_refresh(fuse_dev);
+		return fuse_dev->shadow[addr];
+	}
+
+	return fuse_cmd_read(addr);
+}
+
 static int tegra_fuse_pre_burn_process(struct tegra_fuse_burn_dev *fuse_dev)
 {
 	u32 off_0_val, off_1_val, reg;
@@ -462,6 +502,9 @@ static int tegra_fuse_burn_fuse(struct tegra_fuse_burn_dev *fuse_dev,
 
 	tegra_fuse_post_burn_process(fuse_dev);
 
+	/* burned values change the macro contents, re-read on next query */
+	fuse_dev->shadow_valid = false;
+
 	return 0;
 }
 
@@ -478,13 +521,13 @@ static void tegra_fuse_get_fuse(struct tegra_fuse_burn_dev *fuse_dev,
 	u32 actual_val, redun_val = 0;
 
 	/* Disable power down mode */
-	if (fuse_dev->hw->power_down_mode)
+	if (fuse_dev->hw->power_down_mode && !fuse_dev->shadow)
 		tegra_fuse_set_pd(false);
 
 	do {
-		actual_val = fuse_cmd_read(offset);
+		actual_val = tegra_fuse_macro_read(fuse_dev, offset);
 		if (is_redundant)
-			redun_val = fuse_cmd_read(offset + 1);
+			redun_val = tegra_fuse_macro_read(fuse_dev, offset + 1);
 		loops = min(nbits, 32 - start_bit);
 		for (i = 0; i < loops; i++) {
 			if (actual_val & (BIT(start_bit + i)))
@@ -509,7 +552,7 @@ static void tegra_fuse_get_fuse(struct tegra_fuse_burn_dev *fuse_dev,
 	} while (nbits > 0);
 
 	/* Enable power down mode */
-	if (fuse_dev->hw->power_down_mode)
+	if (fuse_dev->hw->power_down_mode && !fuse_dev->shadow)
 		tegra_fuse_set_pd(true);
 }
 
@@ -629,6 +672,9 @@ static ssize_t tegra_fuse_calc_h2_code(struct device *dev,
 	struct device_attribute *attr,
 	char *buf)
 {
+	struct platform_device *pdev = container_of(dev,
+			struct platform_device, dev);
+	struct tegra_fuse_burn_dev *fuse_dev = platform_get_drvdata(pdev);
 	u32 startrowindex, startbitindex;
 	u32 endrowindex, endbitindex;
 	u32 bitindex;
@@ -646,7 +692,7 @@ static ssize_t tegra_fuse_calc_h2_code(struct device *dev,
 
 	mutex_lock(&fuse_lock);
 	for (rowindex = startrowindex; rowindex <= endrowindex; rowindex++) {
-		rowdata = fuse_cmd_read(rowindex);
+		rowdata = tegra_fuse_macro_read(fuse_dev, rowindex);
 		for (bitindex = 0; bitindex < 32; bitindex++) {
 			pattern++;
 			if ((rowindex == startrowindex) &&
@@ -792,6 +838,21 @@ static ssize_t tegra_fuse_read_ecid(struct device *dev,
 }
 #endif
 
+static ssize_t tegra_fuse_shadow_read(struct file *filp, struct kobject *kobj,
+		struct bin_attribute *attr, char *buf, loff_t off, size_t count)
+{
+	struct device *dev = kobj_to_dev(kobj);
+	struct tegra_fuse_burn_dev *fuse_dev = dev_get_drvdata(dev);
+
+	mutex_lock(&fuse_lock);
+	if (!fuse_dev->shadow_valid)
+		tegra_fuse_shadow_refresh(fuse_dev);
+	memcpy(buf, (u8 *)fuse_dev->shadow + off, count);
+	mutex_unlock(&fuse_lock);
+
+	return count;
+}
+
 static ssize_t tegra_fuse_read_opt_tpc_disable(struct device *dev,
 			struct device_attribute *attr, char *buf)
 {
@@ -839,6 +900,7 @@ static struct tegra_fuse_hw_feature tegra210_fuse_chip_data = {
 	.hw_mutex_support = false,
 	.has_power_switch = true,
 	.pgm_time = 5,
+	.macro_words = 192,
 	.burn_data = {
 		FUSE_BURN_DATA(reserved_odm0, 0x2e, 17, 32, 0xc8, true, false),
 		FUSE_BURN_DATA(reserved_odm1, 0x30, 17, 32, 0xcc, true, false),
@@ -872,6 +934,7 @@ static struct tegra_fuse_hw_feature tegra186_fuse_chip_data = {
 	.hw_mutex_support = false,
 	.has_power_switch = true,
 	.pgm_time = 5,
+	.macro_words = 192,
 	.burn_data = {
 		FUSE_BURN_DATA(reserved_odm0, 0x2, 2, 32, 0xc8, true, false),
 		FUSE_BURN_DATA(reserved_odm1, 0x4, 2, 32, 0xcc, true, false),
@@ -908,6 +971,7 @@ static struct tegra_fuse_hw_feature tegra210b01_fuse_chip_data = {
 	.hw_mutex_support = false,
 	.has_power_switch = true,
 	.pgm_time = 5,
+	.macro_words = 192,
 	.burn_data = {
 		FUSE_BURN_DATA(reserved_odm0, 0x62, 27, 32, 0xc8, true, false),
 		FUSE_BURN_DATA(reserved_odm1, 0x64, 27, 32, 0xcc, true, false),
@@ -942,6 +1006,7 @@ static struct tegra_fuse_hw_feature tegra194_fuse_chip_data = {
 	.hw_mutex_support = false,
 	.has_power_switch = true,
 	.pgm_time = 5,
+	.macro_words = 256,
 	.burn_data = {
 		FUSE_BURN_DATA(reserved_odm0, 0x2, 2, 32, 0xc8, true, false),
 		FUSE_BURN_DATA(reserved_odm1, 0x4, 2, 32, 0xcc, true, false),
@@ -990,6 +1055,7 @@ static struct tegra_fuse_hw_feature tegra234_fuse_chip_data = {
 	.hw_mutex_support = true,
 	.has_power_switch = true,
 	.pgm_time = 5,
+	.macro_words = 256,
 	.burn_data = {
 		FUSE_BURN_DATA(reserved_odm0, 0x2, 2, 32, 0xc8, true, false),
 		FUSE_BURN_DATA(reserved_odm1, 0x4, 2, 32, 0xcc, true, false),
@@ -1136,6 +1202,33 @@ static int tegra_fuse_burn_probe(struct platform_device *pdev)
 			tegra_fuse_parse_dt(fuse_dev, np);
 	}
 
+	if (fuse_dev->hw->macro_words) {
+		fuse_dev->shadow = devm_kcalloc(&pdev->dev,
+						fuse_dev->hw->macro_words,
+						sizeof(*fuse_dev->shadow),
+						GFP_KERNEL);
+		if (!fuse_dev->shadow)
+			return -ENOMEM;
+
+		sysfs_bin_attr_init(&fuse_dev->shadow_attr);
+		fuse_dev->shadow_attr.attr.name = "fuse_shadow";
+		fuse_dev->shadow_attr.attr.mode = FPERM_R;
+		fuse_dev->shadow_attr.size = fuse_dev->hw->macro_words *
+						sizeof(u32);
+		fuse_dev->shadow_attr.read = tegra_fuse_shadow_read;
+		ret = sysfs_create_bin_file(&pdev->dev.kobj,
+					    &fuse_dev->shadow_attr);
+		if (ret) {
+			dev_err(&pdev->dev, "sysfs bin create failed %d\n",
+				ret);
+			return ret;
+		}
+
+		mutex_lock(&fuse_lock);
+		tegra_fuse_shadow_refresh(fuse_dev);
+		mutex_unlock(&fuse_lock);
+	}
+
 	dev_info(&pdev->dev, "Fuse burn driver initialized\n");
 	return 0;
 }
@@ -38,6 +38,7 @@ enum aon_spi_request_type {
 	AON_SPI_REQUEST_TYPE_XFER = 3,
 	AON_SPI_REQUEST_TYPE_SUSPEND = 4,
 	AON_SPI_REQUEST_TYPE_RESUME = 5,
+	AON_SPI_REQUEST_TYPE_XFER_BATCH = 6,
 };
 
 /*
@@ -117,6 +118,17 @@ struct aon_spi_xfer_params {
 	u8 rx_nbits;
 };
 
+/* Max number of transfers that a single batched xfer request can carry. */
+#define AON_SPI_MAX_BATCH_XFERS 16
+
+/* Data area left for a batched request once the params array is
+ * accounted for, so that the batched request stays within the same
+ * message size as a plain xfer request.
+ */
+#define AON_SPI_BATCH_DATA_SIZE \
+	(AON_SPI_MAX_DATA_SIZE - \
+	 (AON_SPI_MAX_BATCH_XFERS * sizeof(struct aon_spi_xfer_params)))
+
 /* This struct indicates the contents of the xfer request from CCPLEX to SPE
  * for the AON SPI controller.
  *
@@ -133,6 +145,25 @@ struct aon_spi_xfer_request {
 	u8 data[AON_SPI_MAX_DATA_SIZE];
 };
 
+/* This struct indicates the contents of a batched xfer request from CCPLEX
+ * to SPE. The SPE executes the transfers back-to-back in array order and
+ * sends one response for the whole batch.
+ *
+ * Fields:
+ * num_xfers:	Number of valid entries in the xfers array.
+ * xfers:	Parameters for each transfer. The tx/rx buf offsets index
+ *		into the data field and must be aligned for DMA transfer.
+ * data:	Buffer that holds the data for all transfers of the batch.
+ */
+struct aon_spi_xfer_batch_request {
+	union {
+		u32 num_xfers;
+		u8 align_t[TEGRA_IVC_ALIGN - sizeof(u32)];
+	};
+	struct aon_spi_xfer_params xfers[AON_SPI_MAX_BATCH_XFERS];
+	u8 data[AON_SPI_BATCH_DATA_SIZE];
+};
+
 /* This structure indicates the contents of the response from the remote CPU
  * i.e SPE for the previously requested transaction via CCPLEX proxy driver.
  *
@@ -148,6 +179,22 @@ struct aon_spi_xfer_response {
 	u8 data[AON_SPI_MAX_DATA_SIZE];
 };
 
+/* This structure indicates the response for a batched xfer request from SPE
+ * to CCPLEX. Execution stops at the first failing transfer.
+ *
+ * Fields:
+ * num_xfers:	Number of transfers that completed successfully.
+ * data:	Matches the data field of the batched request; rx data is
+ *		stored at the rx buf offsets given in the request params.
+ */
+struct aon_spi_xfer_batch_response {
+	union {
+		u32 num_xfers;
+		u8 align_t[TEGRA_IVC_ALIGN - sizeof(u32)];
+	};
+	u8 data[AON_SPI_BATCH_DATA_SIZE];
+};
+
 /* This structure indicates the current SPI request from CCPLEX to SPE for the
  * AON SPI controller.
  *
@@ -161,6 +208,7 @@ struct aon_spi_request {
 	union {
 		struct aon_spi_setup_request setup;
 		struct aon_spi_xfer_request xfer;
+		struct aon_spi_xfer_batch_request batch;
 	} data;
 };
 
@@ -175,6 +223,7 @@ struct aon_spi_response {
 	u32 status;
 	union {
 		struct aon_spi_xfer_response xfer;
+		struct aon_spi_xfer_batch_response batch;
 	} data;
 };
 
@@ -236,11 +236,96 @@ static int do_aon_ivc_spi_xfer(struct spi_device *spi,
 	return 0;
 }
 
+static int do_aon_ivc_spi_xfer_batch(struct spi_device *spi,
+					struct spi_message *msg,
+					struct tegra_spi_data *tspi,
+					unsigned int num_xfers)
+{
+	struct aon_spi_request *req = tspi->spi_req;
+	struct aon_spi_response *resp = tspi->spi_resp;
+	struct aon_spi_xfer_batch_request *batch = &req->data.batch;
+	struct aon_spi_xfer_params *params;
+	struct spi_transfer *xfer;
+	unsigned int i = 0, done;
+	u32 offset = 0;
+	int length, status;
+
+	req->req_type = AON_SPI_REQUEST_TYPE_XFER_BATCH;
+	batch->num_xfers = num_xfers;
+
+	list_for_each_entry(xfer, &msg->transfers, transfer_list) {
+		params = &batch->xfers[i];
+
+		params->flags = AON_SPI_XFER_HANDLE_CACHE;
+		if (i == 0)
+			params->flags |= AON_SPI_XFER_FIRST_MSG;
+		if (list_is_last(&xfer->transfer_list, &msg->transfers))
+			params->flags |= AON_SPI_XFER_LAST_MSG;
+		if (xfer->tx_buf)
+			params->flags |= AON_SPI_XFER_FLAG_WRITE;
+		if (xfer->rx_buf)
+			params->flags |= AON_SPI_XFER_FLAG_READ;
+
+		params->length = xfer->len;
+		params->tx_buf_offset = offset;
+		params->rx_buf_offset = offset;
+		params->chip_select = spi->chip_select;
+		params->tx_nbits = xfer->tx_nbits;
+		params->rx_nbits = xfer->rx_nbits;
+		params->bits_per_word = xfer->bits_per_word;
+		params->mode = spi->mode;
+		params->spi_clk_rate = xfer->speed_hz;
+
+		if (xfer->tx_buf) {
+			memcpy(batch->data + offset, xfer->tx_buf, xfer->len);
+			tegra_spi_dump_buf(batch->data + offset, xfer->len,
+					   "reqdata");
+		}
+		/* keep each buffer cache line aligned for DMA */
+		offset += round_up(xfer->len, TEGRA_IVC_ALIGN);
+		i++;
+	}
+
+	length = sizeof(req->req_type) +
+		 offsetof(struct aon_spi_xfer_batch_request, data) + offset;
+	status = ivc_aon_spi_send_req(tspi, length);
+	if (status) {
+		dev_err(tspi->dev, "Error in batched transfer\n");
+		return -EIO;
+	}
+
+	/* the SPE stops at the first failing transfer */
+	done = resp->data.batch.num_xfers;
+	i = 0;
+	list_for_each_entry(xfer, &msg->transfers, transfer_list) {
+		if (i >= done)
+			break;
+		params = &batch->xfers[i];
+		if (xfer->rx_buf) {
+			memcpy(xfer->rx_buf,
+			       resp->data.batch.data + params->rx_buf_offset,
+			       xfer->len);
+			tegra_spi_dump_buf(xfer->rx_buf, xfer->len, "rxdata");
+		}
+		msg->actual_length += xfer->len;
+		i++;
+	}
+	if (done != num_xfers) {
+		dev_err(tspi->dev, "batch completed %u of %u transfers\n",
+			done, num_xfers);
+		return -EIO;
+	}
+
+	return 0;
+}
+
 static int tegra_spi_transfer_one_message(struct spi_master *master,
 			struct spi_message *msg)
 {
 	struct tegra_spi_data *tspi = spi_master_get_devdata(master);
 	struct spi_transfer *xfer;
+	unsigned int num_xfers = 0;
+	u32 data_len = 0;
 	int ret = -1;
 	int count = 0;
 	u16 flags = 0;
@@ -248,6 +333,23 @@ static int tegra_spi_transfer_one_message(struct spi_master *master,
 	msg->status = 0;
 	msg->actual_length = 0;
 
+	/* Multiple transfers are sent to the SPE as a single batched
+	 * request when they fit in one message, so the whole spi_message
+	 * costs one IVC round trip instead of one per transfer.
+	 */
+	list_for_each_entry(xfer, &msg->transfers, transfer_list) {
+		num_xfers++;
+		data_len += round_up(xfer->len, TEGRA_IVC_ALIGN);
+	}
+	if (num_xfers > 1 && num_xfers <= AON_SPI_MAX_BATCH_XFERS &&
+	    data_len <= AON_SPI_BATCH_DATA_SIZE) {
+		ret = do_aon_ivc_spi_xfer_batch(msg->spi, msg, tspi,
+						num_xfers);
+		msg->status = ret;
+		spi_finalize_current_message(master);
+		return ret;
+	}
+
 	list_for_each_entry(xfer, &msg->transfers, transfer_list) {
 		flags |= AON_SPI_XFER_HANDLE_CACHE;
 		if (count == 0)
@@ -41,9 +41,10 @@
 
 /*
  * Currently assumed that only one buffer is sent using these APIs
- * per operation apart from header
+ * per operation apart from header, and up to TE_MAX_BATCH_OPERS
+ * operations are in flight on the channel at a time.
  */
-#define MAX_TIPC_MSG_NUM (1 + 1)
+#define MAX_TIPC_MSG_NUM (2 * TE_MAX_BATCH_OPERS)
 
 struct tipc_chan_ctx {
 	struct tipc_chan *chan;
@@ -56,6 +57,13 @@ struct tipc_chan_ctx {
 	size_t len[MAX_TIPC_MSG_NUM];
 	int cur_msg;
 	int total_msg;
+	/*
+	 * Payload staging buffer registered to the session: allocated on
+	 * first use, grown to the largest marshalled size seen and reused
+	 * for every operation so steady-state calls do not allocate.
+	 */
+	uint8_t *payload_buf;
+	size_t payload_buf_size;
 };
 
 enum tipc_chan_state {
@@ -153,8 +161,11 @@ static void _handle_event(void *data, int event)
 
 static void _handle_release(void *data)
 {
+	struct tipc_chan_ctx *chan_ctx = data;
+
 	trusty_ote_debug("%s\n", __func__);
-	kfree(data);
+	kfree(chan_ctx->payload_buf);
+	kfree(chan_ctx);
 }
 
 struct tipc_chan_ops chan_ops = {
@@ -228,83 +239,131 @@ static int construct_default_payload_header(payload_header_t *payload_header) {
 }
 
 /*
- * Constructs OTE message and sent it to TA over TIPC channel.
- * And then wait till response is received from TA.
+ * Returns the session payload buffer, growing it if the marshalled
+ * operations do not fit. The buffer is kept until the channel is
+ * released, so repeated operations of similar size never reallocate.
  */
-static int handle_ote_msg(struct tipc_chan_ctx *chan_ctx, void *buf,
-		size_t len, uint32_t cmd, te_error_t *op_status)
+static void *get_payload_buf(struct tipc_chan_ctx *chan_ctx, size_t size)
+{
+	uint8_t *buf;
+
+	if (size <= chan_ctx->payload_buf_size)
+		return chan_ctx->payload_buf;
+
+	buf = kzalloc(size, GFP_KERNEL);
+	if (NULL == buf)
+		return NULL;
+
+	kfree(chan_ctx->payload_buf);
+	chan_ctx->payload_buf = buf;
+	chan_ctx->payload_buf_size = size;
+
+	return buf;
+}
+
+/*
+ * Constructs the OTE messages for a group of independent operations and
+ * sends them to the TA over the TIPC channel back to back. Only then
+ * waits till the responses to all of them are received from the TA. The
+ * channel delivers replies in command order, so the reply to operation i
+ * is matched by position. Queueing the whole group before sleeping means
+ * a burst of operations costs one wakeup instead of one per operation.
+ */
+static int handle_ote_msgs(struct tipc_chan_ctx *chan_ctx,
+		struct te_oper *opers, uint32_t num_opers)
 {
 	int ret = 0;
-	stream_header_t stream_header;
+	int msg;
+	uint32_t i;
+	stream_header_t stream_headers[TE_MAX_BATCH_OPERS];
 	payload_header_t payload_header;
 	uint8_t *payload_buffer = NULL;
+	size_t total_len = 0;
+	size_t offset;
 
-	if (NULL == chan_ctx) {
+	if (NULL == chan_ctx || NULL == opers) {
 		return -EINVAL;
 	}
 
-	if (len > TIPC_MAX_CHUNK_SIZE) {
-		pr_err("%s: passing buffers of size > %u not supported. len(%zu)"
-			, __func__, TIPC_MAX_CHUNK_SIZE, len);
+	if (num_opers == 0 || num_opers > TE_MAX_BATCH_OPERS) {
+		pr_err("%s: invalid number of operations %u\n",
+				__func__, num_opers);
 		return -EINVAL;
 	}
 
-	ret = construct_default_stream_header(&stream_header);
-	if (ret < 0) {
-		return ret;
+	for (i = 0; i < num_opers; i++) {
+		if (opers[i].buf_len > TIPC_MAX_CHUNK_SIZE) {
+			pr_err("%s: passing buffers of size > %u not supported. len(%zu)"
+				, __func__, TIPC_MAX_CHUNK_SIZE, opers[i].buf_len);
+			return -EINVAL;
+		}
+		if (NULL != opers[i].buf)
+			total_len += PAYLOAD_META_HEADER_LEN + opers[i].buf_len;
 	}
 
-	stream_header.command = cmd;
-
-	trusty_ote_debug("%s: buf %p len %zu\n", __func__, buf, len);
+	if (total_len) {
+		payload_buffer = get_payload_buf(chan_ctx, total_len);
+		if (NULL == payload_buffer) {
+			ret = -ENOMEM;
+			return ret;
+		}
+	}
 
-	if (NULL != buf) {
-		stream_header.num_entries = 1;
-		stream_header.total_length = PAYLOAD_META_HEADER_LEN + len;
+	chan_ctx->cur_msg = 0;
+	chan_ctx->total_msg = 0;
+	offset = 0;
 
-		ret = construct_default_payload_header(&payload_header);
+	for (i = 0; i < num_opers; i++) {
+		ret = construct_default_stream_header(&stream_headers[i]);
 		if (ret < 0) {
 			return ret;
 		}
 
-		payload_header.type = TE_PARAM_TYPE_MEM_RW;
-		payload_header.length = len;
+		stream_headers[i].command = opers[i].ta_cmd;
 
-		payload_buffer = kzalloc((len + PAYLOAD_META_HEADER_LEN), GFP_KERNEL);
-		if (NULL == payload_buffer) {
-			ret = -ENOMEM;
-			return ret;
-		}
+		trusty_ote_debug("%s: buf %p len %zu\n", __func__,
+				opers[i].buf, opers[i].buf_len);
 
-		memcpy(payload_buffer, &payload_header, PAYLOAD_META_HEADER_LEN);
-		memcpy(&payload_buffer[PAYLOAD_META_HEADER_LEN], buf, len);
-	}
+		msg = chan_ctx->total_msg++;
+		chan_ctx->data[msg] = &stream_headers[i];
+		chan_ctx->len[msg] = STREAM_META_HEADER_LEN;
 
-	chan_ctx->cur_msg = 0;
-	chan_ctx->total_msg = 1;
-	chan_ctx->data[0] = &stream_header;
-	chan_ctx->len[0] = STREAM_META_HEADER_LEN;
-	if (NULL != buf) {
-		chan_ctx->data[1] = payload_buffer;
-		chan_ctx->len[1] = len + PAYLOAD_META_HEADER_LEN;
-		chan_ctx->total_msg++;
-	}
+		if (NULL != opers[i].buf) {
+			stream_headers[i].num_entries = 1;
+			stream_headers[i].total_length =
+				PAYLOAD_META_HEADER_LEN + opers[i].buf_len;
 
-	/* queue stream header */
-	trusty_ote_debug("%s: queue ote header\n", __func__);
-	ret = queue_msg(chan_ctx, chan_ctx->data[0], chan_ctx->len[0]);
-	if (ret) {
-		pr_err("%s:error(%d) in queue header\n", __func__, ret);
-		goto err_exit;
+			ret = construct_default_payload_header(&payload_header);
+			if (ret < 0) {
+				return ret;
+			}
+
+			payload_header.type = TE_PARAM_TYPE_MEM_RW;
+			payload_header.length = opers[i].buf_len;
+
+			memcpy(&payload_buffer[offset], &payload_header,
+					PAYLOAD_META_HEADER_LEN);
+			memcpy(&payload_buffer[offset + PAYLOAD_META_HEADER_LEN],
+					opers[i].buf, opers[i].buf_len);
+
+			msg = chan_ctx->total_msg++;
+			chan_ctx->data[msg] = &payload_buffer[offset];
+			chan_ctx->len[msg] =
+				PAYLOAD_META_HEADER_LEN + opers[i].buf_len;
+			offset += chan_ctx->len[msg];
+		}
 	}
 
-	/* queue payload if present */
-	if (NULL != buf) {
-		trusty_ote_debug("%s: queue payload\n", __func__);
-		ret = queue_msg(chan_ctx, chan_ctx->data[1], chan_ctx->len[1]);
+	/* queue headers and payloads of all operations before waiting */
+	trusty_ote_debug("%s: queue %d messages\n", __func__,
+			chan_ctx->total_msg);
+	for (msg = 0; msg < chan_ctx->total_msg; msg++) {
+		ret = queue_msg(chan_ctx, chan_ctx->data[msg],
+				chan_ctx->len[msg]);
 		if (ret) {
-			pr_err("%s:error(%d) in queue payload\n", __func__, ret);
-			goto err_exit;
+			pr_err("%s:error(%d) in queue msg %d\n",
+					__func__, ret, msg);
+			return ret;
 		}
 	}
 
@@ -312,29 +371,57 @@ static int handle_ote_msg(struct tipc_chan_ctx *chan_ctx, void *buf,
 	ret = wait_for_response(chan_ctx, REPLY_TIMEOUT);
 	if (ret < 0) {
 		pr_err("%s:ERROR(%d) in receiving header\n", __func__, ret);
-		goto err_exit;
+		return ret;
 	}
 
 	/* sanity check */
 	WARN_ON(chan_ctx->state != TIPC_CONNECTED);
 
-	if (NULL != buf) {
-		memcpy(&payload_header, payload_buffer, PAYLOAD_META_HEADER_LEN);
-		if (payload_header.magic != PAYLOAD_HEADER_MAGIC) {
-			ret = -EINVAL;
-			pr_err("%s: payload header magic mismatch. received != expected "
-				"(%x != %x)\n", __func__, payload_header.magic,
-				PAYLOAD_HEADER_MAGIC);
-			goto err_exit;
+	offset = 0;
+	for (i = 0; i < num_opers; i++) {
+		if (NULL != opers[i].buf) {
+			memcpy(&payload_header, &payload_buffer[offset],
+					PAYLOAD_META_HEADER_LEN);
+			if (payload_header.magic != PAYLOAD_HEADER_MAGIC) {
+				ret = -EINVAL;
+				pr_err("%s: payload header magic mismatch. received != expected "
+					"(%x != %x)\n", __func__, payload_header.magic,
+					PAYLOAD_HEADER_MAGIC);
+				return ret;
+			}
+			memcpy(opers[i].buf,
+				&payload_buffer[offset + PAYLOAD_META_HEADER_LEN],
+				opers[i].buf_len);
+			offset += PAYLOAD_META_HEADER_LEN + opers[i].buf_len;
 		}
-		memcpy(buf, &payload_buffer[PAYLOAD_META_HEADER_LEN], len);
+
+		opers[i].op_status = stream_headers[i].status;
+		trusty_ote_debug("%s: op status 0x%08x\n", __func__,
+				opers[i].op_status);
 	}
 
-	*op_status = stream_header.status;
-	trusty_ote_debug("%s: op status 0x%08x\n", __func__, *op_status);
+	return ret;
+}
+
+/*
+ * Constructs OTE message and sent it to TA over TIPC channel.
+ * And then wait till response is received from TA.
+ */
+static int handle_ote_msg(struct tipc_chan_ctx *chan_ctx, void *buf,
+		size_t len, uint32_t cmd, te_error_t *op_status)
+{
+	int ret;
+	struct te_oper oper = {
+		.buf = buf,
+		.buf_len = len,
+		.ta_cmd = cmd,
+		.op_status = OTE_ERROR_GENERIC,
+	};
+
+	ret = handle_ote_msgs(chan_ctx, &oper, 1);
+	if (!ret)
+		*op_status = oper.op_status;
 
-err_exit:
-	kfree(payload_buffer);
 	return ret;
 }
 
@@ -487,3 +574,52 @@ int te_launch_trusted_oper(void *buf, size_t buf_len, uint32_t ta_cmd,
 	return 0;
 }
 EXPORT_SYMBOL(te_launch_trusted_oper);
+
+/*
+ * te_launch_trusted_opers - Communicate with TA to perform a group of
+ * independent operations in a single exchange
+ * @opers: array of operations to perform.
+ * @num_opers: number of operations, up to TE_MAX_BATCH_OPERS.
+ * @ctx: ctx returned by open session.
+ * Returns 0 when all operations succeed else error code; op_status of
+ * each operation tells which ones failed.
+ */
+int te_launch_trusted_opers(struct te_oper *opers, uint32_t num_opers,
+		void *ctx)
+{
+	int ret;
+	uint32_t i;
+	struct tipc_chan_ctx *chan_ctx;
+
+	trusty_ote_debug("%s: %u opers\n", __func__, num_opers);
+
+	if (!ctx || !opers)
+		return -EINVAL;
+
+	chan_ctx = (struct tipc_chan_ctx *)ctx;
+
+	if (chan_ctx->state != TIPC_CONNECTED) {
+		pr_err("%s:Invalid channel state %d\n",
+				__func__, chan_ctx->state);
+		return -ENOTCONN;
+	}
+
+	for (i = 0; i < num_opers; i++)
+		opers[i].op_status = OTE_ERROR_GENERIC;
+
+	ret = handle_ote_msgs(chan_ctx, opers, num_opers);
+	if (ret) {
+		pr_err("%s:ERROR(%d) in handle_ote_msgs\n", __func__, ret);
+		return ret;
+	}
+
+	for (i = 0; i < num_opers; i++) {
+		if (opers[i].op_status) {
+			pr_err("%s: ERROR in operation %u 0x%08x", __func__,
+					i, opers[i].op_status);
+			ret = -EINVAL;
+		}
+	}
+	return ret;
+}
+EXPORT_SYMBOL(te_launch_trusted_opers);
@@ -20,6 +20,9 @@
 #include <linux/slab.h>
 #include <linux/mutex.h>
 #include <linux/string.h>
+#include <linux/log2.h>
+#include <linux/mm.h>
+#include <linux/vmalloc.h>
 
 #include "dc.h"
 #include "dc_priv_defs.h"
@@ -703,6 +706,174 @@ long tegra_dc_crc_get(struct tegra_dc *dc, struct tegra_dc_ext_crc_arg *arg)
 	return ret;
 }
 
+static inline size_t tegra_dc_crc_ring_bytes(u32 depth)
+{
+	return PAGE_ALIGN(sizeof(struct tegra_dc_ext_crc_ring_hdr) +
+			  depth * sizeof(struct tegra_dc_ext_crc_ring_ele));
+}
+
+/* Publish a freshly collected CRC element into the mmap-able history ring.
+ * The slot sequence number is bumped to an odd value before the rewrite and
+ * back to even once the slot is consistent, and head is published last, so
+ * that lock-free userspace readers can detect and retry torn reads
+ */
+static void tegra_dc_crc_ring_deposit(struct tegra_dc *dc,
+				      struct tegra_dc_crc_buf_ele *ele)
+{
+	struct tegra_dc_ext_crc_ring_hdr *hdr;
+	struct tegra_dc_ext_crc_ring_ele *slot;
+	u32 idx, valid = 0;
+	u8 i;
+
+	mutex_lock(&dc->crc_ring_lock);
+
+	hdr = dc->crc_ring;
+	if (!hdr) {
+		mutex_unlock(&dc->crc_ring_lock);
+		return;
+	}
+
+	idx = (hdr->head + 1) % dc->crc_ring_depth;
+	slot = (struct tegra_dc_ext_crc_ring_ele *)(hdr + 1) + idx;
+
+	WRITE_ONCE(slot->seq, slot->seq + 1); /* Odd, slot in flux */
+	smp_wmb();
+
+	slot->frame_cnt = tegra_dc_get_frame_cnt(dc);
+	slot->rg = ele->rg.crc;
+	if (ele->rg.valid)
+		valid |= TEGRA_DC_EXT_CRC_RING_VALID_RG;
+	slot->comp = ele->comp.crc;
+	if (ele->comp.valid)
+		valid |= TEGRA_DC_EXT_CRC_RING_VALID_COMP;
+	slot->sor = ele->sor.crc;
+	if (ele->sor.valid)
+		valid |= TEGRA_DC_EXT_CRC_RING_VALID_OR;
+	for (i = 0; i < TEGRA_DC_MAX_CRC_REGIONS; i++) {
+		slot->regional[i] = ele->regional[i].crc;
+		if (ele->regional[i].valid)
+			valid |= TEGRA_DC_EXT_CRC_RING_VALID_REGIONAL(i);
+	}
+	slot->valid = valid;
+
+	smp_wmb();
+	WRITE_ONCE(slot->seq, slot->seq + 1); /* Even, slot consistent */
+	smp_wmb();
+	WRITE_ONCE(hdr->head, idx);
+
+	mutex_unlock(&dc->crc_ring_lock);
+}
+
+long tegra_dc_crc_ring_setup(struct tegra_dc *dc,
+			     struct tegra_dc_ext_crc_ring_setup *arg)
+{
+	struct tegra_dc_ext_crc_ring_hdr *hdr;
+	u32 depth = arg->depth;
+	long ret = 0;
+
+	if (depth && (!is_power_of_2(depth) ||
+		      depth < TEGRA_DC_EXT_CRC_RING_MIN_DEPTH ||
+		      depth > TEGRA_DC_EXT_CRC_RING_MAX_DEPTH))
+		return -EINVAL;
+
+	mutex_lock(&dc->crc_ring_lock);
+
+	if (dc->crc_ring && depth == dc->crc_ring_depth)
+		goto done; /* Already sized as requested */
+
+	/* Freeing the ring while mapped would pull the pages from under the
+	 * readers, so resizes are refused until all mappings are gone
+	 */
+	if (atomic_read(&dc->crc_ring_maps)) {
+		ret = -EBUSY;
+		goto done;
+	}
+
+	if (dc->crc_ring) {
+		vfree(dc->crc_ring);
+		dc->crc_ring = NULL;
+		dc->crc_ring_depth = 0;
+	}
+
+	if (!depth)
+		goto done;
+
+	hdr = vmalloc_user(tegra_dc_crc_ring_bytes(depth));
+	if (!hdr) {
+		ret = -ENOMEM;
+		goto done;
+	}
+
+	hdr->magic = TEGRA_DC_EXT_CRC_RING_MAGIC;
+	hdr->version = TEGRA_DC_EXT_CRC_RING_VERSION;
+	hdr->ring_size = depth;
+	hdr->head = depth - 1; /* First deposit publishes slot 0 */
+
+	dc->crc_ring = hdr;
+	dc->crc_ring_depth = depth;
+
+done:
+	mutex_unlock(&dc->crc_ring_lock);
+	return ret;
+}
+
+static void tegra_dc_crc_ring_vm_open(struct vm_area_struct *vma)
+{
+	struct tegra_dc *dc = vma->vm_private_data;
+
+	atomic_inc(&dc->crc_ring_maps);
+}
+
+static void tegra_dc_crc_ring_vm_close(struct vm_area_struct *vma)
+{
+	struct tegra_dc *dc = vma->vm_private_data;
+
+	atomic_dec(&dc->crc_ring_maps);
+}
+
+static const struct vm_operations_struct tegra_dc_crc_ring_vm_ops = {
+	.open = tegra_dc_crc_ring_vm_open,
+	.close = tegra_dc_crc_ring_vm_close,
+};
+
+int tegra_dc_crc_ring_mmap(struct tegra_dc *dc, struct vm_area_struct *vma)
+{
+	int ret;
+
+	if (vma->vm_pgoff)
+		return -EINVAL;
+
+	if (vma->vm_flags & VM_WRITE)
+		return -EPERM;
+
+	mutex_lock(&dc->crc_ring_lock);
+
+	if (!dc->crc_ring) {
+		ret = -ENODEV;
+		goto done;
+	}
+
+	if (vma->vm_end - vma->vm_start >
+	    tegra_dc_crc_ring_bytes(dc->crc_ring_depth)) {
+		ret = -EINVAL;
+		goto done;
+	}
+
+	vma->vm_flags &= ~VM_MAYWRITE;
+
+	ret = remap_vmalloc_range(vma, dc->crc_ring, 0);
+	if (ret)
+		goto done;
+
+	vma->vm_ops = &tegra_dc_crc_ring_vm_ops;
+	vma->vm_private_data = dc;
+	atomic_inc(&dc->crc_ring_maps);
+
+done:
+	mutex_unlock(&dc->crc_ring_lock);
+	return ret;
+}
+
 int tegra_dc_crc_process(struct tegra_dc *dc)
 {
 	int ret = 0, matched = 0;
@@ -720,6 +891,11 @@ int tegra_dc_crc_process(struct tegra_dc *dc)
 	if (ret)
 		return ret;
 
+	/* Publish to the history ring irrespective of whether any flips match
+	 * this frame, so continuous audits see every collected CRC
+	 */
+	tegra_dc_crc_ring_deposit(dc, &crc_ele);
+
 	mutex_lock(&dc->flip_buf.lock);
 
 	/* Before doing any work, check if there are flips to match */
@@ -374,6 +374,30 @@ int tegra_dc_cursor_image(struct tegra_dc *dc,
 
 int tegra_dc_cursor_set(struct tegra_dc *dc, bool enable, int x, int y)
 {
+	/* A pure position move only touches the dedicated double-buffered
+	 * cursor registers, which latch at vblank with CURSOR_ACT_REQ
+	 * independently of the general window pipeline. Program them under
+	 * the cursor-only lock so cursor motion never waits behind a flip
+	 * holding dc->lock. Any enable or image change still goes through
+	 * the full programming path below.
+	 */
+	if (dc->enabled && !dc->cursor.dirty && enable == dc->cursor.enabled) {
+		mutex_lock(&dc->cursor.pos_lock);
+		tegra_dc_get(dc);
+		if (dc->enabled) {
+			dc->cursor.x = x;
+			dc->cursor.y = y;
+			set_cursor_position(dc, x, y);
+			tegra_dc_writel(dc, CURSOR_UPDATE,
+					DC_CMD_STATE_CONTROL);
+			tegra_dc_writel(dc, CURSOR_ACT_REQ,
+					DC_CMD_STATE_CONTROL);
+		}
+		tegra_dc_put(dc);
+		mutex_unlock(&dc->cursor.pos_lock);
+		return 0;
+	}
+
 	mutex_lock(&dc->lock);
 	dc->cursor.x = x;
 	dc->cursor.y = y;
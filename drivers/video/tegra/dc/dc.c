@@ -4876,6 +4876,9 @@ static void tegra_dc_underflow_handler(struct tegra_dc *dc)
 
 static void tegra_dc_process_vblank(struct tegra_dc *dc)
 {
+	/* track the vblank phases of frame-locked heads */
+	tegra_dc_common_process_vblank(dc);
+
 	/* pending user vblank, so wakeup */
 	if (dc->out->user_needs_vblank) {
 		dc->out->user_needs_vblank = false;
@@ -5855,6 +5858,9 @@ static void _tegra_dc_controller_disable(struct tegra_dc *dc)
 
 	tegra_dc_get(dc);
 
+	/* Window state programmed so far is lost along with the controller */
+	dc->shadow_valid_mask = 0;
+
 	if (atomic_read(&dc->holding)) {
 		/* Force release all refs but the last one */
 		atomic_set(&dc->holding, 1);
@@ -6611,6 +6617,8 @@ static int tegra_dc_probe(struct platform_device *ndev)
 	mutex_init(&dc->one_shot_lock);
 	mutex_init(&dc->lp_lock);
 	mutex_init(&dc->msrmnt_info.lock);
+	mutex_init(&dc->crc_ring_lock);
+	mutex_init(&dc->cursor.pos_lock);
 	init_completion(&dc->frame_end_complete);
 	init_completion(&dc->crc_complete);
 	init_completion(&dc->hpd_complete);
@@ -159,6 +159,8 @@ struct tegra_dsi_cmd {
 #define DSI_DCS_SET_DISPLAY_OFF			0x28
 #define DSI_DCS_SET_TEARING_EFFECT_OFF		0x34
 #define DSI_DCS_SET_TEARING_EFFECT_ON		0x35
+#define DSI_DCS_SET_COLUMN_ADDR			0x2a
+#define DSI_DCS_SET_PAGE_ADDR			0x2b
 #define DSI_DCS_NO_OP				0x0
 #define DSI_NULL_PKT_NO_DATA			0x9
 #define DSI_BLANKING_PKT_NO_DATA		0x19
@@ -1201,4 +1203,10 @@ long tegra_dc_crc_disable(struct tegra_dc *dc,
 			  struct tegra_dc_ext_crc_arg *arg);
 long tegra_dc_crc_get(struct tegra_dc *dc, struct tegra_dc_ext_crc_arg *arg);
 
+/* APIs related to the mmap-able CRC history ring */
+struct vm_area_struct;
+long tegra_dc_crc_ring_setup(struct tegra_dc *dc,
+			     struct tegra_dc_ext_crc_ring_setup *arg);
+int tegra_dc_crc_ring_mmap(struct tegra_dc *dc, struct vm_area_struct *vma);
+
 #endif
@@ -25,6 +25,7 @@
 #include <linux/dma-mapping.h>
 #include <linux/of_address.h>
 #include <linux/delay.h>
+#include <linux/ktime.h>
 #include "dc.h"
 #include "dc_reg.h"
 #include "dc_priv.h"
@@ -45,6 +46,12 @@
 #define WAIT_TYPE_CHECK_GEN_ACT_PROMOTION	(1<<1)
 #define WRITE_READ_MUX_ACTIVE			(0x05)
 #define WRITE_MUX_ACTIVE_READ_MUX_ASSEMBLY	(0x01)
+/**
+ * @DC_COMMON_DEFAULT_MAX_DRIFT_US - Default max. allowed vblank phase
+ * difference in usecs between frame-locked heads before dc_common
+ * re-aligns them. Can be changed at runtime through debugfs.
+ */
+#define DC_COMMON_DEFAULT_MAX_DRIFT_US		200
 /**
  * __nvhost_opcode_nonincr_write_reg - Fill the command buffer with
  * host1x opcode and value.
@@ -303,6 +310,7 @@ static int _tegra_dc_common_sync_frames(struct tegra_dc *dc, ulong dsp_cmd_reg,
 {
 	int i;
 	int ret = 0;
+	unsigned long irq_flags;
 
 	__received_bit_set(dc->ctrl_num, &dc_common->head_data.fr_lck_req_rcvd);
 
@@ -334,6 +342,13 @@ static int _tegra_dc_common_sync_frames(struct tegra_dc *dc, ulong dsp_cmd_reg,
 
 	dc_common->heads_locked = true;
 
+	/* Restart drift tracking for the newly locked rasters. */
+	spin_lock_irqsave(&dc_common->vblank_lock, irq_flags);
+	dc_common->vblank_rcvd = 0UL;
+	dc_common->last_drift_us = 0;
+	dc_common->drift_count = 0;
+	spin_unlock_irqrestore(&dc_common->vblank_lock, irq_flags);
+
 #if 0
 	/* For Debug*/
 	for_each_set_bit(i, &dc_common->valid_heads, max_heads) {
@@ -645,6 +660,94 @@ err_handle:
 }
 EXPORT_SYMBOL(tegra_dc_common_handle_flip_lock_error);
 
+/**
+ * dc_common_drift_work - Re-aligns the rasters of the locked heads.
+ * @work: Pointer to @dc_common->drift_work.
+ *
+ * Scheduled from @tegra_dc_common_process_vblank when the measured
+ * vblank phase difference between the locked heads crosses
+ * @max_drift_us. Stalls the heads the same way the flip-lock error
+ * path does so that all of them promote their updates on the same
+ * frame again, without the user space re-sync dance.
+ */
+static void dc_common_drift_work(struct work_struct *work)
+{
+	int i;
+	struct tegra_dc *dc_head = NULL;
+
+	mutex_lock(&dc_common->lock);
+
+	if (!dc_common->heads_locked) {
+		mutex_unlock(&dc_common->lock);
+		return;
+	}
+
+	for_each_set_bit(i, &dc_common->valid_heads, max_heads) {
+		dc_head = tegra_dc_get_dc(i);
+		if (dc_head)
+			tegra_dc_request_trigger_wins(dc_head);
+	}
+
+	mutex_unlock(&dc_common->lock);
+}
+
+/**
+ * tegra_dc_common_process_vblank - Tracks the vblank phases of the
+ *					locked heads and corrects drift.
+ * @dc: Pointer to the caller head's tegra_dc struct.
+ *
+ * Called from the vblank interrupt path of every head. Once all the
+ * locked heads have reported a vblank for the current evaluation
+ * window, the max. phase difference amongst them is computed. If it
+ * crosses @max_drift_us then @drift_work is scheduled to re-align the
+ * heads. Kept lightweight since it runs in interrupt context.
+ */
+void tegra_dc_common_process_vblank(struct tegra_dc *dc)
+{
+	int i;
+	unsigned long irq_flags;
+	ktime_t first, last, now;
+
+	if (!dc_common || !dc || !dc_common->heads_locked)
+		return;
+
+	if (!__valid_request(dc_common->valid_heads, dc->ctrl_num))
+		return;
+
+	now = ktime_get();
+
+	spin_lock_irqsave(&dc_common->vblank_lock, irq_flags);
+
+	dc_common->vblank_ts[dc->ctrl_num] = now;
+	__received_bit_set(dc->ctrl_num, &dc_common->vblank_rcvd);
+
+	if (!__all_req_rcvd(dc_common->vblank_rcvd,
+					dc_common->valid_heads)) {
+		spin_unlock_irqrestore(&dc_common->vblank_lock, irq_flags);
+		return;
+	}
+
+	first = now;
+	last = now;
+	for_each_set_bit(i, &dc_common->valid_heads, max_heads) {
+		if (ktime_before(dc_common->vblank_ts[i], first))
+			first = dc_common->vblank_ts[i];
+		if (ktime_after(dc_common->vblank_ts[i], last))
+			last = dc_common->vblank_ts[i];
+	}
+
+	dc_common->vblank_rcvd = 0UL;
+	dc_common->last_drift_us = ktime_us_delta(last, first);
+
+	if (dc_common->last_drift_us > dc_common->max_drift_us) {
+		dc_common->drift_count++;
+		schedule_work(&dc_common->drift_work);
+	}
+
+	spin_unlock_irqrestore(&dc_common->vblank_lock, irq_flags);
+}
+EXPORT_SYMBOL(tegra_dc_common_process_vblank);
+
 /**
  * _tegra_dc_common_enable_frame_lock - Enables framelock in all the
  *					participating heads.
@@ -998,6 +1101,67 @@ static const struct file_operations frame_lock_head_mask_fops = {
 	.release = single_release,
 };
 
+static int dbg_dc_common_frame_lock_drift_show(struct seq_file *m,
+								void *unused)
+{
+	unsigned long irq_flags;
+	struct tegra_dc_common *dc_common = m->private;
+
+	if (!dc_common)
+		return -ENODEV;
+
+	spin_lock_irqsave(&dc_common->vblank_lock, irq_flags);
+
+	seq_printf(m, "max_drift_us : %u\n", dc_common->max_drift_us);
+	seq_printf(m, "last_drift_us : %u\n", dc_common->last_drift_us);
+	seq_printf(m, "drift_count : %llu\n", dc_common->drift_count);
+
+	spin_unlock_irqrestore(&dc_common->vblank_lock, irq_flags);
+
+	return 0;
+}
+
+static int dbg_dc_common_frame_lock_drift_open(struct inode *inode,
+							struct file *file)
+{
+	return single_open(file, dbg_dc_common_frame_lock_drift_show,
+							inode->i_private);
+}
+
+static ssize_t dbg_dc_common_frame_lock_drift_write(struct file *file,
+			const char __user *addr, size_t len, loff_t *pos)
+{
+	int ret;
+	long new_max_drift_us;
+	unsigned long irq_flags;
+	struct seq_file *m = file->private_data;
+	struct tegra_dc_common *dc_common = m->private;
+
+	if (!dc_common)
+		return -ENODEV;
+
+	ret = kstrtol_from_user(addr, len, 10, &new_max_drift_us);
+	if (ret < 0)
+		return ret;
+
+	if (new_max_drift_us < 0)
+		return -EINVAL;
+
+	spin_lock_irqsave(&dc_common->vblank_lock, irq_flags);
+	dc_common->max_drift_us = new_max_drift_us;
+	spin_unlock_irqrestore(&dc_common->vblank_lock, irq_flags);
+
+	return len;
+}
+
+static const struct file_operations frame_lock_drift_fops = {
+	.open	= dbg_dc_common_frame_lock_drift_open,
+	.read	= seq_read,
+	.write	= dbg_dc_common_frame_lock_drift_write,
+	.llseek	= seq_lseek,
+	.release = single_release,
+};
+
 static void tegra_dc_common_remove_debugfs(struct tegra_dc_common *dc_common)
 {
 	if (dc_common->debugdir)
@@ -1024,6 +1188,11 @@ static void tegra_dc_common_create_debugfs(struct tegra_dc_common *dc_common)
 	if (!retval)
 		goto err_handle;
 
+	retval = debugfs_create_file("frame_lock_drift", 0444,
+		dc_common->debugdir, dc_common,	&frame_lock_drift_fops);
+	if (!retval)
+		goto err_handle;
+
 	return;
 
 err_handle:
@@ -1196,6 +1365,9 @@ static int tegra_dc_common_probe(struct platform_device *pdev)
 
 	mutex_init(&dc_common->lock);
 	init_waitqueue_head(&dc_common->prgrm_reg_reqs_wq);
+	spin_lock_init(&dc_common->vblank_lock);
+	INIT_WORK(&dc_common->drift_work, dc_common_drift_work);
+	dc_common->max_drift_us = DC_COMMON_DEFAULT_MAX_DRIFT_US;
 
 	dc_common->valid_heads = dt_pdata->valid_heads;
 	dc_common->imp_table = dt_pdata->imp_table;
@@ -1248,6 +1420,7 @@ static int tegra_dc_common_remove(struct platform_device *pdev)
 	mutex_lock(&dc_common->lock);
 	_tegra_dc_common_disable_frame_lock(dc_common);
 	mutex_unlock(&dc_common->lock);
+	cancel_work_sync(&dc_common->drift_work);
 	dma_free_coherent(pdev->dev.parent, CMDBUF_SIZE,
 			dc_common->cpuvaddr, dc_common->dma_handle);
 	nvhost_syncpt_put_ref_ext(pdev, dc_common->syncpt_id);
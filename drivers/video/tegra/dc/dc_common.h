@@ -187,6 +187,43 @@ struct tegra_dc_common {
 	 * to program DC_CMD_STATE_CONTROL register.
 	 */
 	wait_queue_head_t	prgrm_reg_reqs_wq;
+	/**
+	 * @vblank_lock: Used by dc_common to protect the vblank drift
+	 * tracking state below. Taken from the vblank interrupt path of
+	 * the heads and hence a spinlock instead of @lock.
+	 */
+	spinlock_t	vblank_lock;
+	/**
+	 * @vblank_ts: Stores the last vblank timestamp reported by each
+	 * of the heads participating in frame lock.
+	 */
+	ktime_t	vblank_ts[MAX_HEAD_COUNT];
+	/**
+	 * @vblank_rcvd: Used to keep track of the heads that have
+	 * reported a vblank for the current drift evaluation window.
+	 */
+	ulong	vblank_rcvd;
+	/**
+	 * @max_drift_us: Max. allowed vblank phase difference in usecs
+	 * between the locked heads. Crossing it schedules @drift_work
+	 * to re-align the heads.
+	 */
+	u32	max_drift_us;
+	/**
+	 * @last_drift_us: Stores the phase difference measured in the
+	 * last complete drift evaluation window.
+	 */
+	u32	last_drift_us;
+	/**
+	 * @drift_count: No. of times the measured drift crossed
+	 * @max_drift_us since the heads were frame-locked.
+	 */
+	u64	drift_count;
+	/**
+	 * @drift_work: Bottom-half to re-align the locked heads when
+	 * their rasters have drifted apart.
+	 */
+	struct work_struct	drift_work;
 	/**
 	 * @imp_table: Holds platform data of IHUB settings for all
 	 * windows and heads.
@@ -231,6 +268,8 @@ int tegra_dc_common_sync_frames(struct tegra_dc *dc, ulong dsp_cmd_reg,
 
 int tegra_dc_common_handle_flip_lock_error(struct tegra_dc *dc);
 
+void tegra_dc_common_process_vblank(struct tegra_dc *dc);
+
 int tegra_dc_common_get_frm_lock_params(
 		struct tegra_dc_ext_control_frm_lck_params *params);
 
@@ -180,6 +180,7 @@ int tegra_dc_calc_refresh(const struct tegra_dc_mode *m);
 int tegra_dc_calc_fb_refresh(const struct fb_videomode *fbmode);
 int tegra_dc_update_mode(struct tegra_dc *dc);
 u32 tegra_dc_get_aspect_ratio(struct tegra_dc *dc);
+void tegra_dc_set_partial_active(struct tegra_dc *dc, u16 width, u16 height);
 
 /* defined in mode.c, used in hdmi.c and hdmi2.0.c */
 bool check_fb_videomode_timings(const struct tegra_dc *dc,
@@ -109,6 +109,10 @@ struct tegra_dc_out_ops {
 	/* callback before new mode is programmed.
 	 * dc clocks are on at this point */
 	void (*modeset_notifier)(struct tegra_dc *dc);
+	/* narrow the next frame to a damage rectangle on the panel.
+	 * dc clocks are on at this point */
+	int (*partial_update)(struct tegra_dc *dc, u16 x, u16 y,
+		u16 w, u16 h);
 	/* refcounted enable of pads and clocks before performing DDC/I2C. */
 	int (*ddc_enable)(struct tegra_dc *dc);
 	/* refcounted disable of pads and clocks after performing DDC/I2C. */
@@ -518,6 +522,11 @@ struct tegra_dc {
 	struct tegra_dc_win		windows[DC_N_WINDOWS];
 
 	struct tegra_dc_win		shadow_windows[DC_N_WINDOWS];
+	/* Windows whose shadow_windows entry matches the programmed HW state.
+	 * Cleared whenever the programmed state is lost, i.e. on controller
+	 * disable and on mode programming
+	 */
+	unsigned long			shadow_valid_mask;
 
 	struct tegra_dc_blend		blend;
 	int				n_windows;
@@ -610,6 +619,8 @@ struct tegra_dc {
 	struct delayed_work		underflow_work;
 	u32				one_shot_delay_ms;
 	struct delayed_work		one_shot_work;
+	/* scanout is narrowed to a damage rectangle, see partial_update */
+	bool				partial_active;
 	s64				frame_end_timestamp;
 	atomic_t			frame_end_ref;
 
@@ -640,6 +651,9 @@ struct tegra_dc {
 		enum tegra_dc_cursor_blend_format blendfmt;
 		enum tegra_dc_cursor_color_format colorfmt;
 		u32 alpha;
+		/* serializes position-only updates, which program the
+		 * dedicated cursor registers without taking dc->lock */
+		struct mutex pos_lock;
 	} cursor;
 
 	int	ctrl_num;
@@ -674,6 +688,12 @@ struct tegra_dc {
 	struct tegra_dc_ring_buf crc_buf; /* Buffer to save HW generated CRCs */
 	struct tegra_dc_crc_ref_cnt crc_ref_cnt;
 	bool crc_initialized;
+
+	/* mmap-able CRC history ring, see TEGRA_DC_EXT_CRC_RING_SETUP */
+	struct tegra_dc_ext_crc_ring_hdr *crc_ring;
+	u32 crc_ring_depth;
+	atomic_t crc_ring_maps; /* Count of live userspace mappings */
+	struct mutex crc_ring_lock;
 	struct tegra_dc_latency_measurement_data msrmnt_info;
 
 #if defined(CONFIG_TEGRA_DC_FAKE_PANEL_SUPPORT)
@@ -955,6 +955,7 @@ static void tegra_dc_dp_debugfs_create(struct tegra_dc_dp_data *dp)
 	retval = tegra_dpaux_dpcd_dir_create(dp, dp->debugdir);
 	if (!retval)
 		goto free_out;
+	debugfs_create_bool("mst_cap", 0444, dp->debugdir, &dp->mst_cap);
 
 	/* hotplug not allowed for eDP */
 	if (is_hotplug_supported(dp)) {
@@ -1567,6 +1568,35 @@ int tegra_dp_set_enhanced_framing(struct tegra_dc_dp_data *dp, bool enable)
 	return 0;
 }
 
+/*
+ * Enable or disable multi-stream transport in the branch device. This only
+ * switches the sink side transport mode; the source keeps driving a single
+ * stream until per-stream payload table programming is added to the SOR, so
+ * the stream targets virtual channel 0 either way.
+ */
+int tegra_dp_set_mst_mode(struct tegra_dc_dp_data *dp, bool enable)
+{
+	int ret;
+	u8 val = 0;
+
+	if (dp->dc->out->type == TEGRA_DC_OUT_FAKE_DP)
+		return 0;
+
+	if (enable) {
+		if (!dp->mst_cap)
+			return -EINVAL;
+		val = NV_DPCD_MSTM_CTRL_MST_EN_YES |
+			NV_DPCD_MSTM_CTRL_UP_REQ_EN_YES |
+			NV_DPCD_MSTM_CTRL_UPSTREAM_IS_SRC_YES;
+	}
+
+	ret = tegra_dc_dp_dpcd_write(dp, NV_DPCD_MSTM_CTRL, val);
+	if (!ret)
+		dp->mst_mode = enable;
+
+	return ret;
+}
+
 static int tegra_dp_set_lane_count(struct tegra_dc_dp_data *dp, u8 lane_cnt)
 {
 	int ret;
@@ -2458,6 +2488,21 @@ static void tegra_dp_read_sink_cap(struct tegra_dc_dp_data *dp)
 	tegra_dc_io_end(dc);
 }
 
+static void tegra_dp_read_mst_cap(struct tegra_dc_dp_data *dp)
+{
+	u8 dpcd_data = 0;
+
+	dp->mst_cap = false;
+
+	if (dp->dc->out->type == TEGRA_DC_OUT_FAKE_DP)
+		return;
+
+	if (tegra_dc_dp_dpcd_read(dp, NV_DPCD_MSTM_CAP, &dpcd_data))
+		return;
+
+	dp->mst_cap = !!(dpcd_data & NV_DPCD_MSTM_CAP_MST_CAP_YES);
+}
+
 static void tegra_dp_hpd_op_edid_ready(void *drv_data)
 {
 	struct tegra_dc_dp_data *dp = drv_data;
@@ -2488,6 +2533,7 @@ static void tegra_dp_hpd_op_edid_ready(void *drv_data)
 	tegra_dc_io_start(dc);
 	tegra_dc_dp_dpcd_read(dp, NV_DPCD_SINK_COUNT,
 				&dp->sink_cnt_cp_ready);
+	tegra_dp_read_mst_cap(dp);
 
 	if (tegra_dp_auto_is_rq(dp)) {
 		enum auto_test_requests test_rq;
@@ -152,6 +152,11 @@ struct tegra_dc_dp_data {
 	bool sink_cap_valid;
 	u8 sink_cnt_cp_ready;
 
+	/* sink reports MST capability (DPCD MSTM_CAP) */
+	bool mst_cap;
+	/* MST transport enabled in the branch device (DPCD MSTM_CTRL) */
+	bool mst_mode;
+
 	u16 dpaux_i2c_dbg_addr;
 	u32 dpaux_i2c_dbg_num_bytes;
 	u16 dpaux_dpcd_dbg_addr;
@@ -297,6 +302,8 @@ static inline void tegra_dp_set_outdata(struct tegra_dc_dp_data *dp,
 #define NV_DPCD_TRAINING_AUX_RD_INTERVAL		(0x0000000E)
 #define NV_DPCD_TRAINING_AUX_RD_INTERVAL_MASK		(0x3f)
 #define NV_DPCD_EXT_RECEIVER_CAP_FIELD_PRESENT_SHIFT	(6)
+#define NV_DPCD_MSTM_CAP				(0x00000021)
+#define NV_DPCD_MSTM_CAP_MST_CAP_YES			(0x00000001)
 #define NV_DPCD_LINK_BANDWIDTH_SET			(0x00000100)
 #define NV_DPCD_LANE_COUNT_SET				(0x00000101)
 #define NV_DPCD_LANE_COUNT_SET_MASK			(0x1f)
@@ -333,6 +340,10 @@ static inline void tegra_dp_set_outdata(struct tegra_dc_dp_data *dp,
 #define NV_DPCD_EDP_CONFIG_SET_FRAMING_CHANGE_ENABLE	(0x00000001 << 1)
 #define NV_DPCD_TRAINING_LANE0_1_SET2			(0x0000010F)
 #define NV_DPCD_TRAINING_LANE2_3_SET2			(0x00000110)
+#define NV_DPCD_MSTM_CTRL				(0x00000111)
+#define NV_DPCD_MSTM_CTRL_MST_EN_YES			(0x00000001)
+#define NV_DPCD_MSTM_CTRL_UP_REQ_EN_YES			(0x00000001 << 1)
+#define NV_DPCD_MSTM_CTRL_UPSTREAM_IS_SRC_YES		(0x00000001 << 2)
 #define NV_DPCD_LANEX_SET2_PC2_SHIFT			0
 #define NV_DPCD_LANEX_SET2_PC2_MAX_REACHED_T		(0x00000001 << 2)
 #define NV_DPCD_LANEX_SET2_PC2_MAX_REACHED_F		(0x00000000 << 2)
@@ -450,4 +461,5 @@ void tegra_dp_set_max_link_bw(struct tegra_dc_sor_data *sor,
 int tegra_dc_dp_get_max_link_bw(struct tegra_dc_dp_data *dp);
 int tegra_dc_dp_get_max_lane_count(struct tegra_dc_dp_data *dp, u8 *dpcd_data);
 int tegra_dp_set_enhanced_framing(struct tegra_dc_dp_data *dp, bool enable);
+int tegra_dp_set_mst_mode(struct tegra_dc_dp_data *dp, bool enable);
 #endif
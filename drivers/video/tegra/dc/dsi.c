@@ -5646,6 +5646,67 @@ static void tegra_dc_dsi_modeset_notifier(struct tegra_dc *dc)
 		tegra_dsi_pix_correction(dc, dsi);
 }
 
+/*
+ * Narrow the next one-shot frame to a damage rectangle. The panel's
+ * column/page address window is moved to (x, y) - (x+w-1, y+h-1) and the
+ * DC active size is shrunk to match, so only w x h pixels cross the
+ * panel link. Passing the full mode restores full-frame updates.
+ */
+static int tegra_dc_dsi_partial_update(struct tegra_dc *dc,
+				u16 x, u16 y, u16 w, u16 h)
+{
+	struct tegra_dc_dsi_data *dsi = tegra_dc_get_outdata(dc);
+	u8 col[5], page[5];
+	struct tegra_dsi_cmd cmd[] = {
+		DSI_CMD_LONG(DSI_DCS_LONG_WRITE, col),
+		DSI_CMD_LONG(DSI_DCS_LONG_WRITE, page),
+	};
+	u32 x_end = (u32)x + w - 1;
+	u32 y_end = (u32)y + h - 1;
+	int err;
+
+	/* only command mode panels can latch a sub-frame */
+	if (!(dc->out->flags & TEGRA_DC_OUT_ONE_SHOT_MODE))
+		return -EOPNOTSUPP;
+
+	/* ganged links split columns; keep them full frame */
+	if (dsi->info.ganged_type)
+		return -EOPNOTSUPP;
+
+	if (!w || !h || x_end >= dc->mode.h_active ||
+			y_end >= dc->mode.v_active)
+		return -EINVAL;
+
+	col[0] = DSI_DCS_SET_COLUMN_ADDR;
+	col[1] = x >> 8;
+	col[2] = x & 0xff;
+	col[3] = x_end >> 8;
+	col[4] = x_end & 0xff;
+
+	page[0] = DSI_DCS_SET_PAGE_ADDR;
+	page[1] = y >> 8;
+	page[2] = y & 0xff;
+	page[3] = y_end >> 8;
+	page[4] = y_end & 0xff;
+
+	tegra_dc_io_start(dc);
+	tegra_dc_dsi_hold_host(dc);
+
+	err = tegra_dsi_send_panel_cmd(dc, dsi, cmd, ARRAY_SIZE(cmd));
+	if (!err)
+		tegra_dc_set_partial_active(dc, w, h);
+
+	tegra_dc_dsi_release_host(dc);
+	tegra_dc_io_end(dc);
+
+	if (err < 0)
+		dev_err(&dc->ndev->dev,
+			"dsi: failed to set update region %ux%u+%u+%u\n",
+			w, h, x, y);
+
+	return err;
+}
+
 static struct tegra_hpd_ops hpd_ops = {
 	.edid_read = tegra_dsi_hpd_op_edid_read,
 	.get_mode_filter = tegra_dsi_op_get_mode_filter,
@@ -5674,4 +5735,5 @@ struct tegra_dc_out_ops tegra_dc_dsi_ops = {
 	.vrr_enable = tegra_dc_dsi_vrr_enable,
 	.vrr_update_monspecs = tegra_dsi_vrr_update_monspecs,
 	.modeset_notifier = tegra_dc_dsi_modeset_notifier,
+	.partial_update = tegra_dc_dsi_partial_update,
 };
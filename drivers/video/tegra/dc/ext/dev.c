@@ -37,6 +37,7 @@
 #include <uapi/linux/sched/types.h>
 #endif
 #include <uapi/video/tegra_dc_ext.h>
+#include <uapi/linux/nvhost_pipeline_events.h>
 #include <trace/events/display.h>
 
 /* XXX ew */
@@ -130,6 +131,12 @@ struct tegra_dc_ext_flip_data {
 	struct tegra_dc_flip_buf_ele *flip_buf_ele;
 	bool background_color_update_needed;
 	u32 background_color;
+	bool target_vblank_valid;
+	u32 target_frame_cnt;
+	bool damage_rect_valid;
+	struct tegra_dc_ext_udata_damage_rect damage_rect;
+	u64 flip_id;
+	u64 trace_id;
 };
 
 struct tegra_dc_ext_scanline_data {
@@ -1009,6 +1016,89 @@ static void tegra_dc_ext_store_latency_msrmnt_info(struct tegra_dc *dc,
 	mutex_unlock(&dc->msrmnt_info.lock);
 }
 
+/* Upper bound on the number of vblanks a single flip may be held back.
+ * Keeps a bogus target from wedging the flip worker (and with it the
+ * disable path, which flushes the worker).
+ */
+#define TEGRA_DC_EXT_TARGET_VBLANK_MAX_WAIT	16
+
+/*
+ * tegra_dc_ext_wait_for_target_vblank() - hold off a frame-targeted flip
+ * @dc : pointer to struct tegra_dc of the current head.
+ * @target_frame_cnt : hardware frame counter value to present at.
+ *
+ * Blocks the flip worker until the head's frame counter reaches the
+ * target vblank the client requested. Since the per-window flip workers
+ * are serialized, flips queued behind this one retire in order on later
+ * vblanks, which is what lets clients queue several frames ahead. The
+ * hardware counter is 16 bits wide, so targets are compared modulo 2^16.
+ *
+ * Return : void
+ */
+static void tegra_dc_ext_wait_for_target_vblank(struct tegra_dc *dc,
+						u32 target_frame_cnt)
+{
+	int budget = TEGRA_DC_EXT_TARGET_VBLANK_MAX_WAIT;
+	u32 frame_cnt;
+
+	while (budget-- > 0) {
+		tegra_dc_get(dc);
+		frame_cnt = tegra_dc_get_frame_cnt(dc);
+		tegra_dc_put(dc);
+
+		if ((s16)((u16)target_frame_cnt - (u16)frame_cnt) <= 0)
+			return;
+
+		/* returns <= 0 on timeout or error; the display isn't
+		 * advancing, so don't keep the flip hostage. */
+		if (tegra_dc_wait_for_vsync(dc) <= 0)
+			break;
+	}
+
+	dev_dbg(&dc->ndev->dev, "gave up waiting for target vblank %u\n",
+		target_frame_cnt);
+}
+
+/*
+ * tegra_dc_ext_record_present_time() - note when a flip actually latched
+ * @ext : pointer to struct tegra_dc_ext of the current head.
+ * @data : the flip that just retired.
+ *
+ * Called from the flip worker once tegra_dc_sync_windows() confirms the
+ * flip has taken effect. The frame end interrupt that latched the flip
+ * already stamped dc->frame_end_timestamp, so pairing it with the flip id
+ * here gives userspace an accurate presentation time without any vblank
+ * estimation. The history ring is sized to cover the deepest flip queue
+ * a client can reasonably keep in flight.
+ *
+ * Return : void
+ */
+static void tegra_dc_ext_record_present_time(struct tegra_dc_ext *ext,
+					     struct tegra_dc_ext_flip_data *data)
+{
+	struct tegra_dc *dc = ext->dc;
+	u32 frame_cnt, slot;
+
+	tegra_dc_get(dc);
+	frame_cnt = tegra_dc_get_frame_cnt(dc);
+	tegra_dc_put(dc);
+
+	mutex_lock(&ext->present_hist.lock);
+	slot = ext->present_hist.next;
+	ext->present_hist.flip_id[slot] = data->flip_id;
+	ext->present_hist.timestamp_ns[slot] = dc->frame_end_timestamp;
+	ext->present_hist.frame_cnt[slot] = frame_cnt;
+	ext->present_hist.next = (slot + 1) % TEGRA_DC_EXT_PRESENT_HIST_SZ;
+	if (data->flip_id > ext->present_hist.last_flip_id)
+		ext->present_hist.last_flip_id = data->flip_id;
+	mutex_unlock(&ext->present_hist.lock);
+
+	wake_up_interruptible(&ext->present_hist.wq);
+
+	nvhost_pipeline_trace_frame(data->trace_id,
+			NVHOST_PIPELINE_STAGE_FLIP_PRESENTED, 0, frame_cnt);
+}
+
 static void tegra_dc_ext_flip_worker(struct kthread_work *work)
 {
 	struct tegra_dc_ext_flip_data *data =
@@ -1202,6 +1292,10 @@ static void tegra_dc_ext_flip_worker(struct kthread_work *work)
 		tegra_dc_flip_trace(data, trace_sync_wt_ovr_syncpt_upd);
 
 	if (dc->enabled && !skip_flip) {
+		if (data->target_vblank_valid)
+			tegra_dc_ext_wait_for_target_vblank(dc,
+						data->target_frame_cnt);
+
 		tegra_dc_set_hdr(dc, &data->hdr_data, data->hdr_cache_dirty);
 
 		if (data->dv_cache_dirty)
@@ -1237,6 +1331,20 @@ static void tegra_dc_ext_flip_worker(struct kthread_work *work)
 		if (dc->yuv_bypass_dirty || dc->yuv_bypass)
 			dc->yuv_bypass_dirty = false;
 
+		if (dc->out_ops && dc->out_ops->partial_update) {
+			if (data->damage_rect_valid)
+				dc->out_ops->partial_update(dc,
+					data->damage_rect.x,
+					data->damage_rect.y,
+					data->damage_rect.w,
+					data->damage_rect.h);
+			else if (dc->partial_active)
+				/* restore full frame updates */
+				dc->out_ops->partial_update(dc, 0, 0,
+					dc->mode.h_active,
+					dc->mode.v_active);
+		}
+
 		tegra_dc_update_windows(wins, nr_win,
 			wait_for_vblank, lock_flip);
 
@@ -1253,6 +1361,8 @@ static void tegra_dc_ext_flip_worker(struct kthread_work *work)
 		if (trace_scanout_syncpt_upd_enabled())
 			tegra_dc_flip_trace(data, trace_scanout_syncpt_upd);
 
+		tegra_dc_ext_record_present_time(ext, data);
+
 		tegra_dc_ext_store_latency_msrmnt_info(dc, data);
 
 		if (dc->out->vrr)
@@ -1848,6 +1958,34 @@ static int tegra_dc_ext_read_user_data(struct tegra_dc_ext_flip_data *data,
 			if (ret)
 				return ret;
 			break;
+		case TEGRA_DC_EXT_FLIP_USER_DATA_TARGET_VBLANK:
+			if (data->target_vblank_valid) {
+				dev_err(&data->ext->dc->ndev->dev,
+					"only one target_vblank/flip is allowed\n");
+				return -EINVAL;
+			}
+			data->target_frame_cnt =
+				flip_user_data[i].target_vblank.target_frame_cnt;
+			data->target_vblank_valid = true;
+			break;
+		case TEGRA_DC_EXT_FLIP_USER_DATA_DAMAGE_RECT:
+			if (data->damage_rect_valid) {
+				dev_err(&data->ext->dc->ndev->dev,
+					"only one damage_rect/flip is allowed\n");
+				return -EINVAL;
+			}
+			data->damage_rect = flip_user_data[i].damage_rect;
+			data->damage_rect_valid = true;
+			break;
+		case TEGRA_DC_EXT_FLIP_USER_DATA_TRACE_ID:
+			if (data->trace_id) {
+				dev_err(&data->ext->dc->ndev->dev,
+					"only one trace_id/flip is allowed\n");
+				return -EINVAL;
+			}
+			data->trace_id =
+				flip_user_data[i].trace_id.trace_id;
+			break;
 		default:
 			dev_err(&data->ext->dc->ndev->dev,
 				"Invalid FLIP_USER_DATA_TYPE\n");
@@ -2007,9 +2145,14 @@ static int tegra_dc_ext_flip(struct tegra_dc_ext_user *user,
 
 	flip_id_local = atomic64_inc_return
 			(&user->ext->dc->flip_stats.flips_queued);
+	data->flip_id = flip_id_local;
 	if (flip_id)
 		*flip_id = flip_id_local;
 
+	nvhost_pipeline_trace_frame(data->trace_id,
+			NVHOST_PIPELINE_STAGE_FLIP_QUEUED, 0,
+			(u32)flip_id_local);
+
 	/* Insert the flip in the flip queue if CRC is enabled */
 	if (atomic_read(&ext->dc->crc_ref_cnt.global)) {
 		struct tegra_dc_flip_buf_ele flip_buf_ele;
@@ -2855,6 +2998,47 @@ static int tegra_dc_copy_flip_id_to_user(struct tegra_dc_ext_flip_4 *args,
 	return 0;
 }
 
+/* Wait budget for TEGRA_DC_EXT_GET_PRESENT_TIME, generous enough to span
+ * several frames at the lowest VRR refresh rate */
+#define TEGRA_DC_EXT_PRESENT_WAIT_MS	500
+
+static int tegra_dc_ext_get_present_time(struct tegra_dc_ext *ext,
+					 struct tegra_dc_ext_present_time *args)
+{
+	int i;
+	long ret;
+
+	if (args->reserved[0] || args->reserved[1] || args->reserved[2])
+		return -EINVAL;
+
+	if (!args->flip_id || (args->flip_id >
+		(u64)atomic64_read(&ext->dc->flip_stats.flips_queued)))
+		return -EINVAL;
+
+	ret = wait_event_interruptible_timeout(ext->present_hist.wq,
+		ext->present_hist.last_flip_id >= args->flip_id,
+		msecs_to_jiffies(TEGRA_DC_EXT_PRESENT_WAIT_MS));
+	if (ret == 0)
+		return -ETIME;
+	if (ret < 0)
+		return ret;
+
+	mutex_lock(&ext->present_hist.lock);
+	for (i = 0; i < TEGRA_DC_EXT_PRESENT_HIST_SZ; i++) {
+		if (ext->present_hist.flip_id[i] == args->flip_id) {
+			args->timestamp_ns = ext->present_hist.timestamp_ns[i];
+			args->frame_cnt = ext->present_hist.frame_cnt[i];
+			mutex_unlock(&ext->present_hist.lock);
+			return 0;
+		}
+	}
+	mutex_unlock(&ext->present_hist.lock);
+
+	/* A newer flip presented but this one never did (skipped), or its
+	 * slot has already been recycled */
+	return -ENODATA;
+}
+
 static long tegra_dc_ioctl(struct file *filp, unsigned int cmd,
 			   unsigned long arg)
 {
@@ -3632,11 +3816,45 @@ free_and_ret:
 		return ret;
 	}
 
+	case TEGRA_DC_EXT_CRC_RING_SETUP:
+	{
+		struct tegra_dc_ext_crc_ring_setup args;
+
+		if (copy_from_user(&args, user_arg, sizeof(args)))
+			return -EFAULT;
+
+		return tegra_dc_crc_ring_setup(user->ext->dc, &args);
+	}
+
+	case TEGRA_DC_EXT_GET_PRESENT_TIME:
+	{
+		struct tegra_dc_ext_present_time args;
+
+		if (copy_from_user(&args, user_arg, sizeof(args)))
+			return -EFAULT;
+
+		ret = tegra_dc_ext_get_present_time(user->ext, &args);
+		if (ret)
+			return ret;
+
+		if (copy_to_user(user_arg, &args, sizeof(args)))
+			return -EFAULT;
+
+		return 0;
+	}
+
 	default:
 		return -EINVAL;
 	}
 }
 
+static int tegra_dc_mmap(struct file *filp, struct vm_area_struct *vma)
+{
+	struct tegra_dc_ext_user *user = filp->private_data;
+
+	return tegra_dc_crc_ring_mmap(user->ext->dc, vma);
+}
+
 static int tegra_dc_open(struct inode *inode, struct file *filp)
 {
 	struct tegra_dc_ext_user *user;
@@ -3761,6 +3979,7 @@ static const struct file_operations tegra_dc_devops = {
 	.owner =		THIS_MODULE,
 	.open =			tegra_dc_open,
 	.release =		tegra_dc_release,
+	.mmap =			tegra_dc_mmap,
 	.unlocked_ioctl =	tegra_dc_ioctl,
 #ifdef CONFIG_COMPAT
 	.compat_ioctl =		tegra_dc_ioctl,
@@ -3780,6 +3999,9 @@ struct tegra_dc_ext *tegra_dc_ext_register(struct platform_device *ndev,
 	if (!ext)
 		return ERR_PTR(-ENOMEM);
 
+	mutex_init(&ext->present_hist.lock);
+	init_waitqueue_head(&ext->present_hist.wq);
+
 	BUG_ON(!tegra_dc_ext_devno);
 	devno = tegra_dc_ext_devno + head_count + 1;
 
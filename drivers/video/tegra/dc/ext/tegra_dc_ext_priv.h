@@ -73,6 +73,10 @@ struct tegra_dc_ext_win {
 	bool			enabled;
 };
 
+/* Number of presented flips remembered per head for
+ * TEGRA_DC_EXT_GET_PRESENT_TIME lookups */
+#define TEGRA_DC_EXT_PRESENT_HIST_SZ	16
+
 struct tegra_dc_ext {
 	struct tegra_dc			*dc;
 
@@ -98,6 +102,18 @@ struct tegra_dc_ext {
 	/* scanline work */
 	struct kthread_worker	scanline_worker;
 	struct task_struct	*scanline_task;
+
+	/* ring of recently presented flips and the frame end timestamps
+	 * they latched on, consumed by TEGRA_DC_EXT_GET_PRESENT_TIME */
+	struct {
+		u64			flip_id[TEGRA_DC_EXT_PRESENT_HIST_SZ];
+		s64			timestamp_ns[TEGRA_DC_EXT_PRESENT_HIST_SZ];
+		u32			frame_cnt[TEGRA_DC_EXT_PRESENT_HIST_SZ];
+		u32			next;
+		u64			last_flip_id;
+		struct mutex		lock;
+		wait_queue_head_t	wq;
+	} present_hist;
 };
 
 #define TEGRA_DC_EXT_EVENT_MASK_ALL		\
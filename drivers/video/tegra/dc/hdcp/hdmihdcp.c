@@ -1090,6 +1090,13 @@ static int nvhdcp_ake_no_stored_km_send(struct tegra_nvhdcp *nvhdcp, u8 *buf)
 	return e;
 }
 
+static int nvhdcp_ake_stored_km_send(struct tegra_nvhdcp *nvhdcp, u8 *buf)
+{
+	int e;
+	e = nvhdcp_i2c_write(nvhdcp, 0x60, SIZE_AKE_STORED_KM, buf);
+	return e;
+}
+
 static int nvhdcp_ake_hprime_receive(struct tegra_nvhdcp *nvhdcp, u8 *buf)
 {
 	int e;
@@ -1213,6 +1220,68 @@ static int nvhdcp_poll_ready(struct tegra_nvhdcp *nvhdcp, int timeout)
 }
 
 
+/* HDCP 2.2 stored-Km session cache.
+ *
+ * A successful pairing leaves behind the TSEC-sealed EPair blob along with
+ * Ekh(km) and m from the receiver. Caching these per receiver id lets a
+ * display re-enable skip key exchange and pairing entirely: km is restored
+ * inside TSEC from EPair and the receiver is re-authenticated with the
+ * abbreviated AKE_Stored_Km exchange.
+ */
+#define HDCP_RCVR_ID_SIZE		5
+#define NVHDCP_SESSION_CACHE_SIZE	4
+
+struct nvhdcp_session_cache_entry {
+	bool	valid;
+	u8	rcvr_id[HDCP_RCVR_ID_SIZE];
+	u8	e_pair[HDCP_SIZE_EPAIR_8];
+	u8	ekhkm[HDCP_SIZE_EKH_KM_8];
+	u8	m[HDCP_SIZE_M_8];
+};
+
+static struct nvhdcp_session_cache_entry *nvhdcp_session_cache_find(
+				struct tegra_nvhdcp *nvhdcp, const u8 *rcvr_id)
+{
+	unsigned int i;
+
+	if (!nvhdcp->session_cache)
+		return NULL;
+
+	for (i = 0; i < NVHDCP_SESSION_CACHE_SIZE; i++) {
+		if (nvhdcp->session_cache[i].valid &&
+			!memcmp(nvhdcp->session_cache[i].rcvr_id, rcvr_id,
+				HDCP_RCVR_ID_SIZE))
+			return &nvhdcp->session_cache[i];
+	}
+
+	return NULL;
+}
+
+static void nvhdcp_session_cache_store(struct tegra_nvhdcp *nvhdcp,
+				struct hdcp_context_t *hdcp_context)
+{
+	struct nvhdcp_session_cache_entry *entry;
+
+	/* receiver id is the leading bytes of the receiver certificate */
+	entry = nvhdcp_session_cache_find(nvhdcp,
+			hdcp_context->msg.cert_rx);
+	if (!entry) {
+		if (!nvhdcp->session_cache)
+			return;
+		entry = &nvhdcp->session_cache[nvhdcp->session_cache_next];
+		nvhdcp->session_cache_next = (nvhdcp->session_cache_next + 1) %
+			NVHDCP_SESSION_CACHE_SIZE;
+	}
+
+	memcpy(entry->rcvr_id, hdcp_context->msg.cert_rx, HDCP_RCVR_ID_SIZE);
+	memcpy(entry->e_pair, hdcp_context->e_pair, HDCP_SIZE_EPAIR_8);
+	memcpy(entry->ekhkm, hdcp_context->msg.ekhkm, HDCP_SIZE_EKH_KM_8);
+	/* m = rtx || rrx of the pairing session */
+	memcpy(entry->m, &hdcp_context->msg.rtx, sizeof(u64));
+	memcpy(entry->m + sizeof(u64), &hdcp_context->msg.rrx, sizeof(u64));
+	entry->valid = true;
+}
+
 static int tsec_hdcp_authentication(struct tegra_nvhdcp *nvhdcp,
 				struct hdcp_context_t *hdcp_context)
 {
@@ -1223,6 +1292,8 @@ static int tsec_hdcp_authentication(struct tegra_nvhdcp *nvhdcp,
 	uint64_t *pkt = NULL;
 	unsigned char nonce[HDCP_NONCE_SIZE];
 	int cert_retry_count;
+	struct nvhdcp_session_cache_entry *cache = NULL;
+	int use_stored_km = 0;
 
 	pkt = kzalloc(PKT_SIZE, GFP_KERNEL);
 
@@ -1313,14 +1384,40 @@ static int tsec_hdcp_authentication(struct tegra_nvhdcp *nvhdcp,
 	err =  tsec_hdcp_update_rrx(hdcp_context);
 	if (err)
 		goto exit;
-	err =  tsec_hdcp_generate_ekm(hdcp_context);
-	if (err)
-		goto exit;
-	hdcp_context->msg.ake_no_stored_km_msg_id = ID_AKE_NO_STORED_KM;
-	err = nvhdcp_ake_no_stored_km_send(nvhdcp,
-		&hdcp_context->msg.ake_no_stored_km_msg_id);
-	if (err)
-		goto exit;
+	cache = nvhdcp_session_cache_find(nvhdcp, hdcp_context->msg.cert_rx);
+	if (cache) {
+		/* Session resumption: restore km inside TSEC from the sealed
+		 * pairing blob and run the abbreviated AKE_Stored_Km
+		 * exchange instead of a full key exchange and pairing.
+		 */
+		err = tsec_hdcp_decrypt_pairing_info(hdcp_context,
+			cache->e_pair);
+		if (err == 0) {
+			memcpy(hdcp_context->msg.eKhKm, cache->ekhkm,
+				HDCP_SIZE_EKH_KM_8);
+			memcpy(hdcp_context->msg.m, cache->m, HDCP_SIZE_M_8);
+			hdcp_context->msg.ake_stored_km_msg_id =
+				ID_AKE_STORED_KM;
+			err = nvhdcp_ake_stored_km_send(nvhdcp,
+				&hdcp_context->msg.ake_stored_km_msg_id);
+		}
+		if (err) {
+			/* retry authenticates from scratch */
+			nvhdcp_err("stored-Km resume failed, invalidating\n");
+			cache->valid = false;
+			goto exit;
+		}
+		use_stored_km = 1;
+	} else {
+		err =  tsec_hdcp_generate_ekm(hdcp_context);
+		if (err)
+			goto exit;
+		hdcp_context->msg.ake_no_stored_km_msg_id = ID_AKE_NO_STORED_KM;
+		err = nvhdcp_ake_no_stored_km_send(nvhdcp,
+			&hdcp_context->msg.ake_no_stored_km_msg_id);
+		if (err)
+			goto exit;
+	}
 	err =  tsec_hdcp_exchange_info(hdcp_context,
 		HDCP_EXCHANGE_INFO_SET_RCVR_INFO,
 		&hdcp_context->msg.rxcaps_version,
@@ -1344,7 +1441,8 @@ static int tsec_hdcp_authentication(struct tegra_nvhdcp *nvhdcp,
 		TEGRA_NVHDCP_PORT_HDMI, HDCP_22);
 	if (err)
 		goto exit;
-	err = nvhdcp_poll_ready(nvhdcp, 1000);
+	/* H' arrives within 200ms on the stored-Km path, 1s otherwise */
+	err = nvhdcp_poll_ready(nvhdcp, use_stored_km ? 200 : 1000);
 	if (err)
 		goto exit;
 	err = nvhdcp_ake_hprime_receive(nvhdcp,
@@ -1358,25 +1456,31 @@ static int tsec_hdcp_authentication(struct tegra_nvhdcp *nvhdcp,
 		goto exit;
 	}
 	err =  tsec_hdcp_verify_hprime(hdcp_context);
-	if (err)
-		goto exit;
-	err = nvhdcp_poll_ready(nvhdcp, 200);
-	if (err)
-		goto exit;
-	err = nvhdcp_ake_pairing_info_receive(nvhdcp,
-		&hdcp_context->msg.ake_send_pairing_info_msg_id);
-	if (err)
-		goto exit;
-	if (hdcp_context->msg.ake_send_pairing_info_msg_id !=
-	ID_AKE_SEND_PAIRING_INFO) {
-		nvhdcp_err("Not ID_AKE_SEND_PAIRING_INFO but %d instead\n",
-			hdcp_context->msg.ake_send_hprime_msg_id);
-		err = -EINVAL;
+	if (err) {
+		if (use_stored_km && cache)
+			cache->valid = false;
 		goto exit;
 	}
-	err =  tsec_hdcp_encrypt_pairing_info(hdcp_context);
-	if (err)
-		goto exit;
+	if (!use_stored_km) {
+		err = nvhdcp_poll_ready(nvhdcp, 200);
+		if (err)
+			goto exit;
+		err = nvhdcp_ake_pairing_info_receive(nvhdcp,
+			&hdcp_context->msg.ake_send_pairing_info_msg_id);
+		if (err)
+			goto exit;
+		if (hdcp_context->msg.ake_send_pairing_info_msg_id !=
+		ID_AKE_SEND_PAIRING_INFO) {
+			nvhdcp_err("Not ID_AKE_SEND_PAIRING_INFO but %d instead\n",
+				hdcp_context->msg.ake_send_hprime_msg_id);
+			err = -EINVAL;
+			goto exit;
+		}
+		err =  tsec_hdcp_encrypt_pairing_info(hdcp_context);
+		if (err)
+			goto exit;
+		nvhdcp_session_cache_store(nvhdcp, hdcp_context);
+	}
 	err =  tsec_hdcp_generate_lc_init(hdcp_context);
 	if (err)
 		goto exit;
@@ -2492,6 +2596,10 @@ struct tegra_nvhdcp *tegra_nvhdcp_create(struct tegra_hdmi *hdmi,
 	nvhdcp->max_retries = HDCP_INFINITE_RETRIES;
 	atomic_set(&nvhdcp->policy, hdmi->dc->pdata->default_out->hdcp_policy);
 
+	/* best effort: without the cache every authentication is a full AKE */
+	nvhdcp->session_cache = kcalloc(NVHDCP_SESSION_CACHE_SIZE,
+			sizeof(*nvhdcp->session_cache), GFP_KERNEL);
+
 	adapter = i2c_get_adapter(bus);
 	if (!adapter) {
 		nvhdcp_err("can't get adapter for bus %d\n", bus);
@@ -2535,6 +2643,7 @@ free_workqueue:
 	destroy_workqueue(nvhdcp->fallback_wq);
 	i2c_unregister_device(nvhdcp->client);
 free_nvhdcp:
+	kfree(nvhdcp->session_cache);
 	kfree(nvhdcp);
 	nvhdcp_err("unable to create device.\n");
 	return ERR_PTR(e);
@@ -2548,6 +2657,7 @@ void tegra_nvhdcp_destroy(struct tegra_nvhdcp *nvhdcp)
 	destroy_workqueue(nvhdcp->fallback_wq);
 	i2c_unregister_device(nvhdcp->client);
 	nvhdcp_head[nvhdcp->id] = NULL;
+	kfree(nvhdcp->session_cache);
 	kfree(nvhdcp);
 }
 
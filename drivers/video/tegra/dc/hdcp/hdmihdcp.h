@@ -46,6 +46,8 @@ enum tegra_nvhdcp_state {
 	STATE_RENEGOTIATE,
 };
 
+struct nvhdcp_session_cache_entry;
+
 struct tegra_nvhdcp {
 	struct delayed_work		work;
 	struct tegra_hdmi		*hdmi;
@@ -78,6 +80,9 @@ struct tegra_nvhdcp {
 	struct workqueue_struct		*fallback_wq;
 	struct delayed_work		fallback_work;
 	void				*ta_ctx;
+	/* HDCP 2.2 stored-Km session resumption cache, see hdmihdcp.c */
+	struct nvhdcp_session_cache_entry *session_cache;
+	unsigned int			session_cache_next;
 };
 
 #ifdef CONFIG_HDCP
@@ -316,11 +316,54 @@ int tsec_hdcp_encrypt_pairing_info(struct hdcp_context_t *hdcp_context)
 	if (encrypt_pairing_info_param.ret_code) {
 		hdcp_err("tsec_hdcp_encrypt_pairing_info: failed with error %d\n",
 			encrypt_pairing_info_param.ret_code);
+		goto exit;
 	}
+	memcpy(hdcp_context->e_pair,
+		encrypt_pairing_info_param.e_pair,
+		HDCP_SIZE_EPAIR_8);
+exit:
 	err = encrypt_pairing_info_param.ret_code;
 	return err;
 }
 
+int tsec_hdcp_decrypt_pairing_info(struct hdcp_context_t *hdcp_context,
+		u8 *e_pair)
+{
+	int err = 0;
+	struct hdcp_decrypt_pairing_info_param decrypt_pairing_info_param;
+	memset(&decrypt_pairing_info_param, 0,
+			sizeof(struct hdcp_decrypt_pairing_info_param));
+	memset(hdcp_context->cpuvaddr_mthd_buf_aligned, 0,
+		HDCP_MTHD_RPLY_BUF_SIZE);
+	decrypt_pairing_info_param.session_id = hdcp_context->session_id;
+	memcpy(decrypt_pairing_info_param.e_pair,
+		e_pair,
+		HDCP_SIZE_EPAIR_8);
+	memcpy(hdcp_context->cpuvaddr_mthd_buf_aligned,
+		&decrypt_pairing_info_param,
+		sizeof(struct hdcp_decrypt_pairing_info_param));
+	tsec_send_method(hdcp_context,
+		HDCP_DECRYPT_PAIRING_INFO,
+		HDCP_MTHD_FLAGS_SB);
+	memcpy(&decrypt_pairing_info_param,
+		hdcp_context->cpuvaddr_mthd_buf_aligned,
+		sizeof(struct hdcp_decrypt_pairing_info_param));
+	if (decrypt_pairing_info_param.ret_code) {
+		hdcp_err("tsec_hdcp_decrypt_pairing_info: failed with error %d\n",
+			decrypt_pairing_info_param.ret_code);
+		goto exit;
+	}
+	memcpy(hdcp_context->msg.m,
+		decrypt_pairing_info_param.m,
+		HDCP_SIZE_M_8);
+	memcpy(hdcp_context->msg.eKhKm,
+		decrypt_pairing_info_param.ekhkm,
+		HDCP_SIZE_EKH_KM_8);
+exit:
+	err = decrypt_pairing_info_param.ret_code;
+	return err;
+}
+
 int tsec_hdcp_generate_lc_init(struct hdcp_context_t *hdcp_context)
 {
 	int err = 0;
@@ -48,6 +48,8 @@ int tsec_hdcp_verify_cert(struct hdcp_context_t *hdcp_context);
 int tsec_hdcp_generate_ekm(struct hdcp_context_t *hdcp_context);
 int tsec_hdcp_verify_hprime(struct hdcp_context_t *hdcp_context);
 int tsec_hdcp_encrypt_pairing_info(struct hdcp_context_t *hdcp_context);
+int tsec_hdcp_decrypt_pairing_info(struct hdcp_context_t *hdcp_context,
+	u8 *e_pair);
 int tsec_hdcp_generate_lc_init(struct hdcp_context_t *hdcp_context);
 int tsec_hdcp_verify_lprime(struct hdcp_context_t *hdcp_context);
 int tsec_hdcp_ske_init(struct hdcp_context_t *hdcp_context);
@@ -910,8 +910,14 @@ void _tegra_hdmivrr_activate(struct tegra_hdmi *hdmi, bool activate)
 		   */
 		msleep(frametime_ms * 20);
 		dc->mode.v_back_porch = fbmode->upper_margin + 2;
-	} else
+	} else {
+		/* Glide the active timing back to the fixed-rate front
+		 * porch before reprogramming the mode, so leaving VRR
+		 * does not jump Vtotal in a single frame.
+		 */
+		tegra_hdmivrr_ramp_vfp(dc, dc->mode.v_front_porch);
 		dc->mode.v_back_porch = fbmode->upper_margin;
+	}
 
 	_tegra_dc_set_mode(dc, &dc->mode);
 	dc->mode_dirty = true;
@@ -919,6 +925,47 @@ void _tegra_hdmivrr_activate(struct tegra_hdmi *hdmi, bool activate)
 	msleep(frametime_ms * 2);
 }
 
+/*
+ * Glide the active vertical front porch toward @target_vfp one step per
+ * frame instead of jumping there in a single update. Each step is bounded
+ * to vrr->max_inc_pct percent of the current frame length, the same cap
+ * the flip-time logic applies, which the monitor tracks without
+ * re-syncing; content rate switches (e.g. 60Hz <-> 120Hz) therefore do
+ * not produce a visible judder.
+ */
+void tegra_hdmivrr_ramp_vfp(struct tegra_dc *dc, s32 target_vfp)
+{
+	struct tegra_vrr *vrr = dc->out->vrr;
+	int frametime_ms = (int)div64_s64(dc->frametime_ns, NS_IN_MS);
+	s32 lines_per_frame;
+	s32 step;
+	s32 cur;
+
+	if (!vrr || !vrr->capability || !(dc->mode.vmode & FB_VMODE_VRR))
+		return;
+
+	target_vfp = clamp(target_vfp, vrr->v_front_porch_min,
+			   vrr->v_front_porch_max);
+	cur = vrr->vfp ? vrr->vfp : dc->mode.v_front_porch;
+
+	while (cur != target_vfp) {
+		lines_per_frame = vrr->lines_per_frame_common + cur;
+		step = lines_per_frame * vrr->max_inc_pct / 100;
+		if (step < 1)
+			step = 1;
+
+		if (target_vfp > cur)
+			cur = min(cur + step, target_vfp);
+		else
+			cur = max(cur - step, target_vfp);
+
+		tegra_dc_set_act_vfp(dc, cur);
+		msleep(frametime_ms);
+	}
+
+	vrr->vfp = cur;
+}
+
 int tegra_hdmivrr_setup(struct tegra_hdmi *hdmi)
 {
 	int status = 0;
@@ -934,6 +981,13 @@ int tegra_hdmivrr_setup(struct tegra_hdmi *hdmi)
 	if (!(dc->out->vrr_hotplug_state == TEGRA_HPD_STATE_NORMAL))
 		goto exit;
 
+	/* The monitor capability was negotiated on a previous plug and is
+	 * only invalidated by tegra_hdmivrr_disable() on unplug; skip the
+	 * DDC/CI renegotiation for mode toggles in between.
+	 */
+	if (vrr->capability)
+		goto exit;
+
 	status = tegra_hdmivrr_is_vrr_capable(hdmi);
 	if (status)
 		goto fail;
@@ -112,6 +112,7 @@ void tegra_hdmivrr_update_monspecs(struct tegra_dc *dc,
 int tegra_hdmi_vrr_init(struct tegra_hdmi *hdmi);
 int tegra_hdmivrr_te_set_buf(void *addr);
 void _tegra_hdmivrr_activate(struct tegra_hdmi *hdmi, bool activate);
+void tegra_hdmivrr_ramp_vfp(struct tegra_dc *dc, s32 target_vfp);
 #else
 static inline int tegra_hdmivrr_setup(struct tegra_hdmi *hdmi) { return 0; }
 static inline int tegra_hdmivrr_disable(struct tegra_hdmi *hdmi) { return 0; }
@@ -124,6 +125,8 @@ static inline int tegra_hdmivrr_te_set_buf(void *addr)
 static inline void _tegra_hdmivrr_activate(struct tegra_hdmi *hdmi,
 					   bool activate)
 { return; }
+static inline void tegra_hdmivrr_ramp_vfp(struct tegra_dc *dc, s32 target_vfp)
+{ return; }
 #endif
 
 #endif
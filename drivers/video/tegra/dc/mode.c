@@ -517,6 +517,9 @@ int tegra_dc_program_mode(struct tegra_dc *dc, struct tegra_dc_mode *mode)
 
 	tegra_dc_get(dc);
 
+	/* Mode programming invalidates previously programmed window state */
+	dc->shadow_valid_mask = 0;
+
 	if (dc->out_ops && dc->out_ops->modeset_notifier)
 		dc->out_ops->modeset_notifier(dc);
 
@@ -568,6 +571,7 @@ int tegra_dc_program_mode(struct tegra_dc *dc, struct tegra_dc_mode *mode)
 	}
 	tegra_dc_writel(dc, mode->h_active | (v_active << 16),
 			DC_DISP_DISP_ACTIVE);
+	dc->partial_active = false;
 
 	if (mode->vmode == FB_VMODE_INTERLACED)
 		tegra_dc_writel(dc, INTERLACE_MODE_ENABLE |
@@ -667,6 +671,21 @@ int tegra_dc_program_mode(struct tegra_dc *dc, struct tegra_dc_mode *mode)
 	return 0;
 }
 
+/* Narrow (or restore) the scanout size for partial updates on one-shot
+ * panels. Only the active size changes; blanking intervals are short
+ * enough in command mode that they can stay as programmed.
+ */
+void tegra_dc_set_partial_active(struct tegra_dc *dc, u16 width, u16 height)
+{
+	tegra_dc_get(dc);
+	tegra_dc_writel(dc, width | ((u32)height << 16),
+			DC_DISP_DISP_ACTIVE);
+	tegra_dc_put(dc);
+
+	dc->partial_active = (width != dc->mode.h_active ||
+			      height != dc->mode.v_active);
+}
+
 static int panel_sync_rate;
 
 int tegra_dc_get_panel_sync_rate(void)
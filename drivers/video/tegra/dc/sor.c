@@ -1312,6 +1312,9 @@ void tegra_dc_sor_termination_cal(struct tegra_dc_sor_data *sor)
 			NV_SOR_PLL1_TMDS_TERMADJ_DEFAULT_MASK,
 			termadj << NV_SOR_PLL1_TMDS_TERMADJ_SHIFT);
 	}
+
+	sor->term_cal.termadj = termadj;
+	sor->term_cal.valid = true;
 }
 
 static void tegra_dc_sor_config_pwm(struct tegra_dc_sor_data *sor, u32 pwm_div,
@@ -1903,6 +1906,19 @@ void tegra_sor_cal(struct tegra_dc_sor_data *sor)
 	if (!tegra_dc_is_t19x() && sor->dc->out->type == TEGRA_DC_OUT_HDMI)
 		return;
 
+	/* Fastpath for repeated bring-ups: reprogram the termination value
+	 * measured on the first calibration instead of re-running the DPD /
+	 * bandgap power sequence and the binary search, which cost several
+	 * milliseconds of forced sleeps per mode switch
+	 */
+	if (sor->term_cal.valid) {
+		tegra_sor_write_field(sor, nv_sor_pll1_reg,
+			NV_SOR_PLL1_TMDS_TERMADJ_DEFAULT_MASK,
+			sor->term_cal.termadj <<
+				NV_SOR_PLL1_TMDS_TERMADJ_SHIFT);
+		return;
+	}
+
 	tegra_dc_sor_io_set_dpd(sor, true);
 	usleep_range(5, 20);
 
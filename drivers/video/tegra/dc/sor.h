@@ -224,6 +224,16 @@ struct tegra_dc_sor_data {
 		bool valid;
 	} audio;
 	u32 dev_id;
+
+	/* Pad termination measured by tegra_dc_sor_termination_cal(). The
+	 * impedance is a property of the pad brick, not of the attached mode
+	 * or monitor, so once measured it is reapplied on subsequent
+	 * bring-ups without re-running the calibration sequence.
+	 */
+	struct {
+		u32 termadj;
+		bool valid;
+	} term_cal;
 };
 
 #define TEGRA_SOR_TIMEOUT_MS		1000
@@ -426,6 +426,37 @@ struct hdcp_encrypt_pairing_info_param {
 #define HDCP_ENCRYPT_PAIRING_INFO_ERROR_NOT_INIT         HDCP_ERROR_NOT_INIT
 #define HDCP_ENCRYPT_PAIRING_INFO_ERROR_INVALID_KM       (0x00000004)
 #define HDCP_ENCRYPT_PAIRING_INFO_ERROR_INVALID_M        (0x00000005)
+/*
+ * DECRYPT_PAIRING_INFO
+ *
+ * This decrypts EPair using the secret key and restores km into the session,
+ * handing m and Ekh(km) back to the client for the stored-Km (session
+ * resumption) authentication path. The receiver id sealed in EPair must
+ * match the receiver attached to the session.
+ *
+ * Depends on: [SET_SCRATCH_BUFFER]
+ *
+ * INVALID_SESSION  - Session not found
+ * SB_NOT_SET       - Scratch Buffer not set
+ * NOT_INIT         - HDCP app not initialized yet
+ * INVALID_STAGE    - State machine sequence is not followed
+ * INVALID_M        - EPair integrity check or receiver id match failed
+ */
+struct hdcp_decrypt_pairing_info_param {
+	unsigned int  session_id;                         /* <<in */
+	unsigned char   reserved1[4];
+	unsigned long long  e_pair[HDCP_SIZE_EPAIR_64];   /* <<in */
+	unsigned long long  m[HDCP_SIZE_M_64];            /* >>out */
+	unsigned long long  ekhkm[HDCP_SIZE_EKH_KM_64];   /* >>out */
+	unsigned int  ret_code;                           /* >>out */
+	unsigned char   reserved2[4];
+};
+#define HDCP_DECRYPT_PAIRING_INFO_ERROR_NONE             HDCP_ERROR_NONE
+#define HDCP_DECRYPT_PAIRING_INFO_ERROR_INVALID_SESSION\
+	HDCP_ERROR_INVALID_SESSION
+#define HDCP_DECRYPT_PAIRING_INFO_ERROR_SB_NOT_SET       HDCP_ERROR_SB_NOT_SET
+#define HDCP_DECRYPT_PAIRING_INFO_ERROR_NOT_INIT         HDCP_ERROR_NOT_INIT
+#define HDCP_DECRYPT_PAIRING_INFO_ERROR_INVALID_M        (0x00000005)
 /*
  * UPDATE_SESSION
  *
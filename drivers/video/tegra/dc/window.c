@@ -473,6 +473,42 @@ bool  update_is_hsync_safe(struct tegra_dc_win *cur_win,
 		);
 }
 
+/*
+ * An unchanged window needs no reprogramming at all: every shadow register
+ * written for it by the programming loop still holds the same value. Compare
+ * all window state the programming loop consumes; any field not compared
+ * here must keep being programmed unconditionally.
+ */
+static bool update_is_redundant(struct tegra_dc_win *cur_win,
+				struct tegra_dc_win *new_win)
+{
+	return ((cur_win->fmt == new_win->fmt) &&
+		(cur_win->flags == new_win->flags) &&
+		(cur_win->ppflags == new_win->ppflags) &&
+		(cur_win->global_alpha == new_win->global_alpha) &&
+		(cur_win->x.full == new_win->x.full) &&
+		(cur_win->y.full == new_win->y.full) &&
+		(cur_win->w.full == new_win->w.full) &&
+		(cur_win->h.full == new_win->h.full) &&
+		(cur_win->out_x == new_win->out_x) &&
+		(cur_win->out_y == new_win->out_y) &&
+		(cur_win->out_w == new_win->out_w) &&
+		(cur_win->out_h == new_win->out_h) &&
+		(cur_win->z == new_win->z) &&
+		(cur_win->stride == new_win->stride) &&
+		(cur_win->stride_uv == new_win->stride_uv) &&
+		(cur_win->phys_addr == new_win->phys_addr) &&
+		(cur_win->phys_addr_u == new_win->phys_addr_u) &&
+		(cur_win->phys_addr_v == new_win->phys_addr_v) &&
+		(cur_win->phys_addr2 == new_win->phys_addr2) &&
+		(cur_win->phys_addr_u2 == new_win->phys_addr_u2) &&
+		(cur_win->phys_addr_v2 == new_win->phys_addr_v2) &&
+		(cur_win->block_height_log2 == new_win->block_height_log2) &&
+		(cur_win->dc == new_win->dc) &&
+		(!memcmp(&cur_win->cde, &new_win->cde, sizeof(cur_win->cde)))
+		);
+}
+
 void tegra_dc_set_background_color(struct tegra_dc *dc,
 				u32 background_color)
 {
@@ -547,6 +583,7 @@ static int _tegra_dc_program_windows(struct tegra_dc *dc,
 	unsigned long update_mask = GENERAL_ACT_REQ;
 	unsigned long act_control = 0;
 	unsigned long win_options;
+	unsigned long skip_mask = 0;
 	bool update_blend_par = false;
 	bool update_blend_seq = false;
 	int i;
@@ -564,8 +601,18 @@ static int _tegra_dc_program_windows(struct tegra_dc *dc,
 		    !update_is_hsync_safe(&dc->shadow_windows[win->idx], win))
 			wait_for_vblank = 1;
 
+		/* Windows unchanged since the previous flip contribute zero
+		 * programming work: their shadow registers already hold these
+		 * values, so the programming loop below skips them entirely
+		 */
+		if (test_bit(win->idx, &dc->shadow_valid_mask) &&
+		    !tegra_dc_get_window(dc, win->idx)->csc_dirty &&
+		    update_is_redundant(&dc->shadow_windows[win->idx], win))
+			__set_bit(win->idx, &skip_mask);
+
 		memcpy(&dc->shadow_windows[win->idx], win,
 		       sizeof(struct tegra_dc_win));
+		__set_bit(win->idx, &dc->shadow_valid_mask);
 	}
 
 	for (i = 0; i < n; i++) {
@@ -585,6 +632,9 @@ static int _tegra_dc_program_windows(struct tegra_dc *dc,
 		bool filter_v;
 		u32 color = DISP_BLEND_BACKGROUND_COLOR_DEFAULT;
 
+		if (test_bit(win->idx, &skip_mask))
+			continue;
+
 		scan_column = (win->flags & TEGRA_WIN_FLAG_SCAN_COLUMN);
 
 		tegra_dc_writel(dc, WINDOW_A_SELECT << win->idx,
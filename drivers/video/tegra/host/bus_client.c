@@ -34,6 +34,7 @@
 
 #include <trace/events/nvhost.h>
 #include <uapi/linux/nvhost_events.h>
+#include <uapi/linux/nvhost_pipeline_events.h>
 #include <uapi/linux/nvdev_fence.h>
 
 #include <linux/io.h>
@@ -58,6 +59,7 @@
 
 #include "nvhost_syncpt.h"
 #include "nvhost_channel.h"
+#include "nvhost_vm.h"
 #include "nvhost_job.h"
 #include "nvhost_sync.h"
 #include "vhost/vhost.h"
@@ -257,6 +259,10 @@ struct nvhost_channel_userctx {
 	struct dma_buf *error_notifier_ref;
 	u64 error_notifier_offset;
 
+	/* vm group identifier for a shared address space, NULL for
+	 * the default per-process vm */
+	void *vm_group;
+
 	/* lock to protect this structure from concurrent ioctl usage */
 	struct mutex ioctl_lock;
 
@@ -313,6 +319,9 @@ static int nvhost_channelrelease(struct inode *inode, struct file *filp)
 		priv->client_managed_syncpt = 0;
 	}
 
+	/* drop vm group membership */
+	nvhost_vm_group_put(priv->vm_group);
+
 	if (pdata->keepalive)
 		nvhost_module_idle(priv->pdev);
 
@@ -777,6 +786,17 @@ static int nvhost_ioctl_channel_submit(struct nvhost_channel_userctx *ctx,
 	job->num_syncpts = args->num_syncpt_incrs;
 	job->clientid = ctx->clientid;
 	job->client_managed_syncpt = ctx->client_managed_syncpt;
+	job->trace_id = args->trace_id;
+
+	if (args->flags & BIT(NVHOST_SUBMIT_FLAG_PIPELINED)) {
+		if (!pdata->pipelined_submits) {
+			nvhost_err(&pdata->pdev->dev,
+				   "pipelined submits not supported");
+			err = -EINVAL;
+			goto put_job;
+		}
+		job->pipelined = 1;
+	}
 
 	/* copy error notifier settings for this job */
 	if (ctx->error_notifier_ref) {
@@ -813,6 +833,9 @@ static int nvhost_ioctl_channel_submit(struct nvhost_channel_userctx *ctx,
 		job->sp[0].id,
 		job->sp[0].incrs);
 
+	trace_nvhost_job_submit(ctx->pdev->name, job->id,
+		job->sp[0].id, job->sp[0].fence);
+
 	err = nvhost_module_busy(ctx->pdev);
 	if (err)
 		goto put_job;
@@ -842,6 +865,10 @@ static int nvhost_ioctl_channel_submit(struct nvhost_channel_userctx *ctx,
 #endif
 	);
 
+	nvhost_pipeline_trace_frame(job->trace_id,
+			NVHOST_PIPELINE_STAGE_ENGINE_SUBMIT,
+			pdata->class, job->sp[0].fence);
+
 	err = submit_deliver_fences(args, job, ctx);
 	if (err)
 		goto put_job;
@@ -1186,6 +1213,30 @@ put_syncpt:
 	return err;
 }
 
+static int nvhost_ioctl_channel_set_vm_group(
+	struct nvhost_channel_userctx *ctx,
+	struct nvhost_set_vm_group_args *args)
+{
+	void *group = NULL;
+
+	/* The group takes effect when the channel is mapped; a channel
+	 * already mapped through this fd keeps its address space.
+	 */
+	if (ctx->ch)
+		return -EBUSY;
+
+	if (args->token) {
+		group = nvhost_vm_group_get(args->token);
+		if (!group)
+			return -ENOMEM;
+	}
+
+	nvhost_vm_group_put(ctx->vm_group);
+	ctx->vm_group = group;
+
+	return 0;
+}
+
 static long nvhost_channelctl(struct file *filp,
 	unsigned int cmd, unsigned long arg)
 {
@@ -1403,7 +1454,8 @@ static long nvhost_channelctl(struct file *filp,
 		args.fences = args32->fences;
 
 		/* first, get a channel */
-		err = nvhost_channel_map(pdata, &priv->ch, identifier);
+		err = nvhost_channel_map_with_vm(pdata, &priv->ch, identifier,
+						 priv->vm_group);
 		if (err)
 			break;
 		/* Mark the syncpoint attached to the channel */
@@ -1432,7 +1484,8 @@ static long nvhost_channelctl(struct file *filp,
 			identifier = (void *)priv;
 
 		/* first, get a channel */
-		err = nvhost_channel_map(pdata, &priv->ch, identifier);
+		err = nvhost_channel_map_with_vm(pdata, &priv->ch, identifier,
+						 priv->vm_group);
 		if (err)
 			break;
 		/* Mark the syncpoint attached to the channel */
@@ -1476,6 +1529,12 @@ static long nvhost_channelctl(struct file *filp,
 			(struct nvhost_channel_attach_syncpt_args *)buf);
 		break;
 	}
+	case NVHOST_IOCTL_CHANNEL_SET_VM_GROUP:
+	{
+		err = nvhost_ioctl_channel_set_vm_group(priv,
+			(struct nvhost_set_vm_group_args *)buf);
+		break;
+	}
 	default:
 		nvhost_dbg_info("unrecognized ioctl cmd: 0x%x", cmd);
 		err = -ENOTTY;
@@ -1672,7 +1731,10 @@ int nvhost_client_device_init(struct platform_device *dev)
 		pdata->scaling_init(dev);
 
 #ifdef CONFIG_EVENTLIB
-	pdata->eventlib_id = keventlib_register(4 * PAGE_SIZE,
+	/* sharded: task events are logged from submit and interrupt
+	 * paths on any CPU
+	 */
+	pdata->eventlib_id = keventlib_register_sharded(4 * PAGE_SIZE,
 						dev_name(&dev->dev),
 						nvhost_events_json,
 						nvhost_events_json_len);
@@ -1680,6 +1742,13 @@ int nvhost_client_device_init(struct platform_device *dev)
 		nvhost_warn(&dev->dev, "failed to register eventlib (err=%d)",
 			    pdata->eventlib_id);
 		pdata->eventlib_id = 0;
+	} else {
+		/* emit all event types by default; userspace can narrow
+		 * the selection at runtime through debugfs
+		 */
+		pdata->eventlib_mask = ~0ULL;
+		debugfs_create_u64("eventlib_mask", S_IRUGO | S_IWUSR,
+				   pdata->debugfs, &pdata->eventlib_mask);
 	}
 #endif
 
@@ -1864,6 +1933,21 @@ struct nvhost_channel *nvhost_find_chan_by_clientid(
 }
 
 #ifdef CONFIG_EVENTLIB
+void nvhost_eventlib_write(struct platform_device *pdev,
+			   void *data,
+			   size_t size,
+			   u32 type,
+			   u64 timestamp)
+{
+	struct nvhost_device_data *pdata = platform_get_drvdata(pdev);
+
+	if (!pdata->eventlib_id ||
+	    !(pdata->eventlib_mask & (1ULL << type)))
+		return;
+
+	keventlib_write(pdata->eventlib_id, data, size, type, timestamp);
+}
+
 void nvhost_eventlib_log_task(struct platform_device *pdev,
 			      u32 syncpt_id,
 			      u32 syncpt_thresh,
@@ -1884,11 +1968,11 @@ void nvhost_eventlib_log_task(struct platform_device *pdev,
 	task_begin.syncpt_thresh = syncpt_thresh;
 	task_begin.class_id = pdata->class;
 
-	keventlib_write(pdata->eventlib_id,
-			&task_begin,
-			sizeof(task_begin),
-			NVHOST_TASK_BEGIN,
-			timestamp_start);
+	nvhost_eventlib_write(pdev,
+			      &task_begin,
+			      sizeof(task_begin),
+			      NVHOST_TASK_BEGIN,
+			      timestamp_start);
 
 	/*
 	 * Write task end event
@@ -1897,11 +1981,11 @@ void nvhost_eventlib_log_task(struct platform_device *pdev,
 	task_end.syncpt_thresh = syncpt_thresh;
 	task_end.class_id = pdata->class;
 
-	keventlib_write(pdata->eventlib_id,
-			&task_end,
-			sizeof(task_end),
-			NVHOST_TASK_END,
-			timestamp_end);
+	nvhost_eventlib_write(pdev,
+			      &task_end,
+			      sizeof(task_end),
+			      NVHOST_TASK_END,
+			      timestamp_end);
 }
 
 void nvhost_eventlib_log_submit(struct platform_device *pdev,
@@ -1912,7 +1996,8 @@ void nvhost_eventlib_log_submit(struct platform_device *pdev,
 	struct nvhost_device_data *pdata = platform_get_drvdata(pdev);
 	struct nvhost_task_submit task_submit;
 
-	if (!pdata->eventlib_id)
+	if (!pdata->eventlib_id ||
+	    !(pdata->eventlib_mask & (1ULL << NVHOST_TASK_SUBMIT)))
 		return;
 
 	/*
@@ -1924,11 +2009,11 @@ void nvhost_eventlib_log_submit(struct platform_device *pdev,
 	task_submit.pid = current->tgid;
 	task_submit.tid = current->pid;
 
-	keventlib_write(pdata->eventlib_id,
-			&task_submit,
-			sizeof(task_submit),
-			NVHOST_TASK_SUBMIT,
-			timestamp);
+	nvhost_eventlib_write(pdev,
+			      &task_submit,
+			      sizeof(task_submit),
+			      NVHOST_TASK_SUBMIT,
+			      timestamp);
 }
 
 void nvhost_eventlib_log_fences(struct platform_device *pdev,
@@ -1942,7 +2027,8 @@ void nvhost_eventlib_log_fences(struct platform_device *pdev,
 	struct nvhost_device_data *pdata = platform_get_drvdata(pdev);
 	u8 i;
 
-	if (!pdata->eventlib_id)
+	if (!pdata->eventlib_id ||
+	    !(pdata->eventlib_mask & (1ULL << NVHOST_TASK_FENCE)))
 		return;
 
 	for (i = 0; i < num_fences; i++) {
@@ -1980,9 +2066,9 @@ void nvhost_eventlib_log_fences(struct platform_device *pdev,
 			break;
 		}
 
-		keventlib_write(pdata->eventlib_id, &task_fence,
-				sizeof(task_fence), NVHOST_TASK_FENCE,
-				timestamp);
+		nvhost_eventlib_write(pdev, &task_fence,
+				      sizeof(task_fence), NVHOST_TASK_FENCE,
+				      timestamp);
 	}
 }
 
@@ -2012,7 +2098,16 @@ void nvhost_eventlib_log_fences(struct platform_device *pdev,
 {
 }
 
+void nvhost_eventlib_write(struct platform_device *pdev,
+			   void *data,
+			   size_t size,
+			   u32 type,
+			   u64 timestamp)
+{
+}
+
 #endif
 EXPORT_SYMBOL(nvhost_eventlib_log_submit);
 EXPORT_SYMBOL(nvhost_eventlib_log_task);
 EXPORT_SYMBOL(nvhost_eventlib_log_fences);
+EXPORT_SYMBOL(nvhost_eventlib_write);
@@ -609,12 +609,18 @@ static int nvhost_flcn_init_sw(struct platform_device *dev)
 {
 	int err = 0;
 	struct nvhost_device_data *pdata = nvhost_get_devdata(dev);
-	struct flcn *v = get_flcn(dev);
+	struct flcn *v;
 
+	/* serialize the first poweron against the probe-time preload */
+	mutex_lock(&pdata->lock);
+
+	v = get_flcn(dev);
 	nvhost_dbg_fn("in dev:%p v:%p", dev, v);
 
-	if (v)
+	if (v) {
+		mutex_unlock(&pdata->lock);
 		return 0;
+	}
 
 	v = kzalloc(sizeof(*v), GFP_KERNEL);
 	if (!v) {
@@ -630,13 +636,27 @@ static int nvhost_flcn_init_sw(struct platform_device *dev)
 		set_flcn(dev, NULL);
 		goto clean_up;
 	}
+	mutex_unlock(&pdata->lock);
 	return 0;
 
  clean_up:
+	mutex_unlock(&pdata->lock);
 	nvhost_err(&dev->dev, "failed : 0x%x", err);
 	return err;
 }
 
+static void flcn_preload_fw_worker(struct work_struct *work)
+{
+	struct nvhost_device_data *pdata = container_of(work,
+			struct nvhost_device_data, fw_preload_work);
+
+	/* Best effort: if the image cannot be fetched yet, the first
+	 * poweron falls back to the synchronous load. */
+	if (nvhost_flcn_init_sw(pdata->pdev))
+		nvhost_dbg_fn("firmware preload failed for %s",
+			      dev_name(&pdata->pdev->dev));
+}
+
 static int nvhost_flcn_deinit_sw(struct platform_device *dev)
 {
 	struct flcn *v = get_flcn(dev);
@@ -907,6 +927,13 @@ static int flcn_probe(struct platform_device *dev)
 
 	if (pdata->flcn_isr)
 		flcn_intr_init(dev);
+
+	/* fetch and validate the firmware in the background so that the
+	 * first submit does not pay for the filesystem load */
+	INIT_WORK(&pdata->fw_preload_work, flcn_preload_fw_worker);
+	if (pdata->preload_fw)
+		schedule_work(&pdata->fw_preload_work);
+
 #ifdef CONFIG_TEGRA_SOC_HWPM
 	hwpm_ip_index = flcn_hwpm_get_ip_index(dev->name);
 	nvhost_dbg_fn("ip %s register", dev->name);
@@ -925,6 +952,10 @@ static int flcn_probe(struct platform_device *dev)
 
 static int __exit flcn_remove(struct platform_device *pdev)
 {
+	struct nvhost_device_data *pdata = platform_get_drvdata(pdev);
+
+	cancel_work_sync(&pdata->fw_preload_work);
+
 	nvhost_client_device_release(pdev);
 
 	return 0;
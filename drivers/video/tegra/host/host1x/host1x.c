@@ -37,6 +37,7 @@
 #include <linux/anon_inodes.h>
 #include <linux/kref.h>
 #include <linux/nospec.h>
+#include <linux/mm.h>
 
 #include "dev.h"
 #include <trace/events/nvhost.h>
@@ -50,6 +51,7 @@
 #include "nvhost_acm.h"
 #include "nvhost_channel.h"
 #include "nvhost_job.h"
+#include "nvhost_pipeline.h"
 #include "vhost/vhost.h"
 #include "platform.h"
 
@@ -234,6 +236,108 @@ static int nvhost_ioctl_ctrl_syncpt_waitmex(struct nvhost_ctrl_userctx *ctx,
 	return err;
 }
 
+static int nvhost_ctrl_syncpt_do_op(struct nvhost_ctrl_userctx *ctx,
+	struct nvhost_ctrl_syncpt_op *op)
+{
+	struct nvhost_syncpt *sp = &ctx->dev->syncpt;
+	struct nvhost_master *owner;
+	u32 timeout, i;
+	int err;
+
+	switch (op->op) {
+	case NVHOST_SYNCPT_OP_READ:
+		if (!nvhost_syncpt_is_valid_hw_pt_nospec(sp, &op->id))
+			return -EINVAL;
+		op->value = nvhost_syncpt_read(sp, op->id);
+		trace_nvhost_ioctl_ctrl_syncpt_read(op->id, op->value);
+		return 0;
+
+	case NVHOST_SYNCPT_OP_READ_MAX:
+		if (!nvhost_syncpt_is_valid_hw_pt_nospec(sp, &op->id))
+			return -EINVAL;
+		op->value = nvhost_syncpt_read_max(sp, op->id);
+		return 0;
+
+	case NVHOST_SYNCPT_OP_INCR:
+		owner = nvhost_get_syncpt_owner(op->id);
+		if (!owner || !op->arg)
+			return -EINVAL;
+		for (i = 0; i < op->arg; i++) {
+			trace_nvhost_ioctl_ctrl_syncpt_incr(op->id);
+			nvhost_syncpt_incr(&owner->syncpt, op->id);
+		}
+		op->value = nvhost_syncpt_read(&owner->syncpt, op->id);
+		return 0;
+
+	case NVHOST_SYNCPT_OP_WAIT:
+		if (!nvhost_syncpt_is_valid_hw_pt_nospec(sp, &op->id))
+			return -EINVAL;
+		if (op->timeout == NVHOST_NO_TIMEOUT)
+			timeout = (u32)MAX_SCHEDULE_TIMEOUT;
+		else
+			timeout = (u32)msecs_to_jiffies(op->timeout);
+		err = nvhost_syncpt_wait_timeout(sp, op->id, op->arg,
+					timeout, &op->value, NULL, true);
+		trace_nvhost_ioctl_ctrl_syncpt_wait(op->id, op->arg,
+			op->timeout, op->value, err);
+		return err;
+
+	default:
+		return -EINVAL;
+	}
+}
+
+static int nvhost_ioctl_ctrl_syncpt_batch(struct nvhost_ctrl_userctx *ctx,
+	struct nvhost_ctrl_syncpt_batch_args *args)
+{
+	void __user *user_ops = (void __user *)(uintptr_t)args->ops;
+	struct nvhost_ctrl_syncpt_op *ops;
+	u32 i, done = 0;
+	int err = 0;
+
+	if (!args->num_ops || args->num_ops > NVHOST_SYNCPT_BATCH_MAX_OPS)
+		return -EINVAL;
+
+	ops = kmalloc_array(args->num_ops, sizeof(*ops), GFP_KERNEL);
+	if (!ops) {
+		nvhost_err(&ctx->dev->dev->dev,
+			   "failed to allocate op array");
+		return -ENOMEM;
+	}
+
+	if (copy_from_user(ops, user_ops, args->num_ops * sizeof(*ops))) {
+		nvhost_err(&ctx->dev->dev->dev,
+			   "failed to copy from user ops=%px", user_ops);
+		err = -EFAULT;
+		goto free_ops;
+	}
+
+	/*
+	 * Entries are processed in order; the first failing entry stops
+	 * the batch so later waits are not armed against increments that
+	 * never happened. Its errno is kept in the entry itself, the
+	 * ioctl only fails when the batch cannot be transferred.
+	 */
+	for (i = 0; i < args->num_ops; i++) {
+		ops[i].result = nvhost_ctrl_syncpt_do_op(ctx, &ops[i]);
+		if (ops[i].result)
+			break;
+		done++;
+	}
+
+	if (copy_to_user(user_ops, ops, args->num_ops * sizeof(*ops))) {
+		nvhost_err(&ctx->dev->dev->dev, "failed to copy to user");
+		err = -EFAULT;
+		goto free_ops;
+	}
+
+	args->num_done = done;
+
+free_ops:
+	kfree(ops);
+	return err;
+}
+
 static int nvhost_ioctl_ctrl_sync_fence_create(struct nvhost_ctrl_userctx *ctx,
 	struct nvhost_ctrl_sync_fence_create_args *args)
 {
@@ -708,6 +812,12 @@ static long nvhost_ctrlctl(struct file *filp,
 	case NVHOST_IOCTL_CTRL_GET_SYNCPT_DMABUF_FD:
 		err = nvhost_syncpt_dmabuf_alloc(priv->dev, (void *)buf);
 		break;
+	case NVHOST_IOCTL_CTRL_SYNCPT_BATCH:
+		err = nvhost_ioctl_ctrl_syncpt_batch(priv, (void *)buf);
+		break;
+	case NVHOST_IOCTL_CTRL_SYNCPT_DMABUF_BATCH:
+		err = nvhost_syncpt_dmabuf_batch_alloc(priv->dev, (void *)buf);
+		break;
 	default:
 		nvhost_err(&priv->dev->dev->dev, "invalid cmd 0x%x", cmd);
 		err = -ENOIOCTLCMD;
@@ -726,10 +836,45 @@ static long nvhost_ctrlctl(struct file *filp,
 	return err;
 }
 
+/*
+ * Map the syncpoint min value shadow page read-only into userspace.
+ * Userspace can poll fence progress with a plain load instead of the
+ * NVHOST_IOCTL_CTRL_SYNCPT_READ syscall. The shadow is refreshed by the
+ * interrupt/update path, so a value read from it is never newer than the
+ * hardware value.
+ */
+static int nvhost_ctrlmmap(struct file *filp, struct vm_area_struct *vma)
+{
+	struct nvhost_ctrl_userctx *priv = filp->private_data;
+	struct nvhost_syncpt *sp = &priv->dev->syncpt;
+	unsigned long size = vma->vm_end - vma->vm_start;
+
+	if (!sp->shadow_page)
+		return -ENODEV;
+
+	if (vma->vm_pgoff != 0 ||
+	    size > (PAGE_SIZE << sp->shadow_order)) {
+		nvhost_err(&priv->dev->dev->dev,
+			   "invalid shadow page mapping request");
+		return -EINVAL;
+	}
+
+	if (vma->vm_flags & VM_WRITE)
+		return -EPERM;
+
+	vma->vm_flags |= VM_DONTEXPAND | VM_DONTDUMP;
+	vma->vm_flags &= ~VM_MAYWRITE;
+
+	return remap_pfn_range(vma, vma->vm_start,
+			       virt_to_phys(sp->shadow_page) >> PAGE_SHIFT,
+			       size, vma->vm_page_prot);
+}
+
 static const struct file_operations nvhost_ctrlops = {
 	.owner = THIS_MODULE,
 	.release = nvhost_ctrlrelease,
 	.open = nvhost_ctrlopen,
+	.mmap = nvhost_ctrlmmap,
 	.unlocked_ioctl = nvhost_ctrlctl,
 #ifdef CONFIG_COMPAT
 	.compat_ioctl = nvhost_ctrlctl,
@@ -975,6 +1120,8 @@ static void nvhost_free_resources(struct nvhost_master *host)
 {
 	kfree(host->intr.syncpt);
 	host->intr.syncpt = NULL;
+	kfree(host->syncpt_dmabufs);
+	host->syncpt_dmabufs = NULL;
 }
 
 static int nvhost_alloc_resources(struct nvhost_master *host)
@@ -1274,6 +1421,7 @@ static int nvhost_probe(struct platform_device *dev)
 	host->syncpt_backing_head = RB_ROOT;
 	mutex_init(&host->vm_mutex);
 	mutex_init(&host->vm_alloc_mutex);
+	mutex_init(&host->syncpt_dmabuf_mutex);
 	mutex_init(&pdata->lock);
 	init_rwsem(&pdata->busy_lock);
 
@@ -1554,6 +1702,8 @@ static int __init nvhost_mod_init(void)
 	nvhost_domain_init(nvhost_tsec_domain_match);
 #endif
 
+	nvhost_pipeline_init();
+
 	for (i = 0; platform_drivers[i] != NULL; i++) {
 		ret = platform_driver_register(platform_drivers[i]);
 		if (ret)
@@ -1570,6 +1720,8 @@ static void __exit nvhost_mod_exit(void)
 	for (i = 0; platform_drivers[i] != NULL; i++) {
 		platform_driver_unregister(platform_drivers[i]);
 	}
+
+	nvhost_pipeline_exit();
 }
 
 /* host1x master device needs nvmap to be instantiated first.
@@ -116,6 +116,8 @@ struct nvhost_master {
 	struct mutex timeout_mutex;
 
 	struct nvhost_channel **chlist;	/* channel list */
+	/* shared watchdog scanning all channels for CDMA timeouts */
+	struct delayed_work cdma_watchdog;
 	struct mutex chlist_mutex;	/* mutex for channel list */
 	struct mutex ch_alloc_mutex;	/* mutex for channel allocation */
 	struct semaphore free_channels; /* Semaphore tracking free channels */
@@ -130,6 +132,12 @@ struct nvhost_master {
 	struct list_head list;
 
 	struct rb_root syncpt_backing_head;
+
+	/* cache of exported syncpoint dmabufs, indexed by syncpt id.
+	 * Entries are weak; nvhost_syncpt_dmabuf.c clears them on release.
+	 */
+	struct dma_buf **syncpt_dmabufs;
+	struct mutex syncpt_dmabuf_mutex;
 };
 
 #ifdef CONFIG_DEBUG_FS
@@ -36,8 +36,6 @@ static inline u32 host1x_channel_dmactrl(int stop, int get_rst, int init_get)
 		| host1x_channel_dmactrl_dmainitget_f(init_get);
 }
 
-static void cdma_timeout_handler(struct work_struct *work);
-
 /*
  * push_buffer
  *
@@ -121,7 +119,6 @@ static int cdma_timeout_init(struct nvhost_cdma *cdma,
 		return -EINVAL;
 	}
 
-	INIT_DELAYED_WORK(&cdma->timeout.wq, cdma_timeout_handler);
 	cdma->timeout.initialized = true;
 
 	return 0;
@@ -132,8 +129,9 @@ static int cdma_timeout_init(struct nvhost_cdma *cdma,
  */
 static void cdma_timeout_destroy(struct nvhost_cdma *cdma)
 {
-	if (cdma->timeout.initialized)
-		cancel_delayed_work(&cdma->timeout.wq);
+	mutex_lock(&cdma->timeout_lock);
+	cdma->timeout.expiry = 0;
+	mutex_unlock(&cdma->timeout_lock);
 	cdma->timeout.initialized = false;
 }
 
@@ -430,8 +428,30 @@ static void cdma_handle_timeout(struct nvhost_cdma *cdma, bool skip_reset)
 	} else {
 		ret = down_write_trylock(&cdma->lock);
 		if (!ret) {
-			schedule_delayed_work(&cdma->timeout.wq,
-					      msecs_to_jiffies(10));
+			nvhost_cdma_arm_timeout(cdma, 10);
+			mutex_unlock(&dev->timeout_mutex);
+			return;
+		}
+	}
+
+	if (!skip_reset) {
+		bool stale;
+
+		/* The watchdog decided on this job without holding
+		 * cdma->lock; if it completed and a new submit re-armed
+		 * the timeout in the meantime, leave the new job to its
+		 * own deadline.
+		 */
+		mutex_lock(&cdma->timeout_lock);
+		stale = (cdma->timeout.clientid !=
+				cdma->timeout.expired_clientid) ||
+			(ktime_compare(cdma->timeout.start_ktime,
+				cdma->timeout.expired_start_ktime) != 0);
+		mutex_unlock(&cdma->timeout_lock);
+		if (stale) {
+			dev_dbg(&dev->dev->dev,
+				"cdma_timeout: job changed, not timing out\n");
+			up_write(&cdma->lock);
 			mutex_unlock(&dev->timeout_mutex);
 			return;
 		}
@@ -442,8 +462,7 @@ static void cdma_handle_timeout(struct nvhost_cdma *cdma, bool skip_reset)
 		dev_dbg(&dev->dev->dev,
 			"cdma_timeout: timeout handler rescheduled\n");
 		cdma->timeout.allow_dependency = false;
-		schedule_delayed_work(&cdma->timeout.wq,
-				      msecs_to_jiffies(cdma->timeout.timeout));
+		nvhost_cdma_arm_timeout(cdma, cdma->timeout.timeout);
 		up_write(&cdma->lock);
 		mutex_unlock(&dev->timeout_mutex);
 		return;
@@ -511,20 +530,6 @@ static void cdma_handle_timeout(struct nvhost_cdma *cdma, bool skip_reset)
 	mutex_unlock(&dev->timeout_mutex);
 }
 
-/**
- * If this timeout fires, it indicates the current sync_queue entry has
- * exceeded its TTL and the userctx should be timed out and remaining
- * submits already issued cleaned up (future submits return an error).
- */
-static void cdma_timeout_handler(struct work_struct *work)
-{
-	struct nvhost_cdma *cdma;
-
-	cdma = container_of(to_delayed_work(work), struct nvhost_cdma,
-			    timeout.wq);
-	cdma_op().handle_timeout(cdma, false);
-}
-
 static const struct nvhost_cdma_ops host1x_cdma_ops = {
 	.start = cdma_start,
 	.stop = cdma_stop,
@@ -113,6 +113,11 @@ static void serialize(struct nvhost_job *job)
 	if (!job->serialize && !pdata->serialize)
 		return;
 
+	/* a pipelined job carries its dependencies as explicit waits, so
+	 * the engine may start on it while earlier jobs still run */
+	if (job->pipelined)
+		return;
+
 	for (i = 0; i < job->num_syncpts; ++i)
 		push_wait(&ch->cdma, job->sp[i].id,
 			  nvhost_syncpt_read_max(sp, job->sp[i].id));
@@ -67,6 +67,11 @@ static void serialize(struct nvhost_job *job)
 	if (!job->serialize && !pdata->serialize)
 		return;
 
+	/* a pipelined job carries its dependencies as explicit waits, so
+	 * the engine may start on it while earlier jobs still run */
+	if (job->pipelined)
+		return;
+
 	/*
 	 * Force serialization by inserting a host wait for the
 	 * previous job to finish before this one can commence.
@@ -32,6 +32,7 @@
 
 #include "dla_channel.h"
 #include "dla_queue.h"
+#include "dla_os_interface.h"
 #include "nvdla_debug.h"
 
 #define CMDBUF_SIZE	4096
@@ -637,14 +638,19 @@ void nvdla_queue_free_task_memory(struct nvdla_queue *queue, int index)
 	struct nvdla_queue_task_pool *task_pool =
 			(struct nvdla_queue_task_pool *)queue->task_pool;
 
-	/* clear task kernel and dma virtual memory contents*/
+	/* clear task kernel memory contents and the descriptor header.
+	 * The action lists, address list and notification area that
+	 * follow the header are length-prefixed and rewritten in full on
+	 * the next submit, so clearing them here would only add uncached
+	 * memory traffic for every recycled slot.
+	 */
 	hw_offset = index * queue->task_dma_size;
 	sw_offset = index * queue->task_kmem_size;
 	task_kmem = (u8 *)task_pool->kmem_addr + sw_offset;
 	task_dma_va = (u8 *)task_pool->va + hw_offset;
 
 	memset(task_kmem, 0, queue->task_kmem_size);
-	memset(task_dma_va, 0, queue->task_dma_size);
+	memset(task_dma_va, 0, sizeof(struct dla_task_descriptor));
 
 	mutex_lock(&task_pool->lock);
 	clear_bit(index, &task_pool->alloc_table);
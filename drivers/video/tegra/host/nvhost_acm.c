@@ -39,6 +39,9 @@
 #include <linux/clk-provider.h>
 #include <linux/iommu.h>
 #include <linux/nospec.h>
+#include <linux/log2.h>
+#include <linux/math64.h>
+#include <linux/ktime.h>
 
 #include <linux/platform/tegra/mc.h>
 #include <linux/platform/tegra/mc_utils.h>
@@ -49,6 +52,7 @@
 #if IS_ENABLED(CONFIG_TEGRA_BWMGR)
 #include <linux/platform/tegra/emc_bwmgr.h>
 #endif
+#include <linux/platform/tegra/actmon_common.h>
 
 #include "vhost/vhost.h"
 #include "nvhost_acm.h"
@@ -61,9 +65,20 @@
 #include "chip_support.h"
 
 #define ACM_SUSPEND_WAIT_FOR_IDLE_TIMEOUT	(2 * HZ)
+/* How long an expected-bandwidth hint posted on engine wake stays valid */
+#define ACTMON_HINT_VALID_MS			100
 #define POWERGATE_DELAY 			10
 #define MAX_DEVID_LENGTH			32
 
+/* Adaptive autosuspend: recompute the delay after this many idle gap
+ * samples, targeting the given percentile of the gap distribution,
+ * clamped to a sane range
+ */
+#define ACM_AS_GAP_RECALC_SAMPLES		64
+#define ACM_AS_GAP_PERCENTILE			95
+#define ACM_AS_DELAY_MIN_MS			5
+#define ACM_AS_DELAY_MAX_MS			5000
+
 static void nvhost_module_load_regs(struct platform_device *pdev, bool prod);
 static void nvhost_module_set_actmon_regs(struct platform_device *pdev);
 
@@ -333,6 +348,63 @@ void nvhost_module_busy_noresume(struct platform_device *dev)
 	pm_runtime_get_noresume(&dev->dev);
 }
 
+/* Record the gap between the engine going idle and this job and, every
+ * ACM_AS_GAP_RECALC_SAMPLES samples, move autosuspend_delay to the
+ * ACM_AS_GAP_PERCENTILE'th percentile of the gap distribution. A delay
+ * covering most gaps avoids paying ungate latency on every burst, while
+ * genuinely long idles still suspend and return thermal headroom.
+ */
+static void nvhost_module_update_autosuspend(struct platform_device *dev)
+{
+	struct nvhost_device_data *pdata = platform_get_drvdata(dev);
+	unsigned long flags;
+	u64 gap_ms;
+	u32 covered = 0, target;
+	int bucket, i, new_delay = 0;
+
+	spin_lock_irqsave(&pdata->as_gap_lock, flags);
+
+	/* no idle transition seen since the last job */
+	if (!pdata->as_idle_ts_ns) {
+		spin_unlock_irqrestore(&pdata->as_gap_lock, flags);
+		return;
+	}
+
+	gap_ms = div_u64(ktime_get_ns() - pdata->as_idle_ts_ns, NSEC_PER_MSEC);
+	pdata->as_idle_ts_ns = 0;
+
+	/* bucket i holds gaps in [2^(i-1), 2^i) ms, bucket 0 is < 1 ms */
+	bucket = gap_ms ? min((int)ilog2(gap_ms) + 1,
+			      NVHOST_MODULE_AS_GAP_BUCKETS - 1) : 0;
+	pdata->as_gap_hist[bucket]++;
+
+	if (++pdata->as_gap_samples < ACM_AS_GAP_RECALC_SAMPLES) {
+		spin_unlock_irqrestore(&pdata->as_gap_lock, flags);
+		return;
+	}
+
+	target = pdata->as_gap_samples * ACM_AS_GAP_PERCENTILE / 100;
+	for (i = 0; i < NVHOST_MODULE_AS_GAP_BUCKETS; i++) {
+		covered += pdata->as_gap_hist[i];
+		if (covered >= target && !new_delay)
+			new_delay = 1 << i;
+		/* age the histogram so the policy tracks workload changes */
+		pdata->as_gap_hist[i] >>= 1;
+	}
+	pdata->as_gap_samples >>= 1;
+	spin_unlock_irqrestore(&pdata->as_gap_lock, flags);
+
+	new_delay = clamp(new_delay, ACM_AS_DELAY_MIN_MS, ACM_AS_DELAY_MAX_MS);
+	if (new_delay == pdata->autosuspend_delay)
+		return;
+
+	mutex_lock(&pdata->lock);
+	pdata->autosuspend_delay = new_delay;
+	mutex_unlock(&pdata->lock);
+
+	pm_runtime_set_autosuspend_delay(&dev->dev, new_delay);
+}
+
 int nvhost_module_busy(struct platform_device *dev)
 {
 	struct nvhost_device_data *pdata = platform_get_drvdata(dev);
@@ -369,11 +441,22 @@ int nvhost_module_busy(struct platform_device *dev)
 		return ret;
 	}
 
+	/* A submission that had to power the engine up means a memory burst
+	 * is about to land that the activity monitors have not seen yet, so
+	 * let opted-in devices pre-ramp the memory frequency
+	 */
+	if (ret == 0 && pdata->actmon_hint_khz)
+		tegra_actmon_hint(MC_ALL, pdata->actmon_hint_khz,
+				  ACTMON_HINT_VALID_MS);
+
 	if (pdata->busy)
 		pdata->busy(dev);
 
 	up_read(&pdata->busy_lock);
 
+	if (pdata->autosuspend_adaptive && pdata->autosuspend_delay)
+		nvhost_module_update_autosuspend(dev);
+
 	return 0;
 }
 EXPORT_SYMBOL(nvhost_module_busy);
@@ -394,6 +477,14 @@ void nvhost_module_idle_mult(struct platform_device *dev, int refs)
 	    pm_runtime_active(&dev->dev)) {
 		if (pdata->idle)
 			pdata->idle(dev);
+
+		if (pdata->autosuspend_adaptive) {
+			unsigned long flags;
+
+			spin_lock_irqsave(&pdata->as_gap_lock, flags);
+			pdata->as_idle_ts_ns = ktime_get_ns();
+			spin_unlock_irqrestore(&pdata->as_gap_lock, flags);
+		}
 	}
 
 	while (refs--) {
@@ -733,6 +824,8 @@ static ssize_t autosuspend_delay_store(struct kobject *kobj,
 	if (ret == 1 && autosuspend_delay >= 0) {
 		mutex_lock(&pdata->lock);
 		pdata->autosuspend_delay = autosuspend_delay;
+		/* a manual setting overrides the adaptive policy */
+		pdata->autosuspend_adaptive = false;
 		mutex_unlock(&pdata->lock);
 
 		pm_runtime_set_autosuspend_delay(&dev->dev,
@@ -761,6 +854,47 @@ static ssize_t autosuspend_delay_show(struct kobject *kobj,
 	return ret;
 }
 
+static ssize_t autosuspend_adaptive_store(struct kobject *kobj,
+	struct kobj_attribute *attr, const char *buf, size_t count)
+{
+	int enable = 0, ret = 0;
+	unsigned long flags;
+	struct nvhost_device_power_attr *power_attribute =
+		container_of(attr, struct nvhost_device_power_attr, \
+			power_attr[NVHOST_POWER_SYSFS_ATTRIB_AUTOSUSPEND_ADAPTIVE]);
+	struct platform_device *dev = power_attribute->ndev;
+	struct nvhost_device_data *pdata = platform_get_drvdata(dev);
+
+	ret = sscanf(buf, "%d", &enable);
+	if (ret != 1)
+		return -EINVAL;
+
+	/* start the policy from a clean distribution */
+	spin_lock_irqsave(&pdata->as_gap_lock, flags);
+	memset(pdata->as_gap_hist, 0, sizeof(pdata->as_gap_hist));
+	pdata->as_gap_samples = 0;
+	pdata->as_idle_ts_ns = 0;
+	spin_unlock_irqrestore(&pdata->as_gap_lock, flags);
+
+	mutex_lock(&pdata->lock);
+	pdata->autosuspend_adaptive = enable ? true : false;
+	mutex_unlock(&pdata->lock);
+
+	return count;
+}
+
+static ssize_t autosuspend_adaptive_show(struct kobject *kobj,
+	struct kobj_attribute *attr, char *buf)
+{
+	struct nvhost_device_power_attr *power_attribute =
+		container_of(attr, struct nvhost_device_power_attr, \
+			power_attr[NVHOST_POWER_SYSFS_ATTRIB_AUTOSUSPEND_ADAPTIVE]);
+	struct platform_device *dev = power_attribute->ndev;
+	struct nvhost_device_data *pdata = platform_get_drvdata(dev);
+
+	return snprintf(buf, PAGE_SIZE, "%d\n", pdata->autosuspend_adaptive);
+}
+
 static ssize_t clk_cap_store(struct kobject *kobj,
 	struct kobj_attribute *attr, const char *buf, size_t count)
 {
@@ -873,6 +1007,7 @@ int nvhost_module_init(struct platform_device *dev)
 	INIT_LIST_HEAD(&pdata->client_list);
 
 	init_rwsem(&pdata->busy_lock);
+	spin_lock_init(&pdata->as_gap_lock);
 
 	if (nvhost_dev_is_virtual(dev)) {
 		pm_runtime_enable(&dev->dev);
@@ -1031,6 +1166,18 @@ int nvhost_module_init(struct platform_device *dev)
 		goto fail_forceon;
 	}
 
+	attr = &pdata->power_attrib->power_attr[NVHOST_POWER_SYSFS_ATTRIB_AUTOSUSPEND_ADAPTIVE];
+	attr->attr.name = "autosuspend_adaptive";
+	attr->attr.mode = S_IWUSR | S_IRUGO;
+	attr->show = autosuspend_adaptive_show;
+	attr->store = autosuspend_adaptive_store;
+	sysfs_attr_init(&attr->attr);
+	if (sysfs_create_file(pdata->power_kobj, &attr->attr)) {
+		dev_err(&dev->dev, "Could not create sysfs attribute autosuspend_adaptive\n");
+		err = -EIO;
+		goto fail_autosuspendadaptive;
+	}
+
 	err = device_create_file(&dev->dev, &dev_attr_force_idle);
 	if (err) {
 		dev_err(&dev->dev, "Couldn't create device file force_idle\n");
@@ -1083,6 +1230,10 @@ fail_clk_cap:
 	device_remove_file(&dev->dev, &dev_attr_force_idle);
 
 fail_force_idle:
+	attr = &pdata->power_attrib->power_attr[NVHOST_POWER_SYSFS_ATTRIB_AUTOSUSPEND_ADAPTIVE];
+	sysfs_remove_file(pdata->power_kobj, &attr->attr);
+
+fail_autosuspendadaptive:
 	attr = &pdata->power_attrib->power_attr[NVHOST_POWER_SYSFS_ATTRIB_FORCE_ON];
 	sysfs_remove_file(pdata->power_kobj, &attr->attr);
 
@@ -26,6 +26,13 @@
 #include "dev.h"
 #include "nvhost_buffer.h"
 
+/*
+ * Number of unreferenced mappings kept around for reuse. Task graphs
+ * tend to resubmit the same buffers, and keeping the mapping alive
+ * saves the attach and iommu map cost on every recurrence.
+ */
+#define NVHOST_BUFFER_LRU_MAX	32
+
 /**
  * nvhost_vm_buffer - Virtual mapping information for a buffer
  *
@@ -38,6 +45,7 @@
  * @submit_map_count:	Buffer reference count from task submit
  * @rb_node:		pinned buffer node
  * @list_head:		List entry
+ * @lru_entry:		Entry in the lru list while unreferenced
  *
  */
 struct nvhost_vm_buffer {
@@ -54,6 +62,7 @@ struct nvhost_vm_buffer {
 
 	struct rb_node rb_node;
 	struct list_head list_head;
+	struct list_head lru_entry;
 };
 
 static struct nvhost_vm_buffer *nvhost_find_map_buffer(
@@ -116,7 +125,7 @@ int nvhost_get_iova_addr(struct nvhost_buffers *nvhost_buffers,
 	mutex_lock(&nvhost_buffers->mutex);
 
 	vm = nvhost_find_map_buffer(nvhost_buffers, dmabuf);
-	if (vm) {
+	if (vm && list_empty(&vm->lru_entry)) {
 		*addr = vm->addr;
 		err = 0;
 	}
@@ -177,6 +186,7 @@ static int nvhost_buffer_map(struct platform_device *pdev,
 	vm->size = dmabuf->size;
 	vm->addr = dma_addr;
 	vm->user_map_count = 1;
+	INIT_LIST_HEAD(&vm->lru_entry);
 
 	return err;
 
@@ -195,6 +205,30 @@ static void nvhost_free_buffers(struct kref *kref)
 	kfree(nvhost_buffers);
 }
 
+/* Tear down a mapping that is not (or no longer) in the table */
+static void nvhost_buffer_unmap_raw(struct nvhost_vm_buffer *vm)
+{
+	dma_buf_unmap_attachment(vm->attach, vm->sgt, DMA_BIDIRECTIONAL);
+	dma_buf_detach(vm->dmabuf, vm->attach);
+	dma_buf_put(vm->dmabuf);
+}
+
+static void nvhost_buffer_evict(struct nvhost_buffers *nvhost_buffers,
+				struct nvhost_vm_buffer *vm)
+{
+	nvhost_buffer_unmap_raw(vm);
+
+	rb_erase(&vm->rb_node, &nvhost_buffers->rb_root);
+	list_del(&vm->list_head);
+
+	if (!list_empty(&vm->lru_entry)) {
+		list_del(&vm->lru_entry);
+		nvhost_buffers->lru_count--;
+	}
+
+	kfree(vm);
+}
+
 static void nvhost_buffer_unmap(struct nvhost_buffers *nvhost_buffers,
 				struct nvhost_vm_buffer *vm)
 {
@@ -203,14 +237,24 @@ static void nvhost_buffer_unmap(struct nvhost_buffers *nvhost_buffers,
 	if ((vm->user_map_count != 0) || (vm->submit_map_count != 0))
 		return;
 
-	dma_buf_unmap_attachment(vm->attach, vm->sgt, DMA_BIDIRECTIONAL);
-	dma_buf_detach(vm->dmabuf, vm->attach);
-	dma_buf_put(vm->dmabuf);
+	if (!list_empty(&vm->lru_entry))
+		return;
 
-	rb_erase(&vm->rb_node, &nvhost_buffers->rb_root);
-	list_del(&vm->list_head);
+	/*
+	 * Keep the mapping cached instead of tearing it down; a later
+	 * pin of the same dmabuf picks it up without remapping. Oldest
+	 * entries are evicted once the cache is over its limit.
+	 */
+	list_add_tail(&vm->lru_entry, &nvhost_buffers->lru_list);
+	nvhost_buffers->lru_count++;
 
-	kfree(vm);
+	while (nvhost_buffers->lru_count > NVHOST_BUFFER_LRU_MAX) {
+		struct nvhost_vm_buffer *oldest = list_first_entry(
+				&nvhost_buffers->lru_list,
+				struct nvhost_vm_buffer, lru_entry);
+
+		nvhost_buffer_evict(nvhost_buffers, oldest);
+	}
 }
 
 struct nvhost_buffers *nvhost_buffer_init(struct platform_device *pdev)
@@ -228,6 +272,7 @@ struct nvhost_buffers *nvhost_buffer_init(struct platform_device *pdev)
 	mutex_init(&nvhost_buffers->mutex);
 	nvhost_buffers->rb_root = RB_ROOT;
 	INIT_LIST_HEAD(&nvhost_buffers->list_head);
+	INIT_LIST_HEAD(&nvhost_buffers->lru_list);
 	kref_init(&nvhost_buffers->kref);
 
 	return nvhost_buffers;
@@ -250,7 +295,8 @@ int nvhost_buffer_submit_pin(struct nvhost_buffers *nvhost_buffers,
 
 	for (i = 0; i < count; i++) {
 		vm = nvhost_find_map_buffer(nvhost_buffers, dmabufs[i]);
-		if (vm == NULL)
+		/* cached entries need a user pin before they can be used */
+		if (vm == NULL || !list_empty(&vm->lru_entry))
 			goto submit_err;
 
 		vm->submit_map_count++;
@@ -275,49 +321,133 @@ submit_err:
 	return -EINVAL;
 }
 
+/*
+ * Pin a batch of buffers as one mapping transaction. Buffers already
+ * known to the table are referenced under the mutex; the dma-buf
+ * attach and map of the new ones - the expensive part when a camera
+ * stream start pins dozens of buffers at once - runs with the mutex
+ * dropped so it does not serialize against concurrent submit pins,
+ * and the table is updated in a single locked pass at the end.
+ */
 int nvhost_buffer_pin(struct nvhost_buffers *nvhost_buffers,
 			struct dma_buf **dmabufs,
 			u32 count)
 {
-	struct nvhost_vm_buffer *vm;
-	int i = 0;
+	struct nvhost_vm_buffer *vm, **new_vms;
+	u32 i, done;
 	int err = 0;
 
-	mutex_lock(&nvhost_buffers->mutex);
+	new_vms = kcalloc(count, sizeof(*new_vms), GFP_KERNEL);
+	if (!new_vms) {
+		nvhost_err(NULL, "could not allocate vm_buffer batch");
+		return -ENOMEM;
+	}
 
+	/* reference buffers that are already mapped */
+	mutex_lock(&nvhost_buffers->mutex);
 	for (i = 0; i < count; i++) {
 		vm = nvhost_find_map_buffer(nvhost_buffers, dmabufs[i]);
 		if (vm) {
+			if (!list_empty(&vm->lru_entry)) {
+				list_del_init(&vm->lru_entry);
+				nvhost_buffers->lru_count--;
+			}
 			vm->user_map_count++;
 			continue;
 		}
 
-		vm = kzalloc(sizeof(struct nvhost_vm_buffer), GFP_KERNEL);
-		if (!vm) {
+		new_vms[i] = kzalloc(sizeof(struct nvhost_vm_buffer),
+					GFP_KERNEL);
+		if (!new_vms[i]) {
 			nvhost_err(NULL, "could not allocate vm_buffer");
 			err = -ENOMEM;
-			goto unpin;
+			break;
 		}
+	}
+	done = i;
+	mutex_unlock(&nvhost_buffers->mutex);
 
-		err = nvhost_buffer_map(nvhost_buffers->pdev, dmabufs[i], vm);
-		if (err)
-			goto free_vm;
+	if (err)
+		goto rollback;
 
-		nvhost_buffer_insert_map_buffer(nvhost_buffers, vm);
+	/* map the new buffers with the mutex dropped */
+	for (i = 0; i < count; i++) {
+		if (!new_vms[i])
+			continue;
+
+		err = nvhost_buffer_map(nvhost_buffers->pdev, dmabufs[i],
+					new_vms[i]);
+		if (err) {
+			kfree(new_vms[i]);
+			new_vms[i] = NULL;
+			goto rollback;
+		}
 	}
 
+	/* publish the new mappings in one locked pass */
+	mutex_lock(&nvhost_buffers->mutex);
+	for (i = 0; i < count; i++) {
+		if (!new_vms[i])
+			continue;
+
+		vm = nvhost_find_map_buffer(nvhost_buffers, dmabufs[i]);
+		if (vm) {
+			/*
+			 * Mapped concurrently, or listed twice in this
+			 * batch; reference the winning mapping and drop
+			 * ours after unlocking.
+			 */
+			if (!list_empty(&vm->lru_entry)) {
+				list_del_init(&vm->lru_entry);
+				nvhost_buffers->lru_count--;
+			}
+			vm->user_map_count++;
+			continue;
+		}
+
+		nvhost_buffer_insert_map_buffer(nvhost_buffers, new_vms[i]);
+		new_vms[i] = NULL;
+	}
 	mutex_unlock(&nvhost_buffers->mutex);
-	return err;
 
-free_vm:
-	kfree(vm);
-unpin:
+	/* drop duplicates that lost the race */
+	for (i = 0; i < count; i++) {
+		if (new_vms[i]) {
+			nvhost_buffer_unmap_raw(new_vms[i]);
+			kfree(new_vms[i]);
+		}
+	}
+
+	kfree(new_vms);
+	return 0;
+
+rollback:
+	/* undo the references taken in the first pass */
+	mutex_lock(&nvhost_buffers->mutex);
+	for (i = 0; i < done; i++) {
+		if (new_vms[i])
+			continue;
+
+		vm = nvhost_find_map_buffer(nvhost_buffers, dmabufs[i]);
+		if (vm == NULL)
+			continue;
+
+		if (vm->user_map_count-- < 0)
+			vm->user_map_count = 0;
+		nvhost_buffer_unmap(nvhost_buffers, vm);
+	}
 	mutex_unlock(&nvhost_buffers->mutex);
 
-	/* free pinned buffers */
-	count = i;
-	nvhost_buffer_unpin(nvhost_buffers, dmabufs, count);
+	/* tear down mappings that were never published */
+	for (i = 0; i < count; i++) {
+		if (!new_vms[i])
+			continue;
+		if (new_vms[i]->dmabuf)
+			nvhost_buffer_unmap_raw(new_vms[i]);
+		kfree(new_vms[i]);
+	}
 
+	kfree(new_vms);
 	return err;
 }
 
@@ -376,7 +506,8 @@ void nvhost_buffer_release(struct nvhost_buffers *nvhost_buffers)
 	list_for_each_entry_safe(vm, n, &nvhost_buffers->list_head,
 				 list_head) {
 		vm->user_map_count = 0;
-		nvhost_buffer_unmap(nvhost_buffers, vm);
+		if (vm->submit_map_count == 0)
+			nvhost_buffer_evict(nvhost_buffers, vm);
 	}
 	mutex_unlock(&nvhost_buffers->mutex);
 
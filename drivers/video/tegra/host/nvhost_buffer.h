@@ -34,6 +34,8 @@ enum nvhost_buffers_heap {
  * list			List for traversing through all the buffers
  * mutex		Mutex for the buffer tree and the buffer list
  * kref			Reference count for the bufferlist
+ * lru_list		Unreferenced buffers kept mapped for reuse
+ * lru_count		Number of buffers on the lru list
  *
  */
 struct nvhost_buffers {
@@ -44,6 +46,9 @@ struct nvhost_buffers {
 	struct mutex mutex;
 
 	struct kref kref;
+
+	struct list_head lru_list;
+	u32 lru_count;
 };
 
 /**
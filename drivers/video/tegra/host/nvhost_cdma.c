@@ -30,6 +30,7 @@
 #include <linux/slab.h>
 #include <linux/kfifo.h>
 #include <trace/events/nvhost.h>
+#include <uapi/linux/nvhost_pipeline_events.h>
 #include <linux/interrupt.h>
 
 /*
@@ -246,6 +247,70 @@ unsigned int nvhost_cdma_wait_locked(struct nvhost_cdma *cdma,
 	return 0;
 }
 
+/* granularity of the shared timeout watchdog scan */
+#define CDMA_WATCHDOG_PERIOD_MS	100
+
+/**
+ * (Re)arm timeout handling for this channel: record the deadline and make
+ * sure the shared host-level watchdog is ticking. Unlike the old per-channel
+ * delayed work this never cancels or reprograms a timer on the submit path;
+ * completion just clears the deadline and the watchdog disarms itself once
+ * no channel has one pending.
+ * Must be called with cdma->timeout_lock held, or from the timeout handler.
+ */
+void nvhost_cdma_arm_timeout(struct nvhost_cdma *cdma, long ms)
+{
+	struct nvhost_master *dev = cdma_to_dev(cdma);
+
+	cdma->timeout.expiry = jiffies + msecs_to_jiffies(ms);
+	schedule_delayed_work(&dev->cdma_watchdog,
+			msecs_to_jiffies(CDMA_WATCHDOG_PERIOD_MS));
+}
+
+/**
+ * Shared watchdog: scan every channel for an expired deadline and run the
+ * chip timeout handler for stalled ones. Reschedules itself while any
+ * channel still has a deadline pending.
+ */
+void nvhost_cdma_watchdog(struct work_struct *work)
+{
+	struct nvhost_master *host = container_of(to_delayed_work(work),
+			struct nvhost_master, cdma_watchdog);
+	bool rearm = false;
+	int i;
+
+	for (i = 0; i < nvhost_channel_nb_channels(host); i++) {
+		struct nvhost_cdma *cdma = &host->chlist[i]->cdma;
+		bool expired = false;
+
+		mutex_lock(&cdma->timeout_lock);
+		if (cdma->timeout.clientid && cdma->timeout.expiry) {
+			rearm = true;
+			if (time_after_eq(jiffies, cdma->timeout.expiry)) {
+				/* guard against refiring during recovery */
+				cdma->timeout.expiry = jiffies +
+					msecs_to_jiffies(cdma->timeout.timeout);
+				/* record which job expired; the handler
+				 * bails out if a completion re-arms the
+				 * timeout before it gets to run */
+				cdma->timeout.expired_clientid =
+					cdma->timeout.clientid;
+				cdma->timeout.expired_start_ktime =
+					cdma->timeout.start_ktime;
+				expired = true;
+			}
+		}
+		mutex_unlock(&cdma->timeout_lock);
+
+		if (expired)
+			cdma_op().handle_timeout(cdma, false);
+	}
+
+	if (rearm)
+		schedule_delayed_work(&host->cdma_watchdog,
+				msecs_to_jiffies(CDMA_WATCHDOG_PERIOD_MS));
+}
+
 /**
  * Start timer for a buffer submition that has completed yet.
  * Must be called with the cdma lock held.
@@ -274,8 +339,7 @@ static void cdma_start_timer_locked(struct nvhost_cdma *cdma,
 	cdma->timeout.allow_dependency = true;
 
 	if (job->timeout)
-		schedule_delayed_work(&cdma->timeout.wq,
-				msecs_to_jiffies(cdma->timeout.timeout));
+		nvhost_cdma_arm_timeout(cdma, job->timeout);
 	mutex_unlock(&cdma->timeout_lock);
 }
 
@@ -285,13 +349,11 @@ static void cdma_start_timer_locked(struct nvhost_cdma *cdma,
  */
 static void stop_cdma_timer_locked(struct nvhost_cdma *cdma)
 {
-	if (cdma->timeout.initialized) {
-		cancel_delayed_work_sync(&cdma->timeout.wq);
-	}
-
 	mutex_lock(&cdma->timeout_lock);
-	if (cdma->timeout.clientid)
+	if (cdma->timeout.clientid) {
 		cdma->timeout.clientid = 0;
+		cdma->timeout.expiry = 0;
+	}
 	mutex_unlock(&cdma->timeout_lock);
 }
 
@@ -351,6 +413,15 @@ static void update_cdma_locked(struct nvhost_cdma *cdma)
 		list_del(&job->list);
 		mutex_unlock(&cdma->sync_queue_lock);
 
+		trace_nvhost_job_syncpt_reached(cdma_to_channel(cdma)->dev->name,
+			job->id, job->sp ? job->sp->id : 0,
+			job->sp ? job->sp->fence : 0);
+
+		nvhost_pipeline_trace_frame(job->trace_id,
+			NVHOST_PIPELINE_STAGE_ENGINE_COMPLETE,
+			nvhost_get_devdata(cdma_to_channel(cdma)->dev)->class,
+			job->sp ? job->sp->fence : 0);
+
 		/* Cancel timeout, when a buffer completes */
 		stop_cdma_timer_locked(cdma);
 
@@ -650,6 +721,10 @@ void nvhost_cdma_end(struct nvhost_cdma *cdma,
 
 	cdma_op().kick(cdma);
 
+	trace_nvhost_job_kick(job->ch->dev->name, job->id,
+		job->sp ? job->sp->id : 0,
+		job->sp ? job->sp->fence : 0);
+
 	/* start timer on idle -> active transitions */
 	if (was_idle)
 		cdma_start_timer_locked(cdma, job);
@@ -66,10 +66,15 @@ struct push_buffer {
 };
 
 struct buffer_timeout {
-	struct delayed_work wq;		/* work queue */
+	unsigned long expiry;		/* jiffies deadline, watchdog scanned */
 	bool initialized;		/* timer one-time setup flag */
 	struct nvhost_job_syncpt *sp;	/* buffer syncpoint information */
 	ktime_t start_ktime;		/* starting time */
+	/* identity of the job the watchdog found expired, re-verified by
+	 * the timeout handler since a completion plus a new submit can
+	 * re-arm the timeout between the two */
+	int expired_clientid;
+	ktime_t expired_start_ktime;
 	/* context timeout information */
 	int clientid;
 	bool timeout_debug_dump;
@@ -180,4 +185,6 @@ void nvhost_cdma_finalize_job_incrs(struct platform_device *pdev,
 					struct nvhost_job_syncpt *sp);
 void nvhost_cdma_update_sync_queue(struct nvhost_cdma *cdma,
 		struct nvhost_syncpt *syncpt, struct platform_device *dev);
+void nvhost_cdma_arm_timeout(struct nvhost_cdma *cdma, long ms);
+void nvhost_cdma_watchdog(struct work_struct *work);
 #endif
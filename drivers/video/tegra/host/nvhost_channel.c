@@ -23,6 +23,7 @@
 #include "nvhost_acm.h"
 #include "nvhost_job.h"
 #include "nvhost_vm.h"
+#include "nvhost_scale.h"
 #include "chip_support.h"
 #include "vhost/vhost.h"
 
@@ -57,6 +58,8 @@ int nvhost_alloc_channels(struct nvhost_master *host)
 
 	sema_init(&host->free_channels, max_channels);
 
+	INIT_DELAYED_WORK(&host->cdma_watchdog, nvhost_cdma_watchdog);
+
 	for (index = 0; index < max_channels; index++) {
 		ch = kzalloc(sizeof(*ch), GFP_KERNEL);
 		if (!ch) {
@@ -67,6 +70,8 @@ int nvhost_alloc_channels(struct nvhost_master *host)
 		/* initialize data structures */
 		nvhost_set_chanops(ch);
 		mutex_init(&ch->submitlock);
+		mutex_init(&ch->pin_cache_lock);
+		ch->pin_cache = RB_ROOT;
 		ch->chid = nvhost_channel_get_id_from_index(host, index);
 
 		/* initialize channel cdma */
@@ -204,6 +209,9 @@ static void nvhost_channel_unmap_locked(struct kref *ref)
 
 err_module_busy:
 
+	/* release cached buffer translations before the vm goes away */
+	nvhost_job_pin_cache_purge(ch);
+
 	/* drop reference to the vm */
 	nvhost_vm_put(ch->vm);
 
@@ -331,6 +339,8 @@ int nvhost_channel_list_free(struct nvhost_master *host)
 {
 	int i;
 
+	cancel_delayed_work_sync(&host->cdma_watchdog);
+
 	for (i = 0; i < nvhost_channel_nb_channels(host); i++)
 		kfree(host->chlist[i]);
 
@@ -416,6 +426,11 @@ void nvhost_channel_init_gather_filter(struct platform_device *pdev,
 
 int nvhost_channel_submit(struct nvhost_job *job)
 {
+	if (job->deadline_ns)
+		nvhost_scale_deadline_hint(job->ch->dev,
+					   job->expected_cycles,
+					   job->deadline_ns);
+
 	return channel_op(job->ch).submit(job);
 }
 EXPORT_SYMBOL(nvhost_channel_submit);
@@ -23,6 +23,7 @@
 
 #include <linux/cdev.h>
 #include <linux/io.h>
+#include <linux/rbtree.h>
 #include "nvhost_cdma.h"
 
 #define NVHOST_MAX_WAIT_CHECKS		256
@@ -57,6 +58,9 @@ struct nvhost_channel {
 	struct nvhost_vm *vm;
 	/* owner identifier */
 	void *identifier;
+	/* cached buffer translations, see nvhost_job.c */
+	struct rb_root pin_cache;
+	struct mutex pin_cache_lock;
 };
 
 #define channel_op(ch)		(ch->ops)
@@ -96,6 +96,23 @@ static bool add_waiter_to_queue(struct nvhost_waitlist *waiter,
 	return true;
 }
 
+/**
+ * drain the lock-free staging list into the sorted waiter queue
+ * caller must hold syncpt->lock
+ */
+static void flush_pending_waiters_locked(struct nvhost_intr_syncpt *syncpt)
+{
+	struct llist_node *node = llist_del_all(&syncpt->pending_head);
+
+	while (node) {
+		struct nvhost_waitlist *waiter =
+			llist_entry(node, struct nvhost_waitlist, pending_node);
+
+		node = node->next;
+		add_waiter_to_queue(waiter, &syncpt->wait_head);
+	}
+}
+
 /**
  * run through a waiter queue for a single sync point ID
  * and gather all completed waiters into lists by actions
@@ -145,9 +162,12 @@ static void reset_threshold_interrupt(struct nvhost_intr *intr,
 			       struct list_head *head,
 			       unsigned int id)
 {
+	struct nvhost_intr_syncpt *syncpt = intr->syncpt + id;
 	u32 thresh = list_first_entry(head,
 				struct nvhost_waitlist, list)->thresh;
 
+	atomic_set(&syncpt->armed_thresh, thresh);
+	atomic_set(&syncpt->intr_armed, 1);
 	intr_op().set_syncpt_threshold(intr, id, thresh);
 	intr_op().enable_syncpt_intr(intr, id);
 }
@@ -291,19 +311,39 @@ static int process_wait_list(struct nvhost_intr *intr,
 	for (j = 0; i < NVHOST_INTR_ACTION_COUNT; ++i, ++j)
 		completed[i] = syncpt->low_prio_handlers + j;
 
+	/* pick up waiters published on the lock-free staging list */
+	flush_pending_waiters_locked(syncpt);
+
 	/* this functions fills completed data */
 	remove_completed_waiters(&syncpt->wait_head, threshold,
 		syncpt->isr_recv, completed);
 
-	/* check if there are still waiters left */
-	empty = list_empty(&syncpt->wait_head);
+	/*
+	 * Disable or rearm the interrupt according to the remaining waiters.
+	 * A waiter can be published on the staging list concurrently with
+	 * this; the re-check below pairs with the barrier implied by
+	 * llist_add() in nvhost_intr_add_action() so that such a waiter is
+	 * either drained here or observes the armed state we just wrote and
+	 * rearms the interrupt itself.
+	 */
+	for (;;) {
+		empty = list_empty(&syncpt->wait_head);
+
+		if (empty) {
+			intr_op().disable_syncpt_intr(intr, syncpt->id);
+			atomic_set(&syncpt->intr_armed, 0);
+		} else {
+			reset_threshold_interrupt(intr, &syncpt->wait_head,
+						  syncpt->id);
+		}
+
+		smp_mb__after_atomic();
 
-	/* if not, disable interrupt. If yes, update the inetrrupt */
-	if (empty)
-		intr_op().disable_syncpt_intr(intr, syncpt->id);
-	else
-		reset_threshold_interrupt(intr, &syncpt->wait_head,
-					  syncpt->id);
+		if (llist_empty(&syncpt->pending_head))
+			break;
+
+		flush_pending_waiters_locked(syncpt);
+	}
 
 	/* remove low priority handlers from this list */
 	for (i = NVHOST_INTR_HIGH_PRIO_COUNT;
@@ -393,6 +433,7 @@ bool nvhost_intr_has_pending_jobs(struct nvhost_intr *intr, u32 id,
 
 	syncpt = intr->syncpt + id;
 	spin_lock(&syncpt->lock);
+	flush_pending_waiters_locked(syncpt);
 	list_for_each_entry(waiter, &syncpt->wait_head, list)
 		if (((waiter->action ==
 			NVHOST_INTR_ACTION_SUBMIT_COMPLETE) &&
@@ -413,7 +454,6 @@ int nvhost_intr_add_action(struct nvhost_intr *intr, u32 id, u32 thresh,
 {
 	struct nvhost_waitlist *waiter = _waiter;
 	struct nvhost_intr_syncpt *syncpt;
-	int queue_was_empty;
 	int err;
 
 	if (waiter == NULL) {
@@ -441,21 +481,32 @@ int nvhost_intr_add_action(struct nvhost_intr *intr, u32 id, u32 thresh,
 
 	syncpt = intr->syncpt + id;
 
-	spin_lock(&syncpt->lock);
-
-	queue_was_empty = list_empty(&syncpt->wait_head);
-
-	if (add_waiter_to_queue(waiter, &syncpt->wait_head)) {
-		/* added at head of list - new threshold value */
-		intr_op().set_syncpt_threshold(intr, id, thresh);
-
-		/* added as first waiter - enable interrupt */
-		if (queue_was_empty)
-			intr_op().enable_syncpt_intr(intr, id);
+	/*
+	 * Publish the waiter on the lock-free staging list; the interrupt
+	 * handler drains it into the sorted queue under syncpt->lock, so
+	 * submission-side insertions no longer contend with the ISR walking
+	 * the queue. llist_add() implies a full barrier, pairing with the
+	 * re-check in process_wait_list().
+	 */
+	llist_add(&waiter->pending_node, &syncpt->pending_head);
+
+	/*
+	 * The lock is only needed when the interrupt is not already armed to
+	 * fire at or before the new threshold. On a busy syncpoint with
+	 * monotonically increasing thresholds this slow path is rarely taken.
+	 */
+	if (!atomic_read(&syncpt->intr_armed) ||
+	    (s32)(thresh - (u32)atomic_read(&syncpt->armed_thresh)) < 0) {
+		spin_lock(&syncpt->lock);
+
+		flush_pending_waiters_locked(syncpt);
+		if (!list_empty(&syncpt->wait_head))
+			reset_threshold_interrupt(intr, &syncpt->wait_head,
+						  id);
+
+		spin_unlock(&syncpt->lock);
 	}
 
-	spin_unlock(&syncpt->lock);
-
 	if (ref)
 		*ref = waiter;
 	return 0;
@@ -603,6 +654,9 @@ int nvhost_intr_init(struct nvhost_intr *intr, u32 irq_gen, u32 irq_sync[8])
 		syncpt->id = id;
 		spin_lock_init(&syncpt->lock);
 		INIT_LIST_HEAD(&syncpt->wait_head);
+		init_llist_head(&syncpt->pending_head);
+		atomic_set(&syncpt->intr_armed, 0);
+		atomic_set(&syncpt->armed_thresh, 0);
 		snprintf(syncpt->thresh_irq_name,
 			sizeof(syncpt->thresh_irq_name),
 			"host_sp_%02d", id);
@@ -655,6 +709,11 @@ int nvhost_intr_stop(struct nvhost_intr *intr)
 		struct nvhost_waitlist *waiter, *next;
 
 		intr_op().disable_syncpt_intr(intr, id);
+		atomic_set(&syncpt->intr_armed, 0);
+
+		spin_lock(&syncpt->lock);
+		flush_pending_waiters_locked(syncpt);
+		spin_unlock(&syncpt->lock);
 
 		list_for_each_entry_safe(waiter, next, &syncpt->wait_head, list) {
 			if (atomic_cmpxchg(&waiter->state, WLS_CANCELLED, WLS_HANDLED)
@@ -26,6 +26,7 @@
 #include <linux/interrupt.h>
 #include <linux/workqueue.h>
 #include <linux/spinlock.h>
+#include <linux/llist.h>
 #include <linux/version.h>
 #if LINUX_VERSION_CODE > KERNEL_VERSION(4, 13, 0)
 #include <linux/wait.h>
@@ -87,6 +88,7 @@ struct nvhost_intr;
 struct nvhost_waitlist {
 	struct nvhost_master *host;
 	struct list_head list;
+	struct llist_node pending_node;
 	struct kref refcount;
 	u32 thresh;
 	enum nvhost_intr_action action;
@@ -116,6 +118,11 @@ struct nvhost_intr_syncpt {
 	u32 id;
 	spinlock_t lock;
 	struct list_head wait_head;
+	/* lock-free staging list for new waiters, drained under lock */
+	struct llist_head pending_head;
+	/* interrupt armed state, readable without taking lock */
+	atomic_t intr_armed;
+	atomic_t armed_thresh;
 	char thresh_irq_name[12];
 	struct nvhost_timespec isr_recv;
 	struct work_struct low_prio_work;
@@ -18,6 +18,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <linux/atomic.h>
 #include <linux/slab.h>
 #include <linux/kref.h>
 #include <linux/err.h>
@@ -36,6 +37,9 @@
 /* Magic to use to fill freed handle slots */
 #define BAD_MAGIC 0xdeadbeef
 
+/* Source of the per-job ids used by the job lifecycle tracepoints */
+static atomic64_t job_id_counter;
+
 static size_t job_size(u32 num_cmdbufs, u32 num_relocs, u32 num_waitchks,
 			u32 num_syncpts)
 {
@@ -129,6 +133,7 @@ struct nvhost_job *nvhost_job_alloc(struct nvhost_channel *ch,
 	kref_init(&job->ref);
 	job->ch = ch;
 	job->size = size;
+	job->id = atomic64_inc_return(&job_id_counter);
 
 	init_fields(job, num_cmdbufs, num_relocs, num_waitchks, num_syncpts);
 
@@ -163,6 +168,10 @@ static void job_free(struct kref *ref)
 	struct nvhost_channel *ch = job->ch;
 	struct nvhost_device_data *pdata = platform_get_drvdata(ch->dev);
 
+	trace_nvhost_job_complete(ch->dev->name, job->id,
+		job->sp ? job->sp->id : 0,
+		job->sp ? job->sp->fence : 0);
+
 	if (job->engine_timestamps.ptr) {
 		if (job->engine_timestamps.ptr[0] != 0) {
 			/* don't log kernel added syncpt added for op_done */
@@ -267,7 +276,157 @@ static int id_cmp(const void *_id1, const void *_id2)
 	return 0;
 }
 
-static int pin_array_ids(struct platform_device *dev,
+/*
+ * Cached dma-buf translation kept warm on a channel across submits. The
+ * entry owns a reference on the buffer together with the attachment and
+ * mapping, so the translation stays valid until the cache is purged. Jobs
+ * using the entry hold it busy until they are unpinned.
+ */
+struct nvhost_pin_cache_entry {
+	struct dma_buf *buf;
+	struct device *dev;
+	struct dma_buf_attachment *attach;
+	struct sg_table *sgt;
+	dma_addr_t addr;
+	enum dma_data_direction direction;
+	s32 busy;
+	struct rb_node node;
+};
+
+static struct nvhost_pin_cache_entry *pin_cache_find(
+		struct nvhost_channel *ch, struct dma_buf *buf,
+		struct device *dev)
+{
+	struct rb_node *node = ch->pin_cache.rb_node;
+	struct nvhost_pin_cache_entry *entry;
+
+	/* check in a sorted tree */
+	while (node) {
+		entry = rb_entry(node, struct nvhost_pin_cache_entry, node);
+
+		if (entry->buf > buf ||
+		    (entry->buf == buf && entry->dev > dev))
+			node = node->rb_left;
+		else if (entry->buf != buf || entry->dev != dev)
+			node = node->rb_right;
+		else
+			return entry;
+	}
+
+	return NULL;
+}
+
+static void pin_cache_insert(struct nvhost_channel *ch,
+		struct nvhost_pin_cache_entry *new_entry)
+{
+	struct rb_node **new_node = &ch->pin_cache.rb_node;
+	struct rb_node *parent = NULL;
+
+	/* Figure out where to put the new node */
+	while (*new_node) {
+		struct nvhost_pin_cache_entry *entry =
+			rb_entry(*new_node, struct nvhost_pin_cache_entry,
+						node);
+		parent = *new_node;
+
+		if (entry->buf > new_entry->buf ||
+		    (entry->buf == new_entry->buf &&
+		     entry->dev > new_entry->dev))
+			new_node = &((*new_node)->rb_left);
+		else
+			new_node = &((*new_node)->rb_right);
+	}
+
+	/* Add new node and rebalance tree */
+	rb_link_node(&new_entry->node, parent, new_node);
+	rb_insert_color(&new_entry->node, &ch->pin_cache);
+}
+
+/*
+ * Hand a freshly mapped translation over to the channel pin cache. If an
+ * identical entry raced in meanwhile, the existing one is reused and the
+ * new mapping is torn down. Returns the entry the job should reference,
+ * or NULL if no entry could be allocated (the mapping then stays owned by
+ * the job as before).
+ */
+static struct nvhost_pin_cache_entry *pin_cache_add(
+		struct nvhost_channel *ch, struct dma_buf *buf,
+		struct device *dev, struct dma_buf_attachment *attach,
+		struct sg_table *sgt, enum dma_data_direction direction)
+{
+	struct nvhost_pin_cache_entry *entry, *old;
+
+	entry = kzalloc(sizeof(*entry), GFP_KERNEL);
+	if (!entry)
+		return NULL;
+
+	mutex_lock(&ch->pin_cache_lock);
+	old = pin_cache_find(ch, buf, dev);
+	if (old) {
+		bool reuse = (old->direction == direction);
+
+		if (reuse)
+			old->busy++;
+		mutex_unlock(&ch->pin_cache_lock);
+		kfree(entry);
+		if (!reuse)
+			return NULL;
+		dma_buf_unmap_attachment(attach, sgt, direction);
+		dma_buf_detach(buf, attach);
+		return old;
+	}
+
+	get_dma_buf(buf);
+	entry->buf = buf;
+	entry->dev = dev;
+	entry->attach = attach;
+	entry->sgt = sgt;
+	entry->addr = sg_dma_address(sgt->sgl);
+	entry->direction = direction;
+	entry->busy = 1;
+	pin_cache_insert(ch, entry);
+	mutex_unlock(&ch->pin_cache_lock);
+
+	return entry;
+}
+
+void nvhost_job_pin_cache_purge(struct nvhost_channel *ch)
+{
+	struct nvhost_pin_cache_entry *entry, *tmp;
+
+	mutex_lock(&ch->pin_cache_lock);
+	rbtree_postorder_for_each_entry_safe(entry, tmp,
+					     &ch->pin_cache, node) {
+		WARN_ON(entry->busy != 0);
+		dma_buf_unmap_attachment(entry->attach, entry->sgt,
+					 entry->direction);
+		dma_buf_detach(entry->buf, entry->attach);
+		dma_buf_put(entry->buf);
+		kfree(entry);
+	}
+	ch->pin_cache = RB_ROOT;
+	mutex_unlock(&ch->pin_cache_lock);
+}
+
+static void unpin_one(struct nvhost_channel *ch,
+		struct nvhost_job_unpin *unpin)
+{
+	if (unpin->cache) {
+		mutex_lock(&ch->pin_cache_lock);
+		unpin->cache->busy--;
+		mutex_unlock(&ch->pin_cache_lock);
+		dma_buf_put(unpin->buf);
+		return;
+	}
+
+	dma_buf_unmap_attachment(unpin->attach, unpin->sgt,
+				 unpin->direction);
+	dma_buf_detach(unpin->buf, unpin->attach);
+	dma_buf_put(unpin->buf);
+}
+
+static int pin_array_ids(struct nvhost_channel *ch,
+		struct platform_device *dev,
 		struct nvhost_pinid *ids,
 		dma_addr_t *phys_addr,
 		u32 count,
@@ -277,6 +436,7 @@ static int pin_array_ids(struct platform_device *dev,
 	struct sg_table *sgt;
 	struct dma_buf *buf;
 	struct dma_buf_attachment *attach;
+	struct nvhost_pin_cache_entry *cache;
 	u32 prev_id = 0;
 	dma_addr_t prev_addr = 0;
 	int err = 0;
@@ -299,6 +459,26 @@ static int pin_array_ids(struct platform_device *dev,
 			goto clean_up;
 		}
 
+		/* reuse a translation cached on the channel if present */
+		mutex_lock(&ch->pin_cache_lock);
+		cache = pin_cache_find(ch, buf, &dev->dev);
+		if (cache && cache->direction == ids[i].direction) {
+			cache->busy++;
+			mutex_unlock(&ch->pin_cache_lock);
+
+			phys_addr[ids[i].index] = cache->addr;
+			unpin_data[pin_count].buf = buf;
+			unpin_data[pin_count].attach = NULL;
+			unpin_data[pin_count].sgt = NULL;
+			unpin_data[pin_count].direction = ids[i].direction;
+			unpin_data[pin_count++].cache = cache;
+
+			prev_id = ids[i].id;
+			prev_addr = phys_addr[ids[i].index];
+			continue;
+		}
+		mutex_unlock(&ch->pin_cache_lock);
+
 		attach = dma_buf_attach(buf, &dev->dev);
 		if (IS_ERR(attach)) {
 			err = PTR_ERR(attach);
@@ -324,11 +504,16 @@ static int pin_array_ids(struct platform_device *dev,
 		if (!sg_dma_address(sgt->sgl))
 			sg_dma_address(sgt->sgl) = sg_phys(sgt->sgl);
 
-		phys_addr[ids[i].index] = sg_dma_address(sgt->sgl);
+		cache = pin_cache_add(ch, buf, &dev->dev, attach, sgt,
+				      ids[i].direction);
+
+		phys_addr[ids[i].index] = cache ? cache->addr :
+					  sg_dma_address(sgt->sgl);
 		unpin_data[pin_count].buf = buf;
-		unpin_data[pin_count].attach = attach;
+		unpin_data[pin_count].attach = cache ? NULL : attach;
+		unpin_data[pin_count].sgt = cache ? NULL : sgt;
 		unpin_data[pin_count].direction = ids[i].direction;
-		unpin_data[pin_count++].sgt = sgt;
+		unpin_data[pin_count++].cache = cache;
 
 		prev_id = ids[i].id;
 		prev_addr = phys_addr[ids[i].index];
@@ -342,12 +527,8 @@ clean_up_map:
 clean_up_attach:
 	dma_buf_put(buf);
 clean_up:
-	for (i = 0; i < pin_count; i++) {
-		dma_buf_unmap_attachment(unpin_data[i].attach,
-			unpin_data[i].sgt, unpin_data[i].direction);
-		dma_buf_detach(unpin_data[i].buf, unpin_data[i].attach);
-		dma_buf_put(unpin_data[i].buf);
-	}
+	for (i = 0; i < pin_count; i++)
+		unpin_one(ch, &unpin_data[i]);
 
 	return err;
 }
@@ -367,7 +548,7 @@ static int pin_job_mem(struct nvhost_job *job)
 	}
 
 	/* validate array and pin unique ids, get refs for reloc unpinning */
-	result = pin_array_ids(job->ch->vm->pdev,
+	result = pin_array_ids(job->ch, job->ch->vm->pdev,
 		job->pin_ids, job->addr_phys,
 		job->num_relocs,
 		job->unpins);
@@ -385,7 +566,7 @@ static int pin_job_mem(struct nvhost_job *job)
 	}
 
 	/* validate array and pin unique ids, get refs for gather unpinning */
-	result = pin_array_ids(nvhost_get_host(job->ch->dev)->dev,
+	result = pin_array_ids(job->ch, nvhost_get_host(job->ch->dev)->dev,
 		&job->pin_ids[job->num_relocs],
 		&job->addr_phys[job->num_relocs],
 		job->num_gathers,
@@ -545,6 +726,11 @@ int nvhost_job_pin(struct nvhost_job *job, struct nvhost_syncpt *sp)
 				break;
 		}
 	}
+
+	if (!err)
+		trace_nvhost_job_pin_done(job->ch->dev->name, job->id,
+			job->sp ? job->sp->id : 0,
+			job->sp ? job->sp->fence : 0);
 fail:
 	return err;
 }
@@ -553,14 +739,8 @@ void nvhost_job_unpin(struct nvhost_job *job)
 {
 	int i;
 
-	for (i = 0; i < job->num_unpins; i++) {
-		struct nvhost_job_unpin *unpin = &job->unpins[i];
-
-		dma_buf_unmap_attachment(unpin->attach, unpin->sgt,
-					 unpin->direction);
-		dma_buf_detach(unpin->buf, unpin->attach);
-		dma_buf_put(unpin->buf);
-	}
+	for (i = 0; i < job->num_unpins; i++)
+		unpin_one(job->ch, &job->unpins[i]);
 	job->num_unpins = 0;
 }
 
@@ -53,11 +53,15 @@ struct nvhost_pinid {
 	enum dma_data_direction direction;
 };
 
+struct nvhost_pin_cache_entry;
+
 struct nvhost_job_unpin {
 	struct sg_table *sgt;
 	struct dma_buf *buf;
 	struct dma_buf_attachment *attach;
 	enum dma_data_direction direction;
+	/* set if the translation came from the channel pin cache */
+	struct nvhost_pin_cache_entry *cache;
 };
 
 /*
@@ -79,6 +83,12 @@ struct nvhost_job {
 	/* Hardware context valid for this client */
 	int clientid;
 
+	/* Unique id of this job, used to key the job lifecycle tracepoints */
+	u64 id;
+
+	/* Client-assigned frame trace id for pipeline tracing, 0 = untraced */
+	u64 trace_id;
+
 	/* Gathers and their memory */
 	struct nvhost_job_gather *gathers;
 	int num_gathers;
@@ -118,6 +128,10 @@ struct nvhost_job {
 	/* Set to true to force an added wait-for-idle before the job */
 	int serialize;
 
+	/* Set to true to skip forced serialization; the job orders itself
+	 * against earlier work with explicit syncpoint waits */
+	int pipelined;
+
 	/* error notifiers used channel submit timeout */
 	struct dma_buf *error_notifier_ref;
 	u64 error_notifier_offset;
@@ -127,6 +141,10 @@ struct nvhost_job {
 		dma_addr_t dma;
 		u64 *ptr;
 	} engine_timestamps;
+
+	/* optional deadline hint for clock scaling, 0 when unused */
+	u64 expected_cycles;
+	u64 deadline_ns;
 };
 
 /*
@@ -155,6 +173,12 @@ int nvhost_job_pin(struct nvhost_job *job, struct nvhost_syncpt *sp);
  */
 void nvhost_job_unpin(struct nvhost_job *job);
 
+/*
+ * Release all buffer translations cached on a channel. Called when the
+ * channel is unmapped, before its address space is dropped.
+ */
+void nvhost_job_pin_cache_purge(struct nvhost_channel *ch);
+
 /*
  * Dump contents of job to debug output.
  */
@@ -0,0 +1,124 @@
+/*
+ * Correlated frame pipeline tracing
+ *
+ * Copyright (c) 2022, NVIDIA Corporation.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <linux/export.h>
+#include <linux/sched.h>
+#include <linux/version.h>
+
+#include <asm/arch_timer.h>
+
+#include <uapi/linux/nvhost_pipeline_events.h>
+
+#include "nvhost_pipeline.h"
+
+#ifdef CONFIG_EVENTLIB
+
+#include <linux/keventlib.h>
+#include "nvhost_pipeline_json.h"
+
+/*
+ * Unlike the per-device nvhost streams, the pipeline stream is global:
+ * the point of it is that VI captures, engine jobs and display flips
+ * belonging to one frame land in a single sequence-ordered log.
+ */
+static int nvhost_pipeline_eventlib_id;
+
+void nvhost_pipeline_init(void)
+{
+	int id;
+
+	/* sharded: frame events are logged from submit paths, completion
+	 * workers and the display flip worker on any CPU
+	 */
+	id = keventlib_register_sharded(4 * PAGE_SIZE,
+					NVHOST_PIPELINE_EVENT_PROVIDER_NAME,
+					nvhost_pipeline_json,
+					nvhost_pipeline_json_len);
+	if (id < 0) {
+		pr_warn("nvhost: failed to register pipeline eventlib (err=%d)",
+			id);
+		return;
+	}
+
+	nvhost_pipeline_eventlib_id = id;
+}
+
+void nvhost_pipeline_exit(void)
+{
+	if (nvhost_pipeline_eventlib_id) {
+		keventlib_unregister(nvhost_pipeline_eventlib_id);
+		nvhost_pipeline_eventlib_id = 0;
+	}
+}
+
+void nvhost_pipeline_trace_frame(u64 trace_id,
+				 u32 stage,
+				 u32 class_id,
+				 u32 extra)
+{
+	struct nvhost_pipeline_frame frame;
+
+	if (!nvhost_pipeline_eventlib_id || !trace_id)
+		return;
+
+	frame.trace_id = trace_id;
+	frame.stage = stage;
+	frame.class_id = class_id;
+	frame.extra = extra;
+
+	/*
+	 * Eventlib events are meant to be matched with their userspace
+	 * analogues. Instead of the PID as (this) thread's ID use the
+	 * inherited thread group ID. For the reported TID use this thread's
+	 * ID (i.e. PID).
+	 */
+	frame.tid = current->pid;
+	frame.pid = current->tgid;
+
+	keventlib_write(nvhost_pipeline_eventlib_id,
+			&frame,
+			sizeof(frame),
+			NVHOST_PIPELINE_FRAME,
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 4, 0)
+			arch_timer_read_counter()
+#else
+			arch_counter_get_cntvct()
+#endif
+	);
+}
+EXPORT_SYMBOL(nvhost_pipeline_trace_frame);
+
+#else
+
+void nvhost_pipeline_init(void)
+{
+}
+
+void nvhost_pipeline_exit(void)
+{
+}
+
+void nvhost_pipeline_trace_frame(u64 trace_id,
+				 u32 stage,
+				 u32 class_id,
+				 u32 extra)
+{
+}
+EXPORT_SYMBOL(nvhost_pipeline_trace_frame);
+
+#endif
@@ -0,0 +1,26 @@
+/*
+ * Correlated frame pipeline tracing
+ *
+ * Copyright (c) 2022, NVIDIA Corporation.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __NVHOST_PIPELINE_H
+#define __NVHOST_PIPELINE_H
+
+/* Register/unregister the global pipeline eventlib stream */
+void nvhost_pipeline_init(void);
+void nvhost_pipeline_exit(void);
+
+#endif
@@ -22,6 +22,7 @@
 #include <linux/slab.h>
 #include <linux/dma-mapping.h>
 #include <linux/debugfs.h>
+#include <linux/ktime.h>
 
 #include <linux/nvhost.h>
 
@@ -42,9 +43,12 @@
  * dma_addr		Physical address of task memory pool
  * va			Virtual address of the task memory pool
  * kmem_addr		Kernel memory for task struct
- * lock			Mutex lock for the array access.
  * alloc_table		Keep track of the index being assigned
- *			and freed for a task
+ *			and freed for a task. Slots are claimed and
+ *			released with atomic bit operations, so no lock
+ *			is taken on the submit or completion path.
+ * alloc_ts		Per-slot allocation timestamps for the latency
+ *			histogram
  * max_task_cnt		Maximum task count that can be supported.
  *
  */
@@ -52,10 +56,10 @@ struct nvhost_queue_task_pool {
 	dma_addr_t dma_addr;
 	void *va;
 	void *kmem_addr;
-	struct mutex lock;
 
 	unsigned long alloc_table;
 	unsigned long max_task_cnt;
+	ktime_t *alloc_ts;
 };
 
 static int nvhost_queue_task_pool_alloc(struct platform_device *pdev,
@@ -90,12 +94,21 @@ static int nvhost_queue_task_pool_alloc(struct platform_device *pdev,
 		err = -ENOMEM;
 		goto err_alloc_task_pool;
 	}
-	task_pool->max_task_cnt = num_tasks;
 
-	mutex_init(&task_pool->lock);
+	task_pool->alloc_ts = kcalloc(num_tasks, sizeof(ktime_t), GFP_KERNEL);
+	if (task_pool->alloc_ts == NULL) {
+		nvhost_err(&pdev->dev,
+			   "failed to allocate task_pool->alloc_ts");
+		err = -ENOMEM;
+		goto err_alloc_ts;
+	}
+	task_pool->max_task_cnt = num_tasks;
 
 	return err;
 
+err_alloc_ts:
+	dma_free_attrs(&pdev->dev, queue->task_dma_size * num_tasks,
+			task_pool->va, task_pool->dma_addr, 0);
 err_alloc_task_pool:
 	kfree(task_pool->kmem_addr);
 err_alloc_task_kmem:
@@ -114,6 +127,8 @@ static void nvhost_queue_task_free_pool(struct platform_device *pdev,
 			0);
 
 	kfree(task_pool->kmem_addr);
+	kfree(task_pool->alloc_ts);
+	task_pool->alloc_ts = NULL;
 	task_pool->max_task_cnt = 0;
 	task_pool->alloc_table = 0;
 }
@@ -122,9 +137,25 @@ static int nvhost_queue_dump(struct nvhost_queue_pool *pool,
 		struct nvhost_queue *queue,
 		struct seq_file *s)
 {
+	u64 count;
+	int i;
+
 	if (pool->ops && pool->ops->dump)
 		pool->ops->dump(queue, s);
 
+	seq_printf(s, "Queue %u task latency histogram (us):\n", queue->id);
+	for (i = 0; i < NVHOST_QUEUE_LAT_BUCKETS; i++) {
+		count = atomic64_read(&queue->lat_hist[i]);
+		if (count == 0)
+			continue;
+		if (i == NVHOST_QUEUE_LAT_BUCKETS - 1)
+			seq_printf(s, "  >= %8llu: %llu\n",
+					(u64)1 << (i - 1), count);
+		else
+			seq_printf(s, "  <  %8llu: %llu\n",
+					(u64)1 << i, count);
+	}
+
 	return 0;
 }
 
@@ -288,6 +319,7 @@ struct nvhost_queue *nvhost_queue_alloc(struct nvhost_queue_pool *pool,
 	struct nvhost_queue *queue;
 	int index = 0;
 	int err = 0;
+	int i;
 
 	mutex_lock(&pool->queue_lock);
 
@@ -318,6 +350,10 @@ struct nvhost_queue *nvhost_queue_alloc(struct nvhost_queue_pool *pool,
 	queue->use_channel = use_channel;
 	queue->sequence = 0;
 
+	/* reset the latency histogram for the new owner */
+	for (i = 0; i < NVHOST_QUEUE_LAT_BUCKETS; i++)
+		atomic64_set(&queue->lat_hist[i], 0);
+
 	/* initialize task list */
 	INIT_LIST_HEAD(&queue->tasklist);
 	mutex_init(&queue->list_lock);
@@ -541,27 +577,26 @@ int nvhost_queue_alloc_task_memory(
 			struct nvhost_queue *queue,
 			struct nvhost_queue_task_mem_info *task_mem_info)
 {
-	int err = 0;
 	int index, hw_offset, sw_offset;
 	struct platform_device *pdev = queue->pool->pdev;
 	struct nvhost_queue_task_pool *task_pool =
 		(struct nvhost_queue_task_pool *)queue->task_pool;
 
-	mutex_lock(&task_pool->lock);
-
-	index = find_first_zero_bit(&task_pool->alloc_table,
-				    task_pool->max_task_cnt);
+	/* claim a free slot atomically; retry if someone beats us to it */
+	do {
+		index = find_first_zero_bit(&task_pool->alloc_table,
+					    task_pool->max_task_cnt);
 
-	/* quit if pre-allocated task array is not free */
-	if (index >= task_pool->max_task_cnt) {
-		dev_err(&pdev->dev,
-				"failed to get Task Pool Memory\n");
-		err = -EAGAIN;
-		goto err_alloc_task_mem;
-	}
+		/* quit if pre-allocated task array is not free */
+		if (index >= task_pool->max_task_cnt) {
+			dev_err(&pdev->dev,
+					"failed to get Task Pool Memory\n");
+			return -EAGAIN;
+		}
+	} while (test_and_set_bit(index, &task_pool->alloc_table));
 
 	/* assign the task array */
-	set_bit(index, &task_pool->alloc_table);
+	task_pool->alloc_ts[index] = ktime_get();
 	hw_offset = index * queue->task_dma_size;
 	sw_offset = index * queue->task_kmem_size;
 	task_mem_info->kmem_addr =
@@ -570,19 +605,24 @@ int nvhost_queue_alloc_task_memory(
 	task_mem_info->dma_addr = task_pool->dma_addr + hw_offset;
 	task_mem_info->pool_index = index;
 
-err_alloc_task_mem:
-	mutex_unlock(&task_pool->lock);
-
-	return err;
+	return 0;
 }
 
 void nvhost_queue_free_task_memory(struct nvhost_queue *queue, int index)
 {
 	int hw_offset, sw_offset;
 	u8 *task_kmem, *task_dma_va;
+	s64 usecs;
+	unsigned int bucket;
 	struct nvhost_queue_task_pool *task_pool =
 			(struct nvhost_queue_task_pool *)queue->task_pool;
 
+	/* account the slot lifetime into the latency histogram */
+	usecs = ktime_us_delta(ktime_get(), task_pool->alloc_ts[index]);
+	bucket = min((unsigned int)fls64(usecs),
+		     (unsigned int)NVHOST_QUEUE_LAT_BUCKETS - 1);
+	atomic64_inc(&queue->lat_hist[bucket]);
+
 	/* clear task kernel and dma virtual memory contents*/
 	hw_offset = index * queue->task_dma_size;
 	sw_offset = index * queue->task_kmem_size;
@@ -592,7 +632,7 @@ void nvhost_queue_free_task_memory(struct nvhost_queue *queue, int index)
 	memset(task_kmem, 0, queue->task_kmem_size);
 	memset(task_dma_va, 0, queue->task_dma_size);
 
-	mutex_lock(&task_pool->lock);
+	/* make the cleared contents visible before the slot is reused */
+	smp_mb__before_atomic();
 	clear_bit(index, &task_pool->alloc_table);
-	mutex_unlock(&task_pool->lock);
 }
@@ -19,12 +19,16 @@
 #ifndef __NVHOST_NVHOST_QUEUE_H__
 #define __NVHOST_NVHOST_QUEUE_H__
 
+#include <linux/atomic.h>
 #include <linux/kref.h>
 #include <linux/mutex.h>
 #include <linux/semaphore.h>
 
 struct nvhost_queue_task_pool;
 
+/* Number of power-of-two buckets in the task latency histogram */
+#define NVHOST_QUEUE_LAT_BUCKETS	16
+
 /**
  * @brief	Describe a allocated task mem struct
  *
@@ -56,6 +60,8 @@ struct nvhost_queue_task_mem_info {
  * task_dma_size	dma size used in hardware for a task
  * task_kmem_size	kernel memory size for a task
  * attr			queue attribute associated with the host module
+ * lat_hist		submit-to-completion latency histogram; bucket n
+ *			counts tasks that completed in less than 2^n us
  *
  */
 struct nvhost_queue {
@@ -83,6 +89,8 @@ struct nvhost_queue {
 
 	struct mutex list_lock;
 	struct list_head tasklist;
+
+	atomic64_t lat_hist[NVHOST_QUEUE_LAT_BUCKETS];
 };
 
 /**
@@ -26,6 +26,7 @@
 #include <linux/clk/tegra.h>
 #include <linux/version.h>
 #include <linux/pm_qos.h>
+#include <linux/math64.h>
 #include <trace/events/nvhost.h>
 #include <linux/uaccess.h>
 #include <linux/version.h>
@@ -116,6 +117,16 @@ static int nvhost_scale_target(struct device *dev, unsigned long *freq,
 	struct nvhost_device_data *pdata = dev_get_drvdata(dev);
 	struct nvhost_device_profile *profile = pdata->power_profile;
 
+	/* honour an active deadline hint as a frequency floor */
+	if (profile->hint_floor) {
+		if (time_before(jiffies, profile->hint_expires)) {
+			if (*freq < profile->hint_floor)
+				*freq = profile->hint_floor;
+		} else {
+			profile->hint_floor = 0;
+		}
+	}
+
 	*freq = clk_round_rate(profile->clk, *freq);
 	if (clk_get_rate(profile->clk) == *freq)
 		return 0;
@@ -194,6 +205,50 @@ static void nvhost_scale_notify(struct platform_device *pdev, bool busy)
 	mutex_unlock(&devfreq->lock);
 }
 
+/*
+ * nvhost_scale_deadline_hint(pdev, expected_cycles, deadline_ns)
+ *
+ * Fold a job deadline hint into an immediate frequency floor. The floor is
+ * the rate needed to retire expected_cycles before deadline_ns elapses and
+ * is applied right away instead of waiting for the utilization history to
+ * catch up; it decays once the deadline has passed.
+ */
+
+void nvhost_scale_deadline_hint(struct platform_device *pdev,
+				u64 expected_cycles, u64 deadline_ns)
+{
+	struct nvhost_device_data *pdata = platform_get_drvdata(pdev);
+	struct nvhost_device_profile *profile = pdata->power_profile;
+	struct devfreq *devfreq = pdata->power_manager;
+	unsigned long floor;
+	u64 rate;
+
+	if (!profile || !expected_cycles || !deadline_ns)
+		return;
+
+	if (expected_cycles > div64_u64(U64_MAX, NSEC_PER_SEC))
+		rate = ULONG_MAX;
+	else
+		rate = div64_u64(expected_cycles * NSEC_PER_SEC, deadline_ns);
+
+	floor = min_t(u64, rate, ULONG_MAX);
+
+	profile->hint_floor = floor;
+	profile->hint_expires = jiffies + nsecs_to_jiffies(deadline_ns) + 1;
+
+	if (!devfreq) {
+		nvhost_scale_target(&pdev->dev, &floor, 0);
+		return;
+	}
+
+	mutex_lock(&devfreq->lock);
+#if defined(CONFIG_PM_DEVFREQ)
+	update_devfreq(devfreq);
+#endif
+	mutex_unlock(&devfreq->lock);
+}
+EXPORT_SYMBOL(nvhost_scale_deadline_hint);
+
 void nvhost_scale_notify_idle(struct platform_device *pdev)
 {
 	nvhost_scale_notify(pdev, false);
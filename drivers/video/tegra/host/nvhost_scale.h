@@ -48,6 +48,10 @@ struct nvhost_device_profile {
 	void				*private_data;
 	struct notifier_block		qos_notify_block;
 	int				num_actmons;
+
+	/* frequency floor from a job deadline hint and its expiry */
+	unsigned long			hint_floor;
+	unsigned long			hint_expires;
 };
 
 #if defined(CONFIG_TEGRA_GRHOST_SCALE)
@@ -62,6 +66,13 @@ void nvhost_scale_deinit(struct platform_device *);
 void nvhost_scale_notify_busy(struct platform_device *);
 void nvhost_scale_notify_idle(struct platform_device *);
 
+/*
+ * fold a job deadline hint into an immediate frequency floor so the engine
+ * does not wait for utilization history to catch up after idle
+ */
+void nvhost_scale_deadline_hint(struct platform_device *,
+				u64 expected_cycles, u64 deadline_ns);
+
 int nvhost_scale_hw_init(struct platform_device *);
 void nvhost_scale_hw_deinit(struct platform_device *);
 
@@ -72,6 +83,9 @@ static inline void nvhost_scale_init(struct platform_device *d) { }
 static inline void nvhost_scale_deinit(struct platform_device *d) { }
 static inline void nvhost_scale_notify_busy(struct platform_device *d) { }
 static inline void nvhost_scale_notify_idle(struct platform_device *d) { }
+static inline void nvhost_scale_deadline_hint(struct platform_device *d,
+					      u64 expected_cycles,
+					      u64 deadline_ns) { }
 static inline int nvhost_scale_hw_init(struct platform_device *d)
 {
 	return 0;
@@ -115,6 +115,16 @@ void nvhost_syncpt_save(struct nvhost_syncpt *sp)
 	}
 }
 
+/**
+ * Publishes a min value to the read-only shadow page mapped by userspace.
+ */
+static void nvhost_syncpt_shadow_publish(struct nvhost_syncpt *sp, u32 id,
+					 u32 val)
+{
+	if (sp->shadow_page && id < nvhost_syncpt_nb_hw_pts(sp))
+		WRITE_ONCE(sp->shadow_page[id], val);
+}
+
 /**
  * Updates the last value read from hardware.
  */
@@ -124,6 +134,7 @@ u32 nvhost_syncpt_update_min(struct nvhost_syncpt *sp, u32 id)
 
 	val = syncpt_op().update_min(sp, id);
 	trace_nvhost_syncpt_update_min(id, val);
+	nvhost_syncpt_shadow_publish(sp, id, val);
 
 	return val;
 }
@@ -152,6 +163,7 @@ u32 nvhost_syncpt_set_min_cached(struct nvhost_syncpt *sp, u32 id, u32 val)
 		((u32)atomic_cmpxchg(&sp->min_val[id], old, val) != old))
 		return nvhost_syncpt_update_min(sp, id);
 
+	nvhost_syncpt_shadow_publish(sp, id, val);
 	return val;
 }
 
@@ -1091,6 +1103,9 @@ int nvhost_syncpt_init(struct platform_device *dev,
 		kzalloc(sizeof(atomic_t) * nvhost_syncpt_nb_mlocks(sp),
 			GFP_KERNEL);
 	sp->ref = kzalloc(sizeof(atomic_t) * nb_pts, GFP_KERNEL);
+	sp->shadow_order = get_order(nb_pts * sizeof(u32));
+	sp->shadow_page = (u32 *)__get_free_pages(GFP_KERNEL | __GFP_ZERO,
+						  sp->shadow_order);
 #if defined(CONFIG_TEGRA_GRHOST_SYNC) && defined(CONFIG_SYNC)
 	sp->timeline = kzalloc(sizeof(struct nvhost_sync_timeline *) *
 			nb_pts, GFP_KERNEL);
@@ -1102,7 +1117,8 @@ int nvhost_syncpt_init(struct platform_device *dev,
 #endif
 
 	if (!(sp->assigned && sp->client_managed && sp->min_val && sp->max_val
-		     && sp->lock_counts && sp->in_use_ch && sp->ref)) {
+		     && sp->lock_counts && sp->in_use_ch && sp->ref
+		     && sp->shadow_page)) {
 		nvhost_err(&dev->dev, "syncpt in a wrong state");
 		/* frees happen in the deinit */
 		err = -ENOMEM;
@@ -1232,6 +1248,9 @@ void nvhost_syncpt_deinit(struct nvhost_syncpt *sp)
 {
 	kobject_put(sp->kobj);
 
+	free_pages((unsigned long)sp->shadow_page, sp->shadow_order);
+	sp->shadow_page = NULL;
+
 	kfree(sp->min_val);
 	sp->min_val = NULL;
 
@@ -1438,6 +1457,8 @@ void nvhost_syncpt_set_min_eq_max_ext(struct platform_device *dev, u32 id)
 	struct nvhost_syncpt *sp =
 		nvhost_get_syncpt_owner_struct(id, &master->syncpt);
 	atomic_set(&sp->min_val[id], atomic_read(&sp->max_val[id]));
+	nvhost_syncpt_shadow_publish(sp, id,
+				     (u32)atomic_read(&sp->min_val[id]));
 	syncpt_op().reset(sp, id);
 }
 EXPORT_SYMBOL(nvhost_syncpt_set_min_eq_max_ext);
@@ -1468,6 +1489,8 @@ void nvhost_syncpt_set_min_eq_max(struct nvhost_syncpt *sp, u32 id)
 {
 	sp = nvhost_get_syncpt_owner_struct(id, sp);
 	atomic_set(&sp->min_val[id], atomic_read(&sp->max_val[id]));
+	nvhost_syncpt_shadow_publish(sp, id,
+				     (u32)atomic_read(&sp->min_val[id]));
 	syncpt_op().reset(sp, id);
 }
 
@@ -1511,6 +1534,7 @@ void nvhost_syncpt_set_minval(struct platform_device *dev, u32 id, u32 val)
 	struct nvhost_syncpt *sp = &master->syncpt;
 
 	atomic_set(&sp->min_val[id], val);
+	nvhost_syncpt_shadow_publish(sp, id, val);
 	smp_wmb();
 	syncpt_op().reset(sp, id);
 }
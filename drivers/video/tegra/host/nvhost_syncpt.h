@@ -60,6 +60,9 @@ struct nvhost_syncpt {
 	const char **syncpt_names;
 	const char **last_used_by;
 	struct nvhost_syncpt_attr *syncpt_attrs;
+	/* read-only shadow of min values, mmap-able from the ctrl node */
+	u32 *shadow_page;
+	unsigned int shadow_order;
 #if IS_ENABLED(CONFIG_TEGRA_GRHOST_SYNC) && IS_ENABLED(CONFIG_SYNC)
 	struct nvhost_sync_timeline **timeline;
 	struct nvhost_sync_timeline *timeline_invalid;
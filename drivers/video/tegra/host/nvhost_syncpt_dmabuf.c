@@ -7,6 +7,7 @@
 #include <linux/nvhost_t194.h>
 #include <linux/dma-buf.h>
 #include <linux/dma-mapping.h>
+#include <linux/fs.h>
 #include <uapi/linux/nvhost_ioctl.h>
 
 #include "host1x/host1x.h"
@@ -22,12 +23,56 @@ struct nvhost_syncpt_dmabuf_data {
 	size_t size;
 };
 
+/*
+ * Look up the cached dmabuf of a syncpoint. The cache holds no reference
+ * of its own, so an entry may sit between its final dma_buf_put() and the
+ * release callback; it is only handed out if a file reference can still
+ * be taken. Returns the dmabuf with a reference held, or NULL.
+ */
+static struct dma_buf *nvhost_syncpt_dmabuf_cache_get(
+	struct nvhost_master *host, u32 syncpt_id)
+{
+	struct dma_buf *dmabuf = NULL;
+
+	mutex_lock(&host->syncpt_dmabuf_mutex);
+	if (host->syncpt_dmabufs)
+		dmabuf = host->syncpt_dmabufs[syncpt_id];
+	if (dmabuf && !get_file_rcu(dmabuf->file))
+		dmabuf = NULL;
+	mutex_unlock(&host->syncpt_dmabuf_mutex);
+
+	return dmabuf;
+}
+
+static void nvhost_syncpt_dmabuf_cache_add(struct nvhost_master *host,
+					u32 syncpt_id, struct dma_buf *dmabuf)
+{
+	mutex_lock(&host->syncpt_dmabuf_mutex);
+	if (!host->syncpt_dmabufs)
+		host->syncpt_dmabufs = kcalloc(host->info.nb_hw_pts,
+					sizeof(*host->syncpt_dmabufs),
+					GFP_KERNEL);
+	/* allocation failure just means this export is not cached */
+	if (host->syncpt_dmabufs)
+		host->syncpt_dmabufs[syncpt_id] = dmabuf;
+	mutex_unlock(&host->syncpt_dmabuf_mutex);
+}
+
 static void nvhost_syncpt_dmabuf_release(struct dma_buf *dmabuf)
 {
 	struct nvhost_syncpt_dmabuf_data *data = dmabuf->priv;
+	struct nvhost_master *host = data->host;
 
-	if (data->syncpt_id != SYNCPT_FULL)
-		nvhost_syncpt_put_ref(&data->host->syncpt, data->syncpt_id);
+	if (data->syncpt_id != SYNCPT_FULL) {
+		mutex_lock(&host->syncpt_dmabuf_mutex);
+		/* a concurrent re-export may have replaced the entry */
+		if (host->syncpt_dmabufs &&
+		    host->syncpt_dmabufs[data->syncpt_id] == dmabuf)
+			host->syncpt_dmabufs[data->syncpt_id] = NULL;
+		mutex_unlock(&host->syncpt_dmabuf_mutex);
+
+		nvhost_syncpt_put_ref(&host->syncpt, data->syncpt_id);
+	}
 
 	kfree(data);
 }
@@ -141,6 +186,25 @@ int nvhost_syncpt_dmabuf_alloc(
 			goto free_data;
 		}
 
+		/* re-exports return the already exported buffer */
+		dmabuf = nvhost_syncpt_dmabuf_cache_get(host, data->syncpt_id);
+		if (dmabuf) {
+			fd = dma_buf_fd(dmabuf, O_CLOEXEC);
+			if (fd < 0) {
+				err = fd;
+				dma_buf_put(dmabuf);
+				goto put_syncpt;
+			}
+			/* the cached dmabuf already holds a syncpt ref */
+			nvhost_syncpt_put_ref(&host->syncpt, data->syncpt_id);
+			kfree(data);
+
+			args->dmabuf_fd = fd;
+			args->nb_syncpts = 1;
+			args->syncpt_page_size = host->info.syncpt_page_size;
+			return 0;
+		}
+
 		offset = nvhost_syncpt_unit_interface_get_byte_offset(data->syncpt_id);
 		data->shim_pa = base + offset;
 		data->size = host->info.syncpt_page_size;
@@ -164,6 +228,10 @@ int nvhost_syncpt_dmabuf_alloc(
 		dma_buf_put(dmabuf);
 		goto put_syncpt;
 	}
+
+	if (!args->is_full_shim)
+		nvhost_syncpt_dmabuf_cache_add(host, data->syncpt_id, dmabuf);
+
 	args->dmabuf_fd = fd;
 	args->nb_syncpts = nb_syncpts;
 	args->syncpt_page_size = host->info.syncpt_page_size;
@@ -179,3 +247,71 @@ free_data:
 	return err;
 }
 
+int nvhost_syncpt_dmabuf_batch_alloc(
+	struct nvhost_master *host,
+	struct nvhost_ctrl_syncpt_dmabuf_batch_args *args)
+{
+	void __user *user_syncpt_fds =
+		(void __user *)(uintptr_t)args->syncpt_fds;
+	void __user *user_dmabuf_fds =
+		(void __user *)(uintptr_t)args->dmabuf_fds;
+	struct nvhost_ctrl_syncpt_dmabuf_args ex_args;
+	s32 *syncpt_fds, *dmabuf_fds;
+	u32 i, done = 0;
+	int err = 0;
+
+	if (!args->num_syncpts ||
+	    args->num_syncpts > NVHOST_SYNCPT_DMABUF_BATCH_MAX)
+		return -EINVAL;
+
+	syncpt_fds = kmalloc_array(args->num_syncpts,
+				sizeof(*syncpt_fds) + sizeof(*dmabuf_fds),
+				GFP_KERNEL);
+	if (!syncpt_fds) {
+		dev_err(&host->dev->dev, "failed to allocate fd arrays");
+		return -ENOMEM;
+	}
+	dmabuf_fds = syncpt_fds + args->num_syncpts;
+
+	if (copy_from_user(syncpt_fds, user_syncpt_fds,
+			args->num_syncpts * sizeof(*syncpt_fds))) {
+		dev_err(&host->dev->dev,
+			"failed to copy from user syncpt_fds=%px",
+			user_syncpt_fds);
+		err = -EFAULT;
+		goto free_fds;
+	}
+
+	/*
+	 * The first failing entry stops the batch and keeps its errno in
+	 * the entry itself; fds already installed stay valid. The ioctl
+	 * only fails when the batch cannot be transferred.
+	 */
+	for (i = 0; i < args->num_syncpts; i++) {
+		memset(&ex_args, 0, sizeof(ex_args));
+		ex_args.syncpt_fd = syncpt_fds[i];
+
+		dmabuf_fds[i] = nvhost_syncpt_dmabuf_alloc(host, &ex_args);
+		if (dmabuf_fds[i])
+			break;
+
+		dmabuf_fds[i] = ex_args.dmabuf_fd;
+		done++;
+	}
+
+	if (copy_to_user(user_dmabuf_fds, dmabuf_fds,
+			(done < args->num_syncpts ? done + 1 : done) *
+			sizeof(*dmabuf_fds))) {
+		dev_err(&host->dev->dev, "failed to copy to user");
+		err = -EFAULT;
+		goto free_fds;
+	}
+
+	args->num_done = done;
+	args->syncpt_page_size = host->info.syncpt_page_size;
+
+free_fds:
+	kfree(syncpt_fds);
+	return err;
+}
+
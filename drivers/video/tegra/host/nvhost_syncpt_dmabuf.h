@@ -8,9 +8,14 @@
 
 struct nvhost_master;
 struct nvhost_ctrl_syncpt_dmabuf_args;
+struct nvhost_ctrl_syncpt_dmabuf_batch_args;
 
 int nvhost_syncpt_dmabuf_alloc(
 	struct nvhost_master *host,
 	struct nvhost_ctrl_syncpt_dmabuf_args *args);
 
+int nvhost_syncpt_dmabuf_batch_alloc(
+	struct nvhost_master *host,
+	struct nvhost_ctrl_syncpt_dmabuf_batch_args *args);
+
 #endif
@@ -24,6 +24,7 @@
 #include <linux/io.h>
 #include <linux/nvmap_t19x.h>
 #include <linux/nvhost_t194.h>
+#include <linux/mutex.h>
 #include <linux/slab.h>
 
 #include "bus_client_t194.h"
@@ -86,6 +87,76 @@ u32 nvhost_syncpt_unit_interface_get_byte_offset(u32 syncpt_id)
 }
 EXPORT_SYMBOL(nvhost_syncpt_unit_interface_get_byte_offset);
 
+static void __iomem *syncpt_shim_cpu_map;
+static u32 syncpt_shim_cpu_nb_pts;
+static DEFINE_MUTEX(syncpt_shim_cpu_lock);
+
+/**
+ * nvhost_syncpt_unit_interface_snapshot() - Bulk-read the syncpoint bank
+ *
+ * @host_pdev:	Host1x pdev
+ * @values:	Caller buffer, one value per hardware syncpoint
+ * @nb_pts:	Number of entries in @values
+ *
+ * Return:	Number of syncpoints copied, a negative error code otherwise
+ *
+ * This function reads the current value of every hardware syncpoint
+ * through the MSS syncpoint shim aperture into the caller buffer in a
+ * single pass. The shim is a read-only view of the bank, so no per-id
+ * locking or shadow bookkeeping is involved; one relaxed MMIO read per
+ * syncpoint. This makes periodic full-state sampling for health
+ * monitoring much cheaper than looping over the per-id read paths.
+ *
+ * The CPU mapping of the shim is created on first use and kept for the
+ * lifetime of the kernel.
+ */
+int nvhost_syncpt_unit_interface_snapshot(struct platform_device *host_pdev,
+					  u32 *values, u32 nb_pts)
+{
+	struct nvhost_master *host = nvhost_get_prim_host();
+	u32 page_size = host->info.syncpt_page_size;
+	struct resource *res;
+	u32 count;
+	u32 i;
+
+	if (host_pdev == NULL || values == NULL) {
+		nvhost_err(NULL, "need nonNULL parameters");
+		return -EINVAL;
+	}
+
+	mutex_lock(&syncpt_shim_cpu_lock);
+	if (syncpt_shim_cpu_map == NULL) {
+		res = platform_get_resource_byname(host_pdev, IORESOURCE_MEM,
+						   "sem-syncpt-shim");
+		if (!res) {
+			mutex_unlock(&syncpt_shim_cpu_lock);
+			dev_err(&host_pdev->dev,
+				"failed to get syncpt aperture info");
+			return -ENXIO;
+		}
+
+		syncpt_shim_cpu_map = ioremap(res->start, resource_size(res));
+		if (!syncpt_shim_cpu_map) {
+			mutex_unlock(&syncpt_shim_cpu_lock);
+			dev_err(&host_pdev->dev,
+				"failed to map syncpt aperture");
+			return -ENOMEM;
+		}
+
+		syncpt_shim_cpu_nb_pts = min((u32)host->info.nb_hw_pts,
+				(u32)(resource_size(res) / page_size));
+	}
+	mutex_unlock(&syncpt_shim_cpu_lock);
+
+	count = min(nb_pts, syncpt_shim_cpu_nb_pts);
+	for (i = 0; i < count; i++)
+		values[i] = readl_relaxed(syncpt_shim_cpu_map +
+					  (size_t)i * page_size);
+
+	return count;
+}
+EXPORT_SYMBOL(nvhost_syncpt_unit_interface_snapshot);
+
 /**
  * nvhost_syncpt_address() - Get syncpoint IOVA for a device
  *
@@ -27,6 +27,75 @@
 #include "nvhost_vm.h"
 #include "dev.h"
 
+/*
+ * VM groups let cooperating processes share one engine address space.
+ * A group is keyed by a userspace-chosen token; its pointer is used as
+ * the vm identifier, so nvhost_vm_allocate() reuses the same vm for
+ * every member instead of building a per-process one.
+ */
+struct nvhost_vm_group {
+	u64 token;
+
+	/* reference to this group */
+	struct kref kref;
+
+	/* to track all groups in the system */
+	struct list_head list;
+};
+
+static DEFINE_MUTEX(vm_group_mutex);
+static LIST_HEAD(vm_group_list);
+
+void *nvhost_vm_group_get(u64 token)
+{
+	struct nvhost_vm_group *group;
+
+	mutex_lock(&vm_group_mutex);
+
+	list_for_each_entry(group, &vm_group_list, list) {
+		if (group->token == token &&
+		    kref_get_unless_zero(&group->kref)) {
+			mutex_unlock(&vm_group_mutex);
+			return group;
+		}
+	}
+
+	group = kzalloc(sizeof(*group), GFP_KERNEL);
+	if (!group) {
+		mutex_unlock(&vm_group_mutex);
+		return NULL;
+	}
+
+	kref_init(&group->kref);
+	group->token = token;
+	list_add_tail(&group->list, &vm_group_list);
+
+	mutex_unlock(&vm_group_mutex);
+
+	return group;
+}
+
+static void nvhost_vm_group_release(struct kref *kref)
+{
+	struct nvhost_vm_group *group =
+		container_of(kref, struct nvhost_vm_group, kref);
+
+	list_del(&group->list);
+	kfree(group);
+}
+
+void nvhost_vm_group_put(void *identifier)
+{
+	struct nvhost_vm_group *group = identifier;
+
+	if (!group)
+		return;
+
+	mutex_lock(&vm_group_mutex);
+	kref_put(&group->kref, nvhost_vm_group_release);
+	mutex_unlock(&vm_group_mutex);
+}
+
 int nvhost_vm_init(struct platform_device *pdev)
 {
 	return 0;
@@ -109,6 +109,29 @@ void nvhost_vm_get(struct nvhost_vm *vm);
 struct nvhost_vm *nvhost_vm_allocate(struct platform_device *pdev,
 				     void *identifier);
 
+/**
+ * nvhost_vm_group_get - Look up or create a vm group for a token
+ *	@token: userspace-chosen group key
+ *
+ * Returns an opaque identifier representing the group; passing it as
+ * the vm identifier makes all members of the group share one engine
+ * address space. Each successful call takes a reference that must be
+ * dropped with nvhost_vm_group_put().
+ *
+ * Returns the group identifier on success, NULL otherwise.
+ */
+void *nvhost_vm_group_get(u64 token);
+
+/**
+ * nvhost_vm_group_put - Drop reference to a vm group
+ *	@identifier: group identifier from nvhost_vm_group_get(), may be NULL
+ *
+ * The group is released when the last member drops its reference.
+ *
+ * No return value
+ */
+void nvhost_vm_group_put(void *identifier);
+
 static inline int nvhost_vm_get_hwid(struct platform_device *pdev,
 				     unsigned int id)
 {
@@ -1122,17 +1122,17 @@ pva_eventlib_record_perf_counter(struct platform_device *pdev,
 	perf_counter.minimum = min;
 	perf_counter.maximum = max;
 
-	keventlib_write(pdata->eventlib_id,
-			&perf_counter,
-			sizeof(perf_counter),
-			NVHOST_VPU_PERF_COUNTER_BEGIN,
-			timestamp_begin);
-
-	keventlib_write(pdata->eventlib_id,
-			&perf_counter,
-			sizeof(perf_counter),
-			NVHOST_VPU_PERF_COUNTER_END,
-			timestamp_end);
+	nvhost_eventlib_write(pdev,
+			      &perf_counter,
+			      sizeof(perf_counter),
+			      NVHOST_VPU_PERF_COUNTER_BEGIN,
+			      timestamp_begin);
+
+	nvhost_eventlib_write(pdev,
+			      &perf_counter,
+			      sizeof(perf_counter),
+			      NVHOST_VPU_PERF_COUNTER_END,
+			      timestamp_end);
 }
 static void
 pva_eventlib_record_r5_states(struct platform_device *pdev,
@@ -1153,55 +1153,55 @@ pva_eventlib_record_r5_states(struct platform_device *pdev,
 	state.queue_id	= 0;
 	state.iova	= 0;
 
-	keventlib_write(pdata->eventlib_id,
-			&state,
-			sizeof(state),
-			NVHOST_PVA_QUEUE_BEGIN,
-			stats->queued_time);
-
-	keventlib_write(pdata->eventlib_id,
-			&state,
-			sizeof(state),
-			NVHOST_PVA_QUEUE_END,
-			stats->vpu_assigned_time);
-
-	keventlib_write(pdata->eventlib_id,
-			&state,
-			sizeof(state),
-			NVHOST_PVA_PREPARE_BEGIN,
-			stats->vpu_assigned_time);
-
-	keventlib_write(pdata->eventlib_id,
-			&state,
-			sizeof(state),
-			NVHOST_PVA_PREPARE_END,
-			stats->vpu_start_time);
-
-	keventlib_write(pdata->eventlib_id,
-			&state,
-			sizeof(state),
-			stats->vpu_assigned == 0 ? NVHOST_PVA_VPU0_BEGIN
-						 : NVHOST_PVA_VPU1_BEGIN,
-			stats->vpu_start_time);
-
-	keventlib_write(pdata->eventlib_id,
-			&state,
-			sizeof(state),
-			stats->vpu_assigned == 0 ? NVHOST_PVA_VPU0_END
-						 : NVHOST_PVA_VPU1_END,
-			stats->vpu_complete_time);
-
-	keventlib_write(pdata->eventlib_id,
-			&state,
-			sizeof(state),
-			NVHOST_PVA_POST_BEGIN,
-			stats->vpu_complete_time);
-
-	keventlib_write(pdata->eventlib_id,
-			&state,
-			sizeof(state),
-			NVHOST_PVA_POST_END,
-			stats->complete_time);
+	nvhost_eventlib_write(pdev,
+			      &state,
+			      sizeof(state),
+			      NVHOST_PVA_QUEUE_BEGIN,
+			      stats->queued_time);
+
+	nvhost_eventlib_write(pdev,
+			      &state,
+			      sizeof(state),
+			      NVHOST_PVA_QUEUE_END,
+			      stats->vpu_assigned_time);
+
+	nvhost_eventlib_write(pdev,
+			      &state,
+			      sizeof(state),
+			      NVHOST_PVA_PREPARE_BEGIN,
+			      stats->vpu_assigned_time);
+
+	nvhost_eventlib_write(pdev,
+			      &state,
+			      sizeof(state),
+			      NVHOST_PVA_PREPARE_END,
+			      stats->vpu_start_time);
+
+	nvhost_eventlib_write(pdev,
+			      &state,
+			      sizeof(state),
+			      stats->vpu_assigned == 0 ? NVHOST_PVA_VPU0_BEGIN
+						       : NVHOST_PVA_VPU1_BEGIN,
+			      stats->vpu_start_time);
+
+	nvhost_eventlib_write(pdev,
+			      &state,
+			      sizeof(state),
+			      stats->vpu_assigned == 0 ? NVHOST_PVA_VPU0_END
+						       : NVHOST_PVA_VPU1_END,
+			      stats->vpu_complete_time);
+
+	nvhost_eventlib_write(pdev,
+			      &state,
+			      sizeof(state),
+			      NVHOST_PVA_POST_BEGIN,
+			      stats->vpu_complete_time);
+
+	nvhost_eventlib_write(pdev,
+			      &state,
+			      sizeof(state),
+			      NVHOST_PVA_POST_END,
+			      stats->complete_time);
 }
 #else
 static void
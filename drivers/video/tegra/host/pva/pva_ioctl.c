@@ -29,6 +29,7 @@
 #include <asm/ioctls.h>
 #include <asm/barrier.h>
 #include <linux/kref.h>
+#include <linux/vmalloc.h>
 #include <uapi/linux/nvdev_fence.h>
 #include <uapi/linux/nvpva_ioctl.h>
 #include <linux/firmware.h>
@@ -52,6 +53,11 @@ struct pva_private {
 	struct nvpva_queue *queue;
 	struct pva_cb *vpu_print_buffer;
 	struct nvpva_client_context *client;
+
+	/* preallocated submit scratch, guarded by submit_lock */
+	struct mutex submit_lock;
+	struct nvpva_ioctl_task *submit_tasks;
+	struct pva_submit_tasks *submit_header;
 };
 
 static int copy_part_from_user(void *kbuffer, size_t kbuffer_size,
@@ -336,7 +342,9 @@ static int pva_submit(struct pva_private *priv, void *arg)
 
 	num_tasks = ioctl_tasks_header->tasks.size / sizeof(*ioctl_tasks);
 	/* Sanity checks for the task heaader */
-	if (num_tasks > NVPVA_SUBMIT_MAX_TASKS) {
+	if ((num_tasks > NVPVA_SUBMIT_MAX_TASKS) ||
+	    (ioctl_tasks_header->tasks.size >
+	     (NVPVA_SUBMIT_MAX_TASKS * sizeof(*ioctl_tasks)))) {
 		err = -EINVAL;
 		dev_err(&priv->pva->pdev->dev,
 			"exceeds maximum number of tasks: %u > %u", num_tasks,
@@ -351,21 +359,15 @@ static int pva_submit(struct pva_private *priv, void *arg)
 	}
 
 
-	/* Allocate memory for the UMD representation of the tasks */
-	ioctl_tasks = kzalloc(ioctl_tasks_header->tasks.size, GFP_KERNEL);
-	if (ioctl_tasks == NULL) {
-		pr_err("pva: submit: allocation for tasks failed");
-		err = -ENOMEM;
-		goto out;
-	}
-
-	tasks_header = kzalloc(sizeof(struct pva_submit_tasks), GFP_KERNEL);
-	if (tasks_header == NULL) {
-		pr_err("pva: submit: allocation for tasks_header failed");
-		kfree(ioctl_tasks);
-		err = -ENOMEM;
-		goto out;
-	}
+	/*
+	 * Use the per-fd scratch allocated at open time for the UMD
+	 * representation of the tasks; submit is the fast path and should
+	 * not hit the allocator for every batch.
+	 */
+	mutex_lock(&priv->submit_lock);
+	ioctl_tasks = priv->submit_tasks;
+	tasks_header = priv->submit_header;
+	memset(tasks_header, 0, sizeof(*tasks_header));
 
 	/* Copy the tasks from userspace */
 	rest = copy_from_user(ioctl_tasks,
@@ -490,8 +492,7 @@ free_tasks:
 
 free_ioctl_tasks:
 
-	kfree(ioctl_tasks);
-	kfree(tasks_header);
+	mutex_unlock(&priv->submit_lock);
 
 out:
 	return err;
@@ -582,6 +583,7 @@ static int pva_register_vpu_exec(struct pva_private *priv, void *arg)
 			(struct nvpva_vpu_exe_register_out_arg *)arg;
 	struct pva_elf_image	*image;
 	void			*exec_data = NULL;
+	uint32_t		digest[PVA_ELF_DIGEST_WORDS];
 	uint16_t		exe_id;
 	bool			is_system = false;
 	uint64_t		data_size;
@@ -604,6 +606,16 @@ static int pva_register_vpu_exec(struct pva_private *priv, void *arg)
 		goto free_mem;
 	}
 
+	/* If the same program is already registered in this context, hand
+	 * out the cached image instead of authenticating, translating and
+	 * pinning the segments again
+	 */
+	pva_vpu_app_digest(exec_data, data_size, digest);
+	err = pva_find_vpu_app(&priv->client->elf_ctx, digest,
+			       data_size, &exe_id);
+	if (err == 0)
+		goto found;
+
 	err = pva_authenticate_vpu_app(priv->pva,
 				       &priv->pva->pva_auth,
 				       (uint8_t *)exec_data,
@@ -632,6 +644,13 @@ static int pva_register_vpu_exec(struct pva_private *priv, void *arg)
 		goto free_mem;
 	}
 
+	mutex_lock(&priv->client->elf_ctx.elf_mutex);
+	image = get_elf_image(&priv->client->elf_ctx, exe_id);
+	memcpy(image->elf_digest, digest, sizeof(image->elf_digest));
+	image->elf_size = data_size;
+	mutex_unlock(&priv->client->elf_ctx.elf_mutex);
+
+found:
 	reg_out->exe_id = exe_id;
 	image = get_elf_image(&priv->client->elf_ctx, exe_id);
 	reg_out->num_of_symbols = image->num_symbols -
@@ -955,6 +974,23 @@ static int pva_open(struct inode *inode, struct file *file)
 
 	file->private_data = priv;
 	priv->pva = pva;
+
+	/* scratch for the submit fast path, reused for every batch */
+	mutex_init(&priv->submit_lock);
+	priv->submit_tasks = vzalloc(NVPVA_SUBMIT_MAX_TASKS *
+				     sizeof(*priv->submit_tasks));
+	if (priv->submit_tasks == NULL) {
+		err = -ENOMEM;
+		goto err_alloc_submit_tasks;
+	}
+
+	priv->submit_header = kzalloc(sizeof(*priv->submit_header),
+				      GFP_KERNEL);
+	if (priv->submit_header == NULL) {
+		err = -ENOMEM;
+		goto err_alloc_submit_header;
+	}
+
 	priv->queue = nvpva_queue_alloc(pva->pool,
 					 MAX_PVA_TASK_COUNT_PER_QUEUE);
 
@@ -977,6 +1013,10 @@ err_alloc_context:
 	nvpva_queue_put(priv->queue);
 err_alloc_queue:
 	nvhost_module_remove_client(pdev, priv);
+	kfree(priv->submit_header);
+err_alloc_submit_header:
+	vfree(priv->submit_tasks);
+err_alloc_submit_tasks:
 	kfree(priv);
 err_alloc_priv:
 	return err;
@@ -1060,6 +1100,8 @@ static int pva_release(struct inode *inode, struct file *file)
 	}
 
 	/* Finally, release the private data */
+	kfree(priv->submit_header);
+	vfree(priv->submit_tasks);
 	kfree(priv);
 
 	return 0;
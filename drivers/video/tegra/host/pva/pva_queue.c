@@ -849,54 +849,54 @@ pva_eventlib_record_r5_states(struct platform_device *pdev,
 	state.queue_id		= stats->queue_id;
 	state.iova		= task->dma_addr;
 
-	keventlib_write(pdata->eventlib_id,
-			&state,
-			sizeof(state),
-			stats->vpu_assigned == 0 ? NVHOST_PVA_VPU0_BEGIN
-						 : NVHOST_PVA_VPU1_BEGIN,
-			stats->vpu_start_time);
-
-	keventlib_write(pdata->eventlib_id,
-			&state,
-			sizeof(state),
-			stats->vpu_assigned == 0 ? NVHOST_PVA_VPU0_END
-						 : NVHOST_PVA_VPU1_END,
-			stats->vpu_complete_time);
-	keventlib_write(pdata->eventlib_id,
-			&state,
-			sizeof(state),
-			NVHOST_PVA_PREPARE_END,
-			stats->vpu_start_time);
-	keventlib_write(pdata->eventlib_id,
-			&state,
-			sizeof(state),
-			NVHOST_PVA_POST_BEGIN,
-			stats->vpu_complete_time);
+	nvhost_eventlib_write(pdev,
+			      &state,
+			      sizeof(state),
+			      stats->vpu_assigned == 0 ? NVHOST_PVA_VPU0_BEGIN
+						       : NVHOST_PVA_VPU1_BEGIN,
+			      stats->vpu_start_time);
+
+	nvhost_eventlib_write(pdev,
+			      &state,
+			      sizeof(state),
+			      stats->vpu_assigned == 0 ? NVHOST_PVA_VPU0_END
+						       : NVHOST_PVA_VPU1_END,
+			      stats->vpu_complete_time);
+	nvhost_eventlib_write(pdev,
+			      &state,
+			      sizeof(state),
+			      NVHOST_PVA_PREPARE_END,
+			      stats->vpu_start_time);
+	nvhost_eventlib_write(pdev,
+			      &state,
+			      sizeof(state),
+			      NVHOST_PVA_POST_BEGIN,
+			      stats->vpu_complete_time);
 
 	if (task->pva->profiling_level >= 2) {
-		keventlib_write(pdata->eventlib_id,
-				&state,
-				sizeof(state),
-				NVHOST_PVA_QUEUE_BEGIN,
-				stats->queued_time);
-
-		keventlib_write(pdata->eventlib_id,
-				&state,
-				sizeof(state),
-				NVHOST_PVA_QUEUE_END,
-				stats->vpu_assigned_time);
-
-		keventlib_write(pdata->eventlib_id,
-				&state,
-				sizeof(state),
-				NVHOST_PVA_PREPARE_BEGIN,
-				stats->vpu_assigned_time);
-
-		keventlib_write(pdata->eventlib_id,
-				&state,
-				sizeof(state),
-				NVHOST_PVA_POST_END,
-				stats->complete_time);
+		nvhost_eventlib_write(pdev,
+				      &state,
+				      sizeof(state),
+				      NVHOST_PVA_QUEUE_BEGIN,
+				      stats->queued_time);
+
+		nvhost_eventlib_write(pdev,
+				      &state,
+				      sizeof(state),
+				      NVHOST_PVA_QUEUE_END,
+				      stats->vpu_assigned_time);
+
+		nvhost_eventlib_write(pdev,
+				      &state,
+				      sizeof(state),
+				      NVHOST_PVA_PREPARE_BEGIN,
+				      stats->vpu_assigned_time);
+
+		nvhost_eventlib_write(pdev,
+				      &state,
+				      sizeof(state),
+				      NVHOST_PVA_POST_END,
+				      stats->complete_time);
 	}
 }
 #else
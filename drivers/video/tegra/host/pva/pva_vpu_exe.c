@@ -22,6 +22,7 @@
 #include "pva.h"
 #include  "hw_vmem_pva.h"
 #include "pva_vpu_exe.h"
+#include "pva_sha256.h"
 
 #define ELF_MAXIMUM_SECTION_NAME 64
 #define ELF_EXPORTS_SECTION "EXPORTS"
@@ -927,6 +928,53 @@ int32_t pva_get_sym_info(struct nvpva_elf_context *d, uint16_t vpu_exe_id,
 	return err;
 }
 
+void pva_vpu_app_digest(const uint8_t *buffer, size_t size, uint32_t *digest)
+{
+	struct sha256_ctx_s ctx;
+	size_t off = (size / 64U) * 64U;
+
+	sha256_init(&ctx);
+	if (off > 0U)
+		pva_sha256_update(&ctx, buffer, off);
+
+	sha256_finalize(&ctx, buffer + off, size % 64U, digest);
+}
+
+int32_t pva_find_vpu_app(struct nvpva_elf_context *d, const uint32_t *digest,
+			 size_t size, uint16_t *exe_id)
+{
+	struct pva_elf_image *image = NULL;
+	uint32_t elf_alloc_table;
+	uint32_t id;
+	uint32_t i;
+	int32_t err = -ENOENT;
+
+	mutex_lock(&d->elf_mutex);
+	for (i = 0; i < NUM_ALLOC_SEGMENTS; i++) {
+		elf_alloc_table = d->elf_images->alloctable[i];
+		while (elf_alloc_table != 0U) {
+			id = rmos_get_first_set_bit(elf_alloc_table);
+			rmos_clear_bit32(id, &elf_alloc_table);
+			image = get_elf_image(d, (i * 32U) + id);
+			if ((image == NULL) ||
+			    (image->user_registered == false) ||
+			    (image->elf_size != size) ||
+			    (memcmp(image->elf_digest, digest,
+				    sizeof(image->elf_digest)) != 0))
+				continue;
+
+			image->reg_count += 1U;
+			*exe_id = image->elf_id;
+			err = 0;
+			goto out;
+		}
+	}
+out:
+	mutex_unlock(&d->elf_mutex);
+
+	return err;
+}
+
 int32_t
 pva_release_vpu_app(struct nvpva_elf_context *d, uint16_t exe_id, bool locked)
 {
@@ -935,6 +983,13 @@ pva_release_vpu_app(struct nvpva_elf_context *d, uint16_t exe_id, bool locked)
 
 	image = get_elf_image(d, exe_id);
 	if (image != NULL && image->user_registered == true) {
+		if (image->reg_count > 1U) {
+			/* Program is still registered through the cache */
+			image->reg_count -= 1U;
+			return 0;
+		}
+
+		image->reg_count = 0U;
 		image->user_registered = false;
 		if (atomic_read(&image->submit_refcount) <= 0)
 			(void)pva_unload_vpu_app(d, exe_id, locked);
@@ -1032,6 +1087,7 @@ int32_t pva_load_vpu_app(struct nvpva_elf_context *d, uint8_t *buffer,
 	}
 	*exe_id = assigned_exe_id;
 	image->user_registered = true;
+	image->reg_count = 1U;
 	(void)atomic_set(&image->submit_refcount, 0);
 out_elf_end:
 	if (err)
@@ -1051,7 +1107,15 @@ void pva_unload_all_apps(struct nvpva_elf_context *d)
 	for (i = 0; i < NUM_ALLOC_SEGMENTS; i++) {
 		elf_alloc_table = d->elf_images->alloctable[i];
 		while (elf_alloc_table != 0U) {
+			struct pva_elf_image *image;
+
 			id = rmos_get_first_set_bit(elf_alloc_table);
+			/* Drop all cached registrations; the context is
+			 * going away */
+			image = get_elf_image(d, (i * 32 + id));
+			if (image != NULL)
+				image->reg_count = 1U;
+
 			(void)pva_release_vpu_app(d, (i * 32 + id), true);
 			rmos_clear_bit32(id, &elf_alloc_table);
 		}
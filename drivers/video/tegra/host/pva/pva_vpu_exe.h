@@ -29,6 +29,8 @@
 #define MAX_NUM_VPU_EXE		65535U
 #define ALOC_SEGMENT_SIZE	32U
 #define NUM_ALLOC_SEGMENTS	((MAX_NUM_VPU_EXE + 1)/ALOC_SEGMENT_SIZE)
+/* Number of 32 bit words in the SHA-256 digest identifying an ELF file */
+#define PVA_ELF_DIGEST_WORDS	8U
 
 /**
  * enum to identify different types of symbols
@@ -119,6 +121,13 @@ struct pva_elf_image {
 	/**<True if user has successfully registered a VPU ELF */
 	bool user_registered;
 	bool is_system_app;
+	/**<SHA-256 digest of the registered ELF file, used to de-duplicate
+	 * repeated registrations of the same program */
+	uint32_t elf_digest[PVA_ELF_DIGEST_WORDS];
+	/**< Size in bytes of the registered ELF file */
+	size_t elf_size;
+	/**< Number of user registrations sharing this image */
+	uint32_t reg_count;
 	/**<Count of how many tasks submitted to FW use this ELF image */
 	atomic_t submit_refcount;
 	/**< Number of symbols in the VPU app */
@@ -153,6 +162,35 @@ struct nvpva_elf_context {
 };
 
 /* following functions to deal with UMD request */
+/**
+ * Compute the SHA-256 digest identifying a VPU ELF file for the
+ * program cache
+ *
+ * @param *buffer	Buffer containing the VPU APP elf file
+ * @param size		Size of the VPU APP elf file
+ * @param *digest	Digest filled by this function, must hold
+ *			PVA_ELF_DIGEST_WORDS words
+ */
+void pva_vpu_app_digest(const uint8_t *buffer, size_t size, uint32_t *digest);
+
+/**
+ * Look up an already registered VPU APP with identical contents
+ *
+ * If a registered image with the same digest and size exists, its
+ * registration count is raised and its ID is returned, so the caller
+ * can skip authentication and ELF translation entirely.
+ *
+ * @param d		Pointer to Elf Context
+ * @param *digest	Digest of the VPU APP elf file being registered
+ * @param size		Size of the VPU APP elf file
+ * @param *exe_id	ID of the matching VPU APP, filled on success
+ *
+ * @return		0 if a matching image was found else -ENOENT
+ */
+int32_t pva_find_vpu_app(struct nvpva_elf_context *d, const uint32_t *digest,
+			 size_t size, uint16_t *exe_id);
+
+
 /**
  * Get Symbol info given the symbol name from a vpu app
  *
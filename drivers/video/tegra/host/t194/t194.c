@@ -310,6 +310,7 @@ struct nvhost_device_data t19_nvdec_info = {
 	.ctrl_ops		= &tegra_nvdec_ctrl_ops,
 	.num_channels		= 1,
 	.serialize		= true,
+	.pipelined_submits	= true,
 	.push_work_done		= true,
 	.resource_policy	= RESOURCE_PER_CHANNEL_INSTANCE,
 	.vm_regs		= {{0x30, true}, {0x34, false} },
@@ -355,6 +356,7 @@ struct nvhost_device_data t19_nvdec1_info = {
 	.ctrl_ops		= &tegra_nvdec_ctrl_ops,
 	.num_channels		= 1,
 	.serialize		= true,
+	.pipelined_submits	= true,
 	.push_work_done		= true,
 	.resource_policy	= RESOURCE_PER_CHANNEL_INSTANCE,
 	.vm_regs		= {{0x30, true}, {0x34, false} },
@@ -289,6 +289,7 @@ struct nvhost_device_data t23x_nvdec_info = {
 	.ctrl_ops		= &tegra_nvdec_ctrl_ops,
 	.num_channels		= 1,
 	.serialize		= true,
+	.pipelined_submits	= true,
 	.push_work_done		= true,
 	.resource_policy	= RESOURCE_PER_CHANNEL_INSTANCE,
 	.vm_regs		= {{0x30, true}, {0x34, false} },
@@ -397,6 +398,7 @@ struct nvhost_device_data t23x_ofa_info = {
 	.num_channels		= 1,
 	.firmware_name		= "nvhost_ofa012.fw",
 	.firmware_not_in_subdir = true,
+	.preload_fw		= true,
 	.serialize		= true,
 	.push_work_done		= true,
 	.resource_policy	= RESOURCE_PER_CHANNEL_INSTANCE,
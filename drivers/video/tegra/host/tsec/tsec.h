@@ -30,6 +30,8 @@ int nvhost_tsec_prepare_poweroff(struct platform_device *dev);
 void nvhost_tsec_isr(void);
 int nvhost_tsec_send_cmd(void *flcn_cmd, u32 queue_id,
 	void (*callback_func)(void *msg));
+int nvhost_tsec_queue_cmd(void *flcn_cmd, u32 queue_id,
+	void (*callback_func)(void *msg), bool urgent);
 int nvhost_t23x_tsec_intr_init(struct platform_device *pdev);
 int nvhost_tsec_cmdif_open(void);
 void nvhost_tsec_cmdif_close(void);
@@ -24,6 +24,7 @@
 #define HDCP_SIZE_VPRIME_2X_8                (256/8)
 #define HDCP_SIZE_SEQ_NUM_M_8                3
 #define HDCP_SIZE_MPRIME_8                   (256/8)
+#define HDCP_SIZE_EPAIR_8                    96
 
 #define NV_PSEC_THI_METHOD1                  0x00000044      /* RW-4R */
 #define NV_PSEC_THI_METHOD0                  0x00000040      /* RW-4R */
@@ -227,6 +228,10 @@ struct hdcp_context_t {
 	/* display type is 0 for HDMI and 1 for DP */
 	u32				display_type;
 	u32				session_id;
+	/* sealed pairing blob from ENCRYPT_PAIRING_INFO, input to the
+	 * stored-Km session resumption path
+	 */
+	u8				e_pair[HDCP_SIZE_EPAIR_8];
 	struct nvhdcp_msg               msg;
 };
 
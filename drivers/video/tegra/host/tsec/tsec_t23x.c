@@ -18,6 +18,7 @@
 
 #include <linux/slab.h>         /* for kzalloc */
 #include <linux/delay.h>	/* for udelay */
+#include <linux/workqueue.h>	/* for the cmd dispatch worker */
 #include <linux/iommu.h>
 #include <linux/iopoll.h>
 #include <linux/dma-mapping.h>
@@ -52,6 +53,7 @@ static bool s_riscv_booted;
 /* Pointer to this device */
 static struct platform_device *tsec;
 static void (*cmd_resp_callback)(void *);
+static void nvhost_tsec_cmdq_flush(void);
 
 /* Configuration for bootloader */
 typedef struct {
@@ -402,6 +404,8 @@ int nvhost_tsec_finalize_poweron_t23x(struct platform_device *dev)
 
 int nvhost_tsec_prepare_poweroff_t23x(struct platform_device *dev)
 {
+	nvhost_tsec_cmdq_flush();
+
 	/*
 	 * Below call is redundant, but there are something statically declared
 	 * in $(srctree.nvidia)/drivers/video/tegra/host/tsec/tsec.c,
@@ -544,37 +548,31 @@ static int validate_cmd(union RM_FLCN_CMD *flcn_cmd,  u32 queue_id)
 	return 0;
 }
 
+static u32 cmdq_start;
+static DEFINE_SPINLOCK(tsec_cmdq_lock);
+
 /*
- * cmd - Falcon command
- * queue_id - ID of queue (usually 0)
- * callback_func - callback func to caller on command completion
- *
+ * Commands accepted by nvhost_tsec_queue_cmd() but not yet pushed to
+ * the hardware queue. The dispatch worker serves the priority backlog
+ * first, so latency-sensitive commands overtake queued background work.
  */
-int nvhost_tsec_send_cmd(void *cmd, u32 queue_id,
-	void (*callback_func)(void *))
-{
-	int i;
-	u32 head;
-	u32 tail;
-	u8 cmd_size;
-	u32 cmdq_head_base;
-	u32 cmdq_tail_base;
-	u32 cmdq_head_stride;
-	u32 cmdq_tail_stride;
-	u32 cmdq_size = 0x80;
-	static u32 cmdq_start;
-	union RM_FLCN_CMD *flcn_cmd;
-	struct RM_FLCN_QUEUE_HDR hdr;
+static LIST_HEAD(tsec_cmdq_backlog);
+static LIST_HEAD(tsec_cmdq_backlog_prio);
+static void tsec_cmdq_dispatch_func(struct work_struct *work);
+static DECLARE_WORK(tsec_cmdq_dispatch_work, tsec_cmdq_dispatch_func);
 
-	if (!s_riscv_booted) {
-		pr_err_once("TSEC RISCV hasn't booted successfully\n");
-		return -ENODEV;
-	}
+struct tsec_queued_cmd {
+	struct list_head node;
+	union RM_FLCN_CMD cmd;
+	u32 queue_id;
+};
 
-	cmdq_head_base = tsec_queue_head_r(0);
-	cmdq_head_stride = tsec_queue_head_r(1) - tsec_queue_head_r(0);
-	cmdq_tail_base = tsec_queue_tail_r(0);
-	cmdq_tail_stride = tsec_queue_tail_r(1) - tsec_queue_tail_r(0);
+/* Discover the command queue offset programmed by the firmware */
+static u32 tsec_get_cmdq_start(u32 queue_id)
+{
+	int i;
+	u32 cmdq_tail_base = tsec_queue_tail_r(0);
+	u32 cmdq_tail_stride = tsec_queue_tail_r(1) - tsec_queue_tail_r(0);
 
 	for (i = 0; !cmdq_start && i < TSEC_POLL_TIME_MS; i++) {
 		cmdq_start = host1x_readl(tsec, (cmdq_tail_base +
@@ -583,17 +581,11 @@ int nvhost_tsec_send_cmd(void *cmd, u32 queue_id,
 			udelay(TSEC_TAIL_POLL_TIME);
 	}
 
-	if (!cmdq_start) {
-		dev_warn(&tsec->dev, "cmdq_start=0x%x\n", cmdq_start);
-		return -ENODEV;
-	}
-
-	if (validate_cmd(cmd, queue_id != 0)) {
-		dev_dbg(&tsec->dev, "CMD: %s: %d Invalid command\n",
-			__func__, __LINE__);
-		return -EINVAL;
-	}
+	return cmdq_start;
+}
 
+static void tsec_set_cmd_callback(void (*callback_func)(void *))
+{
 	if ((cmd_resp_callback == NULL) && (callback_func == NULL)) {
 		dev_dbg(&tsec->dev, "CMD: %s: %d No Callback set up. Can't notify client\n",
 			__func__, __LINE__);
@@ -603,50 +595,52 @@ int nvhost_tsec_send_cmd(void *cmd, u32 queue_id,
 	} else {
 		cmd_resp_callback = callback_func;
 	}
+}
+
+/*
+ * Push one command into the hardware queue without waiting for room.
+ * Returns -EAGAIN when the queue cannot take the command right now;
+ * the caller decides whether to poll or to retry on the next
+ * completion interrupt. Must be called with tsec_cmdq_lock held.
+ */
+static int tsec_cmd_try_enqueue(union RM_FLCN_CMD *flcn_cmd, u32 queue_id)
+{
+	u32 head;
+	u32 tail;
+	u8 cmd_size = flcn_cmd->cmdGen.hdr.size;
+	u32 cmdq_size = 0x80;
+	u32 cmdq_head_base = tsec_queue_head_r(0);
+	u32 cmdq_head_stride = tsec_queue_head_r(1) - tsec_queue_head_r(0);
+	u32 cmdq_tail_base = tsec_queue_tail_r(0);
+	u32 cmdq_tail_stride = tsec_queue_tail_r(1) - tsec_queue_tail_r(0);
+	struct RM_FLCN_QUEUE_HDR hdr;
 
-	flcn_cmd = (union RM_FLCN_CMD *)cmd;
-	cmd_size = flcn_cmd->cmdGen.hdr.size;
 	head = host1x_readl(tsec,
 		(cmdq_head_base + (queue_id * cmdq_head_stride)));
-
-check_space:
 	tail = host1x_readl(tsec, (cmdq_tail_base +
 				   (queue_id * cmdq_tail_stride)));
 	if (head < cmdq_start || tail < cmdq_start)
 		pr_err("***** head/tail invalid, h=0x%x,t=0x%x\n", head, tail);
 
 	if (tail > head) {
-		if ((head + cmd_size) < tail)
-			goto enqueue;
-		udelay(TSEC_TAIL_POLL_TIME);
-		goto check_space;
-	} else {
-
-		if ((head + cmd_size) < (cmdq_start + cmdq_size)) {
-			goto enqueue;
-		} else {
-			if ((cmdq_start + cmd_size) < tail) {
-				goto rewind;
-			} else {
-				udelay(TSEC_TAIL_POLL_TIME);
-				goto check_space;
-			}
-		}
+		if ((head + cmd_size) >= tail)
+			return -EAGAIN;
+	} else if ((head + cmd_size) >= (cmdq_start + cmdq_size)) {
+		if ((cmdq_start + cmd_size) >= tail)
+			return -EAGAIN;
+
+		hdr.unitId = RM_GSP_UNIT_REWIND;
+		hdr.size = RM_FLCN_QUEUE_HDR_SIZE;
+		hdr.ctrlFlags = 0;
+		hdr.seqNumId = 0;
+		if (emem_copy_to(head, (u8 *)&hdr, hdr.size, 0))
+			return -EINVAL;
+		head = cmdq_start;
+		host1x_writel(tsec, (cmdq_head_base +
+				     (queue_id * cmdq_head_stride)), head);
+		pr_debug("CMDQ: rewind h=%x,t=%x\n", head, tail);
 	}
 
-rewind:
-	hdr.unitId = RM_GSP_UNIT_REWIND;
-	hdr.size = RM_FLCN_QUEUE_HDR_SIZE;
-	hdr.ctrlFlags = 0;
-	hdr.seqNumId = 0;
-	if (emem_copy_to(head, (u8 *)&hdr, hdr.size, 0))
-		return -EINVAL;
-	head = cmdq_start;
-	host1x_writel(tsec, (cmdq_head_base +
-			     (queue_id * cmdq_head_stride)), head);
-	pr_debug("CMDQ: rewind h=%x,t=%x\n", head, tail);
-
-enqueue:
 	if (emem_copy_to(head, (u8 *)flcn_cmd, cmd_size, 0))
 		return -EINVAL;
 	head += ALIGN(cmd_size, 4);
@@ -656,6 +650,148 @@ enqueue:
 	return 0;
 }
 
+/*
+ * cmd - Falcon command
+ * queue_id - ID of queue (usually 0)
+ * callback_func - callback func to caller on command completion
+ *
+ */
+int nvhost_tsec_send_cmd(void *cmd, u32 queue_id,
+	void (*callback_func)(void *))
+{
+	int i;
+	int err = -EAGAIN;
+
+	if (!s_riscv_booted) {
+		pr_err_once("TSEC RISCV hasn't booted successfully\n");
+		return -ENODEV;
+	}
+
+	if (!tsec_get_cmdq_start(queue_id)) {
+		dev_warn(&tsec->dev, "cmdq_start=0x%x\n", cmdq_start);
+		return -ENODEV;
+	}
+
+	if (validate_cmd(cmd, queue_id != 0)) {
+		dev_dbg(&tsec->dev, "CMD: %s: %d Invalid command\n",
+			__func__, __LINE__);
+		return -EINVAL;
+	}
+
+	tsec_set_cmd_callback(callback_func);
+
+	for (i = 0; (err == -EAGAIN) && (i < TSEC_POLL_TIME_MS); i++) {
+		spin_lock(&tsec_cmdq_lock);
+		err = tsec_cmd_try_enqueue((union RM_FLCN_CMD *)cmd, queue_id);
+		spin_unlock(&tsec_cmdq_lock);
+		if (err == -EAGAIN)
+			udelay(TSEC_TAIL_POLL_TIME);
+	}
+
+	return (err == -EAGAIN) ? -ETIMEDOUT : err;
+}
+
+static void tsec_cmdq_dispatch_func(struct work_struct *work)
+{
+	struct tsec_queued_cmd *qcmd;
+	struct list_head *backlog;
+	int err;
+
+	spin_lock(&tsec_cmdq_lock);
+	for (;;) {
+		if (!list_empty(&tsec_cmdq_backlog_prio))
+			backlog = &tsec_cmdq_backlog_prio;
+		else if (!list_empty(&tsec_cmdq_backlog))
+			backlog = &tsec_cmdq_backlog;
+		else
+			break;
+
+		qcmd = list_first_entry(backlog, struct tsec_queued_cmd, node);
+		err = tsec_cmd_try_enqueue(&qcmd->cmd, qcmd->queue_id);
+		if (err == -EAGAIN)
+			/* hw queue full; the completion irq re-kicks us */
+			break;
+		list_del(&qcmd->node);
+		if (err)
+			dev_err(&tsec->dev, "CMD: dropping queued cmd, err=%d\n",
+				err);
+		kfree(qcmd);
+	}
+	spin_unlock(&tsec_cmdq_lock);
+}
+
+/*
+ * Queued variant of nvhost_tsec_send_cmd(). The command is copied to a
+ * software backlog and pushed to the hardware queue by a worker, so the
+ * caller never busy-waits for queue space and multiple commands can be
+ * outstanding at once. Urgent commands are dispatched ahead of queued
+ * background work.
+ *
+ * cmd - Falcon command
+ * queue_id - ID of queue (usually 0)
+ * callback_func - callback func to caller on command completion
+ * urgent - serve this command before non-urgent backlog entries
+ */
+int nvhost_tsec_queue_cmd(void *cmd, u32 queue_id,
+	void (*callback_func)(void *), bool urgent)
+{
+	struct tsec_queued_cmd *qcmd;
+	union RM_FLCN_CMD *flcn_cmd = (union RM_FLCN_CMD *)cmd;
+
+	if (!s_riscv_booted) {
+		pr_err_once("TSEC RISCV hasn't booted successfully\n");
+		return -ENODEV;
+	}
+
+	if (!tsec_get_cmdq_start(queue_id)) {
+		dev_warn(&tsec->dev, "cmdq_start=0x%x\n", cmdq_start);
+		return -ENODEV;
+	}
+
+	if (validate_cmd(cmd, queue_id != 0)) {
+		dev_dbg(&tsec->dev, "CMD: %s: %d Invalid command\n",
+			__func__, __LINE__);
+		return -EINVAL;
+	}
+
+	tsec_set_cmd_callback(callback_func);
+
+	qcmd = kzalloc(sizeof(*qcmd), GFP_KERNEL);
+	if (!qcmd)
+		return -ENOMEM;
+
+	memcpy(&qcmd->cmd, flcn_cmd, flcn_cmd->cmdGen.hdr.size);
+	qcmd->queue_id = queue_id;
+
+	spin_lock(&tsec_cmdq_lock);
+	list_add_tail(&qcmd->node,
+		urgent ? &tsec_cmdq_backlog_prio : &tsec_cmdq_backlog);
+	spin_unlock(&tsec_cmdq_lock);
+
+	schedule_work(&tsec_cmdq_dispatch_work);
+
+	return 0;
+}
+
+/* Drop backlog commands that can no longer reach the engine */
+static void nvhost_tsec_cmdq_flush(void)
+{
+	struct tsec_queued_cmd *qcmd, *tmp;
+	LIST_HEAD(purge);
+
+	cancel_work_sync(&tsec_cmdq_dispatch_work);
+
+	spin_lock(&tsec_cmdq_lock);
+	list_splice_init(&tsec_cmdq_backlog_prio, &purge);
+	list_splice_tail_init(&tsec_cmdq_backlog, &purge);
+	spin_unlock(&tsec_cmdq_lock);
+
+	list_for_each_entry_safe(qcmd, tmp, &purge, node) {
+		list_del(&qcmd->node);
+		kfree(qcmd);
+	}
+}
+
 static irqreturn_t process_msg(int irq, void *args)
 {
 	int i;
@@ -759,6 +895,15 @@ FAIL:
 			(msgq_tail_base + (msgq_tail_stride * queue_id)), tail);
 	}
 
+	/*
+	 * All completions delivered with this interrupt have been drained
+	 * above, so one kick is enough to dispatch whatever backlog the
+	 * freed queue space can now take.
+	 */
+	if (!list_empty(&tsec_cmdq_backlog_prio) ||
+	    !list_empty(&tsec_cmdq_backlog))
+		schedule_work(&tsec_cmdq_dispatch_work);
+
 exit:
 	return IRQ_HANDLED;
 }
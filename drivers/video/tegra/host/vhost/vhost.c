@@ -131,6 +131,16 @@ static u64 vhost_virt_connect(int moduleid)
 	return (err || msg.ret) ? 0 : p->connection_id;
 }
 
+/*
+ * Synchronous control-plane exchange with the VM server.
+ *
+ * Note that the command queue only carries control messages (connect,
+ * suspend, resume). Job submission does not transit IVC: channels are
+ * either owned by the guest (vmserver_owns_engines == false) and jobs
+ * are written to the push buffer directly, or owned by the server and
+ * submitted through the separate push buffer queue. There is no
+ * per-job message on this path to batch or aggregate.
+ */
 int vhost_sendrecv(struct tegra_vhost_cmd_msg *msg)
 {
 	void *handle;
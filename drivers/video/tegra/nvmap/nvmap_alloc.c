@@ -21,6 +21,9 @@
 #include <linux/random.h>
 #include <linux/version.h>
 #include <linux/io.h>
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 14, 0)
+#include <linux/sched/clock.h>
+#endif
 #if KERNEL_VERSION(4, 15, 0) > LINUX_VERSION_CODE
 #include <soc/tegra/chip-id.h>
 #else
@@ -815,6 +818,7 @@ int nvmap_alloc_handle(struct nvmap_client *client,
 	int err = -ENOMEM;
 	int tag, i;
 	bool alloc_from_excl = false;
+	u64 start_ns = 0;
 
 	h = nvmap_handle_get(h);
 
@@ -840,6 +844,15 @@ int nvmap_alloc_handle(struct nvmap_client *client,
 	else
 		h->flags = (flags & NVMAP_HANDLE_CACHE_FLAG);
 	h->align = max_t(size_t, align, L1_CACHE_BYTES);
+	/*
+	 * Big-block allocations are aligned (and padded by the heap) to
+	 * PMD granularity so that physically contiguous carveout memory
+	 * can be mapped with 2MB block entries in the CPU and SMMU page
+	 * tables instead of individual 4K entries.
+	 */
+	if ((flags & NVMAP_HANDLE_BIG_BLOCKS) &&
+	    (heap_mask & NVMAP_HEAP_CARVEOUT_MASK))
+		h->align = max_t(size_t, h->align, PMD_SIZE);
 	h->peer = peer;
 	tag = flags >> 16;
 
@@ -880,6 +893,8 @@ int nvmap_alloc_handle(struct nvmap_client *client,
 	alloc_policy = alloc_from_excl ? heap_policy_excl :
 			(nr_page == 1) ? heap_policy_small : heap_policy_large;
 
+	start_ns = sched_clock();
+
 	while (!h->alloc && *alloc_policy) {
 		unsigned int heap_type;
 
@@ -904,6 +919,8 @@ int nvmap_alloc_handle(struct nvmap_client *client,
 
 out:
 	if (h->alloc) {
+		nvmap_stats_lat(h->heap_pgalloc ? NL_IOVMM : NL_CARVEOUT,
+				sched_clock() - start_ns);
 		if (client->kernel_client)
 			nvmap_stats_inc(NS_KALLOC, h->size);
 		else
@@ -973,6 +990,13 @@ void _nvmap_handle_free(struct nvmap_handle *h)
 {
 	unsigned int i, nr_page, page_index = 0;
 	struct nvmap_handle_dmabuf_priv *curr, *next;
+	struct nvmap_deferred_maint *range, *range_next;
+
+	/* drop any maintenance still recorded against the handle */
+	list_for_each_entry_safe(range, range_next, &h->deferred_maint, list) {
+		list_del(&range->list);
+		kfree(range);
+	}
 
 	list_for_each_entry_safe(curr, next, &h->dmabuf_priv, list) {
 		curr->priv_release(curr->priv);
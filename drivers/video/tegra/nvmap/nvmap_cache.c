@@ -288,7 +288,7 @@ int __nvmap_cache_maint(struct nvmap_client *client,
 	int err = 0;
 
 	if (!op->addr || op->op < NVMAP_CACHE_OP_WB ||
-	    op->op > NVMAP_CACHE_OP_WB_INV)
+	    op->op > NVMAP_CACHE_OP_WB_DEFER)
 		return -EINVAL;
 
 	handle = nvmap_handle_get_from_id(client, op->handle);
@@ -317,8 +317,12 @@ int __nvmap_cache_maint(struct nvmap_client *client,
 		(vma->vm_pgoff << PAGE_SHIFT);
 	end = start + op->len;
 
-	err = __nvmap_do_cache_maint(client, priv->handle, start, end, op->op,
-				     false);
+	if (op->op == NVMAP_CACHE_OP_WB_DEFER)
+		err = nvmap_cache_maint_defer(priv->handle, start, end,
+					      NVMAP_CACHE_OP_WB);
+	else
+		err = __nvmap_do_cache_maint(client, priv->handle, start, end,
+					     op->op, false);
 out:
 	nvmap_release_mmap_read_lock(current->mm);
 	nvmap_handle_put(handle);
@@ -440,6 +444,100 @@ inline int nvmap_do_cache_maint_list(struct nvmap_handle **handles,
 	return 0;
 }
 
+/*
+ * Record a dirty range for deferred maintenance instead of flushing it
+ * synchronously. Overlapping or adjacent ranges with the same op are
+ * coalesced in place, so repeated writes to the same region of a large
+ * buffer cost one list entry and, later, one flush.
+ */
+int nvmap_cache_maint_defer(struct nvmap_handle *h, unsigned long start,
+			    unsigned long end, unsigned int op)
+{
+	struct nvmap_deferred_maint *range, *pos, *tmp;
+
+	h = nvmap_handle_get(h);
+	if (!h)
+		return -EFAULT;
+
+	if (start >= h->size || end > h->size) {
+		nvmap_handle_put(h);
+		return -EFAULT;
+	}
+
+	/* no CPU maintenance is ever needed for these handles */
+	if (h->flags == NVMAP_HANDLE_UNCACHEABLE ||
+	    h->flags == NVMAP_HANDLE_WRITE_COMBINE) {
+		nvmap_handle_put(h);
+		return 0;
+	}
+
+	range = kmalloc(sizeof(*range), GFP_KERNEL);
+	if (!range) {
+		nvmap_handle_put(h);
+		return -ENOMEM;
+	}
+
+	range->start = start;
+	range->end = end;
+	range->op = op;
+
+	spin_lock(&h->deferred_lock);
+	list_for_each_entry_safe(pos, tmp, &h->deferred_maint, list) {
+		if (pos->op != op)
+			continue;
+		if (pos->start > range->end || pos->end < range->start)
+			continue;
+		range->start = min(range->start, pos->start);
+		range->end = max(range->end, pos->end);
+		list_del(&pos->list);
+		kfree(pos);
+	}
+	list_add_tail(&range->list, &h->deferred_maint);
+	spin_unlock(&h->deferred_lock);
+
+	nvmap_handle_put(h);
+	return 0;
+}
+
+/*
+ * Issue all maintenance recorded against a handle. Called from the
+ * dmabuf map path so that deferred ranges are clean before any device
+ * access; on IO-coherent chips the ranges are simply discarded.
+ */
+int nvmap_cache_maint_flush_deferred(struct nvmap_handle *h)
+{
+	struct nvmap_deferred_maint *pos, *tmp;
+	LIST_HEAD(ranges);
+	bool skip = false;
+	int err = 0;
+
+	if (list_empty(&h->deferred_maint))
+		return 0;
+
+	spin_lock(&h->deferred_lock);
+	list_splice_init(&h->deferred_maint, &ranges);
+	spin_unlock(&h->deferred_lock);
+
+	/* SCF keeps the caches coherent from T194 onwards */
+#if (LINUX_VERSION_CODE < KERNEL_VERSION(4, 14, 0))
+	if (tegra_get_chip_id() == TEGRA194)
+		skip = true;
+#else
+	if (soc_device_match(&tegra194_soc) || soc_device_match(&tegra234_soc))
+		skip = true;
+#endif
+
+	list_for_each_entry_safe(pos, tmp, &ranges, list) {
+		if (!skip && !err)
+			err = __nvmap_do_cache_maint(h->owner, h, pos->start,
+						     pos->end, pos->op, false);
+		list_del(&pos->list);
+		kfree(pos);
+	}
+
+	return err;
+}
+
 int nvmap_cache_debugfs_init(struct dentry *nvmap_root)
 {
 	struct dentry *cache_root;
@@ -480,10 +480,26 @@ static long nvmap_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 		err = nvmap_ioctl_handle_from_sci_ipc_id(filp, uarg);
 		break;
 
+	case NVMAP_IOC_GET_SCIIPCID_BULK:
+		err = nvmap_ioctl_get_sci_ipc_id_bulk(filp, uarg);
+		break;
+
+	case NVMAP_IOC_HANDLE_FROM_SCIIPCID_BULK:
+		err = nvmap_ioctl_handle_from_sci_ipc_id_bulk(filp, uarg);
+		break;
+
 	case NVMAP_IOC_QUERY_HEAP_PARAMS:
 		err = nvmap_ioctl_query_heap_params(filp, uarg);
 		break;
 
+	case NVMAP_IOC_WRITE_DIRECT:
+		err = nvmap_ioctl_write_direct(filp, uarg);
+		break;
+
+	case NVMAP_IOC_POOL_PRESSURE:
+		err = nvmap_ioctl_pool_pressure(filp, uarg);
+		break;
+
 	default:
 		pr_warn("Unknown NVMAP_IOC = 0x%x\n", cmd);
 	}
@@ -1521,6 +1537,10 @@ int __init nvmap_probe(struct platform_device *pdev)
 	if (e)
 		goto fail_heaps;
 
+	/* dma-buf heap bridge is best effort; nvmap works without it */
+	if (nvmap_dmaheap_init())
+		dev_err(&pdev->dev, "unable to register dma-buf heaps\n");
+
 #ifdef CVNAS_BUILTIN
 	if (tegra_get_chip_id() == TEGRA194) {
 		phys_addr_t cvs_base = nvcvnas_get_cvsram_base();
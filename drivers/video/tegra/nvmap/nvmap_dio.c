@@ -0,0 +1,187 @@
+/*
+ * drivers/video/tegra/nvmap/nvmap_dio.c
+ *
+ * Direct-IO bridge for nvmap handles
+ *
+ * Copyright (c) 2022, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ */
+
+#define pr_fmt(fmt)	"nvmap: %s() " fmt, __func__
+
+#include <linux/bvec.h>
+#include <linux/file.h>
+#include <linux/fs.h>
+#include <linux/nvmap.h>
+#include <linux/slab.h>
+#include <linux/uaccess.h>
+#include <linux/uio.h>
+#include <linux/version.h>
+
+#include "nvmap_ioctl.h"
+#include "nvmap_priv.h"
+
+/*
+ * Build a bio_vec array describing [h_offs, h_offs + count) of the
+ * handle. Carveout handles are physically contiguous, so their pages
+ * come straight from the block base; sysmem handles use the pgalloc
+ * page array. The handle must stay referenced and pinned while the
+ * array is in flight.
+ */
+static struct bio_vec *nvmap_handle_to_bvec(struct nvmap_handle *h,
+					    u64 h_offs, u64 count,
+					    unsigned int *ret_nr)
+{
+	unsigned long first_pg = h_offs >> PAGE_SHIFT;
+	unsigned long last_pg = (h_offs + count - 1) >> PAGE_SHIFT;
+	unsigned int nr = last_pg - first_pg + 1;
+	unsigned int offs = offset_in_page(h_offs);
+	struct bio_vec *bvec;
+	unsigned int i;
+
+	bvec = nvmap_altalloc(sizeof(*bvec) * nr);
+	if (!bvec)
+		return NULL;
+
+	for (i = 0; i < nr; i++) {
+		struct page *page;
+
+		if (h->heap_pgalloc)
+			page = nvmap_to_page(h->pgalloc.pages[first_pg + i]);
+		else
+			page = phys_to_page(h->carveout->base +
+					    ((first_pg + i) << PAGE_SHIFT));
+
+		bvec[i].bv_page = page;
+		bvec[i].bv_offset = offs;
+		bvec[i].bv_len = min_t(u64, PAGE_SIZE - offs, count);
+		count -= bvec[i].bv_len;
+		offs = 0;
+	}
+
+	*ret_nr = nr;
+	return bvec;
+}
+
+/*
+ * Write handle contents to an O_DIRECT file without bouncing through an
+ * intermediate user buffer: the handle's pages are handed to the
+ * filesystem as the iov_iter source, so the block layer DMAs straight
+ * out of the carveout (or sysmem) backing. Caches are cleaned first so
+ * the storage controller observes what the CPU last wrote.
+ */
+static ssize_t nvmap_do_direct_write(struct nvmap_handle *h,
+				     struct file *file, u64 h_offs,
+				     u64 f_offs, u64 count)
+{
+	struct bio_vec *bvec;
+	struct iov_iter iter;
+	unsigned int nr_bvecs;
+	loff_t pos = f_offs;
+	ssize_t written;
+	int err;
+
+	/* make lazily recorded ranges clean before the device reads them */
+	nvmap_cache_maint_flush_deferred(h);
+	err = __nvmap_do_cache_maint(NULL, h, h_offs, h_offs + count,
+				     NVMAP_CACHE_OP_WB, false);
+	if (err)
+		return err;
+
+	bvec = nvmap_handle_to_bvec(h, h_offs, count, &nr_bvecs);
+	if (!bvec)
+		return -ENOMEM;
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 0, 0)
+	iov_iter_bvec(&iter, ITER_SOURCE, bvec, nr_bvecs, count);
+#else
+	iov_iter_bvec(&iter, WRITE, bvec, nr_bvecs, count);
+#endif
+	written = vfs_iter_write(file, &iter, &pos, 0);
+
+	nvmap_altfree(bvec, sizeof(*bvec) * nr_bvecs);
+	return written;
+}
+
+int nvmap_ioctl_write_direct(struct file *filp, void __user *arg)
+{
+	struct nvmap_client *client = filp->private_data;
+	struct nvmap_direct_write op;
+	struct nvmap_handle *h;
+	struct file *file;
+	ssize_t written;
+	int err = 0;
+
+	if (copy_from_user(&op, arg, sizeof(op)))
+		return -EFAULT;
+
+	if (!op.count)
+		return -EINVAL;
+
+	h = nvmap_handle_get_from_id(client, op.handle);
+	if (IS_ERR_OR_NULL(h))
+		return -EINVAL;
+
+	/* reading out VPR contents is never allowed */
+	if (h->heap_type == NVMAP_HEAP_CARVEOUT_VPR) {
+		err = -EPERM;
+		goto put_handle;
+	}
+
+	if (!h->alloc || !(h->heap_type & nvmap_dev->cpu_access_mask)) {
+		err = -EPERM;
+		goto put_handle;
+	}
+
+	if (op.handle_offset + op.count < op.handle_offset ||
+	    op.handle_offset + op.count > h->size) {
+		err = -EINVAL;
+		goto put_handle;
+	}
+
+	file = fget(op.file_fd);
+	if (!file) {
+		err = -EBADF;
+		goto put_handle;
+	}
+
+	/*
+	 * Only O_DIRECT targets qualify; a buffered write would copy the
+	 * frames into the page cache, which is what this path avoids.
+	 */
+	if (!(file->f_flags & O_DIRECT) || !file->f_op->write_iter) {
+		err = -EINVAL;
+		goto put_file;
+	}
+
+	/* hold the backing in place while the block layer owns the pages */
+	atomic_inc(&h->pin);
+	written = nvmap_do_direct_write(h, file, op.handle_offset,
+					op.file_offset, op.count);
+	atomic_dec(&h->pin);
+
+	if (written < 0) {
+		err = written;
+		written = 0;
+	} else if (written < op.count) {
+		err = -EINTR;
+	}
+
+	op.result = written;
+	if (copy_to_user(arg, &op, sizeof(op)))
+		err = -EFAULT;
+
+put_file:
+	fput(file);
+put_handle:
+	nvmap_handle_put(h);
+	return err;
+}
@@ -93,6 +93,7 @@ struct sg_table *_nvmap_dmabuf_map_dma_buf(
 	struct dma_buf_attachment *attach, enum dma_data_direction dir)
 {
 	struct nvmap_handle_info *info = attach->dmabuf->priv;
+	struct iommu_domain *domain;
 	int ents = 0;
 	struct sg_table *sgt;
 #ifdef NVMAP_CONFIG_DEBUG_MAPS
@@ -113,11 +114,34 @@ struct sg_table *_nvmap_dmabuf_map_dma_buf(
 		(dir != DMA_TO_DEVICE))
 		return ERR_PTR(-EACCES);
 
+	/* make any lazily recorded ranges clean before device access */
+	nvmap_cache_maint_flush_deferred(info->handle);
+
 	nvmap_lru_reset(info->handle);
 	mutex_lock(&info->maps_lock);
 
 	atomic_inc(&info->handle->pin);
 
+	/*
+	 * Devices behind the same IOMMU domain share translations, so an
+	 * existing mapping of this handle in the domain can be reused
+	 * instead of repeating the iommu_map work.
+	 */
+	domain = iommu_get_domain_for_dev(attach->dev);
+	if (domain && info->handle->alloc &&
+	    info->handle->heap_type != NVMAP_HEAP_CARVEOUT_VPR &&
+	    (nvmap_dev->dynamic_dma_map_mask & info->handle->heap_type)) {
+		struct nvmap_dmabuf_map *map;
+
+		list_for_each_entry(map, &info->maps, entry) {
+			if (map->domain == domain && map->dir == dir) {
+				atomic_inc(&map->refs);
+				sgt = map->sgt;
+				goto out;
+			}
+		}
+	}
+
 	sgt = __nvmap_sg_table(NULL, info->handle);
 	if (IS_ERR(sgt)) {
 		atomic_dec(&info->handle->pin);
@@ -139,8 +163,24 @@ struct sg_table *_nvmap_dmabuf_map_dma_buf(
 					sgt->nents, dir, __DMA_ATTR(attrs));
 		if (ents <= 0)
 			goto err_map;
+
+		if (domain &&
+		    info->handle->heap_type != NVMAP_HEAP_CARVEOUT_VPR) {
+			struct nvmap_dmabuf_map *map;
+
+			/* stash for reuse; skip silently if oom */
+			map = kzalloc(sizeof(*map), GFP_KERNEL);
+			if (map) {
+				map->domain = domain;
+				map->dir = dir;
+				map->sgt = sgt;
+				atomic_set(&map->refs, 1);
+				list_add(&map->entry, &info->maps);
+			}
+		}
 	}
 
+out:
 	attach->priv = sgt;
 
 #ifdef NVMAP_CONFIG_DEBUG_MAPS
@@ -174,6 +214,7 @@ void _nvmap_dmabuf_unmap_dma_buf(struct dma_buf_attachment *attach,
 				       enum dma_data_direction dir)
 {
 	struct nvmap_handle_info *info = attach->dmabuf->priv;
+	struct nvmap_dmabuf_map *map, *found = NULL;
 #ifdef NVMAP_CONFIG_DEBUG_MAPS
 	char *device_name = NULL;
 	u32 heap_type = 0;
@@ -188,6 +229,20 @@ void _nvmap_dmabuf_unmap_dma_buf(struct dma_buf_attachment *attach,
 		return;
 	}
 
+	list_for_each_entry(map, &info->maps, entry) {
+		if (map->sgt == sgt) {
+			found = map;
+			break;
+		}
+	}
+	if (found) {
+		/* keep the mapping while other attachments still use it */
+		if (!atomic_dec_and_test(&found->refs))
+			goto out;
+		list_del(&found->entry);
+		kfree(found);
+	}
+
 	if (!(nvmap_dev->dynamic_dma_map_mask & info->handle->heap_type)) {
 		sg_dma_address(sgt->sgl) = 0;
 	} else if (info->handle->heap_type == NVMAP_HEAP_CARVEOUT_VPR &&
@@ -200,6 +255,7 @@ void _nvmap_dmabuf_unmap_dma_buf(struct dma_buf_attachment *attach,
 	}
 	__nvmap_free_sg_table(NULL, info->handle, sgt);
 
+out:
 #ifdef NVMAP_CONFIG_DEBUG_MAPS
 	/* Remove the device name from the list of carveout accessing devices */
 	heap_type = info->handle->heap_type;
@@ -354,9 +410,11 @@ int __nvmap_map(struct nvmap_handle *h, struct vm_area_struct *vma)
 	}
 	priv->handle = h;
 
+	/* VM_MIXEDMAP allows the fault handler to insert a cluster of
+	 * pages per fault via vm_insert_page() */
 	vma->vm_flags |= VM_SHARED | VM_DONTEXPAND |
 			  VM_DONTDUMP | VM_DONTCOPY |
-			  (h->heap_pgalloc ? 0 : VM_PFNMAP);
+			  (h->heap_pgalloc ? VM_MIXEDMAP : VM_PFNMAP);
 	vma->vm_ops = &nvmap_vma_ops;
 	BUG_ON(vma->vm_private_data != NULL);
 	vma->vm_private_data = priv;
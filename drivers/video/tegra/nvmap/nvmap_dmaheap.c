@@ -0,0 +1,141 @@
+/*
+ * drivers/video/tegra/nvmap/nvmap_dmaheap.c
+ *
+ * Expose nvmap heaps through the dma-buf heap interface
+ *
+ * Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ */
+
+#define pr_fmt(fmt)	"nvmap: %s() " fmt, __func__
+
+#include <linux/dma-buf.h>
+#include <linux/dma-heap.h>
+#include <linux/slab.h>
+
+#include "nvmap_priv.h"
+
+/*
+ * One instance per registered heap; resolves the dma-buf heap back to the
+ * nvmap heap mask the allocation should be satisfied from.
+ */
+struct nvmap_dmaheap {
+	unsigned int heap_bit;
+};
+
+/* kernel client owning in-flight allocations until the fd is installed */
+static struct nvmap_client *nvmap_dmaheap_client;
+
+static int nvmap_dmaheap_allocate(struct dma_heap *heap, unsigned long len,
+				  unsigned long fd_flags,
+				  unsigned long heap_flags)
+{
+	struct nvmap_dmaheap *dh = dma_heap_get_drvdata(heap);
+	struct nvmap_handle_ref *ref;
+	struct dma_buf *dmabuf;
+	int err, fd;
+
+	ref = nvmap_create_handle(nvmap_dmaheap_client, len, false);
+	if (IS_ERR(ref))
+		return PTR_ERR(ref);
+
+	err = nvmap_alloc_handle(nvmap_dmaheap_client, ref->handle,
+				 dh->heap_bit, PAGE_SIZE,
+				 0, /* no kind */
+				 NVMAP_HANDLE_CACHEABLE,
+				 NVMAP_IVM_INVALID_PEER);
+	if (err)
+		goto free_handle;
+
+	/*
+	 * Hand the buffer's lifetime over to the fd: take a ref for it, then
+	 * drop the bridge client's bookkeeping ref so the allocation is
+	 * released when the last dma_buf user goes away.
+	 */
+	dmabuf = ref->handle->dmabuf;
+	get_dma_buf(dmabuf);
+	fd = dma_buf_fd(dmabuf, fd_flags);
+	if (fd < 0) {
+		dma_buf_put(dmabuf);
+		err = fd;
+		goto free_handle;
+	}
+	nvmap_free_handle(nvmap_dmaheap_client, ref->handle, false);
+	return fd;
+
+free_handle:
+	nvmap_free_handle(nvmap_dmaheap_client, ref->handle, false);
+	return err;
+}
+
+static const struct dma_heap_ops nvmap_dmaheap_ops = {
+	.allocate = nvmap_dmaheap_allocate,
+};
+
+/*
+ * The name must outlive the heap; carveout names point into platform data
+ * and the iovmm name is a literal, so no copy is taken here.
+ */
+static int nvmap_dmaheap_add(const char *name, unsigned int heap_bit)
+{
+	struct dma_heap_export_info exp_info;
+	struct nvmap_dmaheap *dh;
+	struct dma_heap *heap;
+
+	dh = kzalloc(sizeof(*dh), GFP_KERNEL);
+	if (!dh)
+		return -ENOMEM;
+	dh->heap_bit = heap_bit;
+
+	exp_info.name = name;
+	exp_info.ops = &nvmap_dmaheap_ops;
+	exp_info.priv = dh;
+
+	heap = dma_heap_add(&exp_info);
+	if (IS_ERR(heap)) {
+		kfree(dh);
+		return PTR_ERR(heap);
+	}
+
+	return 0;
+}
+
+int nvmap_dmaheap_init(void)
+{
+	int i, err;
+
+	nvmap_dmaheap_client = __nvmap_create_client(nvmap_dev, "dmaheap");
+	if (!nvmap_dmaheap_client)
+		return -ENOMEM;
+
+	mutex_lock(&nvmap_dev->carveout_lock);
+	for (i = 0; i < nvmap_dev->nr_carveouts; i++) {
+		struct nvmap_carveout_node *node = &nvmap_dev->heaps[i];
+
+		/* IVM carveouts need peer state the heap ABI can't carry */
+		if (node->heap_bit & NVMAP_HEAP_CARVEOUT_IVM)
+			continue;
+
+		err = nvmap_dmaheap_add(node->carveout->name, node->heap_bit);
+		if (err)
+			pr_err("couldn't register heap %s: %d\n",
+			       node->carveout->name, err);
+	}
+	mutex_unlock(&nvmap_dev->carveout_lock);
+
+	if (!nvmap_convert_iovmm_to_carveout) {
+		err = nvmap_dmaheap_add("iovmm", NVMAP_HEAP_IOVMM);
+		if (err)
+			pr_err("couldn't register heap iovmm: %d\n", err);
+	}
+
+	return 0;
+}
@@ -17,9 +17,19 @@
 
 #include <trace/events/nvmap.h>
 #include <linux/highmem.h>
+#include <linux/module.h>
 
 #include "nvmap_priv.h"
 
+/*
+ * Number of pages mapped per fault. CPU post-processing tends to walk
+ * whole buffers linearly, so mapping a cluster of pages around each
+ * fault collapses the minor fault storm to one fault per cluster.
+ * Set to 1 to fall back to strict one-page-per-fault behaviour.
+ */
+static unsigned int nvmap_fault_around_pages = 16;
+module_param(nvmap_fault_around_pages, uint, 0644);
+
 static void nvmap_vma_close(struct vm_area_struct *vma);
 
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 4, 0)
@@ -175,6 +185,63 @@ static void nvmap_vma_close(struct vm_area_struct *vma)
 	}
 }
 
+/* inner cache maint and dirty tracking for a page about to be mapped */
+static void nvmap_fault_page_maint(struct nvmap_handle *h, unsigned long pgoffs,
+				   struct page *page)
+{
+	void *kaddr;
+
+	if (!nvmap_handle_track_dirty(h))
+		return;
+
+	mutex_lock(&h->lock);
+	if (nvmap_page_dirty(h->pgalloc.pages[pgoffs])) {
+		mutex_unlock(&h->lock);
+		return;
+	}
+
+	kaddr = kmap(page);
+	BUG_ON(!kaddr);
+	inner_cache_maint(NVMAP_CACHE_OP_WB_INV, kaddr, PAGE_SIZE);
+	kunmap(page);
+
+	nvmap_page_mkdirty(&h->pgalloc.pages[pgoffs]);
+	atomic_inc(&h->pgalloc.ndirty);
+	mutex_unlock(&h->lock);
+}
+
+/*
+ * Speculatively map the pages following the faulting one. Best effort;
+ * the pages that could not be inserted fault in one by one as before.
+ */
+static void nvmap_fault_around(struct vm_area_struct *vma,
+			       struct nvmap_vma_priv *priv,
+			       unsigned long address, unsigned long offs)
+{
+	struct nvmap_handle *h = priv->handle;
+	unsigned int i;
+
+	for (i = 1; i < nvmap_fault_around_pages; i++) {
+		struct page *page;
+
+		address += PAGE_SIZE;
+		offs += PAGE_SIZE;
+
+		if (address >= vma->vm_end || offs >= h->size)
+			break;
+
+		page = nvmap_to_page(h->pgalloc.pages[offs >> PAGE_SHIFT]);
+
+		if (PageAnon(page) && (vma->vm_flags & VM_SHARED))
+			break;
+
+		nvmap_fault_page_maint(h, offs >> PAGE_SHIFT, page);
+
+		if (vm_insert_page(vma, address, page))
+			break;
+	}
+}
+
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 4, 0)
 static vm_fault_t nvmap_vma_fault(struct vm_fault *vmf)
 #define vm_insert_pfn vmf_insert_pfn
@@ -212,48 +279,45 @@ static int nvmap_vma_fault(struct vm_area_struct *vma, struct vm_fault *vmf)
 		BUG_ON(priv->handle->carveout->base & ~PAGE_MASK);
 		pfn = ((priv->handle->carveout->base + offs) >> PAGE_SHIFT);
 		if (!pfn_valid(pfn)) {
-			vm_insert_pfn(vma,
-				(unsigned long)vmf_address, pfn);
+			unsigned long addr = (unsigned long)vmf_address;
+			unsigned int i;
+
+			vm_insert_pfn(vma, addr, pfn);
+
+			/* speculatively map the pfns that follow */
+			for (i = 1; i < nvmap_fault_around_pages; i++) {
+				addr += PAGE_SIZE;
+				offs += PAGE_SIZE;
+				pfn++;
+
+				if (addr >= vma->vm_end ||
+				    offs >= priv->handle->size ||
+				    pfn_valid(pfn))
+					break;
+
+				vm_insert_pfn(vma, addr, pfn);
+			}
 			return VM_FAULT_NOPAGE;
 		}
 		/* CMA memory would get here */
 		page = pfn_to_page(pfn);
 	} else {
-		void *kaddr;
-
-		offs >>= PAGE_SHIFT;
 		if (atomic_read(&priv->handle->pgalloc.reserved))
 			return VM_FAULT_SIGBUS;
-		page = nvmap_to_page(priv->handle->pgalloc.pages[offs]);
+		page = nvmap_to_page(priv->handle->pgalloc.pages[offs >> PAGE_SHIFT]);
 
 		if (PageAnon(page) && (vma->vm_flags & VM_SHARED))
 			return VM_FAULT_SIGSEGV;
 
-		if (!nvmap_handle_track_dirty(priv->handle))
-			goto finish;
-
-		mutex_lock(&priv->handle->lock);
-		if (nvmap_page_dirty(priv->handle->pgalloc.pages[offs])) {
-			mutex_unlock(&priv->handle->lock);
-			goto finish;
-		}
-
-		/* inner cache maint */
-		kaddr  = kmap(page);
-		BUG_ON(!kaddr);
-		inner_cache_maint(NVMAP_CACHE_OP_WB_INV, kaddr, PAGE_SIZE);
-		kunmap(page);
-
-		if (priv->handle->flags & NVMAP_HANDLE_INNER_CACHEABLE)
-			goto make_dirty;
+		nvmap_fault_page_maint(priv->handle, offs >> PAGE_SHIFT, page);
 
-make_dirty:
-		nvmap_page_mkdirty(&priv->handle->pgalloc.pages[offs]);
-		atomic_inc(&priv->handle->pgalloc.ndirty);
-		mutex_unlock(&priv->handle->lock);
+		/* __nvmap_map() marks page-backed mappings VM_MIXEDMAP;
+		 * skip fault-around on vmas that predate the flag */
+		if (vma->vm_flags & VM_MIXEDMAP)
+			nvmap_fault_around(vma, priv,
+					   (unsigned long)vmf_address, offs);
 	}
 
-finish:
 	if (page)
 		get_page(page);
 	vmf->page = page;
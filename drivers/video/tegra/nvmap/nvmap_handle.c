@@ -245,6 +245,8 @@ struct nvmap_handle_ref *nvmap_create_handle(struct nvmap_client *client,
 	INIT_LIST_HEAD(&h->vmas);
 	INIT_LIST_HEAD(&h->lru);
 	INIT_LIST_HEAD(&h->dmabuf_priv);
+	INIT_LIST_HEAD(&h->deferred_maint);
+	spin_lock_init(&h->deferred_lock);
 
 	/*
 	 * This takes out 1 ref on the dambuf. This corresponds to the
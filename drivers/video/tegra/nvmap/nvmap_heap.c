@@ -23,6 +23,7 @@
 #include <linux/list.h>
 #include <linux/mm.h>
 #include <linux/mutex.h>
+#include <linux/seq_file.h>
 #include <linux/slab.h>
 #include <linux/err.h>
 #include <linux/bug.h>
@@ -104,8 +105,93 @@ size_t nvmap_query_heap_size(struct nvmap_heap *heap)
 	return heap->len;
 }
 
+/*
+ * Walk the allocated blocks and measure the free extents between them.
+ * The report shows how close the heap is to failing a large contiguous
+ * request long before it actually does: largest_free is the biggest
+ * request that can still succeed, and the fragmentation percentage is
+ * the share of free space that is unusable for it.
+ */
+static int nvmap_heap_frag_show(struct seq_file *s, void *unused)
+{
+	struct nvmap_heap *heap = s->private;
+	size_t largest_free = 0, free_total = 0;
+	unsigned int nr_blocks = 0, nr_extents = 0, nr_small = 0;
+	phys_addr_t cursor, heap_end;
+	struct list_block *b;
+
+	mutex_lock(&heap->lock);
+
+	heap_end = heap->base + heap->len;
+	cursor = heap->base;
+
+	while (cursor < heap_end) {
+		phys_addr_t next_base = heap_end;
+		bool in_block = false;
+		size_t gap;
+
+		/* find the block covering or following the cursor */
+		list_for_each_entry(b, &heap->all_list, all_list) {
+			phys_addr_t bbase = b->block.base;
+
+			if (bbase <= cursor && cursor < bbase + b->size) {
+				cursor = bbase + b->size;
+				in_block = true;
+				break;
+			}
+			if (bbase > cursor && bbase < next_base)
+				next_base = bbase;
+		}
+
+		if (in_block)
+			continue;
+
+		gap = next_base - cursor;
+		free_total += gap;
+		nr_extents++;
+		if (gap > largest_free)
+			largest_free = gap;
+		cursor = next_base;
+	}
+
+	list_for_each_entry(b, &heap->all_list, all_list) {
+		nr_blocks++;
+		if (b->size <= NVMAP_SMALL_CLASS_SIZE)
+			nr_small++;
+	}
+
+	seq_printf(s, "heap          %s\n", heap->name);
+	seq_printf(s, "total         %zu\n", heap->len);
+	seq_printf(s, "free          %zu\n", free_total);
+	seq_printf(s, "largest_free  %zu\n", largest_free);
+	seq_printf(s, "free_extents  %u\n", nr_extents);
+	seq_printf(s, "blocks        %u\n", nr_blocks);
+	seq_printf(s, "small_blocks  %u\n", nr_small);
+	seq_printf(s, "alloc_fails   %llu\n", heap->alloc_fail_cnt);
+	if (free_total)
+		seq_printf(s, "fragmentation %llu%%\n",
+			   (u64)(free_total - largest_free) * 100 / free_total);
+
+	mutex_unlock(&heap->lock);
+	return 0;
+}
+
+static int nvmap_heap_frag_open(struct inode *inode, struct file *file)
+{
+	return single_open(file, nvmap_heap_frag_show, inode->i_private);
+}
+
+static const struct file_operations nvmap_heap_frag_fops = {
+	.open = nvmap_heap_frag_open,
+	.read = seq_read,
+	.llseek = seq_lseek,
+	.release = single_release,
+};
+
 void nvmap_heap_debugfs_init(struct dentry *heap_root, struct nvmap_heap *heap)
 {
+	debugfs_create_file("fragmentation", S_IRUGO, heap_root, heap,
+			    &nvmap_heap_frag_fops);
 	if (sizeof(heap->base) == sizeof(u64))
 		debugfs_create_x64("base", S_IRUGO,
 			heap_root, (u64 *)&heap->base);
@@ -251,6 +337,12 @@ static struct nvmap_heap_block *do_heap_alloc(struct nvmap_heap *heap,
 	if (heap->is_ivm)
 		align = max_t(size_t, align, NVMAP_IVM_ALIGNMENT);
 
+	/* big-block allocations are padded to full PMDs so both their
+	 * base and size allow block mappings; the coherent pool places
+	 * PMD multiples on PMD boundaries. */
+	if (align >= PMD_SIZE)
+		len = ALIGN(len, PMD_SIZE);
+
 	heap_block = kmem_cache_zalloc(heap_block_cache, GFP_KERNEL);
 	if (!heap_block) {
 		dev_err(dev, "%s: failed to alloc heap block %s\n",
@@ -260,6 +352,7 @@ static struct nvmap_heap_block *do_heap_alloc(struct nvmap_heap *heap,
 
 	dev_base = nvmap_alloc_mem(heap, len, start);
 	if (dma_mapping_error(dev, dev_base)) {
+		heap->alloc_fail_cnt++;
 		dev_err(dev, "failed to alloc mem of size (%zu)\n",
 			len);
 #ifdef NVMAP_CONFIG_VPR_RESIZE
@@ -45,6 +45,8 @@ struct nvmap_heap {
 	int peer; /* Used only if is_ivm == true */
 	int vm_id; /* Used only if is_ivm == true */
 	struct nvmap_pm_ops pm_ops;
+	/* number of failed contiguous allocations, for fragmentation stats */
+	u64 alloc_fail_cnt;
 #ifdef NVMAP_CONFIG_DEBUG_MAPS
 	struct rb_root device_names;
 #endif /* NVMAP_CONFIG_DEBUG_MAPS */
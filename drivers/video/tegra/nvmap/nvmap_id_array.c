@@ -38,25 +38,44 @@ int nvmap_id_array_id_alloc(struct xarray *id_arr, u32 *id, struct dma_buf *dmab
 
 /*
  * Clear mapping between the id(NvRmMemHandle) and dma_buf
+ *
+ * Waits for a grace period after unpublishing the entry so that
+ * lookups which found it before the erase have taken their dma_buf
+ * reference by the time this returns. The caller can then safely drop
+ * the reference the entry pinned. Frees are rare next to lookups, so
+ * the removal side pays for the lock-free readers.
  */
 struct dma_buf *nvmap_id_array_id_release(struct xarray *id_arr, u32 id)
 {
+	struct dma_buf *dmabuf;
+
 	if (!id_arr || !id)
 		return NULL;
 
-	return xa_erase(id_arr, id);
+	dmabuf = xa_erase(id_arr, id);
+	if (!IS_ERR_OR_NULL(dmabuf))
+		synchronize_rcu();
+
+	return dmabuf;
 }
 
 /*
  * Return dma_buf from the id.
+ *
+ * Lock-free: the xarray publishes its slots with RCU, and holding the
+ * read lock across the ref get keeps nvmap_id_array_id_release() from
+ * releasing the entry's dma_buf reference underneath us. ID resolution
+ * therefore never contends with lookups on other CPUs.
  */
 struct dma_buf *nvmap_id_array_get_dmabuf_from_id(struct xarray *id_arr, u32 id)
 {
 	struct dma_buf *dmabuf;
 
+	rcu_read_lock();
 	dmabuf = xa_load(id_arr, id);
 	if (!IS_ERR_OR_NULL(dmabuf))
 		get_dma_buf(dmabuf);
+	rcu_read_unlock();
 
 	return dmabuf;
 }
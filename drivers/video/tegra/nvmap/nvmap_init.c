@@ -23,6 +23,7 @@
 #include <linux/version.h>
 #include <linux/kmemleak.h>
 #include <linux/io.h>
+#include <linux/sizes.h>
 
 #if defined(NVMAP_LOADABLE_MODULE)
 #include <linux/nvmap_t19x.h>
@@ -357,6 +358,7 @@ static void *__nvmap_dma_alloc_from_coherent(struct device *dev,
 	unsigned int count;
 	unsigned int alloc_size;
 	unsigned long align;
+	unsigned long class_start;
 	void *addr = NULL;
 	struct page **pages = NULL;
 	int do_memset = 0;
@@ -398,14 +400,47 @@ static void *__nvmap_dma_alloc_from_coherent(struct device *dev,
 			align = (1 << DMA_BUF_ALIGNMENT) - 1;
 		else
 			align = (1 << order) - 1;
+		/*
+		 * Big-block carveout requests arrive padded to PMD
+		 * multiples; place them on PMD boundaries so the CPU
+		 * and SMMU mappers can use 2MB block entries. The
+		 * DMA_BUF_ALIGNMENT cap would otherwise stop short of
+		 * PMD alignment.
+		 */
+		if (dma_get_attr(DMA_ATTR_ALLOC_EXACT_SIZE, attrs) &&
+		    size >= PMD_SIZE &&
+		    IS_ALIGNED((unsigned long)size, PMD_SIZE))
+			align = max(align, (PMD_SIZE >> PAGE_SHIFT) - 1);
 	}
 
+	/*
+	 * Size-class segregated placement: small contiguous requests scan
+	 * from the top quarter of the region, leaving the low region to
+	 * large allocations, which keep first-fit from the caller's start.
+	 * The split is a placement preference, not a partition; a small
+	 * request that does not fit in the top quarter falls back to a
+	 * full first-fit scan below.
+	 */
+	class_start = start;
+	if (alloc_size == count &&
+	    dma_get_attr(DMA_ATTR_ALLOC_EXACT_SIZE, attrs) &&
+	    size <= NVMAP_SMALL_CLASS_SIZE &&
+	    (mem->size >> 2) > (NVMAP_SMALL_CLASS_SIZE >> PAGE_SHIFT))
+		class_start = max(start, mem->size - (mem->size >> 2));
+
 	while (count) {
 		pageno = bitmap_find_next_zero_area(mem->bitmap, mem->size,
-						    start, alloc_size, align);
+						    class_start, alloc_size,
+						    align);
 
-		if (pageno >= mem->size)
+		if (pageno >= mem->size) {
+			if (class_start != start) {
+				/* preferred class region is full */
+				class_start = start;
+				continue;
+			}
 			goto err;
+		}
 
 		count -= alloc_size;
 		if (pages)
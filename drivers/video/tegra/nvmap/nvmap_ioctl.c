@@ -1249,6 +1249,107 @@ int nvmap_ioctl_handle_from_sci_ipc_id(struct file *filp, void __user *arg)
 exit:
 	return ret;
 }
+
+#define NVMAP_SCIIPC_BULK_MAX_ENTRIES	1024
+
+static int nvmap_sciipc_export_one(struct nvmap_client *client,
+				   NvSciIpcEndpointVuid pr_vuid,
+				   struct nvmap_sciipc_map_entry *e)
+{
+	struct nvmap_handle *handle;
+	bool is_ro;
+	int ret;
+
+	handle = nvmap_handle_get_from_id(client, e->handle);
+	if (IS_ERR_OR_NULL(handle))
+		return -ENODEV;
+
+	is_ro = is_nvmap_id_ro(client, e->handle);
+
+	/* Cannot create RW handle from RO handle */
+	if (is_ro && (e->flags != PROT_READ)) {
+		ret = -EPERM;
+		goto put;
+	}
+
+	ret = nvmap_create_sci_ipc_id(client, handle, e->flags,
+			&e->sci_ipc_id, pr_vuid, is_ro);
+put:
+	nvmap_handle_put(handle);
+	return ret;
+}
+
+/*
+ * Move an array of handles in one transaction with a single
+ * authentication pass. On failure the entries processed before the
+ * failing one keep their results.
+ */
+static int nvmap_ioctl_sci_ipc_bulk(struct file *filp, void __user *arg,
+				    bool is_export)
+{
+	struct nvmap_client *client = filp->private_data;
+	NvSciIpcEndpointVuid pr_vuid, lclu_vuid;
+	struct nvmap_sciipc_map_entry *entries;
+	struct nvmap_sciipc_map_bulk op;
+	size_t bytes;
+	int ret;
+	u32 i;
+
+	if (copy_from_user(&op, arg, sizeof(op)))
+		return -EFAULT;
+
+	if (!op.count || op.count > NVMAP_SCIIPC_BULK_MAX_ENTRIES)
+		return -EINVAL;
+
+	ret = nvmap_validate_sci_ipc_params(client, op.auth_token,
+		&pr_vuid, &lclu_vuid);
+	if (ret)
+		return ret;
+
+	bytes = op.count * sizeof(*entries);
+	entries = nvmap_altalloc(bytes);
+	if (!entries)
+		return -ENOMEM;
+
+	if (copy_from_user(entries, (void __user *)(uintptr_t)op.entries,
+			   bytes)) {
+		ret = -EFAULT;
+		goto free;
+	}
+
+	for (i = 0; i < op.count; i++) {
+		if (is_export)
+			ret = nvmap_sciipc_export_one(client, pr_vuid,
+					&entries[i]);
+		else
+			ret = nvmap_get_handle_from_sci_ipc_id(client,
+					entries[i].flags,
+					entries[i].sci_ipc_id, lclu_vuid,
+					&entries[i].handle);
+		if (ret)
+			break;
+	}
+
+	if (copy_to_user((void __user *)(uintptr_t)op.entries, entries,
+			 bytes)) {
+		pr_err("copy_to_user failed\n");
+		ret = -EFAULT;
+	}
+free:
+	nvmap_altfree(entries, bytes);
+	return ret;
+}
+
+int nvmap_ioctl_get_sci_ipc_id_bulk(struct file *filp, void __user *arg)
+{
+	return nvmap_ioctl_sci_ipc_bulk(filp, arg, true);
+}
+
+int nvmap_ioctl_handle_from_sci_ipc_id_bulk(struct file *filp,
+					    void __user *arg)
+{
+	return nvmap_ioctl_sci_ipc_bulk(filp, arg, false);
+}
 #else
 int nvmap_ioctl_get_sci_ipc_id(struct file *filp, void __user *arg)
 {
@@ -1258,6 +1359,15 @@ int nvmap_ioctl_handle_from_sci_ipc_id(struct file *filp, void __user *arg)
 {
 	return -EPERM;
 }
+int nvmap_ioctl_get_sci_ipc_id_bulk(struct file *filp, void __user *arg)
+{
+	return -EPERM;
+}
+int nvmap_ioctl_handle_from_sci_ipc_id_bulk(struct file *filp,
+					    void __user *arg)
+{
+	return -EPERM;
+}
 #endif
 
 /*
@@ -1443,3 +1553,18 @@ out:
 				is_ro ? "RO" : "RW");
 	return ret;
 }
+
+int nvmap_ioctl_pool_pressure(struct file *filp, void __user *arg)
+{
+	struct nvmap_pool_pressure op;
+
+	if (copy_from_user(&op, arg, sizeof(op)))
+		return -EFAULT;
+
+#ifdef NVMAP_CONFIG_PAGE_POOLS
+	return nvmap_page_pool_set_pressure(op.eventfd, op.low_watermark,
+					    op.high_watermark);
+#else
+	return -ENODEV;
+#endif
+}
@@ -72,8 +72,17 @@ int nvmap_ioctl_get_sci_ipc_id(struct file *filp, void __user *arg);
 
 int nvmap_ioctl_handle_from_sci_ipc_id(struct file *filp, void __user *arg);
 
+int nvmap_ioctl_get_sci_ipc_id_bulk(struct file *filp, void __user *arg);
+
+int nvmap_ioctl_handle_from_sci_ipc_id_bulk(struct file *filp,
+					    void __user *arg);
+
 int nvmap_ioctl_query_heap_params(struct file *filp, void __user *arg);
 
+int nvmap_ioctl_write_direct(struct file *filp, void __user *arg);
+
 int nvmap_ioctl_dup_handle(struct file *filp, void __user *arg);
 
+int nvmap_ioctl_pool_pressure(struct file *filp, void __user *arg);
+
 #endif	/*  __VIDEO_TEGRA_NVMAP_IOCTL_H */
@@ -26,6 +26,7 @@
 #include <linux/debugfs.h>
 #include <linux/freezer.h>
 #include <linux/highmem.h>
+#include <linux/eventfd.h>
 #include <linux/version.h>
 
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 14, 0)
@@ -39,6 +40,7 @@
 
 #define NVMAP_TEST_PAGE_POOL_SHRINKER     1
 #define PENDING_PAGES_SIZE                (SZ_1M / PAGE_SIZE)
+#define NVMAP_PP_SHARD_MAX                256
 
 static bool enable_pp = 1;
 static u32 pool_size;
@@ -46,22 +48,26 @@ static u32 pool_size;
 static struct task_struct *background_allocator;
 static DECLARE_WAIT_QUEUE_HEAD(nvmap_bg_wait);
 
-#ifdef NVMAP_CONFIG_PAGE_POOL_DEBUG
-static inline void __pp_dbg_var_add(u64 *dbg_var, u32 nr)
+/* pool pressure notification, registered via NVMAP_IOC_POOL_PRESSURE */
+static struct eventfd_ctx *pp_pressure_efd;
+static u32 pp_pressure_low;	/* pages, signal when occupancy drops below */
+static u32 pp_pressure_high;	/* pages, re-arm when occupancy recovers */
+static bool pp_pressure_fired;
+static DEFINE_SPINLOCK(pp_pressure_lock);
+
+static inline void __pp_var_add(u64 *var, u32 nr)
 {
-	*dbg_var += nr;
+	*var += nr;
 }
-#else
-#define __pp_dbg_var_add(dbg_var, nr)
-#endif
 
-#define pp_alloc_add(pool, nr) __pp_dbg_var_add(&(pool)->allocs, nr)
-#define pp_fill_add(pool, nr)  __pp_dbg_var_add(&(pool)->fills, nr)
-#define pp_hit_add(pool, nr)   __pp_dbg_var_add(&(pool)->hits, nr)
-#define pp_miss_add(pool, nr)  __pp_dbg_var_add(&(pool)->misses, nr)
+#define pp_alloc_add(pool, nr) __pp_var_add(&(pool)->allocs, nr)
+#define pp_fill_add(pool, nr)  __pp_var_add(&(pool)->fills, nr)
+#define pp_hit_add(pool, nr)   __pp_var_add(&(pool)->hits, nr)
+#define pp_miss_add(pool, nr)  __pp_var_add(&(pool)->misses, nr)
 
 static int __nvmap_page_pool_fill_lots_locked(struct nvmap_page_pool *pool,
 				       struct page **pages, u32 nr);
+static void nvmap_pp_pressure_check(void);
 
 static inline struct page *get_zero_list_page(struct nvmap_page_pool *pool)
 {
@@ -115,6 +121,92 @@ static inline struct page *get_page_list_page_bp(struct nvmap_page_pool *pool)
 }
 #endif /* CONFIG_ARM64_4K_PAGES */
 
+/*
+ * Grab up to nr zeroed pages from this CPU's shard. The global pool lock is
+ * not taken; the shard lock is effectively uncontended unless the rebalancer
+ * or the shrinker is touching this shard at the same time.
+ */
+static u32 nvmap_pp_shard_alloc(struct nvmap_page_pool *pool,
+				struct page **pages, u32 nr)
+{
+	struct nvmap_pp_shard *shard;
+	u32 ind = 0;
+
+	if (!pool->shards)
+		return 0;
+
+	shard = get_cpu_ptr(pool->shards);
+	spin_lock(&shard->lock);
+	while (ind < nr && !list_empty(&shard->page_list)) {
+		struct page *page = list_first_entry(&shard->page_list,
+						     struct page, lru);
+
+		list_del(&page->lru);
+		shard->count--;
+		pages[ind++] = page;
+	}
+	spin_unlock(&shard->lock);
+	put_cpu_ptr(pool->shards);
+
+	if (ind)
+		atomic_sub(ind, &pool->shard_count);
+
+	return ind;
+}
+
+/*
+ * Slow-path rebalancer: move zeroed pages from the global list into this
+ * CPU's shard so that subsequent allocations can stay off the pool lock.
+ * Caller must hold pool->lock; the shard lock nests inside it.
+ */
+static void nvmap_pp_shard_refill_locked(struct nvmap_page_pool *pool)
+{
+	struct nvmap_pp_shard *shard;
+	u32 moved = 0;
+
+	if (!pool->shards)
+		return;
+
+	shard = get_cpu_ptr(pool->shards);
+	spin_lock(&shard->lock);
+	while (shard->count < NVMAP_PP_SHARD_MAX / 2) {
+		struct page *page = get_page_list_page(pool);
+
+		if (!page)
+			break;
+		list_add_tail(&page->lru, &shard->page_list);
+		shard->count++;
+		moved++;
+	}
+	spin_unlock(&shard->lock);
+	put_cpu_ptr(pool->shards);
+
+	atomic_add(moved, &pool->shard_count);
+}
+
+/*
+ * Return all shard pages to the global list, e.g. ahead of shrinking or
+ * clearing the pool. Caller must hold pool->lock.
+ */
+static void nvmap_pp_drain_shards_locked(struct nvmap_page_pool *pool)
+{
+	int cpu;
+
+	if (!pool->shards)
+		return;
+
+	for_each_possible_cpu(cpu) {
+		struct nvmap_pp_shard *shard = per_cpu_ptr(pool->shards, cpu);
+
+		spin_lock(&shard->lock);
+		list_splice_tail_init(&shard->page_list, &pool->page_list);
+		pool->count += shard->count;
+		atomic_sub(shard->count, &pool->shard_count);
+		shard->count = 0;
+		spin_unlock(&shard->lock);
+	}
+}
+
 static inline bool nvmap_bg_should_run(struct nvmap_page_pool *pool)
 {
 	return !list_empty(&pool->zero_list);
@@ -228,6 +320,9 @@ static ulong nvmap_page_pool_free_pages_locked(struct nvmap_page_pool *pool,
 
 	pr_debug("req to release pages=%ld\n", nr_pages);
 
+	/* pull shard pages back so they are visible to the release loop */
+	nvmap_pp_drain_shards_locked(pool);
+
 	while (nr_pages) {
 
 #ifdef CONFIG_ARM64_4K_PAGES
@@ -293,6 +388,16 @@ int nvmap_page_pool_alloc_lots(struct nvmap_page_pool *pool,
 	if (!enable_pp || !nr)
 		return 0;
 
+	/* fast path: satisfy the allocation from this CPU's shard */
+	ind = nvmap_pp_shard_alloc(pool, pages, nr);
+	if (ind == nr) {
+		pp_alloc_add(pool, ind);
+		pp_hit_add(pool, ind);
+		trace_nvmap_pp_alloc_lots(ind, nr);
+		nvmap_pp_pressure_check();
+		return ind;
+	}
+
 	rt_mutex_lock(&pool->lock);
 
 	while (ind < nr) {
@@ -317,6 +422,9 @@ int nvmap_page_pool_alloc_lots(struct nvmap_page_pool *pool,
 #endif /* NVMAP_CONFIG_PAGE_POOL_DEBUG */
 	}
 
+	/* we paid for the lock already - rebalance the local shard too */
+	nvmap_pp_shard_refill_locked(pool);
+
 	rt_mutex_unlock(&pool->lock);
 
 	/* Zero non-zeroed pages, if any */
@@ -329,6 +437,8 @@ int nvmap_page_pool_alloc_lots(struct nvmap_page_pool *pool,
 
 	trace_nvmap_pp_alloc_lots(ind, nr);
 
+	nvmap_pp_pressure_check();
+
 	return ind;
 }
 
@@ -359,6 +469,10 @@ int nvmap_page_pool_alloc_lots_bp(struct nvmap_page_pool *pool,
 	}
 
 	rt_mutex_unlock(&pool->lock);
+
+	if (ind)
+		nvmap_pp_pressure_check();
+
 	return ind;
 }
 
@@ -404,7 +518,8 @@ static int __nvmap_page_pool_fill_lots_locked(struct nvmap_page_pool *pool,
 		return 0;
 
 	BUG_ON(pool->count > pool->max);
-	real_nr = min_t(u32, pool->max - pool->count, nr);
+	real_nr = min_t(u32, pool->max - pool->count -
+			     atomic_read(&pool->shard_count), nr);
 	pages_to_fill = real_nr;
 	if (real_nr == 0)
 		return 0;
@@ -448,7 +563,8 @@ int nvmap_page_pool_fill_lots(struct nvmap_page_pool *pool,
 
 	save_to_zero = pool->to_zero;
 
-	ret = min(nr, pool->max - pool->count - pool->to_zero - pool->under_zero);
+	ret = min(nr, pool->max - pool->count - pool->to_zero -
+		      pool->under_zero - atomic_read(&pool->shard_count));
 
 	for (i = 0; i < ret; i++) {
 		/* If page has additonal referecnces, Don't add it into
@@ -473,6 +589,8 @@ int nvmap_page_pool_fill_lots(struct nvmap_page_pool *pool,
 
 	rt_mutex_unlock(&pool->lock);
 
+	nvmap_pp_pressure_check();
+
 	return ret;
 }
 
@@ -483,11 +601,73 @@ ulong nvmap_page_pool_get_unused_pages(void)
 	if (!nvmap_dev)
 		return 0;
 
-	total = nvmap_dev->pool.count + nvmap_dev->pool.to_zero;
+	total = nvmap_dev->pool.count + nvmap_dev->pool.to_zero +
+		atomic_read(&nvmap_dev->pool.shard_count);
 
 	return total;
 }
 
+/*
+ * Signal the registered eventfd once when pool occupancy drops below the
+ * low watermark; re-arm once it recovers above the high watermark. Called
+ * without the pool lock, so the occupancy read is a best-effort snapshot.
+ */
+static void nvmap_pp_pressure_check(void)
+{
+	unsigned long flags;
+	ulong occupancy;
+
+	if (!READ_ONCE(pp_pressure_efd))
+		return;
+
+	occupancy = nvmap_page_pool_get_unused_pages();
+
+	spin_lock_irqsave(&pp_pressure_lock, flags);
+	if (pp_pressure_efd) {
+		if (!pp_pressure_fired && occupancy < pp_pressure_low) {
+			eventfd_signal(pp_pressure_efd, 1);
+			pp_pressure_fired = true;
+		} else if (pp_pressure_fired &&
+			   occupancy >= pp_pressure_high) {
+			pp_pressure_fired = false;
+		}
+	}
+	spin_unlock_irqrestore(&pp_pressure_lock, flags);
+}
+
+/*
+ * Register (or, with fd < 0, unregister) an eventfd to be signalled on pool
+ * pressure. Watermarks are given in percent of the maximum pool size.
+ */
+int nvmap_page_pool_set_pressure(int fd, u32 low_percent, u32 high_percent)
+{
+	struct nvmap_page_pool *pool = &nvmap_dev->pool;
+	struct eventfd_ctx *efd = NULL, *old;
+	unsigned long flags;
+
+	if (fd >= 0) {
+		if (low_percent >= high_percent || high_percent > 100)
+			return -EINVAL;
+
+		efd = eventfd_ctx_fdget(fd);
+		if (IS_ERR(efd))
+			return PTR_ERR(efd);
+	}
+
+	spin_lock_irqsave(&pp_pressure_lock, flags);
+	old = pp_pressure_efd;
+	pp_pressure_efd = efd;
+	pp_pressure_low = (u64)pool->max * low_percent / 100;
+	pp_pressure_high = (u64)pool->max * high_percent / 100;
+	pp_pressure_fired = false;
+	spin_unlock_irqrestore(&pp_pressure_lock, flags);
+
+	if (old)
+		eventfd_ctx_put(old);
+
+	return 0;
+}
+
 /*
  * Remove and free to the system all the pages currently in the page
  * pool. This operation will happen even if the page pools are disabled.
@@ -550,6 +730,8 @@ static unsigned long nvmap_page_pool_scan_objects(struct shrinker *shrinker,
 			&nvmap_dev->pool, sc->nr_to_scan);
 	rt_mutex_unlock(&nvmap_dev->pool.lock);
 
+	nvmap_pp_pressure_check();
+
 	return (remaining == sc->nr_to_scan) ? \
 			   SHRINK_STOP : (sc->nr_to_scan - remaining);
 }
@@ -689,7 +871,6 @@ int nvmap_page_pool_debugfs_init(struct dentry *nvmap_root)
 			   S_IRUGO, pp_root,
 			   &nvmap_total_page_allocs);
 
-#ifdef NVMAP_CONFIG_PAGE_POOL_DEBUG
 	debugfs_create_u64("page_pool_allocs",
 			   S_IRUGO, pp_root,
 			   &nvmap_dev->pool.allocs);
@@ -702,7 +883,6 @@ int nvmap_page_pool_debugfs_init(struct dentry *nvmap_root)
 	debugfs_create_u64("page_pool_misses",
 			   S_IRUGO, pp_root,
 			   &nvmap_dev->pool.misses);
-#endif
 
 	return 0;
 }
@@ -712,10 +892,25 @@ int nvmap_page_pool_init(struct nvmap_device *dev)
 	struct sysinfo info;
 	struct nvmap_page_pool *pool = &dev->pool;
 
+	int cpu;
+
 	memset(pool, 0x0, sizeof(*pool));
 	rt_mutex_init(&pool->lock);
 	INIT_LIST_HEAD(&pool->page_list);
 	INIT_LIST_HEAD(&pool->zero_list);
+	atomic_set(&pool->shard_count, 0);
+
+	pool->shards = alloc_percpu(struct nvmap_pp_shard);
+	if (!pool->shards)
+		goto fail;
+
+	for_each_possible_cpu(cpu) {
+		struct nvmap_pp_shard *shard = per_cpu_ptr(pool->shards, cpu);
+
+		spin_lock_init(&shard->lock);
+		INIT_LIST_HEAD(&shard->page_list);
+		shard->count = 0;
+	}
 #ifdef CONFIG_ARM64_4K_PAGES
 	INIT_LIST_HEAD(&pool->page_list_bp);
 
@@ -773,5 +968,13 @@ int nvmap_page_pool_fini(struct nvmap_device *dev)
 
 	WARN_ON(!list_empty(&pool->page_list));
 
+	if (pp_pressure_efd) {
+		eventfd_ctx_put(pp_pressure_efd);
+		pp_pressure_efd = NULL;
+	}
+
+	free_percpu(pool->shards);
+	pool->shards = NULL;
+
 	return 0;
 }
@@ -20,6 +20,7 @@
 
 #include <linux/list.h>
 #include <linux/mm.h>
+#include <linux/sizes.h>
 #include <linux/mutex.h>
 #include <linux/rtmutex.h>
 #include <linux/rbtree.h>
@@ -99,6 +100,13 @@ do {                                                    \
 
 #define GFP_NVMAP       (GFP_KERNEL | __GFP_HIGHMEM | __GFP_NOWARN)
 
+/*
+ * Contiguous carveout allocations at or below this size belong to the
+ * small size class; the carveout allocator steers them away from the
+ * region reserved for large contiguous allocations.
+ */
+#define NVMAP_SMALL_CLASS_SIZE	SZ_1M
+
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 10, 0)
 
 /*
@@ -227,6 +235,14 @@ struct nvmap_handle_dmabuf_priv {
 	struct list_head list;
 };
 
+/* dirty range recorded for deferred cache maintenance */
+struct nvmap_deferred_maint {
+	struct list_head list;
+	unsigned long start;
+	unsigned long end;
+	unsigned int op;
+};
+
 struct nvmap_handle {
 	struct rb_node node;	/* entry on global handle tree */
 	atomic_t ref;		/* reference count (i.e., # of duplications) */
@@ -255,6 +271,9 @@ struct nvmap_handle {
 	struct list_head lru;	/* list head to track the lru */
 	struct mutex lock;
 	struct list_head dmabuf_priv;
+	/* ranges recorded by NVMAP_CACHE_OP_WB_DEFER, flushed at map time */
+	struct list_head deferred_maint;
+	spinlock_t deferred_lock;
 	u64 ivm_id;
 	int peer;		/* Peer VM number */
 	int offs;		/* Offset in IVM mem pool */
@@ -272,6 +291,20 @@ struct nvmap_handle_info {
 	bool is_ro;
 };
 
+/*
+ * IOVA mapping shared between devices attached to the same IOMMU domain,
+ * kept on nvmap_handle_info::maps and protected by maps_lock. Devices in
+ * one domain (or stream ID group) see identical translations, so mapping
+ * the buffer once per domain is enough.
+ */
+struct nvmap_dmabuf_map {
+	struct iommu_domain *domain;	/* domain the mapping belongs to */
+	enum dma_data_direction dir;
+	struct sg_table *sgt;
+	atomic_t refs;
+	struct list_head entry;
+};
+
 struct nvmap_tag_entry {
 	struct rb_node node;
 	atomic_t ref;		/* reference count (i.e., # of duplications) */
@@ -301,8 +334,17 @@ struct nvmap_handle_ref {
 #ifdef CONFIG_ARM64_4K_PAGES
 #define NVMAP_PP_BIG_PAGE_SIZE           (0x10000)
 #endif /* CONFIG_ARM64_4K_PAGES */
+/* Per-CPU cache of zeroed pages in front of the global page pool. */
+struct nvmap_pp_shard {
+	spinlock_t lock;
+	struct list_head page_list;
+	u32 count;
+};
+
 struct nvmap_page_pool {
 	struct rt_mutex lock;
+	struct nvmap_pp_shard __percpu *shards;
+	atomic_t shard_count; /* Total pages held in per-CPU shards */
 	u32 count;      /* Number of pages in the page & dirty list. */
 	u32 max;        /* Max no. of pages in all lists. */
 	u32 to_zero;    /* Number of pages on the zero list */
@@ -318,12 +360,11 @@ struct nvmap_page_pool {
 	struct list_head page_list_bp;
 #endif /* CONFIG_ARM64_4K_PAGES */
 
-#ifdef NVMAP_CONFIG_PAGE_POOL_DEBUG
+	/* hit/miss/refill accounting, see nvmap_page_pool_debugfs_init() */
 	u64 allocs;
 	u64 fills;
 	u64 hits;
 	u64 misses;
-#endif
 };
 
 int nvmap_page_pool_init(struct nvmap_device *dev);
@@ -339,6 +380,7 @@ int nvmap_page_pool_fill_lots(struct nvmap_page_pool *pool,
 				       struct page **pages, u32 nr);
 int nvmap_page_pool_clear(void);
 int nvmap_page_pool_debugfs_init(struct dentry *nvmap_root);
+int nvmap_page_pool_set_pressure(int fd, u32 low_percent, u32 high_percent);
 #endif
 
 #define NVMAP_IVM_INVALID_PEER		(-1)
@@ -587,6 +629,9 @@ int nvmap_do_cache_maint_list(struct nvmap_handle **handles, u64 *offsets,
 			      u64 *sizes, int op, u32 nr_ops, bool is_32);
 int __nvmap_cache_maint(struct nvmap_client *client,
 			       struct nvmap_cache_op_64 *op);
+int nvmap_cache_maint_defer(struct nvmap_handle *h, unsigned long start,
+			    unsigned long end, unsigned int op);
+int nvmap_cache_maint_flush_deferred(struct nvmap_handle *h);
 int nvmap_cache_debugfs_init(struct dentry *nvmap_root);
 
 /* Internal API to support dmabuf */
@@ -864,6 +909,15 @@ __weak void nvmap_sci_ipc_exit(void)
 }
 #endif
 
+#if IS_ENABLED(CONFIG_DMABUF_HEAPS)
+int nvmap_dmaheap_init(void);
+#else
+__weak int nvmap_dmaheap_init(void)
+{
+	return 0;
+}
+#endif
+
 #ifdef NVMAP_CONFIG_HANDLE_AS_ID
 void nvmap_id_array_init(struct xarray *xarr);
 void nvmap_id_array_exit(struct xarray *xarr);
@@ -16,14 +16,21 @@
  */
 
 #include <linux/debugfs.h>
+#include <linux/seq_file.h>
+#include <linux/log2.h>
 
 #include "nvmap_priv.h"
 
 struct nvmap_stats nvmap_stats;
 
+static const char * const nvmap_lat_heap_names[NL_NUM] = {
+	"iovmm",
+	"carveout",
+};
+
 static int nvmap_stats_reset(void *data, u64 val)
 {
-	int i;
+	int i, j;
 
 	if (val) {
 		atomic64_set(&nvmap_stats.collect, 0);
@@ -32,6 +39,9 @@ static int nvmap_stats_reset(void *data, u64 val)
 				continue;
 			atomic64_set(&nvmap_stats.stats[i], 0);
 		}
+		for (i = 0; i < NL_NUM; i++)
+			for (j = 0; j < NVMAP_LAT_BUCKETS; j++)
+				atomic64_set(&nvmap_stats.lat[i][j], 0);
 	}
 	return 0;
 }
@@ -55,6 +65,34 @@ static int nvmap_stats_set(void *data, u64 val)
 DEFINE_SIMPLE_ATTRIBUTE(reset_stats_fops, NULL, nvmap_stats_reset, "%llu\n");
 DEFINE_SIMPLE_ATTRIBUTE(stats_fops, nvmap_stats_get, nvmap_stats_set, "%llu\n");
 
+static int nvmap_stats_lat_show(struct seq_file *s, void *unused)
+{
+	int i, j;
+
+	for (i = 0; i < NL_NUM; i++) {
+		seq_printf(s, "%s:\n", nvmap_lat_heap_names[i]);
+		for (j = 0; j < NVMAP_LAT_BUCKETS - 1; j++)
+			seq_printf(s, "  < %7lluus: %llu\n", 1ULL << j,
+				(u64)atomic64_read(&nvmap_stats.lat[i][j]));
+		seq_printf(s, " >= %7lluus: %llu\n",
+			1ULL << (NVMAP_LAT_BUCKETS - 2),
+			(u64)atomic64_read(&nvmap_stats.lat[i][j]));
+	}
+	return 0;
+}
+
+static int nvmap_stats_lat_open(struct inode *inode, struct file *file)
+{
+	return single_open(file, nvmap_stats_lat_show, inode->i_private);
+}
+
+static const struct file_operations lat_stats_fops = {
+	.open = nvmap_stats_lat_open,
+	.read = seq_read,
+	.llseek = seq_lseek,
+	.release = single_release,
+};
+
 void nvmap_stats_init(struct dentry *nvmap_debug_root)
 {
 	struct dentry *stats_root;
@@ -82,6 +120,8 @@ void nvmap_stats_init(struct dentry *nvmap_debug_root)
 			stats_root, &nvmap_stats.collect, &stats_fops);
 		debugfs_create_file("reset", S_IWUSR,
 			stats_root, NULL, &reset_stats_fops);
+		debugfs_create_file("alloc_latency", S_IRUGO,
+			stats_root, NULL, &lat_stats_fops);
 	}
 
 #undef CREATE_DF
@@ -104,3 +144,12 @@ u64 nvmap_stats_read(enum nvmap_stats_t stat)
 	return atomic64_read(&nvmap_stats.stats[stat]);
 }
 
+void nvmap_stats_lat(enum nvmap_lat_heap_t heap, u64 ns)
+{
+	u64 us = ns / NSEC_PER_USEC;
+	int bucket = us ? min((int)ilog2(us) + 1, NVMAP_LAT_BUCKETS - 1) : 0;
+
+	if (atomic64_read(&nvmap_stats.collect))
+		atomic64_add(1, &nvmap_stats.lat[heap][bucket]);
+}
+
@@ -31,8 +31,21 @@ enum nvmap_stats_t {
 	NS_NUM,
 };
 
+/* heap categories for the allocation latency histograms */
+enum nvmap_lat_heap_t {
+	NL_IOVMM = 0,
+	NL_CARVEOUT,
+	NL_NUM,
+};
+
+/* bucket 0 counts allocations under 1us, bucket n allocations in
+ * [2^(n-1), 2^n) us; the last bucket absorbs everything slower
+ */
+#define NVMAP_LAT_BUCKETS 16
+
 struct nvmap_stats {
 	atomic64_t stats[NS_NUM];
+	atomic64_t lat[NL_NUM][NVMAP_LAT_BUCKETS];
 	atomic64_t collect;
 };
 
@@ -42,4 +55,5 @@ void nvmap_stats_init(struct dentry *nvmap_debug_root);
 void nvmap_stats_inc(enum nvmap_stats_t, size_t size);
 void nvmap_stats_dec(enum nvmap_stats_t, size_t size);
 u64 nvmap_stats_read(enum nvmap_stats_t);
+void nvmap_stats_lat(enum nvmap_lat_heap_t heap, u64 ns);
 #endif /* __VIDEO_TEGRA_NVMAP_STATS_H */
@@ -1,6 +1,14 @@
 /*
  * Tegra Graphics Virtualization Communication Framework
  *
+ * This is a generic message transport over IVC queues used by the
+ * graphics and host1x virtualization clients (see tegra_vhost and
+ * vgpu). It carries whatever payload the client hands it and has no
+ * knowledge of the message contents. Display is not virtualized
+ * through this framework in this tree: the dc/nvdisp drivers program
+ * the display hardware directly, so there is no per-flip window state
+ * transiting IVC here that could be delta-encoded.
+ *
  * Copyright (c) 2013-2022, NVIDIA Corporation. All rights reserved.
  *
  * This program is free software; you can redistribute it and/or modify it
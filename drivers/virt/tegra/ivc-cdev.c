@@ -200,13 +200,21 @@ static int ivc_dev_mmap(struct file *filp, struct vm_area_struct *vma)
 		return ret;
 	}
 
-	/* fail if userspace attempts to partially map the mempool */
 	map_region_sz = vma->vm_end - vma->vm_start;
 
-	if (((vma->vm_pgoff == 0) && (map_region_sz == ivc_area_size))) {
+	/*
+	 * Any page-aligned sub-range of the IVC area can be mapped, so
+	 * userspace can map the TX and RX queue regions separately (and
+	 * with different protections) for zero-copy ring access. Mapping
+	 * offset 0 with the full area size keeps the legacy behaviour.
+	 */
+	if (((vma->vm_pgoff << PAGE_SHIFT) < ivc_area_size) &&
+	    (map_region_sz <= ivc_area_size -
+			      (vma->vm_pgoff << PAGE_SHIFT))) {
 
 		if (remap_pfn_range(vma, vma->vm_start,
-					(ivc_area_ipa >> PAGE_SHIFT),
+					(ivc_area_ipa >> PAGE_SHIFT) +
+					vma->vm_pgoff,
 					map_region_sz,
 					vma->vm_page_prot)) {
 			ret = -EAGAIN;
@@ -26,6 +26,7 @@
 #include <linux/module.h>
 #include <linux/of.h>
 #include <linux/of_irq.h>
+#include <clocksource/arm_arch_timer.h>
 
 #include <linux/version.h>
 #if KERNEL_VERSION(4, 15, 0) > LINUX_VERSION_CODE
@@ -406,6 +407,43 @@ static ssize_t vmid_show(struct class *class,
 }
 static CLASS_ATTR_RO(vmid);
 
+/*
+ * The hypervisor programs the same virtual counter offset into every
+ * guest, so the generic timer already serves as the shared cross-VM
+ * timebase: a single counter load yields a value directly comparable
+ * with timestamps taken in any other guest. Publish the counter and
+ * its frequency here so measurement tooling can correlate IVC message
+ * timestamps without an IVC round-trip.
+ */
+static ssize_t timebase_show(struct class *class,
+	struct class_attribute *attr, char *buf)
+{
+	return snprintf(buf, PAGE_SIZE, "%llu %llu\n",
+			(unsigned long long)arch_timer_read_counter(),
+			(unsigned long long)arch_timer_get_cntfrq());
+}
+static CLASS_ATTR_RO(timebase);
+
+/*
+ * tegra_hv_read_timebase - snapshot the shared cross-VM timebase
+ *
+ * Returns the current value of the guest-invariant counter in @cycles
+ * and its frequency in @freq. Both may be NULL if not needed.
+ */
+int tegra_hv_read_timebase(uint64_t *cycles, uint64_t *freq)
+{
+	if (!is_tegra_hypervisor_mode())
+		return -ENODEV;
+
+	if (cycles)
+		*cycles = arch_timer_read_counter();
+	if (freq)
+		*freq = arch_timer_get_cntfrq();
+
+	return 0;
+}
+EXPORT_SYMBOL(tegra_hv_read_timebase);
+
 static int __init tegra_hv_setup(struct tegra_hv_data *hvd)
 {
 	const int intr_property_size = 3;
@@ -438,6 +476,12 @@ static int __init tegra_hv_setup(struct tegra_hv_data *hvd)
 		return ret;
 	}
 
+	ret = class_create_file(hvd->hv_class, &class_attr_timebase);
+	if (ret != 0) {
+		ERR("failed to create timebase file: %d\n", ret);
+		return ret;
+	}
+
 	ret = hyp_read_ivc_info(&info_page);
 	if (ret != 0) {
 		ERR("failed to obtain IVC info page: %d\n", ret);
@@ -21,5 +21,6 @@
 
 const struct ivc_info_page *tegra_hv_get_ivc_info(void);
 int tegra_hv_get_vmid(void);
+int tegra_hv_read_timebase(uint64_t *cycles, uint64_t *freq);
 
 #endif /* __TEGRA_HV_H__ */
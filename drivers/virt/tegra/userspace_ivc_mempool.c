@@ -24,6 +24,7 @@
 #include <linux/device.h>
 #include <linux/cdev.h>
 #include <linux/fs.h>
+#include <linux/mm.h>
 #include <linux/sched.h>
 #include <linux/slab.h>
 #include <linux/version.h>
@@ -60,6 +61,14 @@ struct ivc_mempool_dev {
 /* maximum ivc mempool id from all ivc mempools assigned to this guest */
 static uint32_t max_mempool_id;
 
+/* pages populated around a fault; large pools map windows on demand
+ * instead of paying for the whole pool at mmap() time
+ */
+static unsigned int mempool_map_chunk_pages = 512;
+module_param(mempool_map_chunk_pages, uint, 0644);
+MODULE_PARM_DESC(mempool_map_chunk_pages,
+		"pages mapped per mempool demand fault");
+
 /* sysfs ivc mempool device class */
 static struct class *ivc_mempool_class;
 
@@ -182,12 +191,43 @@ static ssize_t ivc_mempool_write(struct file *filp,
 	return -ENOTSUPP;
 }
 
+static vm_fault_t ivc_mempool_vma_fault(struct vm_fault *vmf)
+{
+	struct vm_area_struct *vma = vmf->vma;
+	struct ivc_mempool_dev *mempooldev = vma->vm_private_data;
+	unsigned long base_pfn = mempooldev->mempoolcfg->pa >> PAGE_SHIFT;
+	unsigned long nr_pages = mempooldev->mempoolcfg->size >> PAGE_SHIFT;
+	unsigned long chunk = mempool_map_chunk_pages ? : 1;
+	unsigned long pgoff, first, last, i;
+	vm_fault_t ret;
+
+	pgoff = (vmf->address - vma->vm_start) >> PAGE_SHIFT;
+	if (pgoff >= nr_pages)
+		return VM_FAULT_SIGBUS;
+
+	/* populate the whole chunk containing the faulting page */
+	first = rounddown(pgoff, chunk);
+	last = min(first + chunk, nr_pages);
+
+	for (i = first; i < last; i++) {
+		ret = vmf_insert_pfn(vma,
+				vma->vm_start + (i << PAGE_SHIFT),
+				base_pfn + i);
+		if ((ret != VM_FAULT_NOPAGE) && (i == pgoff))
+			return ret;
+	}
+
+	return VM_FAULT_NOPAGE;
+}
+
+static const struct vm_operations_struct ivc_mempool_vm_ops = {
+	.fault = ivc_mempool_vma_fault,
+};
+
 static int ivc_mempool_mmap(struct file *filp, struct vm_area_struct *vma)
 {
 	struct ivc_mempool_dev *mempooldev = filp->private_data;
 	uint64_t map_region_sz;
-	unsigned long mpool_ipa_pfn;
-	int ret = -EFAULT;
 
 	if (WARN_ON(!((mempooldev != NULL) &&
 			(mempooldev->mpool_cookie != NULL))))
@@ -196,26 +236,103 @@ static int ivc_mempool_mmap(struct file *filp, struct vm_area_struct *vma)
 	/* fail if userspace attempts to partially map the mempool */
 	map_region_sz = vma->vm_end - vma->vm_start;
 
-	if (((vma->vm_pgoff == 0) &&
-		(map_region_sz == mempooldev->mempoolcfg->size))) {
+	if ((vma->vm_pgoff != 0) ||
+		(map_region_sz != mempooldev->mempoolcfg->size))
+		return -EFAULT;
+
+	/* pages are mapped on demand in mempool_map_chunk_pages windows
+	 * instead of remapping the whole pool here
+	 */
+	vma->vm_flags |= VM_PFNMAP | VM_DONTEXPAND | VM_DONTDUMP;
+	vma->vm_private_data = mempooldev;
+	vma->vm_ops = &ivc_mempool_vm_ops;
+
+	return 0;
+}
+
+/* look up and validate the caller's mempool mapping covering the range */
+static struct vm_area_struct *ivc_mempool_find_vma(
+		struct ivc_mempool_dev *mempooldev,
+		const struct ivc_mempool_range *range)
+{
+	struct vm_area_struct *vma;
+
+	if ((range->size == 0) ||
+		(range->addr + range->size < range->addr))
+		return NULL;
+
+	vma = find_vma(current->mm, range->addr);
+	if ((vma == NULL) ||
+		(vma->vm_ops != &ivc_mempool_vm_ops) ||
+		(vma->vm_private_data != mempooldev) ||
+		(range->addr < vma->vm_start) ||
+		(range->addr + range->size > vma->vm_end))
+		return NULL;
+
+	return vma;
+}
+
+/* populate mappings for a user supplied range ahead of demand faults */
+static long ivc_mempool_prefetch(struct ivc_mempool_dev *mempooldev,
+		const struct ivc_mempool_range *range)
+{
+	struct vm_area_struct *vma;
+	unsigned long base_pfn = mempooldev->mempoolcfg->pa >> PAGE_SHIFT;
+	unsigned long start, end, addr;
+	long ret = 0;
 
-		mpool_ipa_pfn =
-			(mempooldev->mempoolcfg->pa >> PAGE_SHIFT);
+	mmap_read_lock(current->mm);
 
-		if (remap_pfn_range(vma, vma->vm_start,
-					mpool_ipa_pfn,
-					map_region_sz,
-					vma->vm_page_prot)) {
-			ret = -EAGAIN;
-		} else {
-			/* success! */
-			ret = 0;
+	vma = ivc_mempool_find_vma(mempooldev, range);
+	if (vma == NULL) {
+		mmap_read_unlock(current->mm);
+		return -EINVAL;
+	}
+
+	start = rounddown(range->addr, PAGE_SIZE);
+	end = PAGE_ALIGN(range->addr + range->size);
+
+	for (addr = start; addr < end; addr += PAGE_SIZE) {
+		unsigned long pgoff = (addr - vma->vm_start) >> PAGE_SHIFT;
+
+		if (vmf_insert_pfn(vma, addr, base_pfn + pgoff) !=
+				VM_FAULT_NOPAGE) {
+			ret = -EFAULT;
+			break;
 		}
+		cond_resched();
 	}
 
+	mmap_read_unlock(current->mm);
+
 	return ret;
 }
 
+/* drop mappings for a user supplied range; accesses fault back in */
+static long ivc_mempool_range_release(struct ivc_mempool_dev *mempooldev,
+		const struct ivc_mempool_range *range)
+{
+	struct vm_area_struct *vma;
+	unsigned long start, end;
+
+	mmap_read_lock(current->mm);
+
+	vma = ivc_mempool_find_vma(mempooldev, range);
+	if (vma == NULL) {
+		mmap_read_unlock(current->mm);
+		return -EINVAL;
+	}
+
+	start = rounddown(range->addr, PAGE_SIZE);
+	end = PAGE_ALIGN(range->addr + range->size);
+
+	zap_vma_ptes(vma, start, end - start);
+
+	mmap_read_unlock(current->mm);
+
+	return 0;
+}
+
 static long ivc_mempool_dev_ioctl(struct file *filp, unsigned int cmd,
 		unsigned long arg)
 {
@@ -237,6 +354,23 @@ static long ivc_mempool_dev_ioctl(struct file *filp, unsigned int cmd,
 				ret = -EFAULT;
 			}
 			break;
+		case TEGRA_MPLUSERSPACE_IOCTL_PREFETCH:
+		case TEGRA_MPLUSERSPACE_IOCTL_RELEASE: {
+			struct ivc_mempool_range range;
+
+			if (copy_from_user(&range, (void __user *) arg,
+					sizeof(range))) {
+				ret = -EFAULT;
+				break;
+			}
+
+			if (cmd == TEGRA_MPLUSERSPACE_IOCTL_PREFETCH)
+				ret = ivc_mempool_prefetch(mempooldev, &range);
+			else
+				ret = ivc_mempool_range_release(mempooldev,
+						&range);
+			break;
+		}
 		default:
 			/* The ioctl cmd number was validated against
 			 * TEGRA_MPLUSERSPACE_IOCTL_NUMBER_MAX so execution
@@ -71,6 +71,9 @@ int is_ras_ready(void);
 int is_this_ras_cpu(void);
 int is_ras_cpu(int cpu);
 u64 ras_read_error_status(void);
+u64 ras_read_error_address(void);
+u64 ras_read_error_misc0(void);
+u64 ras_read_error_misc1(void);
 u64 ras_read_errselr(void);
 u64 ras_read_pfg_control(void);
 u64 ras_read_pfg_cdn(void);
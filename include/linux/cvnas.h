@@ -21,6 +21,39 @@
 #define __LINUX_CVNAS_H
 
 #include <linux/types.h>
+#include <linux/list.h>
+
+/*
+ * A named sub-region of the CVSRAM carveout.  Partitions are carved
+ * dynamically so time-multiplexed clients share the SRAM instead of
+ * statically splitting it.  @evict is called when another client needs
+ * space; a cooperating client shrinks or destroys its partition and
+ * returns 0.  @used is maintained by the client via
+ * nvcvnas_partition_account() and reported through debugfs.
+ */
+struct nvcvnas_partition {
+	struct list_head node;
+	char name[16];
+	phys_addr_t base;
+	size_t size;
+	size_t used;
+	int (*evict)(struct nvcvnas_partition *part, size_t needed, void *ctx);
+	void *ctx;
+};
+
+struct nvcvnas_partition *nvcvnas_partition_create(const char *name,
+		size_t size,
+		int (*evict)(struct nvcvnas_partition *part,
+				size_t needed, void *ctx),
+		void *ctx);
+void nvcvnas_partition_destroy(struct nvcvnas_partition *part);
+int nvcvnas_partition_resize(struct nvcvnas_partition *part, size_t new_size);
+phys_addr_t nvcvnas_partition_base(struct nvcvnas_partition *part);
+size_t nvcvnas_partition_size(struct nvcvnas_partition *part);
+int nvcvnas_partition_account(struct nvcvnas_partition *part, ssize_t bytes);
+
+struct dentry;
+void nvcvnas_partition_debugfs_init(struct dentry *root);
 
 int nvcvnas_busy(void);
 int nvcvnas_busy_no_rpm(void);
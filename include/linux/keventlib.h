@@ -24,6 +24,14 @@ keventlib_write(int id, void *data, size_t size, uint32_t type, uint64_t ts);
 
 int keventlib_register(size_t size, const char *name,
 		       const char *schema, size_t schema_size);
+
+/* Like keventlib_register(), but the buffer is split into one write
+ * shard per CPU so that writers on different CPUs do not contend.
+ * Readers get the shards merged back into one sequence-ordered stream.
+ */
+int keventlib_register_sharded(size_t size, const char *name,
+			       const char *schema, size_t schema_size);
+
 void keventlib_unregister(int id);
 
 #endif  /* __KEVENTLIB_H */
@@ -48,6 +48,9 @@ enum nvidia_p2p_page_size_type {
 	NVIDIA_P2P_PAGE_SIZE_COUNT
 };
 
+/** Pinned-region cache entry shared by page tables, private to the driver */
+struct nvidia_p2p_pin_cache_entry;
+
 typedef struct nvidia_p2p_page_table {
 	u32 version;
 	u32 page_size;
@@ -59,7 +62,10 @@ typedef struct nvidia_p2p_page_table {
 	u32 mapped;
 
 	struct mm_struct *mm;
-	struct mmu_notifier mn;
+	/** Shared pinning this page table references */
+	struct nvidia_p2p_pin_cache_entry *cache;
+	/** Entry on the pinning's client list */
+	struct list_head cache_node;
 	struct mutex lock;
 	void (*free_callback)(void *data);
 	void *data;
@@ -77,7 +83,7 @@ typedef struct nvidia_p2p_dma_mapping {
 	enum dma_data_direction direction;
 } nvidia_p2p_dma_mapping_t;
 
-#define NVIDIA_P2P_PAGE_TABLE_VERSION   0x00010000
+#define NVIDIA_P2P_PAGE_TABLE_VERSION   0x00010001
 
 #define NVIDIA_P2P_PAGE_TABLE_VERSION_COMPATIBLE(p) \
 	NVIDIA_P2P_VERSION_COMPATIBLE(p, NVIDIA_P2P_PAGE_TABLE_VERSION)
@@ -85,7 +91,9 @@ typedef struct nvidia_p2p_dma_mapping {
 /*
  * @brief
  *   Make the pages underlying a range of GPU virtual memory
- *   accessible to a third-party device.
+ *   accessible to a third-party device. Pinnings are cached per
+ *   (mm, vaddr, size): re-requesting an unchanged range reuses the
+ *   existing pinning instead of walking the pages again.
  *
  * @param[in]     vaddr
  *   A GPU Virtual Address
@@ -112,7 +120,8 @@ int nvidia_p2p_get_pages(u64 vaddr, u64 size,
 /*
  * @brief
  * Release the pages previously made accessible to
- * a third-party device.
+ * a third-party device. The underlying pinning stays cached for later
+ * re-registration until the range is unmapped or the mm exits.
  *
  * @param[in]    *page_table
  *   A pointer to struct nvidia_p2p_page_table
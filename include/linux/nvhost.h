@@ -68,6 +68,8 @@ struct nvhost_fence;
 #define NVHOST_MODULE_MAX_MODMUTEXES		5
 #define NVHOST_MODULE_MAX_IORESOURCE_MEM	5
 #define NVHOST_NAME_SIZE			24
+/* log2(ms) buckets in the adaptive autosuspend idle gap histogram */
+#define NVHOST_MODULE_AS_GAP_BUCKETS		16
 #define NVSYNCPT_INVALID			(-1)
 
 #define NVSYNCPT_AVP_0			(10)	/* t20, t30, t114, t148 */
@@ -89,6 +91,7 @@ struct nvhost_fence;
 
 enum nvhost_power_sysfs_attributes {
 	NVHOST_POWER_SYSFS_ATTRIB_AUTOSUSPEND_DELAY,
+	NVHOST_POWER_SYSFS_ATTRIB_AUTOSUSPEND_ADAPTIVE,
 	NVHOST_POWER_SYSFS_ATTRIB_FORCE_ON,
 	NVHOST_POWER_SYSFS_ATTRIB_MAX
 };
@@ -204,6 +207,7 @@ struct nvhost_device_data {
 	bool		exclusive;	/* True if only one user at a time */
 	bool		keepalive;	/* Do not power gate when opened */
 	bool		serialize;	/* Serialize submits in the channel */
+	bool		pipelined_submits; /* Jobs may skip serialization */
 	bool		push_work_done;	/* Push_op done into push buffer */
 	bool		poweron_reset;	/* Reset the engine before powerup */
 	bool		virtual_dev;	/* True if virtualized device */
@@ -216,10 +220,23 @@ struct nvhost_device_data {
 	char		*firmware_name;	/* Name of firmware */
 	bool		firmware_not_in_subdir; /* Firmware is not located in
                                                    chip subdirectory */
+	bool		preload_fw;	/* Fetch firmware at probe time */
+	struct work_struct fw_preload_work;
 
 	bool		engine_can_cg;	/* True if CG is enabled */
 	bool		can_powergate;	/* True if module can be power gated */
 	int		autosuspend_delay;/* Delay before power gated */
+
+	/* Adapt autosuspend_delay to the measured distribution of gaps
+	 * between the engine going idle and the next job; see
+	 * nvhost_module_update_autosuspend()
+	 */
+	bool		autosuspend_adaptive;
+	spinlock_t	as_gap_lock;	/* protects the gap histogram */
+	u32		as_gap_hist[NVHOST_MODULE_AS_GAP_BUCKETS];
+	u32		as_gap_samples;
+	u64		as_idle_ts_ns;	/* when the engine last went idle */
+
 	struct nvhost_clock clocks[NVHOST_MODULE_MAX_CLOCKS];/* Clock names */
 
 	/* Clock gating registers */
@@ -278,6 +295,9 @@ struct nvhost_device_data {
 	/* WEIGHT_COUNT of actmon */
 	u32				actmon_weight_count;
 	struct nvhost_actmon_register	*actmon_setting_regs;
+	/* Expected memory demand in kHz hinted to the central actmon
+	 * governor when a job arrives at the idle engine; 0 disables */
+	u32				actmon_hint_khz;
 	/* Devfreq governor name */
 	const char			*devfreq_governor;
 	unsigned long *freq_table;
@@ -419,6 +439,11 @@ struct nvhost_device_data {
 	/* eventlib id for the device */
 	int eventlib_id;
 
+	/* bitmask of event types emitted to eventlib; bit n enables the
+	 * event type with schema id n, see uapi/linux/nvhost_events.h
+	 */
+	u64 eventlib_mask;
+
 	/* deliver task timestamps for falcon */
 	void (*enable_timestamps)(struct platform_device *pdev,
 			struct nvhost_cdma *cdma, dma_addr_t timestamp_addr);
@@ -643,6 +668,21 @@ static inline void nvhost_eventlib_log_fences(struct platform_device *pdev,
                                               u64 timestamp)
 {
 }
+
+static inline void nvhost_eventlib_write(struct platform_device *pdev,
+					 void *data,
+					 size_t size,
+					 u32 type,
+					 u64 timestamp)
+{
+}
+
+static inline void nvhost_pipeline_trace_frame(u64 trace_id,
+					       u32 stage,
+					       u32 class_id,
+					       u32 extra)
+{
+}
 #else
 
 #ifdef CONFIG_DEBUG_FS
@@ -751,6 +791,25 @@ void nvhost_eventlib_log_fences(struct platform_device *pdev,
 				enum nvdev_fence_kind kind,
 				u64 timestamp);
 
+/* Emit one binary event record to the device's eventlib stream.
+ * No-op when the stream is not registered or the event type is
+ * masked out in pdata->eventlib_mask.
+ */
+void nvhost_eventlib_write(struct platform_device *pdev,
+			   void *data,
+			   size_t size,
+			   u32 type,
+			   u64 timestamp);
+
+/* Log one stage of a traced frame to the global pipeline eventlib
+ * stream; see uapi/linux/nvhost_pipeline_events.h for the stages.
+ * No-op when trace_id is 0 or the stream is not registered.
+ */
+void nvhost_pipeline_trace_frame(u64 trace_id,
+				 u32 stage,
+				 u32 class_id,
+				 u32 extra);
+
 dma_addr_t nvhost_t194_get_reloc_phys_addr(dma_addr_t phys_addr,
 					   u32 reloc_type);
 dma_addr_t nvhost_t23x_get_reloc_phys_addr(dma_addr_t phys_addr,
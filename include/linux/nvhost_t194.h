@@ -26,6 +26,9 @@ int nvhost_syncpt_unit_interface_get_aperture(
 
 u32 nvhost_syncpt_unit_interface_get_byte_offset(u32 syncpt_id);
 
+int nvhost_syncpt_unit_interface_snapshot(struct platform_device *host_pdev,
+					  u32 *values, u32 nb_pts);
+
 #ifdef CONFIG_TEGRA_HOST1X
 u32 nvhost_syncpt_unit_interface_get_byte_offset_ext(
 				struct platform_device *host_pdev,
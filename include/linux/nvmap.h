@@ -51,6 +51,9 @@
 #define NVMAP_HANDLE_CACHE_SYNC      (0x1ul << 7)
 #define NVMAP_HANDLE_CACHE_SYNC_AT_RESERVE      (0x1ul << 8)
 #define NVMAP_HANDLE_RO	             (0x1ul << 9)
+/* pad and align carveout allocations to PMD granularity so they can be
+ * mapped with block entries in the CPU and SMMU page tables. */
+#define NVMAP_HANDLE_BIG_BLOCKS      (0x1ul << 10)
 
 #ifdef NVMAP_CONFIG_PAGE_POOLS
 ulong nvmap_page_pool_get_unused_pages(void);
@@ -474,6 +474,15 @@ struct nvs_fn_if {
 	int (*suspend)(void *handle);
 	int (*resume)(void *handle);
 	int (*handler)(void *handle, void *buffer, s64 ts);
+/* handler_batch drains an entire device FIFO in one call: buffer holds n
+ * consecutive data sets and the samples are pushed with timestamps linearly
+ * interpolated from ts_first to ts_last (the timestamps of the first and
+ * last sample in the FIFO). Avoids the per-sample handler overhead at high
+ * data rates.
+ * Returns the consumed byte count from buffer or a negative error code.
+ */
+	int (*handler_batch)(void *handle, void *buffer, unsigned int n,
+			     s64 ts_first, s64 ts_last);
 };
 
 extern const char * const nvs_float_significances[];
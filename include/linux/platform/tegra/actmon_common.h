@@ -12,6 +12,7 @@
  *
  */
 #ifndef ACTMON_COMMON_H
+#define ACTMON_COMMON_H
 
 #include <asm/io.h>
 
@@ -138,6 +139,11 @@ struct actmon_dev {
 
 	unsigned long boost_freq;
 	unsigned long boost_freq_step;
+	/* Client supplied expected-bandwidth hint, acts as a floor on the
+	 * governor decisions until hint_expires (in jiffies)
+	 */
+	unsigned long hint_freq;
+	unsigned long hint_expires;
 	unsigned int boost_up_coef;
 	unsigned int boost_down_coef;
 	unsigned int boost_up_threshold;
@@ -219,6 +225,8 @@ static inline void actmon_dev_writel(void __iomem *base, u32
 #if defined(CONFIG_TEGRA_CENTRAL_ACTMON)
 int tegra_actmon_register(struct actmon_drv_data *actmon);
 int tegra_actmon_remove(struct platform_device *pdev);
+int tegra_actmon_hint(enum actmon_devices dev_id, unsigned long freq_khz,
+	unsigned int duration_ms);
 #else
 static inline int tegra_actmon_register(struct actmon_drv_data *actmon)
 {
@@ -229,5 +237,11 @@ static inline int tegra_actmon_remove(struct platform_device *pdev)
 {
 	return -EINVAL;
 }
+
+static inline int tegra_actmon_hint(enum actmon_devices dev_id,
+	unsigned long freq_khz, unsigned int duration_ms)
+{
+	return -EINVAL;
+}
 #endif
 #endif /* ACTMON_COMMON_H */
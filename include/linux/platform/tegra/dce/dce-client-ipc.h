@@ -83,4 +83,36 @@ int tegra_dce_unregister_ipc_client(u32 handle);
  */
 int tegra_dce_client_ipc_send_recv(u32 handle, struct dce_ipc_message *msg);
 
+/*
+ * tegra_dce_client_ipc_done_t - completion callback for async rpcs.
+ *
+ * @handle: handle of the client that submitted the command.
+ * @seq: correlation id returned at submission time.
+ * @status: 0 on success else corresponding error value.
+ * @msg: the submitted message; rx.data holds the response on success.
+ * @usr_ctx: context passed at submission time.
+ *
+ * Called from the dce async workqueue; must not block on further
+ * dce rpcs.
+ */
+typedef void (*tegra_dce_client_ipc_done_t)(u32 handle, u32 seq,
+	      int status, struct dce_ipc_message *msg, void *usr_ctx);
+
+/*
+ * tegra_dce_client_ipc_send_async() - queue an rpc without waiting
+ * @handle : client_id registered with dce driver
+ * @msg : message to be sent and received; must stay valid until the
+ * completion callback runs
+ * @done_fn : completion callback
+ * @usr_ctx : context passed back to the completion callback
+ * @seqp : correlation id of the queued command, may be NULL
+ *
+ * Commands from one client complete in submission order; commands from
+ * different clients overlap instead of queueing behind each other.
+ *
+ * Return: 0 if the command was queued else corresponding error value.
+ */
+int tegra_dce_client_ipc_send_async(u32 handle, struct dce_ipc_message *msg,
+		tegra_dce_client_ipc_done_t done_fn, void *usr_ctx, u32 *seqp);
+
 #endif
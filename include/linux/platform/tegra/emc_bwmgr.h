@@ -141,6 +141,19 @@ struct bwmgr_ops *bwmgr_eff_init_t21x(void);
 struct bwmgr_ops *bwmgr_eff_init_t18x(void);
 struct bwmgr_ops *bwmgr_eff_init_t19x(void);
 
+/*
+ * Attributes derived from an EMC rate. bwmgr precomputes one entry
+ * per rate in the BPMP DVFS table and republishes the entry matching
+ * the applied rate on every rate change, so queries never take the
+ * bwmgr or clock framework locks.
+ */
+struct tegra_bwmgr_rate_attr {
+	unsigned long rate;	/* EMC rate in Hz */
+	unsigned long bw;	/* equivalent bandwidth */
+	unsigned long core_rate; /* rate adjusted by the emc:dram factor */
+	u32 dvfs_latency;	/* worst case DVFS latency in usec */
+};
+
 #if defined(CONFIG_TEGRA_BWMGR)
 /**
  * tegra_bwmgr_register - register an EMC Bandwidth Manager client.
@@ -178,6 +191,18 @@ u8 tegra_bwmgr_get_dram_num_channels(void);
  */
 unsigned long tegra_bwmgr_get_emc_rate(void);
 
+/**
+ * tegra_bwmgr_get_rate_attr - read the precomputed attributes of the
+ *			EMC rate last applied. Safe to call from any
+ *			context; the snapshot is read under a seqlock
+ *			and no other lock is taken.
+ *
+ * @attr	filled with the current rate attributes
+ *
+ * Returns success (0) or negative errno.
+ */
+int tegra_bwmgr_get_rate_attr(struct tegra_bwmgr_rate_attr *attr);
+
 /**
  * tegra_bwmgr_get_max_emc_rate - get the max EMC rate.
  *
@@ -222,6 +247,28 @@ unsigned long tegra_bwmgr_round_rate(unsigned long bw);
 int tegra_bwmgr_set_emc(struct tegra_bwmgr_client *handle, unsigned long val,
 		enum tegra_bwmgr_request_type req);
 
+/**
+ * tegra_bwmgr_set_emc_async - post an EMC rate request without waiting for
+ *			 the clock to be reprogrammed. Requests from all
+ *			 clients are coalesced and applied by a worker once
+ *			 per decision interval; posting again before the
+ *			 worker runs replaces the previous request. Safe to
+ *			 call from latency-sensitive paths. At most one
+ *			 poster per client handle may be active at a time.
+ *
+ * @handle      handle acquired during tegra_bwmgr_register
+ * @val         value to be set in Hz, 0 to clear old request of the same type
+ * @req         chosen type from tegra_bwmgr_request_type
+ * @complete    optional, invoked once from process context with the result
+ *		of the clock update after the request has been applied
+ * @priv        opaque pointer passed to @complete
+ *
+ * Returns success (0) or negative errno. On error @complete is not invoked.
+ */
+int tegra_bwmgr_set_emc_async(struct tegra_bwmgr_client *handle,
+		unsigned long val, enum tegra_bwmgr_request_type req,
+		void (*complete)(void *priv, int ret), void *priv);
+
 /**
  * tegra_bwmgr_get_client_info - outputs the value previously set with
  *                       tegra_bwmgr_set_emc or 0 if no value has been set.
@@ -236,6 +283,21 @@ int tegra_bwmgr_get_client_info(struct tegra_bwmgr_client *handle,
 		unsigned long *out_val,
 		enum tegra_bwmgr_request_type req);
 
+/**
+ * tegra_bwmgr_get_client_request - snapshot a client slot's current
+ *		bandwidth requests by client id, without a handle.
+ *
+ * @client	client id to inspect
+ * @name	out, static client name (may be NULL)
+ * @bw		out, requested shared BW in Hz (may be NULL)
+ * @iso_bw	out, requested ISO BW in Hz (may be NULL)
+ *
+ * Returns success (0), -EINVAL on a bad id or -ENOENT if the client
+ * slot is not registered.
+ */
+int tegra_bwmgr_get_client_request(enum tegra_bwmgr_client_id client,
+		const char **name, unsigned long *bw, unsigned long *iso_bw);
+
 /**
  * tegra_bwmgr_notifier_register - register a notifier callback when
  *		emc rate changes. Must be called from non-atomic
@@ -342,6 +404,10 @@ static inline unsigned long tegra_bwmgr_get_core_emc_rate(void)
 {
 	return 0;
 }
+static inline int tegra_bwmgr_get_rate_attr(struct tegra_bwmgr_rate_attr *attr)
+{
+	return -ENOTSUPP;
+}
 static inline unsigned long tegra_bwmgr_round_rate(unsigned long bw)
 {
 	static struct clk *bwmgr_emc_clk;
@@ -372,6 +438,15 @@ static inline int tegra_bwmgr_set_emc(struct tegra_bwmgr_client *handle,
 	return 0;
 }
 
+static inline int tegra_bwmgr_set_emc_async(struct tegra_bwmgr_client *handle,
+		unsigned long val, enum tegra_bwmgr_request_type req,
+		void (*complete)(void *priv, int ret), void *priv)
+{
+	if (complete)
+		complete(priv, 0);
+	return 0;
+}
+
 static inline int tegra_bwmgr_get_client_info(struct tegra_bwmgr_client *handle,
 		unsigned long *out_val,
 		enum tegra_bwmgr_request_type req)
@@ -382,6 +457,13 @@ static inline int tegra_bwmgr_get_client_info(struct tegra_bwmgr_client *handle,
 	return 0;
 }
 
+static inline int tegra_bwmgr_get_client_request(
+		enum tegra_bwmgr_client_id client,
+		const char **name, unsigned long *bw, unsigned long *iso_bw)
+{
+	return -ENOENT;
+}
+
 static inline int tegra_bwmgr_notifier_register(struct notifier_block *nb)
 {
 	return 0;
@@ -20,11 +20,28 @@
 #ifndef _INCLUDE_MACH_ISOMGR_H
 #define _INCLUDE_MACH_ISOMGR_H
 
+#include <linux/notifier.h>
 #include <linux/platform/tegra/emc_bwmgr.h>
 #include <linux/platform/tegra/iso_client.h>
 
 #define ISOMGR_MAGIC  0x150A1C
 
+/* headroom watermark notifier actions */
+#define TEGRA_ISOMGR_WMARK_BELOW	1
+#define TEGRA_ISOMGR_WMARK_ABOVE	2
+
+/* number of admitted (bw, lt) tuples cached per client */
+#define ISOMGR_MAX_ADMISSIONS	8
+
+/* precomputed admission result, valid while gen matches isomgr */
+struct isomgr_admission {
+	u32 bw;                 /* requested BW (KB/sec) */
+	u32 lt;                 /* requested LT (usec) */
+	u32 mf;                 /* precomputed min freq (KHz) */
+	u32 lto;                /* precomputed MC LT (usec) */
+	u32 gen;                /* admission generation at fill time */
+};
+
 /* handle to identify registered client */
 #define tegra_isomgr_handle void *
 
@@ -60,6 +77,8 @@ struct isomgr_client {
 				 */
 	void *priv;             /* client driver's private data */
 	struct completion cmpl; /* so we can sleep waiting for delta BW */
+	struct isomgr_admission admissions[ISOMGR_MAX_ADMISSIONS];
+	u32 next_admission;     /* round-robin fill cursor */
 
 #ifdef CONFIG_COMMON_CLK
 	struct tegra_bwmgr_client *bwmgr_handle;
@@ -99,6 +118,10 @@ struct isomgr {
 	s32 dedi_bw;                    /* total BW 'dedicated' to clients */
 	s32 sleep_bw;                   /* pending bw requirement */
 	u32 max_iso_bw;                 /* max ISO BW MC can accommodate */
+	u32 admission_gen;              /* bumped when admission inputs change */
+	s32 wmark_bw;                   /* headroom watermark, 0 = disabled */
+	bool below_wmark;               /* avail_bw is below the watermark */
+	u32 wmark_crossings;            /* times avail_bw fell below it */
 	struct kobject *kobj;           /* for sysfs linkage */
 	struct isomgr_ops *ops;         /* ops structure for isomgr*/
 };
@@ -158,6 +181,13 @@ u32 tegra_isomgr_get_available_iso_bw(void);
 /* returns total iso bw in KB/sec */
 u32 tegra_isomgr_get_total_iso_bw(enum tegra_iso_client client);
 
+/* sets the headroom watermark in KB/sec, 0 disables events */
+int tegra_isomgr_set_wmark(u32 bw);
+
+/* subscribe to/unsubscribe from headroom watermark events */
+int tegra_isomgr_register_wmark_notifier(struct notifier_block *nb);
+void tegra_isomgr_unregister_wmark_notifier(struct notifier_block *nb);
+
 /* Initialize isomgr.
  * This api would be called by .init_machine during boot.
  * isomgr clients, don't call this api.
@@ -210,6 +240,20 @@ static inline u32 tegra_isomgr_get_total_iso_bw(enum tegra_iso_client client)
 	return UINT_MAX;
 }
 
+static inline int tegra_isomgr_set_wmark(u32 bw)
+{
+	return 0;
+}
+
+static inline int tegra_isomgr_register_wmark_notifier(
+					struct notifier_block *nb)
+{
+	return 0;
+}
+
+static inline void tegra_isomgr_unregister_wmark_notifier(
+					struct notifier_block *nb) {}
+
 static inline int isomgr_init(void)
 {
 	return 0;
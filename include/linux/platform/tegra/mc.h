@@ -289,6 +289,9 @@ enum {
 
 int tegra_mc_flush(int id);
 int tegra_mc_flush_done(int id);
+int tegra_mc_flush_async(int id);
+int tegra_mc_flush_async_done(int id);
+int tegra_mc_flush_wait(int id);
 
 void tegra_mc_utils_init(void);
 
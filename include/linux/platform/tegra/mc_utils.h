@@ -43,6 +43,34 @@ enum dram_types {
 	DRAM_TYPE_LPDDR4_4CH_2RANK,
 };
 
+/*
+ * One point of the precomputed DRAM bandwidth/latency curve.
+ *
+ * The same layout is used for the in-kernel query API and for the
+ * entries of the "bw_latency_curve" sysfs binary blob.
+ */
+struct mc_bw_latency_point {
+	__u32 dram_clk_mhz;
+	__u32 mc_clk_mhz;
+	__u64 peak_bw_kbps;
+	__u32 latency_ns;
+	__u32 reserved;
+} __attribute__((__packed__));
+
+/*
+ * Header of the "bw_latency_curve" sysfs binary blob, followed by
+ * num_points instances of struct mc_bw_latency_point in ascending
+ * DRAM clock order.
+ */
+struct mc_bw_latency_header {
+	__u32 version;
+	__u32 dram_type;
+	__u32 num_channels;
+	__u32 num_points;
+} __attribute__((__packed__));
+
+#define MC_BW_LATENCY_VERSION	1
+
 void tegra_mc_utils_init(void);
 
 /*
@@ -101,4 +129,21 @@ u8 get_dram_num_channels(void);
  * Return: mc clk in MHz.
  */
 unsigned long dram_clk_to_mc_clk(unsigned long dram_clk);
+
+/*
+ * Query peak bandwidth and expected isochronous latency at a DRAM
+ * clock.
+ *
+ * Fills @point with the theoretical peak bandwidth for the detected
+ * channel configuration and the worst case latency derived from the
+ * per-DRAM-type disruption, refresh, training and calibration
+ * components.
+ *
+ * dram_clk_mhz: DRAM clock in MHz
+ * point: output curve point
+ * Return: 0 on success, -EINVAL for a zero clock, -ENODEV when the
+ * DRAM configuration is unknown.
+ */
+int tegra_mc_query_bw_latency(unsigned long dram_clk_mhz,
+				struct mc_bw_latency_point *point);
 #endif /* __TEGRA_MC_UTILS_H */
@@ -0,0 +1,49 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.  All rights reserved.
+ */
+
+#ifndef _LINUX_TEGRA_CLK_TXN_H
+#define _LINUX_TEGRA_CLK_TXN_H
+
+#include <linux/types.h>
+
+struct clk;
+
+/**
+ * struct tegra_clk_txn_entry - one staged rate change
+ *
+ * @clk:	clock to retarget
+ * @rate:	rate requested by the caller
+ * @rounded:	rate the clock will actually run at, filled by validation
+ * @saved:	rate at commit start, used for rollback on failure
+ */
+struct tegra_clk_txn_entry {
+	struct clk *clk;
+	unsigned long rate;
+	unsigned long rounded;
+	unsigned long saved;
+};
+
+/**
+ * struct tegra_clk_txn - a multi-clock rate transaction
+ *
+ * Storage for the entries is provided by the caller, typically an array
+ * embedded in driver state, so staging never allocates.
+ */
+struct tegra_clk_txn {
+	struct tegra_clk_txn_entry *entries;
+	unsigned int max_entries;
+	unsigned int num_entries;
+	bool validated;
+};
+
+int tegra_clk_txn_init(struct tegra_clk_txn *txn,
+		       struct tegra_clk_txn_entry *entries,
+		       unsigned int max_entries);
+int tegra_clk_txn_stage(struct tegra_clk_txn *txn, struct clk *clk,
+			unsigned long rate);
+int tegra_clk_txn_validate(struct tegra_clk_txn *txn);
+int tegra_clk_txn_commit(struct tegra_clk_txn *txn);
+
+#endif
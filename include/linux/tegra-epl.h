@@ -72,10 +72,15 @@ int epl_report_misc_ec_error(struct device *dev, uint8_t err_number, uint32_t sw
 /**
  * @brief API to report SW error via TOP2 HSP
  *
+ * The first occurrence of a given (reporter_id, error_code) pair is
+ * forwarded to the FSI immediately. Repeats arriving shortly after are
+ * coalesced into a single trailing report so that error storms do not
+ * flood the mailbox and delay other safety traffic.
+ *
  * @param[in]	error_report			Error frame to be reported
  *
  * @return
- *	0			(Success)
+ *	0			(Success, possibly coalesced with an earlier report)
  *	-ENODEV		(On device driver not loaded or not configured)
  *	-ETIME		(On timeout)
  */
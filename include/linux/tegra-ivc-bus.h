@@ -75,6 +75,7 @@ struct tegra_ivc_channel {
 	struct tegra_ivc_rpc_data *rpc_priv;
 	atomic_t bus_resets;
 	u16 group;
+	u32 priority;
 	bool is_ready;
 };
 
@@ -102,6 +102,8 @@ int tegra_mce_update_cstate_info(u32 cluster, u32 ccplex, u32 system,
 				 u8 force, u32 wake_mask, bool valid);
 int tegra_mce_update_crossover_time(u32 type, u32 time);
 int tegra_mce_read_cstate_stats(u32 state, u64 *stats);
+int tegra_mce_read_cstate_stats_batch(const u32 *states, u64 *stats,
+				      u32 count);
 int tegra_mce_write_cstate_stats(u32 state, u32 stats);
 int tegra_mce_is_sc7_allowed(u32 state, u32 wake, u32 *allowed);
 int tegra_mce_online_core(int cpu);
@@ -133,6 +135,7 @@ struct tegra_mce_ops {
 	int (*update_cstate_info)(u32, u32, u32, u8, u32, bool);
 	int (*update_crossover_time)(u32, u32);
 	int (*read_cstate_stats)(u32, u64 *);
+	int (*read_cstate_stats_batch)(const u32 *, u64 *, u32);
 	int (*write_cstate_stats)(u32, u32);
 	int (*is_sc7_allowed)(u32, u32, u32 *);
 	int (*online_core)(int);
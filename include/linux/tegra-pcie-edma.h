@@ -64,6 +64,19 @@ struct pcie_tegra_edma_remote_info {
 	uint16_t msi_data;
 	/** MSI address that needs to be configured on EP DMA registers */
 	uint64_t msi_addr;
+	/** Number of valid entries in msi_irqs[]. 0 or 1 keeps all completion
+	 *  handling on msi_irq; with more, channels are spread round-robin
+	 *  across the vectors and each vector gets a default affinity hint
+	 *  spread across the present CPUs, overridable per vector through
+	 *  /proc/irq/<N>/smp_affinity.
+	 */
+	uint32_t num_msi_irqs;
+	/** IRQ numbers of the MSI/MSI-X completion vectors. Vector n must be
+	 *  programmed to signal with MSI data msi_data + n at msi_addr; this
+	 *  holds for multi-message MSI and for MSI-X on GIC ITS based hosts,
+	 *  where the table entries share the translator doorbell address.
+	 */
+	uint32_t msi_irqs[DMA_WR_CHNL_NUM];
 	/** EP's DMA PHY base address, which same as BAR4 base address */
 	phys_addr_t dma_phy_base;
 	/** EP's DMA register spec size, which same as BAR4 size */
@@ -117,11 +130,19 @@ struct tegra_pcie_edma_desc {
 };
 
 /** @brief data strcuture needs to be passed for Tx operations */
+/**
+ * Channel selector for tegra_pcie_edma_xfer_info.channel_num: library picks
+ * the configured channel of the given type with the most free descriptors,
+ * striping concurrent submissions across channels.
+ */
+#define EDMA_CHAN_ANY			0xFFFFFFFFU
+
 struct tegra_pcie_edma_xfer_info {
 	/** Read or write operation. 0 -> write, 1->read */
 	edma_xfer_type_t type;
 	/** Channel on which operation needs to be performed.
-	 *  Range 0 to (DMA_RD_CHNL_NUM-1)/(DMA_WR_CHNL_NUM-1)
+	 *  Range 0 to (DMA_RD_CHNL_NUM-1)/(DMA_WR_CHNL_NUM-1), or
+	 *  EDMA_CHAN_ANY to let the library choose.
 	 */
 	uint32_t channel_num;
 	/** EDMA descriptor structure with source, destination DMA addr along with its size. */
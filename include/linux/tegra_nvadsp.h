@@ -101,6 +101,11 @@ struct nvadsp_mbox {
 
 #define NVADSP_MBOX_SMSG       0x1
 #define NVADSP_MBOX_LMSG       0x2
+/* Drop the send if an identical message is still queued for the hw
+ * mailbox. Only valid for pure doorbell messages where one delivery
+ * covers all work queued before it (e.g. shared msgq "message ready").
+ */
+#define NVADSP_MBOX_SMSG_COALESCE	0x4
 
 status_t nvadsp_mbox_open(struct nvadsp_mbox *mbox, uint16_t *mid,
 			  const char *name, nvadsp_mbox_handler_t handler,
@@ -109,6 +114,8 @@ status_t nvadsp_mbox_send(struct nvadsp_mbox *mbox, uint32_t data,
 			  uint32_t flags, bool block, unsigned int timeout);
 status_t nvadsp_mbox_recv(struct nvadsp_mbox *mbox, uint32_t *data, bool block,
 			  unsigned int timeout);
+status_t nvadsp_mbox_recv_poll(struct nvadsp_mbox *mbox, uint32_t *data,
+			       unsigned int poll_usec, unsigned int timeout);
 status_t nvadsp_mbox_close(struct nvadsp_mbox *mbox);
 
 #ifdef CONFIG_MBOX_ACK_HANDLER
@@ -31,11 +31,16 @@
 struct therm_est_sub_thz {
 	struct thermal_zone_device *thz;
 	long hist[HIST_LEN];
+	/* consecutive identical samples, capped at HIST_LEN + 1 */
+	int same_count;
 };
 
 struct therm_est_coeffs {
 	long toffset;
 	s32 (*coeffs)[HIST_LEN];
+	/* per-device sum of all HIST_LEN coefficients, for the
+	 * flat-history fastpath; may be NULL */
+	s32 *coeff_sums;
 };
 
 struct therm_est_subdevice {
@@ -222,5 +227,11 @@ struct therm_fan_estimator {
 	int nonsleep_hyst;
 
 	bool is_continuous_gov;
+
+	/* load feedforward: bias the estimate while a load hint is active */
+	long ff_gain; /* bias at 100% load hint, in mC */
+	long ff_timeout; /* load hint lifetime, in msec */
+	long ff_boost; /* current bias, in mC */
+	unsigned long ff_deadline; /* jiffies when the current bias expires */
 };
 #endif /* _LINUX_THERM_EST_H */
@@ -118,5 +118,35 @@ void te_close_trusted_session(void *ctx);
 int te_launch_trusted_oper(void *buf, size_t buf_len, uint32_t ta_cmd,
 		void *ctx);
 
+/* Maximum number of operations accepted by te_launch_trusted_opers */
+#define TE_MAX_BATCH_OPERS	8
+
+/*
+ * te_oper - one operation of a batched launch
+ * @buf: Buffer to sent to secure world (NULL if a buffer is not required).
+ * @buf_len: length of the buffer (0 if a buffer is not required).
+ * @ta_cmd: command to sent to secure world.
+ * @op_status: status code returned by the TA for this operation.
+ */
+struct te_oper {
+	void *buf;
+	size_t buf_len;
+	uint32_t ta_cmd;
+	uint32_t op_status;
+};
+
+/*
+ * te_launch_trusted_opers - Perform independent operations in one exchange
+ * @opers: array of operations to perform.
+ * @num_opers: number of operations, up to TE_MAX_BATCH_OPERS.
+ * @ctx: ctx returned by open session.
+ * All operations are queued to the TA before waiting for the replies, so
+ * a burst of independent calls pays for a single wait instead of one per
+ * operation. Returns 0 when every operation succeeds; on -EINVAL the
+ * per-operation status codes identify the failing operations.
+ */
+int te_launch_trusted_opers(struct te_oper *opers, uint32_t num_opers,
+		void *ctx);
+
 #endif /* __LINUX_TRUSTY_TRUSTY_IPC_H */
 
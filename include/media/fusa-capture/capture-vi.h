@@ -76,6 +76,13 @@ struct vi_capture {
 	struct syncpoint_info linetimer_sp;
 		/**< Syncpoint for frame line timer */
 
+	bool early_notify_enable;
+		/**< Patch line timer config into capture requests */
+	bool early_notify_periodic;
+		/**< Signal every early_notify_line lines instead of once */
+	uint16_t early_notify_line;
+		/**< Scanline at which the line timer syncpoint is signalled */
+
 	struct completion control_resp;
 		/**< Completion for capture-control IVC response */
 	struct completion capture_resp;
@@ -94,6 +101,22 @@ struct vi_capture {
 	struct capture_common_unpins *unpins_list;
 		/**< List of capture request buffer unpins */
 
+	uint64_t *pending_seq;
+		/**< Per-buffer submit sequence number, 0 when not in flight */
+	uint64_t submit_seq;
+		/**< Monotonic capture request submission counter */
+
+	bool syncpt_status_enable;
+		/**<
+		 * Routine frame completion is signaled from the progress
+		 * syncpoint instead of a per-frame CAPTURE_STATUS_IND
+		 */
+	uint32_t sp_fence;
+		/**<
+		 * Progress syncpoint threshold of the last submitted
+		 * capture request
+		 */
+
 	uint64_t vi_channel_mask;
 		/**< Bitmask of RCE-assigned VI FW channel(s). */
 	uint64_t vi2_channel_mask;
@@ -205,6 +228,40 @@ struct vi_capture_req {
 		 */
 } __VI_CAPTURE_ALIGN;
 
+/**
+ * @brief VI capture request ring (IOCTL payload).
+ *
+ * Enqueues a batch of future capture requests in one call, so that RCE
+ * always has the next capture descriptor resident and the per-frame
+ * request submission is off the frame-interval critical path.
+ */
+struct vi_capture_req_ring {
+	uint64_t reqs;
+		/**<
+		 * Pointer to an array of @ref vi_capture_req, enqueued in
+		 * array order.
+		 */
+	uint32_t num_reqs;
+		/**< No. of requests in the array, up to the queue depth. */
+	uint32_t __pad;
+} __VI_CAPTURE_ALIGN;
+
+/**
+ * @brief VI capture early-completion notification config (IOCTL payload).
+ *
+ * Programs the VI line timer so that the channel's line timer syncpoint
+ * is signalled when the configured scanline has been written to memory,
+ * ahead of the end-of-frame progress syncpoint.
+ */
+struct vi_capture_early_notify {
+	uint8_t enable;
+		/**< Patch line timer config into subsequent capture requests */
+	uint8_t periodic;
+		/**< Signal every @ref line lines instead of once per frame */
+	uint16_t line; /**< Scanline at which to signal the syncpoint */
+	uint32_t __pad;
+} __VI_CAPTURE_ALIGN;
+
 /**
  * @brief VI capture progress status setup config (IOCTL payload)
  */
@@ -346,6 +403,25 @@ int vi_capture_reset(
 	struct tegra_vi_channel *chan,
 	uint32_t reset_flags);
 
+/**
+ * @brief Recover an errored VI channel in place and resubmit its pending
+ * capture requests.
+ *
+ * Unlike a full teardown/rebuild cycle, buffer pins, the capture descriptor
+ * queue and the RCE channel allocation are all retained: the channel is reset
+ * in RCE and the capture requests that were in flight at the time of the
+ * error are re-enqueued in their original submission order.
+ *
+ * @param[in]	chan		VI channel context
+ * @param[in]	reset_flags	Bitmask for VI channel reset options
+ *				(CAPTURE_CHANNEL_RESET_FLAG_*)
+ *
+ * @returns	0 (success), neg. errno (failure)
+ */
+int vi_capture_recover(
+	struct tegra_vi_channel *chan,
+	uint32_t reset_flags);
+
 /**
  * @brief Release an opened VI channel; the RCE channel allocation, syncpts and
  * IVC channel callbacks are released.
@@ -471,4 +547,21 @@ int vi_capture_set_progress_status_notifier(
 	struct tegra_vi_channel *chan,
 	struct vi_capture_progress_status_req *req);
 
+/**
+ * @brief Configure early-completion notification at scanline granularity.
+ *
+ * The channel must have been set up with
+ * @ref CAPTURE_CHANNEL_FLAG_LINETIMER so that the line timer syncpoint
+ * exists. Subsequent capture requests have the line timer programmed to
+ * the configured scanline before submission to RCE.
+ *
+ * @param[in]	chan	VI channel context
+ * @param[in]	notify	VI early notification config
+ *
+ * @returns	0 (success), neg. errno (failure)
+ */
+int vi_capture_set_early_notify(
+	struct tegra_vi_channel *chan,
+	struct vi_capture_early_notify *notify);
+
 #endif /* __FUSA_CAPTURE_VI_H__ */
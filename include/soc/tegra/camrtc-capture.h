@@ -304,6 +304,9 @@ typedef struct syncpoint_info {
 #define CAPTURE_CHANNEL_FLAG_ENABLE_VI_PFSD	MK_U32(0x8000)
 /** Channel binds to a CSI stream and channel */
 #define CAPTURE_CHANNEL_FLAG_CSI		MK_U32(0x10000)
+/** Routine frame completion is signaled by the progress syncpoint only;
+ * CAPTURE_STATUS_IND is sent for errors and metadata */
+#define CAPTURE_CHANNEL_FLAG_SILENT_STATUS	MK_U32(0x20000)
 
   /**@}*/
 
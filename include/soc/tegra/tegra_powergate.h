@@ -36,4 +36,35 @@ static inline int tegra_bpmp_init_powergate(struct platform_device *pdev)
 }
 #endif
 
+/*
+ * One member of a partition batch. depends_on names the index of an
+ * earlier entry in the same batch that must be ungated before this one,
+ * or -1 when the partition has no ordering requirement.
+ */
+struct tegra_pg_batch_entry {
+	int id;
+	int depends_on;
+};
+
+#if defined(CONFIG_ARCH_TEGRA_18x_SOC) || defined(CONFIG_ARCH_TEGRA_19x_SOC)
+int tegra_unpowergate_partitions(const struct tegra_pg_batch_entry *entries,
+				 unsigned int count);
+int tegra_powergate_partitions(const struct tegra_pg_batch_entry *entries,
+			       unsigned int count);
+#else
+static inline int
+tegra_unpowergate_partitions(const struct tegra_pg_batch_entry *entries,
+			     unsigned int count)
+{
+	return -ENOSYS;
+}
+
+static inline int
+tegra_powergate_partitions(const struct tegra_pg_batch_entry *entries,
+			   unsigned int count)
+{
+	return -ENOSYS;
+}
+#endif
+
 #endif
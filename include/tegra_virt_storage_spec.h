@@ -351,6 +351,42 @@ typedef struct vblk_ufs_combo_info {
 	uint8_t need_cq_empty;
 }vblk_ufs_combo_info_t;
 
+/* Cross-VM shared read-only block cache.
+ *
+ * The storage server may expose an additional mempool holding a cache of
+ * recently served blocks, shared read-only by all guests backed by the
+ * same physical device.  The region starts with vs_cache_header, followed
+ * by num_entries descriptors, followed by the cache lines themselves.
+ * Lines are direct-mapped: a device block range starting at block B is
+ * held (if at all) by entry (B / line_blks) % num_entries.
+ *
+ * Only the server writes the region.  A guest validates an entry with a
+ * seqcount-style generation: the server makes the generation odd while a
+ * line is being filled, makes it even once the line is consistent, and
+ * bumps it whenever a write or discard from any guest touches the line.
+ * A guest copies the data and re-reads the generation afterwards; if it
+ * changed, or was odd to begin with, the guest falls back to a regular
+ * IVC read.
+ */
+#define VS_CACHE_MAGIC		0x56534243 /* "VSBC" */
+#define VS_CACHE_VERSION	1
+
+struct vs_cache_entry {
+	uint64_t blk_offset;	/* first device block held by this line,
+					aligned to line_blks */
+	uint32_t num_blks;	/* valid blocks in the line, 0 when empty */
+	uint32_t generation;	/* odd while the line is inconsistent */
+};
+
+struct vs_cache_header {
+	uint32_t magic;		/* VS_CACHE_MAGIC */
+	uint32_t version;	/* VS_CACHE_VERSION */
+	uint32_t line_blks;	/* cache line length in device blocks */
+	uint32_t num_entries;	/* number of cache lines */
+	uint64_t data_offset;	/* offset of the first line from the start
+					of the region */
+};
+
 #pragma pack(pop)
 
 #endif
@@ -778,6 +778,60 @@ TRACE_EVENT(nvhost_channel_submit_complete,
 		__entry->name, __entry->count, __entry->thresh)
 );
 
+/*
+ * Job lifecycle events keyed by the per-job id assigned at allocation
+ * time. Each stage of a submit emits one event so that per-stage
+ * latencies can be derived offline by pairing events with the same id.
+ */
+DECLARE_EVENT_CLASS(nvhost_job_lifecycle,
+	TP_PROTO(const char *name, u64 job_id, u32 syncpt_id, u32 fence),
+
+	TP_ARGS(name, job_id, syncpt_id, fence),
+
+	TP_STRUCT__entry(
+		__field(const char *, name)
+		__field(u64, job_id)
+		__field(u32, syncpt_id)
+		__field(u32, fence)
+	),
+
+	TP_fast_assign(
+		__entry->name = name;
+		__entry->job_id = job_id;
+		__entry->syncpt_id = syncpt_id;
+		__entry->fence = fence;
+	),
+
+	TP_printk("name=%s, job_id=%llu, syncpt_id=%u, fence=%u",
+		__entry->name, __entry->job_id, __entry->syncpt_id,
+		__entry->fence)
+);
+
+DEFINE_EVENT(nvhost_job_lifecycle, nvhost_job_submit,
+	TP_PROTO(const char *name, u64 job_id, u32 syncpt_id, u32 fence),
+	TP_ARGS(name, job_id, syncpt_id, fence)
+);
+
+DEFINE_EVENT(nvhost_job_lifecycle, nvhost_job_pin_done,
+	TP_PROTO(const char *name, u64 job_id, u32 syncpt_id, u32 fence),
+	TP_ARGS(name, job_id, syncpt_id, fence)
+);
+
+DEFINE_EVENT(nvhost_job_lifecycle, nvhost_job_kick,
+	TP_PROTO(const char *name, u64 job_id, u32 syncpt_id, u32 fence),
+	TP_ARGS(name, job_id, syncpt_id, fence)
+);
+
+DEFINE_EVENT(nvhost_job_lifecycle, nvhost_job_syncpt_reached,
+	TP_PROTO(const char *name, u64 job_id, u32 syncpt_id, u32 fence),
+	TP_ARGS(name, job_id, syncpt_id, fence)
+);
+
+DEFINE_EVENT(nvhost_job_lifecycle, nvhost_job_complete,
+	TP_PROTO(const char *name, u64 job_id, u32 syncpt_id, u32 fence),
+	TP_ARGS(name, job_id, syncpt_id, fence)
+);
+
 TRACE_EVENT(nvhost_wait_cdma,
 	TP_PROTO(const char *name, u32 eventid),
 
@@ -206,6 +206,22 @@ struct nv_camera_task_log {
 	__u32 tid;
 } __packed;
 
+/* Marks an NVCSI interrupt or error reported by RCE */
+struct nv_camera_nvcsi_intr {
+
+	/* Interrupt class (global/correctable/uncorrectable) */
+	__u32 intr_class;
+
+	/* Interrupt type (phy/stream/host1x/...) */
+	__u32 intr_type;
+
+	/* Interrupt index within its type */
+	__u32 index;
+
+	/* Raw interrupt status */
+	__u32 status;
+} __packed;
+
 enum {
 	/* struct nvhost_task_submit */
 	NVHOST_TASK_SUBMIT = 0,
@@ -294,7 +310,10 @@ enum {
 	/* struct nv_camera_task_log */
 	NVHOST_CAMERA_TASK_LOG = 35,
 
-	NVHOST_NUM_EVENT_TYPES = 36
+	/* struct nv_camera_nvcsi_intr */
+	NVHOST_CAMERA_NVCSI_INTR = 36,
+
+	NVHOST_NUM_EVENT_TYPES = 37
 };
 
 enum {
@@ -201,6 +201,10 @@ struct nvhost32_submit_args {
 } __packed;
 
 #define NVHOST_SUBMIT_FLAG_SYNC_FENCE_FD	0
+/* Do not serialize against the previous job in the channel; the submit
+ * carries its dependencies as explicit syncpoint waitchks. Only honored
+ * on engines that advertise pipelined submits. */
+#define NVHOST_SUBMIT_FLAG_PIPELINED		1
 #define NVHOST_SUBMIT_MAX_NUM_SYNCPT_INCRS	10
 
 struct nvhost_submit_args {
@@ -218,7 +222,8 @@ struct nvhost_submit_args {
 	__u32 checksum_methods;
 	__u32 checksum_falcon_methods;
 
-	__u64 pad[1];		/* future expansion */
+	__u64 trace_id;		/* frame trace id for pipeline tracing,
+				 * 0 = untraced (was unused padding) */
 
 	__u64 reloc_types;
 	__u64 cmdbufs;
@@ -273,6 +278,10 @@ struct nvhost_channel_attach_syncpt_args {
 	__u32 flags;
 };
 
+struct nvhost_set_vm_group_args {
+	__u64 token;	/* non-zero group key; 0 reverts to per-process */
+};
+
 #define NVHOST_IOCTL_CHANNEL_GET_SYNCPOINTS	\
 	_IOR(NVHOST_IOCTL_MAGIC, 2, struct nvhost_get_param_args)
 #define NVHOST_IOCTL_CHANNEL_GET_WAITBASES	\
@@ -327,6 +336,8 @@ struct nvhost_channel_attach_syncpt_args {
 	_IOW(NVHOST_IOCTL_MAGIC, 30, struct nvhost_set_syncpt_name_args)
 #define NVHOST_IOCTL_CHANNEL_ATTACH_SYNCPT \
 	_IOWR(NVHOST_IOCTL_MAGIC, 31, struct nvhost_channel_attach_syncpt_args)
+#define NVHOST_IOCTL_CHANNEL_SET_VM_GROUP \
+	_IOW(NVHOST_IOCTL_MAGIC, 32, struct nvhost_set_vm_group_args)
 
 #define NVHOST_IOCTL_CHANNEL_SET_ERROR_NOTIFIER  \
 	_IOWR(NVHOST_IOCTL_MAGIC, 111, struct nvhost_set_error_notifier)
@@ -475,6 +486,28 @@ struct nvhost_ctrl_sync_file_extract {
 	__u64 fences_ptr;
 };
 
+/* one entry of a vectored syncpoint operation batch */
+struct nvhost_ctrl_syncpt_op {
+#define NVHOST_SYNCPT_OP_READ		0
+#define NVHOST_SYNCPT_OP_READ_MAX	1
+#define NVHOST_SYNCPT_OP_INCR		2
+#define NVHOST_SYNCPT_OP_WAIT		3
+	__u32 op;
+	__u32 id;
+	__u32 arg;	/* INCR: increment count, WAIT: threshold */
+	__s32 timeout;	/* WAIT: timeout in ms, NVHOST_NO_TIMEOUT allowed */
+	__u32 value;	/* out: syncpoint value after the operation */
+	__s32 result;	/* out: 0 or negative errno of this entry */
+};
+
+#define NVHOST_SYNCPT_BATCH_MAX_OPS	64
+
+struct nvhost_ctrl_syncpt_batch_args {
+	__u64 ops;	/* struct nvhost_ctrl_syncpt_op* */
+	__u32 num_ops;
+	__u32 num_done;	/* out: entries completed without error */
+};
+
 struct nvhost_ctrl_syncpt_dmabuf_args {
 	__s32 syncpt_fd;
 	__s32 dmabuf_fd;
@@ -484,6 +517,17 @@ struct nvhost_ctrl_syncpt_dmabuf_args {
 	__u32 padding;
 };
 
+#define NVHOST_SYNCPT_DMABUF_BATCH_MAX	64
+
+struct nvhost_ctrl_syncpt_dmabuf_batch_args {
+	__u64 syncpt_fds;	/* __s32 array of syncpoint fds */
+	__u64 dmabuf_fds;	/* out: __s32 array, dmabuf fd or -errno */
+	__u32 num_syncpts;
+	__u32 num_done;		/* out: entries exported without error */
+	__u32 syncpt_page_size;	/* out */
+	__u32 padding;
+};
+
 #define NVHOST_IOCTL_CTRL_SYNCPT_READ		\
 	_IOWR(NVHOST_IOCTL_MAGIC, 1, struct nvhost_ctrl_syncpt_read_args)
 #define NVHOST_IOCTL_CTRL_SYNCPT_INCR		\
@@ -533,8 +577,14 @@ struct nvhost_ctrl_syncpt_dmabuf_args {
 #define NVHOST_IOCTL_CTRL_GET_SYNCPT_DMABUF_FD     \
 	_IOWR(NVHOST_IOCTL_MAGIC, 20, struct nvhost_ctrl_syncpt_dmabuf_args)
 
+#define NVHOST_IOCTL_CTRL_SYNCPT_BATCH		\
+	_IOWR(NVHOST_IOCTL_MAGIC, 21, struct nvhost_ctrl_syncpt_batch_args)
+
+#define NVHOST_IOCTL_CTRL_SYNCPT_DMABUF_BATCH	\
+	_IOWR(NVHOST_IOCTL_MAGIC, 22, struct nvhost_ctrl_syncpt_dmabuf_batch_args)
+
 #define NVHOST_IOCTL_CTRL_LAST			\
-	_IOC_NR(NVHOST_IOCTL_CTRL_GET_SYNCPT_DMABUF_FD)
+	_IOC_NR(NVHOST_IOCTL_CTRL_SYNCPT_DMABUF_BATCH)
 #define NVHOST_IOCTL_CTRL_MAX_ARG_SIZE	\
 	sizeof(struct nvhost_ctrl_syncpt_waitmex_args)
 
@@ -0,0 +1,91 @@
+/*
+ * Eventlib interface for correlated frame pipeline tracing
+ *
+ * Copyright (c) 2022, NVIDIA Corporation.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NVHOST_PIPELINE_EVENTS_H
+#define NVHOST_PIPELINE_EVENTS_H
+
+enum {
+	NVHOST_PIPELINE_SCHEMA_VERSION = 1
+};
+
+#define NVHOST_PIPELINE_EVENT_PROVIDER_NAME "nv_pipeline"
+
+/*
+ * Frames flowing through the capture/compute/display pipeline are keyed
+ * by a trace id so that the per-stage events of one frame can be joined
+ * into an end-to-end latency record. The id is assigned by the client
+ * and passed down with each stage submission where the UAPI carries it
+ * (nvhost channel submits and display flips); 0 means untraced and is
+ * never logged. On the VI capture path, where the request format cannot
+ * carry a client id, the kernel derives the id as
+ * ((u64)channel_id << 32) | buffer_index, which a client can compute
+ * from the same values it used for the capture request.
+ */
+
+/* A frame passing one pipeline stage */
+struct nvhost_pipeline_frame {
+	/* Per-frame trace ID, correlates events across stages */
+	__u64 trace_id;
+
+	/* Pipeline stage, one of NVHOST_PIPELINE_STAGE_* */
+	__u32 stage;
+
+	/* Engine class ID, 0 where not applicable */
+	__u32 class_id;
+
+	/* Stage detail: buffer index, syncpoint threshold or frame count */
+	__u32 extra;
+
+	/* PID */
+	__u32 pid;
+
+	/* TID */
+	__u32 tid;
+} __packed;
+
+/* Pipeline stages reported in nvhost_pipeline_frame */
+enum {
+	/* VI capture request sent to RCE */
+	NVHOST_PIPELINE_STAGE_CAPTURE_REQUEST = 0,
+
+	/* VI capture status indication received from RCE */
+	NVHOST_PIPELINE_STAGE_CAPTURE_STATUS = 1,
+
+	/* nvhost channel job submitted to hardware */
+	NVHOST_PIPELINE_STAGE_ENGINE_SUBMIT = 2,
+
+	/* nvhost channel job syncpoint threshold reached */
+	NVHOST_PIPELINE_STAGE_ENGINE_COMPLETE = 3,
+
+	/* Display flip queued to the flip worker */
+	NVHOST_PIPELINE_STAGE_FLIP_QUEUED = 4,
+
+	/* Display flip latched into active scanout */
+	NVHOST_PIPELINE_STAGE_FLIP_PRESENTED = 5,
+
+	NVHOST_PIPELINE_NUM_STAGES = 6
+};
+
+enum {
+	/* struct nvhost_pipeline_frame */
+	NVHOST_PIPELINE_FRAME = 0,
+
+	NVHOST_PIPELINE_NUM_EVENT_TYPES = 1
+};
+
+#endif /* NVHOST_PIPELINE_EVENTS_H */
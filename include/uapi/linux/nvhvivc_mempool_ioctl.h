@@ -14,10 +14,18 @@
 #define __UAPI_NVHVIVC_MEMPOOL_IOCTL_H__
 
 #include <linux/ioctl.h>
+#include <linux/types.h>
 
 /* ivc mempool IOCTL magic number */
 #define TEGRA_MPLUSERSPACE_IOCTL_MAGIC 0xA6
 
+/* address range inside the caller's mempool mapping */
+struct ivc_mempool_range {
+	/* start address within the caller's mapping of the mempool */
+	__u64 addr;
+	/* length of the range in bytes */
+	__u64 size;
+};
 
 /* IOCTL definitions */
 
@@ -25,6 +33,14 @@
 #define TEGRA_MPLUSERSPACE_IOCTL_GET_INFO \
 	_IOR(TEGRA_MPLUSERSPACE_IOCTL_MAGIC, 1, struct ivc_mempool)
 
-#define TEGRA_MPLUSERSPACE_IOCTL_NUMBER_MAX 1
+/* populate mappings for a range ahead of demand faults */
+#define TEGRA_MPLUSERSPACE_IOCTL_PREFETCH \
+	_IOW(TEGRA_MPLUSERSPACE_IOCTL_MAGIC, 2, struct ivc_mempool_range)
+
+/* drop mappings for a range; pages fault back in on next access */
+#define TEGRA_MPLUSERSPACE_IOCTL_RELEASE \
+	_IOW(TEGRA_MPLUSERSPACE_IOCTL_MAGIC, 3, struct ivc_mempool_range)
+
+#define TEGRA_MPLUSERSPACE_IOCTL_NUMBER_MAX 3
 
 #endif /* __UAPI_NVHVIVC_MEMPOOL_IOCTL_H__ */
@@ -41,6 +41,8 @@ enum {
 	NVMAP_CACHE_OP_WB = 0,
 	NVMAP_CACHE_OP_INV,
 	NVMAP_CACHE_OP_WB_INV,
+	/* record the range; maintenance is issued lazily at map time */
+	NVMAP_CACHE_OP_WB_DEFER,
 };
 
 enum {
@@ -225,6 +227,43 @@ struct nvmap_sciipc_map {
 	__u32 handle;      /* Nvmap handle */
 };
 
+struct nvmap_sciipc_map_entry {
+	__u32 flags;       /* Exporter permission flags */
+	__u32 sci_ipc_id;  /* FromImportId */
+	__u32 handle;      /* Nvmap handle */
+	__u32 reserved;
+};
+
+/*
+ * Bulk variant of the SCI_IPC export/import ioctls. The auth token is
+ * validated once for the whole array. On failure the ioctl returns an
+ * error after copying back the array; entries processed before the
+ * failing one keep their results.
+ */
+struct nvmap_sciipc_map_bulk {
+	__u64 auth_token;    /* AuthToken */
+	__u64 entries;       /* pointer to struct nvmap_sciipc_map_entry[] */
+	__u32 count;         /* number of entries */
+	__u32 reserved;
+};
+
+/*
+ * NVMAP_IOC_WRITE_DIRECT: write `count` bytes of a handle, starting at
+ * `handle_offset`, to `file_offset` of a file opened with O_DIRECT. The
+ * handle's pages are handed to the filesystem as the IO source, so no
+ * intermediate copy through the page cache is made and the target
+ * file's direct-IO alignment constraints apply to the offsets and the
+ * count. On success `result` holds the number of bytes written.
+ */
+struct nvmap_direct_write {
+	__u32 handle;		/* nvmap handle */
+	__u32 file_fd;		/* target file, opened with O_DIRECT */
+	__u64 handle_offset;	/* byte offset into the handle */
+	__u64 file_offset;	/* byte offset into the file */
+	__u64 count;		/* number of bytes to write */
+	__u64 result;		/* out: number of bytes written */
+};
+
 struct nvmap_handle_parameters {
     __u8 contig;
     __u32 import_id;
@@ -259,6 +298,19 @@ struct nvmap_duplicate_handle {
 	__u32 dup_handle;
 };
 
+/**
+ * Struct used to register an eventfd for page pool pressure notification.
+ * The eventfd is signalled once when pool occupancy drops below the low
+ * watermark and is re-armed when it recovers above the high watermark.
+ * Watermarks are in percent of the maximum pool size. An eventfd of -1
+ * removes the registration.
+ */
+struct nvmap_pool_pressure {
+	__s32 eventfd;
+	__u32 low_watermark;
+	__u32 high_watermark;
+};
+
 #define NVMAP_IOC_MAGIC 'N'
 
 /* Creates a new memory handle. On input, the argument is the size of the new
@@ -361,6 +413,22 @@ struct nvmap_duplicate_handle {
 #define NVMAP_IOC_DUP_HANDLE _IOWR(NVMAP_IOC_MAGIC, 106, \
 		struct nvmap_duplicate_handle)
 
-#define NVMAP_IOC_MAXNR (_IOC_NR(NVMAP_IOC_DUP_HANDLE))
+/* Get SCI_IPC_IDs for an array of nvmap handles */
+#define NVMAP_IOC_GET_SCIIPCID_BULK _IOWR(NVMAP_IOC_MAGIC, 107, \
+		struct nvmap_sciipc_map_bulk)
+
+/* Get Nvmap handles from an array of SCI_IPC_IDs */
+#define NVMAP_IOC_HANDLE_FROM_SCIIPCID_BULK _IOWR(NVMAP_IOC_MAGIC, 108, \
+		struct nvmap_sciipc_map_bulk)
+
+/* Write handle contents to an O_DIRECT file without a bounce copy */
+#define NVMAP_IOC_WRITE_DIRECT _IOWR(NVMAP_IOC_MAGIC, 109, \
+		struct nvmap_direct_write)
+
+/* Register an eventfd for page pool pressure notification */
+#define NVMAP_IOC_POOL_PRESSURE _IOW(NVMAP_IOC_MAGIC, 110, \
+		struct nvmap_pool_pressure)
+
+#define NVMAP_IOC_MAXNR (_IOC_NR(NVMAP_IOC_POOL_PRESSURE))
 
 #endif /* __UAPI_LINUX_NVMAP_H */
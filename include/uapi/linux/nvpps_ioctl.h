@@ -34,7 +34,7 @@ struct nvpps_version {
 #define NVPPS_VERSION_MAJOR	0
 #define NVPPS_VERSION_MINOR	2
 #define NVPPS_API_MAJOR		0
-#define NVPPS_API_MINOR         4
+#define NVPPS_API_MINOR         5
 
 struct nvpps_params {
 	__u32	evt_mode;
@@ -80,6 +80,45 @@ struct nvpps_timestamp_struct {
 };
 
 
+/* Layout of the read-only page returned by mmap() on the nvpps device.
+ * The kernel appends a sample to the ring on every PPS event; userspace
+ * can read timestamp tuples without any syscall:
+ *
+ *	idx = READ_ONCE(hdr->head);
+ *	seq = READ_ONCE(sample[idx].seq); (repeat while odd)
+ *	copy sample, then re-read seq; retry if it changed.
+ *
+ * tsc is always in raw counter units; multiply by tsc_res_ns from the
+ * header to convert to nanoseconds.
+ */
+#define NVPPS_SHM_MAGIC		0x7350564e	/* "NVPs" */
+#define NVPPS_SHM_VERSION	1
+/* number of ring entries, power of 2 */
+#define NVPPS_SHM_RING_SZ	16
+
+struct nvpps_shm_sample {
+	/* odd while the entry is being rewritten */
+	__u32	seq;
+	__u32	evt_nb;
+	__u64	tsc;
+	__u64	ptp;
+	__s64	ptp_offset;
+	__u64	irq_latency;
+	__u32	evt_mode;
+	__u32	reserved;
+};
+
+struct nvpps_shm_hdr {
+	__u32	magic;
+	__u32	version;
+	__u32	ring_size;
+	/* index of the most recently published sample */
+	__u32	head;
+	__u64	tsc_res_ns;
+	struct nvpps_shm_sample	samples[NVPPS_SHM_RING_SZ];
+};
+
+
 #define NVPPS_GETVERSION	_IOR('p', 0x1, struct nvpps_version *)
 #define NVPPS_GETPARAMS		_IOR('p', 0x2, struct nvpps_params *)
 #define NVPPS_SETPARAMS		_IOW('p', 0x3, struct nvpps_params *)
@@ -62,6 +62,13 @@ struct nvsciipc_get_vuid {
 	uint64_t vuid;
 };
 
+struct nvsciipc_get_db {
+	/* in: capacity of entries array, out: endpoint count in database */
+	int num_eps;
+	/* user buffer for num_eps entries, may be NULL to query the count */
+	struct nvsciipc_config_entry *entries;
+};
+
 /* IOCTL magic number - seen available in ioctl-number.txt*/
 #define NVSCIIPC_IOCTL_MAGIC    0xC3
 
@@ -71,6 +78,9 @@ struct nvsciipc_get_vuid {
 #define NVSCIIPC_IOCTL_GET_VUID \
 	_IOWR(NVSCIIPC_IOCTL_MAGIC, 2, struct nvsciipc_get_vuid)
 
-#define NVSCIIPC_IOCTL_NUMBER_MAX 2
+#define NVSCIIPC_IOCTL_GET_DB \
+	_IOWR(NVSCIIPC_IOCTL_MAGIC, 3, struct nvsciipc_get_db)
+
+#define NVSCIIPC_IOCTL_NUMBER_MAX 3
 
 #endif /* __NVSCIIPC_IOCTL_H__ */
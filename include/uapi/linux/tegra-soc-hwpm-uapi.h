@@ -287,6 +287,19 @@ struct tegra_soc_hwpm_update_get_put {
 	__u8 b_overflowed;
 };
 
+/* TEGRA_CTRL_CMD_SOC_HWPM_PERIODIC_SAMPLE IOCTL */
+#define TEGRA_SOC_HWPM_SAMPLE_INTERVAL_MIN_NS	100000
+struct tegra_soc_hwpm_periodic_sample {
+	/*
+	 * Input and Output
+	 *
+	 * Requested sampling interval in nanoseconds. 0 disables periodic
+	 * sampling. Requests below TEGRA_SOC_HWPM_SAMPLE_INTERVAL_MIN_NS are
+	 * raised to the minimum. The applied interval is returned.
+	 */
+	__u64 interval_ns;
+};
+
 /* IOCTL enum */
 enum tegra_soc_hwpm_ioctl_num {
 	TEGRA_SOC_HWPM_IOCTL_DEVICE_INFO,
@@ -298,6 +311,7 @@ enum tegra_soc_hwpm_ioctl_num {
 	TEGRA_SOC_HWPM_IOCTL_QUERY_ALLOWLIST,
 	TEGRA_SOC_HWPM_IOCTL_EXEC_REG_OPS,
 	TEGRA_SOC_HWPM_IOCTL_UPDATE_GET_PUT,
+	TEGRA_SOC_HWPM_IOCTL_PERIODIC_SAMPLE,
 	TERGA_SOC_HWPM_NUM_IOCTLS
 };
 
@@ -365,6 +379,7 @@ enum tegra_soc_hwpm_ioctl_num {
  *    - QUERY_ALLOWLIST
  *    - EXEC_REG_OPS
  *    - UPDATE_GET_PUT
+ *    - PERIODIC_SAMPLE
  */
 #define TEGRA_CTRL_CMD_BIND						\
 			_IO(TEGRA_SOC_HWPM_IOC_MAGIC,			\
@@ -402,6 +417,21 @@ enum tegra_soc_hwpm_ioctl_num {
 				TEGRA_SOC_HWPM_IOCTL_UPDATE_GET_PUT,	\
 				struct tegra_soc_hwpm_update_get_put)
 
+/*
+ * IOCTL for timed periodic sampling of the PMA output stream
+ *
+ * While enabled, the driver triggers MEM_BYTES streaming at the requested
+ * interval so that userspace can follow the stream buffer by polling the
+ * mapped MEM_BYTES buffer, without issuing a syscall per sampling window.
+ * Periodic sampling is stopped on device release.
+ *
+ * This IOCTL can only be called after the BIND IOCTL
+ */
+#define	TEGRA_CTRL_CMD_SOC_HWPM_PERIODIC_SAMPLE				\
+			_IOWR(TEGRA_SOC_HWPM_IOC_MAGIC,			\
+				TEGRA_SOC_HWPM_IOCTL_PERIODIC_SAMPLE,	\
+				struct tegra_soc_hwpm_periodic_sample)
+
 
 /* Interface for IP driver communication */
 
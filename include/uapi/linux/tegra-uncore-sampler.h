@@ -0,0 +1,55 @@
+/*
+ * Layout of the mmap-able uncore sample ring exported by the Carmel
+ * uncore PMU driver (tegra19_perf_uncore.c).
+ *
+ * Copyright (c) 2022, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef __UAPI_LINUX_TEGRA_UNCORE_SAMPLER_H
+#define __UAPI_LINUX_TEGRA_UNCORE_SAMPLER_H
+
+#include <linux/types.h>
+
+#define TEGRA_UNCORE_SAMPLER_MAGIC	0x756e6372	/* "uncr" */
+#define TEGRA_UNCORE_SAMPLER_VERSION	1
+
+/* number of entries in the sample ring, power of two */
+#define TEGRA_UNCORE_SAMPLER_RING_SZ	32
+
+/*
+ * One latched sample. seq is odd while the kernel rewrites the entry;
+ * read seq, copy the entry, re-read seq and retry if they differ or are
+ * odd. The derived metrics always hold the most recent value; raw_ctr
+ * and raw_events describe the counter pair latched in this window.
+ */
+struct tegra_uncore_sample {
+	__u32 seq;		/* odd while the entry is inconsistent */
+	__u32 l3_hit_pct;	/* L3 hits as percent of L3 lookups */
+	__u64 timestamp_ns;	/* local clock at latch time */
+	__u64 window_ns;	/* length of the measurement window */
+	__u64 dram_rd_kbps;	/* DRAM read BW (L3 refill * line size) */
+	__u64 dram_wr_kbps;	/* DRAM write BW (L3 WB * line size) */
+	__u32 raw_ctr[2];	/* raw counter deltas of this window */
+	__u32 raw_events[2];	/* event numbers the deltas belong to */
+};
+
+struct tegra_uncore_sampler_hdr {
+	__u32 magic;		/* TEGRA_UNCORE_SAMPLER_MAGIC */
+	__u32 version;		/* TEGRA_UNCORE_SAMPLER_VERSION */
+	__u32 ring_size;	/* TEGRA_UNCORE_SAMPLER_RING_SZ */
+	__u32 rate_hz;		/* configured sampling rate */
+	__u32 head;		/* index of the newest consistent entry */
+	__u32 reserved;
+	struct tegra_uncore_sample samples[TEGRA_UNCORE_SAMPLER_RING_SZ];
+};
+
+#endif /* __UAPI_LINUX_TEGRA_UNCORE_SAMPLER_H */
@@ -21,7 +21,7 @@
 #include <linux/types.h>
 
 #define QUADD_SAMPLES_VERSION	51
-#define QUADD_IO_VERSION	30
+#define QUADD_IO_VERSION	31
 
 #define QUADD_IO_VERSION_DYNAMIC_RB		5
 #define QUADD_IO_VERSION_RB_MAX_FILL_COUNT	6
@@ -49,6 +49,7 @@
 #define QUADD_IO_VERSION_UNCORE_EVENTS		28
 #define QUADD_IO_VERSION_EVENT_FILTER		29
 #define QUADD_IO_VERSION_CPUS_UINT		30
+#define QUADD_IO_VERSION_BT_FP_FIRST		31
 
 #define QUADD_SAMPLE_VERSION_THUMB_MODE_FLAG	17
 #define QUADD_SAMPLE_VERSION_GROUP_SAMPLES	18
@@ -379,6 +380,7 @@ struct quadd_comm_data {
 #define QUADD_HDR_FLAG_EXCLUDE_USER	(1ULL << 20)
 #define QUADD_HDR_FLAG_EXCLUDE_KERNEL	(1ULL << 21)
 #define QUADD_HDR_FLAG_EXCLUDE_HV	(1ULL << 22)
+#define QUADD_HDR_FLAG_BT_FP_FIRST	(1ULL << 23)
 
 struct quadd_header_data {
 	__u16 magic;
@@ -448,6 +450,7 @@ enum {
 #define QUADD_PARAM_EXTRA_EXCLUDE_USER		(1 << 17)
 #define QUADD_PARAM_EXTRA_EXCLUDE_KERNEL	(1 << 18)
 #define QUADD_PARAM_EXTRA_EXCLUDE_HV		(1 << 19)
+#define QUADD_PARAM_EXTRA_BT_FP_FIRST		(1 << 20)
 
 enum {
 	QUADD_EVENT_TYPE_RAW			= 0,
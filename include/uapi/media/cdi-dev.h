@@ -18,6 +18,8 @@
 #include <linux/types.h>
 
 #define CDI_DEV_PKG_FLAG_WR	1
+/* post the write and return without waiting for the i2c transfer */
+#define CDI_DEV_PKG_FLAG_ASYNC	2
 
 #define CDI_DEV_IOCTL_RW	          _IOW('o', 1, struct cdi_dev_package)
 #define CDI_DEV_IOCTL_GET_PWR_MODE    _IOW('o', 2, struct cdi_dev_pwr_mode)
@@ -18,6 +18,8 @@
 #include <linux/types.h>
 
 #define ISC_DEV_PKG_FLAG_WR	1
+/* post the write and return without waiting for the i2c transfer */
+#define ISC_DEV_PKG_FLAG_ASYNC	2
 
 #define ISC_DEV_IOCTL_RW	_IOW('o', 1, struct isc_dev_package)
 
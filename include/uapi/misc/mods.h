@@ -25,7 +25,7 @@
 
 /* Driver version */
 #define MODS_DRIVER_VERSION_MAJOR 4
-#define MODS_DRIVER_VERSION_MINOR 8
+#define MODS_DRIVER_VERSION_MINOR 9
 #define MODS_DRIVER_VERSION ((MODS_DRIVER_VERSION_MAJOR << 8) | \
 			     ((MODS_DRIVER_VERSION_MINOR / 10) << 4) | \
 			     (MODS_DRIVER_VERSION_MINOR % 10))
@@ -1821,6 +1821,95 @@ struct MODS_TEGRA_OIST_STATUS {
 	__u64 smc_status;
 };
 
+#define MODS_MAX_REG_OPS 256
+
+#define MODS_REG_OP_READ  0
+#define MODS_REG_OP_WRITE 1
+#define MODS_REG_OP_RMW   2
+#define MODS_REG_OP_POLL  3
+
+/* One register operation executed by MODS_ESC_REG_TRANSACTION.
+ *
+ * READ  returns the current register contents in read_value.
+ * WRITE stores value into the register.
+ * RMW   writes (read_value & ~mask) | (value & mask) and returns the
+ *       original register contents in read_value.
+ * POLL  reads the register until (read_value & mask) == value or until
+ *       timeout_ms milliseconds have elapsed, and returns the last value
+ *       read.
+ */
+struct MODS_REG_OP {
+	/* IN */
+	__u64 address;     /* physical address, must be 4-byte aligned */
+	__u8  op;
+	__u8  reserved[3]; /* Force 32-bit member alignment */
+	__u32 value;
+	__u32 mask;
+	__u32 timeout_ms;  /* POLL only */
+
+	/* OUT */
+	__u32 read_value;
+};
+
+/* Used by MODS_ESC_REG_TRANSACTION ioctl.
+ *
+ * Executes a script of register operations in a single kernel entry.
+ * Execution stops at the first operation that fails; num_completed and
+ * status tell how far the script got and why it stopped.  The ioctl
+ * itself fails only if the transaction is malformed.
+ */
+struct MODS_REG_TRANSACTION {
+	/* IN */
+	__u32 num_ops;
+	__u8  reserved[4]; /* Force 64-bit member alignment */
+	struct MODS_REG_OP ops[MODS_MAX_REG_OPS];
+
+	/* OUT */
+	__u32 num_completed;
+	__s32 status;      /* 0 or negative errno of the failed op */
+};
+
+#define MODS_MAX_DONATED_BUFFERS 64
+
+/* Used by MODS_ESC_DONATE_BUFFER ioctl.
+ *
+ * Registers a previously allocated buffer as long-lived.  The driver
+ * caches its DMA address and a kernel mapping and hands back an index
+ * which subsequent ioctls can use instead of re-resolving the handle.
+ * The donation is dropped automatically when the backing allocation is
+ * freed or when the client exits.
+ */
+struct MODS_DONATE_BUFFER {
+	/* IN */
+	__u64 memory_handle;
+
+	/* OUT */
+	__u32 index;
+	__u8  reserved[4]; /* Force 64-bit member alignment */
+};
+
+/* Used by MODS_ESC_GET_DONATED_BUFFER ioctl.
+ *
+ * Returns the addresses cached for a donated buffer.
+ */
+struct MODS_GET_DONATED_BUFFER {
+	/* IN */
+	__u32 index;
+	__u8  reserved[4]; /* Force 64-bit member alignment */
+
+	/* OUT */
+	__u64 dma_addr;         /* DMA address of the first chunk */
+	__u64 physical_address; /* physical address of the first chunk */
+	__u64 size;             /* total size of the buffer, in bytes */
+};
+
+/* Used by MODS_ESC_RELEASE_DONATED_BUFFER ioctl. */
+struct MODS_RELEASE_DONATED_BUFFER {
+	/* IN */
+	__u32 index;
+	__u8  reserved[4]; /* Force 64-bit member alignment */
+};
+
 #define MODS_IOMMU_MAP_CONTIGUOUS 1
 
 #pragma pack(pop)
@@ -2023,5 +2112,10 @@ struct MODS_TEGRA_OIST_STATUS {
 #define MODS_ESC_GET_ACPI_DEV_CHILDREN MODSIO(WR, 138, MODS_GET_ACPI_DEV_CHILDREN)
 #define MODS_ESC_SEND_TZ_MSG MODSIO(WR, 139, MODS_TZ_PARAMS)
 #define MODS_ESC_OIST_STATUS MODSIO(WR, 140, MODS_TEGRA_OIST_STATUS)
+#define MODS_ESC_REG_TRANSACTION MODSIO(WR, 141, MODS_REG_TRANSACTION)
+#define MODS_ESC_DONATE_BUFFER MODSIO(WR, 142, MODS_DONATE_BUFFER)
+#define MODS_ESC_GET_DONATED_BUFFER MODSIO(WR, 143, MODS_GET_DONATED_BUFFER)
+#define MODS_ESC_RELEASE_DONATED_BUFFER MODSIO(W, 144, \
+					       MODS_RELEASE_DONATED_BUFFER)
 
 #endif /* _UAPI_MODS_H_  */
@@ -180,6 +180,21 @@ struct nvscic2c_pcie_submit_copy_args {
 	__u64 remote_post_fence_values;
 };
 
+/*
+ * stream extensions - burst of copy requests submitted in one syscall.
+ *
+ * @num_requests: in - number of entries in @requests. out - number of
+ *  requests actually submitted. Requests are submitted in order and
+ *  submission stops at the first failing request; an error is returned
+ *  only when no request could be submitted.
+ * @requests: user memory atleast of size:
+ *  num_requests * sizeof(struct nvscic2c_pcie_submit_copy_args)
+ */
+struct nvscic2c_pcie_submit_copy_burst_args {
+	__u64 num_requests;
+	__u64 requests;
+};
+
 /**
  * stream extensions - Pass upper limit for the total possible outstanding
  * submit copy requests.
@@ -203,6 +218,7 @@ struct nvscic2c_link_change_ack {
 union nvscic2c_pcie_ioctl_arg_max_size {
 	struct nvscic2c_pcie_max_copy_args mc;
 	struct nvscic2c_pcie_submit_copy_args cr;
+	struct nvscic2c_pcie_submit_copy_burst_args cb;
 	struct nvscic2c_pcie_free_obj_args fo;
 	struct nvscic2c_pcie_import_obj_args io;
 	struct nvscic2c_pcie_export_obj_args eo;
@@ -270,6 +286,13 @@ union nvscic2c_pcie_ioctl_arg_max_size {
 	_IOW(NVSCIC2C_PCIE_IOCTL_MAGIC, 9,\
 	     struct nvscic2c_link_change_ack)
 
-#define NVSCIC2C_PCIE_IOCTL_NUMBER_MAX 9
+/**
+ * Submit a burst of copy requests for transfer with one syscall.
+ */
+#define NVSCIC2C_PCIE_IOCTL_SUBMIT_COPY_REQUESTS \
+	_IOWR(NVSCIC2C_PCIE_IOCTL_MAGIC, 10,\
+	      struct nvscic2c_pcie_submit_copy_burst_args)
+
+#define NVSCIC2C_PCIE_IOCTL_NUMBER_MAX 10
 
 #endif /*__UAPI_NVSCIC2C_PCIE_IOCTL_H__*/
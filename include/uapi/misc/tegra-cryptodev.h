@@ -148,6 +148,8 @@ struct tegra_pka1_rsa_request {
 		_IOWR(0x98, 106, struct tegra_pka1_rsa_request)
 
 int tegra_se_pka1_ecc_op(struct tegra_se_pka1_ecc_request *req);
+int tegra_se_pka1_ecc_op_queue(struct tegra_se_pka1_ecc_request *reqs,
+			       unsigned int nreqs);
 int tegra_se_rng1_op(struct tegra_se_rng1_request *req);
 
 /* a pointer to this struct needs to be passed to:
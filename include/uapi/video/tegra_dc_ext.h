@@ -334,6 +334,9 @@ enum tegra_dc_ext_flip_data_type {
 	TEGRA_DC_EXT_FLIP_USER_DATA_BACKGROUND_COLOR,
 	TEGRA_DC_EXT_FLIP_USER_DATA_AVI_DATA,
 	TEGRA_DC_EXT_FLIP_USER_DATA_DV_DATA,
+	TEGRA_DC_EXT_FLIP_USER_DATA_TARGET_VBLANK,
+	TEGRA_DC_EXT_FLIP_USER_DATA_DAMAGE_RECT,
+	TEGRA_DC_EXT_FLIP_USER_DATA_TRACE_ID,
 };
 
 /*
@@ -650,6 +653,57 @@ struct tegra_dc_ext_udata_background_color {
 	__u8 reserved[22];
 } __attribute__((__packed__));
 
+/*
+ * This struct is a flip user data type
+ * (TEGRA_DC_EXT_FLIP_USER_DATA_TARGET_VBLANK) used for frame-targeted
+ * presentation. The flip is held back until the head's hardware frame
+ * counter reaches target_frame_cnt, and retires on that vblank. Clients
+ * can queue several flips ahead, each tagged with a successive target,
+ * and pace themselves off the post-syncpt fences instead of waking up
+ * for every vsync. Only the low 16 bits of the counter are implemented
+ * in hardware; targets are compared modulo 2^16, so a target may lead
+ * the current frame counter by at most 32767 frames.
+ * reserved is padding so that the total struct size is 26 bytes.
+ */
+struct tegra_dc_ext_udata_target_vblank {
+	__u32 target_frame_cnt;
+	__u8 reserved[22]; /* unused - must be 0 */
+} __attribute__((__packed__));
+
+/*
+ * This struct is a flip user data type
+ * (TEGRA_DC_EXT_FLIP_USER_DATA_DAMAGE_RECT) describing the panel region
+ * this flip actually changes. On command mode (one-shot) DSI panels the
+ * kernel narrows the frame sent over the panel link to this rectangle;
+ * the flip's windows must describe a scanout of exactly w x h pixels,
+ * which the panel places at (x, y). Flips without this user data on a
+ * head that previously flipped with it restore full-frame updates. The
+ * rectangle is ignored on outputs without partial update support.
+ * reserved is padding so that the total struct size is 26 bytes.
+ */
+struct tegra_dc_ext_udata_damage_rect {
+	__u16 x;
+	__u16 y;
+	__u16 w;
+	__u16 h;
+	__u8 reserved[18]; /* unused - must be 0 */
+} __attribute__((__packed__));
+
+/*
+ * This struct is a flip user data type
+ * (TEGRA_DC_EXT_FLIP_USER_DATA_TRACE_ID) tagging the flip with a
+ * client-assigned frame trace id. The kernel logs the id to the
+ * "nv_pipeline" eventlib stream when the flip is queued and again when
+ * it latches into active scanout, so the flip can be correlated with
+ * the capture and engine stages of the same frame. An id of 0 means
+ * untraced and is equivalent to omitting this user data.
+ * reserved is padding so that the total struct size is 26 bytes.
+ */
+struct tegra_dc_ext_udata_trace_id {
+	__u64 trace_id;
+	__u8 reserved[18]; /* unused - must be 0 */
+} __attribute__((__packed__));
+
 /*
  * Variable "flip_id" is a per-head unique value that is returned from kernel to
  * user-space. User-space can then pass this flip_id to TEGRA_DC_EXT_CRC_GET
@@ -681,6 +735,9 @@ struct tegra_dc_ext_flip_user_data {
 		struct tegra_dc_ext_udata_output_csc output_csc;
 		struct tegra_dc_ext_flip_info flip_info;
 		struct tegra_dc_ext_udata_background_color background_color;
+		struct tegra_dc_ext_udata_target_vblank target_vblank;
+		struct tegra_dc_ext_udata_damage_rect damage_rect;
+		struct tegra_dc_ext_udata_trace_id trace_id;
 	};
 } __attribute__((__packed__));
 
@@ -1662,6 +1719,52 @@ struct tegra_dc_ext_scanline_info {
 #define TEGRA_DC_EXT_CRC_GET \
 	_IOWR('D', 0x28, struct tegra_dc_ext_crc_arg)
 
+/* Set up (or resize) the mmap-able CRC history ring for this head. Once the
+ * ring exists, the frame end interrupt handler deposits every collected CRC
+ * element into it along with the RG frame counter, so userspace can audit
+ * CRCs continuously without issuing a (blocking) GET IOCTL per frame. The
+ * ring is mapped read-only by calling mmap() on the device with offset 0; see
+ * struct tegra_dc_ext_crc_ring_hdr for the memory layout and the reader
+ * protocol.
+ *
+ * Returns
+ * -EINVAL   if depth is not a power of 2 within
+ *           [TEGRA_DC_EXT_CRC_RING_MIN_DEPTH, TEGRA_DC_EXT_CRC_RING_MAX_DEPTH]
+ * -EBUSY    if the ring is currently mapped by some process, since resizing
+ *           it would pull the pages from under the readers
+ * -ENOMEM   if the ring allocation fails
+ */
+#define TEGRA_DC_EXT_CRC_RING_SETUP \
+	_IOW('D', 0x29, struct tegra_dc_ext_crc_ring_setup)
+
+/* Report when a flip was actually presented. The flip is identified using the
+ * flip ID that was returned to the user by the TEGRA_DC_EXT_FLIP4 IOCTL. The
+ * call blocks until the flip has retired on a vblank, and returns the
+ * CLOCK_MONOTONIC time of the frame end interrupt that latched it, along with
+ * the hardware frame counter at that point. Clients that pace their rendering
+ * with absolute presentation timestamps (per-window timestamps or the
+ * TARGET_VBLANK flip user data) can close the loop on these timestamps
+ * instead of estimating vblank positions in userspace.
+ *
+ * Returns
+ * -EINVAL   if flip_id is 0 or has not been handed out yet, or if reserved
+ *           is not 0
+ * -ETIME    if nothing presented within the wait budget, e.g. because the
+ *           head is blanked
+ * -ENODATA  if the flip never presented (it was skipped in favor of a newer
+ *           flip), or if it presented so long ago that its timestamp has
+ *           been dropped from the kernel history
+ */
+struct tegra_dc_ext_present_time {
+	__u64 flip_id;      /* in: flip to query */
+	__s64 timestamp_ns; /* out: CLOCK_MONOTONIC presentation time */
+	__u32 frame_cnt;    /* out: hardware frame counter at presentation */
+	__u32 reserved[3];  /* unused - must be 0 */
+};
+
+#define TEGRA_DC_EXT_GET_PRESENT_TIME \
+	_IOWR('D', 0x2A, struct tegra_dc_ext_present_time)
+
 enum tegra_dc_ext_control_output_type {
 	TEGRA_DC_EXT_DSI,
 	TEGRA_DC_EXT_LVDS,
@@ -1949,6 +2052,70 @@ struct tegra_dc_ext_crc_arg {
 	__u8 reserved[32]; /* unused - must be 0 */
 } __attribute__((__packed__));
 
+#define TEGRA_DC_EXT_CRC_RING_MAGIC 0x48524354 /* 'TCRH' */
+#define TEGRA_DC_EXT_CRC_RING_VERSION 1
+#define TEGRA_DC_EXT_CRC_RING_MIN_DEPTH 16
+#define TEGRA_DC_EXT_CRC_RING_MAX_DEPTH 4096
+
+/* Bits of the valid field of tegra_dc_ext_crc_ring_ele */
+#define TEGRA_DC_EXT_CRC_RING_VALID_RG (1 << 0)
+#define TEGRA_DC_EXT_CRC_RING_VALID_COMP (1 << 1)
+#define TEGRA_DC_EXT_CRC_RING_VALID_OR (1 << 2)
+#define TEGRA_DC_EXT_CRC_RING_VALID_REGIONAL(i) (1 << (3 + (i)))
+
+/*
+ * tegra_dc_ext_crc_ring_ele - One slot of the mmap-able CRC history ring
+ * @seq       - Incremented to an odd value before the kernel rewrites the
+ *              slot and back to even once the slot is consistent. A slot
+ *              whose seq is 0 has never been written
+ * @frame_cnt - Value of the RG frame counter when the CRCs were latched
+ * @valid     - Bitmask of TEGRA_DC_EXT_CRC_RING_VALID_* flags denoting which
+ *              of the CRC fields carry live values
+ * @rg/comp/sor/regional - CRCs collected at the frame end interrupt
+ */
+struct tegra_dc_ext_crc_ring_ele {
+	__u32 seq;
+	__u32 frame_cnt;
+	__u32 valid;
+	__u32 rg;
+	__u32 comp;
+	__u32 sor;
+	__u32 regional[TEGRA_DC_EXT_MAX_REGIONS];
+	__u32 reserved;
+};
+
+/*
+ * tegra_dc_ext_crc_ring_hdr - Header page of the mmap-able CRC history ring.
+ *                             An array of ring_size tegra_dc_ext_crc_ring_ele
+ *                             slots immediately follows the header
+ * @magic     - TEGRA_DC_EXT_CRC_RING_MAGIC
+ * @version   - TEGRA_DC_EXT_CRC_RING_VERSION
+ * @ring_size - Number of slots, as programmed via the SETUP IOCTL
+ * @head      - Index of the most recently published slot
+ *
+ * A reader snapshots head, copies the slot out, and accepts the copy only if
+ * seq was even and identical before and after the copy, retrying otherwise
+ */
+struct tegra_dc_ext_crc_ring_hdr {
+	__u32 magic;
+	__u32 version;
+	__u32 ring_size;
+	__u32 head;
+	__u8 reserved[48];
+};
+
+/*
+ * tegra_dc_ext_crc_ring_setup - The argument to the CRC RING SETUP IOCTL
+ * @depth    - Number of slots in the ring. Must be a power of 2 within
+ *             [TEGRA_DC_EXT_CRC_RING_MIN_DEPTH,
+ *              TEGRA_DC_EXT_CRC_RING_MAX_DEPTH], or 0 to tear the ring down
+ * @reserved - Easier way to extend the data structure
+ */
+struct tegra_dc_ext_crc_ring_setup {
+	__u32 depth;
+	__u8 reserved[12];
+} __attribute__((__packed__));
+
 #define TEGRA_DC_EXT_CONTROL_GET_NUM_OUTPUTS \
 	_IOR('C', 0x00, __u32)
 #define TEGRA_DC_EXT_CONTROL_GET_OUTPUT_PROPERTIES \
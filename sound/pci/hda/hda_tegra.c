@@ -133,6 +133,7 @@ struct hda_tegra {
 	struct work_struct probe_work;
 	struct kobject *kobj;
 	struct hda_pcm_devices *hda_pcm_dev;
+	struct bin_attribute pos_attr;
 	const struct tegra_hda_chip_data *cdata;
 };
 
@@ -734,6 +735,36 @@ static ssize_t hda_get_pcm_switch_name(struct kobject *kobj,
 	return snprintf(buf, PAGE_SIZE, "%s\n", pcm_dev->switch_name);
 }
 
+static ssize_t hda_dma_pos_read(struct file *filp, struct kobject *kobj,
+	struct bin_attribute *attr, char *buf, loff_t off, size_t count)
+{
+	struct hda_tegra *hda = attr->private;
+	struct hdac_bus *bus = azx_bus(&hda->chip);
+
+	if (off >= attr->size)
+		return 0;
+	if (count > attr->size - off)
+		count = attr->size - off;
+	memcpy(buf, bus->posbuf.area + off, count);
+
+	return count;
+}
+
+static int hda_dma_pos_mmap(struct file *filp, struct kobject *kobj,
+	struct bin_attribute *attr, struct vm_area_struct *vma)
+{
+	struct hda_tegra *hda = attr->private;
+	struct hdac_bus *bus = azx_bus(&hda->chip);
+
+	/* the page is written by the DMA engine; map it read-only */
+	if (vma->vm_flags & VM_WRITE)
+		return -EPERM;
+	vma->vm_flags &= ~VM_MAYWRITE;
+
+	return dma_mmap_coherent(bus->dev, vma, bus->posbuf.area,
+				 bus->posbuf.addr, bus->posbuf.bytes);
+}
+
 static int hda_tegra_create_sysfs(struct hda_tegra *hda)
 {
 	struct azx *chip = &hda->chip;
@@ -754,6 +785,21 @@ static int hda_tegra_create_sysfs(struct hda_tegra *hda)
 	if (!hda->kobj)
 		return -ENOMEM;
 
+	/* expose the controller's DMA position readback page (8 bytes per
+	 * stream, HDA spec section 3.6); the audio server can mmap it and
+	 * poll stream positions without taking a period interrupt
+	 */
+	sysfs_bin_attr_init(&hda->pos_attr);
+	hda->pos_attr.attr.name = "dma_pos";
+	hda->pos_attr.attr.mode = 0444;
+	hda->pos_attr.size = 8 * chip->num_streams;
+	hda->pos_attr.private = hda;
+	hda->pos_attr.read = hda_dma_pos_read;
+	hda->pos_attr.mmap = hda_dma_pos_mmap;
+	ret = sysfs_create_bin_file(hda->kobj, &hda->pos_attr);
+	if (ret < 0)
+		return ret;
+
 	list_for_each_entry(apcm, &chip->pcm_list, list) {
 		char subdirname[CHAR_BUF_SIZE_MAX];
 		struct hda_pcm_devices *pcm_dev = &hda->hda_pcm_dev[dev_count];
@@ -828,6 +874,7 @@ static void hda_tegra_remove_sysfs(struct device *dev)
 			pcm_dev->kobj = NULL;
 		}
 	}
+	sysfs_remove_bin_file(hda->kobj, &hda->pos_attr);
 	kobject_put(hda->kobj);
 	hda->kobj = NULL;
 }
@@ -503,7 +503,7 @@ static int tegra210_adsp_send_msg(struct tegra210_adsp_app *app,
 	if (ret < 0) {
 		/* Wakeup APM to consume messages and give it some time */
 		ret = nvadsp_mbox_send(&app->apm_mbox, apm_cmd_msg_ready,
-			NVADSP_MBOX_SMSG, false, 0);
+			NVADSP_MBOX_SMSG | NVADSP_MBOX_SMSG_COALESCE, false, 0);
 		if (ret) {
 			pr_err("%s: Failed to send mailbox message id %d ret %d\n",
 				__func__, app->apm->mbox_id, ret);
@@ -529,7 +529,7 @@ static int tegra210_adsp_send_msg(struct tegra210_adsp_app *app,
 		return 0;
 
 	ret = nvadsp_mbox_send(&app->apm_mbox, apm_cmd_msg_ready,
-		NVADSP_MBOX_SMSG, false, 0);
+		NVADSP_MBOX_SMSG | NVADSP_MBOX_SMSG_COALESCE, false, 0);
 	if (ret) {
 		pr_err("%s: Failed to send mailbox message id %d ret %d\n",
 			__func__, app->apm->mbox_id, ret);